@@ -0,0 +1,79 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "game/save_container.h"
+
+#include "game/save_container_test_data.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(save_container_benchmarks)
+
+using namespace save_container_test_data;
+
+namespace {
+
+//save the records as a Lua table, in the same way as the map tiles were previously saved
+std::string save_tile_records_as_text(const std::vector<tile_record> &records)
+{
+	std::string text;
+	std::array<char, 256> buffer{};
+
+	for (const tile_record &record : records) {
+		const int length = snprintf(buffer.data(), buffer.size(), "  {\"%s\", \"%s\", %d, %d, \"landmass\", %d, \"explored\", %llu, \"flags\", %u},\n", record.terrain->get_identifier().c_str(), record.overlay_terrain != nullptr ? record.overlay_terrain->get_identifier().c_str() : "", record.value, record.movement_cost, record.landmass, static_cast<unsigned long long>(record.explored), record.flags);
+		text.append(buffer.data(), length);
+	}
+
+	return text;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(save_container_tile_benchmark)
+{
+	const std::vector<tile_record> records = create_tile_records();
+
+	auto start_time = std::chrono::steady_clock::now();
+	const std::string text = save_tile_records_as_text(records);
+	const std::chrono::nanoseconds text_save_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	const std::string container_data = save_tile_records(records);
+	const std::chrono::nanoseconds binary_save_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	const std::vector<tile_record> loaded_records = load_tile_records(container_data);
+	const std::chrono::nanoseconds binary_load_duration = std::chrono::steady_clock::now() - start_time;
+
+	BOOST_CHECK(loaded_records == records);
+
+	BOOST_TEST_MESSAGE("Save container benchmark (" << map_size << "x" << map_size << " tiles): text " << std::chrono::duration_cast<std::chrono::microseconds>(text_save_duration).count() << " us (" << text.size() << " bytes, uncompressed), binary save " << std::chrono::duration_cast<std::chrono::microseconds>(binary_save_duration).count() << " us (" << container_data.size() << " bytes), binary load " << std::chrono::duration_cast<std::chrono::microseconds>(binary_load_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/cell_grid.h"
+
+#include "map/cell_grid_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(cell_grid_benchmarks)
+
+using namespace cell_grid_reference;
+
+BOOST_AUTO_TEST_CASE(cell_grid_reaction_range_benchmark)
+{
+	static constexpr int reaction_range = 8;
+
+	std::vector<test_unit> units = create_units(1500);
+
+	wyrmgus::cell_grid<test_unit> grid(QSize(map_width, map_height));
+	for (test_unit &unit : units) {
+		grid.insert(&unit, unit.rect);
+	}
+
+	const tile_unit_lists tiles(units);
+
+	std::chrono::nanoseconds grid_duration(0);
+	std::chrono::nanoseconds tile_duration(0);
+	size_t found_count = 0;
+
+	std::vector<test_unit *> grid_units;
+	std::vector<test_unit *> tile_units;
+
+	//every unit looks for the units within its reaction range, as done each cycle for idle units
+	for (const test_unit &unit : units) {
+		const QRect rect = get_reaction_rect(unit, reaction_range);
+
+		grid_units.clear();
+		auto start_time = std::chrono::steady_clock::now();
+		grid.for_each_in_rect(rect, [&grid_units](test_unit *other_unit, const QRect &) {
+			grid_units.push_back(other_unit);
+		});
+		grid_duration += std::chrono::steady_clock::now() - start_time;
+
+		tile_units.clear();
+		start_time = std::chrono::steady_clock::now();
+		tiles.select(rect, tile_units);
+		tile_duration += std::chrono::steady_clock::now() - start_time;
+
+		std::sort(grid_units.begin(), grid_units.end());
+		std::sort(tile_units.begin(), tile_units.end());
+		BOOST_CHECK(grid_units == tile_units);
+
+		found_count += grid_units.size();
+	}
+
+	BOOST_TEST_MESSAGE("Reaction range benchmark (" << units.size() << " units, " << found_count << " units found): cell grid " << std::chrono::duration_cast<std::chrono::microseconds>(grid_duration).count() << " us, tile scan " << std::chrono::duration_cast<std::chrono::microseconds>(tile_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace cell_grid_reference {
+
+inline constexpr int map_width = 256;
+inline constexpr int map_height = 256;
+
+struct test_unit final
+{
+	QRect rect;
+	bool cache_lock = false;
+};
+
+//place units of sizes from 1x1 to 3x3 throughout the map
+inline std::vector<test_unit> create_units(const size_t unit_count)
+{
+	std::vector<test_unit> units(unit_count);
+
+	uint32_t seed = 0x2545F491;
+	for (test_unit &unit : units) {
+		seed = seed * 1103515245 + 12345;
+		const int size = (seed >> 16) % 10 == 0 ? 3 : ((seed >> 16) % 10 < 3 ? 2 : 1);
+		seed = seed * 1103515245 + 12345;
+		const int x = (seed >> 16) % (map_width - size + 1);
+		seed = seed * 1103515245 + 12345;
+		const int y = (seed >> 16) % (map_height - size + 1);
+		unit.rect = QRect(QPoint(x, y), QSize(size, size));
+	}
+
+	return units;
+}
+
+//the per-tile unit lists previously used for range queries, kept here as the reference for comparisons
+class tile_unit_lists final
+{
+public:
+	explicit tile_unit_lists(std::vector<test_unit> &units) : tiles(map_width * map_height)
+	{
+		for (test_unit &unit : units) {
+			for (int y = unit.rect.top(); y <= unit.rect.bottom(); ++y) {
+				for (int x = unit.rect.left(); x <= unit.rect.right(); ++x) {
+					this->tiles[y * map_width + x].push_back(&unit);
+				}
+			}
+		}
+	}
+
+	void select(const QRect &rect, std::vector<test_unit *> &units) const
+	{
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			for (int x = rect.left(); x <= rect.right(); ++x) {
+				for (test_unit *unit : this->tiles[y * map_width + x]) {
+					if (!unit->cache_lock) {
+						unit->cache_lock = true;
+						units.push_back(unit);
+					}
+				}
+			}
+		}
+
+		for (test_unit *unit : units) {
+			unit->cache_lock = false;
+		}
+	}
+
+private:
+	std::vector<std::vector<test_unit *>> tiles;
+};
+
+inline QRect get_reaction_rect(const test_unit &unit, const int range)
+{
+	const QRect rect(unit.rect.topLeft() - QPoint(range, range), unit.rect.bottomRight() + QPoint(range, range));
+	return rect.intersected(QRect(0, 0, map_width, map_height));
+}
+
+}
@@ -0,0 +1,68 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/minimap_overlay_tracker.h"
+
+#include "map/minimap_overlay_tracker_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(minimap_overlay_tracker_benchmarks)
+
+using namespace minimap_overlay_tracker_reference;
+
+BOOST_AUTO_TEST_CASE(minimap_overlay_tracker_benchmark)
+{
+	overlay_simulation simulation;
+
+	std::chrono::nanoseconds full_duration(0);
+	std::chrono::nanoseconds incremental_duration(0);
+
+	for (int second = 0; second < simulated_seconds; ++second) {
+		if (second > 0) {
+			simulation.advance(second);
+		}
+
+		const std::vector<test_tracker::unit_state> unit_states = get_unit_states(simulation.units);
+
+		auto start_time = std::chrono::steady_clock::now();
+		simulation.redraw_full_overlay(unit_states);
+		full_duration += std::chrono::steady_clock::now() - start_time;
+
+		start_time = std::chrono::steady_clock::now();
+		simulation.update_incremental_overlay(unit_states);
+		incremental_duration += std::chrono::steady_clock::now() - start_time;
+
+		BOOST_CHECK(simulation.incremental_overlay.pixels == simulation.full_overlay.pixels);
+	}
+
+	BOOST_TEST_MESSAGE("Minimap overlay benchmark (" << unit_count << " units on a " << texture_size << "x" << texture_size << " texture, per second of game time): full redraw " << std::chrono::duration_cast<std::chrono::microseconds>(full_duration).count() / simulated_seconds << " us, incremental " << std::chrono::duration_cast<std::chrono::microseconds>(incremental_duration).count() / simulated_seconds << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
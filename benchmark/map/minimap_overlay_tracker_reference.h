@@ -0,0 +1,192 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "map/minimap_overlay_tracker.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace minimap_overlay_tracker_reference {
+
+inline constexpr int texture_size = 512;
+inline constexpr int unit_count = 4000;
+inline constexpr int simulated_seconds = 30;
+inline constexpr int border_size = 1;
+
+struct test_unit final
+{
+	QPoint pos;
+	int size = 1;
+	uint32_t color = 0;
+	bool removed = false;
+};
+
+using test_tracker = wyrmgus::minimap_overlay_tracker;
+
+class test_overlay final
+{
+public:
+	test_overlay() : background(texture_size * texture_size, 0), pixels(texture_size * texture_size, 0)
+	{
+		//a territory-like background
+		for (int y = 0; y < texture_size; ++y) {
+			for (int x = 0; x < texture_size; ++x) {
+				this->background[y * texture_size + x] = static_cast<uint32_t>((x / 64) * 8 + (y / 64));
+			}
+		}
+	}
+
+	void restore(const QRect &rect)
+	{
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			std::copy_n(this->background.begin() + y * texture_size + rect.left(), rect.width(), this->pixels.begin() + y * texture_size + rect.left());
+		}
+	}
+
+	void draw(const wyrmgus::minimap_unit_draw_state &state)
+	{
+		const QRect rect = state.rect.intersected(QRect(0, 0, texture_size, texture_size));
+
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			std::fill_n(this->pixels.begin() + y * texture_size + rect.left(), rect.width(), state.color);
+		}
+	}
+
+	std::vector<uint32_t> background;
+	std::vector<uint32_t> pixels;
+};
+
+inline std::vector<test_tracker::unit_state> get_unit_states(const std::vector<test_unit> &units)
+{
+	std::vector<test_tracker::unit_state> unit_states;
+
+	for (size_t i = 0; i < units.size(); ++i) {
+		const test_unit &unit = units[i];
+		if (unit.removed) {
+			continue;
+		}
+
+		wyrmgus::minimap_unit_draw_state state;
+		state.rect = QRect(unit.pos.x(), unit.pos.y(), unit.size + 1, unit.size + 1);
+		state.color = unit.color;
+		unit_states.emplace_back(i, state);
+	}
+
+	return unit_states;
+}
+
+//redraw the overlay from scratch, as the minimap did every second before, including the pass over the whole texture for its borders
+inline void redraw_overlay(test_overlay &overlay, const std::vector<test_tracker::unit_state> &unit_states)
+{
+	overlay.pixels = overlay.background;
+
+	for (int y = 0; y < texture_size; ++y) {
+		for (int x = 0; x < texture_size; ++x) {
+			if (x < border_size || x >= texture_size - border_size || y < border_size || y >= texture_size - border_size) {
+				overlay.pixels[y * texture_size + x] = overlay.background[y * texture_size + x];
+			}
+		}
+	}
+
+	for (const auto &[key, state] : unit_states) {
+		overlay.draw(state);
+	}
+}
+
+//units moving, blinking and being removed or placed again, and territories changing, over simulated seconds of game time; the overlay is redrawn once per second both from scratch and incrementally with the tracker
+class overlay_simulation final
+{
+public:
+	overlay_simulation()
+	{
+		for (int i = 0; i < unit_count; ++i) {
+			test_unit unit;
+			unit.pos = QPoint(this->pos_distribution(this->random_engine), this->pos_distribution(this->random_engine));
+			unit.size = this->size_distribution(this->random_engine);
+			unit.color = 1000 + static_cast<uint32_t>(i % 16);
+			this->units.push_back(unit);
+		}
+
+		this->tracker.clear(QSize(texture_size, texture_size));
+		this->incremental_overlay.pixels = this->incremental_overlay.background;
+	}
+
+	//apply the changes of a second of game time
+	void advance(const int second)
+	{
+		for (test_unit &unit : this->units) {
+			const int percent = this->percent_distribution(this->random_engine);
+
+			if (percent < 10) {
+				unit.pos = QPoint(std::clamp(unit.pos.x() + this->step_distribution(this->random_engine), 0, texture_size - 4), std::clamp(unit.pos.y() + this->step_distribution(this->random_engine), 0, texture_size - 4));
+			} else if (percent < 11) {
+				//blink as if attacked
+				unit.color ^= 0x10000;
+			} else if (percent < 12) {
+				unit.removed = !unit.removed;
+			}
+		}
+
+		//a change in territory ownership
+		const QRect territory_rect(this->pos_distribution(this->random_engine), this->pos_distribution(this->random_engine), 4, 4);
+		for (int y = territory_rect.top(); y <= territory_rect.bottom(); ++y) {
+			for (int x = territory_rect.left(); x <= territory_rect.right(); ++x) {
+				this->full_overlay.background[y * texture_size + x] = 500 + static_cast<uint32_t>(second);
+				this->incremental_overlay.background[y * texture_size + x] = 500 + static_cast<uint32_t>(second);
+			}
+		}
+		this->tracker.mark_dirty(territory_rect);
+	}
+
+	void redraw_full_overlay(const std::vector<test_tracker::unit_state> &unit_states)
+	{
+		redraw_overlay(this->full_overlay, unit_states);
+	}
+
+	void update_incremental_overlay(const std::vector<test_tracker::unit_state> &unit_states)
+	{
+		this->tracker.update(unit_states, [this](const QRect &rect) {
+			this->incremental_overlay.restore(rect);
+		}, [this](const size_t, const wyrmgus::minimap_unit_draw_state &state) {
+			this->incremental_overlay.draw(state);
+		});
+	}
+
+	std::vector<test_unit> units;
+	test_overlay full_overlay;
+	test_overlay incremental_overlay;
+
+private:
+	test_tracker tracker;
+	std::mt19937 random_engine = std::mt19937(42);
+	std::uniform_int_distribution<int> pos_distribution = std::uniform_int_distribution<int>(0, texture_size - 4);
+	std::uniform_int_distribution<int> size_distribution = std::uniform_int_distribution<int>(1, 3);
+	std::uniform_int_distribution<int> percent_distribution = std::uniform_int_distribution<int>(0, 99);
+	std::uniform_int_distribution<int> step_distribution = std::uniform_int_distribution<int>(-1, 1);
+};
+
+}
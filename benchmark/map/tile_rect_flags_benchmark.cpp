@@ -0,0 +1,74 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/tile_rect_flags.h"
+
+#include "map/tile_rect_flags_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(tile_rect_flags_benchmarks)
+
+using namespace tile_rect_flags_reference;
+
+BOOST_AUTO_TEST_CASE(tile_rect_flags_terrain_adjustment_benchmark)
+{
+	const std::vector<int> initial_map = create_terrain_map();
+
+	std::vector<int> in_order_map = initial_map;
+	std::vector<int> parallel_check_map = initial_map;
+
+	std::chrono::nanoseconds in_order_duration(0);
+	std::chrono::nanoseconds parallel_check_duration(0);
+
+	//adjust until no irregularities are left, as the terrain adjustment does
+	for (int i = 0; i < 100; ++i) {
+		auto start_time = std::chrono::steady_clock::now();
+		const int in_order_changed_tile_count = adjust_tiles_in_order(in_order_map);
+		in_order_duration += std::chrono::steady_clock::now() - start_time;
+
+		start_time = std::chrono::steady_clock::now();
+		const int parallel_check_changed_tile_count = adjust_tiles_with_parallel_check(parallel_check_map);
+		parallel_check_duration += std::chrono::steady_clock::now() - start_time;
+
+		BOOST_CHECK(in_order_changed_tile_count == parallel_check_changed_tile_count);
+
+		if (in_order_changed_tile_count == 0) {
+			break;
+		}
+	}
+
+	//the result must be exactly the same
+	BOOST_CHECK(in_order_map == parallel_check_map);
+	BOOST_CHECK(in_order_map != initial_map);
+
+	BOOST_TEST_MESSAGE("Terrain adjustment benchmark (" << map_width << "x" << map_height << " map, " << std::thread::hardware_concurrency() << " hardware threads): parallel check " << std::chrono::duration_cast<std::chrono::microseconds>(parallel_check_duration).count() << " us, in order " << std::chrono::duration_cast<std::chrono::microseconds>(in_order_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "map/tile_rect_flags.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace tile_rect_flags_reference {
+
+inline constexpr int map_width = 256;
+inline constexpr int map_height = 256;
+inline constexpr int terrain_count = 4;
+
+inline std::vector<int> create_terrain_map()
+{
+	std::vector<int> map(map_width * map_height, 0);
+
+	uint32_t seed = 0x2545F491;
+	for (int &terrain : map) {
+		seed = seed * 1103515245 + 12345;
+		terrain = static_cast<int>((seed >> 16) % 100) < 90 ? 0 : static_cast<int>((seed >> 16) % terrain_count);
+	}
+
+	return map;
+}
+
+//a reduced version of the terrain irregularity check: a tile is irregular if most of its adjacent tiles have a terrain which is neither its own nor one which can border it
+inline bool is_tile_irregular(const std::vector<int> &map, const QPoint &tile_pos)
+{
+	const int terrain = map[tile_pos.y() * map_width + tile_pos.x()];
+
+	std::set<int> acceptable_adjacent_terrains;
+	acceptable_adjacent_terrains.insert(terrain);
+	acceptable_adjacent_terrains.insert((terrain + 1) % terrain_count);
+
+	int unacceptable_adjacent_tiles = 0;
+	for (int x = tile_pos.x() - 1; x <= tile_pos.x() + 1; ++x) {
+		for (int y = tile_pos.y() - 1; y <= tile_pos.y() + 1; ++y) {
+			if (x < 0 || y < 0 || x >= map_width || y >= map_height || (x == tile_pos.x() && y == tile_pos.y())) {
+				continue;
+			}
+
+			if (!acceptable_adjacent_terrains.contains(map[y * map_width + x])) {
+				++unacceptable_adjacent_tiles;
+			}
+		}
+	}
+
+	return unacceptable_adjacent_tiles >= 4;
+}
+
+inline void adjust_tile(std::vector<int> &map, const QPoint &tile_pos)
+{
+	std::map<int, int> terrain_scores;
+
+	for (int x = tile_pos.x() - 1; x <= tile_pos.x() + 1; ++x) {
+		for (int y = tile_pos.y() - 1; y <= tile_pos.y() + 1; ++y) {
+			if (x < 0 || y < 0 || x >= map_width || y >= map_height || (x == tile_pos.x() && y == tile_pos.y())) {
+				continue;
+			}
+
+			terrain_scores[map[y * map_width + x]]++;
+		}
+	}
+
+	int best_score = 0;
+	for (const auto &[terrain, score] : terrain_scores) {
+		if (score > best_score) {
+			best_score = score;
+			map[tile_pos.y() * map_width + tile_pos.x()] = terrain;
+		}
+	}
+}
+
+//adjust the tiles by checking each in order, as the terrain adjustment did previously
+inline int adjust_tiles_in_order(std::vector<int> &map)
+{
+	int changed_tile_count = 0;
+
+	for (int x = 0; x < map_width; ++x) {
+		for (int y = 0; y < map_height; ++y) {
+			const QPoint tile_pos(x, y);
+
+			if (is_tile_irregular(map, tile_pos)) {
+				adjust_tile(map, tile_pos);
+				++changed_tile_count;
+			}
+		}
+	}
+
+	return changed_tile_count;
+}
+
+//adjust the tiles by checking them in parallel first, and then applying the results in order
+inline int adjust_tiles_with_parallel_check(std::vector<int> &map)
+{
+	const QRect rect(0, 0, map_width, map_height);
+
+	wyrmgus::tile_rect_flags irregular_tiles(rect);
+	irregular_tiles.set_if([&map](const QPoint &tile_pos) {
+		return is_tile_irregular(map, tile_pos);
+	});
+
+	wyrmgus::tile_rect_flags changed_tiles(rect);
+	int changed_tile_count = 0;
+
+	for (int x = 0; x < map_width; ++x) {
+		for (int y = 0; y < map_height; ++y) {
+			const QPoint tile_pos(x, y);
+
+			bool irregular = irregular_tiles.get(tile_pos);
+			if (changed_tiles.is_set_in_neighborhood(tile_pos)) {
+				irregular = is_tile_irregular(map, tile_pos);
+			}
+
+			if (irregular) {
+				adjust_tile(map, tile_pos);
+				changed_tiles.set(tile_pos);
+				++changed_tile_count;
+			}
+		}
+	}
+
+	return changed_tile_count;
+}
+
+}
@@ -0,0 +1,68 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/astar_open_list.h"
+
+#include "pathfinder/astar_open_list_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(astar_open_list_benchmarks)
+
+using namespace astar_open_list_reference;
+
+BOOST_AUTO_TEST_CASE(astar_open_list_search_benchmark)
+{
+	const std::vector<int> grid = create_cost_grid();
+	const std::vector<std::pair<Vec2i, Vec2i>> start_goal_pairs = create_start_goal_pairs();
+
+	wyrmgus::astar_open_list bucket_open_list;
+	bucket_open_list.set_node_count(grid.size());
+	flat_set_open_list flat_set_list;
+
+	std::chrono::nanoseconds bucket_duration(0);
+	std::chrono::nanoseconds flat_set_duration(0);
+
+	for (const auto &[start_pos, goal_pos] : start_goal_pairs) {
+		auto start_time = std::chrono::steady_clock::now();
+		const std::vector<unsigned int> bucket_expanded_offsets = run_search(bucket_open_list, grid, start_pos, goal_pos);
+		bucket_duration += std::chrono::steady_clock::now() - start_time;
+
+		start_time = std::chrono::steady_clock::now();
+		const std::vector<unsigned int> flat_set_expanded_offsets = run_search(flat_set_list, grid, start_pos, goal_pos);
+		flat_set_duration += std::chrono::steady_clock::now() - start_time;
+
+		//both open lists must expand the nodes in exactly the same order
+		BOOST_CHECK(bucket_expanded_offsets == flat_set_expanded_offsets);
+	}
+
+	BOOST_TEST_MESSAGE("A* open list benchmark (" << start_goal_pairs.size() << " searches on a " << grid_width << "x" << grid_height << " grid): bucket queue " << std::chrono::duration_cast<std::chrono::microseconds>(bucket_duration).count() << " us, flat set " << std::chrono::duration_cast<std::chrono::microseconds>(flat_set_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
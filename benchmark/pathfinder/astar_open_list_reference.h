@@ -0,0 +1,192 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "vec2i.h"
+
+#include <boost/container/flat_set.hpp>
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace astar_open_list_reference {
+
+inline constexpr int grid_width = 256;
+inline constexpr int grid_height = 256;
+
+//the open set implementation previously used by the A* pathfinder, kept here as the reference for comparisons
+class flat_set_open_list final
+{
+public:
+	struct entry final
+	{
+		bool operator <(const entry &rhs) const
+		{
+			if (this->costs != rhs.costs) {
+				return this->costs < rhs.costs;
+			}
+
+			if (this->cost_to_goal != rhs.cost_to_goal) {
+				return this->cost_to_goal < rhs.cost_to_goal;
+			}
+
+			if (this->distance != rhs.distance) {
+				return this->distance < rhs.distance;
+			}
+
+			return this->offset < rhs.offset;
+		}
+
+		Vec2i pos;
+		unsigned int offset = 0;
+		int cost_to_goal = 0;
+		int distance = 0;
+		int costs = 0;
+	};
+
+	bool empty() const
+	{
+		return this->set.empty();
+	}
+
+	void push(const Vec2i &pos, const unsigned int offset, const int costs, const int cost_to_goal, const int distance)
+	{
+		for (auto it = this->set.begin(); it != this->set.end(); ++it) {
+			if (it->offset == offset) {
+				this->set.erase(it);
+				break;
+			}
+		}
+
+		this->set.insert(entry{ pos, offset, cost_to_goal, distance, costs });
+	}
+
+	entry pop()
+	{
+		const entry top = *this->set.begin();
+		this->set.erase(this->set.begin());
+		return top;
+	}
+
+	void clear()
+	{
+		this->set.clear();
+	}
+
+private:
+	boost::container::flat_set<entry> set;
+};
+
+//a tile cost grid with scattered obstacles (-1) and rough terrain
+inline std::vector<int> create_cost_grid()
+{
+	std::vector<int> grid(grid_width * grid_height, 1);
+
+	uint32_t seed = 0x2545F491;
+	for (int &cost : grid) {
+		seed = seed * 1103515245 + 12345;
+		const uint32_t value = (seed >> 16) % 100;
+
+		if (value < 20) {
+			cost = -1;
+		} else if (value < 35) {
+			cost = 4;
+		}
+	}
+
+	return grid;
+}
+
+//run an A* search with the same relaxation rules as AStarFindPath, returning the sequence of expanded tile offsets
+template <typename open_list_type>
+std::vector<unsigned int> run_search(open_list_type &open_list, const std::vector<int> &grid, const Vec2i &start_pos, const Vec2i &goal_pos)
+{
+	static constexpr std::array<int, 8> heading_x = { 0, +1, +1, +1, 0, -1, -1, -1 };
+	static constexpr std::array<int, 8> heading_y = { -1, -1, 0, +1, +1, +1, 0, -1 };
+
+	std::vector<int> cost_from_start(grid.size(), 0);
+	std::vector<unsigned int> expanded_offsets;
+
+	const auto cost_to_goal = [&goal_pos](const Vec2i &pos) {
+		return std::max(std::abs(pos.x - goal_pos.x), std::abs(pos.y - goal_pos.y));
+	};
+
+	const auto distance = [&goal_pos](const Vec2i &pos) {
+		return std::abs(pos.x - goal_pos.x) + std::abs(pos.y - goal_pos.y);
+	};
+
+	open_list.clear();
+
+	const unsigned int start_offset = start_pos.y * grid_width + start_pos.x;
+	cost_from_start[start_offset] = 1;
+	open_list.push(start_pos, start_offset, 1 + cost_to_goal(start_pos), cost_to_goal(start_pos), distance(start_pos));
+
+	while (!open_list.empty()) {
+		const auto shortest = open_list.pop();
+		expanded_offsets.push_back(shortest.offset);
+
+		if (shortest.pos == goal_pos) {
+			break;
+		}
+
+		for (size_t i = 0; i < heading_x.size(); ++i) {
+			const Vec2i end_pos(shortest.pos.x + heading_x[i], shortest.pos.y + heading_y[i]);
+
+			if (end_pos.x < 0 || end_pos.x >= grid_width || end_pos.y < 0 || end_pos.y >= grid_height) {
+				continue;
+			}
+
+			const unsigned int end_offset = end_pos.y * grid_width + end_pos.x;
+			if (grid[end_offset] == -1) {
+				continue;
+			}
+
+			const int new_cost = cost_from_start[shortest.offset] + grid[end_offset] + 1;
+
+			if (cost_from_start[end_offset] == 0 || new_cost < cost_from_start[end_offset]) {
+				cost_from_start[end_offset] = new_cost;
+				open_list.push(end_pos, end_offset, new_cost + cost_to_goal(end_pos), cost_to_goal(end_pos), distance(end_pos));
+			}
+		}
+	}
+
+	return expanded_offsets;
+}
+
+inline std::vector<std::pair<Vec2i, Vec2i>> create_start_goal_pairs()
+{
+	std::vector<std::pair<Vec2i, Vec2i>> pairs;
+
+	for (int i = 0; i < 16; ++i) {
+		const Vec2i start_pos((i * 37) % grid_width, (i * 53) % grid_height);
+		const Vec2i goal_pos(grid_width - 1 - (i * 29) % grid_width, grid_height - 1 - (i * 41) % grid_height);
+		pairs.emplace_back(start_pos, goal_pos);
+	}
+
+	return pairs;
+}
+
+}
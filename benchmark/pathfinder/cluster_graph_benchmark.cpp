@@ -0,0 +1,95 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+
+#include "stratagus.h"
+
+#include "pathfinder/cluster_graph.h"
+
+#include "pathfinder/cluster_graph_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(cluster_graph_benchmarks)
+
+using namespace cluster_graph_reference;
+
+static void run_cluster_graph_search_benchmark(const QSize &map_size)
+{
+	const cost_grid grid = create_cost_grid(map_size);
+	const std::vector<std::pair<QPoint, QPoint>> start_goal_pairs = create_start_goal_pairs(grid);
+
+	wyrmgus::cluster_graph graph(map_size, grid.get_cost_function());
+
+	//build the graph before timing, as it is kept between searches in the game
+	for (const auto &[start_pos, goal_pos] : start_goal_pairs) {
+		find_hierarchical_path_cost(graph, grid, start_pos, goal_pos);
+	}
+
+	std::chrono::nanoseconds waypoint_duration(0);
+	std::chrono::nanoseconds first_step_duration(0);
+	std::chrono::nanoseconds grid_duration(0);
+	int64_t hierarchical_total_cost = 0;
+	int64_t grid_total_cost = 0;
+
+	for (const auto &[start_pos, goal_pos] : start_goal_pairs) {
+		auto start_time = std::chrono::steady_clock::now();
+		QPoint waypoint;
+		graph.find_waypoint(start_pos, goal_pos, max_waypoint_distance, waypoint);
+		waypoint_duration += std::chrono::steady_clock::now() - start_time;
+
+		//a unit searching for a path hierarchically refines it on the grid up to the waypoint, and searches again once it has taken the steps stored, as it would with a flat search
+		start_time = std::chrono::steady_clock::now();
+		if (graph.find_waypoint(start_pos, goal_pos, max_waypoint_distance, waypoint)) {
+			find_grid_path_cost(grid, start_pos, waypoint);
+		}
+		first_step_duration += std::chrono::steady_clock::now() - start_time;
+
+		start_time = std::chrono::steady_clock::now();
+		const int grid_cost = find_grid_path_cost(grid, start_pos, goal_pos);
+		grid_duration += std::chrono::steady_clock::now() - start_time;
+
+		const int hierarchical_cost = find_hierarchical_path_cost(graph, grid, start_pos, goal_pos);
+
+		BOOST_CHECK((hierarchical_cost == -1) == (grid_cost == -1));
+
+		if (grid_cost != -1) {
+			hierarchical_total_cost += hierarchical_cost;
+			grid_total_cost += grid_cost;
+		}
+	}
+
+	BOOST_TEST_MESSAGE("Cluster graph benchmark (" << start_goal_pairs.size() << " searches on a " << map_size.width() << "x" << map_size.height() << " map): waypoint on the graph " << std::chrono::duration_cast<std::chrono::microseconds>(waypoint_duration).count() << " us, waypoint and path to it " << std::chrono::duration_cast<std::chrono::microseconds>(first_step_duration).count() << " us, flat grid search " << std::chrono::duration_cast<std::chrono::microseconds>(grid_duration).count() << " us; total cost of the whole paths by waypoints " << hierarchical_total_cost << ", of the flat paths " << grid_total_cost);
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_search_benchmark)
+{
+	run_cluster_graph_search_benchmark(QSize(map_width, map_height));
+	run_cluster_graph_search_benchmark(QSize(1024, 1024));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
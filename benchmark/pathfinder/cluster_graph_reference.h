@@ -0,0 +1,131 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "pathfinder/cluster_graph.h"
+
+#include "pathfinder/pathfinder_test_data.h"
+
+//the flat search used as the reference for the cluster graph benchmark
+namespace cluster_graph_reference {
+
+using namespace pathfinder_test_data;
+
+//get the cost of the cheapest path between two positions with a flat A* search over the grid, or -1 if there is none
+inline int find_grid_path_cost(const cost_grid &grid, const QPoint &start_pos, const QPoint &goal_pos)
+{
+	static constexpr std::array<QPoint, 8> offsets = { QPoint(0, -1), QPoint(1, -1), QPoint(1, 0), QPoint(1, 1), QPoint(0, 1), QPoint(-1, 1), QPoint(-1, 0), QPoint(-1, -1) };
+
+	if (grid.get_cost(start_pos) == -1 || grid.get_cost(goal_pos) == -1) {
+		return -1;
+	}
+
+	const int width = grid.get_size().width();
+	const int height = grid.get_size().height();
+
+	const auto get_index = [width](const QPoint &pos) {
+		return pos.y() * width + pos.x();
+	};
+
+	const auto get_cost_to_goal = [&goal_pos](const QPoint &pos) {
+		return std::max(std::abs(pos.x() - goal_pos.x()), std::abs(pos.y() - goal_pos.y()));
+	};
+
+	std::vector<int> costs(static_cast<size_t>(width * height), -1);
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> open_set;
+
+	costs[get_index(start_pos)] = 0;
+	open_set.emplace(get_cost_to_goal(start_pos), get_index(start_pos));
+
+	while (!open_set.empty()) {
+		const auto [estimated_cost, index] = open_set.top();
+		open_set.pop();
+
+		const QPoint pos(index % width, index / width);
+		const int cost = costs[index];
+
+		if (estimated_cost > cost + get_cost_to_goal(pos)) {
+			continue;
+		}
+
+		if (pos == goal_pos) {
+			return cost;
+		}
+
+		for (const QPoint &offset : offsets) {
+			const QPoint adjacent_pos = pos + offset;
+
+			if (adjacent_pos.x() < 0 || adjacent_pos.x() >= width || adjacent_pos.y() < 0 || adjacent_pos.y() >= height) {
+				continue;
+			}
+
+			const int tile_cost = grid.get_cost(adjacent_pos);
+			if (tile_cost == -1) {
+				continue;
+			}
+
+			const int adjacent_index = get_index(adjacent_pos);
+			const int new_cost = cost + tile_cost;
+
+			if (costs[adjacent_index] == -1 || new_cost < costs[adjacent_index]) {
+				costs[adjacent_index] = new_cost;
+				open_set.emplace(new_cost + get_cost_to_goal(adjacent_pos), adjacent_index);
+			}
+		}
+	}
+
+	return -1;
+}
+
+//get the cost of the path found by moving from waypoint to waypoint of the cluster graph, refining each step with a flat search, as units do when pathfinding hierarchically; returns -1 if there is no path
+inline int find_hierarchical_path_cost(wyrmgus::cluster_graph &graph, const cost_grid &grid, const QPoint &start_pos, const QPoint &goal_pos)
+{
+	QPoint pos = start_pos;
+	int total_cost = 0;
+
+	//the number of steps is bounded, so that a faulty graph can't make the search loop forever
+	for (int i = 0; i < grid.get_size().width() * grid.get_size().height(); ++i) {
+		QPoint waypoint;
+		if (!graph.find_waypoint(pos, goal_pos, max_waypoint_distance, waypoint)) {
+			const int cost = find_grid_path_cost(grid, pos, goal_pos);
+			return cost != -1 ? total_cost + cost : -1;
+		}
+
+		const int cost = find_grid_path_cost(grid, pos, waypoint);
+		if (cost == -1) {
+			return -1;
+		}
+
+		total_cost += cost;
+		pos = waypoint;
+	}
+
+	return -1;
+}
+
+}
@@ -0,0 +1,60 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/pathfinder.h"
+
+#include "pathfinder/terrain_traversal_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(terrain_traversal_benchmarks)
+
+using namespace terrain_traversal_reference;
+
+BOOST_AUTO_TEST_CASE(terrain_traversal_resource_search_benchmark)
+{
+	const std::vector<uint8_t> map = create_map();
+
+	const std::vector<Vec2i> worker_positions = create_worker_positions(map);
+
+	auto start_time = std::chrono::steady_clock::now();
+	const int64_t clearing_checksum = find_resources<clearing_terrain_traversal>(map, worker_positions);
+	const std::chrono::nanoseconds clearing_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	const int64_t checksum = find_resources<TerrainTraversal>(map, worker_positions);
+	const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start_time;
+
+	//both traversals must find the same resources
+	BOOST_CHECK(checksum == clearing_checksum);
+
+	BOOST_TEST_MESSAGE("Terrain traversal benchmark (" << worker_count << " resource searches on a " << map_width << "x" << map_height << " map): generation-stamped " << std::chrono::duration_cast<std::chrono::microseconds>(duration).count() << " us, clearing " << std::chrono::duration_cast<std::chrono::microseconds>(clearing_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,234 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "pathfinder/pathfinder.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace terrain_traversal_reference {
+
+inline constexpr int map_width = 512;
+inline constexpr int map_height = 512;
+inline constexpr int worker_count = 2000;
+
+//the traversal implementation previously used, which cleared its whole grid for each search, kept here as the reference for comparisons
+class clearing_terrain_traversal final
+{
+public:
+	void SetSize(const unsigned int width, const unsigned int height)
+	{
+		this->values.resize((width + 2) * (height + 2));
+		this->extended_width = width + 2;
+		this->height = height;
+	}
+
+	void Init()
+	{
+		const unsigned int width = this->extended_width - 2;
+
+		std::fill(this->values.begin(), this->values.begin() + this->extended_width, -1);
+		for (unsigned int y = 1; y < 1 + this->height; ++y) {
+			this->values[y * this->extended_width] = -1;
+			std::fill_n(this->values.begin() + y * this->extended_width + 1, width, 0);
+			this->values[y * this->extended_width + width + 1] = -1;
+		}
+		std::fill(this->values.end() - this->extended_width, this->values.end(), -1);
+
+		this->queue = {};
+	}
+
+	void PushPos(const Vec2i &pos)
+	{
+		if (!this->IsVisited(pos)) {
+			this->queue.push(PosNode(pos, pos));
+			this->Set(pos, 1);
+		}
+	}
+
+	void PushNeighbor(const Vec2i &pos)
+	{
+		static constexpr std::array<Vec2i, 8> offsets = { Vec2i(0, -1), Vec2i(-1, 0), Vec2i(1, 0), Vec2i(0, 1), Vec2i(-1, -1), Vec2i(1, -1), Vec2i(-1, 1), Vec2i(1, 1) };
+
+		for (const Vec2i &offset : offsets) {
+			const Vec2i new_pos = pos + offset;
+
+			if (!this->IsVisited(new_pos)) {
+				this->queue.push(PosNode(new_pos, pos));
+				this->Set(new_pos, this->Get(pos) + 1);
+			}
+		}
+	}
+
+	template <typename T>
+	bool Run(T &context)
+	{
+		for (; !this->queue.empty(); this->queue.pop()) {
+			const PosNode &pos_node = this->queue.front();
+
+			switch (context.Visit(*this, pos_node.pos, pos_node.from)) {
+				case VisitResult::Finished: return true;
+				case VisitResult::DeadEnd: this->Set(pos_node.pos, -1); break;
+				case VisitResult::Ok: this->PushNeighbor(pos_node.pos); break;
+				case VisitResult::Cancel: return false;
+			}
+		}
+		return false;
+	}
+
+	bool IsVisited(const Vec2i &pos) const
+	{
+		return this->Get(pos) != 0;
+	}
+
+	short int Get(const Vec2i &pos) const
+	{
+		return this->values[this->extended_width + 1 + pos.y * this->extended_width + pos.x];
+	}
+
+private:
+	void Set(const Vec2i &pos, const short int value)
+	{
+		this->values[this->extended_width + 1 + pos.y * this->extended_width + pos.x] = value;
+	}
+
+	struct PosNode final
+	{
+		PosNode(const Vec2i &pos, const Vec2i &from) : pos(pos), from(from)
+		{
+		}
+
+		Vec2i pos;
+		Vec2i from;
+	};
+
+	std::vector<short int> values;
+	std::queue<PosNode> queue;
+	unsigned int extended_width = 0;
+	unsigned int height = 0;
+};
+
+//a map with obstacles (1) and scattered resources (2)
+inline std::vector<uint8_t> create_map()
+{
+	std::vector<uint8_t> map(map_width * map_height, 0);
+
+	uint32_t seed = 0x2545F491;
+	for (uint8_t &tile : map) {
+		seed = seed * 1103515245 + 12345;
+		const uint32_t value = (seed >> 16) % 1000;
+
+		if (value < 200) {
+			tile = 1;
+		} else if (value < 203) {
+			tile = 2;
+		}
+	}
+
+	return map;
+}
+
+//a reduced version of the resource finder's visit logic: finds the nearest resource tile within range through passable tiles
+class resource_tile_finder final
+{
+public:
+	explicit resource_tile_finder(const std::vector<uint8_t> &map, const int max_range) : map(map), max_range(max_range)
+	{
+	}
+
+	template <typename traversal_type>
+	VisitResult Visit(traversal_type &terrain_traversal, const Vec2i &pos, const Vec2i &from)
+	{
+		Q_UNUSED(from);
+
+		if (pos.x < 0 || pos.y < 0 || pos.x >= map_width || pos.y >= map_height) {
+			return VisitResult::DeadEnd;
+		}
+
+		const uint8_t tile = this->map[pos.y * map_width + pos.x];
+
+		if (tile == 2) {
+			this->result_pos = pos;
+			return VisitResult::Finished;
+		}
+
+		if (tile == 1) {
+			return VisitResult::DeadEnd;
+		}
+
+		if (terrain_traversal.Get(pos) >= this->max_range) {
+			return VisitResult::DeadEnd;
+		}
+
+		return VisitResult::Ok;
+	}
+
+	const std::vector<uint8_t> &map;
+	const int max_range = 0;
+	Vec2i result_pos = Vec2i(-1, -1);
+};
+
+//find the nearest resource for each worker, returning a checksum of the results
+template <typename traversal_type>
+int64_t find_resources(const std::vector<uint8_t> &map, const std::vector<Vec2i> &worker_positions)
+{
+	int64_t checksum = 0;
+
+	for (const Vec2i &worker_pos : worker_positions) {
+		traversal_type terrain_traversal;
+		terrain_traversal.SetSize(map_width, map_height);
+		terrain_traversal.Init();
+		terrain_traversal.PushPos(worker_pos);
+
+		resource_tile_finder finder(map, 64);
+		if (terrain_traversal.Run(finder)) {
+			checksum += finder.result_pos.y * map_width + finder.result_pos.x;
+		} else {
+			checksum -= 1;
+		}
+	}
+
+	return checksum;
+}
+
+//the positions of the workers looking for resources, on passable tiles spread throughout the map
+inline std::vector<Vec2i> create_worker_positions(const std::vector<uint8_t> &map)
+{
+	std::vector<Vec2i> worker_positions;
+
+	for (int i = 0; i < worker_count; ++i) {
+		Vec2i pos((i * 37) % map_width, (i * 53) % map_height);
+		while (map[pos.y * map_width + pos.x] != 0) {
+			pos.x = (pos.x + 1) % map_width;
+		}
+		worker_positions.push_back(pos);
+	}
+
+	return worker_positions;
+}
+
+}
@@ -0,0 +1,71 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/fenwick_tree.h"
+
+#include "util/fenwick_tree_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(fenwick_tree_benchmarks)
+
+using namespace fenwick_tree_reference;
+
+BOOST_AUTO_TEST_CASE(fenwick_tree_trigger_selection_benchmark)
+{
+	const std::vector<int> weights = create_trigger_weights();
+
+	wyrmgus::fenwick_tree tree;
+	std::vector<int> tree_weights;
+
+	std::mt19937 expanded_rng(42);
+	std::mt19937 tree_rng(42);
+
+	std::vector<int> expanded_results;
+	std::vector<int> tree_results;
+
+	auto start_time = std::chrono::steady_clock::now();
+	for (int check = 0; check < check_count; ++check) {
+		expanded_results.push_back(select_with_expanded_vector(weights, check, expanded_rng));
+	}
+	const std::chrono::nanoseconds expanded_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	for (int check = 0; check < check_count; ++check) {
+		tree_results.push_back(select_with_fenwick_tree(tree, tree_weights, weights, check, tree_rng));
+	}
+	const std::chrono::nanoseconds tree_duration = std::chrono::steady_clock::now() - start_time;
+
+	//with the same random number sequence, both methods must select exactly the same triggers
+	BOOST_CHECK(expanded_results == tree_results);
+
+	BOOST_TEST_MESSAGE("Random trigger selection benchmark (" << check_count << " checks over " << trigger_count << " triggers): Fenwick tree " << std::chrono::duration_cast<std::chrono::microseconds>(tree_duration).count() << " us, expanded vector " << std::chrono::duration_cast<std::chrono::microseconds>(expanded_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
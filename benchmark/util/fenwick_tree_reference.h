@@ -0,0 +1,105 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/fenwick_tree.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace fenwick_tree_reference {
+
+//a synthetic random trigger set, with the default random weight for most triggers, and a null entry weight for no trigger firing
+inline constexpr int trigger_count = 300;
+inline constexpr int none_random_weight = 1000;
+inline constexpr int check_count = 500;
+
+inline std::vector<int> create_trigger_weights()
+{
+	std::vector<int> weights;
+
+	for (int i = 0; i < trigger_count; ++i) {
+		weights.push_back(i % 7 == 0 ? 300 : 100);
+	}
+
+	return weights;
+}
+
+//whether the conditions of a trigger are fulfilled; most random triggers fail their conditions, which is what makes repeated selection expensive
+inline bool check_trigger(const int trigger_index, const int check)
+{
+	return (trigger_index * 31 + check * 17) % 53 == 0;
+}
+
+//select a trigger in the way it was done before, by repeating each trigger in a vector as many times as its weight, and erasing it if it fails; returns -1 if no trigger fired
+inline int select_with_expanded_vector(const std::vector<int> &weights, const int check, std::mt19937 &rng)
+{
+	std::vector<int> random_triggers;
+
+	for (size_t i = 0; i < weights.size(); ++i) {
+		for (int j = 0; j < weights[i]; ++j) {
+			random_triggers.push_back(static_cast<int>(i));
+		}
+	}
+
+	for (int i = 0; i < none_random_weight; ++i) {
+		random_triggers.push_back(-1);
+	}
+
+	while (!random_triggers.empty()) {
+		const int trigger_index = random_triggers[std::uniform_int_distribution<int>(0, static_cast<int>(random_triggers.size()) - 1)(rng)];
+
+		if (trigger_index == -1 || check_trigger(trigger_index, check)) {
+			return trigger_index;
+		}
+
+		std::erase(random_triggers, trigger_index);
+	}
+
+	return -1;
+}
+
+inline int select_with_fenwick_tree(wyrmgus::fenwick_tree &tree, std::vector<int> &tree_weights, const std::vector<int> &weights, const int check, std::mt19937 &rng)
+{
+	tree_weights = weights;
+	tree_weights.push_back(none_random_weight);
+	tree.assign(tree_weights);
+
+	while (tree.get_total_weight() > 0) {
+		const size_t index = tree.find(std::uniform_int_distribution<int>(0, tree.get_total_weight() - 1)(rng));
+		const int trigger_index = index == weights.size() ? -1 : static_cast<int>(index);
+
+		if (trigger_index == -1 || check_trigger(trigger_index, check)) {
+			return trigger_index;
+		}
+
+		tree.remove(index);
+	}
+
+	return -1;
+}
+
+}
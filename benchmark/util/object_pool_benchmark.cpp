@@ -0,0 +1,60 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/object_pool.h"
+
+#include "util/object_pool_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(object_pool_benchmarks)
+
+using namespace object_pool_reference;
+
+BOOST_AUTO_TEST_CASE(object_pool_missile_cycle_benchmark)
+{
+	erase_missile_table erase_table;
+	pool_missile_table pool_table;
+
+	auto start_time = std::chrono::steady_clock::now();
+	const std::vector<int> erase_hits = run_cycles(erase_table);
+	const std::chrono::nanoseconds erase_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	const std::vector<int> pool_hits = run_cycles(pool_table);
+	const std::chrono::nanoseconds pool_duration = std::chrono::steady_clock::now() - start_time;
+
+	//missiles must hit in exactly the same order
+	BOOST_CHECK(erase_hits == pool_hits);
+	BOOST_CHECK(pool_table.get_pool_size() > 0);
+
+	BOOST_TEST_MESSAGE("Missile storage benchmark (" << cycle_count << " cycles): object pool " << std::chrono::duration_cast<std::chrono::microseconds>(pool_duration).count() << " us, individual allocation with erasure " << std::chrono::duration_cast<std::chrono::microseconds>(erase_duration).count() << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
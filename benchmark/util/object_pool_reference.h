@@ -0,0 +1,195 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/object_pool.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace object_pool_reference {
+
+inline constexpr int cycle_count = 2000;
+
+//a stand-in for a missile, with derived classes which differ only in their action
+class test_missile
+{
+public:
+	virtual ~test_missile()
+	{
+	}
+
+	virtual void action(std::vector<int> &hits) = 0;
+
+	int id = 0;
+	int ttl = 0;
+	int wait = 1;
+	std::array<char, 128> padding{};
+};
+
+class test_missile_hit final : public test_missile
+{
+public:
+	virtual void action(std::vector<int> &hits) override
+	{
+		hits.push_back(this->id);
+		this->ttl = 0;
+	}
+};
+
+class test_missile_fly final : public test_missile
+{
+public:
+	virtual void action(std::vector<int> &hits) override
+	{
+		if (this->ttl % 4 == 0) {
+			hits.push_back(this->id);
+		}
+	}
+};
+
+//the previous missile storage, with each missile allocated on its own and removed from the table as soon as it expires
+class erase_missile_table final
+{
+public:
+	void create(const int id, const int ttl, const bool hit)
+	{
+		std::unique_ptr<test_missile> missile;
+		if (hit) {
+			missile = std::make_unique<test_missile_hit>();
+		} else {
+			missile = std::make_unique<test_missile_fly>();
+		}
+		missile->id = id;
+		missile->ttl = ttl;
+		this->missiles.push_back(std::move(missile));
+	}
+
+	void run_cycle(std::vector<int> &hits)
+	{
+		for (size_t i = 0; i != this->missiles.size(); /* empty */) {
+			test_missile &missile = *this->missiles[i];
+
+			if (--missile.ttl == 0) {
+				this->missiles.erase(this->missiles.begin() + i);
+				continue;
+			}
+
+			missile.action(hits);
+			if (missile.ttl == 0) {
+				this->missiles.erase(this->missiles.begin() + i);
+				continue;
+			}
+			++i;
+		}
+	}
+
+private:
+	std::vector<std::unique_ptr<test_missile>> missiles;
+};
+
+//the missile storage in an object pool, with expired missiles removed from the table in a single pass after the cycle
+class pool_missile_table final
+{
+public:
+	~pool_missile_table()
+	{
+		for (test_missile *missile : this->missiles) {
+			this->pool.destroy(missile);
+		}
+	}
+
+	void create(const int id, const int ttl, const bool hit)
+	{
+		test_missile *missile = nullptr;
+		if (hit) {
+			missile = this->pool.create<test_missile_hit>();
+		} else {
+			missile = this->pool.create<test_missile_fly>();
+		}
+		missile->id = id;
+		missile->ttl = ttl;
+		this->missiles.push_back(missile);
+	}
+
+	void run_cycle(std::vector<int> &hits)
+	{
+		bool has_expired_missiles = false;
+
+		for (size_t i = 0; i != this->missiles.size(); ++i) {
+			test_missile &missile = *this->missiles[i];
+
+			if (--missile.ttl == 0) {
+				this->pool.destroy(this->missiles[i]);
+				this->missiles[i] = nullptr;
+				has_expired_missiles = true;
+				continue;
+			}
+
+			missile.action(hits);
+			if (missile.ttl == 0) {
+				this->pool.destroy(this->missiles[i]);
+				this->missiles[i] = nullptr;
+				has_expired_missiles = true;
+			}
+		}
+
+		if (has_expired_missiles) {
+			std::erase(this->missiles, nullptr);
+		}
+	}
+
+	size_t get_pool_size() const
+	{
+		return this->pool.size();
+	}
+
+private:
+	wyrmgus::object_pool<test_missile> pool;
+	std::vector<test_missile *> missiles;
+};
+
+//run cycles in which missiles are fired in volleys and expire; returns the order in which missiles hit, which must be the same regardless of the storage
+template <typename missile_table_type>
+std::vector<int> run_cycles(missile_table_type &missile_table)
+{
+	std::vector<int> hits;
+	int next_id = 0;
+
+	for (int cycle = 1; cycle <= cycle_count; ++cycle) {
+		for (int i = 0; i < 100; ++i) {
+			const int ttl = 10 + (cycle * 7 + i * 13) % 90;
+			missile_table.create(next_id, ttl, (next_id % 3) == 0);
+			++next_id;
+		}
+
+		missile_table.run_cycle(hits);
+	}
+
+	return hits;
+}
+
+}
@@ -0,0 +1,60 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/slab_storage.h"
+
+#include "util/slab_storage_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(slab_storage_benchmarks)
+
+using namespace slab_storage_reference;
+
+BOOST_AUTO_TEST_CASE(slab_storage_unit_cycle_benchmark)
+{
+	test_unit_manager heap_unit_manager(false);
+	test_unit_manager slab_unit_manager(true);
+
+	auto start_time = std::chrono::steady_clock::now();
+	const uint64_t heap_checksum = run_cycles(heap_unit_manager);
+	const std::chrono::nanoseconds heap_duration = std::chrono::steady_clock::now() - start_time;
+
+	start_time = std::chrono::steady_clock::now();
+	const uint64_t slab_checksum = run_cycles(slab_unit_manager);
+	const std::chrono::nanoseconds slab_duration = std::chrono::steady_clock::now() - start_time;
+
+	//released units are only reused after the release delay, in the same order, so both must end up with the same slots
+	BOOST_CHECK(heap_checksum == slab_checksum);
+	BOOST_CHECK(heap_unit_manager.slot_count() == slab_unit_manager.slot_count());
+
+	BOOST_TEST_MESSAGE("Unit cycle benchmark (" << cycle_count << " cycles over " << unit_count << " units): slab allocation " << std::chrono::duration_cast<std::chrono::microseconds>(slab_duration).count() / cycle_count << " us per cycle, heap allocation " << std::chrono::duration_cast<std::chrono::microseconds>(heap_duration).count() / cycle_count << " us per cycle");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
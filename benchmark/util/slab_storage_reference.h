@@ -0,0 +1,174 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/slab_storage.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace slab_storage_reference {
+
+inline constexpr int unit_count = 4000;
+inline constexpr int cycle_count = 2000;
+inline constexpr unsigned long release_delay = 500;
+
+//a stand-in for a unit, with a similar size, and the fields touched each cycle at different offsets
+struct test_unit final
+{
+	explicit test_unit(int &destruction_count) : destruction_count(&destruction_count)
+	{
+	}
+
+	~test_unit()
+	{
+		++(*this->destruction_count);
+	}
+
+	int *destruction_count = nullptr;
+	int slot = -1;
+	int units_slot = -1;
+	unsigned long release_cycle = 0;
+	int hp = 100;
+	std::array<char, 512> padding_1{};
+	int wait = 0;
+	std::array<char, 1024> padding_2{};
+	int frame = 0;
+};
+
+//a reduced version of the unit manager's allocation and release logic, with slot storage either in slabs or with each unit allocated on its own
+class test_unit_manager final
+{
+public:
+	explicit test_unit_manager(const bool slab_allocation) : slab_allocation(slab_allocation)
+	{
+	}
+
+	test_unit *alloc_unit(const unsigned long cycle)
+	{
+		test_unit *unit = nullptr;
+
+		if (!this->released_units.empty() && this->released_units.front()->release_cycle < cycle) {
+			unit = this->released_units.front();
+			this->released_units.pop_front();
+			unit->release_cycle = 0;
+		} else {
+			const int slot = static_cast<int>(this->slot_count());
+
+			if (this->slab_allocation) {
+				unit = this->unit_slab_slots.emplace_back(this->destruction_count);
+			} else {
+				this->unit_slots.push_back(std::make_unique<test_unit>(this->destruction_count));
+				unit = this->unit_slots.back().get();
+
+				//other allocations of varying sizes happen between unit allocations in the game, e.g. for orders, paths and variables, and some of them are freed again, so that units end up scattered across the heap
+				const size_t other_allocation_size = std::uniform_int_distribution<size_t>(16, 4096)(this->rng);
+				this->other_allocations.push_back(std::make_unique<char[]>(other_allocation_size));
+
+				if (this->rng() % 2 == 0) {
+					this->other_allocations[this->rng() % this->other_allocations.size()].reset();
+				}
+			}
+
+			unit->slot = slot;
+		}
+
+		unit->units_slot = static_cast<int>(this->units.size());
+		this->units.push_back(unit);
+		return unit;
+	}
+
+	void release_unit(test_unit *unit, const unsigned long cycle)
+	{
+		test_unit *last_unit = this->units.back();
+		last_unit->units_slot = unit->units_slot;
+		this->units[unit->units_slot] = last_unit;
+		this->units.pop_back();
+		unit->units_slot = -1;
+
+		unit->release_cycle = cycle + release_delay;
+		this->released_units.push_back(unit);
+	}
+
+	size_t slot_count() const
+	{
+		return this->slab_allocation ? this->unit_slab_slots.size() : this->unit_slots.size();
+	}
+
+	const std::vector<test_unit *> &get_units() const
+	{
+		return this->units;
+	}
+
+private:
+	int destruction_count = 0;
+	const bool slab_allocation = true;
+	std::vector<test_unit *> units;
+	wyrmgus::slab_storage<test_unit, 64> unit_slab_slots;
+	std::vector<std::unique_ptr<test_unit>> unit_slots;
+	std::vector<std::unique_ptr<char[]>> other_allocations;
+	std::mt19937 rng = std::mt19937(42);
+	std::deque<test_unit *> released_units;
+};
+
+//run game cycles which touch each unit, and release and allocate units regularly; returns a checksum of the visited unit slots, which must be the same regardless of the allocation method
+inline uint64_t run_cycles(test_unit_manager &unit_manager)
+{
+	uint64_t checksum = 0;
+
+	for (int i = 0; i < unit_count; ++i) {
+		unit_manager.alloc_unit(0);
+	}
+
+	for (unsigned long cycle = 1; cycle <= cycle_count; ++cycle) {
+		for (test_unit *unit : unit_manager.get_units()) {
+			if (unit->wait > 0) {
+				--unit->wait;
+				continue;
+			}
+
+			unit->frame = (unit->frame + 1) % 8;
+			unit->wait = unit->slot % 3;
+			checksum += static_cast<uint64_t>(unit->slot);
+		}
+
+		//units dying and being trained
+		if (cycle % 10 == 0) {
+			for (int i = 0; i < 20; ++i) {
+				const std::vector<test_unit *> &units = unit_manager.get_units();
+				unit_manager.release_unit(units[(cycle * 7 + i * 13) % units.size()], cycle);
+			}
+
+			for (int i = 0; i < 20; ++i) {
+				unit_manager.alloc_unit(cycle);
+			}
+		}
+	}
+
+	return checksum;
+}
+
+}
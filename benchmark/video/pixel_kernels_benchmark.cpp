@@ -0,0 +1,122 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/pixel_kernels.h"
+
+#include "video/pixel_kernels_reference.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(pixel_kernels_benchmarks)
+
+using namespace pixel_kernels_reference;
+
+namespace {
+
+//sprite-like images: a transparent background, with a body of shaded colors and player color shades
+std::vector<std::vector<uint32_t>> create_sprite_images(const std::vector<rgb_color> &player_colors)
+{
+	static constexpr int image_size = 256;
+	static constexpr int image_count = 64;
+
+	std::vector<std::vector<uint32_t>> images;
+	uint32_t seed = 0x1234567;
+
+	for (int i = 0; i < image_count; ++i) {
+		std::vector<uint32_t> image(image_size * image_size, 0);
+
+		for (int y = 0; y < image_size; ++y) {
+			for (int x = 0; x < image_size; ++x) {
+				const int dx = x - image_size / 2;
+				const int dy = y - image_size / 2;
+
+				if (dx * dx + dy * dy > (image_size / 3) * (image_size / 3)) {
+					continue;
+				}
+
+				seed = seed * 1103515245 + 12345;
+				const uint32_t random_value = seed >> 8;
+
+				if (random_value % 4 == 0) {
+					image[y * image_size + x] = to_rgb(player_colors[random_value % player_colors.size()]) | 0xFF000000;
+				} else {
+					image[y * image_size + x] = (random_value & 0xFFFFFF) | 0xFF000000;
+				}
+			}
+		}
+
+		images.push_back(std::move(image));
+	}
+
+	return images;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_sprite_benchmark)
+{
+	const std::vector<std::vector<uint32_t>> images = create_sprite_images(conversible_colors);
+	const std::vector<color_swap> color_swaps = create_color_swaps(conversible_colors, blue_colors);
+
+	const auto measure = [&images](const std::function<void(std::vector<uint32_t> &)> &function) {
+		std::vector<std::vector<uint32_t>> image_copies = images;
+
+		const auto start_time = std::chrono::steady_clock::now();
+		for (std::vector<uint32_t> &image : image_copies) {
+			function(image);
+		}
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+	};
+
+	BOOST_TEST_MESSAGE("Pixel kernel benchmark (" << images.size() << " sprites of " << images.front().size() << " pixels), in us:");
+
+	BOOST_TEST_MESSAGE("  reference: player color " << measure([](std::vector<uint32_t> &image) {
+		apply_player_color_reference(reinterpret_cast<unsigned char *>(image.data()), image.size(), conversible_colors, blue_colors);
+	}) << ", grayscale " << measure([](std::vector<uint32_t> &image) {
+		apply_grayscale_reference(reinterpret_cast<unsigned char *>(image.data()), image.size());
+	}) << ", sepia " << measure([](std::vector<uint32_t> &image) {
+		apply_sepia_reference(reinterpret_cast<unsigned char *>(image.data()), image.size());
+	}) << ", RGB change " << measure([](std::vector<uint32_t> &image) {
+		apply_rgb_change_reference(reinterpret_cast<unsigned char *>(image.data()), image.size(), 20, -20, 10);
+	}));
+
+	for (const simd_level level : get_simd_levels()) {
+		BOOST_TEST_MESSAGE("  " << wyrmgus::pixel_kernels::get_simd_level_name(level) << ": player color " << measure([&color_swaps, level](std::vector<uint32_t> &image) {
+			wyrmgus::pixel_kernels::apply_color_swaps(image.data(), image.size(), color_swaps, level);
+		}) << ", grayscale " << measure([level](std::vector<uint32_t> &image) {
+			wyrmgus::pixel_kernels::apply_grayscale(image.data(), image.size(), level);
+		}) << ", sepia " << measure([level](std::vector<uint32_t> &image) {
+			wyrmgus::pixel_kernels::apply_sepia(image.data(), image.size(), level);
+		}) << ", RGB change " << measure([level](std::vector<uint32_t> &image) {
+			wyrmgus::pixel_kernels::apply_rgb_change(image.data(), image.size(), 20, -20, 10, level);
+		}));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "video/pixel_kernels.h"
+
+//the reference implementation which the benchmark compares against, and its test data
+namespace pixel_kernels_reference {
+
+using wyrmgus::pixel_kernels::color_swap;
+using wyrmgus::pixel_kernels::simd_level;
+
+
+//the per-pixel code used before the kernels were vectorized, kept here as the reference for bit-exactness
+inline void apply_grayscale_reference(unsigned char *image_data, const size_t pixel_count)
+{
+	const double redGray = 0.21;
+	const double greenGray = 0.72;
+	const double blueGray = 0.07;
+
+	for (size_t i = 0; i < pixel_count; ++i) {
+		unsigned char &red = image_data[i * 4];
+		unsigned char &green = image_data[i * 4 + 1];
+		unsigned char &blue = image_data[i * 4 + 2];
+
+		const int gray = redGray * red + greenGray * green + blueGray * blue;
+		red = gray;
+		green = gray;
+		blue = gray;
+	}
+}
+
+inline void apply_sepia_reference(unsigned char *image_data, const size_t pixel_count)
+{
+	for (size_t i = 0; i < pixel_count; ++i) {
+		unsigned char &red = image_data[i * 4];
+		unsigned char &green = image_data[i * 4 + 1];
+		unsigned char &blue = image_data[i * 4 + 2];
+
+		const int input_red = red;
+		const int input_green = green;
+		const int input_blue = blue;
+
+		red = std::min<int>(255, (input_red * .393) + (input_green * .769) + (input_blue * .189));
+		green = std::min<int>(255, (input_red * .349) + (input_green * .686) + (input_blue * .168));
+		blue = std::min<int>(255, (input_red * .272) + (input_green * .534) + (input_blue * .131));
+	}
+}
+
+inline void apply_rgb_change_reference(unsigned char *image_data, const size_t pixel_count, const int red_change, const int green_change, const int blue_change)
+{
+	for (size_t i = 0; i < pixel_count * 4; i += 4) {
+		unsigned char &red = image_data[i];
+		unsigned char &green = image_data[i + 1];
+		unsigned char &blue = image_data[i + 2];
+
+		red = std::clamp<int>(red + red_change, 0, 255);
+		green = std::clamp<int>(green + green_change, 0, 255);
+		blue = std::clamp<int>(blue + blue_change, 0, 255);
+	}
+}
+
+using rgb_color = std::array<unsigned char, 3>;
+
+inline void apply_player_color_reference(unsigned char *image_data, const size_t pixel_count, const std::vector<rgb_color> &conversible_colors, const std::vector<rgb_color> &colors)
+{
+	for (size_t i = 0; i < pixel_count * 4; i += 4) {
+		unsigned char &red = image_data[i];
+		unsigned char &green = image_data[i + 1];
+		unsigned char &blue = image_data[i + 2];
+
+		for (size_t z = 0; z < conversible_colors.size(); ++z) {
+			const rgb_color &color = conversible_colors[z];
+			if (red == color[0] && green == color[1] && blue == color[2]) {
+				red = colors[z][0];
+				green = colors[z][1];
+				blue = colors[z][2];
+			}
+		}
+	}
+}
+
+inline uint32_t to_rgb(const rgb_color &color)
+{
+	return static_cast<uint32_t>(color[0]) | (static_cast<uint32_t>(color[1]) << 8) | (static_cast<uint32_t>(color[2]) << 16);
+}
+
+//build the swap table in the same way as player_color::get_color_swaps
+inline std::vector<color_swap> create_color_swaps(const std::vector<rgb_color> &conversible_colors, const std::vector<rgb_color> &colors)
+{
+	std::vector<color_swap> color_swaps;
+
+	for (const rgb_color &conversible_color : conversible_colors) {
+		const uint32_t rgb = to_rgb(conversible_color);
+
+		if (std::find_if(color_swaps.begin(), color_swaps.end(), [rgb](const color_swap &swap) { return swap.rgb == rgb; }) != color_swaps.end()) {
+			continue;
+		}
+
+		uint32_t new_rgb = rgb;
+		for (size_t z = 0; z < conversible_colors.size(); ++z) {
+			if (new_rgb == to_rgb(conversible_colors[z])) {
+				new_rgb = to_rgb(colors[z]);
+			}
+		}
+
+		if (new_rgb != rgb) {
+			color_swaps.push_back(color_swap{ rgb, new_rgb });
+		}
+	}
+
+	return color_swaps;
+}
+
+inline std::vector<simd_level> get_simd_levels()
+{
+	std::vector<simd_level> levels = { simd_level::scalar };
+
+	if (wyrmgus::pixel_kernels::get_supported_simd_level() >= simd_level::sse2) {
+		levels.push_back(simd_level::sse2);
+	}
+
+	if (wyrmgus::pixel_kernels::get_supported_simd_level() >= simd_level::avx2) {
+		levels.push_back(simd_level::avx2);
+	}
+
+	return levels;
+}
+
+inline const std::vector<rgb_color> conversible_colors = {
+	{ 164, 0, 0 }, { 124, 0, 0 }, { 92, 4, 0 }, { 68, 4, 0 }, { 208, 0, 0 }, { 60, 0, 0 }, { 248, 0, 0 }
+};
+
+inline const std::vector<rgb_color> blue_colors = {
+	{ 0, 0, 252 }, { 0, 4, 196 }, { 0, 4, 140 }, { 0, 4, 84 }, { 0, 0, 248 }, { 0, 0, 56 }, { 164, 0, 0 }
+};
+
+}
@@ -47,6 +47,7 @@
 #include "map/tile.h"
 #include "map/tile_flag.h"
 #include "missile.h"
+#include "pathfinder/flow_field.h"
 #include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "player/player_type.h"
@@ -235,7 +236,7 @@ bool COrder_Attack::IsValid() const
 	}
 }
 
-PixelPos COrder_Attack::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Attack::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->has_goal()) {
 		if (this->get_goal()->MapLayer != UI.CurrentMapLayer) {
@@ -275,6 +276,13 @@ QColor COrder_Attack::get_shown_target_color() const
 }
 
 void COrder_Attack::UpdatePathFinderData(PathFinderInput &input)
+{
+	this->update_path_finder_goal(input);
+
+	input.set_flow_field(flow_field::get_for_order(this->goal_flow_field, input));
+}
+
+bool COrder_Attack::update_path_finder_goal(PathFinderInput &input) const
 {
 	Vec2i tileSize;
 	if (this->has_goal()) {
@@ -301,6 +309,8 @@ void COrder_Attack::UpdatePathFinderData(PathFinderInput &input)
 		}
 	}
 	input.SetMaxRange(distance);
+
+	return true;
 }
 
 void COrder_Attack::OnAnimationAttack(CUnit &unit)
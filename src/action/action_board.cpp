@@ -111,7 +111,7 @@ bool COrder_Board::IsValid() const
 	return this->has_goal() && this->get_goal()->IsAliveOnMap();
 }
 
-PixelPos COrder_Board::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Board::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->has_goal()) {
 		if (this->get_goal()->MapLayer != UI.CurrentMapLayer) {
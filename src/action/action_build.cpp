@@ -179,7 +179,7 @@ bool COrder_Build::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Build::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Build::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->MapLayer != UI.CurrentMapLayer->ID) {
 		return lastScreenPos;
@@ -416,6 +416,7 @@ bool COrder_Build::StartBuilding(CUnit &unit, CUnit &ontop)
 	build->UnderConstruction = 1;
 	build->CurrentSightRange = 0;
 	build->MapLayer = CMap::get()->MapLayers[this->MapLayer].get();
+	build->invalidate_derived_stats();
 
 	// Building on top of something, may remove what is beneath it
 	if (&ontop != &unit) {
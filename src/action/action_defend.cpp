@@ -121,7 +121,7 @@ bool COrder_Defend::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Defend::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Defend::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->has_goal()) {
 		if (this->get_goal()->MapLayer != UI.CurrentMapLayer) {
@@ -68,7 +68,7 @@ bool COrder_Die::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Die::Show(const CViewport &, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Die::Show(const CViewport &, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(render_commands)
 
@@ -132,6 +132,7 @@ void COrder_Die::Execute(CUnit &unit)
 	unit.Stats = &corpse_type->Stats[unit.Player->get_index()];
 	//Wyrmgus start
 	unit.Variable = corpse_type->Stats[unit.Player->get_index()].Variables;
+	unit.invalidate_derived_stats();
 	//Wyrmgus end
 	UpdateUnitSightRange(unit);
 	//Wyrmgus start
@@ -123,7 +123,7 @@ bool COrder_Follow::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Follow::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Follow::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->has_goal()) {
 		if (this->get_goal()->MapLayer != UI.CurrentMapLayer) {
@@ -148,6 +148,11 @@ QPoint COrder_Follow::get_shown_target_pos(const CViewport &vp) const
 }
 
 void COrder_Follow::UpdatePathFinderData(PathFinderInput &input)
+{
+	this->update_path_finder_goal(input);
+}
+
+bool COrder_Follow::update_path_finder_goal(PathFinderInput &input) const
 {
 	input.SetMinRange(0);
 	input.SetMaxRange(this->Range);
@@ -162,6 +167,8 @@ void COrder_Follow::UpdatePathFinderData(PathFinderInput &input)
 		tileSize.y = 0;
 		input.SetGoal(this->goalPos, tileSize, this->MapLayer);
 	}
+
+	return true;
 }
 
 void COrder_Follow::Execute(CUnit &unit)
@@ -42,6 +42,7 @@
 #include "map/map_layer.h"
 #include "map/tile.h"
 #include "map/tile_flag.h"
+#include "pathfinder/flow_field.h"
 #include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "script.h"
@@ -121,7 +122,7 @@ bool COrder_Move::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Move::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Move::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->MapLayer != UI.CurrentMapLayer->ID) {
 		return lastScreenPos;
@@ -136,6 +137,13 @@ QPoint COrder_Move::get_shown_target_pos(const CViewport &vp) const
 }
 
 void COrder_Move::UpdatePathFinderData(PathFinderInput &input)
+{
+	this->update_path_finder_goal(input);
+
+	input.set_flow_field(flow_field::get_for_order(this->goal_flow_field, input));
+}
+
+bool COrder_Move::update_path_finder_goal(PathFinderInput &input) const
 {
 	const Vec2i tileSize(0, 0);
 	input.SetGoal(this->goalPos, tileSize, this->MapLayer);
@@ -143,6 +151,8 @@ void COrder_Move::UpdatePathFinderData(PathFinderInput &input)
 	int distance = this->Range;
 	input.SetMaxRange(distance);
 	input.SetMinRange(0);
+
+	return true;
 }
 
 /**
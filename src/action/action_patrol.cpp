@@ -51,6 +51,7 @@
 //Wyrmgus end
 #include "unit/unit_type.h"
 #include "util/assert_util.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -141,7 +142,7 @@ bool COrder_Patrol::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Patrol::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Patrol::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->MapLayer != UI.CurrentMapLayer->ID) {
 		return lastScreenPos;
@@ -166,11 +167,18 @@ PixelPos COrder_Patrol::Show(const CViewport &vp, const PixelPos &lastScreenPos,
 }
 
 void COrder_Patrol::UpdatePathFinderData(PathFinderInput &input)
+{
+	this->update_path_finder_goal(input);
+}
+
+bool COrder_Patrol::update_path_finder_goal(PathFinderInput &input) const
 {
 	input.SetMinRange(0);
 	input.SetMaxRange(this->Range);
 	const Vec2i tileSize(0, 0);
 	input.SetGoal(this->goalPos, tileSize, this->MapLayer);
+
+	return true;
 }
 
 void COrder_Patrol::Execute(CUnit &unit)
@@ -161,7 +161,7 @@ bool COrder_Repair::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Repair::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Repair::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->get_reparable_target() != nullptr) {
 		if (this->get_reparable_target()->MapLayer != UI.CurrentMapLayer) {
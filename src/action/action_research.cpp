@@ -106,7 +106,7 @@ bool COrder_Research::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Research::Show(const CViewport &, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Research::Show(const CViewport &, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(render_commands)
 
@@ -402,7 +402,7 @@ bool COrder_Resource::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Resource::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Resource::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (this->has_goal()) {
 		if (this->get_goal()->MapLayer != UI.CurrentMapLayer) {
@@ -442,6 +442,11 @@ QColor COrder_Resource::get_shown_target_color() const
 }
 
 void COrder_Resource::UpdatePathFinderData(PathFinderInput &input)
+{
+	this->update_path_finder_goal(input);
+}
+
+bool COrder_Resource::update_path_finder_goal(PathFinderInput &input) const
 {
 	input.SetMinRange(0);
 	input.SetMaxRange(1);
@@ -456,6 +461,9 @@ void COrder_Resource::UpdatePathFinderData(PathFinderInput &input)
 		tileSize.y = 0;
 		input.SetGoal(this->goalPos, tileSize, this->MapLayer);
 	}
+
+	//without a goal unit, the order may be in a phase in which its goal position is not set
+	return this->has_goal();
 }
 
 bool COrder_Resource::OnAiHitUnit(CUnit &unit, CUnit *attacker, int /* damage*/)
@@ -65,6 +65,7 @@
 //Wyrmgus end
 #include "util/util.h"
 #include "util/vector_util.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -115,7 +116,7 @@ bool COrder_Still::IsValid() const
 	return true;
 }
 
-PixelPos COrder_Still::Show(const CViewport &, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_Still::Show(const CViewport &, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	if (preferences::get()->are_pathlines_enabled()) {
 		QColor color = CVideo::GetRGBA(ColorGray);
@@ -278,6 +278,7 @@ int TransformUnitIntoType(CUnit &unit, const wyrmgus::unit_type &newtype)
 	
 	unit.Type = &newtype;
 	unit.Stats = &unit.Type->Stats[player.get_index()];
+	unit.invalidate_derived_stats();
 	
 	//Wyrmgus start
 	//change the civilization/faction upgrade markers for those of the new type
@@ -442,7 +443,7 @@ bool COrder_TransformInto::IsValid() const
 }
 
 
-PixelPos COrder_TransformInto::Show(const CViewport &, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_TransformInto::Show(const CViewport &, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(render_commands)
 
@@ -501,7 +502,7 @@ bool COrder_UpgradeTo::IsValid() const
 	return true;
 }
 
-PixelPos COrder_UpgradeTo::Show(const CViewport &, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder_UpgradeTo::Show(const CViewport &, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(render_commands)
 
@@ -76,6 +76,7 @@
 #include "unit/unit_type.h"
 #include "util/assert_util.h"
 #include "util/random.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -147,7 +148,7 @@ void COrder::AiUnitKilled(CUnit &unit)
 	}
 }
 
-PixelPos COrder::Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const
+PixelPos COrder::Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const
 {
 	const QPoint target_pos = this->get_shown_target_pos(vp);
 
@@ -416,7 +417,7 @@ static void HandleBuffsEachCycle(CUnit &unit)
 			}
 		}
 	}
-	
+
 	unit.decrement_status_effect_timers();
 }
 
@@ -737,8 +738,9 @@ void UnitActions()
 	try {
 		const bool isASecondCycle = !(GameCycle % CYCLES_PER_SECOND);
 
-		//unit list may be modified during loop... so make a copy
-		std::vector<CUnit *> table = unit_manager::get()->get_units();
+		//unit list may be modified during loop... so make a copy, reusing the buffer of the previous cycle
+		static std::vector<CUnit *> table;
+		table = unit_manager::get()->get_units();
 
 		//check for things that only happen every second
 		if (isASecondCycle) {
@@ -748,6 +750,10 @@ void UnitActions()
 		if ((GameCycle % (CYCLES_PER_SECOND * 5)) == 0) {
 			UnitActionsEachFiveSeconds(table.begin(), table.end());
 		}
+
+		//calculate the paths needed by units in parallel, before their actions are handled
+		CalculatePendingPaths(table);
+
 		// Do all actions
 		UnitActionsEachCycle(table.begin(), table.end());
 
@@ -1415,6 +1415,8 @@ void CommandSharedVision(const int player_index, const bool state, const int oth
 				MapMarkUnitSight(*unit);
 			}
 		}
+
+		InvalidateFogOfWar();
 	}
 }
 
@@ -135,6 +135,7 @@
 //Wyrmgus start
 #include "editor.h"
 //Wyrmgus end
+#include "game/cycle_profiler.h"
 #include "game/game.h"
 #include "grand_strategy.h"
 #include "iolib.h"
@@ -1670,15 +1671,24 @@ void AiEachSecond(CPlayer &player)
 	AiPlayer->NeededMask = 0;
 
 	//  Look if everything is fine.
-	AiCheckUnits();
+	{
+		scoped_cycle_timer timer(cycle_profiler_stage::ai_check_units);
+		AiCheckUnits();
+	}
 
 	AiPlayer->check_factions();
 
 	//  Handle the resource manager.
-	AiResourceManager();
+	{
+		scoped_cycle_timer timer(cycle_profiler_stage::ai_resource_manager);
+		AiResourceManager();
+	}
 
 	//  Handle the force manager.
-	AiForceManager();
+	{
+		scoped_cycle_timer timer(cycle_profiler_stage::ai_force_manager);
+		AiForceManager();
+	}
 
 	AiPlayer->check_site_transport_units();
 
@@ -84,7 +84,7 @@
 #include "widgets.h"
 
 extern void DoScrollArea(int state, bool fast, bool isKeyboard, const Qt::KeyboardModifiers key_modifiers);
-extern void DrawGuichanWidgets(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawGuichanWidgets(render_command_buffer &render_commands);
 
 static int IconWidth;                       /// Icon width in panels
 static int IconHeight;                      /// Icon height in panels
@@ -770,7 +770,7 @@ void RecalculateShownUnits()
 /**
 **  Draw a table with the players
 */
-static void DrawPlayers(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawPlayers(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 	std::array<char, 256> buf{};
@@ -856,7 +856,7 @@ static void DrawPlayers(std::vector<std::function<void(renderer *)>> &render_com
 /**
 **  Draw unit icons.
 */
-static void DrawUnitIcons(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitIcons(render_command_buffer &render_commands)
 {
 	int i = CEditor::get()->UnitIndex;
 
@@ -934,7 +934,7 @@ static void DrawUnitIcons(std::vector<std::function<void(renderer *)>> &render_c
 **  @param y        Y display position
 **  @param flags    State of the icon (::IconActive,::IconClicked,...)
 */
-static void DrawTileIcon(const terrain_type *terrain, unsigned x, unsigned y, unsigned flags, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawTileIcon(const terrain_type *terrain, unsigned x, unsigned y, unsigned flags, render_command_buffer &render_commands)
 {
 	Video.DrawVLine(ColorGray, x + defines::get()->get_scaled_tile_width() + 4 - 1, y + 5 - 1, defines::get()->get_scaled_tile_height() - 1 - 1, render_commands); // _|
 	Video.DrawVLine(ColorGray, x + defines::get()->get_scaled_tile_width() + 5 - 1, y + 5 - 1, defines::get()->get_scaled_tile_height() - 1 - 1, render_commands);
@@ -975,7 +975,7 @@ static void DrawTileIcon(const terrain_type *terrain, unsigned x, unsigned y, un
 **        If we have more solid tiles, than they fit into the panel, we need
 **        some new ideas.
 */
-static void DrawTileIcons(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawTileIcons(render_command_buffer &render_commands)
 {
 	CLabel label(defines::get()->get_game_font());
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
@@ -1079,7 +1079,7 @@ static void DrawTileIcons(std::vector<std::function<void(renderer *)>> &render_c
 	}
 }
 
-static void DrawEditorPanel_SelectIcon(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawEditorPanel_SelectIcon(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 
@@ -1106,7 +1106,7 @@ static void DrawEditorPanel_SelectIcon(std::vector<std::function<void(renderer *
 	icon->DrawUnitIcon(*UI.SingleSelectedButton->Style, flag, pos, "", CPlayer::Players[CEditor::get()->SelectedPlayer]->get_player_color(), render_commands);
 }
 
-static void DrawEditorPanel_UnitsIcon(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawEditorPanel_UnitsIcon(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 
@@ -1130,7 +1130,7 @@ static void DrawEditorPanel_UnitsIcon(std::vector<std::function<void(renderer *)
 	icon->DrawUnitIcon(*UI.SingleSelectedButton->Style, flag, pos, "", CPlayer::Players[CEditor::get()->SelectedPlayer]->get_player_color(), render_commands);
 }
 
-static void DrawEditorPanel_StartIcon(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawEditorPanel_StartIcon(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 
@@ -1181,7 +1181,7 @@ static void DrawEditorPanel_StartIcon(std::vector<std::function<void(renderer *)
 /**
 **  Draw the editor panels.
 */
-static void DrawEditorPanel(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawEditorPanel(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 
@@ -1220,7 +1220,7 @@ static void DrawEditorPanel(std::vector<std::function<void(renderer *)>> &render
 **
 **  @todo support for bigger cursors (2x2, 3x3 ...)
 */
-static void DrawMapCursor(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawMapCursor(render_command_buffer &render_commands)
 {
 	//  Affect CursorBuilding if necessary.
 	//  (Menu reset CursorBuilding)
@@ -1288,7 +1288,7 @@ static void DrawMapCursor(std::vector<std::function<void(renderer *)>> &render_c
 	}
 }
 
-static void DrawCross(const PixelPos &topleft_pos, const QSize &size, uint32_t color, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawCross(const PixelPos &topleft_pos, const QSize &size, uint32_t color, render_command_buffer &render_commands)
 {
 	const PixelPos lt = topleft_pos;
 	const PixelPos lb(topleft_pos.x, topleft_pos.y + size.height());
@@ -1302,7 +1302,7 @@ static void DrawCross(const PixelPos &topleft_pos, const QSize &size, uint32_t c
 /**
 **  Draw the start locations of all active players on the map
 */
-static void DrawStartLocations(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawStartLocations(render_command_buffer &render_commands)
 {
 	const unit_type *type = CEditor::get()->StartUnit;
 	for (const CViewport *vp = UI.Viewports; vp < UI.Viewports + UI.NumViewports; ++vp) {
@@ -1331,7 +1331,7 @@ static void DrawStartLocations(std::vector<std::function<void(renderer *)>> &ren
 **
 **  If cursor is on map or minimap show information about the current tile.
 */
-static void DrawEditorInfo(std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawEditorInfo(render_command_buffer &render_commands)
 {
 	Vec2i pos(0, 0);
 
@@ -1418,7 +1418,7 @@ static void ShowUnitInfo(const CUnit &unit)
 */
 void EditorUpdateDisplay()
 {
-	std::vector<std::function<void(renderer *)>> render_commands;
+	render_command_buffer render_commands = render_context::get()->take_recycled_commands();
 
 	DrawMapArea(render_commands); // draw the map area
 
@@ -0,0 +1,276 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "game/cycle_profiler.h"
+
+#include "database/defines.h"
+#include "ui/ui.h"
+#include "util/path_util.h"
+#include "video/font.h"
+#include "video/graphic_loader.h"
+#include "video/image_cache.h"
+#include "video/render_context.h"
+#include "video/video.h"
+
+namespace wyrmgus {
+
+std::string_view cycle_profiler::get_stage_name(const cycle_profiler_stage stage)
+{
+	switch (stage) {
+		case cycle_profiler_stage::network:
+			return "network";
+		case cycle_profiler_stage::triggers:
+			return "triggers";
+		case cycle_profiler_stage::unit_actions:
+			return "unit_actions";
+		case cycle_profiler_stage::missile_actions:
+			return "missile_actions";
+		case cycle_profiler_stage::players_each_cycle:
+			return "players_each_cycle";
+		case cycle_profiler_stage::map:
+			return "map";
+		case cycle_profiler_stage::rescue_units:
+			return "rescue_units";
+		case cycle_profiler_stage::players_each_second:
+			return "players_each_second";
+		case cycle_profiler_stage::players_each_half_minute:
+			return "players_each_half_minute";
+		case cycle_profiler_stage::players_each_minute:
+			return "players_each_minute";
+		case cycle_profiler_stage::game:
+			return "game";
+		case cycle_profiler_stage::autosave:
+			return "autosave";
+		case cycle_profiler_stage::ai_check_units:
+			return "ai_check_units";
+		case cycle_profiler_stage::ai_resource_manager:
+			return "ai_resource_manager";
+		case cycle_profiler_stage::ai_force_manager:
+			return "ai_force_manager";
+		default:
+			break;
+	}
+
+	throw std::runtime_error("Invalid cycle profiler stage: \"" + std::to_string(static_cast<int>(stage)) + "\".");
+}
+
+void cycle_profiler::begin_cycle(const unsigned long cycle)
+{
+	if (!this->is_enabled()) {
+		return;
+	}
+
+	this->current_record = cycle_record();
+	this->current_record.cycle = cycle;
+	this->cycle_start_time = std::chrono::steady_clock::now();
+	this->cycle_in_progress = true;
+}
+
+void cycle_profiler::end_cycle()
+{
+	if (!this->cycle_in_progress) {
+		return;
+	}
+
+	this->cycle_in_progress = false;
+	this->current_record.total_duration = std::chrono::steady_clock::now() - this->cycle_start_time;
+
+	for (size_t i = 0; i < cycle_profiler::stage_count; ++i) {
+		++this->stage_histograms[i][cycle_profiler::get_histogram_bucket(this->current_record.stage_durations[i])];
+		this->stage_total_durations[i] += this->current_record.stage_durations[i];
+	}
+
+	++this->total_histogram[cycle_profiler::get_histogram_bucket(this->current_record.total_duration)];
+	this->total_duration += this->current_record.total_duration;
+
+	const size_t index = this->write_count.load(std::memory_order_relaxed);
+	this->history[index % cycle_profiler::history_size] = this->current_record;
+	this->write_count.store(index + 1, std::memory_order_release);
+}
+
+std::vector<cycle_profiler::cycle_record> cycle_profiler::get_history() const
+{
+	const size_t end_index = this->write_count.load(std::memory_order_acquire);
+	const size_t start_index = end_index - std::min(end_index, cycle_profiler::history_size);
+
+	std::vector<cycle_record> records;
+	records.reserve(end_index - start_index);
+
+	for (size_t i = start_index; i < end_index; ++i) {
+		records.push_back(this->history[i % cycle_profiler::history_size]);
+	}
+
+	//discard the records which may have been overwritten by the writer while they were being copied, i.e. those whose slots have been reused by the records written since, or by the one being written now
+	const size_t new_end_index = this->write_count.load(std::memory_order_acquire);
+	if (new_end_index + 1 > cycle_profiler::history_size) {
+		const size_t first_valid_index = new_end_index + 1 - cycle_profiler::history_size;
+
+		if (first_valid_index > start_index) {
+			records.erase(records.begin(), records.begin() + std::min(first_valid_index - start_index, records.size()));
+		}
+	}
+
+	return records;
+}
+
+void cycle_profiler::clear()
+{
+	this->cycle_in_progress = false;
+	this->write_count.store(0, std::memory_order_release);
+	this->stage_histograms = {};
+	this->total_histogram = {};
+	this->stage_total_durations = {};
+	this->total_duration = std::chrono::nanoseconds(0);
+}
+
+static std::string duration_to_milliseconds_string(const std::chrono::nanoseconds duration)
+{
+	std::array<char, 32> buffer{};
+	snprintf(buffer.data(), buffer.size(), "%.2f", std::chrono::duration<double, std::milli>(duration).count());
+	return buffer.data();
+}
+
+void cycle_profiler::draw_overlay(render_command_buffer &render_commands) const
+{
+	if (!this->is_overlay_shown()) {
+		return;
+	}
+
+	//the amount of most recent cycles over which the averages are calculated
+	static constexpr size_t average_cycle_count = CYCLES_PER_SECOND;
+
+	const std::vector<cycle_record> records = this->get_history();
+	if (records.empty()) {
+		return;
+	}
+
+	//the last element is for the total duration of the cycles
+	std::array<std::chrono::nanoseconds, cycle_profiler::stage_count + 1> average_durations{};
+	std::array<std::chrono::nanoseconds, cycle_profiler::stage_count + 1> max_durations{};
+
+	const size_t average_start_index = records.size() - std::min(records.size(), average_cycle_count);
+	const long long average_record_count = static_cast<long long>(records.size() - average_start_index);
+
+	for (size_t i = 0; i < records.size(); ++i) {
+		const cycle_record &record = records[i];
+
+		for (size_t j = 0; j <= cycle_profiler::stage_count; ++j) {
+			const std::chrono::nanoseconds duration = j < cycle_profiler::stage_count ? record.stage_durations[j] : record.total_duration;
+
+			max_durations[j] = std::max(max_durations[j], duration);
+
+			if (i >= average_start_index) {
+				average_durations[j] += duration;
+			}
+		}
+	}
+
+	std::vector<std::string> lines;
+	lines.push_back("Cycle " + std::to_string(records.back().cycle) + " (ms, average of " + std::to_string(average_record_count) + " / max of " + std::to_string(records.size()) + " cycles)");
+
+	for (size_t j = 0; j <= cycle_profiler::stage_count; ++j) {
+		const std::string stage_name = j < cycle_profiler::stage_count ? std::string(cycle_profiler::get_stage_name(static_cast<cycle_profiler_stage>(j))) : "total";
+
+		lines.push_back(stage_name + ": " + duration_to_milliseconds_string(average_durations[j] / average_record_count) + " / " + duration_to_milliseconds_string(max_durations[j]));
+	}
+
+	//show the histogram of the total cycle durations, with the upper bound of each bucket
+	std::string histogram_str = "Cycles by duration:";
+	for (size_t i = 0; i < cycle_profiler::histogram_bucket_count; ++i) {
+		if (this->total_histogram[i] == 0) {
+			continue;
+		}
+
+		histogram_str += " <" + std::to_string(1ull << i) + "us: " + std::to_string(this->total_histogram[i]);
+	}
+	lines.push_back(std::move(histogram_str));
+
+	//show the statistics of the last rendered frame, as rendering is not part of the game cycle
+	const render_command_buffer::statistics render_statistics = render_context::get()->get_last_frame_statistics();
+	lines.push_back("Last frame: " + duration_to_milliseconds_string(render_context::get()->get_last_frame_duration()) + " ms, " + std::to_string(render_statistics.command_count) + " render commands (" + std::to_string(render_statistics.custom_command_count) + " custom), " + std::to_string(render_statistics.texture_batch_count) + " texture batches, " + std::to_string(render_statistics.allocation_count) + " allocations");
+
+	const image_cache::statistics image_cache_statistics = image_cache::get()->get_statistics();
+	lines.push_back("Image cache: " + std::to_string(image_cache_statistics.hit_count) + " hits, " + std::to_string(image_cache_statistics.miss_count) + " misses, " + std::to_string(image_cache_statistics.write_count) + " writes, " + std::to_string(image_cache_statistics.error_count) + " errors");
+
+	const graphic_loader::statistics graphic_loader_statistics = graphic_loader::get()->get_last_statistics();
+	lines.push_back("Graphic loading: first playable frame after " + duration_to_milliseconds_string(graphic_loader_statistics.first_playable_frame_duration) + " ms, " + std::to_string(graphic_loader_statistics.loaded_count) + " graphics loaded in " + duration_to_milliseconds_string(graphic_loader_statistics.load_duration) + " ms, " + std::to_string(graphic_loader_statistics.streamed_count) + " streamed in " + duration_to_milliseconds_string(graphic_loader_statistics.stream_duration) + " ms");
+
+	wyrmgus::font *font = defines::get()->get_small_font();
+	const CLabel label(font);
+	const int line_height = label.Height() + 1;
+
+	int width = 0;
+	for (const std::string &line : lines) {
+		width = std::max(width, font->Width(line));
+	}
+
+	const int x = UI.SelectedViewport->get_top_left_pos().x() + 4;
+	int y = UI.SelectedViewport->get_top_left_pos().y() + 4;
+
+	Video.FillTransRectangleClip(ColorBlack, x - 2, y - 2, width + 4, static_cast<int>(lines.size()) * line_height + 4, 160, render_commands);
+
+	for (const std::string &line : lines) {
+		label.Draw(x, y, line, render_commands);
+		y += line_height;
+	}
+}
+
+void cycle_profiler::export_csv(const std::filesystem::path &filepath) const
+{
+	const std::string filepath_str = path::to_string(filepath);
+
+	FILE *file = fopen(filepath_str.c_str(), "w");
+	if (file == nullptr) {
+		throw std::runtime_error("Failed to open file \"" + filepath_str + "\" for writing the cycle profile.");
+	}
+
+	fprintf(file, "cycle");
+	for (size_t i = 0; i < cycle_profiler::stage_count; ++i) {
+		fprintf(file, ",%s_us", std::string(cycle_profiler::get_stage_name(static_cast<cycle_profiler_stage>(i))).c_str());
+	}
+	fprintf(file, ",total_us\n");
+
+	const auto to_microseconds = [](const std::chrono::nanoseconds duration) {
+		return std::chrono::duration<double, std::micro>(duration).count();
+	};
+
+	for (const cycle_record &record : this->get_history()) {
+		fprintf(file, "%lu", record.cycle);
+
+		for (const std::chrono::nanoseconds duration : record.stage_durations) {
+			fprintf(file, ",%.1f", to_microseconds(duration));
+		}
+
+		fprintf(file, ",%.1f\n", to_microseconds(record.total_duration));
+	}
+
+	fclose(file);
+}
+
+}
@@ -0,0 +1,203 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/singleton.h"
+
+namespace wyrmgus {
+
+class render_command_buffer;
+
+//the stages of a game cycle which are timed by the cycle profiler; the AI stages are nested within the per-second player stage
+enum class cycle_profiler_stage {
+	network,
+	triggers,
+	unit_actions,
+	missile_actions,
+	players_each_cycle,
+	map,
+	rescue_units,
+	players_each_second,
+	players_each_half_minute,
+	players_each_minute,
+	game,
+	autosave,
+	ai_check_units,
+	ai_resource_manager,
+	ai_force_manager,
+
+	count
+};
+
+//records how long each stage of the game logic takes in each cycle, to find the cycles which exceed the frame budget
+class cycle_profiler final : public singleton<cycle_profiler>
+{
+public:
+	static constexpr size_t stage_count = static_cast<size_t>(cycle_profiler_stage::count);
+	static constexpr size_t history_size = 4096; //the amount of cycles kept in the history
+	static constexpr size_t histogram_bucket_count = 16;
+
+	struct cycle_record final
+	{
+		unsigned long cycle = 0;
+		std::array<std::chrono::nanoseconds, stage_count> stage_durations{};
+		std::chrono::nanoseconds total_duration{};
+	};
+
+	static std::string_view get_stage_name(const cycle_profiler_stage stage);
+
+	//get the histogram bucket for a duration; bucket 0 holds durations below 1 microsecond, and each subsequent bucket holds twice the range of the previous one
+	static size_t get_histogram_bucket(const std::chrono::nanoseconds duration)
+	{
+		const long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+		if (microseconds <= 0) {
+			return 0;
+		}
+
+		return std::min<size_t>(std::bit_width(static_cast<unsigned long long>(microseconds)), histogram_bucket_count - 1);
+	}
+
+	bool is_enabled() const
+	{
+		return this->enabled;
+	}
+
+	void set_enabled(const bool enabled)
+	{
+		this->enabled = enabled;
+	}
+
+	bool is_overlay_shown() const
+	{
+		return this->overlay_shown;
+	}
+
+	void set_overlay_shown(const bool shown)
+	{
+		this->overlay_shown = shown;
+
+		//the overlay shows the profiled cycles, so showing it enables profiling
+		if (shown) {
+			this->enabled = true;
+		}
+	}
+
+	void begin_cycle(const unsigned long cycle);
+	void end_cycle();
+
+	void add_stage_duration(const cycle_profiler_stage stage, const std::chrono::nanoseconds duration)
+	{
+		if (!this->cycle_in_progress) {
+			return;
+		}
+
+		this->current_record.stage_durations[static_cast<size_t>(stage)] += duration;
+	}
+
+	//get the amount of cycles which have been recorded, including those which have been overwritten in the history since
+	size_t get_recorded_cycle_count() const
+	{
+		return this->write_count.load(std::memory_order_acquire);
+	}
+
+	//copy the cycles currently in the history, from oldest to newest
+	std::vector<cycle_record> get_history() const;
+
+	const std::array<unsigned int, histogram_bucket_count> &get_stage_histogram(const cycle_profiler_stage stage) const
+	{
+		return this->stage_histograms[static_cast<size_t>(stage)];
+	}
+
+	const std::array<unsigned int, histogram_bucket_count> &get_total_histogram() const
+	{
+		return this->total_histogram;
+	}
+
+	//get the time spent in a stage over all cycles recorded since the profiler was last cleared
+	std::chrono::nanoseconds get_stage_total_duration(const cycle_profiler_stage stage) const
+	{
+		return this->stage_total_durations[static_cast<size_t>(stage)];
+	}
+
+	std::chrono::nanoseconds get_total_duration() const
+	{
+		return this->total_duration;
+	}
+
+	void clear();
+
+	void draw_overlay(render_command_buffer &render_commands) const;
+	void export_csv(const std::filesystem::path &filepath) const;
+
+private:
+	bool enabled = false; //profiling is opt-in, as the timers have a cost in every cycle
+	bool overlay_shown = false;
+	bool cycle_in_progress = false;
+	std::chrono::steady_clock::time_point cycle_start_time;
+	cycle_record current_record;
+
+	//the history is a single-producer ring buffer: the game logic writes a record and then publishes it by incrementing the write count, so readers never see a partially-written record unless it is overwritten while being read, which they detect by checking the write count again
+	std::array<cycle_record, history_size> history;
+	std::atomic<size_t> write_count = 0;
+
+	std::array<std::array<unsigned int, histogram_bucket_count>, stage_count> stage_histograms{};
+	std::array<unsigned int, histogram_bucket_count> total_histogram{};
+	std::array<std::chrono::nanoseconds, stage_count> stage_total_durations{};
+	std::chrono::nanoseconds total_duration{};
+};
+
+//times the scope it is in, adding the elapsed time to a stage of the current cycle
+class scoped_cycle_timer final
+{
+public:
+	explicit scoped_cycle_timer(const cycle_profiler_stage stage) : stage(stage)
+	{
+		if (cycle_profiler::get()->is_enabled()) {
+			this->start_time = std::chrono::steady_clock::now();
+			this->active = true;
+		}
+	}
+
+	~scoped_cycle_timer()
+	{
+		if (this->active) {
+			cycle_profiler::get()->add_stage_duration(this->stage, std::chrono::steady_clock::now() - this->start_time);
+		}
+	}
+
+	scoped_cycle_timer(const scoped_cycle_timer &other) = delete;
+	scoped_cycle_timer &operator =(const scoped_cycle_timer &other) = delete;
+
+private:
+	const cycle_profiler_stage stage;
+	std::chrono::steady_clock::time_point start_time;
+	bool active = false;
+};
+
+}
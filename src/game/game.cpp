@@ -45,7 +45,10 @@
 #include "economy/resource.h"
 #include "editor.h"
 #include "engine_interface.h"
+#include "game/cycle_profiler.h"
 #include "game/results_info.h"
+#include "game/save_container.h"
+#include "game/save_writer.h"
 //Wyrmgus start
 #include "grand_strategy.h"
 //Wyrmgus end
@@ -131,6 +134,7 @@
 #include "util/vector_util.h"
 #include "version.h"
 #include "video/font.h"
+#include "video/graphic_loader.h"
 #include "video/video.h"
 #include "widgets.h"
 
@@ -390,6 +394,14 @@ void game::process_gsml_scope(const gsml_data &scope)
 
 void game::save(const std::filesystem::path &filepath) const
 {
+	if (this->save_asynchronously) {
+		this->save_async(filepath);
+		return;
+	}
+
+	//a background write to the same file may still be in progress
+	save_writer::get()->wait();
+
 	const std::string filepath_str = path::to_string(filepath);
 
 	CFile file;
@@ -398,6 +410,28 @@ void game::save(const std::filesystem::path &filepath) const
 		throw std::runtime_error("Can't save to \"" + filepath_str + "\".");
 	}
 
+	this->write_save_data(file);
+
+	file.close();
+}
+
+void game::save_async(const std::filesystem::path &filepath) const
+{
+	//serialize the game state to memory, which is the only part of the save which stalls the game; compressing and writing it is then done in the background
+	const auto start_time = std::chrono::steady_clock::now();
+
+	CFile file;
+	file.open_memory();
+	this->write_save_data(file);
+	file.close();
+
+	const std::chrono::nanoseconds snapshot_duration = std::chrono::steady_clock::now() - start_time;
+
+	save_writer::get()->write_async(filepath, file.take_memory_data(), snapshot_duration);
+}
+
+void game::write_save_data(CFile &file) const
+{
 	time_t now;
 	char dateStr[64];
 
@@ -439,10 +473,12 @@ void game::save(const std::filesystem::path &filepath) const
 
 	file.printf("SetGodMode(%s)\n", GodMode ? "true" : "false");
 
+	save_container container;
+
 	SaveUnitTypes(file);
 	SaveUpgrades(file);
 	SavePlayers(file);
-	CMap::get()->save(file);
+	CMap::get()->save(file, container);
 	unit_manager::get()->Save(file);
 	SaveUserInterface(file);
 	SaveAi(file);
@@ -458,7 +494,9 @@ void game::save(const std::filesystem::path &filepath) const
 	}
 	SaveTriggers(file); //Triggers are saved in SaveGlobal, so load it after Global
 
-	file.close();
+	//the binary save container is written after the Lua script, so that it is not passed to the Lua interpreter when loading
+	const std::string container_data = container.to_save_trailer_bytes();
+	file.write(container_data.data(), container_data.size());
 }
 
 void game::save_game_data(CFile &file) const
@@ -832,6 +870,12 @@ boost::asio::awaitable<void> StartMap(const std::filesystem::path &filepath, con
 
 		GameEstablishing = true;
 
+		if (!SaveGameLoading) {
+			//for saved games, this has been done before loading the save file
+			graphic_loader::get()->on_game_load_started();
+			engine_interface::get()->clear_loading_log();
+		}
+
 		//create the game in another thread, to not block the main one while it is loading
 		co_await thread_pool::get()->co_spawn_awaitable([&filepath]() -> boost::asio::awaitable<void> {
 			CreateGame(filepath, CMap::get());
@@ -1679,6 +1723,7 @@ void CleanGame()
 	CMap::get()->Clean();
 	CleanReplayLog();
 	FreePathfinder();
+	graphic_loader::get()->stop_streaming();
 	CursorBuilding = nullptr;
 	UnitUnderCursor = nullptr;
 	GameEstablishing = false;
@@ -1746,6 +1791,69 @@ static int CclGetGodMode(lua_State *l)
 	return 1;
 }
 
+/**
+**  Set whether the cycle profiler records the duration of each stage of the game cycles.
+**
+**  @param l  Lua state.
+*/
+static int CclSetCycleProfilerEnabled(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	cycle_profiler::get()->set_enabled(LuaToBoolean(l, 1));
+	return 0;
+}
+
+/**
+**  Set whether the cycle profiler overlay is shown.
+**
+**  @param l  Lua state.
+*/
+static int CclSetCycleProfilerOverlay(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	cycle_profiler::get()->set_overlay_shown(LuaToBoolean(l, 1));
+	return 0;
+}
+
+/**
+**  Toggle the cycle profiler overlay.
+**
+**  @param l  Lua state.
+*/
+static int CclToggleCycleProfilerOverlay(lua_State *l)
+{
+	LuaCheckArgs(l, 0);
+	cycle_profiler::get()->set_overlay_shown(!cycle_profiler::get()->is_overlay_shown());
+	return 0;
+}
+
+/**
+**  Export the per-stage durations of the recorded game cycles to a CSV file.
+**
+**  @param l  Lua state.
+*/
+static int CclExportCycleProfile(lua_State *l)
+{
+	const int args = lua_gettop(l);
+	if (args > 1) {
+		LuaError(l, "incorrect argument");
+	}
+
+	std::filesystem::path filepath = parameters::get()->GetUserDirectory() / "cycle_profile.csv";
+	if (args == 1) {
+		filepath = LuaToString(l, 1);
+	}
+
+	try {
+		cycle_profiler::get()->export_csv(filepath);
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+		LuaError(l, "Failed to export the cycle profile.");
+	}
+
+	return 0;
+}
+
 /**
 **  Set resource harvesting speed (deprecated).
 **
@@ -2045,6 +2153,11 @@ void LuaRegisterModules()
 	lua_register(Lua, "SetGodMode", CclSetGodMode);
 	lua_register(Lua, "GetGodMode", CclGetGodMode);
 
+	lua_register(Lua, "SetCycleProfilerEnabled", CclSetCycleProfilerEnabled);
+	lua_register(Lua, "SetCycleProfilerOverlay", CclSetCycleProfilerOverlay);
+	lua_register(Lua, "ToggleCycleProfilerOverlay", CclToggleCycleProfilerOverlay);
+	lua_register(Lua, "ExportCycleProfile", CclExportCycleProfile);
+
 	lua_register(Lua, "SetSpeedResourcesHarvest", CclSetSpeedResourcesHarvest);
 	lua_register(Lua, "SetSpeedResourcesReturn", CclSetSpeedResourcesReturn);
 	lua_register(Lua, "SetSpeedBuild", CclSetSpeedBuild);
@@ -203,8 +203,27 @@ public:
 	void process_gsml_scope(const gsml_data &scope);
 
 	void save(const std::filesystem::path &filepath) const;
+	void save_async(const std::filesystem::path &filepath) const;
+	void write_save_data(CFile &file) const;
 	void save_game_data(CFile &file) const;
 
+	//set whether saves should take a snapshot of the game state and write it in the background, instead of stalling the game until the file has been written
+	void set_save_asynchronously(const bool save_asynchronously)
+	{
+		this->save_asynchronously = save_asynchronously;
+	}
+
+	//get the binary save container of the save being loaded, which is only valid while its Lua script is being run
+	const std::string_view &get_loading_save_container_data() const
+	{
+		return this->loading_save_container_data;
+	}
+
+	void set_loading_save_container_data(const std::string_view &container_data)
+	{
+		this->loading_save_container_data = container_data;
+	}
+
 	void set_cheat(const bool cheat);
 
 	bool is_persistency_enabled() const;
@@ -305,10 +324,30 @@ private:
 	std::vector<std::unique_ptr<delayed_effect_instance<CPlayer>>> player_delayed_effects;
 	std::vector<std::unique_ptr<delayed_effect_instance<CUnit>>> unit_delayed_effects;
 	bool console_active = false;
+	bool save_asynchronously = false;
+	std::string_view loading_save_container_data;
 	qunique_ptr<results_info> results;
 	std::vector<std::function<void()>> posted_functions;
 };
 
+//makes saves during its scope take a snapshot and write it in the background, restoring synchronous saving when it ends, even if the save throws
+class scoped_asynchronous_save final
+{
+public:
+	scoped_asynchronous_save()
+	{
+		game::get()->set_save_asynchronously(true);
+	}
+
+	~scoped_asynchronous_save()
+	{
+		game::get()->set_save_asynchronously(false);
+	}
+
+	scoped_asynchronous_save(const scoped_asynchronous_save &other) = delete;
+	scoped_asynchronous_save &operator =(const scoped_asynchronous_save &other) = delete;
+};
+
 }
 
 class CFile;
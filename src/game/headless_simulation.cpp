@@ -0,0 +1,130 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "game/headless_simulation.h"
+
+#include "actions.h"
+#include "game/game.h"
+#include "replay.h"
+#include "results.h"
+#include "util/exception_util.h"
+#include "util/log_util.h"
+#include "util/path_util.h"
+
+namespace wyrmgus {
+
+boost::asio::awaitable<int> headless_simulation::run(const std::filesystem::path &filepath, const bool is_replay, const unsigned long cycle_count)
+{
+	this->running = true;
+	this->filepath = filepath;
+	this->cycle_count = cycle_count;
+	this->game_ended = false;
+
+	//the time spent in each stage of the cycles is part of the results
+	cycle_profiler::get()->set_enabled(true);
+
+	try {
+		if (is_replay) {
+			co_await StartReplay(filepath, false);
+		} else {
+			co_await game::get()->run_map(filepath);
+		}
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+		this->running = false;
+		co_return EXIT_FAILURE;
+	}
+
+	this->running = false;
+
+	if (!this->game_ended) {
+		log::log_error("The headless simulation of \"" + path::to_string(filepath) + "\" ended without the game having been run.");
+		co_return EXIT_FAILURE;
+	}
+
+	this->print_results();
+
+	co_return EXIT_SUCCESS;
+}
+
+void headless_simulation::on_game_started()
+{
+	//the game start is not deterministic in its timing, so only the cycles themselves are measured; the cycle profiler is cleared at the start of each game
+	this->start_cycle = GameCycle;
+	this->start_time = std::chrono::steady_clock::now();
+}
+
+void headless_simulation::on_cycle_end()
+{
+	if (!GameRunning) {
+		return;
+	}
+
+	const bool cycle_limit_reached = this->cycle_count != 0 && GameCycle - this->start_cycle >= this->cycle_count;
+
+	if (cycle_limit_reached || (IsReplayGame() && IsReplayFinished())) {
+		StopGame(GameNoResult);
+	}
+}
+
+void headless_simulation::on_game_ended()
+{
+	this->duration = std::chrono::steady_clock::now() - this->start_time;
+	this->simulated_cycle_count = GameCycle - this->start_cycle;
+	this->sync_hash = SyncHash;
+
+	for (size_t i = 0; i < cycle_profiler::stage_count; ++i) {
+		this->stage_durations[i] = cycle_profiler::get()->get_stage_total_duration(static_cast<cycle_profiler_stage>(i));
+	}
+
+	this->profiled_duration = cycle_profiler::get()->get_total_duration();
+	this->game_ended = true;
+}
+
+void headless_simulation::print_results() const
+{
+	const double seconds = std::chrono::duration<double>(this->duration).count();
+	const double cycles_per_second = seconds > 0 ? static_cast<double>(this->simulated_cycle_count) / seconds : 0.;
+	const double profiled_milliseconds = std::chrono::duration<double, std::milli>(this->profiled_duration).count();
+
+	fprintf(stdout, "Headless simulation of \"%s\": %lu cycles (%.1f minutes of game time) in %.3f s, %.1f cycles per second\n", path::to_string(this->filepath).c_str(), this->simulated_cycle_count, static_cast<double>(this->simulated_cycle_count) / CYCLES_PER_MINUTE, seconds, cycles_per_second);
+
+	//the AI stages are nested within the per-second player stage, so the percentages do not add up to 100
+	for (size_t i = 0; i < cycle_profiler::stage_count; ++i) {
+		const double stage_milliseconds = std::chrono::duration<double, std::milli>(this->stage_durations[i]).count();
+		const double percent = profiled_milliseconds > 0 ? stage_milliseconds * 100. / profiled_milliseconds : 0.;
+
+		fprintf(stdout, "  %-26s %12.2f ms %6.1f%%\n", std::string(cycle_profiler::get_stage_name(static_cast<cycle_profiler_stage>(i))).c_str(), stage_milliseconds, percent);
+	}
+
+	fprintf(stdout, "  %-26s %12.2f ms\n", "total", profiled_milliseconds);
+	fprintf(stdout, "Final SyncHash: %u\n", this->sync_hash);
+	fflush(stdout);
+}
+
+}
@@ -0,0 +1,69 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#pragma once
+
+#include "game/cycle_profiler.h"
+#include "util/singleton.h"
+
+namespace wyrmgus {
+
+//runs a map or replay without display, sound or input, as fast as possible, and then prints the cycle rate, the time spent in each stage of the game logic and the final sync hash, for regression and performance testing on machines without a GPU
+class headless_simulation final : public singleton<headless_simulation>
+{
+public:
+	bool is_running() const
+	{
+		return this->running;
+	}
+
+	//run a map or replay for an amount of cycles (0 for no limit), returning the exit code
+	[[nodiscard]]
+	boost::asio::awaitable<int> run(const std::filesystem::path &filepath, const bool is_replay, const unsigned long cycle_count);
+
+	void on_game_started();
+	void on_cycle_end();
+	void on_game_ended();
+
+private:
+	void print_results() const;
+
+	bool running = false;
+	std::filesystem::path filepath;
+	unsigned long cycle_count = 0;
+	unsigned long start_cycle = 0;
+	std::chrono::steady_clock::time_point start_time;
+
+	//the results, which are stored when the game ends, before the game state is cleaned up
+	bool game_ended = false;
+	unsigned long simulated_cycle_count = 0;
+	std::chrono::nanoseconds duration{};
+	unsigned sync_hash = 0;
+	std::array<std::chrono::nanoseconds, cycle_profiler::stage_count> stage_durations{};
+	std::chrono::nanoseconds profiled_duration{};
+};
+
+}
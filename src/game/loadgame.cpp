@@ -33,6 +33,8 @@
 #include "database/database.h"
 #include "dialogue.h"
 #include "game/game.h"
+#include "game/save_container.h"
+#include "game/save_writer.h"
 //Wyrmgus start
 #include "grand_strategy.h"
 //Wyrmgus end
@@ -252,6 +254,9 @@ static void PlaceUnits()
 */
 void LoadGame(const std::filesystem::path &filepath)
 {
+	//the save file may still be being written in the background
+	save_writer::get()->wait();
+
 	CleanPlayers();
 
 	// log will be enabled if found in the save game
@@ -267,7 +272,26 @@ void LoadGame(const std::filesystem::path &filepath)
 	//Wyrmgus start
 	CalculateItemsToLoad();
 	//Wyrmgus end
-	LuaLoadFile(path::to_string(filepath));
+	const std::string filepath_str = path::to_string(filepath);
+
+	std::string save_data;
+	if (!GetFileContent(filepath_str, save_data)) {
+		throw std::runtime_error("Failed to load saved game: \"" + filepath_str + "\"");
+	}
+
+	//only the Lua script of the save is run by the interpreter, with the binary save container appended to it being read directly when the script refers to it
+	const auto [script_data, container_data] = save_container::split_save_data(save_data);
+
+	game::get()->set_loading_save_container_data(container_data);
+
+	try {
+		LuaLoadBuffer(script_data, filepath_str);
+	} catch (...) {
+		game::get()->set_loading_save_container_data(std::string_view());
+		throw;
+	}
+
+	game::get()->set_loading_save_container_data(std::string_view());
 	LuaGarbageCollect();
 
 	//clear the base reference for destroyed units
@@ -310,4 +334,6 @@ void LoadGame(const std::filesystem::path &filepath)
 	}
 
 	CMap::get()->calculate_settlement_neutral_buildings();
+
+	ApplyPendingReplaySeek(filepath);
 }
@@ -31,6 +31,9 @@
 #include "actions.h"
 #include "commands.h"
 #include "game/game.h"
+#include "game/headless_simulation.h"
+#include "game/replay_binary.h"
+#include "game/save_container.h"
 #include "iocompat.h"
 #include "iolib.h"
 #include "map/map.h"
@@ -46,6 +49,7 @@
 //Wyrmgus start
 #include "quest/quest.h"
 //Wyrmgus end
+#include "results.h"
 #include "script.h"
 #include "settings.h"
 #include "spell/spell.h"
@@ -57,8 +61,10 @@
 #include "unit/unit_manager.h"
 #include "unit/unit_type.h"
 #include "util/assert_util.h"
+#include "util/exception_util.h"
 #include "util/path_util.h"
 #include "util/random.h"
+#include "util/thread_pool.h"
 #include "version.h"
 
 class LogEntry
@@ -66,6 +72,7 @@ class LogEntry
 public:
 	unsigned long GameCycle = 0;
 	int UnitNumber = 0;
+	std::vector<int> GroupUnitNumbers; /// Other units which received the same command
 	std::string UnitIdent;
 	std::string Action;
 	int Flush = 0;
@@ -139,16 +146,42 @@ public:
 	int Engine[3];
 	int Network[3];
 	std::unique_ptr<LogEntry> Commands;
+	size_t CommandCount = 0;
+	std::vector<wyrmgus::replay_checkpoint> Checkpoints; /// Game state snapshots, sorted by game cycle
+};
+
+/**
+** Replay to be resumed from a checkpoint once its game state has been loaded
+*/
+class ReplaySeek final
+{
+public:
+	std::unique_ptr<FullReplay> Replay;
+	std::filesystem::path StateFilepath; /// Save file with the checkpoint's game state
+	ReplayType Type = ReplayNone;
+	size_t CommandIndex = 0;
+	unsigned long TargetCycle = 0;
 };
 
 bool CommandLogDisabled;           /// True if command log is off
 ReplayType ReplayGameType;         /// Replay game type
 static bool DisabledLog;           /// Disabled log for replay
 static std::unique_ptr<CFile> LogFile;             /// Replay log file
+static std::filesystem::path BinaryLogFilepath;     /// Binary replay file written when logging ends
 static unsigned long NextLogCycle; /// Next log cycle number
 static int InitReplay;             /// Initialize replay
 static std::unique_ptr<FullReplay> CurrentReplay;
 static LogEntry *ReplayStep;
+static size_t ReplayStepIndex;     /// Index of the replay step in the replay's commands
+static bool CommandLogGrouping;    /// Whether the same command given to several units is merged into one log entry
+static std::unique_ptr<LogEntry> PendingGroupLog; /// Log entry being built for a group command
+static constexpr size_t MaxReplayCheckpoints = 32; /// Maximum amount of checkpoints kept for a replay, as each holds a compressed copy of the game state
+static unsigned long ReplayCheckpointInterval = 0; /// Game cycles between replay checkpoints, 0 to disable them
+static bool SavingReplayCheckpoint; /// Whether the game state is being saved for a replay checkpoint
+static std::unique_ptr<wyrmgus::replay_checkpoint> PendingReplayCheckpoint; /// Checkpoint whose game state is being compressed
+static std::future<void> PendingReplayCheckpointFuture; /// Background compression of the pending checkpoint's game state
+static bool ConvertingReplay;      /// Whether a replay is being parsed for conversion, in which case its settings are not applied
+static std::unique_ptr<ReplaySeek> PendingReplaySeek;
 
 //----------------------------------------------------------------------------
 // Log commands
@@ -275,6 +308,13 @@ static void PrintLogCommand(const LogEntry &log, CFile &file)
 	if (log.UnitNumber != -1) {
 		file.printf("UnitNumber = %d, ", log.UnitNumber);
 	}
+	if (!log.GroupUnitNumbers.empty()) {
+		file.printf("GroupUnitNumbers = {");
+		for (size_t i = 0; i != log.GroupUnitNumbers.size(); ++i) {
+			file.printf("%s%d", i != 0 ? ", " : "", log.GroupUnitNumbers[i]);
+		}
+		file.printf("}, ");
+	}
 	if (!log.UnitIdent.empty()) {
 		file.printf("UnitIdent = \"%s\", ", log.UnitIdent.c_str());
 	}
@@ -296,66 +336,90 @@ static void PrintLogCommand(const LogEntry &log, CFile &file)
 }
 
 /**
-**  Output the FullReplay list to file
-**
-**  @param file  The file to output to
+**  Get the directory in which replay logs are written
 */
-static void SaveFullLog(CFile &file)
+static std::filesystem::path GetReplayLogDirectory()
 {
-	file.printf("\n--- -----------------------------------------\n");
-	file.printf("--- MODULE: replay list\n");
+	std::filesystem::path path = parameters::get()->GetUserDirectory();
+	if (!GameName.empty()) {
+		path /= GameName;
+	}
+	path /= "logs";
+	return path;
+}
 
-	file.printf("\n");
+/**
+**  Output the FullReplay definition to file
+**
+**  @param replay  The replay whose definition to output
+**  @param file    The file to output to
+*/
+static void SaveReplayHeader(const FullReplay &replay, CFile &file)
+{
 	file.printf("ReplayLog( {\n");
-	file.printf("  Comment1 = \"%s\",\n", CurrentReplay->Comment1.c_str());
-	file.printf("  Comment2 = \"%s\",\n", CurrentReplay->Comment2.c_str());
-	file.printf("  Date = \"%s\",\n", CurrentReplay->Date.c_str());
-	file.printf("  Map = \"%s\",\n", CurrentReplay->Map.c_str());
-	file.printf("  MapPath = \"%s\",\n", CurrentReplay->MapPath.c_str());
-	file.printf("  MapId = %u,\n", CurrentReplay->MapId);
-	file.printf("  Type = %d,\n", CurrentReplay->Type);
-	file.printf("  Race = %d,\n", CurrentReplay->Race);
+	file.printf("  Comment1 = \"%s\",\n", replay.Comment1.c_str());
+	file.printf("  Comment2 = \"%s\",\n", replay.Comment2.c_str());
+	file.printf("  Date = \"%s\",\n", replay.Date.c_str());
+	file.printf("  Map = \"%s\",\n", replay.Map.c_str());
+	file.printf("  MapPath = \"%s\",\n", replay.MapPath.c_str());
+	file.printf("  MapId = %u,\n", replay.MapId);
+	file.printf("  Type = %d,\n", replay.Type);
+	file.printf("  Race = %d,\n", replay.Race);
 	//Wyrmgus start
-	file.printf("  Faction = %d,\n", CurrentReplay->Faction);
+	file.printf("  Faction = %d,\n", replay.Faction);
 	//Wyrmgus end
-	file.printf("  LocalPlayer = %d,\n", CurrentReplay->LocalPlayer);
+	file.printf("  LocalPlayer = %d,\n", replay.LocalPlayer);
 	file.printf("  Players = {\n");
 	for (int i = 0; i < PlayerMax; ++i) {
-		if (!CurrentReplay->Players[i].Name.empty()) {
-			file.printf("\t{ Name = \"%s\",", CurrentReplay->Players[i].Name.c_str());
+		if (!replay.Players[i].Name.empty()) {
+			file.printf("\t{ Name = \"%s\",", replay.Players[i].Name.c_str());
 		} else {
 			file.printf("\t{");
 		}
-		file.printf(" AIScript = \"%s\",", CurrentReplay->Players[i].AIScript.c_str());
-		file.printf(" Race = %d,", CurrentReplay->Players[i].Race);
+		file.printf(" AIScript = \"%s\",", replay.Players[i].AIScript.c_str());
+		file.printf(" Race = %d,", replay.Players[i].Race);
 		//Wyrmgus start
-		if (CurrentReplay->Players[i].Faction != nullptr) {
-			file.printf(" Faction = \"%s\",", CurrentReplay->Players[i].Faction->get_identifier().c_str());
+		if (replay.Players[i].Faction != nullptr) {
+			file.printf(" Faction = \"%s\",", replay.Players[i].Faction->get_identifier().c_str());
 		}
 		//Wyrmgus end
-		file.printf(" Team = %d,", CurrentReplay->Players[i].Team);
-		file.printf(" Type = %d }%s", static_cast<int>(CurrentReplay->Players[i].Type),
+		file.printf(" Team = %d,", replay.Players[i].Team);
+		file.printf(" Type = %d }%s", static_cast<int>(replay.Players[i].Type),
 					i != PlayerMax - 1 ? ",\n" : "\n");
 	}
 	file.printf("  },\n");
-	file.printf("  Resource = %d,\n", CurrentReplay->Resource);
-	file.printf("  NumUnits = %d,\n", CurrentReplay->NumUnits);
-	file.printf("  Difficulty = %d,\n", CurrentReplay->Difficulty);
-	file.printf("  NoFow = %s,\n", CurrentReplay->NoFow ? "true" : "false");
-	file.printf("  Inside = %s,\n", CurrentReplay->Inside ? "true" : "false");
-	file.printf("  RevealMap = %d,\n", CurrentReplay->RevealMap);
-	file.printf("  GameType = %d,\n", CurrentReplay->GameType);
-	file.printf("  Opponents = %d,\n", CurrentReplay->Opponents);
-	file.printf("  MapRichness = %d,\n", CurrentReplay->MapRichness);
+	file.printf("  Resource = %d,\n", replay.Resource);
+	file.printf("  NumUnits = %d,\n", replay.NumUnits);
+	file.printf("  Difficulty = %d,\n", replay.Difficulty);
+	file.printf("  NoFow = %s,\n", replay.NoFow ? "true" : "false");
+	file.printf("  Inside = %s,\n", replay.Inside ? "true" : "false");
+	file.printf("  RevealMap = %d,\n", replay.RevealMap);
+	file.printf("  GameType = %d,\n", replay.GameType);
+	file.printf("  Opponents = %d,\n", replay.Opponents);
+	file.printf("  MapRichness = %d,\n", replay.MapRichness);
 	//Wyrmgus start
-	file.printf("  TechLevel = %d,\n", CurrentReplay->TechLevel);
-	file.printf("  MaxTechLevel = %d,\n", CurrentReplay->MaxTechLevel);
+	file.printf("  TechLevel = %d,\n", replay.TechLevel);
+	file.printf("  MaxTechLevel = %d,\n", replay.MaxTechLevel);
 	//Wyrmgus end
 	file.printf("  Engine = { %d, %d, %d },\n",
-				CurrentReplay->Engine[0], CurrentReplay->Engine[1], CurrentReplay->Engine[2]);
+				replay.Engine[0], replay.Engine[1], replay.Engine[2]);
 	file.printf("  Network = { %d, %d, %d }\n",
-				CurrentReplay->Network[0], CurrentReplay->Network[1], CurrentReplay->Network[2]);
+				replay.Network[0], replay.Network[1], replay.Network[2]);
 	file.printf("} )\n");
+}
+
+/**
+**  Output the FullReplay list to file
+**
+**  @param file  The file to output to
+*/
+static void SaveFullLog(CFile &file)
+{
+	file.printf("\n--- -----------------------------------------\n");
+	file.printf("--- MODULE: replay list\n");
+
+	file.printf("\n");
+	SaveReplayHeader(*CurrentReplay, file);
 	const LogEntry *log = CurrentReplay->Commands.get();
 	while (log) {
 		PrintLogCommand(*log, file);
@@ -363,6 +427,123 @@ static void SaveFullLog(CFile &file)
 	}
 }
 
+/**
+**  Convert a log entry to a binary replay command
+*/
+static wyrmgus::replay_command ToReplayCommand(const LogEntry &log)
+{
+	wyrmgus::replay_command command;
+	command.game_cycle = log.GameCycle;
+	command.unit_number = log.UnitNumber;
+	command.group_unit_numbers = log.GroupUnitNumbers;
+	command.unit_ident = log.UnitIdent;
+	command.action = log.Action;
+	command.flush = log.Flush;
+	command.pos_x = log.PosX;
+	command.pos_y = log.PosY;
+	command.dest_unit_number = log.DestUnitNumber;
+	command.value = log.Value;
+	command.num = log.Num;
+	command.sync_rand_seed = log.SyncRandSeed;
+	return command;
+}
+
+/**
+**  Convert a binary replay command to a log entry
+*/
+static std::unique_ptr<LogEntry> FromReplayCommand(const wyrmgus::replay_command &command)
+{
+	auto log = std::make_unique<LogEntry>();
+	log->GameCycle = command.game_cycle;
+	log->UnitNumber = command.unit_number;
+	log->GroupUnitNumbers = command.group_unit_numbers;
+	log->UnitIdent = command.unit_ident;
+	log->Action = command.action;
+	log->Flush = command.flush;
+	log->PosX = command.pos_x;
+	log->PosY = command.pos_y;
+	log->DestUnitNumber = command.dest_unit_number;
+	log->Value = command.value;
+	log->Num = command.num;
+	log->SyncRandSeed = command.sync_rand_seed;
+	return log;
+}
+
+/**
+**  Save a replay to a file in the binary replay format
+**
+**  @param replay    The replay to save
+**  @param filepath  The file to save to
+*/
+static void SaveBinaryReplayFile(const FullReplay &replay, const std::filesystem::path &filepath)
+{
+	wyrmgus::binary_replay binary_replay;
+
+	CFile header_file;
+	header_file.open_memory();
+	SaveReplayHeader(replay, header_file);
+	header_file.close();
+	binary_replay.set_header(header_file.take_memory_data());
+
+	for (const LogEntry *log = replay.Commands.get(); log != nullptr; log = log->Next.get()) {
+		binary_replay.add_command(ToReplayCommand(*log));
+	}
+
+	for (const wyrmgus::replay_checkpoint &checkpoint : replay.Checkpoints) {
+		binary_replay.add_checkpoint(wyrmgus::replay_checkpoint(checkpoint));
+	}
+
+	const std::string data = binary_replay.to_bytes();
+
+	std::ofstream ofstream(filepath, std::ios::binary);
+	ofstream.write(data.data(), data.size());
+
+	if (!ofstream) {
+		throw std::runtime_error("Failed to write binary replay \"" + path::to_string(filepath) + "\".");
+	}
+}
+
+/**
+**  Whether a file is a replay in the binary replay format
+*/
+static bool IsBinaryReplayFile(const std::filesystem::path &filepath)
+{
+	std::array<char, wyrmgus::binary_replay::magic.size()> magic{};
+
+	std::ifstream ifstream(filepath, std::ios::binary);
+	ifstream.read(magic.data(), magic.size());
+
+	return ifstream && wyrmgus::binary_replay::is_binary_replay(std::string_view(magic.data(), magic.size()));
+}
+
+/**
+**  Load a replay in the binary replay format as the current replay
+*/
+static void LoadBinaryReplayFile(const std::filesystem::path &filepath)
+{
+	std::ifstream ifstream(filepath, std::ios::binary);
+	if (!ifstream) {
+		throw std::runtime_error("Failed to open binary replay \"" + path::to_string(filepath) + "\".");
+	}
+
+	const std::string data((std::istreambuf_iterator<char>(ifstream)), std::istreambuf_iterator<char>());
+
+	wyrmgus::binary_replay binary_replay = wyrmgus::binary_replay::from_bytes(data);
+
+	//the header creates the current replay
+	CclCommand(binary_replay.get_header());
+	assert_throw(CurrentReplay != nullptr);
+
+	std::unique_ptr<LogEntry> *last = &CurrentReplay->Commands;
+	for (const wyrmgus::replay_command &command : binary_replay.get_commands()) {
+		*last = FromReplayCommand(command);
+		last = &(*last)->Next;
+		++CurrentReplay->CommandCount;
+	}
+
+	CurrentReplay->Checkpoints = binary_replay.take_checkpoints();
+}
+
 /**
 **  Append the LogEntry structure at the end of currentLog, and to LogFile
 **
@@ -380,11 +561,37 @@ static void AppendLog(std::unique_ptr<LogEntry> &&log, CFile &file)
 	LogEntry *log_ptr = log.get();
 	*last = std::move(log);
 	log_ptr->Next = nullptr;
+	++CurrentReplay->CommandCount;
 
 	PrintLogCommand(*log_ptr, file);
 	file.flush();
 }
 
+/**
+**  Whether a log entry gives the same command as a pending group log entry,
+**  so that its unit can be added to it.
+*/
+static bool IsSameGroupLogCommand(const LogEntry &group_log, const LogEntry &log)
+{
+	return ToReplayCommand(group_log).has_same_order(ToReplayCommand(log));
+}
+
+/**
+**  Write the pending group log entry, if any.
+*/
+static void FlushPendingGroupLog()
+{
+	if (PendingGroupLog == nullptr) {
+		return;
+	}
+
+	if (LogFile != nullptr && CurrentReplay != nullptr) {
+		AppendLog(std::move(PendingGroupLog), *LogFile);
+	} else {
+		PendingGroupLog.reset();
+	}
+}
+
 /**
 **  Log commands into file.
 **
@@ -411,11 +618,7 @@ void CommandLog(const char *action, const CUnit *unit, int flush,
 	//
 	if (!LogFile) {
 		struct stat tmp;
-		std::filesystem::path path = parameters::get()->GetUserDirectory();
-		if (!GameName.empty()) {
-			path /= GameName;
-		}
-		path /= "logs";
+		std::filesystem::path path = GetReplayLogDirectory();
 
 		if (stat(path::to_string(path).c_str(), &tmp) < 0) {
 			makedir(path::to_string(path).c_str(), 0777);
@@ -431,6 +634,9 @@ void CommandLog(const char *action, const CUnit *unit, int flush,
 			return;
 		}
 
+		BinaryLogFilepath = path;
+		BinaryLogFilepath.replace_extension(".wrpl");
+
 		if (CurrentReplay) {
 			SaveFullLog(*LogFile);
 		}
@@ -482,10 +688,42 @@ void CommandLog(const char *action, const CUnit *unit, int flush,
 
 	log->SyncRandSeed = wyrmgus::random::get()->get_seed();
 
+	if (CommandLogGrouping) {
+		if (PendingGroupLog != nullptr && IsSameGroupLogCommand(*PendingGroupLog, *log)) {
+			PendingGroupLog->GroupUnitNumbers.push_back(log->UnitNumber);
+			return;
+		}
+
+		FlushPendingGroupLog();
+
+		if (log->UnitNumber != -1) {
+			PendingGroupLog = std::move(log);
+			return;
+		}
+	}
+
 	// Append it to ReplayLog list
 	AppendLog(std::move(log), *LogFile);
 }
 
+/**
+**  Begin merging logged commands which give the same order to several
+**  units into a single log entry.
+*/
+void BeginCommandLogGroup()
+{
+	CommandLogGrouping = true;
+}
+
+/**
+**  End merging logged commands, writing the pending group log entry.
+*/
+void EndCommandLogGroup()
+{
+	FlushPendingGroupLog();
+	CommandLogGrouping = false;
+}
+
 /**
 ** Parse log
 */
@@ -512,6 +750,14 @@ static int CclLog(lua_State *l)
 			log->GameCycle = LuaToNumber(l, -1);
 		} else if (!strcmp(value, "UnitNumber")) {
 			log->UnitNumber = LuaToNumber(l, -1);
+		} else if (!strcmp(value, "GroupUnitNumbers")) {
+			if (!lua_istable(l, -1)) {
+				LuaError(l, "incorrect argument");
+			}
+			const int subargs = lua_rawlen(l, -1);
+			for (int k = 0; k < subargs; ++k) {
+				log->GroupUnitNumbers.push_back(LuaToNumber(l, -1, k + 1));
+			}
 		} else if (!strcmp(value, "UnitIdent")) {
 			log->UnitIdent = LuaToString(l, -1);
 		} else if (!strcmp(value, "Action")) {
@@ -543,6 +789,7 @@ static int CclLog(lua_State *l)
 	}
 
 	*last = std::move(log);
+	++CurrentReplay->CommandCount;
 
 	return 0;
 }
@@ -672,6 +919,10 @@ static int CclReplayLog(lua_State *l)
 	}
 
 	// Apply CurrentReplay settings.
+	if (ConvertingReplay) {
+		return 0;
+	}
+
 	if (!SaveGameLoading) {
 		ApplyReplaySettings();
 	} else {
@@ -689,6 +940,14 @@ bool IsReplayGame()
 	return ReplayGameType != ReplayNone;
 }
 
+/**
+**  Check if all the commands of the replay being played have been executed
+*/
+bool IsReplayFinished()
+{
+	return CurrentReplay == nullptr || (!InitReplay && ReplayStep == nullptr);
+}
+
 /**
 **  Save generated replay
 **
@@ -696,6 +955,11 @@ bool IsReplayGame()
 */
 void SaveReplayList(CFile &file)
 {
+	//the commands up to a checkpoint are already in the replay, so they do not need to be part of its game state
+	if (SavingReplayCheckpoint) {
+		return;
+	}
+
 	SaveFullLog(file);
 }
 
@@ -709,7 +973,11 @@ int LoadReplay(const std::filesystem::path &filepath)
 	CleanReplayLog();
 	ReplayGameType = ReplaySinglePlayer;
 
-	LuaLoadFile(path::to_string(filepath));
+	if (IsBinaryReplayFile(filepath)) {
+		LoadBinaryReplayFile(filepath);
+	} else {
+		LuaLoadFile(path::to_string(filepath));
+	}
 
 	NextLogCycle = ~0UL;
 	if (!CommandLogDisabled) {
@@ -722,14 +990,76 @@ int LoadReplay(const std::filesystem::path &filepath)
 	return 0;
 }
 
+/**
+**  Add a checkpoint to the current replay. If the replay has too many
+**  checkpoints afterwards, every second one is dropped, so that checkpoints
+**  remain spread over the whole replay.
+**
+**  @param checkpoint  The checkpoint to add
+*/
+static void AddReplayCheckpoint(wyrmgus::replay_checkpoint &&checkpoint)
+{
+	std::vector<wyrmgus::replay_checkpoint> &checkpoints = CurrentReplay->Checkpoints;
+
+	checkpoints.push_back(std::move(checkpoint));
+
+	if (checkpoints.size() <= MaxReplayCheckpoints) {
+		return;
+	}
+
+	//keep the first checkpoint and every second one after it, as well as the latest one
+	size_t kept_count = 0;
+	for (size_t i = 0; i < checkpoints.size(); ++i) {
+		if (i % 2 == 0 || i == checkpoints.size() - 1) {
+			checkpoints[kept_count++] = std::move(checkpoints[i]);
+		}
+	}
+	checkpoints.resize(kept_count);
+}
+
+/**
+**  Wait for the game state of the pending replay checkpoint to be
+**  compressed, and add the checkpoint to the current replay.
+*/
+static void FinishReplayCheckpoint()
+{
+	if (!PendingReplayCheckpointFuture.valid()) {
+		return;
+	}
+
+	try {
+		PendingReplayCheckpointFuture.get();
+
+		if (CurrentReplay != nullptr) {
+			AddReplayCheckpoint(std::move(*PendingReplayCheckpoint));
+		}
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+	}
+
+	PendingReplayCheckpoint.reset();
+}
+
 /**
 **  End logging
 */
 void EndReplayLog()
 {
+	FinishReplayCheckpoint();
+	PendingGroupLog.reset();
+	CommandLogGrouping = false;
 	if (LogFile != nullptr) {
 		LogFile->close();
 		LogFile.reset();
+
+		//also keep the recorded game as a binary replay, which includes its checkpoints
+		if (CurrentReplay != nullptr) {
+			try {
+				SaveBinaryReplayFile(*CurrentReplay, BinaryLogFilepath);
+			} catch (const std::exception &exception) {
+				exception::report(exception);
+			}
+		}
 	}
 	if (CurrentReplay != nullptr) {
 		CurrentReplay.reset();
@@ -742,6 +1072,7 @@ void EndReplayLog()
 */
 void CleanReplayLog()
 {
+	FinishReplayCheckpoint();
 	if (CurrentReplay != nullptr) {
 		CurrentReplay.reset();
 	}
@@ -757,52 +1088,12 @@ void CleanReplayLog()
 }
 
 /**
-**  Do next replay
+**  Execute a replayed command for a unit
 */
-static void DoNextReplay()
+static void DoReplayAction(CUnit *unit, const char *action, const int flags, const Vec2i &pos, CUnit *dunit, const char *val, const int num)
 {
-	assert_throw(ReplayStep != 0);
-
-	NextLogCycle = ReplayStep->GameCycle;
-
-	if (NextLogCycle != GameCycle) {
-		return;
-	}
-
-	const int unitSlot = ReplayStep->UnitNumber;
-	const char *action = ReplayStep->Action.c_str();
-	const int flags = ReplayStep->Flush;
-	const Vec2i pos(ReplayStep->PosX, ReplayStep->PosY);
-	const int arg1 = ReplayStep->PosX;
-	const int arg2 = ReplayStep->PosY;
-	CUnit *unit = unitSlot != -1 ? &wyrmgus::unit_manager::get()->GetSlotUnit(unitSlot) : nullptr;
-	CUnit *dunit = (ReplayStep->DestUnitNumber != -1 ? &wyrmgus::unit_manager::get()->GetSlotUnit(ReplayStep->DestUnitNumber) : nullptr);
-	const char *val = ReplayStep->Value.c_str();
-	const int num = ReplayStep->Num;
-
-	assert_throw(unitSlot == -1 || ReplayStep->UnitIdent == unit->Type->get_identifier());
-
-	if (wyrmgus::random::get()->get_seed() != ReplayStep->SyncRandSeed) {
-#ifdef DEBUG
-		if (!ReplayStep->SyncRandSeed) {
-			// Replay without the 'sync info
-			CPlayer::GetThisPlayer()->Notify("%s", _("No sync info for this replay !"));
-		} else {
-			CPlayer::GetThisPlayer()->Notify(_("Replay got out of sync (%lu)!"), GameCycle);
-			DebugPrint("OUT OF SYNC %u != %u\n" _C_ random::get()->get_seed() _C_ ReplayStep->SyncRandSeed);
-			DebugPrint("OUT OF SYNC GameCycle %lu \n" _C_ GameCycle);
-			assert_throw(false);
-			// ReplayStep = 0;
-			// NextLogCycle = ~0UL;
-			// return;
-		}
-#else
-		CPlayer::GetThisPlayer()->Notify("%s", _("Replay got out of sync!"));
-		ReplayStep = 0;
-		NextLogCycle = ~0UL;
-		return;
-#endif
-	}
+	const int arg1 = pos.x;
+	const int arg2 = pos.y;
 
 	if (!strcmp(action, "stop")) {
 		SendCommandStopUnit(*unit);
@@ -906,8 +1197,68 @@ static void DoNextReplay()
 	} else {
 		DebugPrint("Invalid action: %s" _C_ action);
 	}
+}
+
+/**
+**  Do next replay
+*/
+static void DoNextReplay()
+{
+	assert_throw(ReplayStep != 0);
+
+	NextLogCycle = ReplayStep->GameCycle;
+
+	if (NextLogCycle != GameCycle) {
+		return;
+	}
+
+	const int unitSlot = ReplayStep->UnitNumber;
+	const char *action = ReplayStep->Action.c_str();
+	const int flags = ReplayStep->Flush;
+	const Vec2i pos(ReplayStep->PosX, ReplayStep->PosY);
+	CUnit *unit = unitSlot != -1 ? &wyrmgus::unit_manager::get()->GetSlotUnit(unitSlot) : nullptr;
+	CUnit *dunit = (ReplayStep->DestUnitNumber != -1 ? &wyrmgus::unit_manager::get()->GetSlotUnit(ReplayStep->DestUnitNumber) : nullptr);
+	const char *val = ReplayStep->Value.c_str();
+	const int num = ReplayStep->Num;
+
+	assert_throw(unitSlot == -1 || ReplayStep->UnitIdent == unit->Type->get_identifier());
+
+	if (wyrmgus::random::get()->get_seed() != ReplayStep->SyncRandSeed) {
+#ifdef DEBUG
+		if (!ReplayStep->SyncRandSeed) {
+			// Replay without the 'sync info
+			CPlayer::GetThisPlayer()->Notify("%s", _("No sync info for this replay !"));
+		} else {
+			CPlayer::GetThisPlayer()->Notify(_("Replay got out of sync (%lu)!"), GameCycle);
+			DebugPrint("OUT OF SYNC %u != %u\n" _C_ random::get()->get_seed() _C_ ReplayStep->SyncRandSeed);
+			DebugPrint("OUT OF SYNC GameCycle %lu \n" _C_ GameCycle);
+			assert_throw(false);
+			// ReplayStep = 0;
+			// NextLogCycle = ~0UL;
+			// return;
+		}
+#else
+		CPlayer::GetThisPlayer()->Notify("%s", _("Replay got out of sync!"));
+		ReplayStep = 0;
+		NextLogCycle = ~0UL;
+		return;
+#endif
+	}
+
+	if (ReplayStep->GroupUnitNumbers.empty()) {
+		DoReplayAction(unit, action, flags, pos, dunit, val, num);
+	} else {
+		//the same command given to several units
+		BeginCommandLogGroup();
+		DoReplayAction(unit, action, flags, pos, dunit, val, num);
+		for (const int group_unit_slot : ReplayStep->GroupUnitNumbers) {
+			DoReplayAction(&wyrmgus::unit_manager::get()->GetSlotUnit(group_unit_slot), action, flags, pos, dunit, val, num);
+		}
+		EndCommandLogGroup();
+	}
 
 	ReplayStep = ReplayStep->Next.get();
+	++ReplayStepIndex;
 	NextLogCycle = ReplayStep ? ReplayStep->GameCycle : ~0UL;
 }
 
@@ -926,6 +1277,7 @@ static void ReplayEachCycle()
 			}
 		}
 		ReplayStep = CurrentReplay->Commands.get();
+		ReplayStepIndex = 0;
 		NextLogCycle = (ReplayStep ? ReplayStep->GameCycle : ~0UL);
 		InitReplay = 0;
 	}
@@ -970,6 +1322,199 @@ void MultiPlayerReplayEachCycle()
 	}
 }
 
+/**
+**  Take a snapshot of the game state for the current replay periodically,
+**  so that its playback can later be resumed from it; if the replay already
+**  has a checkpoint for the cycle, check that the game is still in sync
+**  with it instead
+*/
+void ReplayCheckpointEachCycle()
+{
+	if (CurrentReplay == nullptr || GameCycle == 0) {
+		return;
+	}
+
+	const size_t command_index = IsReplayGame() ? ReplayStepIndex : CurrentReplay->CommandCount;
+
+	//the checkpoints a replay was recorded with are checked against even if no new checkpoints are being taken
+	if (!CurrentReplay->Checkpoints.empty() && CurrentReplay->Checkpoints.back().game_cycle >= GameCycle) {
+		const wyrmgus::replay_checkpoint *checkpoint = wyrmgus::find_replay_checkpoint(CurrentReplay->Checkpoints, GameCycle);
+
+		//the game state can only be compared if the same commands have been executed as when the checkpoint was taken
+		if (checkpoint != nullptr && checkpoint->game_cycle == GameCycle && checkpoint->command_index == command_index && checkpoint->sync_hash != SyncHash) {
+			CPlayer::GetThisPlayer()->Notify("%s", _("Replay got out of sync!"));
+			DebugPrint("OUT OF SYNC at checkpoint: SyncHash %u != %u, GameCycle %lu\n" _C_ SyncHash _C_ checkpoint->sync_hash _C_ GameCycle);
+		}
+
+		return;
+	}
+
+	if (ReplayCheckpointInterval == 0 || GameCycle % ReplayCheckpointInterval != 0) {
+		return;
+	}
+
+	//taking snapshots would distort the timing of a headless simulation
+	if (wyrmgus::headless_simulation::get()->is_running()) {
+		return;
+	}
+
+	//the previous checkpoint has had a whole interval to be compressed
+	FinishReplayCheckpoint();
+
+	try {
+		//the game state has to be written on the game thread, but compressing it can be done in the background
+		CFile file;
+		file.open_memory();
+		SavingReplayCheckpoint = true;
+		game::get()->write_save_data(file);
+		SavingReplayCheckpoint = false;
+		file.close();
+
+		PendingReplayCheckpoint = std::make_unique<wyrmgus::replay_checkpoint>();
+		PendingReplayCheckpoint->game_cycle = GameCycle;
+		PendingReplayCheckpoint->command_index = command_index;
+		PendingReplayCheckpoint->sync_hash = SyncHash;
+		PendingReplayCheckpoint->sync_rand_seed = wyrmgus::random::get()->get_seed();
+
+		PendingReplayCheckpointFuture = thread_pool::get()->co_spawn_future([checkpoint = PendingReplayCheckpoint.get(), state_data = file.take_memory_data()]() -> boost::asio::awaitable<void> {
+			checkpoint->state = wyrmgus::save_container::compress_chunk(state_data);
+			co_return;
+		});
+	} catch (const std::exception &exception) {
+		SavingReplayCheckpoint = false;
+		exception::report(exception);
+	}
+}
+
+/**
+**  Move the replay being played to a game cycle, resuming it from the
+**  latest checkpoint before the cycle and fast-forwarding from there
+**
+**  @param game_cycle  The game cycle to move to
+*/
+void SeekReplay(const unsigned long game_cycle)
+{
+	if (!IsReplayGame() || CurrentReplay == nullptr) {
+		return;
+	}
+
+	FinishReplayCheckpoint();
+
+	const wyrmgus::replay_checkpoint *checkpoint = wyrmgus::find_replay_checkpoint(CurrentReplay->Checkpoints, game_cycle);
+
+	//if the current cycle is already past the latest checkpoint before the target, just fast-forward to it
+	if (game_cycle >= GameCycle && (checkpoint == nullptr || checkpoint->game_cycle <= GameCycle)) {
+		FastForwardCycle = game_cycle;
+		return;
+	}
+
+	if (checkpoint == nullptr) {
+		CPlayer::GetThisPlayer()->Notify("%s", _("The replay has no checkpoint before that time."));
+		return;
+	}
+
+	auto seek = std::make_unique<ReplaySeek>();
+	seek->StateFilepath = GetReplayLogDirectory() / "replay_checkpoint.sav";
+	seek->Type = ReplayGameType;
+	seek->CommandIndex = checkpoint->command_index;
+	seek->TargetCycle = game_cycle;
+
+	try {
+		std::string state_data;
+		wyrmgus::save_container::decompress_chunk(checkpoint->state.data, checkpoint->state.uncompressed_size, state_data);
+
+		std::ofstream ofstream(seek->StateFilepath, std::ios::binary);
+		ofstream.write(state_data.data(), state_data.size());
+
+		if (!ofstream) {
+			throw std::runtime_error("Failed to write replay checkpoint \"" + path::to_string(seek->StateFilepath) + "\".");
+		}
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+		return;
+	}
+
+	//load the checkpoint as a saved game, and then continue playing the replay from it
+	seek->Replay = std::move(CurrentReplay);
+	set_load_game_file(seek->StateFilepath);
+	PendingReplaySeek = std::move(seek);
+	StopGame(GameNoResult);
+}
+
+/**
+**  Continue playing a replay after the game state of one of its checkpoints
+**  has been loaded
+**
+**  @param filepath  The save file which has been loaded
+*/
+void ApplyPendingReplaySeek(const std::filesystem::path &filepath)
+{
+	if (PendingReplaySeek == nullptr) {
+		return;
+	}
+
+	const std::unique_ptr<ReplaySeek> seek = std::move(PendingReplaySeek);
+
+	if (filepath != seek->StateFilepath) {
+		//a different game was loaded in the meantime
+		return;
+	}
+
+	CurrentReplay = std::move(seek->Replay);
+	ReplayGameType = seek->Type;
+	CommandLogDisabled = true;
+	DisabledLog = true;
+	GameObserve = true;
+	InitReplay = 0;
+
+	ReplayStep = CurrentReplay->Commands.get();
+	ReplayStepIndex = 0;
+	while (ReplayStep != nullptr && ReplayStepIndex < seek->CommandIndex) {
+		ReplayStep = ReplayStep->Next.get();
+		++ReplayStepIndex;
+	}
+	NextLogCycle = ReplayStep ? ReplayStep->GameCycle : ~0UL;
+
+	FastForwardCycle = seek->TargetCycle;
+}
+
+/**
+**  Convert a replay log to the binary replay format
+**
+**  @param source_filepath       The replay log to convert
+**  @param destination_filepath  The binary replay file to write
+*/
+void ConvertReplayToBinary(const std::filesystem::path &source_filepath, const std::filesystem::path &destination_filepath)
+{
+	if (IsBinaryReplayFile(source_filepath)) {
+		std::filesystem::copy_file(source_filepath, destination_filepath, std::filesystem::copy_options::overwrite_existing);
+		return;
+	}
+
+	//parse the replay log without replacing the current replay or applying its settings
+	std::unique_ptr<FullReplay> current_replay = std::move(CurrentReplay);
+	ConvertingReplay = true;
+
+	try {
+		LuaLoadFile(path::to_string(source_filepath));
+	} catch (...) {
+		ConvertingReplay = false;
+		CurrentReplay = std::move(current_replay);
+		throw;
+	}
+
+	ConvertingReplay = false;
+	const std::unique_ptr<FullReplay> converted_replay = std::move(CurrentReplay);
+	CurrentReplay = std::move(current_replay);
+
+	if (converted_replay == nullptr) {
+		throw std::runtime_error("\"" + path::to_string(source_filepath) + "\" is not a replay log.");
+	}
+
+	//checkpoints cannot be created without playing the replay, so a converted replay only gets them once it has been played and saved again
+	SaveBinaryReplayFile(*converted_replay, destination_filepath);
+}
+
 /**
 **  Save the replay
 **
@@ -1031,6 +1576,79 @@ boost::asio::awaitable<void> StartReplay(const std::filesystem::path &filepath,
 	co_await StartMap(CurrentMapPath, false);
 }
 
+/**
+**  Save the current replay, including its checkpoints, in the binary replay format
+**
+**  @param l  Lua state.
+*/
+static int CclSaveBinaryReplay(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	const std::string filename = LuaToString(l, 1);
+
+	if (filename.find_first_of("\\/") != std::string::npos) {
+		LuaError(l, "\\ or / not allowed in SaveBinaryReplay filename");
+	}
+
+	if (CurrentReplay == nullptr) {
+		LuaError(l, "There is no replay to save.");
+	}
+
+	FinishReplayCheckpoint();
+
+	try {
+		SaveBinaryReplayFile(*CurrentReplay, GetReplayLogDirectory() / path::from_string(filename));
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+	}
+
+	return 0;
+}
+
+/**
+**  Convert a replay log to the binary replay format
+**
+**  @param l  Lua state.
+*/
+static int CclConvertReplayToBinary(lua_State *l)
+{
+	LuaCheckArgs(l, 2);
+	const std::filesystem::path source_filepath = path::from_string(LuaToString(l, 1));
+	const std::filesystem::path destination_filepath = path::from_string(LuaToString(l, 2));
+
+	try {
+		ConvertReplayToBinary(source_filepath, destination_filepath);
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+	}
+
+	return 0;
+}
+
+/**
+**  Move the replay being played to a game cycle
+**
+**  @param l  Lua state.
+*/
+static int CclSeekReplay(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	SeekReplay(LuaToUnsignedNumber(l, 1));
+	return 0;
+}
+
+/**
+**  Set the amount of game cycles between replay checkpoints, 0 to disable them
+**
+**  @param l  Lua state.
+*/
+static int CclSetReplayCheckpointInterval(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	ReplayCheckpointInterval = LuaToUnsignedNumber(l, 1);
+	return 0;
+}
+
 /**
 **  Register Ccl functions with lua
 */
@@ -1038,4 +1656,8 @@ void ReplayCclRegister()
 {
 	lua_register(Lua, "Log", CclLog);
 	lua_register(Lua, "ReplayLog", CclReplayLog);
+	lua_register(Lua, "SaveBinaryReplay", CclSaveBinaryReplay);
+	lua_register(Lua, "ConvertReplayToBinary", CclConvertReplayToBinary);
+	lua_register(Lua, "SeekReplay", CclSeekReplay);
+	lua_register(Lua, "SetReplayCheckpointInterval", CclSetReplayCheckpointInterval);
 }
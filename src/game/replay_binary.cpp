@@ -0,0 +1,364 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "game/replay_binary.h"
+
+namespace wyrmgus {
+
+namespace {
+
+//the bits of the field mask of an encoded replay command, for the fields which are not at their default value
+namespace replay_command_field {
+	constexpr uint8_t unit_number = 1 << 0;
+	constexpr uint8_t group_unit_numbers = 1 << 1;
+	constexpr uint8_t unit_ident = 1 << 2;
+	constexpr uint8_t flush = 1 << 3;
+	constexpr uint8_t pos = 1 << 4;
+	constexpr uint8_t dest_unit_number = 1 << 5;
+	constexpr uint8_t value = 1 << 6;
+	constexpr uint8_t num = 1 << 7;
+}
+
+//the minimum encoded sizes of the elements of a replay, which bound how many of them the remaining data can hold
+constexpr size_t min_command_size = 7; //game cycle delta, field mask, action and random seed
+constexpr size_t min_group_unit_number_size = 1;
+constexpr size_t min_checkpoint_size = 15; //game cycle delta, command index, sync hash, random seed, uncompressed size and state size
+
+//read an element count, throwing an exception if the remaining data is too small to hold that many elements, so that an invalid count cannot cause a huge allocation
+size_t read_element_count(save_buffer_reader &reader, const size_t min_element_size)
+{
+	const uint64_t count = reader.read_varint();
+
+	if (count > reader.get_remaining_data().size() / min_element_size) {
+		throw std::runtime_error("Invalid element count in replay data: " + std::to_string(count) + ".");
+	}
+
+	return static_cast<size_t>(count);
+}
+
+//writes strings as indexes into a table, with each string only being written at its first occurrence; index 0 is the empty string
+class replay_string_writer final
+{
+public:
+	void write(save_buffer_writer &writer, const std::string &str)
+	{
+		if (str.empty()) {
+			writer.write_varint(0);
+			return;
+		}
+
+		const auto find_iterator = this->indexes.find(str);
+		if (find_iterator != this->indexes.end()) {
+			writer.write_varint(find_iterator->second);
+			return;
+		}
+
+		const size_t index = this->indexes.size() + 1;
+		this->indexes[str] = index;
+		writer.write_varint(index);
+		writer.write_string(str);
+	}
+
+private:
+	std::map<std::string, size_t> indexes;
+};
+
+class replay_string_reader final
+{
+public:
+	const std::string &read(save_buffer_reader &reader)
+	{
+		static const std::string empty_string;
+
+		const size_t index = static_cast<size_t>(reader.read_varint());
+
+		if (index == 0) {
+			return empty_string;
+		}
+
+		if (index == this->strings.size() + 1) {
+			this->strings.emplace_back(reader.read_string());
+			return this->strings.back();
+		}
+
+		if (index > this->strings.size()) {
+			throw std::runtime_error("Invalid string index in replay data: " + std::to_string(index) + ".");
+		}
+
+		return this->strings[index - 1];
+	}
+
+private:
+	std::deque<std::string> strings; //a deque, so that references to the strings stay valid when more are added
+};
+
+}
+
+binary_replay binary_replay::from_bytes(const std::string_view &data)
+{
+	if (!binary_replay::is_binary_replay(data)) {
+		throw std::runtime_error("Invalid binary replay.");
+	}
+
+	save_buffer_reader reader(data.substr(binary_replay::magic.size()));
+
+	const uint32_t replay_version = reader.read_uint32();
+	if (replay_version != binary_replay::version) {
+		throw std::runtime_error("Unsupported binary replay version: " + std::to_string(replay_version) + ".");
+	}
+
+	binary_replay replay;
+	replay.header = std::string(reader.read_string());
+
+	replay_string_reader string_reader;
+	unsigned long game_cycle = 0;
+
+	const size_t command_count = read_element_count(reader, min_command_size);
+	replay.commands.reserve(command_count);
+
+	for (size_t i = 0; i < command_count; ++i) {
+		replay_command command;
+
+		game_cycle += static_cast<unsigned long>(reader.read_varint());
+		command.game_cycle = game_cycle;
+
+		const uint8_t fields = reader.read_uint8();
+
+		command.action = string_reader.read(reader);
+
+		if (fields & replay_command_field::unit_number) {
+			command.unit_number = static_cast<int>(reader.read_signed_varint());
+		}
+
+		if (fields & replay_command_field::group_unit_numbers) {
+			const size_t group_size = read_element_count(reader, min_group_unit_number_size);
+			command.group_unit_numbers.reserve(group_size);
+			int previous_unit_number = command.unit_number;
+
+			for (size_t j = 0; j < group_size; ++j) {
+				previous_unit_number += static_cast<int>(reader.read_signed_varint());
+				command.group_unit_numbers.push_back(previous_unit_number);
+			}
+		}
+
+		if (fields & replay_command_field::unit_ident) {
+			command.unit_ident = string_reader.read(reader);
+		}
+
+		if (fields & replay_command_field::flush) {
+			command.flush = static_cast<int>(reader.read_signed_varint());
+		}
+
+		if (fields & replay_command_field::pos) {
+			command.pos_x = static_cast<int>(reader.read_signed_varint());
+			command.pos_y = static_cast<int>(reader.read_signed_varint());
+		}
+
+		if (fields & replay_command_field::dest_unit_number) {
+			command.dest_unit_number = static_cast<int>(reader.read_signed_varint());
+		}
+
+		if (fields & replay_command_field::value) {
+			command.value = string_reader.read(reader);
+		}
+
+		if (fields & replay_command_field::num) {
+			command.num = static_cast<int>(reader.read_signed_varint());
+		}
+
+		command.sync_rand_seed = reader.read_uint32();
+
+		replay.commands.push_back(std::move(command));
+	}
+
+	game_cycle = 0;
+
+	const size_t checkpoint_count = read_element_count(reader, min_checkpoint_size);
+	replay.checkpoints.reserve(checkpoint_count);
+
+	for (size_t i = 0; i < checkpoint_count; ++i) {
+		replay_checkpoint checkpoint;
+
+		game_cycle += static_cast<unsigned long>(reader.read_varint());
+		checkpoint.game_cycle = game_cycle;
+		checkpoint.command_index = static_cast<size_t>(reader.read_varint());
+		checkpoint.sync_hash = reader.read_uint32();
+		checkpoint.sync_rand_seed = reader.read_uint32();
+		checkpoint.state.uncompressed_size = reader.read_uint32();
+		checkpoint.state.data = std::string(reader.read_string());
+
+		if (checkpoint.command_index > replay.commands.size()) {
+			throw std::runtime_error("Invalid command index for replay checkpoint: " + std::to_string(checkpoint.command_index) + ".");
+		}
+
+		replay.checkpoints.push_back(std::move(checkpoint));
+	}
+
+	if (!reader.is_at_end()) {
+		throw std::runtime_error("Unexpected data at the end of the binary replay.");
+	}
+
+	return replay;
+}
+
+std::string binary_replay::to_bytes() const
+{
+	save_buffer_writer writer;
+
+	writer.write_bytes(binary_replay::magic.data(), binary_replay::magic.size());
+	writer.write_uint32(binary_replay::version);
+	writer.write_string(this->header);
+
+	replay_string_writer string_writer;
+	unsigned long previous_game_cycle = 0;
+
+	writer.write_varint(this->commands.size());
+
+	for (const replay_command &command : this->commands) {
+		if (command.game_cycle < previous_game_cycle) {
+			throw std::runtime_error("Replay commands are not in game cycle order.");
+		}
+
+		writer.write_varint(command.game_cycle - previous_game_cycle);
+		previous_game_cycle = command.game_cycle;
+
+		uint8_t fields = 0;
+		if (command.unit_number != -1) {
+			fields |= replay_command_field::unit_number;
+		}
+		if (!command.group_unit_numbers.empty()) {
+			fields |= replay_command_field::group_unit_numbers;
+		}
+		if (!command.unit_ident.empty()) {
+			fields |= replay_command_field::unit_ident;
+		}
+		if (command.flush != 0) {
+			fields |= replay_command_field::flush;
+		}
+		if (command.pos_x != -1 || command.pos_y != -1) {
+			fields |= replay_command_field::pos;
+		}
+		if (command.dest_unit_number != -1) {
+			fields |= replay_command_field::dest_unit_number;
+		}
+		if (!command.value.empty()) {
+			fields |= replay_command_field::value;
+		}
+		if (command.num != -1) {
+			fields |= replay_command_field::num;
+		}
+
+		writer.write_uint8(fields);
+
+		string_writer.write(writer, command.action);
+
+		if (fields & replay_command_field::unit_number) {
+			writer.write_signed_varint(command.unit_number);
+		}
+
+		if (fields & replay_command_field::group_unit_numbers) {
+			//group units are mostly selected together and so have close slots, which makes their deltas small
+			writer.write_varint(command.group_unit_numbers.size());
+			int previous_unit_number = command.unit_number;
+
+			for (const int group_unit_number : command.group_unit_numbers) {
+				writer.write_signed_varint(static_cast<int64_t>(group_unit_number) - previous_unit_number);
+				previous_unit_number = group_unit_number;
+			}
+		}
+
+		if (fields & replay_command_field::unit_ident) {
+			string_writer.write(writer, command.unit_ident);
+		}
+
+		if (fields & replay_command_field::flush) {
+			writer.write_signed_varint(command.flush);
+		}
+
+		if (fields & replay_command_field::pos) {
+			writer.write_signed_varint(command.pos_x);
+			writer.write_signed_varint(command.pos_y);
+		}
+
+		if (fields & replay_command_field::dest_unit_number) {
+			writer.write_signed_varint(command.dest_unit_number);
+		}
+
+		if (fields & replay_command_field::value) {
+			string_writer.write(writer, command.value);
+		}
+
+		if (fields & replay_command_field::num) {
+			writer.write_signed_varint(command.num);
+		}
+
+		//the random seed is effectively random, so a varint would not make it smaller
+		writer.write_uint32(command.sync_rand_seed);
+	}
+
+	previous_game_cycle = 0;
+
+	writer.write_varint(this->checkpoints.size());
+
+	for (const replay_checkpoint &checkpoint : this->checkpoints) {
+		writer.write_varint(checkpoint.game_cycle - previous_game_cycle);
+		previous_game_cycle = checkpoint.game_cycle;
+
+		writer.write_varint(checkpoint.command_index);
+		writer.write_uint32(checkpoint.sync_hash);
+		writer.write_uint32(checkpoint.sync_rand_seed);
+		writer.write_uint32(checkpoint.state.uncompressed_size);
+		writer.write_string(checkpoint.state.data);
+	}
+
+	return writer.take_data();
+}
+
+void binary_replay::add_checkpoint(replay_checkpoint &&checkpoint)
+{
+	if (!this->checkpoints.empty() && checkpoint.game_cycle <= this->checkpoints.back().game_cycle) {
+		throw std::runtime_error("Replay checkpoints must be added in game cycle order.");
+	}
+
+	this->checkpoints.push_back(std::move(checkpoint));
+}
+
+const replay_checkpoint *find_replay_checkpoint(const std::vector<replay_checkpoint> &checkpoints, const unsigned long game_cycle)
+{
+	const auto find_iterator = std::upper_bound(checkpoints.begin(), checkpoints.end(), game_cycle, [](const unsigned long cycle, const replay_checkpoint &checkpoint) {
+		return cycle < checkpoint.game_cycle;
+	});
+
+	if (find_iterator == checkpoints.begin()) {
+		return nullptr;
+	}
+
+	return &*std::prev(find_iterator);
+}
+
+}
@@ -0,0 +1,136 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#pragma once
+
+#include "game/save_container.h"
+
+namespace wyrmgus {
+
+//a command recorded in a replay, with the same fields as a text replay log entry; -1 marks an absent number field
+struct replay_command final
+{
+	bool operator ==(const replay_command &rhs) const = default;
+
+	//whether another command gives the same order in the same cycle, so that its unit can be added to this command's group
+	bool has_same_order(const replay_command &other) const
+	{
+		return other.unit_number != -1
+			&& this->game_cycle == other.game_cycle
+			&& this->action == other.action
+			&& this->flush == other.flush
+			&& this->pos_x == other.pos_x
+			&& this->pos_y == other.pos_y
+			&& this->dest_unit_number == other.dest_unit_number
+			&& this->value == other.value
+			&& this->num == other.num;
+	}
+
+	unsigned long game_cycle = 0;
+	int unit_number = -1;
+	std::vector<int> group_unit_numbers;
+	std::string unit_ident;
+	std::string action;
+	int flush = 0;
+	int pos_x = -1;
+	int pos_y = -1;
+	int dest_unit_number = -1;
+	std::string value;
+	int num = -1;
+	unsigned sync_rand_seed = 0;
+};
+
+//a snapshot of the game state taken during a replay, from which playback can be resumed
+struct replay_checkpoint final
+{
+	unsigned long game_cycle = 0;
+	size_t command_index = 0; //the index of the first replay command which is not yet reflected in the snapshot
+	unsigned sync_hash = 0;
+	unsigned sync_rand_seed = 0;
+	save_container::compressed_chunk state; //the compressed save data
+};
+
+//get the latest checkpoint at or before a game cycle from checkpoints sorted by game cycle, or null if there is none
+extern const replay_checkpoint *find_replay_checkpoint(const std::vector<replay_checkpoint> &checkpoints, const unsigned long game_cycle);
+
+//a replay in a compact binary encoding: commands are stored with cycle deltas, a bitmask of their present fields and varint-encoded numbers, and their strings (e.g. actions and unit type identifiers) are written only once and then referred to by index
+class binary_replay final
+{
+public:
+	static constexpr std::array<char, 4> magic = { 'W', 'R', 'P', 'L' };
+	static constexpr uint32_t version = 1;
+
+	static bool is_binary_replay(const std::string_view &data)
+	{
+		return data.starts_with(std::string_view(binary_replay::magic.data(), binary_replay::magic.size()));
+	}
+
+	//decode a binary replay, throwing an exception if the data is invalid
+	static binary_replay from_bytes(const std::string_view &data);
+
+	std::string to_bytes() const;
+
+	//get the Lua script which sets up the replay's game settings
+	const std::string &get_header() const
+	{
+		return this->header;
+	}
+
+	void set_header(const std::string &header)
+	{
+		this->header = header;
+	}
+
+	const std::vector<replay_command> &get_commands() const
+	{
+		return this->commands;
+	}
+
+	void add_command(replay_command &&command)
+	{
+		this->commands.push_back(std::move(command));
+	}
+
+	const std::vector<replay_checkpoint> &get_checkpoints() const
+	{
+		return this->checkpoints;
+	}
+
+	std::vector<replay_checkpoint> take_checkpoints()
+	{
+		return std::move(this->checkpoints);
+	}
+
+	//add a checkpoint; checkpoints must be added in order of their game cycle
+	void add_checkpoint(replay_checkpoint &&checkpoint);
+
+private:
+	std::string header;
+	std::vector<replay_command> commands;
+	std::vector<replay_checkpoint> checkpoints;
+};
+
+}
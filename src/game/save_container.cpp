@@ -0,0 +1,166 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "game/save_container.h"
+
+#include <zlib.h>
+
+namespace wyrmgus {
+
+save_container::compressed_chunk save_container::compress_chunk(const std::string_view &data)
+{
+	compressed_chunk chunk;
+	chunk.uncompressed_size = static_cast<uint32_t>(data.size());
+
+	uLongf compressed_size = compressBound(static_cast<uLong>(data.size()));
+	chunk.data.resize(compressed_size);
+
+	const int result = compress2(reinterpret_cast<Bytef *>(chunk.data.data()), &compressed_size, reinterpret_cast<const Bytef *>(data.data()), static_cast<uLong>(data.size()), Z_BEST_SPEED);
+
+	if (result != Z_OK) {
+		throw std::runtime_error("Failed to compress save data chunk (error " + std::to_string(result) + ").");
+	}
+
+	chunk.data.resize(compressed_size);
+
+	return chunk;
+}
+
+void save_container::decompress_chunk(const std::string_view &compressed_data, const uint32_t uncompressed_size, std::string &output)
+{
+	output.resize(uncompressed_size);
+	uLongf decompressed_size = uncompressed_size;
+
+	const int result = uncompress(reinterpret_cast<Bytef *>(output.data()), &decompressed_size, reinterpret_cast<const Bytef *>(compressed_data.data()), static_cast<uLong>(compressed_data.size()));
+
+	if (result != Z_OK || decompressed_size != uncompressed_size) {
+		throw std::runtime_error("Failed to decompress save data chunk (error " + std::to_string(result) + ").");
+	}
+}
+
+void save_container::for_each_chunk(const std::string_view &container_data, const save_section section, const std::function<void(const std::string_view &)> &function)
+{
+	save_buffer_reader reader(container_data);
+
+	const std::string_view container_magic = reader.read_bytes(save_container::magic.size());
+	if (container_magic != std::string_view(save_container::magic.data(), save_container::magic.size())) {
+		throw std::runtime_error("Invalid save container.");
+	}
+
+	const uint32_t container_version = reader.read_uint32();
+	if (container_version != save_container::version) {
+		throw std::runtime_error("Unsupported save container version: " + std::to_string(container_version) + ".");
+	}
+
+	//the buffer is reused for each chunk, so that chunks are decompressed one at a time
+	std::string chunk_buffer;
+
+	const uint32_t section_count = reader.read_uint32();
+	for (uint32_t i = 0; i < section_count; ++i) {
+		const save_section current_section = static_cast<save_section>(reader.read_uint32());
+		const uint32_t chunk_count = reader.read_uint32();
+
+		for (uint32_t j = 0; j < chunk_count; ++j) {
+			const uint32_t uncompressed_size = reader.read_uint32();
+			const uint32_t compressed_size = reader.read_uint32();
+			const std::string_view compressed_data = reader.read_bytes(compressed_size);
+
+			if (current_section != section) {
+				continue;
+			}
+
+			save_container::decompress_chunk(compressed_data, uncompressed_size, chunk_buffer);
+
+			function(chunk_buffer);
+		}
+	}
+}
+
+std::pair<std::string_view, std::string_view> save_container::split_save_data(const std::string_view &save_data)
+{
+	static constexpr size_t footer_size = sizeof(uint32_t) + save_container::magic.size();
+
+	const std::string_view magic_view(save_container::magic.data(), save_container::magic.size());
+
+	if (save_data.size() < footer_size || !save_data.ends_with(magic_view)) {
+		return { save_data, std::string_view() };
+	}
+
+	save_buffer_reader footer_reader(save_data.substr(save_data.size() - footer_size, sizeof(uint32_t)));
+	const size_t container_size = footer_reader.read_uint32();
+
+	if (container_size > save_data.size() - footer_size) {
+		throw std::runtime_error("Invalid save container size: " + std::to_string(container_size) + ".");
+	}
+
+	const size_t container_start = save_data.size() - footer_size - container_size;
+	const std::string_view container_data = save_data.substr(container_start, container_size);
+
+	if (!container_data.starts_with(magic_view)) {
+		throw std::runtime_error("Invalid save container.");
+	}
+
+	return { save_data.substr(0, container_start), container_data };
+}
+
+std::string save_container::to_bytes() const
+{
+	save_buffer_writer writer;
+
+	writer.write_bytes(save_container::magic.data(), save_container::magic.size());
+	writer.write_uint32(save_container::version);
+	writer.write_uint32(static_cast<uint32_t>(this->sections.size()));
+
+	for (const auto &[section, chunks] : this->sections) {
+		writer.write_uint32(static_cast<uint32_t>(section));
+		writer.write_uint32(static_cast<uint32_t>(chunks.size()));
+
+		for (const compressed_chunk &chunk : chunks) {
+			writer.write_uint32(chunk.uncompressed_size);
+			writer.write_uint32(static_cast<uint32_t>(chunk.data.size()));
+			writer.write_bytes(chunk.data.data(), chunk.data.size());
+		}
+	}
+
+	return writer.take_data();
+}
+
+std::string save_container::to_save_trailer_bytes() const
+{
+	save_buffer_writer writer;
+
+	const std::string container_data = this->to_bytes();
+	writer.write_bytes(container_data.data(), container_data.size());
+	writer.write_uint32(static_cast<uint32_t>(container_data.size()));
+	writer.write_bytes(save_container::magic.data(), save_container::magic.size());
+
+	return writer.take_data();
+}
+
+}
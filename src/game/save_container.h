@@ -0,0 +1,275 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//the sections of a binary save container; the game state which is not in a binary section is still saved as a Lua script, which the container follows in the save file
+enum class save_section : uint32_t {
+	map_tiles = 1
+};
+
+//writes values to a byte buffer, with integers in little-endian order
+class save_buffer_writer final
+{
+public:
+	void write_uint8(const uint8_t value)
+	{
+		this->data.push_back(static_cast<char>(value));
+	}
+
+	void write_uint32(const uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i) {
+			this->write_uint8(static_cast<uint8_t>(value >> (i * 8)));
+		}
+	}
+
+	//write an unsigned integer with 7 bits per byte, so that small values take a single byte
+	void write_varint(uint64_t value)
+	{
+		while (value >= 0x80) {
+			this->write_uint8(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+
+		this->write_uint8(static_cast<uint8_t>(value));
+	}
+
+	//write a signed integer as a varint with zigzag encoding, so that small negative values also take a single byte
+	void write_signed_varint(const int64_t value)
+	{
+		this->write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+	void write_string(const std::string_view &str)
+	{
+		this->write_varint(str.size());
+		this->write_bytes(str.data(), str.size());
+	}
+
+	void write_bytes(const char *bytes, const size_t size)
+	{
+		this->data.append(bytes, size);
+	}
+
+	const std::string &get_data() const
+	{
+		return this->data;
+	}
+
+	std::string take_data()
+	{
+		return std::move(this->data);
+	}
+
+private:
+	std::string data;
+};
+
+//reads values written by a save buffer writer, throwing an exception if the data ends prematurely
+class save_buffer_reader final
+{
+public:
+	explicit save_buffer_reader(const std::string_view &data) : data(data)
+	{
+	}
+
+	bool is_at_end() const
+	{
+		return this->pos == this->data.size();
+	}
+
+	std::string_view get_remaining_data() const
+	{
+		return this->data.substr(this->pos);
+	}
+
+	uint8_t read_uint8()
+	{
+		this->check_remaining_size(1);
+		return static_cast<uint8_t>(this->data[this->pos++]);
+	}
+
+	uint32_t read_uint32()
+	{
+		uint32_t value = 0;
+
+		for (int i = 0; i < 4; ++i) {
+			value |= static_cast<uint32_t>(this->read_uint8()) << (i * 8);
+		}
+
+		return value;
+	}
+
+	uint64_t read_varint()
+	{
+		uint64_t value = 0;
+
+		for (int shift = 0; shift < 64; shift += 7) {
+			const uint8_t byte = this->read_uint8();
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0) {
+				return value;
+			}
+		}
+
+		throw std::runtime_error("Invalid variable-length integer in save data.");
+	}
+
+	int64_t read_signed_varint()
+	{
+		const uint64_t value = this->read_varint();
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	std::string_view read_string()
+	{
+		const size_t size = static_cast<size_t>(this->read_varint());
+		return this->read_bytes(size);
+	}
+
+	std::string_view read_bytes(const size_t size)
+	{
+		this->check_remaining_size(size);
+		const std::string_view bytes = this->data.substr(this->pos, size);
+		this->pos += size;
+		return bytes;
+	}
+
+private:
+	void check_remaining_size(const size_t size) const
+	{
+		if (size > this->data.size() - this->pos) {
+			throw std::runtime_error("Save data ended prematurely.");
+		}
+	}
+
+	std::string_view data;
+	size_t pos = 0;
+};
+
+//writes references to data entries as indexes into a table of their identifiers, with each identifier only being written at its first reference
+template <typename data_entry_type>
+class save_identifier_writer final
+{
+public:
+	void write(save_buffer_writer &writer, const data_entry_type *data_entry)
+	{
+		if (data_entry == nullptr) {
+			writer.write_varint(0);
+			return;
+		}
+
+		const auto find_iterator = this->indexes.find(data_entry);
+		if (find_iterator != this->indexes.end()) {
+			writer.write_varint(find_iterator->second);
+			return;
+		}
+
+		const size_t index = this->indexes.size() + 1;
+		this->indexes[data_entry] = index;
+		writer.write_varint(index);
+		writer.write_string(data_entry->get_identifier());
+	}
+
+private:
+	std::map<const data_entry_type *, size_t> indexes;
+};
+
+//reads references to data entries written by a save identifier writer
+template <typename data_entry_type>
+class save_identifier_reader final
+{
+public:
+	data_entry_type *read(save_buffer_reader &reader)
+	{
+		const size_t index = static_cast<size_t>(reader.read_varint());
+
+		if (index == 0) {
+			return nullptr;
+		}
+
+		if (index == this->data_entries.size() + 1) {
+			data_entry_type *data_entry = data_entry_type::get(std::string(reader.read_string()));
+			this->data_entries.push_back(data_entry);
+			return data_entry;
+		}
+
+		if (index > this->data_entries.size()) {
+			throw std::runtime_error("Invalid identifier index in save data: " + std::to_string(index) + ".");
+		}
+
+		return this->data_entries[index - 1];
+	}
+
+private:
+	std::vector<data_entry_type *> data_entries;
+};
+
+//a versioned binary container of save sections, each of which consists of independently compressed chunks, so that the chunks can be serialized and compressed concurrently, and loaded one at a time
+class save_container final
+{
+public:
+	static constexpr std::array<char, 8> magic = { 'W', 'Y', 'R', 'M', 'S', 'A', 'V', 'E' };
+	static constexpr uint32_t version = 1;
+
+	struct compressed_chunk final
+	{
+		uint32_t uncompressed_size = 0;
+		std::string data;
+	};
+
+	//compress the data of a chunk; this is thread-safe, so that chunks can be compressed while being serialized in parallel
+	static compressed_chunk compress_chunk(const std::string_view &data);
+
+	//decompress the data of a chunk into the output buffer, reusing its memory
+	static void decompress_chunk(const std::string_view &compressed_data, const uint32_t uncompressed_size, std::string &output);
+
+	//call a function for each decompressed chunk of a section in a container, in order; the chunk data is only valid during the call
+	static void for_each_chunk(const std::string_view &container_data, const save_section section, const std::function<void(const std::string_view &)> &function);
+
+	//split save data into the Lua script and the container appended to it; the container data is empty if the save has none
+	static std::pair<std::string_view, std::string_view> split_save_data(const std::string_view &save_data);
+
+	void add_section(const save_section section, std::vector<compressed_chunk> &&chunks)
+	{
+		this->sections.emplace_back(section, std::move(chunks));
+	}
+
+	std::string to_bytes() const;
+
+	//get the bytes to append to the Lua script of a save: the container, followed by a footer with its size and the container magic, so that the loader can find the container from the end of the save data and only pass the script to the Lua interpreter
+	std::string to_save_trailer_bytes() const;
+
+private:
+	std::vector<std::pair<save_section, std::vector<compressed_chunk>>> sections;
+};
+
+}
@@ -0,0 +1,122 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "game/save_writer.h"
+
+#include "util/exception_util.h"
+#include "util/path_util.h"
+#include "util/thread_pool.h"
+
+#include <zlib.h>
+
+namespace wyrmgus {
+
+save_writer::~save_writer()
+{
+	this->wait();
+}
+
+void save_writer::write_async(const std::filesystem::path &filepath, std::string &&snapshot_data, const std::chrono::nanoseconds &snapshot_duration)
+{
+	this->wait();
+
+	statistics save_statistics;
+	save_statistics.snapshot_duration = snapshot_duration;
+	save_statistics.uncompressed_size = snapshot_data.size();
+
+	this->future = thread_pool::get()->co_spawn_future([this, filepath, snapshot_data = std::move(snapshot_data), save_statistics]() -> boost::asio::awaitable<void> {
+		try {
+			this->write(filepath, snapshot_data, save_statistics);
+		} catch (const std::exception &exception) {
+			exception::report(exception);
+		}
+
+		co_return;
+	});
+}
+
+void save_writer::wait()
+{
+	if (this->future.valid()) {
+		this->future.get();
+	}
+}
+
+void save_writer::write(const std::filesystem::path &filepath, const std::string &snapshot_data, statistics save_statistics)
+{
+	const auto start_time = std::chrono::steady_clock::now();
+
+	//write to a temporary file and then rename it, so that an existing save is never left partially overwritten
+	std::filesystem::path gz_filepath = filepath;
+	if (gz_filepath.extension() != ".gz") {
+		gz_filepath += ".gz";
+	}
+
+	std::filesystem::path temp_filepath = gz_filepath;
+	temp_filepath += ".tmp";
+
+	const std::string temp_filepath_str = path::to_string(temp_filepath);
+
+	gzFile gz_file = gzopen(temp_filepath_str.c_str(), "wb");
+	if (gz_file == nullptr) {
+		throw std::runtime_error("Can't save to \"" + temp_filepath_str + "\".");
+	}
+
+	size_t written_size = 0;
+	while (written_size < snapshot_data.size()) {
+		//gzwrite takes an unsigned int size, so write the data in blocks
+		const unsigned int block_size = static_cast<unsigned int>(std::min<size_t>(snapshot_data.size() - written_size, 1 << 20));
+
+		if (gzwrite(gz_file, snapshot_data.data() + written_size, block_size) != static_cast<int>(block_size)) {
+			gzclose(gz_file);
+			std::filesystem::remove(temp_filepath);
+			throw std::runtime_error("Failed to write to \"" + temp_filepath_str + "\".");
+		}
+
+		written_size += block_size;
+	}
+
+	if (gzclose(gz_file) != Z_OK) {
+		std::filesystem::remove(temp_filepath);
+		throw std::runtime_error("Failed to close \"" + temp_filepath_str + "\".");
+	}
+
+	save_statistics.compressed_size = static_cast<size_t>(std::filesystem::file_size(temp_filepath));
+
+	std::filesystem::rename(temp_filepath, gz_filepath);
+
+	save_statistics.write_duration = std::chrono::steady_clock::now() - start_time;
+
+	const long long write_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(save_statistics.write_duration).count();
+	const double megabytes_per_second = static_cast<double>(save_statistics.uncompressed_size) / (1024. * 1024.) / std::max(std::chrono::duration<double>(save_statistics.write_duration).count(), 0.001);
+
+	DebugPrint("Saved \"%s\": snapshot took %lld ms, writing %zu bytes (%zu compressed) took %lld ms (%.1f MB/s).\n" _C_ path::to_string(gz_filepath).c_str() _C_ static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(save_statistics.snapshot_duration).count()) _C_ save_statistics.uncompressed_size _C_ save_statistics.compressed_size _C_ write_milliseconds _C_ megabytes_per_second);
+}
+
+}
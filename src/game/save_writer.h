@@ -0,0 +1,60 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/singleton.h"
+
+namespace wyrmgus {
+
+//writes snapshots of the save data to disk in a background thread, so that the game can keep running while a save is being compressed and written
+class save_writer final : public singleton<save_writer>
+{
+public:
+	struct statistics final
+	{
+		std::chrono::nanoseconds snapshot_duration = std::chrono::nanoseconds(0); //the time taken to serialize the game state to memory, during which the game was stalled
+		std::chrono::nanoseconds write_duration = std::chrono::nanoseconds(0); //the time taken to compress and write the snapshot in the background
+		size_t uncompressed_size = 0;
+		size_t compressed_size = 0;
+	};
+
+	~save_writer();
+
+	//write the snapshot's data to the given (gzip) file in the background; if a previous write is still in progress, this waits for it first
+	void write_async(const std::filesystem::path &filepath, std::string &&snapshot_data, const std::chrono::nanoseconds &snapshot_duration);
+
+	//wait for the write in progress (if any) to finish, e.g. before loading a save file or writing to it synchronously
+	void wait();
+
+private:
+	void write(const std::filesystem::path &filepath, const std::string &snapshot_data, statistics save_statistics);
+
+	std::future<void> future;
+};
+
+}
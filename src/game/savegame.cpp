@@ -58,6 +58,7 @@
 #include "util/path_util.h"
 #include "util/random.h"
 #include "version.h"
+#include "video/graphic_loader.h"
 
 std::filesystem::path load_game_file;
 
@@ -86,6 +87,8 @@ int SaveGame(const std::string &file_url_str)
 boost::asio::awaitable<void> StartSavedGame(const std::filesystem::path &filepath)
 {
 	SaveGameLoading = true;
+	graphic_loader::get()->on_game_load_started();
+	engine_interface::get()->clear_loading_log();
 	LoadGame(filepath);
 
 	co_await StartMap(filepath, false);
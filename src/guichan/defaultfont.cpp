@@ -73,7 +73,7 @@ namespace gcn
         return 8*text.size();
     }
 
-    int DefaultFont::drawGlyph(Graphics* graphics, unsigned char, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+    int DefaultFont::drawGlyph(Graphics* graphics, unsigned char, int x, int y, render_command_buffer &render_commands)
     {
         graphics->drawRectangle(Rectangle(x, y, 8, 8), render_commands);
 
@@ -82,7 +82,7 @@ namespace gcn
 
 	//Wyrmgus start
 //    void DefaultFont::drawString(Graphics* graphics, const std::string& text, int x, int y)
-    void DefaultFont::drawString(Graphics* graphics, const std::string& text, int x, int y, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands)
+    void DefaultFont::drawString(Graphics* graphics, const std::string& text, int x, int y, bool is_normal, render_command_buffer &render_commands)
 	//Wyrmgus end
     {
         Q_UNUSED(is_normal)
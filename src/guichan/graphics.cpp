@@ -120,12 +120,12 @@ namespace gcn
 
     void Graphics::drawImage(const Image *image, int srcX, int srcY,
         int dstX, int dstY, int width,
-        int height, std::vector<std::function<void(renderer *)>> &render_commands) const
+        int height, render_command_buffer &render_commands) const
     {
         this->drawImage(image, srcX, srcY, dstX, dstY, width, height, color_modification(), 0, false, render_commands);
     }
 
-    void Graphics::drawImage(const Image* image, int dstX, int dstY, const color_modification &color_modification, unsigned int transparency, std::vector<std::function<void(renderer *)>> &render_commands) const
+    void Graphics::drawImage(const Image* image, int dstX, int dstY, const color_modification &color_modification, unsigned int transparency, render_command_buffer &render_commands) const
     {
         drawImage(image, 0, 0, dstX, dstY, image->getWidth(), image->getHeight(), color_modification, transparency, false, render_commands);
     }
@@ -139,7 +139,7 @@ namespace gcn
 //    void Graphics::drawText(const std::string& text, int x, int y,
 //                            unsigned int alignment)
     void Graphics::drawText(const std::string& text, int x, int y,
-                            unsigned int alignment, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands)
+                            unsigned int alignment, bool is_normal, render_command_buffer &render_commands)
 	//Wyrmgus end
     {
         if (mFont == nullptr)
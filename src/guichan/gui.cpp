@@ -241,7 +241,7 @@ namespace gcn
         mTop->logic();
     }
 
-    void Gui::draw(Widget* top, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Gui::draw(Widget* top, render_command_buffer &render_commands)
     {
         if (!top)
         {
@@ -279,7 +279,7 @@ namespace gcn
         }
     }
 
-    void Gui::draw(std::vector<std::function<void(renderer *)>> &render_commands)
+    void Gui::draw(render_command_buffer &render_commands)
     {
         draw(mTop, render_commands);
     }
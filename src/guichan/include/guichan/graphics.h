@@ -61,6 +61,7 @@
 
 namespace wyrmgus {
     class color_modification;
+    class render_command_buffer;
     class renderer;
 }
 
@@ -182,12 +183,12 @@ namespace gcn
                                int dstX, int dstY, int width,
 							   //Wyrmgus start
 //                               int height) = 0;
-                               int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, std::vector<std::function<void(renderer *)>> &render_commands) const = 0;
+                               int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, render_command_buffer &render_commands) const = 0;
 							   //Wyrmgus end
 
         void drawImage(const Image *image, int srcX, int srcY,
             int dstX, int dstY, int width,
-            int height, std::vector<std::function<void(renderer *)>> &render_commands) const;
+            int height, render_command_buffer &render_commands) const;
 
         /**
          * Draws an image. A simplified version of the other drawImage.
@@ -197,7 +198,7 @@ namespace gcn
          */
 		//Wyrmgus start
 //        virtual void drawImage(const Image* image, int dstX, int dstY);
-        virtual void drawImage(const Image* image, int dstX, int dstY, const color_modification &color_modification, unsigned int transparency, std::vector<std::function<void(renderer *)>> &render_commands) const;
+        virtual void drawImage(const Image* image, int dstX, int dstY, const color_modification &color_modification, unsigned int transparency, render_command_buffer &render_commands) const;
 		//Wyrmgus end
 
         /**
@@ -208,21 +209,21 @@ namespace gcn
          * @param x2 the second x coordinate.
          * @param y2 the second y coordinate.
          */
-        virtual void drawLine(int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands) = 0;
+        virtual void drawLine(int x1, int y1, int x2, int y2, render_command_buffer &render_commands) = 0;
 
         /**
          * Draws a simple, non-filled, Rectangle with one pixel width.
          *
          * @param rectangle the Rectangle to draw.
          */
-        virtual void drawRectangle(const Rectangle& rectangle, std::vector<std::function<void(renderer *)>> &render_commands) = 0;
+        virtual void drawRectangle(const Rectangle& rectangle, render_command_buffer &render_commands) = 0;
 
         /**
          * Draws a filled Rectangle.
          *
          * @param rectangle the filled Rectangle to draw.
          */
-        virtual void fillRectangle(const Rectangle& rectangle, std::vector<std::function<void(renderer *)>> &render_commands) = 0;
+        virtual void fillRectangle(const Rectangle& rectangle, render_command_buffer &render_commands) = 0;
 
         /**
          * Sets the Color to use when drawing.
@@ -258,9 +259,9 @@ namespace gcn
 //        virtual void drawText(const std::string& text, int x, int y,
 //                              unsigned int alignment = LEFT);
         virtual void drawText(const std::string& text, int x, int y,
-                              unsigned int alignment, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands);
+                              unsigned int alignment, bool is_normal, render_command_buffer &render_commands);
 
-        void drawText(const std::string &text, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+        void drawText(const std::string &text, int x, int y, render_command_buffer &render_commands)
         {
             this->drawText(text, x, y, LEFT, true, render_commands);
         }
@@ -67,6 +67,7 @@
 #include "guichan/platform.h"
 
 namespace wyrmgus {
+    class render_command_buffer;
     class renderer;
 }
 
@@ -114,7 +115,7 @@ namespace gcn
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) = 0;
+        virtual void draw(Graphics* graphics, render_command_buffer &render_commands) = 0;
 
         /**
          * Draws a the Widget border. A border is drawn around a Widget.
@@ -124,7 +125,7 @@ namespace gcn
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawBorder(Graphics*, std::vector<std::function<void(renderer *)>> &) { }
+        virtual void drawBorder(Graphics*, render_command_buffer &) { }
 
         /**
          * Called for all Widgets in the gui each time Gui::logic is called.
@@ -94,7 +94,7 @@ namespace gcn
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawBox(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawBox(Graphics *graphics, render_command_buffer &render_commands);
 
         /**
          * Checks if the CheckBox is marked.
@@ -132,9 +132,9 @@ namespace gcn
 
         // Inherited from Widget
 
-        virtual void draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void draw(Graphics* graphics, render_command_buffer &render_commands) override;
 
-        virtual void drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void drawBorder(Graphics* graphics, render_command_buffer &render_commands) override;
 
         // Inherited from KeyListener
 
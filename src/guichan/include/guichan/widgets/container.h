@@ -141,9 +141,9 @@ namespace gcn
 
         // Inherited from Widget
 
-        virtual void draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void draw(Graphics* graphics, render_command_buffer &render_commands) override;
 
-        virtual void drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void drawBorder(Graphics* graphics, render_command_buffer &render_commands) override;
 
         virtual void logic() override;
 
@@ -175,7 +175,7 @@ namespace gcn
          *
          * @param graphics the Graphics object to draw with.
          */
-        virtual void drawChildren(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawChildren(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Calls the logic function for all children of Container. The Widgets
@@ -59,6 +59,7 @@
 #include "guichan/widget.h"
 
 namespace wyrmgus {
+    class render_command_buffer;
     class renderer;
 }
 
@@ -80,9 +81,9 @@ namespace gcn
 
         // Inherited from Widget
 
-        virtual void draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void draw(Graphics* graphics, render_command_buffer &render_commands) override;
 
-        virtual void drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void drawBorder(Graphics* graphics, render_command_buffer &render_commands) override;
 
 	//Wyrmgus start
 //    private:
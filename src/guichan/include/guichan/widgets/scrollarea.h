@@ -233,9 +233,9 @@ namespace gcn
 
         // Inherited from Widget
 
-        virtual void draw(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void draw(Graphics *graphics, render_command_buffer &render_commands) override;
 
-        virtual void drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void drawBorder(Graphics* graphics, render_command_buffer &render_commands) override;
 
         virtual void logic() override;
 
@@ -292,63 +292,63 @@ namespace gcn
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawUpButton(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawUpButton(Graphics *graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the down button.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawDownButton(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawDownButton(Graphics *graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the left button.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawLeftButton(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawLeftButton(Graphics *graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the right button.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawRightButton(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawRightButton(Graphics *graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the content in the ScrollArea.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawContent(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawContent(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the vertical scrollbar.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawVBar(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawVBar(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the horizontal scrollbar.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawHBar(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawHBar(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the vertical marker.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawVMarker(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawVMarker(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Draws the horizontal marker.
          *
          * @param graphics a Graphics object to draw with.
          */
-        virtual void drawHMarker(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawHMarker(Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Checks the policies for the scrollbars.
@@ -148,7 +148,7 @@ namespace gcn
          *
          * @param graphics a graphics object to draw with.
          */
-        virtual void drawMarker(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+        virtual void drawMarker(gcn::Graphics* graphics, render_command_buffer &render_commands);
 
         /**
          * Sets the length of the marker.
@@ -197,9 +197,9 @@ namespace gcn
 
         // Inherited from Widget
 
-        virtual void draw(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void draw(gcn::Graphics* graphics, render_command_buffer &render_commands) override;
 
-        virtual void drawBorder(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+        virtual void drawBorder(gcn::Graphics* graphics, render_command_buffer &render_commands) override;
 
         virtual void lostFocus() override;
 
@@ -84,7 +84,7 @@ namespace gcn
         adjustSize();
     }
 
-    void CheckBox::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void CheckBox::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         drawBox(graphics, render_commands);
 
@@ -101,7 +101,7 @@ namespace gcn
         }
     }
 
-    void CheckBox::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void CheckBox::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -125,7 +125,7 @@ namespace gcn
         }
     }
 
-    void CheckBox::drawBox(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void CheckBox::drawBox(Graphics *graphics, render_command_buffer &render_commands)
     {
         int h = getHeight() - 1;
 
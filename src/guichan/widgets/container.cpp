@@ -86,7 +86,7 @@ namespace gcn
 		logicChildren();
 	}
 
-	void Container::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+	void Container::draw(Graphics* graphics, render_command_buffer &render_commands)
 	{
 		if (isOpaque())
 		{
@@ -97,7 +97,7 @@ namespace gcn
 		drawChildren(graphics, render_commands);
 	}
 
-	void Container::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+	void Container::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
 	{
 		Color faceColor = getBaseColor();
 		Color highlightColor, shadowColor;
@@ -130,7 +130,7 @@ namespace gcn
 		}
 	}
 
-	void Container::drawChildren(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+	void Container::drawChildren(Graphics* graphics, render_command_buffer &render_commands)
 	{
 		WidgetIterator iter;
 		for (iter = mWidgets.begin(); iter != mWidgets.end(); iter++)
@@ -178,7 +178,7 @@ namespace gcn
         mFocusHandler.applyChanges();
     }
 
-    void DropDown::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void DropDown::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         if (mScrollArea == nullptr || mScrollArea->getContent() == nullptr)
         {
@@ -239,7 +239,7 @@ namespace gcn
          }
     }
 
-    void DropDown::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void DropDown::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -263,7 +263,7 @@ namespace gcn
         }
     }
 
-    void DropDown::drawButton(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void DropDown::drawButton(Graphics *graphics, render_command_buffer &render_commands)
     {
         Color faceColor, highlightColor, shadowColor;
         int offset;
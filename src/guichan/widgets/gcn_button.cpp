@@ -127,7 +127,7 @@ namespace gcn
     }
     //Wyrmgus end
 
-    void Button::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Button::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -212,7 +212,7 @@ namespace gcn
         }
     }
 
-    void Button::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Button::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
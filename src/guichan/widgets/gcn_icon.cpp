@@ -71,13 +71,13 @@ namespace gcn
         setWidth(image->getWidth());
     }
 
-    void Icon::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Icon::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         graphics->drawImage(mImage, 0, 0, color_modification(), 0, render_commands);
 
     }
 
-    void Icon::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Icon::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
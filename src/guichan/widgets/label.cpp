@@ -97,7 +97,7 @@ namespace gcn
         return mAlignment;
     }
 
-    void Label::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Label::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         int textX = 0;
         int textY = getHeight() / 2 - getFont()->getHeight() / 2;
@@ -122,7 +122,7 @@ namespace gcn
         graphics->drawText(getCaption(), textX, textY, getAlignment(), true, render_commands);
     }
 
-    void Label::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Label::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -86,7 +86,7 @@ namespace gcn
         addKeyListener(this);
     }
 
-    void ListBox::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ListBox::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
         if (mListModel == nullptr)
         {
@@ -119,7 +119,7 @@ namespace gcn
         }
     }
 
-    void ListBox::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ListBox::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
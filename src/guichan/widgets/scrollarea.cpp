@@ -420,7 +420,7 @@ namespace gcn
         }
     }
 
-    void ScrollArea::draw(Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::draw(Graphics *graphics, render_command_buffer &render_commands)
     {
         graphics->setColor(getBackgroundColor());
         graphics->fillRectangle(getContentDimension(), render_commands);
@@ -480,7 +480,7 @@ namespace gcn
         }
     }
 
-    void ScrollArea::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -504,7 +504,7 @@ namespace gcn
         }
     }
 
-    void ScrollArea::drawHBar(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawHBar(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getHorizontalBarDimension();
 
@@ -525,7 +525,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawVBar(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawVBar(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getVerticalBarDimension();
 
@@ -546,7 +546,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawUpButton(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawUpButton(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getUpButtonDimension();
         graphics->pushClipArea(dim);
@@ -607,7 +607,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawDownButton(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawDownButton(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getDownButtonDimension();
         graphics->pushClipArea(dim);
@@ -668,7 +668,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawLeftButton(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawLeftButton(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getLeftButtonDimension();
         graphics->pushClipArea(dim);
@@ -729,7 +729,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawRightButton(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawRightButton(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getRightButtonDimension();
         graphics->pushClipArea(dim);
@@ -790,7 +790,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawVMarker(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawVMarker(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getVerticalMarkerDimension();
         graphics->pushClipArea(dim);
@@ -817,7 +817,7 @@ namespace gcn
         graphics->popClipArea();
     }
 
-    void ScrollArea::drawHMarker(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawHMarker(Graphics* graphics, render_command_buffer &render_commands)
     {
         Rectangle dim = getHorizontalMarkerDimension();
         graphics->pushClipArea(dim);
@@ -916,7 +916,7 @@ namespace gcn
         }
     }
 
-    void ScrollArea::drawContent(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void ScrollArea::drawContent(Graphics* graphics, render_command_buffer &render_commands)
     {
         if (mContent)
         {
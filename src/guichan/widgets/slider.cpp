@@ -126,7 +126,7 @@ namespace gcn
         mScaleEnd = scaleEnd;
     }
 
-    void Slider::draw(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Slider::draw(gcn::Graphics* graphics, render_command_buffer &render_commands)
     {
         Color shadowColor = getBaseColor() - 0x101010;
         int alpha = getBaseColor().a;
@@ -138,7 +138,7 @@ namespace gcn
         drawMarker(graphics, render_commands);
     }
 
-    void Slider::drawBorder(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Slider::drawBorder(gcn::Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -162,7 +162,7 @@ namespace gcn
         }
     }
 
-    void Slider::drawMarker(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void Slider::drawMarker(gcn::Graphics* graphics, render_command_buffer &render_commands)
     {
         gcn::Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
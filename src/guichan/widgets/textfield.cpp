@@ -107,7 +107,7 @@ namespace gcn
         mText = text;
     }
 
-    void TextField::draw(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void TextField::draw(Graphics* graphics, render_command_buffer &render_commands)
     {
 		Font *font;
 		int x, y;
@@ -150,7 +150,7 @@ namespace gcn
         graphics->drawText(mText, x, y, render_commands);
     }
 
-    void TextField::drawBorder(Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+    void TextField::drawBorder(Graphics* graphics, render_command_buffer &render_commands)
     {
         Color faceColor = getBaseColor();
         Color highlightColor, shadowColor;
@@ -174,7 +174,7 @@ namespace gcn
         }
     }
 
-    void TextField::drawCaret(Graphics* graphics, int x, std::vector<std::function<void(renderer *)>> &render_commands)
+    void TextField::drawCaret(Graphics* graphics, int x, render_command_buffer &render_commands)
     {
         graphics->setColor(getForegroundColor());
         graphics->drawLine(x, getHeight() - 2, x, 1, render_commands);
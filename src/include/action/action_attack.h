@@ -30,6 +30,10 @@
 
 #include "actions.h"
 
+namespace wyrmgus {
+	class flow_field;
+}
+
 class COrder_Attack final : public COrder
 {
 	friend std::unique_ptr<COrder> COrder::NewActionAttack(const CUnit &attacker, CUnit &target);
@@ -56,13 +60,14 @@ public:
 	virtual void Execute(CUnit &unit) override;
 	virtual void OnAnimationAttack(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const override;
 	virtual QColor get_shown_source_color() const override;
 	virtual QColor get_shown_line_color() const override;
 	virtual QColor get_shown_target_color() const override;
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) override;
+	virtual bool update_path_finder_goal(PathFinderInput &input) const override;
 	virtual bool OnAiHitUnit(CUnit &unit, CUnit *attacker, int /*damage*/) override;
 
 	virtual const Vec2i GetGoalPos() const override { return goalPos; }
@@ -85,4 +90,5 @@ private:
 	//Wyrmgus start
 	int MapLayer = 0;
 	//Wyrmgus end
+	std::shared_ptr<wyrmgus::flow_field> goal_flow_field; //the flow field shared with the orders of other units attacking the same position
 };
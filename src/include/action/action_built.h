@@ -50,7 +50,7 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 	virtual void Cancel(CUnit &unit) override;
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual void UpdatePathFinderData(PathFinderInput &input) override
 	{
 		UpdatePathFinderData_NotCalled(input);
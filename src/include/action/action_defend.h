@@ -57,7 +57,7 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const override;
 	virtual QColor get_shown_target_color() const override;
 
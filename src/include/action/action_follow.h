@@ -56,10 +56,11 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const override;
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) override;
+	virtual bool update_path_finder_goal(PathFinderInput &input) const override;
 
 private:
 	follow_state state = follow_state::init;
@@ -28,6 +28,10 @@
 
 #include "actions.h"
 
+namespace wyrmgus {
+	class flow_field;
+}
+
 class COrder_Move final : public COrder
 {
 	//Wyrmgus start
@@ -51,10 +55,11 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const override;
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) override;
+	virtual bool update_path_finder_goal(PathFinderInput &input) const override;
 
 private:
 	int Range = 0;
@@ -62,4 +67,5 @@ private:
 	//Wyrmgus start
 	int MapLayer = 0;
 	//Wyrmgus end
+	std::shared_ptr<wyrmgus::flow_field> goal_flow_field; //the flow field shared with the orders of other units moving to the same goal
 };
@@ -56,9 +56,10 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) override;
+	virtual bool update_path_finder_goal(PathFinderInput &input) const override;
 
 	const Vec2i &GetWayPoint() const { return WayPoint; }
 
@@ -50,13 +50,14 @@ public:
 
 	virtual void Execute(CUnit &unit) override;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const override;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const override;
 	virtual QColor get_shown_source_color() const override;
 	virtual QColor get_shown_line_color() const override;
 	virtual QColor get_shown_target_color() const override;
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) override;
+	virtual bool update_path_finder_goal(PathFinderInput &input) const override;
 	virtual bool OnAiHitUnit(CUnit &unit, CUnit *attacker, int /*damage*/) override;
 
 	const resource *get_current_resource() const;
@@ -32,6 +32,7 @@
 
 namespace wyrmgus {
 	class landmass;
+	class render_command_buffer;
 	class renderer;
 	class unit_ref;
 }
@@ -118,7 +119,7 @@ public:
 
 	virtual bool IsValid() const = 0;
 
-	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	virtual PixelPos Show(const CViewport &vp, const PixelPos &lastScreenPos, render_command_buffer &render_commands) const;
 	virtual QPoint get_shown_target_pos(const CViewport &vp) const;
 	virtual QColor get_shown_source_color() const;
 	virtual QColor get_shown_line_color() const;
@@ -140,6 +141,14 @@ public:
 
 	virtual void UpdatePathFinderData(PathFinderInput &input) = 0;
 
+	//set the goal and ranges of a path finder input for the order, without any other effect, so that the path can be calculated in advance; returns false if the order's goal cannot be known before it is executed
+	virtual bool update_path_finder_goal(PathFinderInput &input) const
+	{
+		Q_UNUSED(input)
+
+		return false;
+	}
+
 	bool has_goal() const
 	{
 		return this->goal != nullptr;
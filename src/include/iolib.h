@@ -96,6 +96,7 @@ public:
 	~CFile();
 
 	int open(const char *name, long flags);
+	int open_memory(); //open a file which is written to an in-memory buffer
 	int close();
 	void flush();
 	int read(void *buf, size_t len);
@@ -103,6 +104,10 @@ public:
 	long tell();
 
 	int printf(const char *format, ...) PRINTF_VAARG_ATTRIBUTE(2, 3); // Don't forget to count this
+	int write(const void *buf, size_t len);
+
+	//take the data written to an in-memory file
+	std::string take_memory_data();
 private:
 	CFile(const CFile &rhs); // No implementation
 	const CFile &operator = (const CFile &rhs); // No implementation
@@ -114,7 +119,8 @@ private:
 enum {
 	CLF_TYPE_INVALID,  /// invalid file handle
 	CLF_TYPE_PLAIN,    /// plain text file handle
-	CLF_TYPE_GZIP
+	CLF_TYPE_GZIP,
+	CLF_TYPE_MEMORY    /// in-memory buffer
 };
 
 #define CL_OPEN_READ 0x1
@@ -35,18 +35,19 @@ class ButtonStyle;
 
 namespace wyrmgus {
 	class color_modification;
+	class render_command_buffer;
 	class renderer;
 }
 
 /// Draw menu button
-extern void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, int show_percent, render_command_buffer &render_commands);
 
-inline void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, std::vector<std::function<void(renderer *)>> &render_commands)
+inline void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, render_command_buffer &render_commands)
 {
 	DrawUIButton(style, flags, x, y, text, grayscale, color_modification, transparent, 100, render_commands);
 }
 
-void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands);
+void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, render_command_buffer &render_commands);
 
 /// Pre menu setup
 extern void PreMenuSetup();
@@ -294,6 +294,7 @@ struct NumberDesc;
 
 namespace wyrmgus {
 
+class render_command_buffer;
 class renderer;
 class sound;
 class unit_ref;
@@ -330,8 +331,9 @@ public:
 	
 	/// load the graphics for a missile type
 	void LoadMissileSprite();
+	void correct_graphic_frame_count();
 	void Init();
-	void DrawMissileType(int frame, const PixelPos &pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawMissileType(int frame, const PixelPos &pos, render_command_buffer &render_commands) const;
 
 	void Load(lua_State *l);
 
@@ -483,11 +485,11 @@ protected:
 public:
 	virtual ~Missile();
 
-	static std::unique_ptr<Missile> Init(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z);
+	static Missile *Init(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z);
 
 	virtual void Action() = 0;
 
-	void DrawMissile(const CViewport &vp, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawMissile(const CViewport &vp, render_command_buffer &render_commands) const;
 	void SaveMissile(CFile &file) const;
 	void MissileHit(CUnit *unit = nullptr);
 	bool NextMissileFrame(char sign, char longAnimation);
@@ -32,6 +32,7 @@ class CGraphic;
 class CViewport;
 
 namespace wyrmgus {
+	class render_command_buffer;
 	class renderer;
 }
 
@@ -56,7 +57,7 @@ public:
 	**  @param x x screen coordinate where to draw the animation.
 	**  @param y y screen coordinate where to draw the animation.
 	*/
-	void draw(int x, int y, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void draw(int x, int y, render_command_buffer &render_commands) const;
 
 	/**
 	**  Update the animation.
@@ -88,7 +89,7 @@ public:
 	virtual ~CParticle() {}
 
 	virtual bool isVisible(const CViewport &vp) const = 0;
-	virtual void draw(std::vector<std::function<void(renderer *)>> &render_commands) const = 0;
+	virtual void draw(render_command_buffer &render_commands) const = 0;
 	virtual void update(int) = 0;
 
 	void destroy() { destroyed = true; }
@@ -118,7 +119,7 @@ public:
 	virtual ~StaticParticle();
 
 	virtual bool isVisible(const CViewport &vp) const;
-	virtual void draw(std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void draw(render_command_buffer &render_commands) const override;
 	virtual void update(int ticks);
 	virtual std::unique_ptr<CParticle> clone() const;
 
@@ -140,7 +141,7 @@ public:
 	virtual ~CChunkParticle();
 
 	virtual bool isVisible(const CViewport &vp) const;
-	virtual void draw(std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void draw(render_command_buffer &render_commands) const override;
 	virtual void update(int ticks);
 	virtual std::unique_ptr<CParticle> clone() const;
 	int getSmokeDrawLevel() const { return smokeDrawLevel; }
@@ -183,7 +184,7 @@ public:
 	virtual ~CSmokeParticle();
 
 	virtual bool isVisible(const CViewport &vp) const;
-	virtual void draw(std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void draw(render_command_buffer &render_commands) const override;
 	virtual void update(int ticks);
 	virtual std::unique_ptr<CParticle> clone() const;
 
@@ -205,7 +206,7 @@ public:
 	virtual ~CRadialParticle();
 
 	virtual bool isVisible(const CViewport &vp) const;
-	virtual void draw(std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void draw(render_command_buffer &render_commands) const override;
 	virtual void update(int ticks);
 	virtual std::unique_ptr<CParticle> clone() const;
 
@@ -43,10 +43,26 @@ extern ReplayType ReplayGameType;  /// Replay game type
 /// Log commands into file
 extern void CommandLog(const char *action, const CUnit *unit, int flush,
 					   int x, int y, const CUnit *dest, const char *value, int num);
+/// Begin merging logged commands which give the same order to several units into one log entry
+extern void BeginCommandLogGroup();
+/// End merging logged commands, writing the pending group log entry
+extern void EndCommandLogGroup();
 /// Replay user commands from log each cycle, single player games
 extern void SinglePlayerReplayEachCycle();
 /// Replay user commands from log each cycle, multiplayer games
 extern void MultiPlayerReplayEachCycle();
+/// Check if we're replaying a game
+extern bool IsReplayGame();
+/// Whether all the commands of the replay being played have been executed
+extern bool IsReplayFinished();
+/// Take or check a replay checkpoint each cycle
+extern void ReplayCheckpointEachCycle();
+/// Move the replay being played to a game cycle
+extern void SeekReplay(const unsigned long game_cycle);
+/// Continue playing a replay after its checkpoint has been loaded
+extern void ApplyPendingReplaySeek(const std::filesystem::path &filepath);
+/// Convert a replay log to the binary replay format
+extern void ConvertReplayToBinary(const std::filesystem::path &source_filepath, const std::filesystem::path &destination_filepath);
 /// Load replay
 extern int LoadReplay(const std::filesystem::path &filepath);
 /// End logging
@@ -64,7 +64,9 @@ enum {
 
 extern lua_State *Lua;
 
+extern bool GetFileContent(const std::string &file, std::string &content);
 extern int LuaLoadFile(const std::string &file, const std::string &strArg = "");
+extern int LuaLoadBuffer(const std::string_view &buffer, const std::string &name, const std::string &strArg = "");
 extern int LuaCall(int narg, int clear, bool exitOnError = true);
 
 #define LuaError(l, args) \
@@ -158,6 +158,7 @@ namespace archimedes {
 }
 
 namespace wyrmgus {
+	class render_command_buffer;
 	class renderer;
 }
 
@@ -172,7 +173,7 @@ extern unsigned long FastForwardCycle;		/// Game Replay Fast Forward Counter
 extern boost::asio::awaitable<void> Exit(const int err);                  /// Exit
 
 extern void UpdateDisplay();            /// Game display update
-extern void DrawMapArea(std::vector<std::function<void(wyrmgus::renderer *)>> &render_commands); //draw the map area
+extern void DrawMapArea(wyrmgus::render_command_buffer &render_commands); //draw the map area
 
 [[nodiscard]]
 extern boost::asio::awaitable<void> GameMainLoop(); //game main loop
@@ -30,6 +30,7 @@
 
 namespace wyrmgus {
 	class font;
+	class render_command_buffer;
 	class renderer;
 }
 
@@ -51,10 +52,10 @@ class TitleScreen final
 {
 public:
 	[[nodiscard]]
-	boost::asio::awaitable<void> ShowTitleImage(std::vector<std::function<void(renderer *)>> &render_commands) const;
+	boost::asio::awaitable<void> ShowTitleImage(render_command_buffer &render_commands) const;
 
 private:
-	void ShowLabels(std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void ShowLabels(render_command_buffer &render_commands) const;
 
 public:
 	std::string File;
@@ -68,4 +69,4 @@ public:
 extern std::vector<TitleScreen> TitleScreens;          /// File for title screen
 
 [[nodiscard]]
-extern boost::asio::awaitable<void> ShowTitleScreens(std::vector<std::function<void(renderer *)>> &render_commands);
+extern boost::asio::awaitable<void> ShowTitleScreens(render_command_buffer &render_commands);
@@ -33,6 +33,7 @@
 class CUnit;
 
 namespace wyrmgus {
+	class render_command_buffer;
 	class renderer;
 	class season;
 	class tile;
@@ -104,8 +105,8 @@ public:
 	void SetClipping() const;
 
 	/// Draw the full Viewport.
-	void Draw(std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void DrawBorder(std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void Draw(render_command_buffer &render_commands) const;
+	void DrawBorder(render_command_buffer &render_commands) const;
 	/// Check if any part of an area is visible in viewport
 	bool AnyMapAreaVisibleInViewport(const Vec2i &boxmin, const Vec2i &boxmax) const;
 
@@ -160,12 +161,12 @@ private:
 	template <typename function_type>
 	void for_each_map_tile(const function_type &function) const;
 
-	void draw_map_tile(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_map_tile_top(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_map_tile_overlay_terrain(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_map_tile_border(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_map(std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_map_fog_of_war(std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void draw_map_tile(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const;
+	void draw_map_tile_top(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const;
+	void draw_map_tile_overlay_terrain(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const;
+	void draw_map_tile_border(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const;
+	void draw_map(render_command_buffer &render_commands) const;
+	void draw_map_fog_of_war(render_command_buffer &render_commands) const;
 
 private:
 	QRect rect; //screen rectangle area, in pixels
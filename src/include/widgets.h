@@ -66,11 +66,11 @@ public:
 	virtual void _beginDraw() override;
 	virtual void _endDraw() override;
 
-	virtual void drawImage(const gcn::Image *image, int srcX, int srcY, int dstX, int dstY, int width, int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void drawImage(const gcn::Image *image, int srcX, int srcY, int dstX, int dstY, int width, int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, render_command_buffer &render_commands) const override;
 
-	virtual void drawLine(int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawRectangle(const gcn::Rectangle &rectangle, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void fillRectangle(const gcn::Rectangle &rectangle, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void drawLine(int x1, int y1, int x2, int y2, render_command_buffer &render_commands) override;
+	virtual void drawRectangle(const gcn::Rectangle &rectangle, render_command_buffer &render_commands) override;
+	virtual void fillRectangle(const gcn::Rectangle &rectangle, render_command_buffer &render_commands) override;
 
 	virtual void setColor(const gcn::Color &color) override
 	{
@@ -102,7 +102,7 @@ class PlayerColorImageWidget : public gcn::Icon
 public:
 	explicit PlayerColorImageWidget(const std::string &image_path, const std::string &playercolor);
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	void setImageOrigin(int x, int y) { ImageOrigin.x = x; ImageOrigin.y = y; }
 
 	void setGrayscale(bool grayscale)
@@ -131,7 +131,7 @@ public:
 	explicit ImageButton(const std::string &caption);
 	~ImageButton();
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	virtual void adjustSize() override;
 
 	void setNormalImage(const std::string &image_path);
@@ -157,7 +157,7 @@ public:
 	PlayerColorImageButton();
 	explicit PlayerColorImageButton(const std::string &caption, const std::string &playercolor);
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	virtual void adjustSize() override;
 
 	void setNormalImage(const std::string &image_path);
@@ -193,8 +193,8 @@ public:
 	ImageCheckBox();
 	ImageCheckBox(const std::string &caption, bool marked = false);
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBox(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBox(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 
 	virtual void mousePress(int x, int y, int button) override;
 	virtual void mouseRelease(int button) override;
@@ -232,8 +232,8 @@ public:
 	virtual void setLineWidth(int width);
 	virtual int getLineWidth();
 	virtual void adjustSize();
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 
 	enum {
 		LEFT = 0,
@@ -278,8 +278,8 @@ class ImageTextField : public gcn::TextField
 public:
 	ImageTextField() : TextField(), itemImage(nullptr) {}
 	ImageTextField(const std::string& text) : gcn::TextField(text), itemImage(nullptr) {}
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	void setItemImage(CGraphic *image) { itemImage = image; }
 private:
 	CGraphic *itemImage;
@@ -309,8 +309,8 @@ class ImageListBox : public gcn::ListBox
 public:
 	ImageListBox();
 	ImageListBox(gcn::ListModel *listModel);
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	void setItemImage(CGraphic *image) { itemImage = image; }
 	void adjustSize();
 	void mousePress(int, int y, int button);
@@ -370,25 +370,25 @@ public:
 	void setVBarImage(CGraphic *image);
 	void setMarkerImage(CGraphic *image) { markerImage = image; }
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	virtual gcn::Rectangle getVerticalMarkerDimension() override;
 	virtual gcn::Rectangle getHorizontalMarkerDimension() override;
 private:
 	void adjustSize();
 
-	void drawUpButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawDownButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawLeftButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawRightButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawUpPressedButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawDownPressedButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawLeftPressedButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawRightPressedButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawHMarker(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawVMarker(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawHBar(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
-	void drawVBar(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+	void drawUpButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawDownButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawLeftButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawRightButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawUpPressedButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawDownPressedButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawLeftPressedButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawRightPressedButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawHMarker(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawVMarker(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawHBar(gcn::Graphics *graphics, render_command_buffer &render_commands);
+	void drawVBar(gcn::Graphics *graphics, render_command_buffer &render_commands);
 private:
 	CGraphic *itemImage;
 	CGraphic *upButtonImage;
@@ -435,9 +435,9 @@ public:
 		return &mListBox;
 	}
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	virtual void drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
-	void drawButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands);
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	virtual void drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
+	void drawButton(gcn::Graphics *graphics, render_command_buffer &render_commands);
 	void setList(lua_State *lua, lua_Object *lo);
 	virtual void setSize(int width, int height) override;
 	void setListModel(LuaListModel *listModel);
@@ -460,7 +460,7 @@ class StatBoxWidget : public gcn::Widget
 public:
 	StatBoxWidget(int width, int height);
 
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 	void setCaption(const std::string &s);
 	const std::string &getCaption() const;
 	void setPercent(const int percent);
@@ -486,7 +486,7 @@ public:
 	}
 
 	void addLogicCallback(LuaActionListener *listener);
-	virtual void draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void draw(gcn::Graphics *graphics, render_command_buffer &render_commands) override;
 
 	virtual void logic() override;
 
@@ -0,0 +1,139 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//a coarse grid of cells over a map layer, each holding a contiguous array of the elements (e.g. units) overlapping it, together with their tile rectangles
+//this allows range queries to take time proportional to the amount of elements near the queried area, rather than to the amount of tiles in it
+template <typename T>
+class cell_grid final
+{
+public:
+	static constexpr int cell_size = 8;
+
+	struct entry final
+	{
+		T *element = nullptr;
+		QRect rect;
+	};
+
+	explicit cell_grid(const QSize &size)
+		: size(size), width((size.width() + cell_size - 1) / cell_size), height((size.height() + cell_size - 1) / cell_size)
+	{
+		this->cells.resize(static_cast<size_t>(this->width * this->height));
+	}
+
+	//add an element occupying the given tile rectangle; the same rectangle must be given when removing it
+	void insert(T *element, const QRect &rect)
+	{
+		this->for_each_cell_in_rect(rect, [element, &rect](std::vector<entry> &cell) {
+			cell.push_back(entry{ element, rect });
+		});
+	}
+
+	void remove(T *element, const QRect &rect)
+	{
+		this->for_each_cell_in_rect(rect, [element](std::vector<entry> &cell) {
+			for (size_t i = 0; i < cell.size(); ++i) {
+				if (cell[i].element == element) {
+					cell[i] = cell.back();
+					cell.pop_back();
+					break;
+				}
+			}
+		});
+	}
+
+	void clear()
+	{
+		for (std::vector<entry> &cell : this->cells) {
+			cell.clear();
+		}
+	}
+
+	//call the function for each element whose rectangle intersects with the given one, passing the element and the intersection
+	//elements overlapping several cells are visited only once, in the cell containing the top-left tile of their intersection with the rectangle
+	template <typename function_type>
+	void for_each_in_rect(const QRect &rect, const function_type &function) const
+	{
+		const QRect cell_rect = this->get_cell_rect(rect);
+
+		for (int cell_y = cell_rect.top(); cell_y <= cell_rect.bottom(); ++cell_y) {
+			for (int cell_x = cell_rect.left(); cell_x <= cell_rect.right(); ++cell_x) {
+				const std::vector<entry> &cell = this->cells[cell_y * this->width + cell_x];
+
+				for (const entry &cell_entry : cell) {
+					const QRect intersection = cell_entry.rect.intersected(rect);
+
+					if (intersection.isEmpty()) {
+						continue;
+					}
+
+					if (intersection.left() / cell_size != cell_x || intersection.top() / cell_size != cell_y) {
+						continue;
+					}
+
+					function(cell_entry.element, intersection);
+				}
+			}
+		}
+	}
+
+private:
+	//get the rectangle of cells overlapped by a tile rectangle, clipped to the grid
+	QRect get_cell_rect(const QRect &rect) const
+	{
+		const QRect clipped_rect = rect.intersected(QRect(QPoint(0, 0), this->size));
+
+		if (clipped_rect.isEmpty()) {
+			return QRect();
+		}
+
+		return QRect(QPoint(clipped_rect.left() / cell_size, clipped_rect.top() / cell_size), QPoint(clipped_rect.right() / cell_size, clipped_rect.bottom() / cell_size));
+	}
+
+	template <typename function_type>
+	void for_each_cell_in_rect(const QRect &rect, const function_type &function)
+	{
+		const QRect cell_rect = this->get_cell_rect(rect);
+
+		for (int cell_y = cell_rect.top(); cell_y <= cell_rect.bottom(); ++cell_y) {
+			for (int cell_x = cell_rect.left(); cell_x <= cell_rect.right(); ++cell_x) {
+				function(this->cells[cell_y * this->width + cell_x]);
+			}
+		}
+	}
+
+	QSize size;
+	int width = 0;
+	int height = 0;
+	std::vector<std::vector<entry>> cells;
+};
+
+}
@@ -39,11 +39,13 @@
 #include "engine_interface.h"
 //Wyrmgus start
 #include "game/game.h" // for the SaveGameLoading variable
+#include "game/save_container.h"
 //Wyrmgus end
 #include "iolib.h"
 #include "map/direction.h"
 #include "map/generated_terrain.h"
 #include "map/landmass.h"
+#include "map/map_generation_regions.h"
 #include "map/map_info.h"
 #include "map/map_layer.h"
 #include "map/map_template.h"
@@ -57,9 +59,11 @@
 #include "map/terrain_type.h"
 #include "map/tile.h"
 #include "map/tile_flag.h"
+#include "map/tile_rect_flags.h"
 #include "map/tileset.h"
 #include "map/world.h"
 #include "map/world_game_data.h"
+#include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "player/player_type.h"
 //Wyrmgus start
@@ -97,6 +101,7 @@
 #include "util/set_util.h"
 #include "util/size_util.h"
 #include "util/string_util.h"
+#include "util/thread_pool.h"
 #include "util/util.h"
 #include "util/vector_random_util.h"
 #include "util/vector_util.h"
@@ -212,6 +217,10 @@ void CMap::Reveal(const bool only_person_players)
 	}
 	//Wyrmgus end
 
+	AStarExplorationChanged();
+
+	InvalidateFogOfWar();
+
 	// Global seen recount. Simple and effective.
 	for (CUnit *unit : unit_manager::get()->get_units()) {
 		//  Reveal neutral buildings. Gold mines:)
@@ -1972,7 +1981,7 @@ void CMap::process_gsml_scope(const gsml_data &scope)
 	}
 }
 
-void CMap::save(CFile &file) const
+void CMap::save(CFile &file, save_container &container) const
 {
 	file.printf("\n--- -----------------------------------------\n");
 	file.printf("--- MODULE: map\n");
@@ -2048,42 +2057,111 @@ void CMap::save(CFile &file) const
 	file.printf("  },\n");
 	//Wyrmgus end
 
-	file.printf("  \"map-fields\", {\n");
-	//Wyrmgus start
-	/*
-	for (int h = 0; h < this->Info->MapHeight; ++h) {
-		file.printf("  -- %d\n", h);
-		for (int w = 0; w < this->Info->MapWidth; ++w) {
-			const wyrmgus::tile &mf = *this->Field(w, h);
-
-			mf.Save(file);
-			if (w & 1) {
-				file.printf(",\n");
-			} else {
-				file.printf(", ");
-			}
+	//the tiles are saved in the binary save container, so that loading them does not require the Lua interpreter
+	this->save_tiles_to_binary(container);
+
+	file.printf("  \"map-fields-in-save-container\"\n");
+	file.printf("}})\n");
+}
+
+void CMap::save_tiles_to_binary(save_container &container) const
+{
+	static constexpr int rows_per_chunk = 32;
+
+	struct chunk_range final
+	{
+		size_t z = 0;
+		int start_index = 0;
+		int tile_count = 0;
+	};
+
+	std::vector<chunk_range> chunk_ranges;
+
+	for (size_t z = 0; z < this->MapLayers.size(); ++z) {
+		const int width = this->Info->MapWidths[z];
+		const int height = this->Info->MapHeights[z];
+
+		for (int start_y = 0; start_y < height; start_y += rows_per_chunk) {
+			const int end_y = std::min(start_y + rows_per_chunk, height);
+			chunk_ranges.push_back(chunk_range{ z, start_y * width, (end_y - start_y) * width });
 		}
 	}
-	*/
-	for (size_t z = 0; z < this->MapLayers.size(); ++z) {
-		file.printf("  {\n");
-		for (int h = 0; h < this->Info->MapHeights[z]; ++h) {
-			file.printf("  -- %d\n", h);
-			for (int w = 0; w < this->Info->MapWidths[z]; ++w) {
-				const wyrmgus::tile &mf = *this->Field(w, h, z);
-
-				mf.Save(file);
-				if (w & 1) {
-					file.printf(",\n");
-				} else {
-					file.printf(", ");
-				}
+
+	std::vector<save_container::compressed_chunk> chunks(chunk_ranges.size());
+	std::atomic<size_t> next_chunk_index = 0;
+
+	//each worker serializes and compresses chunks into their own buffers, until none are left
+	const auto serialize_chunks = [this, &chunk_ranges, &chunks, &next_chunk_index]() {
+		while (true) {
+			const size_t chunk_index = next_chunk_index.fetch_add(1);
+			if (chunk_index >= chunk_ranges.size()) {
+				break;
 			}
+
+			const chunk_range &range = chunk_ranges[chunk_index];
+
+			save_buffer_writer writer;
+			writer.write_varint(range.z);
+			writer.write_varint(range.start_index);
+			writer.write_varint(range.tile_count);
+
+			const std::string tile_data = tile::save_tiles_to_binary(this->MapLayers[range.z]->Field(range.start_index), range.tile_count);
+			writer.write_bytes(tile_data.data(), tile_data.size());
+
+			chunks[chunk_index] = save_container::compress_chunk(writer.get_data());
 		}
-		file.printf("  },\n");
+	};
+
+	const size_t worker_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), chunk_ranges.size());
+
+	std::vector<std::future<void>> futures;
+	for (size_t i = 1; i < worker_count; ++i) {
+		futures.push_back(thread_pool::get()->co_spawn_future([&serialize_chunks]() -> boost::asio::awaitable<void> {
+			serialize_chunks();
+			co_return;
+		}));
 	}
-	//Wyrmgus end
-	file.printf("}})\n");
+
+	serialize_chunks();
+
+	for (std::future<void> &future : futures) {
+		future.get();
+	}
+
+	container.add_section(save_section::map_tiles, std::move(chunks));
+}
+
+void CMap::load_tiles_from_binary(const std::string_view &container_data)
+{
+	save_container::for_each_chunk(container_data, save_section::map_tiles, [this](const std::string_view &chunk_data) {
+		save_buffer_reader reader(chunk_data);
+
+		const size_t z = static_cast<size_t>(reader.read_varint());
+		const int start_index = static_cast<int>(reader.read_varint());
+		const int tile_count = static_cast<int>(reader.read_varint());
+
+		if (z >= this->MapLayers.size()) {
+			throw std::runtime_error("Invalid map layer in tile save data: " + std::to_string(z) + ".");
+		}
+
+		CMapLayer *map_layer = this->MapLayers[z].get();
+
+		if (start_index < 0 || tile_count < 0 || start_index + tile_count > map_layer->get_width() * map_layer->get_height()) {
+			throw std::runtime_error("Invalid tile range in tile save data.");
+		}
+
+		tile::load_tiles_from_binary(map_layer->Field(start_index), tile_count, reader.get_remaining_data());
+
+		for (int i = start_index; i < start_index + tile_count; ++i) {
+			const tile *map_tile = map_layer->Field(i);
+
+			if (map_tile->is_destroyed_tree_tile()) {
+				map_layer->destroyed_tree_tiles.push_back(map_layer->GetPosFromIndex(i));
+			} else if (map_tile->get_overlay_terrain() != nullptr && map_tile->OverlayTerrainDestroyed) {
+				map_layer->destroyed_overlay_terrain_tiles.push_back(map_layer->GetPosFromIndex(i));
+			}
+		}
+	});
 }
 
 void CMap::do_per_cycle_loop()
@@ -2143,8 +2221,14 @@ void CMap::SetTileTerrain(const QPoint &pos, const terrain_type *terrain, const
 		const size_t old_base_transition_count = tile->TransitionTiles.size();
 		const size_t old_overlay_transition_count = tile->OverlayTransitionTiles.size();
 
+		const tile_flag old_flags = tile->get_flags();
+
 		tile->SetTerrain(terrain);
 
+		if (tile->get_flags() != old_flags) {
+			AStarTilePassabilityChanged(pos, z, (old_flags & ~tile->get_flags()) | (tile->get_flags() & ~old_flags));
+		}
+
 		if (terrain->is_overlay()) {
 			//remove decorations if the overlay terrain has changed
 			std::vector<CUnit *> table;
@@ -2172,6 +2256,7 @@ void CMap::SetTileTerrain(const QPoint &pos, const terrain_type *terrain, const
 			MarkSeenTile(*tile);
 		}
 		UI.get_minimap()->UpdateXY(pos, z);
+		AStarTileTerrainChanged(pos, z);
 
 		const player_color *player_color = tile->get_player_color();
 
@@ -2216,6 +2301,7 @@ void CMap::SetTileTerrain(const QPoint &pos, const terrain_type *terrain, const
 						MarkSeenTile(*adjacent_tile);
 					}
 					UI.get_minimap()->UpdateXY(adjacent_pos, z);
+					AStarTileTerrainChanged(adjacent_pos, z);
 
 					const wyrmgus::player_color *adjacent_player_color = adjacent_tile->get_player_color();
 
@@ -2245,8 +2331,13 @@ void CMap::RemoveTileOverlayTerrain(const QPoint &pos, const int z)
 	}
 	
 	const size_t old_overlay_transition_count = tile->OverlayTransitionTiles.size();
+	const tile_flag old_flags = tile->get_flags();
 
 	tile->RemoveOverlayTerrain();
+
+	if (tile->get_flags() != old_flags) {
+		AStarTilePassabilityChanged(pos, z, (old_flags & ~tile->get_flags()) | (tile->get_flags() & ~old_flags));
+	}
 	
 	this->calculate_tile_transitions(pos, true, z);
 	
@@ -2254,6 +2345,7 @@ void CMap::RemoveTileOverlayTerrain(const QPoint &pos, const int z)
 		MarkSeenTile(*tile);
 	}
 	UI.get_minimap()->UpdateXY(pos, z);
+	AStarTileTerrainChanged(pos, z);
 
 	const player_color *player_color = tile->get_player_color();
 
@@ -2282,6 +2374,7 @@ void CMap::RemoveTileOverlayTerrain(const QPoint &pos, const int z)
 					MarkSeenTile(*adjacent_tile);
 				}
 				UI.get_minimap()->UpdateXY(adjacent_pos, z);
+				AStarTileTerrainChanged(adjacent_pos, z);
 
 				if (old_adjacent_overlay_transition_count != 0 || adjacent_tile->OverlayTransitionTiles.size() != 0) {
 					const wyrmgus::player_color *adjacent_player_color = adjacent_tile->get_player_color();
@@ -2319,6 +2412,8 @@ void CMap::SetOverlayTerrainDestroyed(const QPoint &pos, const bool destroyed, c
 			sight_unmarker = std::make_unique<nearby_sight_unmarker>(pos, z);
 		}
 
+		const tile_flag old_flags = tile->get_flags();
+
 		tile->SetOverlayTerrainDestroyed(destroyed);
 
 		if (destroyed) {
@@ -2350,6 +2445,10 @@ void CMap::SetOverlayTerrainDestroyed(const QPoint &pos, const bool destroyed, c
 			}
 		}
 
+		if (tile->get_flags() != old_flags) {
+			AStarTilePassabilityChanged(pos, z, (old_flags & ~tile->get_flags()) | (tile->get_flags() & ~old_flags));
+		}
+
 		if (destroyed) {
 			if (tile->get_overlay_terrain()->get_destroyed_tiles().size() > 0) {
 				tile->OverlaySolidTile = vector::get_random(tile->get_overlay_terrain()->get_destroyed_tiles());
@@ -2364,6 +2463,7 @@ void CMap::SetOverlayTerrainDestroyed(const QPoint &pos, const bool destroyed, c
 			MarkSeenTile(*tile);
 		}
 		UI.get_minimap()->UpdateXY(pos, z);
+		AStarTileTerrainChanged(pos, z);
 
 		const player_color *player_color = tile->get_player_color();
 
@@ -2397,6 +2497,7 @@ void CMap::SetOverlayTerrainDestroyed(const QPoint &pos, const bool destroyed, c
 						MarkSeenTile(*adjacent_tile);
 					}
 					UI.get_minimap()->UpdateXY(adjacent_pos, z);
+					AStarTileTerrainChanged(adjacent_pos, z);
 
 					if (old_adjacent_overlay_transition_count != 0 || adjacent_tile->OverlayTransitionTiles.size() != 0) {
 						const wyrmgus::player_color *adjacent_player_color = adjacent_tile->get_player_color();
@@ -2441,6 +2542,7 @@ void CMap::SetOverlayTerrainDamaged(const QPoint &pos, const bool damaged, const
 			MarkSeenTile(*tile);
 		}
 		UI.get_minimap()->UpdateXY(pos, z);
+		AStarTileTerrainChanged(pos, z);
 
 		const player_color *player_color = tile->get_player_color();
 
@@ -2918,8 +3020,79 @@ void CMap::AdjustMap()
 	}
 }
 
+bool CMap::is_tile_irregular(const QPoint &pos, const bool overlay, const int z) const
+{
+	const int x = pos.x();
+	const int y = pos.y();
+
+	const tile &mf = *this->Field(x, y, z);
+	const terrain_type *terrain = overlay ? mf.get_overlay_terrain() : mf.get_terrain();
+	if (!terrain || terrain->allows_single()) {
+		return false;
+	}
+
+	std::set<const terrain_type *> acceptable_adjacent_tile_types;
+	acceptable_adjacent_tile_types.insert(terrain);
+	set::merge(acceptable_adjacent_tile_types, terrain->get_outer_border_terrain_types());
+	
+	int horizontal_adjacent_tiles = 0;
+	int vertical_adjacent_tiles = 0;
+	int nw_quadrant_adjacent_tiles = 0; //should be 4 if the wrong tile types are present in X-1,Y; X-1,Y-1; X,Y-1; and X+1,Y+1
+	int ne_quadrant_adjacent_tiles = 0;
+	int sw_quadrant_adjacent_tiles = 0;
+	int se_quadrant_adjacent_tiles = 0;
+	
+	if ((x - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x - 1, y), overlay, z))) {
+		horizontal_adjacent_tiles += 1;
+		nw_quadrant_adjacent_tiles += 1;
+		sw_quadrant_adjacent_tiles += 1;
+	}
+	if ((x + 1) < this->Info->MapWidths[z] && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x + 1, y), overlay, z))) {
+		horizontal_adjacent_tiles += 1;
+		ne_quadrant_adjacent_tiles += 1;
+		se_quadrant_adjacent_tiles += 1;
+	}
+	
+	if ((y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x, y - 1), overlay, z))) {
+		vertical_adjacent_tiles += 1;
+		nw_quadrant_adjacent_tiles += 1;
+		ne_quadrant_adjacent_tiles += 1;
+	}
+	if ((y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x, y + 1), overlay, z))) {
+		vertical_adjacent_tiles += 1;
+		sw_quadrant_adjacent_tiles += 1;
+		se_quadrant_adjacent_tiles += 1;
+	}
+
+	if ((x - 1) >= 0 && (y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x - 1, y - 1), overlay, z))) {
+		nw_quadrant_adjacent_tiles += 1;
+		se_quadrant_adjacent_tiles += 1;
+	}
+
+	if ((x - 1) >= 0 && (y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x - 1, y + 1), overlay, z))) {
+		sw_quadrant_adjacent_tiles += 1;
+		ne_quadrant_adjacent_tiles += 1;
+	}
+	if ((x + 1) < this->Info->MapWidths[z] && (y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x + 1, y - 1), overlay, z))) {
+		ne_quadrant_adjacent_tiles += 1;
+		sw_quadrant_adjacent_tiles += 1;
+	}
+	if ((x + 1) < this->Info->MapWidths[z] && (y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x + 1, y + 1), overlay, z))) {
+		se_quadrant_adjacent_tiles += 1;
+		nw_quadrant_adjacent_tiles += 1;
+	}
+	
+	return horizontal_adjacent_tiles >= 2 || vertical_adjacent_tiles >= 2 || nw_quadrant_adjacent_tiles >= 4 || ne_quadrant_adjacent_tiles >= 4 || sw_quadrant_adjacent_tiles >= 4 || se_quadrant_adjacent_tiles >= 4;
+}
+
 void CMap::AdjustTileMapIrregularities(const bool overlay, const Vec2i &min_pos, const Vec2i &max_pos, const int z)
 {
+	if (min_pos.x >= max_pos.x || min_pos.y >= max_pos.y) {
+		return;
+	}
+
+	const QRect rect(min_pos, max_pos - Vec2i(1, 1));
+
 	bool no_irregularities_found = false;
 	int try_count = 0;
 	static constexpr int max_try_count = 100;
@@ -2928,97 +3101,61 @@ void CMap::AdjustTileMapIrregularities(const bool overlay, const Vec2i &min_pos,
 		no_irregularities_found = true;
 		++try_count;
 
+		//find the irregular tiles in parallel, and then adjust them in order; a tile is checked again if it is next to a tile adjusted before it in this pass, so that the result is the same as if each tile had been checked in order
+		tile_rect_flags irregular_tiles(rect);
+		irregular_tiles.set_if([this, overlay, z](const QPoint &tile_pos) {
+			return this->is_tile_irregular(tile_pos, overlay, z);
+		});
+
+		tile_rect_flags changed_tiles(rect);
+
 		for (int x = min_pos.x; x < max_pos.x; ++x) {
 			for (int y = min_pos.y; y < max_pos.y; ++y) {
-				tile &mf = *this->Field(x, y, z);
-				const terrain_type *terrain = overlay ? mf.get_overlay_terrain() : mf.get_terrain();
-				if (!terrain || terrain->allows_single()) {
-					continue;
-				}
+				const QPoint tile_pos(x, y);
 
-				std::set<const terrain_type *> acceptable_adjacent_tile_types;
-				acceptable_adjacent_tile_types.insert(terrain);
-				set::merge(acceptable_adjacent_tile_types, terrain->get_outer_border_terrain_types());
-				
-				int horizontal_adjacent_tiles = 0;
-				int vertical_adjacent_tiles = 0;
-				int nw_quadrant_adjacent_tiles = 0; //should be 4 if the wrong tile types are present in X-1,Y; X-1,Y-1; X,Y-1; and X+1,Y+1
-				int ne_quadrant_adjacent_tiles = 0;
-				int sw_quadrant_adjacent_tiles = 0;
-				int se_quadrant_adjacent_tiles = 0;
-				
-				if ((x - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x - 1, y), overlay, z))) {
-					horizontal_adjacent_tiles += 1;
-					nw_quadrant_adjacent_tiles += 1;
-					sw_quadrant_adjacent_tiles += 1;
-				}
-				if ((x + 1) < this->Info->MapWidths[z] && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x + 1, y), overlay, z))) {
-					horizontal_adjacent_tiles += 1;
-					ne_quadrant_adjacent_tiles += 1;
-					se_quadrant_adjacent_tiles += 1;
-				}
-				
-				if ((y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x, y - 1), overlay, z))) {
-					vertical_adjacent_tiles += 1;
-					nw_quadrant_adjacent_tiles += 1;
-					ne_quadrant_adjacent_tiles += 1;
-				}
-				if ((y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x, y + 1), overlay, z))) {
-					vertical_adjacent_tiles += 1;
-					sw_quadrant_adjacent_tiles += 1;
-					se_quadrant_adjacent_tiles += 1;
+				bool irregular = irregular_tiles.get(tile_pos);
+				if (changed_tiles.is_set_in_neighborhood(tile_pos)) {
+					irregular = this->is_tile_irregular(tile_pos, overlay, z);
 				}
 
-				if ((x - 1) >= 0 && (y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(this->GetTileTerrain(Vec2i(x - 1, y - 1), overlay, z))) {
-					nw_quadrant_adjacent_tiles += 1;
-					se_quadrant_adjacent_tiles += 1;
+				if (!irregular) {
+					continue;
 				}
 
-				if ((x - 1) >= 0 && (y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x - 1, y + 1), overlay, z))) {
-					sw_quadrant_adjacent_tiles += 1;
-					ne_quadrant_adjacent_tiles += 1;
-				}
-				if ((x + 1) < this->Info->MapWidths[z] && (y - 1) >= 0 && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x + 1, y - 1), overlay, z))) {
-					ne_quadrant_adjacent_tiles += 1;
-					sw_quadrant_adjacent_tiles += 1;
-				}
-				if ((x + 1) < this->Info->MapWidths[z] && (y + 1) < this->Info->MapHeights[z] && !acceptable_adjacent_tile_types.contains(GetTileTerrain(Vec2i(x + 1, y + 1), overlay, z))) {
-					se_quadrant_adjacent_tiles += 1;
-					nw_quadrant_adjacent_tiles += 1;
-				}
-				
-				if (horizontal_adjacent_tiles >= 2 || vertical_adjacent_tiles >= 2 || nw_quadrant_adjacent_tiles >= 4 || ne_quadrant_adjacent_tiles >= 4 || sw_quadrant_adjacent_tiles >= 4 || se_quadrant_adjacent_tiles >= 4) {
-					if (overlay) {
-						mf.RemoveOverlayTerrain();
-					} else {
-						std::map<const wyrmgus::terrain_type *, int> best_terrain_scores;
+				tile &mf = *this->Field(x, y, z);
 
-						for (int sub_x = -1; sub_x <= 1; ++sub_x) {
-							for (int sub_y = -1; sub_y <= 1; ++sub_y) {
-								if ((x + sub_x) < min_pos.x || (x + sub_x) >= max_pos.x || (y + sub_y) < min_pos.y || (y + sub_y) >= max_pos.y || (sub_x == 0 && sub_y == 0)) {
-									continue;
-								}
-								const wyrmgus::terrain_type *tile_terrain = GetTileTerrain(Vec2i(x + sub_x, y + sub_y), false, z);
-								if (mf.get_terrain() != tile_terrain) {
-									best_terrain_scores[tile_terrain]++;
-								}
-							}
-						}
+				if (overlay) {
+					mf.RemoveOverlayTerrain();
+				} else {
+					std::map<const wyrmgus::terrain_type *, int> best_terrain_scores;
 
-						const wyrmgus::terrain_type *best_terrain = nullptr;
-						int best_score = 0;
-						for (const auto &score_pair : best_terrain_scores) {
-							const int score = score_pair.second;
-							if (score > best_score) {
-								best_score = score;
-								best_terrain = score_pair.first;
+					for (int sub_x = -1; sub_x <= 1; ++sub_x) {
+						for (int sub_y = -1; sub_y <= 1; ++sub_y) {
+							if ((x + sub_x) < min_pos.x || (x + sub_x) >= max_pos.x || (y + sub_y) < min_pos.y || (y + sub_y) >= max_pos.y || (sub_x == 0 && sub_y == 0)) {
+								continue;
+							}
+							const wyrmgus::terrain_type *tile_terrain = GetTileTerrain(Vec2i(x + sub_x, y + sub_y), false, z);
+							if (mf.get_terrain() != tile_terrain) {
+								best_terrain_scores[tile_terrain]++;
 							}
 						}
+					}
 
-						mf.SetTerrain(best_terrain);
+					const wyrmgus::terrain_type *best_terrain = nullptr;
+					int best_score = 0;
+					for (const auto &score_pair : best_terrain_scores) {
+						const int score = score_pair.second;
+						if (score > best_score) {
+							best_score = score;
+							best_terrain = score_pair.first;
+						}
 					}
-					no_irregularities_found = false;
+
+					mf.SetTerrain(best_terrain);
 				}
+
+				changed_tiles.set(tile_pos);
+				no_irregularities_found = false;
 			}
 		}
 	}
@@ -3026,53 +3163,57 @@ void CMap::AdjustTileMapIrregularities(const bool overlay, const Vec2i &min_pos,
 
 void CMap::AdjustTileMapTransitions(const Vec2i &min_pos, const Vec2i &max_pos, int z)
 {
-	bool tile_changed = true;
-	int try_count = 0;
-	static constexpr int max_try_count = 100;
+	if (min_pos.x >= max_pos.x || min_pos.y >= max_pos.y) {
+		return;
+	}
 
-	while (tile_changed && try_count < max_try_count) {
-		tile_changed = false;
-		++try_count;
+	const QRect rect(min_pos, max_pos - Vec2i(1, 1));
 
-		for (int x = min_pos.x; x < max_pos.x; ++x) {
-			for (int y = min_pos.y; y < max_pos.y; ++y) {
-				wyrmgus::tile &mf = *this->Field(x, y, z);
+	//adjust the base terrain of each tile in order, setting it to the terrain type returned for an adjacent tile, if any; returns whether any tile was changed
+	//the tiles which would be changed are found in parallel beforehand, and other tiles are only checked if a tile next to them has been changed before them, so that the result is the same as if each tile had been checked in order
+	const auto adjust_tiles = [this, &min_pos, &max_pos, &rect, z](const auto &get_adjacent_tile_terrain) {
+		const auto get_new_terrain = [this, &min_pos, &max_pos, z, &get_adjacent_tile_terrain](const tile &tile, const QPoint &tile_pos, const int sub_x, const int sub_y) -> const terrain_type * {
+			const int x = tile_pos.x();
+			const int y = tile_pos.y();
 
-				if (mf.get_terrain() == nullptr) {
-					continue;
-				}
+			if ((x + sub_x) < min_pos.x || (x + sub_x) >= max_pos.x || (y + sub_y) < min_pos.y || (y + sub_y) >= max_pos.y || (sub_x == 0 && sub_y == 0)) {
+				return nullptr;
+			}
 
-				for (int sub_x = -1; sub_x <= 1; ++sub_x) {
-					for (int sub_y = -1; sub_y <= 1; ++sub_y) {
-						if ((x + sub_x) < min_pos.x || (x + sub_x) >= max_pos.x || (y + sub_y) < min_pos.y || (y + sub_y) >= max_pos.y || (sub_x == 0 && sub_y == 0)) {
-							continue;
-						}
+			return get_adjacent_tile_terrain(tile, Vec2i(x + sub_x, y + sub_y));
+		};
 
-						const wyrmgus::terrain_type *tile_terrain = GetTileTerrain(Vec2i(x + sub_x, y + sub_y), false, z);
-						const wyrmgus::terrain_type *tile_top_terrain = GetTileTopTerrain(Vec2i(x + sub_x, y + sub_y), false, z);
+		tile_rect_flags tiles_to_change(rect);
+		tiles_to_change.set_if([this, z, &get_new_terrain](const QPoint &tile_pos) {
+			const tile &tile = *this->Field(tile_pos, z);
 
-						if (tile_terrain == nullptr) {
-							continue;
-						}
+			if (tile.get_terrain() == nullptr) {
+				return false;
+			}
 
-						if (
-							mf.get_terrain() != tile_terrain
-							&& tile_top_terrain->is_overlay()
-							&& tile_top_terrain != mf.get_overlay_terrain()
-							&& !vector::contains(tile_terrain->get_outer_border_terrain_types(), mf.get_terrain())
-							&& !vector::contains(tile_top_terrain->get_base_terrain_types(), mf.get_terrain())
-						) {
-							mf.SetTerrain(tile_terrain);
-							tile_changed = true;
-						}
+			for (int sub_x = -1; sub_x <= 1; ++sub_x) {
+				for (int sub_y = -1; sub_y <= 1; ++sub_y) {
+					if (get_new_terrain(tile, tile_pos, sub_x, sub_y) != nullptr) {
+						return true;
 					}
 				}
 			}
-		}
+
+			return false;
+		});
+
+		tile_rect_flags changed_tiles(rect);
+		bool tile_changed = false;
 
 		for (int x = min_pos.x; x < max_pos.x; ++x) {
 			for (int y = min_pos.y; y < max_pos.y; ++y) {
-				wyrmgus::tile &mf = *this->Field(x, y, z);
+				const QPoint tile_pos(x, y);
+
+				if (!tiles_to_change.get(tile_pos) && !changed_tiles.is_set_in_neighborhood(tile_pos)) {
+					continue;
+				}
+
+				wyrmgus::tile &mf = *this->Field(tile_pos, z);
 
 				if (mf.get_terrain() == nullptr) {
 					continue;
@@ -3080,27 +3221,63 @@ void CMap::AdjustTileMapTransitions(const Vec2i &min_pos, const Vec2i &max_pos,
 
 				for (int sub_x = -1; sub_x <= 1; ++sub_x) {
 					for (int sub_y = -1; sub_y <= 1; ++sub_y) {
-						if ((x + sub_x) < min_pos.x || (x + sub_x) >= max_pos.x || (y + sub_y) < min_pos.y || (y + sub_y) >= max_pos.y || (sub_x == 0 && sub_y == 0)) {
-							continue;
-						}
+						const terrain_type *new_terrain = get_new_terrain(mf, tile_pos, sub_x, sub_y);
 
-						const terrain_type *tile_terrain = GetTileTerrain(Vec2i(x + sub_x, y + sub_y), false, z);
-
-						if (tile_terrain == nullptr) {
-							continue;
-						}
-
-						if (mf.get_terrain() != tile_terrain && !mf.get_terrain()->is_border_terrain_type(tile_terrain)) {
-							const terrain_type *intermediate_terrain = mf.get_terrain()->get_intermediate_terrain_type(tile_terrain);
-							if (intermediate_terrain != nullptr) {
-								mf.SetTerrain(intermediate_terrain);
-								tile_changed = true;
-							}
+						if (new_terrain != nullptr) {
+							mf.SetTerrain(new_terrain);
+							changed_tiles.set(tile_pos);
+							tile_changed = true;
 						}
 					}
 				}
 			}
 		}
+
+		return tile_changed;
+	};
+
+	bool tile_changed = true;
+	int try_count = 0;
+	static constexpr int max_try_count = 100;
+
+	while (tile_changed && try_count < max_try_count) {
+		tile_changed = false;
+		++try_count;
+
+		tile_changed |= adjust_tiles([this, z](const tile &mf, const Vec2i &adjacent_pos) -> const terrain_type * {
+			const wyrmgus::terrain_type *tile_terrain = GetTileTerrain(adjacent_pos, false, z);
+			const wyrmgus::terrain_type *tile_top_terrain = GetTileTopTerrain(adjacent_pos, false, z);
+
+			if (tile_terrain == nullptr) {
+				return nullptr;
+			}
+
+			if (
+				mf.get_terrain() != tile_terrain
+				&& tile_top_terrain->is_overlay()
+				&& tile_top_terrain != mf.get_overlay_terrain()
+				&& !vector::contains(tile_terrain->get_outer_border_terrain_types(), mf.get_terrain())
+				&& !vector::contains(tile_top_terrain->get_base_terrain_types(), mf.get_terrain())
+			) {
+				return tile_terrain;
+			}
+
+			return nullptr;
+		});
+
+		tile_changed |= adjust_tiles([this, z](const tile &mf, const Vec2i &adjacent_pos) -> const terrain_type * {
+			const terrain_type *tile_terrain = GetTileTerrain(adjacent_pos, false, z);
+
+			if (tile_terrain == nullptr) {
+				return nullptr;
+			}
+
+			if (mf.get_terrain() != tile_terrain && !mf.get_terrain()->is_border_terrain_type(tile_terrain)) {
+				return mf.get_terrain()->get_intermediate_terrain_type(tile_terrain);
+			}
+
+			return nullptr;
+		});
 	}
 }
 
@@ -3333,161 +3510,213 @@ void CMap::generate_terrain(const generated_terrain *generated_terrain, const QP
 		}
 	}
 	
-	//expand seeds
-	for (size_t i = 0; i < seeds.size(); ++i) {
-		QPoint seed_pos = seeds[i];
-		
-		if (max_tile_quantity != 0 && tile_quantity >= max_tile_quantity) {
-			break;
+	//whether a seed can expand to a diagonally adjacent tile, together with the two tiles between them
+	const auto can_expand_to = [&](const QPoint &seed_pos, const QPoint &diagonal_pos) {
+		const QPoint vertical_pos(seed_pos.x(), diagonal_pos.y());
+		const QPoint horizontal_pos(diagonal_pos.x(), seed_pos.y());
+
+		if (
+			//must either be able to generate on the tiles, or they must already have the generated terrain type
+			!generated_terrain->can_tile_be_part_of_expansion(this->Field(diagonal_pos, z))
+			|| !generated_terrain->can_tile_be_part_of_expansion(this->Field(vertical_pos, z))
+			|| !generated_terrain->can_tile_be_part_of_expansion(this->Field(horizontal_pos, z))
+		) {
+			return false;
 		}
-		
-		const int random_number = random::get()->generate(100);
-		if (random_number >= generated_terrain->get_expansion_chance()) {
-			continue;
+
+		const wyrmgus::terrain_type *diagonal_tile_terrain = this->GetTileTerrain(diagonal_pos, false, z);
+		const wyrmgus::terrain_type *vertical_tile_terrain = this->GetTileTerrain(vertical_pos, false, z);
+		const wyrmgus::terrain_type *horizontal_tile_terrain = this->GetTileTerrain(horizontal_pos, false, z);
+		const wyrmgus::terrain_type *diagonal_tile_top_terrain = this->GetTileTopTerrain(diagonal_pos, false, z);
+		const wyrmgus::terrain_type *vertical_tile_top_terrain = this->GetTileTopTerrain(vertical_pos, false, z);
+		const wyrmgus::terrain_type *horizontal_tile_top_terrain = this->GetTileTopTerrain(horizontal_pos, false, z);
+
+		if (!terrain_type->is_overlay()) {
+			if (diagonal_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(diagonal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(diagonal_pos, terrain_type, z))) {
+				return false;
+			}
+			if (vertical_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(vertical_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(vertical_pos, terrain_type, z))) {
+				return false;
+			}
+			if (horizontal_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(horizontal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(horizontal_pos, terrain_type, z))) {
+				return false;
+			}
+		} else {
+			if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), diagonal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(diagonal_pos, terrain_type, z)) && GetTileTerrain(diagonal_pos, terrain_type->is_overlay(), z) != terrain_type) {
+				return false;
+			}
+			if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), vertical_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(vertical_pos, terrain_type, z)) && GetTileTerrain(vertical_pos, terrain_type->is_overlay(), z) != terrain_type) {
+				return false;
+			}
+			if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), horizontal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(horizontal_pos, terrain_type, z)) && GetTileTerrain(horizontal_pos, terrain_type->is_overlay(), z) != terrain_type) {
+				return false;
+			}
 		}
-		
-		std::vector<QPoint> adjacent_positions;
-		for (int sub_x = -1; sub_x <= 1; sub_x += 2) { // +2 so that only diagonals are used
-			for (int sub_y = -1; sub_y <= 1; sub_y += 2) {
-				QPoint diagonal_pos(seed_pos.x() + sub_x, seed_pos.y() + sub_y);
-				QPoint vertical_pos(seed_pos.x(), seed_pos.y() + sub_y);
-				QPoint horizontal_pos(seed_pos.x() + sub_x, seed_pos.y());
-				if (!this->Info->IsPointOnMap(diagonal_pos, z) || diagonal_pos.x() < min_pos.x() || diagonal_pos.y() < min_pos.y() || diagonal_pos.x() > max_pos.x() || diagonal_pos.y() > max_pos.y()) {
+
+		if (diagonal_tile_top_terrain == terrain_type && vertical_tile_top_terrain == terrain_type && horizontal_tile_top_terrain == terrain_type) { //at least one of the tiles being expanded to must be different from the terrain type
+			return false;
+		}
+
+		//tiles within a subtemplate area can only be used as seeds, they cannot be modified themselves
+		if (
+			(this->is_point_in_a_subtemplate_area(diagonal_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(diagonal_pos, z)))
+			|| (this->is_point_in_a_subtemplate_area(vertical_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(vertical_pos, z)))
+			|| (this->is_point_in_a_subtemplate_area(horizontal_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(horizontal_pos, z)))
+		) {
+			return false;
+		}
+
+		if (
+			preserve_coastline
+			&& (
+				terrain_type->has_flag(tile_flag::water_allowed) != diagonal_tile_terrain->has_flag(tile_flag::water_allowed)
+				|| terrain_type->has_flag(tile_flag::water_allowed) != vertical_tile_terrain->has_flag(tile_flag::water_allowed)
+				|| terrain_type->has_flag(tile_flag::water_allowed) != horizontal_tile_terrain->has_flag(tile_flag::water_allowed)
+			)
+		) {
+			return false;
+		}
+
+		if ( // if the terrain is unpassable, don't expand to spots adjacent to buildings
+			terrain_type->has_flag(tile_flag::impassable) && (this->TileBordersUnit(diagonal_pos, z) || this->TileBordersUnit(vertical_pos, z) || this->TileBordersUnit(horizontal_pos, z))
+		) {
+			return false;
+		}
+
+		//tiles with no terrain could nevertheless have units that were placed there already, e.g. due to units in a subtemplate being placed in a location where something is already present (e.g. units with a settlement set as their location, or resource units generated near the player's starting location); as such, we need to check if the terrain is compatible with those units
+		if (this->TileHasUnitsIncompatibleWithTerrain(diagonal_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(vertical_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(horizontal_pos, terrain_type, z)) {
+			return false;
+		}
+
+		return true;
+	};
+
+	//expand seeds in rounds, each round expanding the seeds added by the previous one
+	//the expansion of a round's seeds is chosen in parallel for each region of the map, with a random stream per region, and then applied in region order
+	const QRect map_rect = this->get_rect(z);
+	const map_generation_regions regions(map_rect, static_cast<uint64_t>(random::get()->generate(std::numeric_limits<int>::max())));
+	tile_rect_flags changed_tiles(map_rect);
+	bool max_tile_quantity_reached = max_tile_quantity != 0 && tile_quantity >= max_tile_quantity;
+
+	for (uint64_t round = 0; !seeds.empty() && !max_tile_quantity_reached; ++round) {
+		const std::vector<std::vector<QPoint>> region_seeds = regions.distribute(seeds);
+		seeds.clear();
+
+		std::vector<size_t> region_indices;
+		for (size_t region_index = 0; region_index < region_seeds.size(); ++region_index) {
+			if (!region_seeds[region_index].empty()) {
+				region_indices.push_back(region_index);
+			}
+		}
+
+		//pairs of seeds and the diagonally adjacent tiles they expand to
+		std::vector<std::vector<std::pair<QPoint, QPoint>>> region_expansions(region_seeds.size());
+
+		regions.process_regions(region_indices, [&](const size_t region_index) {
+			random_stream region_random = regions.get_random_stream(region_index, round);
+
+			for (const QPoint &seed_pos : region_seeds[region_index]) {
+				const int random_number = region_random.generate(100);
+				if (random_number >= generated_terrain->get_expansion_chance()) {
 					continue;
 				}
 
+				std::vector<QPoint> adjacent_positions;
+				for (int sub_x = -1; sub_x <= 1; sub_x += 2) { // +2 so that only diagonals are used
+					for (int sub_y = -1; sub_y <= 1; sub_y += 2) {
+						const QPoint diagonal_pos(seed_pos.x() + sub_x, seed_pos.y() + sub_y);
+						if (!this->Info->IsPointOnMap(diagonal_pos, z) || diagonal_pos.x() < min_pos.x() || diagonal_pos.y() < min_pos.y() || diagonal_pos.x() > max_pos.x() || diagonal_pos.y() > max_pos.y()) {
+							continue;
+						}
+
+						if (!can_expand_to(seed_pos, diagonal_pos)) {
+							continue;
+						}
+
+						adjacent_positions.push_back(diagonal_pos);
+					}
+				}
+
+				if (adjacent_positions.size() > 0) {
+					region_expansions[region_index].emplace_back(seed_pos, region_random.get_random(adjacent_positions));
+				}
+			}
+		});
+
+		//an expansion is checked again if a tile near it has been changed by an earlier expansion in the same round
+		changed_tiles.clear();
+
+		for (const size_t region_index : region_indices) {
+			for (const auto &[seed_pos, adjacent_pos] : region_expansions[region_index]) {
+				if (max_tile_quantity != 0 && tile_quantity >= max_tile_quantity) {
+					max_tile_quantity_reached = true;
+					break;
+				}
+
+				const QPoint adjacent_pos_horizontal(adjacent_pos.x(), seed_pos.y());
+				const QPoint adjacent_pos_vertical(seed_pos.x(), adjacent_pos.y());
+
 				if (
-					//must either be able to generate on the tiles, or they must already have the generated terrain type
-					!generated_terrain->can_tile_be_part_of_expansion(this->Field(diagonal_pos, z))
-					|| !generated_terrain->can_tile_be_part_of_expansion(this->Field(vertical_pos, z))
-					|| !generated_terrain->can_tile_be_part_of_expansion(this->Field(horizontal_pos, z))
+					(changed_tiles.is_set_in_neighborhood(adjacent_pos) || changed_tiles.is_set_in_neighborhood(adjacent_pos_horizontal) || changed_tiles.is_set_in_neighborhood(adjacent_pos_vertical))
+					&& !can_expand_to(seed_pos, adjacent_pos)
 				) {
 					continue;
 				}
-		
-				const wyrmgus::terrain_type *diagonal_tile_terrain = this->GetTileTerrain(diagonal_pos, false, z);
-				const wyrmgus::terrain_type *vertical_tile_terrain = this->GetTileTerrain(vertical_pos, false, z);
-				const wyrmgus::terrain_type *horizontal_tile_terrain = this->GetTileTerrain(horizontal_pos, false, z);
-				const wyrmgus::terrain_type *diagonal_tile_top_terrain = this->GetTileTopTerrain(diagonal_pos, false, z);
-				const wyrmgus::terrain_type *vertical_tile_top_terrain = this->GetTileTopTerrain(vertical_pos, false, z);
-				const wyrmgus::terrain_type *horizontal_tile_top_terrain = this->GetTileTopTerrain(horizontal_pos, false, z);
-				
-				if (!terrain_type->is_overlay()) {
-					if (diagonal_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(diagonal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(diagonal_pos, terrain_type, z))) {
-						continue;
+
+				if (!this->is_point_in_a_subtemplate_area(adjacent_pos, z) && this->GetTileTopTerrain(adjacent_pos, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos, z)))) {
+					if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos, z))) {
+						this->Field(adjacent_pos, z)->RemoveOverlayTerrain();
 					}
-					if (vertical_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(vertical_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(vertical_pos, terrain_type, z))) {
-						continue;
+
+					if (this->GetTileTerrain(adjacent_pos, terrain_type->is_overlay(), z) != terrain_type) {
+						this->Field(adjacent_pos, z)->SetTerrain(terrain_type);
 					}
-					if (horizontal_tile_terrain != terrain_type && (!terrain_type->is_border_terrain_type(horizontal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(horizontal_pos, terrain_type, z))) {
-						continue;
+
+					changed_tiles.set(adjacent_pos);
+					seeds.push_back(adjacent_pos);
+
+					if (this->GetTileTopTerrain(adjacent_pos, false, z) == terrain_type) {
+						tile_quantity++;
 					}
-				} else {
-					if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), diagonal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(diagonal_pos, terrain_type, z)) && GetTileTerrain(diagonal_pos, terrain_type->is_overlay(), z) != terrain_type) {
-						continue;
+				}
+
+				if (!this->is_point_in_a_subtemplate_area(adjacent_pos_horizontal, z) && this->GetTileTopTerrain(adjacent_pos_horizontal, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos_horizontal, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_horizontal, z)))) {
+					if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_horizontal, z))) {
+						this->Field(adjacent_pos_horizontal, z)->RemoveOverlayTerrain();
 					}
-					if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), vertical_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(vertical_pos, terrain_type, z)) && GetTileTerrain(vertical_pos, terrain_type->is_overlay(), z) != terrain_type) {
-						continue;
+
+					if (this->GetTileTerrain(adjacent_pos_horizontal, terrain_type->is_overlay(), z) != terrain_type) {
+						this->Field(adjacent_pos_horizontal, z)->SetTerrain(terrain_type);
 					}
-					if ((!wyrmgus::vector::contains(terrain_type->get_base_terrain_types(), horizontal_tile_terrain) || this->TileBordersTerrainIncompatibleWithTerrain(horizontal_pos, terrain_type, z)) && GetTileTerrain(horizontal_pos, terrain_type->is_overlay(), z) != terrain_type) {
-						continue;
+
+					changed_tiles.set(adjacent_pos_horizontal);
+					seeds.push_back(adjacent_pos_horizontal);
+
+					if (this->GetTileTopTerrain(adjacent_pos_horizontal, false, z) == terrain_type) {
+						tile_quantity++;
 					}
 				}
-				
-				if (diagonal_tile_top_terrain == terrain_type && vertical_tile_top_terrain == terrain_type && horizontal_tile_top_terrain == terrain_type) { //at least one of the tiles being expanded to must be different from the terrain type
-					continue;
-				}
-				
-				//tiles within a subtemplate area can only be used as seeds, they cannot be modified themselves
-				if (
-					(this->is_point_in_a_subtemplate_area(diagonal_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(diagonal_pos, z)))
-					|| (this->is_point_in_a_subtemplate_area(vertical_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(vertical_pos, z)))
-					|| (this->is_point_in_a_subtemplate_area(horizontal_pos, z) && !generated_terrain->can_use_tile_as_seed(this->Field(horizontal_pos, z)))
-				) {
-					continue;
-				}
-				
-				if (
-					preserve_coastline
-					&& (
-						terrain_type->has_flag(tile_flag::water_allowed) != diagonal_tile_terrain->has_flag(tile_flag::water_allowed)
-						|| terrain_type->has_flag(tile_flag::water_allowed) != vertical_tile_terrain->has_flag(tile_flag::water_allowed)
-						|| terrain_type->has_flag(tile_flag::water_allowed) != horizontal_tile_terrain->has_flag(tile_flag::water_allowed)
-					)
-				) {
-					continue;
-				}
-				
-				if (this->TileHasUnitsIncompatibleWithTerrain(diagonal_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(vertical_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(horizontal_pos, terrain_type, z)) {
-					continue;
-				}
-				
-				if ( // if the terrain is unpassable, don't expand to spots adjacent to buildings
-					terrain_type->has_flag(tile_flag::impassable) && (this->TileBordersUnit(diagonal_pos, z) || this->TileBordersUnit(vertical_pos, z) || this->TileBordersUnit(horizontal_pos, z))
-				) {
-					continue;
-				}
-				
-				//tiles with no terrain could nevertheless have units that were placed there already, e.g. due to units in a subtemplate being placed in a location where something is already present (e.g. units with a settlement set as their location, or resource units generated near the player's starting location); as such, we need to check if the terrain is compatible with those units
-				if (this->TileHasUnitsIncompatibleWithTerrain(diagonal_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(vertical_pos, terrain_type, z) || this->TileHasUnitsIncompatibleWithTerrain(horizontal_pos, terrain_type, z)) {
-					continue;
-				}
 
-				adjacent_positions.push_back(diagonal_pos);
-			}
-		}
-		
-		if (adjacent_positions.size() > 0) {
-			QPoint adjacent_pos = vector::get_random(adjacent_positions);
-			QPoint adjacent_pos_horizontal(adjacent_pos.x(), seed_pos.y());
-			QPoint adjacent_pos_vertical(seed_pos.x(), adjacent_pos.y());
-			
-			if (!this->is_point_in_a_subtemplate_area(adjacent_pos, z) && this->GetTileTopTerrain(adjacent_pos, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos, z)))) {
-				if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos, z))) {
-					this->Field(adjacent_pos, z)->RemoveOverlayTerrain();
-				}
+				if (!this->is_point_in_a_subtemplate_area(adjacent_pos_vertical, z) && this->GetTileTopTerrain(adjacent_pos_vertical, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos_vertical, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_vertical, z)))) {
+					if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_vertical, z))) {
+						this->Field(adjacent_pos_vertical, z)->RemoveOverlayTerrain();
+					}
 
-				if (this->GetTileTerrain(adjacent_pos, terrain_type->is_overlay(), z) != terrain_type) {
-					this->Field(adjacent_pos, z)->SetTerrain(terrain_type);
-				}
-				
-				seeds.push_back(adjacent_pos);
-				
-				if (this->GetTileTopTerrain(adjacent_pos, false, z) == terrain_type) {
-					tile_quantity++;
-				}
-			}
-			
-			if (!this->is_point_in_a_subtemplate_area(adjacent_pos_horizontal, z) && this->GetTileTopTerrain(adjacent_pos_horizontal, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos_horizontal, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_horizontal, z)))) {
-				if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_horizontal, z))) {
-					this->Field(adjacent_pos_horizontal, z)->RemoveOverlayTerrain();
-				}
-				
-				if (this->GetTileTerrain(adjacent_pos_horizontal, terrain_type->is_overlay(), z) != terrain_type) {
-					this->Field(adjacent_pos_horizontal, z)->SetTerrain(terrain_type);
-				}
-				
-				seeds.push_back(adjacent_pos_horizontal);
-				
-				if (this->GetTileTopTerrain(adjacent_pos_horizontal, false, z) == terrain_type) {
-					tile_quantity++;
+					if (this->GetTileTerrain(adjacent_pos_vertical, terrain_type->is_overlay(), z) != terrain_type) {
+						this->Field(adjacent_pos_vertical, z)->SetTerrain(terrain_type);
+					}
+
+					changed_tiles.set(adjacent_pos_vertical);
+					seeds.push_back(adjacent_pos_vertical);
+
+					if (this->GetTileTopTerrain(adjacent_pos_vertical, false, z) == terrain_type) {
+						tile_quantity++;
+					}
 				}
 			}
-			
-			if (!this->is_point_in_a_subtemplate_area(adjacent_pos_vertical, z) && this->GetTileTopTerrain(adjacent_pos_vertical, false, z) != terrain_type && (this->GetTileTerrain(adjacent_pos_vertical, terrain_type->is_overlay(), z) != terrain_type || generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_vertical, z)))) {
-				if (!terrain_type->is_overlay() && generated_terrain->can_remove_tile_overlay_terrain(this->Field(adjacent_pos_vertical, z))) {
-					this->Field(adjacent_pos_vertical, z)->RemoveOverlayTerrain();
-				}
-				
-				if (this->GetTileTerrain(adjacent_pos_vertical, terrain_type->is_overlay(), z) != terrain_type) {
-					this->Field(adjacent_pos_vertical, z)->SetTerrain(terrain_type);
-				}
-				
-				seeds.push_back(adjacent_pos_vertical);
-				
-				if (this->GetTileTopTerrain(adjacent_pos_vertical, false, z) == terrain_type) {
-					tile_quantity++;
-				}
+
+			if (max_tile_quantity_reached) {
+				break;
 			}
 		}
 	}
@@ -4081,75 +4310,91 @@ void CMap::generate_settlement_territories(const int z)
 
 point_set CMap::expand_settlement_territories(std::vector<QPoint> &&seeds, const int z, const tile_flag block_flags, const tile_flag same_flags)
 {
+	//expand the territories for each region of the map in parallel, with a random stream per region
+	const map_generation_regions regions(this->get_rect(z), static_cast<uint64_t>(random::get()->generate(std::numeric_limits<int>::max())));
+
 	//the seeds blocked by the block flags are stored, and then returned by the function
-	point_set blocked_seeds;
+	std::vector<std::vector<QPoint>> region_blocked_seeds(regions.get_region_count());
 
-	//expand seeds
-	vector::process_randomly(seeds, [&](const QPoint &seed_pos) {
-		const tile *seed_tile = this->Field(seed_pos, z);
+	regions.expand(seeds, [&](const size_t region_index, std::vector<QPoint> &region_seeds, random_stream &region_random, std::vector<QPoint> &outside_seeds) {
+		const QRect region_rect = regions.get_region_rect(region_index);
+		std::vector<QPoint> &blocked_seeds = region_blocked_seeds[region_index];
 
-		//tiles with a block flag can be expanded to, but they can't serve as a basis for further expansion
-		if (seed_tile->CheckMask(block_flags)) {
-			blocked_seeds.insert(seed_pos);
-			return;
-		}
+		while (!region_seeds.empty()) {
+			const QPoint seed_pos = region_random.take_random(region_seeds);
+			const tile *seed_tile = this->Field(seed_pos, z);
 
-		const site *settlement = seed_tile->get_settlement();
-		const tile *settlement_tile = this->Field(settlement->get_game_data()->get_site_unit()->get_center_tile_pos(), z);
+			//tiles with a block flag can be expanded to, but they can't serve as a basis for further expansion
+			if (seed_tile->CheckMask(block_flags)) {
+				blocked_seeds.push_back(seed_pos);
+				continue;
+			}
 
-		const std::vector<QPoint> adjacent_positions = point::get_diagonally_adjacent_if(seed_pos, [&](const QPoint &diagonal_pos) {
-			const QPoint vertical_pos(seed_pos.x(), diagonal_pos.y());
-			const QPoint horizontal_pos(diagonal_pos.x(), seed_pos.y());
+			const site *settlement = seed_tile->get_settlement();
+			const tile *settlement_tile = this->Field(settlement->get_game_data()->get_site_unit()->get_center_tile_pos(), z);
 
-			if (!this->Info->IsPointOnMap(diagonal_pos, z)) {
-				return false;
-			}
+			const std::vector<QPoint> adjacent_positions = point::get_diagonally_adjacent_if(seed_pos, [&](const QPoint &diagonal_pos) {
+				const QPoint vertical_pos(seed_pos.x(), diagonal_pos.y());
+				const QPoint horizontal_pos(diagonal_pos.x(), seed_pos.y());
 
-			const tile *diagonal_tile = this->Field(diagonal_pos, z);
-			const tile *vertical_tile = this->Field(vertical_pos, z);
-			const tile *horizontal_tile = this->Field(horizontal_pos, z);
+				if (!this->Info->IsPointOnMap(diagonal_pos, z)) {
+					return false;
+				}
 
-			if ( //the tiles must either have no settlement, or have the settlement we want to assign
-				(diagonal_tile->get_settlement() != nullptr && diagonal_tile->get_settlement() != settlement)
-				|| (vertical_tile->get_settlement() != nullptr && vertical_tile->get_settlement() != settlement)
-				|| (horizontal_tile->get_settlement() != nullptr && horizontal_tile->get_settlement() != settlement)
-			) {
-				return false;
-			}
+				const tile *diagonal_tile = this->Field(diagonal_pos, z);
+				const tile *vertical_tile = this->Field(vertical_pos, z);
+				const tile *horizontal_tile = this->Field(horizontal_pos, z);
 
-			if (diagonal_tile->get_settlement() != nullptr && vertical_tile->get_settlement() != nullptr && horizontal_tile->get_settlement() != nullptr) { //at least one of the tiles being expanded to must have no assigned settlement
-				return false;
-			}
+				if ( //the tiles must either have no settlement, or have the settlement we want to assign
+					(diagonal_tile->get_settlement() != nullptr && diagonal_tile->get_settlement() != settlement)
+					|| (vertical_tile->get_settlement() != nullptr && vertical_tile->get_settlement() != settlement)
+					|| (horizontal_tile->get_settlement() != nullptr && horizontal_tile->get_settlement() != settlement)
+				) {
+					return false;
+				}
 
-			//the same flags function similarly to the block flags, but block only if the tile does not contain the same same_flags as the settlement's original tile, and they block expansion to the tile itself, not just expansion from it
-			if ((diagonal_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags) || (vertical_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags) || (horizontal_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags)) {
-				blocked_seeds.insert(seed_pos);
-				return false;
-			}
+				if (diagonal_tile->get_settlement() != nullptr && vertical_tile->get_settlement() != nullptr && horizontal_tile->get_settlement() != nullptr) { //at least one of the tiles being expanded to must have no assigned settlement
+					return false;
+				}
 
-			return true;
-		});
+				//the same flags function similarly to the block flags, but block only if the tile does not contain the same same_flags as the settlement's original tile, and they block expansion to the tile itself, not just expansion from it
+				if ((diagonal_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags) || (vertical_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags) || (horizontal_tile->Flags & same_flags) != (settlement_tile->Flags & same_flags)) {
+					blocked_seeds.push_back(seed_pos);
+					return false;
+				}
 
-		if (adjacent_positions.size() > 0) {
-			if (adjacent_positions.size() > 1) {
-				//push the seed back again for another try, since it may be able to generate further in the future
-				seeds.push_back(seed_pos);
-			}
+				return true;
+			});
 
-			QPoint adjacent_pos = vector::get_random(adjacent_positions);
-			QPoint adjacent_pos_horizontal(adjacent_pos.x(), seed_pos.y());
-			QPoint adjacent_pos_vertical(seed_pos.x(), adjacent_pos.y());
+			if (adjacent_positions.size() > 0) {
+				if (adjacent_positions.size() > 1) {
+					//push the seed back again for another try, since it may be able to generate further in the future
+					region_seeds.push_back(seed_pos);
+				}
 
-			this->Field(adjacent_pos, z)->set_settlement(settlement);
-			this->Field(adjacent_pos_horizontal, z)->set_settlement(settlement);
-			this->Field(adjacent_pos_vertical, z)->set_settlement(settlement);
+				const QPoint &adjacent_pos = region_random.get_random(adjacent_positions);
+				const QPoint adjacent_pos_horizontal(adjacent_pos.x(), seed_pos.y());
+				const QPoint adjacent_pos_vertical(seed_pos.x(), adjacent_pos.y());
 
-			seeds.push_back(std::move(adjacent_pos));
-			seeds.push_back(std::move(adjacent_pos_horizontal));
-			seeds.push_back(std::move(adjacent_pos_vertical));
+				for (const QPoint &pos : { adjacent_pos, adjacent_pos_horizontal, adjacent_pos_vertical }) {
+					this->Field(pos, z)->set_settlement(settlement);
+
+					if (region_rect.contains(pos)) {
+						region_seeds.push_back(pos);
+					} else {
+						outside_seeds.push_back(pos);
+					}
+				}
+			}
 		}
 	});
 
+	point_set blocked_seeds;
+
+	for (const std::vector<QPoint> &positions : region_blocked_seeds) {
+		blocked_seeds.insert(positions.begin(), positions.end());
+	}
+
 	return blocked_seeds;
 }
 
@@ -90,6 +90,7 @@ namespace wyrmgus {
 	class map_info;
 	class map_settings;
 	class map_template;
+	class save_container;
 	class site;
 	class terrain_type;
 	class tile;
@@ -164,8 +165,12 @@ public:
 	void process_gsml_property(const gsml_property &property);
 	void process_gsml_scope(const gsml_data &scope);
 
-	//save the map.
-	void save(CFile &file) const;
+	//save the map; the tiles are added as a section of the binary save container, which is written after the Lua script of the save
+	void save(CFile &file, save_container &container) const;
+
+	//save the tiles of all map layers to a binary save container, serializing chunks of tile rows in parallel, and load them from it
+	void save_tiles_to_binary(save_container &container) const;
+	void load_tiles_from_binary(const std::string_view &container_data);
 
 	void do_per_cycle_loop();
 	
@@ -179,6 +184,7 @@ public:
 	void CalculateTileLandmass(const Vec2i &pos, int z);
 	void CalculateTileOwnershipTransition(const Vec2i &pos, int z);
 	void AdjustMap();
+	bool is_tile_irregular(const QPoint &pos, const bool overlay, const int z) const;
 	void AdjustTileMapIrregularities(const bool overlay, const Vec2i &min_pos, const Vec2i &max_pos, const int z);
 	void AdjustTileMapTransitions(const Vec2i &min_pos, const Vec2i &max_pos, int z);
 	void adjust_territory_irregularities(const QPoint &min_pos, const QPoint &max_pos, const int z);
@@ -448,8 +454,20 @@ extern template void MapSight<MapUnmarkTileRadar>(const CPlayer &player, const V
 extern template void MapSight<MapMarkTileRadarJammer>(const CPlayer &player, const Vec2i &pos, const int w, const int h, const int range, const int z);
 extern template void MapSight<MapUnmarkTileRadarJammer>(const CPlayer &player, const Vec2i &pos, const int w, const int h, const int range, const int z);
 
+/// Move a sight area, only marking and unmarking the tiles which differ between the old and new positions
+template <wyrmgus::map_marker_func_ptr marker, wyrmgus::map_marker_func_ptr unmarker>
+extern void MapSightDelta(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+
+extern template void MapSightDelta<MapMarkTileSight, MapUnmarkTileSight>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+extern template void MapSightDelta<MapMarkTileDetectCloak, MapUnmarkTileDetectCloak>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+extern template void MapSightDelta<MapMarkTileDetectEthereal, MapUnmarkTileDetectEthereal>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+extern template void MapSightDelta<MapMarkTileRadar, MapUnmarkTileRadar>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+extern template void MapSightDelta<MapMarkTileRadarJammer, MapUnmarkTileRadarJammer>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+
 /// Update fog of war
 extern void UpdateFogOfWarChange();
+/// Mark the fog of war of all map layers as needing a full update when drawn
+extern void InvalidateFogOfWar();
 
 //
 // in map_wall.c
@@ -530,6 +548,20 @@ extern void load_map_data(const std::string &gsml_string);
 void MapMarkUnitSight(CUnit &unit);
 /// Unmark on vision table the Sight of the unit.
 void MapUnmarkUnitSight(CUnit &unit);
+/// The ranges with which the sight of a unit was marked on the vision table, 0 for those not marked
+struct unit_sight_marking final
+{
+	int sight_range = 0;
+	int detect_cloak_range = 0;
+	int ethereal_vision_range = 0;
+	int radar_range = 0;
+	int radar_jammer_range = 0;
+};
+
+/// Get the ranges with which the Sight of the unit (and of the units inside it) is marked on vision table.
+void GetUnitSightMarkings(const CUnit &unit, std::vector<unit_sight_marking> &markings);
+/// Move on vision table the Sight of the unit, after it moved on the same map layer.
+void MapMoveUnitSight(CUnit &unit, const Vec2i &old_pos, const std::vector<unit_sight_marking> &old_markings);
 
 /// Can a unit with 'mask' enter the field
 extern bool CanMoveToMask(const Vec2i &pos, tile_flag mask, const int z);
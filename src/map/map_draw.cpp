@@ -61,6 +61,7 @@
 #include "util/vector_util.h"
 #include "video/font.h"
 #include "video/font_color.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -316,7 +317,7 @@ void CViewport::for_each_map_tile(const function_type &function) const
 	}
 }
 
-void CViewport::draw_map_tile(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map_tile(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const
 {
 	const terrain_type *terrain = ReplayRevealMap ? tile->get_terrain() : tile->player_info->SeenTerrain;
 	const terrain_type *overlay_terrain = ReplayRevealMap ? tile->get_overlay_terrain() : tile->player_info->SeenOverlayTerrain;
@@ -360,7 +361,7 @@ void CViewport::draw_map_tile(const tile *tile, const QPoint &pixel_pos, std::ve
 	}
 }
 
-void CViewport::draw_map_tile_top(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map_tile_top(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const
 {
 	const terrain_type *terrain = ReplayRevealMap ? tile->get_terrain() : tile->player_info->SeenTerrain;
 	const terrain_type *overlay_terrain = ReplayRevealMap ? tile->get_overlay_terrain() : tile->player_info->SeenOverlayTerrain;
@@ -385,7 +386,7 @@ void CViewport::draw_map_tile_top(const tile *tile, const QPoint &pixel_pos, std
 	}
 }
 
-void CViewport::draw_map_tile_overlay_terrain(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map_tile_overlay_terrain(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const
 {
 	const terrain_type *terrain = ReplayRevealMap ? tile->get_terrain() : tile->player_info->SeenTerrain;
 	const terrain_type *overlay_terrain = ReplayRevealMap ? tile->get_overlay_terrain() : tile->player_info->SeenOverlayTerrain;
@@ -427,7 +428,7 @@ void CViewport::draw_map_tile_overlay_terrain(const tile *tile, const QPoint &pi
 	}
 }
 
-void CViewport::draw_map_tile_border(const tile *tile, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map_tile_border(const tile *tile, const QPoint &pixel_pos, render_command_buffer &render_commands) const
 {
 	const wyrmgus::player_color *player_color = tile->get_player_color();
 
@@ -473,7 +474,7 @@ void CViewport::draw_map_tile_border(const tile *tile, const QPoint &pixel_pos,
 ** (in pixels)
 ** </PRE>
 */
-void CViewport::draw_map(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map(render_command_buffer &render_commands) const
 {
 	this->for_each_map_tile([this, &render_commands](const tile *tile, const QPoint &pixel_pos) {
 		this->draw_map_tile(tile, pixel_pos, render_commands);
@@ -491,7 +492,7 @@ void CViewport::draw_map(std::vector<std::function<void(renderer *)>> &render_co
 /**
 **  Draw a map viewport.
 */
-void CViewport::Draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::Draw(render_command_buffer &render_commands) const
 {
 	PushClipping();
 	this->SetClipping();
@@ -641,7 +642,7 @@ void CViewport::Draw(std::vector<std::function<void(renderer *)>> &render_comman
 /**
 **  Draw border around the viewport
 */
-void CViewport::DrawBorder(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::DrawBorder(render_command_buffer &render_commands) const
 {
 	// if we a single viewport, no need to denote the "selected" one
 	if (UI.NumViewports == 1) {
@@ -40,6 +40,7 @@
 #include "map/minimap.h"
 #include "map/tile.h"
 #include "map/tile_flag.h"
+#include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "ui/ui.h"
 #include "unit/unit.h"
@@ -50,7 +51,7 @@
 #include "util/assert_util.h"
 #include "util/util.h"
 #include "video/intern_video.h"
-#include "video/renderer.h"
+#include "video/render_command_buffer.h"
 #include "video/video.h"
 
 
@@ -75,6 +76,18 @@ static constexpr std::array<int, 16> FogTable = {
 static std::vector<std::vector<unsigned short>> VisibleTable;
 //Wyrmgus end
 
+//the state on which the team visibility of the tiles in a map layer's visible table was calculated, other than the visibility states of the tiles themselves
+struct visible_table_key final
+{
+	bool valid = false;
+	int player_index = -1;
+	player_index_set mutual_shared_vision;
+	std::vector<int> revealed_player_indexes;
+	bool fog_of_war = true;
+};
+
+static std::vector<visible_table_key> VisibleTableKeys;
+
 class _filter_flags
 {
 public:
@@ -242,6 +255,18 @@ static void UnitsOnTileUnmarkSeen(const CPlayer &player, wyrmgus::tile &mf, int
 }
 
 
+/**
+**  Mark a tile as needing its fog of war to be updated when drawn.
+**
+**  @param index   tile whose visibility changed.
+**  @param z       map layer of the tile.
+*/
+static void MarkTileFogDirty(const unsigned int index, const int z)
+{
+	CMapLayer *map_layer = CMap::get()->MapLayers[z].get();
+	map_layer->mark_fog_dirty_tile(map_layer->GetPosFromIndex(index));
+}
+
 /**
 **  Mark a tile's sight. (Explore and make visible.)
 **
@@ -269,8 +294,14 @@ void MapMarkTileSight(const CPlayer &player, const unsigned int index, int z)
 				UnitsOnTileMarkSeen(player, mf, 0, 0);
 			}
 
+			if (v == 0) {
+				AStarTileExplored(CMap::get()->get_index_pos(index, z), z, player);
+			}
+
 			v = 2;
 
+			MarkTileFogDirty(index, z);
+
 			if (GameRunning) {
 				if (CPlayer::GetThisPlayer() == &player || player.shares_visibility_with(CPlayer::GetThisPlayer())) {
 					CMap::get()->MarkSeenTile(mf);
@@ -332,6 +363,8 @@ void MapUnmarkTileSight(const CPlayer &player, const unsigned int index, int z)
 
 			--v;
 
+			MarkTileFogDirty(index, z);
+
 			if (GameRunning) {
 				if (CPlayer::GetThisPlayer() == &player || player.shares_visibility_with(CPlayer::GetThisPlayer())) {
 					UI.get_minimap()->update_exploration_index(index, z);
@@ -632,6 +665,97 @@ template void MapSight<MapUnmarkTileRadar>(const CPlayer &player, const Vec2i &p
 template void MapSight<MapMarkTileRadarJammer>(const CPlayer &player, const Vec2i &pos, const int w, const int h, const int range, const int z);
 template void MapSight<MapUnmarkTileRadarJammer>(const CPlayer &player, const Vec2i &pos, const int w, const int h, const int range, const int z);
 
+/**
+**  The tile indexes collected by MapCollectTileSight.
+*/
+static std::vector<unsigned int> *CollectedSightTiles = nullptr;
+
+static void MapCollectTileSight(const CPlayer &player, const unsigned int index, const int z)
+{
+	Q_UNUSED(player)
+	Q_UNUSED(z)
+
+	CollectedSightTiles->push_back(index);
+}
+
+/**
+**  Get the indexes of the tiles which MapSight would mark, in ascending order.
+*/
+static void GetSightTiles(const CPlayer &player, const Vec2i &pos, const int w, const int h, const int range, const int z, std::vector<unsigned int> &sight_tiles)
+{
+	sight_tiles.clear();
+	CollectedSightTiles = &sight_tiles;
+	MapSight<MapCollectTileSight>(player, pos, w, h, range, z);
+	CollectedSightTiles = nullptr;
+
+	//MapSight visits the tiles row by row, so the indexes should already be sorted
+	if (!std::is_sorted(sight_tiles.begin(), sight_tiles.end())) {
+		std::sort(sight_tiles.begin(), sight_tiles.end());
+	}
+}
+
+/**
+**  Move a sight area, marking only the tiles which became part of it and
+**  unmarking only the ones which left it, instead of unmarking and remarking
+**  the whole area.
+**
+**  This is equivalent to MapSight<unmarker> for the old position followed
+**  by MapSight<marker> for the new one, but tiles in both areas keep their
+**  visibility state, so units on them don't go under and out of fog again.
+**
+**  @param player    Player to mark sight.
+**  @param old_pos   Previous location of the sight area.
+**  @param new_pos   New location of the sight area.
+**  @param w         Width in tiles of the unit.
+**  @param h         Height in tiles of the unit.
+**  @param range     Radius of the sight area.
+**  @param z         Map layer of both positions.
+**  @param marker    Function to mark sight.
+**  @param unmarker  Function to unmark sight.
+*/
+template <map_marker_func_ptr marker, map_marker_func_ptr unmarker>
+void MapSightDelta(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z)
+{
+	if (!range || old_pos == new_pos) {
+		return;
+	}
+
+	static std::vector<unsigned int> old_sight_tiles;
+	static std::vector<unsigned int> new_sight_tiles;
+
+	GetSightTiles(player, old_pos, w, h, range, z, old_sight_tiles);
+	GetSightTiles(player, new_pos, w, h, range, z, new_sight_tiles);
+
+	//mark the tiles only in the new area first, then unmark the ones only in the old area
+	auto old_it = old_sight_tiles.begin();
+	for (const unsigned int index : new_sight_tiles) {
+		while (old_it != old_sight_tiles.end() && *old_it < index) {
+			++old_it;
+		}
+
+		if (old_it == old_sight_tiles.end() || *old_it != index) {
+			marker(player, index, z);
+		}
+	}
+
+	auto new_it = new_sight_tiles.begin();
+	for (const unsigned int index : old_sight_tiles) {
+		while (new_it != new_sight_tiles.end() && *new_it < index) {
+			++new_it;
+		}
+
+		if (new_it == new_sight_tiles.end() || *new_it != index) {
+			unmarker(player, index, z);
+		}
+	}
+}
+
+template void MapSightDelta<MapMarkTileSight, MapUnmarkTileSight>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+template void MapSightDelta<MapMarkTileDetectCloak, MapUnmarkTileDetectCloak>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+template void MapSightDelta<MapMarkTileDetectEthereal, MapUnmarkTileDetectEthereal>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+template void MapSightDelta<MapMarkTileRadar, MapUnmarkTileRadar>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+template void MapSightDelta<MapMarkTileRadarJammer, MapUnmarkTileRadarJammer>(const CPlayer &player, const Vec2i &old_pos, const Vec2i &new_pos, const int w, const int h, const int range, const int z);
+
 /**
 **  Update fog of war.
 */
@@ -670,6 +794,8 @@ void UpdateFogOfWarChange()
 	for (size_t z = 0; z < CMap::get()->MapLayers.size(); ++z) {
 		UI.get_minimap()->update_exploration(z);
 	}
+
+	InvalidateFogOfWar();
 }
 
 /*----------------------------------------------------------------------------
@@ -682,11 +808,9 @@ void UpdateFogOfWarChange()
 **  @param x  X position into video memory
 **  @param y  Y position into video memory
 */
-static void VideoDrawOnlyFog(const int x, const int y, std::vector<std::function<void(renderer *)>> &render_commands)
+static void VideoDrawOnlyFog(const int x, const int y, render_command_buffer &render_commands)
 {
-	render_commands.push_back([x, y](renderer *renderer) {
-		renderer->fill_rect(QPoint(x, y), defines::get()->get_scaled_tile_size(), QColor(0, 0, 0, FogOfWarOpacity));
-	});
+	render_commands.add_filled_rect(QPoint(x, y), defines::get()->get_scaled_tile_size(), QColor(0, 0, 0, FogOfWarOpacity));
 }
 
 /*----------------------------------------------------------------------------
@@ -907,7 +1031,7 @@ static void GetFogOfWarTile(int sx, int sy, int *fogTile, int *blackFogTile, int
 **  @param dx  X position into video memory.
 **  @param dy  Y position into video memory.
 */
-static void DrawFogOfWarTile(const int sx, const int sy, const int dx, const int dy, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawFogOfWarTile(const int sx, const int sy, const int dx, const int dy, render_command_buffer &render_commands)
 {
 	int fogTile = 0;
 	int blackFogTile = 0;
@@ -937,41 +1061,83 @@ static void DrawFogOfWarTile(const int sx, const int sy, const int dx, const int
 #undef IsMapFieldVisibleTable
 }
 
+/**
+**  Update the visible table of a map layer for the tiles whose visibility
+**  changed, or for the whole map layer if the state on which the team
+**  visibility depends (e.g. the player or shared vision) changed.
+**
+**  @param map_layer  Map layer to update.
+*/
+static void UpdateVisibleTable(CMapLayer &map_layer)
+{
+	const int z = map_layer.ID;
+	const CPlayer *this_player = CPlayer::GetThisPlayer();
+	const player_index_set &mutual_shared_vision = this_player->get_mutual_shared_vision();
+	const std::vector<int> &revealed_player_indexes = CPlayer::get_revealed_player_indexes();
+	const bool fog_of_war = !CMap::get()->NoFogOfWar;
+
+	const std::vector<QRect> dirty_rects = map_layer.take_fog_dirty_rects();
+
+	visible_table_key &key = VisibleTableKeys[z];
+	std::vector<unsigned short> &visible_table = VisibleTable[z];
+
+	const auto update_rect = [&](const QRect &rect) {
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			const int row_index = y * map_layer.get_width();
+
+			for (int x = rect.left(); x <= rect.right(); ++x) {
+				const int index = row_index + x;
+				visible_table[index] = map_layer.Field(index)->player_info->get_team_visibility_state(this_player->get_index(), mutual_shared_vision, revealed_player_indexes, fog_of_war);
+			}
+		}
+	};
+
+	if (!key.valid || key.player_index != this_player->get_index() || key.mutual_shared_vision != mutual_shared_vision || key.revealed_player_indexes != revealed_player_indexes || key.fog_of_war != fog_of_war) {
+		key.valid = true;
+		key.player_index = this_player->get_index();
+		key.mutual_shared_vision = mutual_shared_vision;
+		key.revealed_player_indexes = revealed_player_indexes;
+		key.fog_of_war = fog_of_war;
+
+		update_rect(QRect(QPoint(0, 0), map_layer.get_size()));
+		return;
+	}
+
+	for (const QRect &dirty_rect : dirty_rects) {
+		update_rect(dirty_rect);
+	}
+}
+
+/**
+**  Mark the fog of war of all map layers as needing to be updated when drawn.
+*/
+void InvalidateFogOfWar()
+{
+	for (visible_table_key &key : VisibleTableKeys) {
+		key.valid = false;
+	}
+}
+
 /**
 **  Draw the map fog of war.
 */
-void CViewport::draw_map_fog_of_war(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CViewport::draw_map_fog_of_war(render_command_buffer &render_commands) const
 {
 	// flags must redraw or not
 	if (ReplayRevealMap) {
 		return;
 	}
 
-	int sx = std::max<int>(MapPos.x - 1, 0);
-	int ex = std::min<int>(MapPos.x + MapWidth + 1, UI.CurrentMapLayer->get_width());
-	int my = std::max<int>(MapPos.y - 1, 0);
-	int ey = std::min<int>(MapPos.y + MapHeight + 1, UI.CurrentMapLayer->get_height());
-
-	// Update for visibility all tile in viewport
-	// and 1 tile around viewport (for fog-of-war connection display)
+	//update the visibility of the tiles which changed since the last time the fog of war was drawn
+	UpdateVisibleTable(*UI.CurrentMapLayer);
 
-	unsigned int my_index = my * UI.CurrentMapLayer->get_width();
-	for (; my < ey; ++my) {
-		for (int mx = sx; mx < ex; ++mx) {
-			//Wyrmgus start
-//			VisibleTable[my_index + mx] = CMap::get()->Field(mx + my_index)->player_info->TeamVisibilityState(*ThisPlayer);
-			VisibleTable[UI.CurrentMapLayer->ID][my_index + mx] = CMap::get()->Field(mx + my_index, UI.CurrentMapLayer->ID)->player_info->get_team_visibility_state(*CPlayer::GetThisPlayer());
-			//Wyrmgus end
-		}
-		my_index += UI.CurrentMapLayer->get_width();
-	}
-	ex = this->get_bottom_right_pos().x();
+	const int ex = this->get_bottom_right_pos().x();
 	int sy = MapPos.y * UI.CurrentMapLayer->get_width();
 	int dy = this->get_top_left_pos().y() - Offset.y;
-	ey = this->get_bottom_right_pos().y();
+	const int ey = this->get_bottom_right_pos().y();
 
 	while (dy <= ey) {
-		sx = MapPos.x + sy;
+		int sx = MapPos.x + sy;
 		int dx = this->get_top_left_pos().x() - Offset.x;
 		while (dx <= ex) {
 			//Wyrmgus start
@@ -980,9 +1146,7 @@ void CViewport::draw_map_fog_of_war(std::vector<std::function<void(renderer *)>>
 			//Wyrmgus end
 				DrawFogOfWarTile(sx, sy, dx, dy, render_commands);
 			} else {
-				render_commands.push_back([dx, dy](renderer *renderer) {
-					renderer->fill_rect(QPoint(dx, dy), defines::get()->get_scaled_tile_size(), CVideo::GetRGBA(FogOfWarColorSDL));
-				});
+				render_commands.add_filled_rect(QPoint(dx, dy), defines::get()->get_scaled_tile_size(), CVideo::GetRGBA(FogOfWarColorSDL));
 			}
 			++sx;
 			dx += defines::get()->get_scaled_tile_width();
@@ -1014,6 +1178,9 @@ void CMap::InitFogOfWar()
 		VisibleTable[z].resize(this->Info->MapWidths[z] * this->Info->MapHeights[z]);
 	}
 	//Wyrmgus end
+
+	VisibleTableKeys.clear();
+	VisibleTableKeys.resize(this->MapLayers.size());
 }
 
 /**
@@ -1022,6 +1189,7 @@ void CMap::InitFogOfWar()
 void CMap::CleanFogOfWar()
 {
 	VisibleTable.clear();
+	VisibleTableKeys.clear();
 
 	CMap::FogGraphics.reset();
 }
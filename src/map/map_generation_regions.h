@@ -0,0 +1,186 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#pragma once
+
+#include "util/random_stream.h"
+#include "util/thread_pool.h"
+
+namespace wyrmgus {
+
+//splits a map rect into fixed-size regions, so that procedural generation can be processed for disjoint regions on several threads
+//each region has its own random stream for each round of generation, seeded from a single value, so that the same seed yields the same map regardless of the number of threads
+class map_generation_regions final
+{
+public:
+	static constexpr int region_size = 32;
+
+	//how far outside of its region the expansion function given to expand() may change tiles; it may read tiles up to twice as far
+	static constexpr int expansion_margin = 1;
+
+	explicit map_generation_regions(const QRect &rect, const uint64_t seed)
+		: rect(rect), seed(seed)
+	{
+		this->columns = std::max((rect.width() + map_generation_regions::region_size - 1) / map_generation_regions::region_size, 0);
+		this->rows = std::max((rect.height() + map_generation_regions::region_size - 1) / map_generation_regions::region_size, 0);
+	}
+
+	size_t get_region_count() const
+	{
+		return static_cast<size_t>(this->columns * this->rows);
+	}
+
+	size_t get_region_index(const QPoint &pos) const
+	{
+		const int column = (pos.x() - this->rect.left()) / map_generation_regions::region_size;
+		const int row = (pos.y() - this->rect.top()) / map_generation_regions::region_size;
+		return static_cast<size_t>(row * this->columns + column);
+	}
+
+	QRect get_region_rect(const size_t region_index) const
+	{
+		const int column = static_cast<int>(region_index) % this->columns;
+		const int row = static_cast<int>(region_index) / this->columns;
+		const QPoint top_left(this->rect.left() + column * map_generation_regions::region_size, this->rect.top() + row * map_generation_regions::region_size);
+		return QRect(top_left, QSize(map_generation_regions::region_size, map_generation_regions::region_size)).intersected(this->rect);
+	}
+
+	random_stream get_random_stream(const size_t region_index, const uint64_t round) const
+	{
+		return random_stream(random_stream::mix_seed(random_stream::mix_seed(this->seed, round), region_index));
+	}
+
+	//distribute the positions within the rect to the regions containing them, keeping their order
+	std::vector<std::vector<QPoint>> distribute(const std::vector<QPoint> &positions) const
+	{
+		std::vector<std::vector<QPoint>> region_positions(this->get_region_count());
+
+		for (const QPoint &pos : positions) {
+			if (!this->rect.contains(pos)) {
+				continue;
+			}
+
+			region_positions[this->get_region_index(pos)].push_back(pos);
+		}
+
+		return region_positions;
+	}
+
+	//call the function with each of the given region indices, on the thread pool; the function must only write data belonging to the region it is called for
+	template <typename function_type>
+	void process_regions(const std::vector<size_t> &region_indices, const function_type &function) const
+	{
+		if (region_indices.empty()) {
+			return;
+		}
+
+		std::atomic<size_t> next_index = 0;
+
+		const auto process = [&region_indices, &function, &next_index]() {
+			while (true) {
+				const size_t index = next_index.fetch_add(1);
+				if (index >= region_indices.size()) {
+					break;
+				}
+
+				function(region_indices[index]);
+			}
+		};
+
+		const size_t worker_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), region_indices.size());
+
+		std::vector<std::future<void>> futures;
+		for (size_t i = 1; i < worker_count; ++i) {
+			futures.push_back(thread_pool::get()->co_spawn_future([&process]() -> boost::asio::awaitable<void> {
+				process();
+				co_return;
+			}));
+		}
+
+		process();
+
+		for (std::future<void> &future : futures) {
+			future.get();
+		}
+	}
+
+	//expand from the given seeds until no region has seeds left
+	//the function is called as function(region_index, seeds, random, outside_seeds), and should process all seeds of its region, placing any new seeds outside the region in outside_seeds
+	//it may change tiles up to the expansion margin outside its region; the regions are processed in four checkerboard passes, so that regions processed at the same time are a whole region apart
+	template <typename function_type>
+	void expand(const std::vector<QPoint> &seeds, const function_type &function) const
+	{
+		std::vector<std::vector<QPoint>> region_seeds = this->distribute(seeds);
+		std::vector<std::vector<QPoint>> region_outside_seeds(this->get_region_count());
+
+		for (uint64_t round = 0; std::any_of(region_seeds.begin(), region_seeds.end(), [](const std::vector<QPoint> &seeds) { return !seeds.empty(); }); ++round) {
+			for (int pass = 0; pass < 4; ++pass) {
+				std::vector<size_t> region_indices;
+
+				for (size_t region_index = 0; region_index < region_seeds.size(); ++region_index) {
+					if (region_seeds[region_index].empty()) {
+						continue;
+					}
+
+					const int column = static_cast<int>(region_index) % this->columns;
+					const int row = static_cast<int>(region_index) / this->columns;
+					if ((column % 2) + (row % 2) * 2 != pass) {
+						continue;
+					}
+
+					region_indices.push_back(region_index);
+				}
+
+				this->process_regions(region_indices, [this, round, &function, &region_seeds, &region_outside_seeds](const size_t region_index) {
+					random_stream random = this->get_random_stream(region_index, round);
+					function(region_index, region_seeds[region_index], random, region_outside_seeds[region_index]);
+					region_seeds[region_index].clear();
+				});
+
+				//hand the seeds placed outside of the processed regions over to the regions containing them, in a fixed order
+				for (const size_t region_index : region_indices) {
+					for (const QPoint &outside_seed : region_outside_seeds[region_index]) {
+						if (!this->rect.contains(outside_seed)) {
+							continue;
+						}
+
+						region_seeds[this->get_region_index(outside_seed)].push_back(outside_seed);
+					}
+
+					region_outside_seeds[region_index].clear();
+				}
+			}
+		}
+	}
+
+private:
+	QRect rect;
+	uint64_t seed = 0;
+	int columns = 0;
+	int rows = 0;
+};
+
+}
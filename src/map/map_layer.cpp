@@ -49,7 +49,7 @@
 #include "util/assert_util.h"
 #include "util/point_util.h"
 
-CMapLayer::CMapLayer(const QSize &size) : size(size)
+CMapLayer::CMapLayer(const QSize &size) : size(size), unit_cell_grid(size)
 {
 	if (size.width() > MaxMapWidth) {
 		throw std::runtime_error("Tried to create a map layer with width (" + std::to_string(size.width()) + ") greater than the maximum (" + std::to_string(MaxMapWidth) + ").");
@@ -104,6 +104,49 @@ tile *CMapLayer::Field(const unsigned int index) const
 	return &this->Fields[index];
 }
 
+void CMapLayer::mark_fog_dirty_rect(const QRect &tile_rect)
+{
+	const QRect clipped_rect = tile_rect.intersected(QRect(QPoint(0, 0), this->size));
+	if (clipped_rect.isEmpty()) {
+		return;
+	}
+
+	const int cell_width = (this->get_width() + fog_cell_size - 1) / fog_cell_size;
+
+	if (this->fog_dirty_cells.empty()) {
+		const int cell_height = (this->get_height() + fog_cell_size - 1) / fog_cell_size;
+		this->fog_dirty_cells.resize(cell_width * cell_height, false);
+	}
+
+	for (int cell_y = clipped_rect.top() / fog_cell_size; cell_y <= clipped_rect.bottom() / fog_cell_size; ++cell_y) {
+		for (int cell_x = clipped_rect.left() / fog_cell_size; cell_x <= clipped_rect.right() / fog_cell_size; ++cell_x) {
+			std::vector<bool>::reference dirty = this->fog_dirty_cells[cell_y * cell_width + cell_x];
+
+			if (dirty) {
+				continue;
+			}
+
+			dirty = true;
+
+			const QRect cell_rect(QPoint(cell_x * fog_cell_size, cell_y * fog_cell_size), QSize(fog_cell_size, fog_cell_size));
+			this->fog_dirty_rects.push_back(cell_rect.intersected(QRect(QPoint(0, 0), this->size)));
+		}
+	}
+}
+
+std::vector<QRect> CMapLayer::take_fog_dirty_rects()
+{
+	const int cell_width = (this->get_width() + fog_cell_size - 1) / fog_cell_size;
+
+	for (const QRect &dirty_rect : this->fog_dirty_rects) {
+		this->fog_dirty_cells[(dirty_rect.top() / fog_cell_size) * cell_width + dirty_rect.left() / fog_cell_size] = false;
+	}
+
+	std::vector<QRect> dirty_rects = std::move(this->fog_dirty_rects);
+	this->fog_dirty_rects.clear();
+	return dirty_rects;
+}
+
 /**
 **	@brief	Perform the map layer's per-hour loop
 */
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "map/cell_grid.h"
 #include "map/map_template_container.h"
 #include "map/tile_transition.h"
 #include "vec2i.h"
@@ -193,6 +194,27 @@ public:
 		return empty_rect;
 	}
 
+	const cell_grid<CUnit> &get_unit_cell_grid() const
+	{
+		return this->unit_cell_grid;
+	}
+
+	cell_grid<CUnit> &get_unit_cell_grid()
+	{
+		return this->unit_cell_grid;
+	}
+
+	//mark the tiles in the rect as having had their visibility changed, so that their fog of war is updated when next drawn
+	void mark_fog_dirty_rect(const QRect &tile_rect);
+
+	void mark_fog_dirty_tile(const QPoint &tile_pos)
+	{
+		this->mark_fog_dirty_rect(QRect(tile_pos, QSize(1, 1)));
+	}
+
+	//get the rects of the tiles whose visibility changed since the last call, and clear them
+	std::vector<QRect> take_fog_dirty_rects();
+
 signals:
 	void tile_image_changed(QPoint tile_pos, const terrain_type *terrain, short tile_frame, const player_color *player_color) const;
 	void tile_overlay_image_changed(QPoint tile_pos, const terrain_type *terrain, short tile_frame, const player_color *player_color) const;
@@ -226,6 +248,13 @@ public:
 	wyrmgus::map_template_map<QRect> subtemplate_areas;
 	std::vector<QPoint> destroyed_overlay_terrain_tiles; /// destroyed overlay terrain tiles (excluding trees)
 	std::vector<QPoint> destroyed_tree_tiles;	/// destroyed tree tiles; this list is used for forest regeneration
+private:
+	//visibility changes are tracked per cell of tiles, so that the list of dirty rects stays bounded regardless of how many tiles change
+	static constexpr int fog_cell_size = 8;
+
+	cell_grid<CUnit> unit_cell_grid; //index of the units on the map layer by coarse cells, kept alongside the tile unit caches
+	std::vector<bool> fog_dirty_cells; //whether each fog of war cell has had a change in tile visibility since the fog of war was last drawn
+	std::vector<QRect> fog_dirty_rects; //the tile rects of the dirty fog of war cells
 
 	friend int CclStratagusMap(lua_State *l);
 };
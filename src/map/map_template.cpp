@@ -32,6 +32,7 @@
 #include "character_history.h"
 #include "database/defines.h"
 #include "editor.h"
+#include "engine_interface.h"
 #include "game/game.h"
 #include "include/config.h"
 #include "iocompat.h"
@@ -44,6 +45,7 @@
 #include "map/generated_terrain.h"
 #include "map/historical_location.h"
 #include "map/map.h"
+#include "map/map_generation_regions.h"
 #include "map/map_info.h"
 #include "map/map_layer.h"
 #include "map/map_projection.h"
@@ -89,6 +91,7 @@
 #include "util/number_util.h"
 #include "util/path_util.h"
 #include "util/point_util.h"
+#include "util/random.h"
 #include "util/set_util.h"
 #include "util/size_util.h"
 #include "util/string_util.h"
@@ -772,6 +775,45 @@ void map_template::apply_territory_image(const QPoint &template_start_pos, const
 	}
 }
 
+//measures how long each phase of applying a map template takes, adding the duration of each phase to the loading screen log when it ends
+class map_template_phase_timer final
+{
+public:
+	explicit map_template_phase_timer(const wyrmgus::map_template *applied_template) : applied_template(applied_template)
+	{
+	}
+
+	~map_template_phase_timer()
+	{
+		this->finish_phase();
+	}
+
+	void start_phase(const char *phase_name)
+	{
+		this->finish_phase();
+
+		this->phase_name = phase_name;
+		this->phase_start_time = std::chrono::steady_clock::now();
+	}
+
+	void finish_phase()
+	{
+		if (this->phase_name == nullptr) {
+			return;
+		}
+
+		const long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->phase_start_time).count();
+		engine_interface::get()->add_loading_log_line("Map template \"" + this->applied_template->get_identifier() + "\": " + this->phase_name + " took " + std::to_string(milliseconds) + " ms.");
+
+		this->phase_name = nullptr;
+	}
+
+private:
+	const wyrmgus::map_template *applied_template = nullptr;
+	const char *phase_name = nullptr;
+	std::chrono::steady_clock::time_point phase_start_time;
+};
+
 void map_template::apply(const QPoint &template_start_pos, const QPoint &map_start_pos, const int z)
 {
 	if (SaveGameLoading) {
@@ -851,7 +893,10 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 	
 	const bool has_base_map = !this->get_terrain_file().empty();
 	
+	map_template_phase_timer phase_timer(this);
+
 	ShowLoadProgress(_("Applying \"%s\" Map Template Terrain..."), this->get_name().c_str());
+	phase_timer.start_phase("terrain application");
 	
 	if (this->get_base_terrain_type() != nullptr || this->get_border_terrain_type() != nullptr || this->clear_terrain) {
 		for (int x = map_start_pos.x(); x < map_end.x(); ++x) {
@@ -991,16 +1036,19 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 	
 	if (!this->get_subtemplates().empty()) {
 		ShowLoadProgress(_("Applying \"%s\" Subtemplates..."), this->get_name().c_str());
+		phase_timer.start_phase("subtemplate application");
 		this->apply_subtemplates(template_start_pos, map_start_pos, map_end, z, false, false);
 	}
 
 	if (!this->IsSubtemplateArea() && !this->generated_factions.empty()) {
 		ShowLoadProgress(_("Generating \"%s\" Zones..."), this->get_name().c_str());
+		phase_timer.start_phase("zone generation");
 		this->generate_zones(z);
 	}
 
 	if (!this->IsSubtemplateArea() && this->is_tile_adjustment_enabled()) {
 		ShowLoadProgress(_("Adjusting \"%s\" Map Template Terrain..."), this->get_name().c_str());
+		phase_timer.start_phase("terrain adjustment");
 		CMap::get()->AdjustTileMapIrregularities(false, map_start_pos, map_end, z);
 		CMap::get()->AdjustTileMapIrregularities(true, map_start_pos, map_end, z);
 		CMap::get()->AdjustTileMapTransitions(map_start_pos, map_end, z);
@@ -1008,6 +1056,7 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 	}
 	
 	ShowLoadProgress(_("Applying \"%s\" Map Template Units..."), this->get_name().c_str());
+	phase_timer.start_phase("unit application");
 
 	for (std::map<std::pair<int, int>, std::tuple<unit_type *, int, unique_item *>>::const_iterator iterator = this->Resources.begin(); iterator != this->Resources.end(); ++iterator) {
 		Vec2i unit_raw_pos(iterator->first.first, iterator->first.second);
@@ -1050,20 +1099,24 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 
 	if (!this->get_subtemplates().empty()) {
 		ShowLoadProgress(_("Applying \"%s\" Random Subtemplates..."), this->get_name().c_str());
+		phase_timer.start_phase("random subtemplate application");
 		this->apply_subtemplates(template_start_pos, map_start_pos, map_end, z, true, false);
 	}
 
 	if (!this->IsSubtemplateArea()) {
+		phase_timer.start_phase("missing terrain generation");
 		CMap::get()->generate_missing_terrain(QRect(map_start_pos, map_end - QPoint(1, 1)), z);
 	}
 
 	ShowLoadProgress(_("Generating \"%s\" Map Template Random Terrain..."), this->get_name().c_str());
+	phase_timer.start_phase("random terrain generation");
 	for (const auto &generated_terrain : this->generated_terrains) {
 		CMap::get()->generate_terrain(generated_terrain.get(), map_start_pos, map_end - Vec2i(1, 1), has_base_map, z);
 	}
 
 	if (!this->IsSubtemplateArea() && this->is_tile_adjustment_enabled()) {
 		ShowLoadProgress(_("Readjusting \"%s\" Map Template Terrain..."), this->get_name().c_str());
+		phase_timer.start_phase("terrain readjustment");
 		CMap::get()->AdjustTileMapIrregularities(false, map_start_pos, map_end, z);
 		CMap::get()->AdjustTileMapIrregularities(true, map_start_pos, map_end, z);
 		CMap::get()->AdjustTileMapTransitions(map_start_pos, map_end, z);
@@ -1072,11 +1125,13 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 
 	if (!this->get_subtemplates().empty()) {
 		ShowLoadProgress(_("Applying \"%s\" Constructed Subtemplates..."), this->get_name().c_str());
+		phase_timer.start_phase("constructed subtemplate application");
 		this->apply_subtemplates(template_start_pos, map_start_pos, map_end, z, false, true);
 		this->apply_subtemplates(template_start_pos, map_start_pos, map_end, z, true, true);
 	}
 
 	ShowLoadProgress(_("Generating \"%s\" Map Template Random Units..."), this->get_name().c_str());
+	phase_timer.start_phase("random unit generation");
 
 	// now, generate the units and heroes that were set to be generated at a random position (by having their position set to {-1, -1})
 	if (current_campaign != nullptr) {
@@ -1157,6 +1212,7 @@ void map_template::apply(const QPoint &template_start_pos, const QPoint &map_sta
 	}
 
 	if (!this->IsSubtemplateArea()) {
+		phase_timer.start_phase("territory adjustment");
 		CMap::get()->adjust_territory_irregularities(map_start_pos, map_end - QPoint(1, 1), z);
 
 		if (this->create_starting_mine) {
@@ -2379,38 +2435,49 @@ void map_template::expand_zones(std::vector<zone_variant> &tile_zones, std::vect
 {
 	const QSize &map_size = CMap::get()->MapLayers[z]->get_size();
 
-	while (!seeds.empty()) {
-		QPoint seed_pos = vector::take_random(seeds);
-		const zone_variant zone = tile_zones[point::to_index(seed_pos, map_size)];
+	//expand the zones for each region of the map in parallel, with a random stream per region
+	const map_generation_regions regions(QRect(QPoint(0, 0), map_size), static_cast<uint64_t>(random::get()->generate(std::numeric_limits<int>::max())));
 
-		std::vector<QPoint> adjacent_positions;
+	regions.expand(seeds, [&](const size_t region_index, std::vector<QPoint> &region_seeds, random_stream &region_random, std::vector<QPoint> &outside_seeds) {
+		const QRect region_rect = regions.get_region_rect(region_index);
 
-		point::for_each_cardinally_adjacent(seed_pos, [&](QPoint &&adjacent_pos) {
-			if (!CMap::get()->get_info()->IsPointOnMap(adjacent_pos, z)) {
-				return;
-			}
+		while (!region_seeds.empty()) {
+			QPoint seed_pos = region_random.take_random(region_seeds);
+			const zone_variant zone = tile_zones[point::to_index(seed_pos, map_size)];
 
-			if (!std::holds_alternative<std::monostate>(tile_zones[point::to_index(adjacent_pos, map_size)])) {
-				return;
-			}
+			std::vector<QPoint> adjacent_positions;
 
-			adjacent_positions.push_back(std::move(adjacent_pos));
-		});
+			point::for_each_cardinally_adjacent(seed_pos, [&](QPoint &&adjacent_pos) {
+				if (!CMap::get()->get_info()->IsPointOnMap(adjacent_pos, z)) {
+					return;
+				}
 
-		if (adjacent_positions.empty()) {
-			continue;
-		}
+				if (!std::holds_alternative<std::monostate>(tile_zones[point::to_index(adjacent_pos, map_size)])) {
+					return;
+				}
 
-		if (adjacent_positions.size() > 1) {
-			//push the seed back again for another try, since it may be able to generate further in the future
-			seeds.push_back(std::move(seed_pos));
-		}
+				adjacent_positions.push_back(std::move(adjacent_pos));
+			});
+
+			if (adjacent_positions.empty()) {
+				continue;
+			}
 
-		QPoint adjacent_pos = vector::take_random(adjacent_positions);
-		tile_zones[point::to_index(adjacent_pos, map_size)] = zone;
+			if (adjacent_positions.size() > 1) {
+				//push the seed back again for another try, since it may be able to generate further in the future
+				region_seeds.push_back(std::move(seed_pos));
+			}
 
-		seeds.push_back(std::move(adjacent_pos));
-	}
+			QPoint adjacent_pos = region_random.take_random(adjacent_positions);
+			tile_zones[point::to_index(adjacent_pos, map_size)] = zone;
+
+			if (region_rect.contains(adjacent_pos)) {
+				region_seeds.push_back(std::move(adjacent_pos));
+			} else {
+				outside_seeds.push_back(std::move(adjacent_pos));
+			}
+		}
+	});
 }
 
 void map_template::generate_site(const site *site, const QPoint &map_start_pos, const QPoint &map_end, const int z) const
@@ -47,6 +47,7 @@
 #include "unit/unit_type.h"
 #include "util/log_util.h"
 #include "util/vector_util.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -57,8 +58,6 @@ static constexpr int ATTACK_RED_DURATION = 1 * CYCLES_PER_SECOND;
 /// unit attacked are shown blinking for this amount of cycles
 static constexpr int ATTACK_BLINK_DURATION = 7 * CYCLES_PER_SECOND;
 
-static constexpr int SCALE_PRECISION = 100;
-
 // MinimapScale:
 // 32x32 64x64 96x96 128x128 256x256 512x512 ...
 // *4    *2    *4/3  *1      *1/2    *1/4
@@ -76,7 +75,7 @@ int NumMinimapEvents;
 
 namespace wyrmgus {
 
-minimap::minimap() : mode(minimap_mode::terrain)
+minimap::minimap() : mode(minimap_mode::terrain), overlay_mode(minimap_mode::terrain)
 {
 }
 
@@ -129,6 +128,24 @@ void minimap::Create()
 			this->map_to_minimap_y[z][i] = (i * MinimapScaleY[z]) / MINIMAP_FAC;
 		}
 
+		//the texels showing each tile, so that updating a tile doesn't need to scan the whole texture
+		this->tile_texel_columns.push_back(std::vector<std::pair<int, int>>(CMap::get()->Info->MapWidths[z], std::make_pair(0, 0)));
+		this->tile_texel_rows.push_back(std::vector<std::pair<int, int>>(CMap::get()->Info->MapHeights[z], std::make_pair(0, 0)));
+		for (int mx = XOffset[z]; mx < texture_width - XOffset[z]; ++mx) {
+			std::pair<int, int> &texel_range = this->tile_texel_columns[z][this->minimap_to_map_x[z][mx]];
+			if (texel_range.first == texel_range.second) {
+				texel_range.first = mx;
+			}
+			texel_range.second = mx + 1;
+		}
+		for (int my = YOffset[z]; my < texture_height - YOffset[z]; ++my) {
+			std::pair<int, int> &texel_range = this->tile_texel_rows[z][this->minimap_to_map_y[z][my] / CMap::get()->Info->MapWidths[z]];
+			if (texel_range.first == texel_range.second) {
+				texel_range.first = my;
+			}
+			texel_range.second = my + 1;
+		}
+
 		// Palette updated from UpdateMinimapTerrain()
 		for (this->minimap_texture_width[z] = 1; this->minimap_texture_width[z] < texture_width; this->minimap_texture_width[z] <<= 1) {
 		}
@@ -165,6 +182,8 @@ void minimap::Create()
 		this->update_exploration(z);
 	}
 
+	this->overlay_layer = -1;
+
 	NumMinimapEvents = 0;
 }
 
@@ -241,49 +260,18 @@ void minimap::UpdateXY(const Vec2i &pos, const int z)
 		return;
 	}
 
-	int scalex = MinimapScaleX[z] * SCALE_PRECISION / MINIMAP_FAC;
-	if (scalex == 0) {
-		scalex = 1;
-	}
-	int scaley = MinimapScaleY[z] * SCALE_PRECISION / MINIMAP_FAC;
-	if (scaley == 0) {
-		scaley = 1;
-	}
-
+	const tile &mf = *CMap::get()->MapLayers[z]->Field(pos);
+	const terrain_type *terrain = mf.get_top_terrain(true);
 	const season *season = CMap::get()->MapLayers[z]->get_tile_season(pos);
 
-	const int ty = pos.y * CMap::get()->Info->MapWidths[z];
-	const int tx = pos.x;
+	const QColor color = terrain ? terrain->get_minimap_color(season) : QColor(0, 0, 0);
+	const uint32_t c = CVideo::MapRGB(color);
 
-	const int texture_width = this->get_texture_width(z);
-	const int texture_height = this->get_texture_height(z);
+	const QRect texel_rect = this->get_tile_texel_rect(pos, z);
 	unsigned char *terrain_image_buffer = this->terrain_images[z].bits();
 
-	for (int my = YOffset[z]; my < texture_height - YOffset[z]; ++my) {
-		const int y = this->minimap_to_map_y[z][my];
-		if (y < ty) {
-			continue;
-		}
-		if (y > ty) {
-			break;
-		}
-
-		for (int mx = XOffset[z]; mx < texture_width - XOffset[z]; ++mx) {
-			const int x = this->minimap_to_map_x[z][mx];
-
-			if (x < tx) {
-				continue;
-			}
-			if (x > tx) {
-				break;
-			}
-
-			const tile &mf = *CMap::get()->MapLayers[z]->Field(x + y);
-			const terrain_type *terrain = mf.get_top_terrain(true);
-
-			const QColor color = terrain ? terrain->get_minimap_color(season) : QColor(0, 0, 0);
-
-			const uint32_t c = CVideo::MapRGB(color);
+	for (int my = texel_rect.top(); my <= texel_rect.bottom(); ++my) {
+		for (int mx = texel_rect.left(); mx <= texel_rect.right(); ++mx) {
 			*(uint32_t *) &(terrain_image_buffer[(mx + my * this->minimap_texture_width[z]) * 4]) = c;
 		}
 	}
@@ -291,34 +279,18 @@ void minimap::UpdateXY(const Vec2i &pos, const int z)
 
 void minimap::update_territory_xy(const QPoint &pos, const int z)
 {
-	const int texture_width = this->get_texture_width(z);
-	const int texture_height = this->get_texture_height(z);
-
-	const int ty = pos.y() * CMap::get()->Info->MapWidths[z];
-	const int tx = pos.x();
-
-	for (int my = YOffset[z]; my < texture_height - YOffset[z]; ++my) {
-		const int y = this->minimap_to_map_y[z][my];
-		if (y < ty) {
-			continue;
-		}
-		if (y > ty) {
-			break;
-		}
-
-		for (int mx = XOffset[z]; mx < texture_width - XOffset[z]; ++mx) {
-			const int x = this->minimap_to_map_x[z][mx];
-
-			if (x < tx) {
-				continue;
-			}
-			if (x > tx) {
-				break;
-			}
+	const QRect texel_rect = this->get_tile_texel_rect(pos, z);
 
+	for (int my = texel_rect.top(); my <= texel_rect.bottom(); ++my) {
+		for (int mx = texel_rect.left(); mx <= texel_rect.right(); ++mx) {
 			this->update_territory_pixel(mx, my, z);
 		}
 	}
+
+	if (z == this->overlay_layer) {
+		//the overlay copies the territory pixels in some minimap modes
+		this->overlay_tracker.mark_dirty(texel_rect);
+	}
 }
 
 void minimap::update_territory_pixel(const int mx, const int my, const int z)
@@ -406,12 +378,6 @@ void minimap::update_exploration_index(const int index, const int z)
 
 void minimap::update_exploration_xy(const QPoint &pos, const int z)
 {
-	const int texture_width = this->get_texture_width(z);
-	const int texture_height = this->get_texture_height(z);
-
-	const int ty = pos.y() * CMap::get()->Info->MapWidths[z];
-	const int tx = pos.x();
-
 	unsigned short visibility_state;
 
 	if (ReplayRevealMap) {
@@ -422,25 +388,10 @@ void minimap::update_exploration_xy(const QPoint &pos, const int z)
 		visibility_state = tile->player_info->get_team_visibility_state(*CPlayer::GetThisPlayer());
 	}
 
-	for (int my = YOffset[z]; my < texture_height - YOffset[z]; ++my) {
-		const int y = this->minimap_to_map_y[z][my];
-		if (y < ty) {
-			continue;
-		}
-		if (y > ty) {
-			break;
-		}
-
-		for (int mx = XOffset[z]; mx < texture_width - XOffset[z]; ++mx) {
-			const int x = this->minimap_to_map_x[z][mx];
-
-			if (x < tx) {
-				continue;
-			}
-			if (x > tx) {
-				break;
-			}
+	const QRect texel_rect = this->get_tile_texel_rect(pos, z);
 
+	for (int my = texel_rect.top(); my <= texel_rect.bottom(); ++my) {
+		for (int mx = texel_rect.left(); mx <= texel_rect.right(); ++mx) {
 			this->update_exploration_pixel(mx, my, z, visibility_state);
 		}
 	}
@@ -535,19 +486,15 @@ QColor minimap::get_terrain_unit_minimap_color(const CUnit *unit, const unit_typ
 	return QColor(Qt::transparent);
 }
 
-void minimap::draw_unit(const CUnit *unit, const bool red_phase)
+std::optional<minimap_unit_draw_state> minimap::get_unit_draw_state(const CUnit *unit, const bool red_phase, const int z) const
 {
-	const int z = UI.CurrentMapLayer->ID;
-
 	const unit_type *type = this->get_unit_minimap_type(unit);
 
 	//don't draw decorations or diminutive fauna units on the minimap
 	if (type->BoolFlag[DECORATION_INDEX].value || (type->BoolFlag[DIMINUTIVE_INDEX].value && type->BoolFlag[FAUNA_INDEX].value)) {
-		return;
+		return std::nullopt;
 	}
 
-	const uint32_t color = this->get_unit_minimap_color(unit, type, red_phase);
-
 	const int texture_width = this->get_texture_width(z);
 	const int texture_height = this->get_texture_height(z);
 
@@ -559,31 +506,47 @@ void minimap::draw_unit(const CUnit *unit, const bool red_phase)
 		w = texture_width - mx;
 	}
 
-	int h0 = this->map_to_minimap_y[z][type->get_tile_height()];
-	if (my + h0 >= texture_height) { //clip bottom side
-		h0 = texture_height - my;
+	int h = this->map_to_minimap_y[z][type->get_tile_height()];
+	if (my + h >= texture_height) { //clip bottom side
+		h = texture_height - my;
 	}
 
+	minimap_unit_draw_state state;
+	state.rect = QRect(mx - 1, my - 1, w + 1, h + 1);
+	state.color = this->get_unit_minimap_color(unit, type, red_phase);
+	return state;
+}
+
+minimap_unit_draw_state minimap::get_terrain_unit_draw_state(const CUnit *unit, const bool red_phase, const int z) const
+{
+	const unit_type *type = this->get_unit_minimap_type(unit);
+
+	const int x = this->XOffset[z] + this->map_to_minimap_x[z][unit->tilePos.x];
+	const int y = this->YOffset[z] + this->map_to_minimap_y[z][unit->tilePos.y];
+
+	//include the texels touched by the antialiased outline of the circle
+	minimap_unit_draw_state state;
+	state.rect = QRect(x - 1, y - 1, type->get_tile_width() + 4, type->get_tile_height() + 4);
+	state.color = this->get_terrain_unit_minimap_color(unit, type, red_phase).rgba();
+	state.terrain = true;
+	return state;
+}
+
+void minimap::draw_unit(const minimap_unit_draw_state &state, const int z)
+{
 	unsigned char *overlay_image_buffer = this->overlay_images[z].bits();
 
-	while (w-- >= 0) {
-		int h = h0;
-		while (h-- >= 0) {
-			*(uint32_t *) &(overlay_image_buffer[((mx + w) + (my + h) * this->minimap_texture_width[z]) * 4]) = color;
+	for (int my = state.rect.top(); my <= state.rect.bottom(); ++my) {
+		for (int mx = state.rect.left(); mx <= state.rect.right(); ++mx) {
+			*(uint32_t *) &(overlay_image_buffer[(mx + my * this->minimap_texture_width[z]) * 4]) = state.color;
 		}
 	}
 }
 
 //draw a unit as terrain, on its center tile
-void minimap::draw_terrain_unit(const CUnit *unit, const bool red_phase)
+void minimap::draw_terrain_unit(const minimap_unit_draw_state &state, const int z)
 {
-	const unit_type *type = this->get_unit_minimap_type(unit);
-	const QColor color = this->get_terrain_unit_minimap_color(unit, type, red_phase);
-
-	const int z = UI.CurrentMapLayer->ID;
-
-	const int x = this->XOffset[z] + this->map_to_minimap_x[z][unit->tilePos.x];
-	const int y = this->YOffset[z] + this->map_to_minimap_y[z][unit->tilePos.y];
+	const QColor color = QColor::fromRgba(state.color);
 
 	//draw as a circle
 	QPainter painter(&this->overlay_images[z]);
@@ -591,11 +554,14 @@ void minimap::draw_terrain_unit(const CUnit *unit, const bool red_phase)
 	painter.setBrush(QBrush(color));
 	painter.setPen(QPen(color));
 
-	painter.drawEllipse(x, y, type->get_tile_width() + 1, type->get_tile_height() + 1);
+	painter.drawEllipse(state.rect.x() + 1, state.rect.y() + 1, state.rect.width() - 3, state.rect.height() - 3);
 }
 
 /**
 **  Update the minimap with the current game information
+**
+**  Only the parts of the overlay which changed since the last update are redrawn,
+**  unless the map layer or minimap mode changed.
 */
 void minimap::Update()
 {
@@ -608,32 +574,46 @@ void minimap::Update()
 
 	const int z = UI.CurrentMapLayer->ID;
 
-	//clear Minimap background if not transparent
-	if (!this->Transparent) {
-		this->overlay_images[z].fill(Qt::transparent);
-	}
-
-	if (minimap_mode_has_overlay(this->get_mode())) {
-		this->overlay_images[z] = this->mode_overlay_images[this->get_mode()][z];
-	}
-
 	const int texture_width = this->get_texture_width(z);
 	const int texture_height = this->get_texture_height(z);
-	unsigned char *overlay_image_buffer = this->overlay_images[z].bits();
 
-	for (int my = 0; my < texture_height; ++my) {
-		for (int mx = 0; mx < texture_width; ++mx) {
-			if (mx < XOffset[z] || mx >= texture_width - XOffset[z] || my < YOffset[z] || my >= texture_height - YOffset[z]) {
-				*(uint32_t *) &(overlay_image_buffer[(mx + my * this->minimap_texture_width[z]) * 4]) = CVideo::MapRGB(0, 0, 0);
+	if (z != this->overlay_layer || this->get_mode() != this->overlay_mode) {
+		//clear Minimap background if not transparent
+		if (!this->Transparent) {
+			this->overlay_images[z].fill(Qt::transparent);
+		}
+
+		if (minimap_mode_has_overlay(this->get_mode())) {
+			this->overlay_images[z] = this->mode_overlay_images[this->get_mode()][z];
+		}
+
+		unsigned char *overlay_image_buffer = this->overlay_images[z].bits();
+
+		for (int my = 0; my < texture_height; ++my) {
+			for (int mx = 0; mx < texture_width; ++mx) {
+				if (mx < XOffset[z] || mx >= texture_width - XOffset[z] || my < YOffset[z] || my >= texture_height - YOffset[z]) {
+					*(uint32_t *) &(overlay_image_buffer[(mx + my * this->minimap_texture_width[z]) * 4]) = CVideo::MapRGB(0, 0, 0);
+				}
 			}
 		}
+
+		this->overlay_layer = z;
+		this->overlay_mode = this->get_mode();
+		this->overlay_tracker.clear(QSize(texture_width, texture_height));
 	}
 
+	std::vector<minimap_overlay_tracker::unit_state> unit_states;
+
 	if (this->are_units_visible()) {
 		//draw units on the map
 		for (const CUnit *unit : unit_manager::get()->get_units()) {
-			if (unit->IsVisibleOnMinimap()) {
-				this->draw_unit(unit, red_phase);
+			if (!unit->IsVisibleOnMinimap()) {
+				continue;
+			}
+
+			std::optional<minimap_unit_draw_state> state = this->get_unit_draw_state(unit, red_phase, z);
+			if (state.has_value()) {
+				unit_states.emplace_back(UnitNumber(*unit), std::move(state.value()));
 			}
 		}
 	} else {
@@ -647,12 +627,48 @@ void minimap::Update()
 				continue;
 			}
 
-			this->draw_terrain_unit(unit, red_phase);
+			unit_states.emplace_back(UnitNumber(*unit), this->get_terrain_unit_draw_state(unit, red_phase, z));
+		}
+	}
+
+	this->overlay_tracker.update(unit_states, [this, z](const QRect &rect) {
+		this->restore_overlay_rect(rect, z);
+	}, [this, z](const size_t, const minimap_unit_draw_state &state) {
+		if (state.terrain) {
+			this->draw_terrain_unit(state, z);
+		} else {
+			this->draw_unit(state, z);
+		}
+	});
+}
+
+//restore the overlay background (i.e. what it has without any units drawn on it) for a rectangle of texels
+void minimap::restore_overlay_rect(const QRect &rect, const int z)
+{
+	const int texture_width = this->get_texture_width(z);
+	const int texture_height = this->get_texture_height(z);
+
+	const bool has_mode_overlay = minimap_mode_has_overlay(this->get_mode());
+	const unsigned char *mode_overlay_image_buffer = has_mode_overlay ? this->mode_overlay_images[this->get_mode()][z].constBits() : nullptr;
+	unsigned char *overlay_image_buffer = this->overlay_images[z].bits();
+
+	for (int my = rect.top(); my <= rect.bottom(); ++my) {
+		for (int mx = rect.left(); mx <= rect.right(); ++mx) {
+			const int offset = (mx + my * this->minimap_texture_width[z]) * 4;
+			uint32_t c = 0;
+
+			if (mx < XOffset[z] || mx >= texture_width - XOffset[z] || my < YOffset[z] || my >= texture_height - YOffset[z]) {
+				c = CVideo::MapRGB(0, 0, 0);
+			} else if (has_mode_overlay) {
+				c = *(const uint32_t *) &(mode_overlay_image_buffer[offset]);
+			}
+
+			*(uint32_t *) &(overlay_image_buffer[offset]) = c;
 		}
 	}
 }
 
-void minimap::draw_events(std::vector<std::function<void(renderer *)>> &render_commands) const
+void minimap::draw_events(render_command_buffer &render_commands) const
 {
 	static constexpr unsigned char alpha = 192;
 
@@ -684,7 +700,7 @@ void minimap::draw_events(std::vector<std::function<void(renderer *)>> &render_c
 	}
 }
 
-void minimap::Draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void minimap::Draw(render_command_buffer &render_commands) const
 {
 	const int z = UI.CurrentMapLayer->ID;
 
@@ -702,7 +718,7 @@ void minimap::Draw(std::vector<std::function<void(renderer *)>> &render_commands
 	this->draw_events(render_commands);
 }
 
-void minimap::draw_image(const QImage &image, const int z, std::vector<std::function<void(renderer *)>> &render_commands) const
+void minimap::draw_image(const QImage &image, const int z, render_command_buffer &render_commands) const
 {
 	QRect rect = this->get_texture_draw_rect(z);
 
@@ -781,6 +797,14 @@ QPoint minimap::tile_to_screen_pos(const QPoint &tile_pos) const
 	return this->texture_to_screen_pos(texture_pos);
 }
 
+QRect minimap::get_tile_texel_rect(const QPoint &tile_pos, const int z) const
+{
+	const std::pair<int, int> &texel_columns = this->tile_texel_columns[z][tile_pos.x()];
+	const std::pair<int, int> &texel_rows = this->tile_texel_rows[z][tile_pos.y()];
+
+	return QRect(texel_columns.first, texel_rows.first, texel_columns.second - texel_columns.first, texel_rows.second - texel_rows.first);
+}
+
 /**
 **  Destroy mini-map.
 */
@@ -796,6 +820,10 @@ void minimap::Destroy()
 	this->minimap_to_map_y.clear();
 	this->map_to_minimap_x.clear();
 	this->map_to_minimap_y.clear();
+	this->tile_texel_columns.clear();
+	this->tile_texel_rows.clear();
+
+	this->overlay_layer = -1;
 
 	MinimapScaleX.clear();
 	MinimapScaleY.clear();
@@ -806,7 +834,7 @@ void minimap::Destroy()
 /**
 **  Draw viewport area contour.
 */
-void minimap::DrawViewportArea(const CViewport &viewport, std::vector<std::function<void(renderer *)>> &render_commands) const
+void minimap::DrawViewportArea(const CViewport &viewport, render_command_buffer &render_commands) const
 {
 	// Determine and save region below minimap cursor
 	const int z = UI.CurrentMapLayer->ID;
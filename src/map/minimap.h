@@ -27,6 +27,7 @@
 #pragma once
 
 #include "color.h"
+#include "map/minimap_overlay_tracker.h"
 #include "vec2i.h"
 
 class CUnit;
@@ -61,29 +62,35 @@ public:
 	void update_exploration_xy(const QPoint &pos, const int z);
 	void update_exploration_pixel(const int mx, const int my, const int z, const unsigned short visibility_state);
 	void Update();
+private:
+	void restore_overlay_rect(const QRect &rect, const int z);
+public:
 	void Create();
 	void Destroy();
-	void Draw(std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void draw_image(const QImage &image, const int z, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	void DrawViewportArea(const CViewport &viewport, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void Draw(render_command_buffer &render_commands) const;
+	void draw_image(const QImage &image, const int z, render_command_buffer &render_commands) const;
+	void DrawViewportArea(const CViewport &viewport, render_command_buffer &render_commands) const;
 
 private:
 	const unit_type *get_unit_minimap_type(const CUnit *unit) const;
 	uint32_t get_unit_minimap_color(const CUnit *unit, const unit_type *type, const bool red_phase) const;
 	QColor get_terrain_unit_minimap_color(const CUnit *unit, const unit_type *type, const bool red_phase) const;
+	std::optional<minimap_unit_draw_state> get_unit_draw_state(const CUnit *unit, const bool red_phase, const int z) const;
+	minimap_unit_draw_state get_terrain_unit_draw_state(const CUnit *unit, const bool red_phase, const int z) const;
 
-	void draw_unit(const CUnit *unit, const bool red_phase);
-	void draw_terrain_unit(const CUnit *unit, const bool red_phase);
+	void draw_unit(const minimap_unit_draw_state &state, const int z);
+	void draw_terrain_unit(const minimap_unit_draw_state &state, const int z);
 
 public:
 	void AddEvent(const Vec2i &pos, int z, IntColor color);
-	void draw_events(std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void draw_events(render_command_buffer &render_commands) const;
 
 	QPoint texture_to_tile_pos(const QPoint &texture_pos) const;
 	QPoint texture_to_screen_pos(const QPoint &texture_pos) const;
 	QPoint screen_to_tile_pos(const QPoint &screen_pos) const;
 	QPoint tile_to_texture_pos(const QPoint &tile_pos) const;
 	QPoint tile_to_screen_pos(const QPoint &tile_pos) const;
+	QRect get_tile_texel_rect(const QPoint &tile_pos, const int z) const;
 
 	QRect get_rect() const
 	{
@@ -156,6 +163,8 @@ private:
 	std::vector<std::vector<int>> minimap_to_map_y; //fast conversion table
 	std::vector<std::vector<int>> map_to_minimap_x; //fast conversion table
 	std::vector<std::vector<int>> map_to_minimap_y; //fast conversion table
+	std::vector<std::vector<std::pair<int, int>>> tile_texel_columns; //the range of texel columns for each tile column
+	std::vector<std::vector<std::pair<int, int>>> tile_texel_rows; //the range of texel rows for each tile row
 	std::vector<int> minimap_texture_width;
 	std::vector<int> minimap_texture_height;
 public:
@@ -178,6 +187,11 @@ private:
 	std::vector<QImage> overlay_images;
 
 	std::map<minimap_mode, std::vector<QImage>> mode_overlay_images;
+
+	//the map layer and mode for which the overlay was last drawn; switching either redraws it from scratch
+	int overlay_layer = -1;
+	minimap_mode overlay_mode;
+	minimap_overlay_tracker overlay_tracker;
 };
 
 }
@@ -0,0 +1,211 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//the state in which a unit has been drawn on the minimap overlay; if it doesn't change, the unit doesn't need to be redrawn
+struct minimap_unit_draw_state final
+{
+	bool operator ==(const minimap_unit_draw_state &other) const = default;
+
+	QRect rect; //the texels affected by drawing the unit
+	uint32_t color = 0;
+	bool terrain = false; //whether the unit is drawn as a terrain feature, rather than as a unit
+};
+
+//tracks what has been drawn on the minimap overlay, so that updating it only needs to redraw the texels affected by changes
+//units are identified by a small index (e.g. their unit slot), which may be reused by other units afterwards
+class minimap_overlay_tracker final
+{
+public:
+	using unit_state = std::pair<size_t, minimap_unit_draw_state>;
+
+	static constexpr int cell_size = 16;
+
+	//forget the previous state, for when the overlay is going to be redrawn from scratch
+	void clear(const QSize &size)
+	{
+		this->size = size;
+		this->cell_width = (size.width() + cell_size - 1) / cell_size;
+		this->cell_unit_indexes.clear();
+		this->cell_unit_indexes.resize(static_cast<size_t>(this->cell_width * ((size.height() + cell_size - 1) / cell_size)));
+		this->dirty_rects.clear();
+		this->drawn_states.clear();
+		this->drawn_keys.clear();
+	}
+
+	const QSize &get_size() const
+	{
+		return this->size;
+	}
+
+	//mark texels whose background has changed, so that they and the units over them are redrawn
+	void mark_dirty(const QRect &rect)
+	{
+		const QRect clipped_rect = rect.intersected(QRect(QPoint(0, 0), this->size));
+
+		if (clipped_rect.isEmpty()) {
+			return;
+		}
+
+		this->dirty_rects.push_back(clipped_rect);
+	}
+
+	//update the overlay to the given unit states, in drawing order
+	//the restore function is called for each dirty rectangle to redraw its background, and then the draw function for each unit which needs to be redrawn, in order
+	//units which overlap a redrawn area are redrawn as well, so that their drawing order is kept
+	template <typename restore_function_type, typename draw_function_type>
+	void update(const std::vector<unit_state> &unit_states, const restore_function_type &restore_function, const draw_function_type &draw_function)
+	{
+		++this->update_id;
+
+		std::vector<bool> redraw_flags(unit_states.size(), false);
+
+		for (size_t i = 0; i < unit_states.size(); ++i) {
+			const auto &[key, state] = unit_states[i];
+
+			if (key >= this->drawn_states.size()) {
+				this->drawn_states.resize(key + 1);
+			}
+
+			drawn_state &previous_state = this->drawn_states[key];
+
+			if (previous_state.update_id == 0 || previous_state.state != state) {
+				redraw_flags[i] = true;
+				this->mark_dirty(state.rect);
+
+				if (previous_state.update_id != 0) {
+					this->mark_dirty(previous_state.state.rect);
+				} else {
+					this->drawn_keys.push_back(key);
+				}
+
+				previous_state.state = state;
+			}
+
+			previous_state.update_id = this->update_id;
+		}
+
+		//units which have disappeared need their previous texels to be redrawn
+		for (size_t i = 0; i < this->drawn_keys.size();) {
+			drawn_state &previous_state = this->drawn_states[this->drawn_keys[i]];
+
+			if (previous_state.update_id != this->update_id) {
+				this->mark_dirty(previous_state.state.rect);
+				previous_state.update_id = 0;
+				this->drawn_keys[i] = this->drawn_keys.back();
+				this->drawn_keys.pop_back();
+			} else {
+				++i;
+			}
+		}
+
+		if (this->dirty_rects.empty()) {
+			return;
+		}
+
+		//redrawing a unit also clears the texels of other units overlapping it, so those need to be redrawn as well
+		//the dirty rectangles are processed as a worklist, with units found through the cells they overlap
+		for (size_t i = 0; i < unit_states.size(); ++i) {
+			if (redraw_flags[i]) {
+				continue;
+			}
+
+			this->for_each_cell_in_rect(unit_states[i].second.rect, [i](std::vector<size_t> &cell_unit_indexes) {
+				cell_unit_indexes.push_back(i);
+			});
+		}
+
+		for (size_t i = 0; i < this->dirty_rects.size(); ++i) {
+			const QRect dirty_rect = this->dirty_rects[i];
+
+			this->for_each_cell_in_rect(dirty_rect, [this, &dirty_rect, &unit_states, &redraw_flags](const std::vector<size_t> &cell_unit_indexes) {
+				for (const size_t unit_index : cell_unit_indexes) {
+					if (redraw_flags[unit_index]) {
+						continue;
+					}
+
+					const QRect &rect = unit_states[unit_index].second.rect;
+					if (rect.intersects(dirty_rect)) {
+						redraw_flags[unit_index] = true;
+						this->mark_dirty(rect);
+					}
+				}
+			});
+		}
+
+		for (std::vector<size_t> &cell_unit_indexes : this->cell_unit_indexes) {
+			cell_unit_indexes.clear();
+		}
+
+		for (const QRect &dirty_rect : this->dirty_rects) {
+			restore_function(dirty_rect);
+		}
+		this->dirty_rects.clear();
+
+		for (size_t i = 0; i < unit_states.size(); ++i) {
+			if (redraw_flags[i]) {
+				draw_function(unit_states[i].first, unit_states[i].second);
+			}
+		}
+	}
+
+private:
+	template <typename function_type>
+	void for_each_cell_in_rect(const QRect &rect, const function_type &function)
+	{
+		const QRect clipped_rect = rect.intersected(QRect(QPoint(0, 0), this->size));
+
+		if (clipped_rect.isEmpty()) {
+			return;
+		}
+
+		for (int cell_y = clipped_rect.top() / cell_size; cell_y <= clipped_rect.bottom() / cell_size; ++cell_y) {
+			for (int cell_x = clipped_rect.left() / cell_size; cell_x <= clipped_rect.right() / cell_size; ++cell_x) {
+				function(this->cell_unit_indexes[cell_y * this->cell_width + cell_x]);
+			}
+		}
+	}
+
+	struct drawn_state final
+	{
+		minimap_unit_draw_state state;
+		uint64_t update_id = 0; //the last update in which the unit was drawn, or 0 if it isn't drawn
+	};
+
+	QSize size;
+	int cell_width = 0;
+	std::vector<std::vector<size_t>> cell_unit_indexes; //the indexes of the units not yet being redrawn, for each cell of texels
+	std::vector<QRect> dirty_rects;
+	std::vector<drawn_state> drawn_states; //indexed by unit key
+	std::vector<size_t> drawn_keys;
+	uint64_t update_id = 0;
+};
+
+}
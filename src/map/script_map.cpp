@@ -236,6 +236,9 @@ int CclStratagusMap(lua_State *l)
 					}
 					lua_pop(l, 1);
 					//Wyrmgus end
+				} else if (!strcmp(subvalue, "map-fields-in-save-container")) {
+					CMap::get()->load_tiles_from_binary(game::get()->get_loading_save_container_data());
+					--k;
 				} else {
 					LuaError(l, "Unsupported tag: %s" _C_ subvalue);
 				}
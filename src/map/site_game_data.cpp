@@ -37,6 +37,7 @@
 #include "map/minimap.h"
 #include "map/site.h"
 #include "map/tile.h"
+#include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "population/employment_type.h"
 #include "population/population_class.h"
@@ -216,6 +217,9 @@ void site_game_data::set_owner(CPlayer *player)
 
 	this->owner = player;
 
+	//the owner of the territory affects the pathfinding of units avoiding deserts
+	AStarTerritoryOwnerChanged();
+
 	if (this->site->is_settlement()) {
 		if (defines::get()->is_population_enabled()) {
 			if (old_owner != nullptr) {
@@ -48,37 +48,48 @@
 #include "util/string_conversion_util.h"
 #include "util/util.h"
 #include "util/vector_util.h"
+#include "video/graphic_loader.h"
 #include "video/video.h"
 
 namespace wyrmgus {
 
 void terrain_type::LoadTerrainTypeGraphics()
 {
-	for (terrain_type *terrain_type : terrain_type::get_all()) {
-		if (terrain_type->graphics != nullptr) {
-			terrain_type->graphics->Load(preferences::get()->get_scale_factor());
+	std::vector<std::shared_ptr<CGraphic>> graphics;
 
-			if (!terrain_type->minimap_color.isValid()) {
-				terrain_type->calculate_minimap_color();
-			}
+	for (const terrain_type *terrain_type : terrain_type::get_all()) {
+		if (terrain_type->graphics != nullptr) {
+			graphics.push_back(terrain_type->graphics);
 		}
 
 		if (terrain_type->transition_graphics != nullptr) {
-			terrain_type->transition_graphics->Load(preferences::get()->get_scale_factor());
+			graphics.push_back(terrain_type->transition_graphics);
+		}
+
+		for (const auto &kv_pair : terrain_type->season_graphics) {
+			graphics.push_back(kv_pair.second);
+		}
+
+		if (terrain_type->elevation_graphics != nullptr) {
+			graphics.push_back(terrain_type->elevation_graphics);
+		}
+	}
+
+	//all terrain graphics are needed to draw the map, so the game waits for them
+	graphic_loader::get()->load(graphics);
+
+	for (terrain_type *terrain_type : terrain_type::get_all()) {
+		if (terrain_type->graphics != nullptr && !terrain_type->minimap_color.isValid()) {
+			terrain_type->calculate_minimap_color();
 		}
 
 		for (const auto &kv_pair : terrain_type->season_graphics) {
 			const season *season = kv_pair.first;
-			kv_pair.second->Load(preferences::get()->get_scale_factor());
 
 			if (!terrain_type->season_minimap_colors[season].isValid()) {
 				terrain_type->calculate_minimap_color(season);
 			}
 		}
-
-		if (terrain_type->elevation_graphics != nullptr) {
-			terrain_type->elevation_graphics->Load(preferences::get()->get_scale_factor());
-		}
 	}
 }
 
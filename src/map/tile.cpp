@@ -31,6 +31,7 @@
 #include "economy/resource.h"
 //Wyrmgus start
 #include "editor.h"
+#include "game/save_container.h"
 //Wyrmgus end
 #include "iolib.h"
 #include "map/landmass.h"
@@ -41,6 +42,7 @@
 #include "map/terrain_type.h"
 #include "map/tile_flag.h"
 #include "map/tileset.h"
+#include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "script.h"
 #include "unit/unit.h"
@@ -385,6 +387,154 @@ void tile::UpdateSeenTile()
 }
 //Wyrmgus end
 
+struct tile_binary_save_tables final
+{
+	save_identifier_writer<terrain_type> terrain_types;
+	save_identifier_writer<terrain_feature> terrain_features;
+	save_identifier_writer<site> sites;
+};
+
+struct tile_binary_load_tables final
+{
+	save_identifier_reader<terrain_type> terrain_types;
+	save_identifier_reader<terrain_feature> terrain_features;
+	save_identifier_reader<site> sites;
+};
+
+std::string tile::save_tiles_to_binary(const tile *tiles, const size_t count)
+{
+	save_buffer_writer writer;
+	tile_binary_save_tables tables;
+
+	for (size_t i = 0; i < count; ++i) {
+		tiles[i].save_binary(writer, tables);
+	}
+
+	return writer.take_data();
+}
+
+void tile::load_tiles_from_binary(tile *tiles, const size_t count, const std::string_view &data)
+{
+	save_buffer_reader reader(data);
+	tile_binary_load_tables tables;
+
+	for (size_t i = 0; i < count; ++i) {
+		tiles[i].load_binary(reader, tables);
+	}
+
+	if (!reader.is_at_end()) {
+		throw std::runtime_error("Tile save data has more data than expected.");
+	}
+}
+
+void tile::save_binary(save_buffer_writer &writer, tile_binary_save_tables &tables) const
+{
+	//this saves the same data as the Lua save
+	tables.terrain_types.write(writer, this->get_terrain());
+	tables.terrain_types.write(writer, this->get_overlay_terrain());
+	tables.terrain_features.write(writer, this->get_terrain_feature());
+	writer.write_uint8((this->OverlayTerrainDamaged ? 1 : 0) | (this->OverlayTerrainDestroyed ? 2 : 0));
+	tables.terrain_types.write(writer, this->player_info->SeenTerrain);
+	tables.terrain_types.write(writer, this->player_info->SeenOverlayTerrain);
+	writer.write_signed_varint(this->SolidTile);
+	writer.write_signed_varint(this->OverlaySolidTile);
+	writer.write_signed_varint(this->player_info->SeenSolidTile);
+	writer.write_signed_varint(this->player_info->SeenOverlaySolidTile);
+	writer.write_signed_varint(this->get_value());
+	writer.write_varint(this->get_movement_cost());
+	writer.write_signed_varint(this->get_landmass() != nullptr ? static_cast<int64_t>(this->get_landmass()->get_index()) : -1);
+	tables.sites.write(writer, this->get_settlement());
+
+	for (const std::vector<tile_transition> *transition_tiles : { &this->TransitionTiles, &this->OverlayTransitionTiles, &this->player_info->SeenTransitionTiles, &this->player_info->SeenOverlayTransitionTiles }) {
+		writer.write_varint(transition_tiles->size());
+
+		for (const tile_transition &transition : *transition_tiles) {
+			tables.terrain_types.write(writer, transition.terrain);
+			writer.write_signed_varint(transition.tile_frame);
+		}
+	}
+
+	//write the exploration mask, with each player being represented as one bit
+	uint64_t exploration_mask = 0;
+	static_assert(PlayerMax <= 64);
+	for (int i = 0; i < PlayerMax; ++i) {
+		if (this->player_info->get_visibility_state(i) == 1) {
+			exploration_mask |= uint64_t(1) << i;
+		}
+	}
+	writer.write_varint(exploration_mask);
+
+	writer.write_uint32(static_cast<uint32_t>(this->get_flags()));
+}
+
+void tile::load_binary(save_buffer_reader &reader, tile_binary_load_tables &tables)
+{
+	const terrain_type *terrain = tables.terrain_types.read(reader);
+	if (terrain != nullptr) {
+		this->terrain = terrain;
+	}
+
+	const terrain_type *overlay_terrain = tables.terrain_types.read(reader);
+	if (overlay_terrain != nullptr) {
+		this->overlay_terrain = overlay_terrain;
+	}
+
+	const wyrmgus::terrain_feature *terrain_feature = tables.terrain_features.read(reader);
+	if (terrain_feature != nullptr) {
+		this->terrain_feature = terrain_feature;
+	}
+
+	const uint8_t overlay_state = reader.read_uint8();
+	this->SetOverlayTerrainDamaged((overlay_state & 1) != 0);
+	this->SetOverlayTerrainDestroyed((overlay_state & 2) != 0);
+
+	const terrain_type *seen_terrain = tables.terrain_types.read(reader);
+	if (seen_terrain != nullptr) {
+		this->player_info->SeenTerrain = seen_terrain;
+	}
+
+	const terrain_type *seen_overlay_terrain = tables.terrain_types.read(reader);
+	if (seen_overlay_terrain != nullptr) {
+		this->player_info->SeenOverlayTerrain = seen_overlay_terrain;
+	}
+
+	this->SolidTile = static_cast<short>(reader.read_signed_varint());
+	this->OverlaySolidTile = static_cast<short>(reader.read_signed_varint());
+	this->player_info->SeenSolidTile = static_cast<short>(reader.read_signed_varint());
+	this->player_info->SeenOverlaySolidTile = static_cast<short>(reader.read_signed_varint());
+	this->value = static_cast<short>(reader.read_signed_varint());
+	this->movement_cost = static_cast<unsigned char>(reader.read_varint());
+
+	const int64_t landmass_index = reader.read_signed_varint();
+	if (landmass_index != -1) {
+		this->landmass = CMap::get()->get_landmasses().at(landmass_index).get();
+	}
+
+	const site *settlement = tables.sites.read(reader);
+	if (settlement != nullptr) {
+		this->settlement = settlement;
+	}
+
+	for (std::vector<tile_transition> *transition_tiles : { &this->TransitionTiles, &this->OverlayTransitionTiles, &this->player_info->SeenTransitionTiles, &this->player_info->SeenOverlayTransitionTiles }) {
+		const size_t transition_count = static_cast<size_t>(reader.read_varint());
+
+		for (size_t i = 0; i < transition_count; ++i) {
+			const terrain_type *transition_terrain = tables.terrain_types.read(reader);
+			const short tile_frame = static_cast<short>(reader.read_signed_varint());
+			transition_tiles->emplace_back(transition_terrain, tile_frame);
+		}
+	}
+
+	const uint64_t exploration_mask = reader.read_varint();
+	for (int i = 0; i < PlayerMax; ++i) {
+		if ((exploration_mask & (uint64_t(1) << i)) != 0) {
+			this->player_info->get_visibility_state_ref(i) = 1;
+		}
+	}
+
+	this->Flags |= static_cast<tile_flag>(reader.read_uint32());
+}
+
 void tile::Save(CFile &file) const
 {
 	const wyrmgus::terrain_feature *terrain_feature = this->get_terrain_feature();
@@ -775,6 +925,12 @@ void tile::update_movement_cost()
 	if (top_terrain != nullptr) {
 		this->movement_cost -= top_terrain->get_movement_bonus();
 	}
+
+	//the speed of units on the tile depends on its movement cost and flags
+	const CUnitCache &cache = this->UnitCache;
+	for (size_t i = 0; i != cache.size(); ++i) {
+		cache[i]->invalidate_derived_stats();
+	}
 }
 
 bool tile::is_animated() const
@@ -782,6 +938,18 @@ bool tile::is_animated() const
 	return (this->get_terrain() != nullptr && this->get_terrain()->SolidAnimationFrames > 0) || (this->get_overlay_terrain() != nullptr && this->get_overlay_terrain()->SolidAnimationFrames > 0);
 }
 
+void tile::set_settlement(const site *settlement)
+{
+	if (settlement == this->get_settlement()) {
+		return;
+	}
+
+	this->settlement = settlement;
+
+	//the owner of the territory affects the pathfinding of units avoiding deserts
+	AStarTerritoryOwnerChanged();
+}
+
 CPlayer *tile::get_owner() const
 {
 	if (this->get_settlement() == nullptr) {
@@ -125,12 +125,16 @@ namespace wyrmgus {
 class landmass;
 class player_color;
 class resource;
+class save_buffer_reader;
+class save_buffer_writer;
 class site;
 class terrain_feature;
 class terrain_type;
 class tileset;
 class world;
 enum class tile_flag : uint32_t;
+struct tile_binary_load_tables;
+struct tile_binary_save_tables;
 
 class tile_player_info final
 {
@@ -254,9 +258,18 @@ class tile final
 public:
 	tile();
 
+	//save a range of tiles to binary data, and load them from it; each range is self-contained, so that ranges can be processed in parallel
+	static std::string save_tiles_to_binary(const tile *tiles, const size_t count);
+	static void load_tiles_from_binary(tile *tiles, const size_t count, const std::string_view &data);
+
 	void Save(CFile &file) const;
 	void parse(lua_State *l);
 
+private:
+	void save_binary(save_buffer_writer &writer, tile_binary_save_tables &tables) const;
+	void load_binary(save_buffer_reader &reader, tile_binary_load_tables &tables);
+
+public:
 	//Wyrmgus start
 	void SetTerrain(const terrain_type *terrain_type);
 	void RemoveOverlayTerrain();
@@ -410,14 +423,7 @@ public:
 		return this->settlement;
 	}
 
-	void set_settlement(const site *settlement)
-	{
-		if (settlement == this->get_settlement()) {
-			return;
-		}
-
-		this->settlement = settlement;
-	}
+	void set_settlement(const site *settlement);
 
 	bool is_on_trade_route() const;
 
@@ -0,0 +1,161 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/thread_pool.h"
+
+namespace wyrmgus {
+
+//a flag for each tile of a map rect, ordered column by column, as the tiles are visited when adjusting the terrain of a rect
+//used to check the tiles of a rect in parallel, and then to track which tiles have been changed while applying the results in order
+class tile_rect_flags final
+{
+public:
+	static constexpr int columns_per_band = 16;
+	static constexpr int min_parallel_tile_count = 4096; //smaller rects are checked on the calling thread only
+
+	explicit tile_rect_flags(const QRect &rect)
+		: rect(rect), flags(static_cast<size_t>(std::max(rect.width(), 0) * std::max(rect.height(), 0)), 0)
+	{
+	}
+
+	bool get(const QPoint &pos) const
+	{
+		return this->flags[this->get_index(pos)] != 0;
+	}
+
+	void set(const QPoint &pos)
+	{
+		this->flags[this->get_index(pos)] = 1;
+		this->any_set = true;
+	}
+
+	void clear()
+	{
+		if (!this->any_set) {
+			return;
+		}
+
+		std::fill(this->flags.begin(), this->flags.end(), 0);
+		this->any_set = false;
+	}
+
+	//whether the flag is set for the tile, or for any tile adjacent to it in the rect
+	bool is_set_in_neighborhood(const QPoint &pos) const
+	{
+		if (!this->any_set) {
+			return false;
+		}
+
+		const int min_x = std::max(pos.x() - 1, this->rect.left());
+		const int max_x = std::min(pos.x() + 1, this->rect.right());
+		const int min_y = std::max(pos.y() - 1, this->rect.top());
+		const int max_y = std::min(pos.y() + 1, this->rect.bottom());
+
+		for (int x = min_x; x <= max_x; ++x) {
+			for (int y = min_y; y <= max_y; ++y) {
+				if (this->get(QPoint(x, y))) {
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	//set the flag of each tile for which the predicate returns true; bands of columns are checked in parallel, so the predicate must only read data
+	template <typename predicate_type>
+	void set_if(const predicate_type &predicate)
+	{
+		if (this->flags.empty()) {
+			return;
+		}
+
+		const int band_count = (this->rect.width() + tile_rect_flags::columns_per_band - 1) / tile_rect_flags::columns_per_band;
+		std::atomic<int> next_band = 0;
+		std::atomic<bool> any_set_in_bands = false;
+
+		const auto check_bands = [this, &predicate, band_count, &next_band, &any_set_in_bands]() {
+			while (true) {
+				const int band = next_band.fetch_add(1);
+				if (band >= band_count) {
+					break;
+				}
+
+				const int start_x = this->rect.left() + band * tile_rect_flags::columns_per_band;
+				const int end_x = std::min(start_x + tile_rect_flags::columns_per_band, this->rect.right() + 1);
+
+				for (int x = start_x; x < end_x; ++x) {
+					for (int y = this->rect.top(); y <= this->rect.bottom(); ++y) {
+						const QPoint tile_pos(x, y);
+
+						if (predicate(tile_pos)) {
+							this->flags[this->get_index(tile_pos)] = 1;
+							any_set_in_bands = true;
+						}
+					}
+				}
+			}
+		};
+
+		size_t worker_count = 1;
+		if (this->flags.size() >= tile_rect_flags::min_parallel_tile_count) {
+			worker_count = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), static_cast<size_t>(band_count));
+		}
+
+		std::vector<std::future<void>> futures;
+		for (size_t i = 1; i < worker_count; ++i) {
+			futures.push_back(thread_pool::get()->co_spawn_future([&check_bands]() -> boost::asio::awaitable<void> {
+				check_bands();
+				co_return;
+			}));
+		}
+
+		check_bands();
+
+		for (std::future<void> &future : futures) {
+			future.get();
+		}
+
+		if (any_set_in_bands) {
+			this->any_set = true;
+		}
+	}
+
+private:
+	size_t get_index(const QPoint &pos) const
+	{
+		return static_cast<size_t>((pos.x() - this->rect.left()) * this->rect.height() + pos.y() - this->rect.top());
+	}
+
+	QRect rect;
+	std::vector<uint8_t> flags; //bytes rather than bits, so that different threads can set adjacent flags
+	bool any_set = false;
+};
+
+}
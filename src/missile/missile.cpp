@@ -63,10 +63,12 @@
 #include "unit/unit_ref.h"
 #include "unit/unit_type.h"
 #include "util/assert_util.h"
+#include "util/object_pool.h"
 #include "util/point_util.h"
 #include "util/string_conversion_util.h"
 #include "util/util.h"
 #include "video/font.h"
+#include "video/graphic_loader.h"
 #include "video/video.h"
 
 #ifdef __MORPHOS__
@@ -75,8 +77,9 @@
 
 unsigned int Missile::Count = 0;
 
-static std::vector<std::unique_ptr<Missile>> GlobalMissiles;    /// all global missiles on map
-static std::vector<std::unique_ptr<Missile>> LocalMissiles;     /// all local missiles on map
+static wyrmgus::object_pool<Missile> MissilePool;  /// storage of all missiles
+static std::vector<Missile *> GlobalMissiles;    /// all global missiles on map, in creation order
+static std::vector<Missile *> LocalMissiles;     /// all local missiles on map, in creation order
 
 std::vector<std::unique_ptr<BurningBuildingFrame>> BurningBuildingFrames; /// Burning building frames
 
@@ -173,13 +176,18 @@ void missile_type::LoadMissileSprite()
 	if (this->G && !this->G->IsLoaded()) {
 		this->G->Load(preferences::get()->get_scale_factor());
 
-		// Correct the number of frames in graphic
-		assert_throw(this->G->NumFrames >= this->get_frames());
-		this->G->NumFrames = this->get_frames();
-		// FIXME: Don't use NumFrames as number of frames.
+		this->correct_graphic_frame_count();
 	}
 }
 
+void missile_type::correct_graphic_frame_count()
+{
+	// Correct the number of frames in graphic
+	assert_throw(this->G->NumFrames >= this->get_frames());
+	this->G->NumFrames = this->get_frames();
+	// FIXME: Don't use NumFrames as number of frames.
+}
+
 }
 
 int GetMissileSpritesCount()
@@ -197,8 +205,28 @@ int GetMissileSpritesCount()
 void LoadMissileSprites()
 {
 #ifndef DYNAMIC_LOAD
+	std::vector<std::shared_ptr<CGraphic>> graphics;
+	std::vector<wyrmgus::missile_type *> loaded_missile_types;
+	std::set<const CGraphic *> graphic_set;
+
 	for (wyrmgus::missile_type *missile_type : wyrmgus::missile_type::get_all()) {
-		missile_type->LoadMissileSprite();
+		if (missile_type->G == nullptr || missile_type->G->IsLoaded()) {
+			continue;
+		}
+
+		//the frame count of a graphic shared by several missile types is corrected for the first of them, as when loading them one by one
+		if (!graphic_set.insert(missile_type->G.get()).second) {
+			continue;
+		}
+
+		graphics.push_back(missile_type->G);
+		loaded_missile_types.push_back(missile_type);
+	}
+
+	wyrmgus::graphic_loader::get()->load(graphics);
+
+	for (wyrmgus::missile_type *missile_type : loaded_missile_types) {
+		missile_type->correct_graphic_frame_count();
 	}
 #endif
 }
@@ -226,64 +254,64 @@ Missile::Missile()
 **
 **  @return       created missile.
 */
-std::unique_ptr<Missile> Missile::Init(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z)
+Missile *Missile::Init(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z)
 {
-	std::unique_ptr<Missile> missile;
+	Missile *missile = nullptr;
 
 	switch (mtype.get_missile_class()) {
 		case wyrmgus::missile_class::none:
-			missile = std::make_unique<MissileNone>();
+			missile = MissilePool.create<MissileNone>();
 			break;
 		case wyrmgus::missile_class::point_to_point:
-			missile = std::make_unique<MissilePointToPoint>();
+			missile = MissilePool.create<MissilePointToPoint>();
 			break;
 		case wyrmgus::missile_class::point_to_point_with_hit:
-			missile = std::make_unique<MissilePointToPointWithHit>();
+			missile = MissilePool.create<MissilePointToPointWithHit>();
 			break;
 		case wyrmgus::missile_class::point_to_point_cycle_once:
-			missile = std::make_unique<MissilePointToPointCycleOnce>();
+			missile = MissilePool.create<MissilePointToPointCycleOnce>();
 			break;
 		case wyrmgus::missile_class::point_to_point_bounce:
-			missile = std::make_unique<MissilePointToPointBounce>();
+			missile = MissilePool.create<MissilePointToPointBounce>();
 			break;
 		case wyrmgus::missile_class::stay:
-			missile = std::make_unique<MissileStay>();
+			missile = MissilePool.create<MissileStay>();
 			break;
 		case wyrmgus::missile_class::cycle_once:
-			missile = std::make_unique<MissileCycleOnce>();
+			missile = MissilePool.create<MissileCycleOnce>();
 			break;
 		case wyrmgus::missile_class::fire:
-			missile = std::make_unique<MissileFire>();
+			missile = MissilePool.create<MissileFire>();
 			break;
 		case wyrmgus::missile_class::hit:
-			missile = std::make_unique<::MissileHit>();
+			missile = MissilePool.create<::MissileHit>();
 			break;
 		case wyrmgus::missile_class::parabolic:
-			missile = std::make_unique<MissileParabolic>();
+			missile = MissilePool.create<MissileParabolic>();
 			break;
 		case wyrmgus::missile_class::land_mine:
-			missile = std::make_unique<MissileLandMine>();
+			missile = MissilePool.create<MissileLandMine>();
 			break;
 		case wyrmgus::missile_class::whirlwind:
-			missile = std::make_unique<MissileWhirlwind>();
+			missile = MissilePool.create<MissileWhirlwind>();
 			break;
 		case wyrmgus::missile_class::flame_shield:
-			missile = std::make_unique<MissileFlameShield>();
+			missile = MissilePool.create<MissileFlameShield>();
 			break;
 		case wyrmgus::missile_class::death_coil:
-			missile = std::make_unique<MissileDeathCoil>();
+			missile = MissilePool.create<MissileDeathCoil>();
 			break;
 		case wyrmgus::missile_class::tracer:
-			missile = std::make_unique<MissileTracer>();
+			missile = MissilePool.create<MissileTracer>();
 			break;
 		case wyrmgus::missile_class::clip_to_target:
-			missile = std::make_unique<MissileClipToTarget>();
+			missile = MissilePool.create<MissileClipToTarget>();
 			break;
 		case wyrmgus::missile_class::continuous:
-			missile = std::make_unique<wyrmgus::missile_continuous>();
+			missile = MissilePool.create<wyrmgus::missile_continuous>();
 			break;
 		case wyrmgus::missile_class::straight_fly:
-			missile = std::make_unique<MissileStraightFly>();
+			missile = MissilePool.create<MissileStraightFly>();
 			break;
 	}
 	const PixelPos halfSize = mtype.get_frame_size() / 2;
@@ -318,10 +346,9 @@ std::unique_ptr<Missile> Missile::Init(const wyrmgus::missile_type &mtype, const
 */
 Missile *MakeMissile(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z)
 {
-	std::unique_ptr<Missile> missile = Missile::Init(mtype, startPos, destPos, z);
-	Missile *missile_ptr = missile.get();
-	GlobalMissiles.push_back(std::move(missile));
-	return missile_ptr;
+	Missile *missile = Missile::Init(mtype, startPos, destPos, z);
+	GlobalMissiles.push_back(missile);
+	return missile;
 }
 
 /**
@@ -335,11 +362,10 @@ Missile *MakeMissile(const wyrmgus::missile_type &mtype, const PixelPos &startPo
 */
 Missile *MakeLocalMissile(const wyrmgus::missile_type &mtype, const PixelPos &startPos, const PixelPos &destPos, int z)
 {
-	std::unique_ptr<Missile> missile = Missile::Init(mtype, startPos, destPos, z);
+	Missile *missile = Missile::Init(mtype, startPos, destPos, z);
 	missile->Local = 1;
-	Missile *missile_ptr = missile.get();
-	LocalMissiles.push_back(std::move(missile));
-	return missile_ptr;
+	LocalMissiles.push_back(missile);
+	return missile;
 }
 
 /**
@@ -880,7 +906,7 @@ namespace wyrmgus {
 **  @param frame  Animation frame
 **  @param pos    Screen pixel position
 */
-void missile_type::DrawMissileType(int frame, const PixelPos &pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void missile_type::DrawMissileType(int frame, const PixelPos &pos, render_command_buffer &render_commands) const
 {
 #ifdef DYNAMIC_LOAD
 	if (!this->G->IsLoaded()) {
@@ -923,7 +949,7 @@ void missile_type::DrawMissileType(int frame, const PixelPos &pos, std::vector<s
 /**
 **  Draw missile.
 */
-void Missile::DrawMissile(const CViewport &vp, std::vector<std::function<void(renderer *)>> &render_commands) const
+void Missile::DrawMissile(const CViewport &vp, render_command_buffer &render_commands) const
 {
 	assert_throw(this->Type != nullptr);
 	CUnit *sunit = this->get_source_unit();
@@ -966,7 +992,7 @@ static bool MissileDrawLevelCompare(const Missile *const l, const Missile *const
 */
 void FindAndSortMissiles(const CViewport &vp, std::vector<Missile *> &table)
 {
-	typedef std::vector<std::unique_ptr<Missile>>::const_iterator MissilePtrConstiterator;
+	typedef std::vector<Missile *>::const_iterator MissilePtrConstiterator;
 
 	// Loop through global missiles, then through locals.
 	for (MissilePtrConstiterator i = GlobalMissiles.begin(); i != GlobalMissiles.end(); ++i) {
@@ -1677,39 +1703,58 @@ void Missile::NextMissileFrameCycle()
 	}
 }
 
+/**
+**  Destroy a missile, returning its slot to the missile pool.
+**
+**  @param missile  Missile to destroy.
+*/
+static void DestroyMissile(Missile *missile)
+{
+	MissilePool.destroy(missile);
+}
+
 /**
 **  Handle all missile actions of global/local missiles.
 **
+**  Expired missiles are destroyed right away, but only removed from the
+**  table after the loop, in a single pass which keeps the order of the rest.
+**
 **  @param missiles  Table of missiles.
 */
-static void MissilesActionLoop(std::vector<std::unique_ptr<Missile>> &missiles)
+static void MissilesActionLoop(std::vector<Missile *> &missiles)
 {
-	for (size_t i = 0; i != missiles.size(); /* empty */) {
+	bool has_expired_missiles = false;
+
+	for (size_t i = 0; i != missiles.size(); ++i) {
 		Missile &missile = *missiles[i];
 
 		if (missile.Delay) {
 			missile.Delay--;
-			++i;
 			continue;  // delay start of missile
 		}
 		if (missile.TTL > 0) {
 			missile.TTL--;  // overall time to live if specified
 		}
 		if (missile.TTL == 0) {
-			missiles.erase(missiles.begin() + i);
+			DestroyMissile(missiles[i]);
+			missiles[i] = nullptr;
+			has_expired_missiles = true;
 			continue;
 		}
 		assert_throw(missile.Wait != 0);
 		if (--missile.Wait) {  // wait until time is over
-			++i;
 			continue;
 		}
 		missile.Action(); // may create other missiles, and so modifies the array
 		if (missile.TTL == 0) {
-			missiles.erase(missiles.begin() + i);
-			continue;
+			DestroyMissile(missiles[i]);
+			missiles[i] = nullptr;
+			has_expired_missiles = true;
 		}
-		++i;
+	}
+
+	if (has_expired_missiles) {
+		std::erase(missiles, nullptr);
 	}
 }
 
@@ -1812,10 +1857,10 @@ void SaveMissiles(CFile &file)
 	file.printf("\n--- -----------------------------------------\n");
 	file.printf("--- MODULE: missiles\n\n");
 
-	for (const std::unique_ptr<Missile> &missile : GlobalMissiles) {
+	for (const Missile *missile : GlobalMissiles) {
 		missile->SaveMissile(file);
 	}
-	for (const std::unique_ptr<Missile> &missile : LocalMissiles) {
+	for (const Missile *missile : LocalMissiles) {
 		missile->SaveMissile(file);
 	}
 }
@@ -1871,7 +1916,14 @@ Missile::~Missile()
 */
 void CleanMissiles()
 {
+	for (Missile *missile : GlobalMissiles) {
+		DestroyMissile(missile);
+	}
 	GlobalMissiles.clear();
+
+	for (Missile *missile : LocalMissiles) {
+		DestroyMissile(missile);
+	}
 	LocalMissiles.clear();
 }
 
@@ -466,6 +466,44 @@ size_t CNetworkExtendedCommand::Deserialize(const unsigned char *buf)
 	return p - buf;
 }
 
+// CNetworkGroupCommand
+
+size_t CNetworkGroupCommand::Serialize(unsigned char *buf) const
+{
+	unsigned char *p = buf;
+	p += serialize8(p, this->Type);
+	p += serialize16(p, this->X);
+	p += serialize16(p, this->Y);
+	p += serialize16(p, this->Dest);
+	p += serialize16(p, uint16_t(this->Units.size()));
+	for (size_t i = 0; i != this->Units.size(); ++i) {
+		p += serialize16(p, this->Units[i]);
+	}
+	return p - buf;
+}
+
+size_t CNetworkGroupCommand::Deserialize(const unsigned char *buf)
+{
+	const unsigned char *p = buf;
+
+	uint16_t size;
+	p += deserialize8(p, &this->Type);
+	p += deserialize16(p, &this->X);
+	p += deserialize16(p, &this->Y);
+	p += deserialize16(p, &this->Dest);
+	p += deserialize16(p, &size);
+	this->Units.resize(size);
+	for (size_t i = 0; i != this->Units.size(); ++i) {
+		p += deserialize16(p, &this->Units[i]);
+	}
+	return p - buf;
+}
+
+size_t CNetworkGroupCommand::Size() const
+{
+	return 1 + 2 + 2 + 2 + 2 + 2 * this->Units.size();
+}
+
 // CNetworkChat
 
 size_t CNetworkChat::Serialize(unsigned char *buf) const
@@ -32,6 +32,7 @@
 #include "network/multiplayer_setup.h"
 
 constexpr int MaxNetworkCommands = 9;  /// Max Commands In A Packet
+constexpr int MaxNetworkGroupCommandUnits = 48;  /// Max units in a group command, so that a packet full of group commands still fits in the receive buffer
 
 /**
 **  Network init config message subtypes (menu state machine).
@@ -288,6 +289,7 @@ enum _message_type_ {
 	//Wyrmgus end
 
 	MessageExtendedCommand,        /// Command is the next byte
+	MessageGroupCommand,           /// Unit command for several units, the unit command type is the next byte (added in network protocol revision 1)
 
 	// ATTN: __MUST__ be last due to spellid encoding!!!
 	MessageCommandSpellCast        /// Unit command spell cast
@@ -343,6 +345,27 @@ public:
 	uint16_t Arg4;          /// Argument 4
 };
 
+/**
+**  Network command message for a group of units.
+**
+**  Carries the same unit command (with the same target) for several units,
+**  instead of sending one command per unit.
+*/
+class CNetworkGroupCommand
+{
+public:
+	size_t Serialize(unsigned char *buf) const;
+	size_t Deserialize(const unsigned char *buf);
+	size_t Size() const;
+
+public:
+	uint8_t Type = 0;             /// Unit command type
+	uint16_t X = 0;               /// Map position X
+	uint16_t Y = 0;               /// Map position Y
+	uint16_t Dest = 0;            /// Destination unit
+	std::vector<uint16_t> Units;  /// Units which receive the command
+};
+
 /**
 **  Network chat message.
 */
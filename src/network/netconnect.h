@@ -41,14 +41,16 @@ constexpr int NetworkProtocolMajorVersion = StratagusMajorVersion;
 constexpr int NetworkProtocolMinorVersion = StratagusMinorVersion;
 /// Network protocol patch level (maximum 99)
 constexpr int NetworkProtocolPatchLevel = StratagusPatchLevel;
-/// Network protocol version (1,2,3) -> 10203
-constexpr int NetworkProtocolVersion = (NetworkProtocolMajorVersion * 10000 + NetworkProtocolMinorVersion * 100 + \
-	NetworkProtocolPatchLevel);
+/// Network protocol revision (maximum 99), to be increased whenever the network messages change within the same engine version
+constexpr int NetworkProtocolRevision = 1;
+/// Network protocol version (1,2,3,4) -> 1020304
+constexpr int NetworkProtocolVersion = (NetworkProtocolMajorVersion * 1000000 + NetworkProtocolMinorVersion * 10000 + \
+	NetworkProtocolPatchLevel * 100 + NetworkProtocolRevision);
 
 /// Network protocol printf format string
-#define NetworkProtocolFormatString "%d.%d.%d"
+#define NetworkProtocolFormatString "%d.%d.%d.%d"
 /// Network protocol printf format arguments
-#define NetworkProtocolFormatArgs(v) (v) / 10000, ((v) / 100) % 100, (v) % 100
+#define NetworkProtocolFormatArgs(v) (v) / 1000000, ((v) / 10000) % 100, ((v) / 100) % 100, (v) % 100
 
 // received nothing from client for xx frames?
 constexpr int CLIENT_LIVE_BEAT = 60;
@@ -234,34 +234,6 @@
 
 #include <cstddef>
 
-/**
-**  Network command input/output queue.
-*/
-class CNetworkCommandQueue final
-{
-public:
-	void Clear()
-	{
-		this->Time = this->Type = 0;
-		this->Data.clear();
-	}
-
-	bool operator == (const CNetworkCommandQueue &rhs) const
-	{
-		return Time == rhs.Time && Type == rhs.Type && Data == rhs.Data;
-	}
-
-	bool operator != (const CNetworkCommandQueue &rhs) const
-	{
-		return !(*this == rhs);
-	}
-
-public:
-	unsigned long Time = 0;    /// time to execute
-	unsigned char Type = 0;    /// Command Type
-	std::vector<unsigned char> Data;  /// command content (network format)
-};
-
 CNetworkParameter CNetworkParameter::Instance;
 
 CNetworkParameter::CNetworkParameter()
@@ -298,10 +270,15 @@ public:
 	void print() const
 	{
 		DebugPrint("resent: %d packets\n" _C_ resentPacketCount);
+		DebugPrint("group commands: %u for %u units, %u bytes (%u bytes as unit commands)\n" _C_ groupCommandCount _C_ groupCommandUnitCount _C_ groupCommandBytes _C_ groupCommandUnitCommandBytes);
 	}
 
 public:
 	unsigned int resentPacketCount = 0;
+	unsigned int groupCommandCount = 0;            /// Group commands sent
+	unsigned int groupCommandUnitCount = 0;        /// Units in the group commands sent
+	unsigned int groupCommandBytes = 0;            /// Bytes used by the group commands sent
+	unsigned int groupCommandUnitCommandBytes = 0; /// Bytes the group commands would have used if sent as one command per unit
 };
 
 static CNetworkStat NetworkStat;
@@ -700,11 +677,8 @@ static boost::asio::awaitable<void> ParseResendCommand(const CNetworkPacket &pac
 	}
 }
 
-static bool IsAValidCommand_Command(const CNetworkPacket &packet, int index, const int player)
+static bool IsAValidCommandUnit(const unsigned int slot, const int player)
 {
-	CNetworkCommand nc;
-	nc.Deserialize(&packet.Command[index][0]);
-	const unsigned int slot = nc.Unit;
 	const CUnit *unit = slot < wyrmgus::unit_manager::get()->GetUsedSlotCount() ? &wyrmgus::unit_manager::get()->GetSlotUnit(slot) : nullptr;
 
 	if (unit && (unit->Player->get_index() == player
@@ -715,6 +689,45 @@ static bool IsAValidCommand_Command(const CNetworkPacket &packet, int index, con
 	}
 }
 
+static bool IsAValidCommand_Command(const CNetworkPacket &packet, int index, const int player)
+{
+	CNetworkCommand nc;
+	nc.Deserialize(&packet.Command[index][0]);
+	return IsAValidCommandUnit(nc.Unit, player);
+}
+
+static bool IsAValidCommand_GroupCommand(const CNetworkPacket &packet, int index, const int player)
+{
+	CNetworkGroupCommand ngc;
+	ngc.Deserialize(&packet.Command[index][0]);
+
+	if (ngc.Units.empty() || ngc.Units.size() > MaxNetworkGroupCommandUnits) {
+		return false;
+	}
+
+	switch (ngc.Type) {
+		case MessageNone:
+		case MessageSync:
+		case MessageSelection:
+		case MessageQuit:
+		case MessageResend:
+		case MessageChat:
+		case MessageCommandDismiss:
+		case MessageExtendedCommand:
+		case MessageGroupCommand:
+			return false;
+		default:
+			break;
+	}
+
+	for (const uint16_t slot : ngc.Units) {
+		if (!IsAValidCommandUnit(slot, player)) {
+			return false;
+		}
+	}
+	return true;
+}
+
 static bool IsAValidCommand_Dismiss(const CNetworkPacket &packet, int index, const int player)
 {
 	CNetworkCommand nc;
@@ -739,6 +752,7 @@ static bool IsAValidCommand(const CNetworkPacket &packet, int index, const int p
 		case MessageChat:      // FIXME: ensure it's from the right player
 			return true;
 		case MessageCommandDismiss: return IsAValidCommand_Dismiss(packet, index, player);
+		case MessageGroupCommand: return IsAValidCommand_GroupCommand(packet, index, player);
 		default: return IsAValidCommand_Command(packet, index, player);
 	}
 	// FIXME: not all values in nc have been validated
@@ -962,6 +976,22 @@ static void NetworkExecCommand_ExtendedCommand(const CNetworkCommandQueue &ncq)
 						nec.Arg1, nec.Arg2, nec.Arg3, nec.Arg4);
 }
 
+static void NetworkExecCommand_GroupCommand(const CNetworkCommandQueue &ncq)
+{
+	assert_throw((ncq.Type & 0x7F) == MessageGroupCommand);
+	CNetworkGroupCommand ngc;
+
+	ngc.Deserialize(&ncq.Data[0]);
+	const unsigned char msgnr = ngc.Type | (ncq.Type & 0x80);
+
+	//the units are given their orders in the order in which they were issued, so that the result is the same as for individual commands
+	BeginCommandLogGroup();
+	for (const uint16_t slot : ngc.Units) {
+		ExecCommand(msgnr, slot, ngc.X, ngc.Y, ngc.Dest);
+	}
+	EndCommandLogGroup();
+}
+
 static void NetworkExecCommand_Command(const CNetworkCommandQueue &ncq)
 {
 	CNetworkCommand nc;
@@ -983,6 +1013,7 @@ static void NetworkExecCommand(const CNetworkCommandQueue &ncq)
 		case MessageChat: NetworkExecCommand_Chat(ncq); break;
 		case MessageQuit: NetworkExecCommand_Quit(ncq); break;
 		case MessageExtendedCommand: NetworkExecCommand_ExtendedCommand(ncq); break;
+		case MessageGroupCommand: NetworkExecCommand_GroupCommand(ncq); break;
 		case MessageNone:
 			// Nothing to Do, This Message Should Never be Executed
 			assert_throw(false);
@@ -991,6 +1022,95 @@ static void NetworkExecCommand(const CNetworkCommandQueue &ncq)
 	}
 }
 
+/**
+**  Whether a queued command is a unit command which can be sent as part of a group command.
+**
+**  @param ncq  Network command from queue
+*/
+static bool IsGroupableCommand(const CNetworkCommandQueue &ncq)
+{
+	switch (ncq.Type & 0x7F) {
+		case MessageNone:
+		case MessageSync:
+		case MessageSelection:
+		case MessageQuit:
+		case MessageResend:
+		case MessageChat:
+		case MessageExtendedCommand:
+		case MessageGroupCommand:
+		case MessageCommandDismiss: // has its own validation rules
+			return false;
+		default:
+			return true;
+	}
+}
+
+/**
+**  Take the next command from the input queue.
+**
+**  Consecutive unit commands which give the same order to different units
+**  (e.g. all units of a selection being told to move to the same position)
+**  are merged into a single group command.
+**
+**  @param commands  Queue of the commands to be sent, which must not be empty
+**
+**  @return  The command to be sent.
+*/
+CNetworkCommandQueue PopNetworkCommand(std::deque<CNetworkCommandQueue> &commands)
+{
+	CNetworkCommandQueue ncq = std::move(commands.front());
+	commands.pop_front();
+
+	if (!IsGroupableCommand(ncq)) {
+		return ncq;
+	}
+
+	CNetworkCommand nc;
+	nc.Deserialize(&ncq.Data[0]);
+
+	CNetworkGroupCommand ngc;
+	ngc.Type = ncq.Type & 0x7F;
+	ngc.X = nc.X;
+	ngc.Y = nc.Y;
+	ngc.Dest = nc.Dest;
+	ngc.Units.push_back(nc.Unit);
+
+	while (!commands.empty() && ngc.Units.size() < MaxNetworkGroupCommandUnits) {
+		const CNetworkCommandQueue &next_ncq = commands.front();
+		if (next_ncq.Type != ncq.Type) {
+			break;
+		}
+
+		CNetworkCommand next_nc;
+		next_nc.Deserialize(&next_ncq.Data[0]);
+		if (next_nc.X != nc.X || next_nc.Y != nc.Y || next_nc.Dest != nc.Dest) {
+			break;
+		}
+
+		ngc.Units.push_back(next_nc.Unit);
+		commands.pop_front();
+	}
+
+	if (ngc.Units.size() == 1) {
+		return ncq;
+	}
+
+	CNetworkCommandQueue group_ncq;
+	group_ncq.Time = ncq.Time;
+	group_ncq.Type = MessageGroupCommand | (ncq.Type & 0x80);
+	group_ncq.Data.resize(ngc.Size());
+	ngc.Serialize(&group_ncq.Data[0]);
+
+#ifdef DEBUG
+	++NetworkStat.groupCommandCount;
+	NetworkStat.groupCommandUnitCount += static_cast<unsigned int>(ngc.Units.size());
+	NetworkStat.groupCommandBytes += static_cast<unsigned int>(serialize(nullptr, group_ncq.Data));
+	NetworkStat.groupCommandUnitCommandBytes += static_cast<unsigned int>(ngc.Units.size() * serialize(nullptr, ncq.Data));
+#endif
+
+	return group_ncq;
+}
+
 /**
 **  Network send commands.
 */
@@ -1025,10 +1145,9 @@ static boost::asio::awaitable<void> NetworkSendCommands(unsigned long gameNetCyc
 				}
 			}
 #endif
-			ncq[numcommands] = incommand;
+			ncq[numcommands] = PopNetworkCommand(CommandsIn);
 			ncq[numcommands].Time = gameNetCycle;
 			++numcommands;
-			CommandsIn.pop_front();
 		}
 		while (!MsgCommandsIn.empty() && numcommands < MaxNetworkCommands) {
 			const CNetworkCommandQueue &incommand = MsgCommandsIn.front();
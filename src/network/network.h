@@ -56,6 +56,34 @@ public:
 	static CNetworkParameter Instance;
 };
 
+/**
+**  Network command input/output queue.
+*/
+class CNetworkCommandQueue final
+{
+public:
+	void Clear()
+	{
+		this->Time = this->Type = 0;
+		this->Data.clear();
+	}
+
+	bool operator == (const CNetworkCommandQueue &rhs) const
+	{
+		return Time == rhs.Time && Type == rhs.Type && Data == rhs.Data;
+	}
+
+	bool operator != (const CNetworkCommandQueue &rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+public:
+	unsigned long Time = 0;    /// time to execute
+	unsigned char Type = 0;    /// Command Type
+	std::vector<unsigned char> Data;  /// command content (network format)
+};
+
 extern bool NetworkInSync;        /// Network is in sync
 
 extern bool IsNetworkGame();
@@ -85,5 +113,7 @@ extern void NetworkSendExtendedCommand(int command, int arg1, int arg2,
 									   int arg3, int arg4, int status);
 /// Send Selections to Team
 extern void NetworkSendSelection(CUnit * const *units, int count);
+/// Take the next command to be sent from a queue, merging consecutive unit commands with the same order into a group command
+extern CNetworkCommandQueue PopNetworkCommand(std::deque<CNetworkCommandQueue> &commands);
 
 extern void NetworkCclRegister();
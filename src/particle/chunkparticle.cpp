@@ -90,7 +90,7 @@ bool CChunkParticle::isVisible(const CViewport &vp) const
 	//Wyrmgus end
 }
 
-void CChunkParticle::draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CChunkParticle::draw(render_command_buffer &render_commands) const
 {
 	CPosition screenPos = ParticleManager.getScreenPos(pos);
 	screenPos.y = calculateScreenPos(screenPos.y, height);
@@ -46,7 +46,7 @@ GraphicAnimation::GraphicAnimation(CGraphic *g, int ticksPerFrame) :
 }
 
 
-void GraphicAnimation::draw(int x, int y, std::vector<std::function<void(renderer *)>> &render_commands) const
+void GraphicAnimation::draw(int x, int y, render_command_buffer &render_commands) const
 {
 	if (!isFinished()) {
 		g->DrawFrameClip(currentFrame, x - g->Width / 2, y - g->Height / 2, render_commands);
@@ -62,7 +62,7 @@ bool CRadialParticle::isVisible(const CViewport &vp) const
 	//Wyrmgus end
 }
 
-void CRadialParticle::draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CRadialParticle::draw(render_command_buffer &render_commands) const
 {
 	CPosition screenPos = ParticleManager.getScreenPos(pos);
 	animation->draw(static_cast<int>(screenPos.x), static_cast<int>(screenPos.y), render_commands);
@@ -59,7 +59,7 @@ bool CSmokeParticle::isVisible(const CViewport &vp) const
 	//Wyrmgus end
 }
 
-void CSmokeParticle::draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void CSmokeParticle::draw(render_command_buffer &render_commands) const
 {
 	CPosition screenPos = ParticleManager.getScreenPos(pos);
 	puff->draw(static_cast<int>(screenPos.x), static_cast<int>(screenPos.y), render_commands);
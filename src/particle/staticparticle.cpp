@@ -54,7 +54,7 @@ bool StaticParticle::isVisible(const CViewport &vp) const
 	//Wyrmgus end
 }
 
-void StaticParticle::draw(std::vector<std::function<void(renderer *)>> &render_commands) const
+void StaticParticle::draw(render_command_buffer &render_commands) const
 {
 	CPosition screenPos = ParticleManager.getScreenPos(pos);
 	animation->draw(static_cast<int>(screenPos.x), static_cast<int>(screenPos.y), render_commands);
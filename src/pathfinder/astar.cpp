@@ -29,11 +29,16 @@
 
 #include "pathfinder/pathfinder.h"
 
+#include "pathfinder/astar_open_list.h"
+#include "pathfinder/cluster_graph.h"
+#include "pathfinder/flow_field.h"
+
 #include "map/map.h"
 #include "map/map_info.h"
 #include "map/map_layer.h"
 #include "map/tile.h"
 #include "map/tile_flag.h"
+#include "player/player.h"
 #include "settings.h"
 #include "time/time_of_day.h"
 #include "unit/unit.h"
@@ -48,8 +53,6 @@
 #include "util/util.h"
 #include "util/vector_util.h"
 
-#include <boost/container/flat_set.hpp>
-
 struct Node {
 	int CostFromStart = 0;  /// Real costs to reach this point
 	short int CostToGoal = 0;     /// Estimated cost to goal
@@ -63,17 +66,9 @@ std::array<std::vector<int>, 9> Heading2O;//heading to offset
 //Wyrmgus end
 static constexpr std::array<std::array<int, 3>, 3> XY2Heading = { { {7, 6, 5}, {0, 0, 4}, {1, 2, 3} } };
 
-/// cost matrix
-//Wyrmgus start
-//static std::vector<Node> AStarMatrix;
-static std::vector<std::vector<Node>> AStarMatrix;
-//Wyrmgus end
-
-/// a list of close nodes, helps to speed up the matrix cleaning
 //Wyrmgus start
 //static std::vector<int> CloseSet;
 //static size_t Threshold = 0;
-static std::vector<std::vector<int>> CloseSet;
 static std::vector<size_t> Threshold;
 //Wyrmgus end
 static constexpr int MAX_CLOSE_SET_RATIO = 4;
@@ -84,6 +79,7 @@ int AStarFixedUnitCrossingCost;// = MaxMapWidth * MaxMapHeight;
 int AStarMovingUnitCrossingCost = 5;
 bool AStarKnowUnseenTerrain = false;
 int AStarUnknownTerrainCost = 2;
+int AStarThreadCount = std::max<int>(1, std::thread::hardware_concurrency());
 
 //Wyrmgus start
 //static int AStarMapWidth;
@@ -92,48 +88,156 @@ static std::vector<int> AStarMapWidth;
 static std::vector<int> AStarMapHeight;
 //Wyrmgus end
 
-static int AStarGoalX;
-static int AStarGoalY;
-
-static int AStarGoalZ;
+static constexpr int CacheNotSet = -5;
 
-static std::vector<std::vector<unsigned>> cached_tiles;
+/// The tile flags for units occupying a tile, which don't by themselves make it impassable
+static constexpr tile_flag UnitOccupancyFlags = tile_flag::land_unit | tile_flag::air_unit | tile_flag::sea_unit;
 
-struct Open final
+/**
+**  The costs of moving through the tiles of a map layer for a given movement mask,
+**  leaving aside the units occupying them and what the moving unit knows about them.
+**
+**  It is kept up to date as the terrain changes, rather than being evaluated anew for each search.
+*/
+class astar_static_cost_grid final
 {
-	explicit Open(const Vec2i &pos, const short int costs, const unsigned int offset)
-		: pos(pos), costs(costs), offset(offset)
+public:
+	static constexpr uint8_t impassable_flag = 1 << 0; //the tile is impassable for the movement mask, regardless of units merely occupying it
+	static constexpr uint8_t desert_flag = 1 << 1;
+	static constexpr uint8_t railroad_flag = 1 << 2;
+
+	struct entry final
 	{
-		this->distance = number::fast_abs(this->pos.x - AStarGoalX) + number::fast_abs(this->pos.y - AStarGoalY);
-	}
+		uint8_t movement_cost = 0;
+		uint8_t flags = 0;
+	};
 
-	bool operator <(const Open &rhs) const
+	explicit astar_static_cost_grid(const int z, const tile_flag movement_mask) : movement_mask(movement_mask)
 	{
-		if (this->costs != rhs.costs) {
-			return this->costs < rhs.costs;
+		const CMapLayer *map_layer = CMap::get()->MapLayers[z].get();
+		const unsigned int tile_count = static_cast<unsigned int>(map_layer->get_width() * map_layer->get_height());
+
+		this->entries.resize(tile_count);
+
+		for (unsigned int index = 0; index < tile_count; ++index) {
+			this->update_tile(index, *map_layer->Field(index));
 		}
+	}
 
-		const int cost_to_goal = AStarMatrix[AStarGoalZ][this->offset].CostToGoal;
-		const int rhs_cost_to_goal = AStarMatrix[AStarGoalZ][rhs.offset].CostToGoal;
+	void update_tile(const unsigned int index, const tile &tile)
+	{
+		entry &tile_entry = this->entries[index];
+		tile_entry.movement_cost = tile.get_movement_cost();
+		tile_entry.flags = 0;
 
-		if (cost_to_goal != rhs_cost_to_goal) {
-			return cost_to_goal < rhs_cost_to_goal;
+		if ((tile.get_flags() & this->movement_mask & ~UnitOccupancyFlags) != tile_flag::none) {
+			tile_entry.flags |= impassable_flag;
 		}
 
-		if (this->distance != rhs.distance) {
-			return this->distance < rhs.distance;
+		if (tile.has_flag(tile_flag::desert)) {
+			tile_entry.flags |= desert_flag;
 		}
 
-		return this->offset < rhs.offset;
+		if (tile.has_flag(tile_flag::railroad)) {
+			tile_entry.flags |= railroad_flag;
+		}
+	}
+
+	const entry &get_entry(const unsigned int index) const
+	{
+		return this->entries[index];
 	}
 
-	Vec2i pos = Vec2i(0, 0);
-	short int costs = 0; //complete costs to goal
-	unsigned int offset = 0; //offset into matrix
 private:
-	int distance = 0;
+	tile_flag movement_mask = tile_flag::none;
+	std::vector<entry> entries;
+};
+
+/// The static cost grids, per map layer and movement mask; they are created when first used, as the movement masks for which they are needed are not known beforehand
+static std::vector<std::map<tile_flag, std::unique_ptr<astar_static_cost_grid>>> StaticCostGrids;
+/// Guards the creation of static cost grids, which can happen during searches
+static std::mutex StaticCostGridMutex;
+
+/// The units occupying each tile, per map layer, as a compact copy of the tiles' unit occupancy flags
+static std::vector<std::vector<uint8_t>> OccupancyGrids;
+
+/// The tiles whose occupancy has changed since paths were calculated in advance in the current cycle, with their occupancy before the first change, per map layer
+static std::vector<std::vector<std::pair<unsigned int, uint8_t>>> OccupancyChanges;
+/// Whether each tile is already in the occupancy change log, per map layer
+static std::vector<std::vector<bool>> OccupancyChangeLogged;
+/// The cycle for which occupancy changes are logged
+static unsigned long OccupancyChangeLogCycle = std::numeric_limits<unsigned long>::max();
+
+static constexpr uint8_t LandUnitOccupancy = 1 << 0;
+static constexpr uint8_t AirUnitOccupancy = 1 << 1;
+static constexpr uint8_t SeaUnitOccupancy = 1 << 2;
+
+static uint8_t GetOccupancy(const tile_flag flags)
+{
+	uint8_t occupancy = 0;
+
+	if ((flags & tile_flag::land_unit) != tile_flag::none) {
+		occupancy |= LandUnitOccupancy;
+	}
+
+	if ((flags & tile_flag::air_unit) != tile_flag::none) {
+		occupancy |= AirUnitOccupancy;
+	}
+
+	if ((flags & tile_flag::sea_unit) != tile_flag::none) {
+		occupancy |= SeaUnitOccupancy;
+	}
+
+	return occupancy;
+}
+
+/**
+**  The state of A* searches, of which each pathfinding worker has its own,
+**  so that searches can be run concurrently.
+**
+**  The Open set is handled by a bucket queue keyed on the node costs,
+**  which is kept per map layer and reused between searches.
+*/
+class astar_context final
+{
+public:
+	void init_map_layer(const int width, const int height)
+	{
+		this->matrix.push_back(std::vector<Node>(width * height));
+
+		this->close_set.emplace_back();
+		this->close_set.back().reserve(width * height / MAX_CLOSE_SET_RATIO);
+
+		this->open_set.emplace_back();
+		this->open_set.back().set_node_count(width * height);
+
+		this->cost_move_to_cache.push_back(std::vector<int>(width * height, CacheNotSet));
+
+		this->cached_tiles.emplace_back();
+	}
+
+	std::vector<std::vector<Node>> matrix; /// cost matrix
+	std::vector<std::vector<int>> close_set; /// a list of close nodes, helps to speed up the matrix cleaning
+	std::vector<astar_open_list> open_set; /// the set of Open nodes
+	std::vector<std::vector<int>> cost_move_to_cache;
+	std::vector<std::vector<unsigned>> cached_tiles;
+	int goal_x = 0;
+	int goal_y = 0;
+
+	//the unit for which the current search is made, and the parts of its movement costs which are the same for each tile
+	const CUnit *unit = nullptr;
+	const astar_static_cost_grid *static_cost_grid = nullptr;
+	uint8_t occupancy_mask = 0;
+	bool uses_tile_movement_cost = false;
+	int rail_speed_bonus = 0;
+	bool avoids_desert = false;
+
+	astar_search_dependencies *dependencies = nullptr; //if set, what the current search depends on is recorded in it
 };
 
+/// The search contexts, one per pathfinding worker; the first one is also used for searches made outside of the parallel path calculation
+static std::vector<std::unique_ptr<astar_context>> AStarContexts;
+
 /// heuristic cost function for a*
 static int AStarCosts(const Vec2i &pos, const Vec2i &goalPos)
 {
@@ -141,19 +245,23 @@ static int AStarCosts(const Vec2i &pos, const Vec2i &goalPos)
 	return std::max<int>(number::fast_abs(diff.x), number::fast_abs(diff.y));
 }
 
-/**
-**  The Open set is handled by a stored array
-**  the end of the array holds the item with the smallest cost.
-*/
+/// The key of a cluster graph within a map layer: the movement mask, the index of the player whose explored terrain is used (or -1 if all terrain is known) and whether tile movement costs are used
+using cluster_graph_key = std::tuple<tile_flag, int, bool>;
 
-/// The set of Open nodes
-static std::vector<boost::container::flat_set<Open>> OpenSet;
+/// The cluster graphs used for hierarchical pathfinding, per map layer
+static std::vector<std::map<cluster_graph_key, std::unique_ptr<cluster_graph>>> ClusterGraphs;
+/// Guards the creation of cluster graphs, which can happen during searches; the graphs serialize the building of their own parts
+static std::mutex ClusterGraphMutex;
 
-//Wyrmgus start
-//static std::vector<int> CostMoveToCache;
-static std::vector<std::vector<int>> CostMoveToCache;
-//Wyrmgus end
-static constexpr int CacheNotSet = -5;
+/// The amount of changes to the passability of tiles so far, with which paths calculated in advance are checked for still being valid
+static unsigned long AStarPassabilityGeneration = 0;
+
+/// Minimum distance from the start to the goal for a path to be planned on the cluster graph
+static constexpr int HIERARCHICAL_PATH_MIN_DISTANCE = cluster_graph::cluster_size * 2;
+/// Maximum distance from the start to the waypoint up to which a hierarchical path is refined
+static constexpr int HIERARCHICAL_WAYPOINT_DISTANCE = cluster_graph::cluster_size * 2;
+/// Maximum amount of nodes expanded when refining a hierarchical path
+static constexpr int HIERARCHICAL_REFINEMENT_MAX_LENGTH = cluster_graph::cluster_size * cluster_graph::cluster_size * 8;
 
 /**
 **  Init A* data structures
@@ -163,30 +271,37 @@ static constexpr int CacheNotSet = -5;
 void InitAStar()
 //Wyrmgus end
 {
+	// Should only be called once
+	assert_throw(AStarContexts.empty());
+
 	for (size_t z = 0; z < CMap::get()->MapLayers.size(); ++z) {
-		// Should only be called once
-		assert_throw(AStarMatrix.size() <= z);
-	
 		AStarMapWidth.push_back(CMap::get()->Info->MapWidths[z]);
 		AStarMapHeight.push_back(CMap::get()->Info->MapHeights[z]);
-		
-		AStarMatrix.push_back(std::vector<Node>(AStarMapWidth[z] * AStarMapHeight[z]));
 
 		const size_t threshold = static_cast<size_t>(AStarMapWidth[z] * AStarMapHeight[z] / MAX_CLOSE_SET_RATIO);
 		Threshold.push_back(threshold);
-		CloseSet.emplace_back();
-		CloseSet.back().reserve(threshold);
-
-		OpenSet.emplace_back();
-
-		CostMoveToCache.push_back(std::vector<int>(AStarMapWidth[z] * AStarMapHeight[z], CacheNotSet));
 
 		for (int i = 0; i < 9; ++i) {
 			Heading2O[i].push_back(Heading2Y[i] * AStarMapWidth[z]);
 		}
 
-		cached_tiles.emplace_back();
+		//the cluster graphs are created when first used, as the movement masks for which they are needed are not known beforehand
+		ClusterGraphs.emplace_back();
+		StaticCostGrids.emplace_back();
+
+		const CMapLayer *map_layer = CMap::get()->MapLayers[z].get();
+		std::vector<uint8_t> occupancy_grid(AStarMapWidth[z] * AStarMapHeight[z], 0);
+		for (size_t index = 0; index < occupancy_grid.size(); ++index) {
+			occupancy_grid[index] = GetOccupancy(map_layer->Field(static_cast<unsigned int>(index))->get_flags());
+		}
+		OccupancyGrids.push_back(std::move(occupancy_grid));
+
+		OccupancyChanges.emplace_back();
+		OccupancyChangeLogged.push_back(std::vector<bool>(AStarMapWidth[z] * AStarMapHeight[z], false));
 	}
+
+	//the contexts of the other workers are created when they are first needed
+	AStarPrepareWorkers(1);
 }
 
 /**
@@ -196,106 +311,100 @@ void FreeAStar()
 {
 	AStarMapWidth.clear();
 	AStarMapHeight.clear();
-	AStarMatrix.clear();
 	Threshold.clear();
-	CloseSet.clear();
-	OpenSet.clear();
-	CostMoveToCache.clear();
-	cached_tiles.clear();
+	AStarContexts.clear();
+	ClusterGraphs.clear();
+	StaticCostGrids.clear();
+	OccupancyGrids.clear();
+	OccupancyChanges.clear();
+	OccupancyChangeLogged.clear();
+	OccupancyChangeLogCycle = std::numeric_limits<unsigned long>::max();
+	flow_field::clear_cache();
 	
 	for (int i = 0; i < 9; ++i) {
 		Heading2O[i].clear();
 	}
 }
 
+/**
+**  Make sure a search context exists for each of the given amount of pathfinding workers.
+**
+**  @param worker_count  The amount of workers.
+*/
+void AStarPrepareWorkers(const int worker_count)
+{
+	while (static_cast<int>(AStarContexts.size()) < worker_count) {
+		auto context = std::make_unique<astar_context>();
+
+		for (size_t z = 0; z < AStarMapWidth.size(); ++z) {
+			context->init_map_layer(AStarMapWidth[z], AStarMapHeight[z]);
+		}
+
+		AStarContexts.push_back(std::move(context));
+	}
+}
+
 /**
 **  Clean up A*
 */
 //Wyrmgus start
 //static void AStarCleanUp()
-static void AStarCleanUp(int z)
+static void AStarCleanUp(astar_context &context, int z)
 //Wyrmgus end
 {
-	std::vector<int> &cache = CostMoveToCache[z];
+	std::vector<int> &cache = context.cost_move_to_cache[z];
 
 	//Wyrmgus start
 //	if (CloseSet.size() >= Threshold) {
-	if (CloseSet[z].size() >= Threshold[z]) {
+	if (context.close_set[z].size() >= Threshold[z]) {
 	//Wyrmgus end
-		std::fill(AStarMatrix[z].begin(), AStarMatrix[z].end(), Node());
+		std::fill(context.matrix[z].begin(), context.matrix[z].end(), Node());
 		std::fill(cache.begin(), cache.end(), CacheNotSet);
+		context.close_set[z].clear();
 	} else {
-		for (const unsigned tile_offset : cached_tiles[z]) {
-			AStarMatrix[z][tile_offset].CostFromStart = 0;
-			AStarMatrix[z][tile_offset].InGoal = 0;
+		for (const unsigned tile_offset : context.cached_tiles[z]) {
+			context.matrix[z][tile_offset].CostFromStart = 0;
+			context.matrix[z][tile_offset].InGoal = 0;
 			cache[tile_offset] = CacheNotSet;
 		}
 	}
 
-	cached_tiles[z].clear();
+	context.cached_tiles[z].clear();
 }
 
 /**
-**  Add a new node to the open set (and update the heap structure)
+**  Add a new node to the open set, or lower the cost of a node already in it
 **
 **  @return  0 or PF_FAILED
 */
 //Wyrmgus start
 //static int AStarAddNode(const Vec2i &pos, const int o, const int costs)
-static int AStarAddNode(const Vec2i &pos, const int o, const int costs, const int z)
+static int AStarAddNode(astar_context &context, const Vec2i &pos, const int o, const int costs, const int z)
 //Wyrmgus end
 {
+	const int distance = number::fast_abs(pos.x - context.goal_x) + number::fast_abs(pos.y - context.goal_y);
+
 	// fill our new node
-	OpenSet[z].emplace(pos, costs, o);
+	context.open_set[z].push(pos, o, costs, context.matrix[z][o].CostToGoal, distance);
 
 	return 0;
 }
 
-/**
-**  Change the cost associated to an open node.
-**  Can be further optimised knowing that the new cost MUST BE LOWER
-**  than the old one.
-*/
-static void AStarReplaceNode(const Open *node_ptr, const int z)
-{
-	const Open node = std::move(*node_ptr);
-	OpenSet[z].erase(*node_ptr);
-
-	// Re-add the node with the new cost
-	AStarAddNode(node.pos, node.offset, node.costs, z);
-}
-
-/**
-**  Check if a node is already in the open set.
-**
-**  @return  The pointer to the node if found, or null otherwise.
-*/
-static const Open *AStarFindNode(const int eo, const int z)
-{
-	for (const Open &open_node : OpenSet[z]) {
-		if (static_cast<int>(open_node.offset) == eo) {
-			return &open_node;
-		}
-	}
-
-	return nullptr;
-}
-
 /**
 **  Add a node to the closed set
 */
 //Wyrmgus start
 //static void AStarAddToClose(int node)
-static void AStarAddToClose(int node, int z)
+static void AStarAddToClose(astar_context &context, int node, int z)
 //Wyrmgus end
 {
 	//Wyrmgus start
 //	if (CloseSet.size() < Threshold) {
-	if (CloseSet[z].size() < Threshold[z]) {
+	if (context.close_set[z].size() < Threshold[z]) {
 	//Wyrmgus end
 		//Wyrmgus start
 //		CloseSet.push_back(node);
-		CloseSet[z].push_back(node);
+		context.close_set[z].push_back(node);
 		//Wyrmgus end
 	}
 }
@@ -305,8 +414,65 @@ static void AStarAddToClose(int node, int z)
 #define GetIndex(x, y, z) (x) + (y) * AStarMapWidth[(z)]
 //Wyrmgus end
 
+/**
+**  Get the static cost grid for a movement mask, creating it if necessary.
+*/
+static const astar_static_cost_grid *GetStaticCostGrid(const tile_flag movement_mask, const int z)
+{
+	std::lock_guard<std::mutex> lock(StaticCostGridMutex);
+
+	std::unique_ptr<astar_static_cost_grid> &grid = StaticCostGrids[z][movement_mask];
+	if (grid == nullptr) {
+		grid = std::make_unique<astar_static_cost_grid>(z, movement_mask);
+	}
+
+	return grid.get();
+}
+
+/**
+**  Evaluate the parts of a unit's movement costs which don't depend on the tile.
+*/
+static astar_search_dependencies::unit_costs AStarGetSearchUnitCosts(const CUnit &unit)
+{
+	astar_search_dependencies::unit_costs costs;
+	costs.player = unit.Player;
+	costs.movement_mask = unit.Type->MovementMask;
+	costs.tile_size = Vec2i(unit.Type->get_tile_width(), unit.Type->get_tile_height());
+	costs.uses_tile_movement_cost = AStarUsesTileMovementCost(unit);
+
+	//add rail speed bonus to the cost for non-railroad tiles, as it is an implicit penalty for them
+	costs.rail_speed_bonus = unit.Variable[RAIL_SPEED_BONUS_INDEX].Value;
+
+	//increase the cost of moving through deserts for units affected by dehydration, as we want the pathfinding to try to avoid that
+	costs.avoids_desert = unit.Type->BoolFlag[ORGANIC_INDEX].value
+		&& unit.get_center_tile_time_of_day() != nullptr
+		&& unit.get_center_tile_time_of_day()->is_day()
+		&& unit.Variable[DEHYDRATIONIMMUNITY_INDEX].Value <= 0;
+
+	return costs;
+}
+
+/**
+**  Set the unit for which searches are made with a context.
+*/
+static void AStarSetSearchUnit(astar_context &context, const CUnit &unit, const int z)
+{
+	const astar_search_dependencies::unit_costs costs = AStarGetSearchUnitCosts(unit);
+
+	context.unit = &unit;
+	context.static_cost_grid = GetStaticCostGrid(costs.movement_mask, z);
+	context.occupancy_mask = GetOccupancy(costs.movement_mask);
+	context.uses_tile_movement_cost = costs.uses_tile_movement_cost;
+	context.rail_speed_bonus = costs.rail_speed_bonus;
+	context.avoids_desert = costs.avoids_desert;
+
+	if (context.dependencies != nullptr) {
+		context.dependencies->costs = costs;
+	}
+}
+
 /* build-in costmoveto code */
-static int CostMoveToCallBack_Default(unsigned int index, const CUnit &unit, int z)
+static int CostMoveToCallBack_Default(const astar_context &context, unsigned int index, const CUnit &unit, int z)
 {
 #ifdef DEBUG
 	{
@@ -317,95 +483,93 @@ static int CostMoveToCallBack_Default(unsigned int index, const CUnit &unit, int
 	}
 #endif
 	int cost = 0;
-	const tile_flag mask = unit.Type->MovementMask;
-	const unit_domain_blocker_finder unit_finder(unit.Type->get_domain());
+	const astar_static_cost_grid &static_cost_grid = *context.static_cost_grid;
+	const std::vector<uint8_t> &occupancy_grid = OccupancyGrids[z];
 
 	// verify each tile of the unit.
 	int h = unit.Type->get_tile_height();
 	const int w = unit.Type->get_tile_width();
 	do {
-		const wyrmgus::tile *mf = CMap::get()->Field(index, z);
+		unsigned int tile_index = index;
 		int i = w;
 		do {
-			const tile_flag tile_flags = mf->get_flags();
-			const tile_flag flags = tile_flags & mask;
-			
-			if (flags != tile_flag::none && (AStarKnowUnseenTerrain || mf->player_info->IsTeamExplored(*unit.Player))) {
-				if ((flags & ~(tile_flag::land_unit | tile_flag::air_unit | tile_flag::sea_unit)) != tile_flag::none) {
+			const astar_static_cost_grid::entry &static_cost = static_cost_grid.get_entry(tile_index);
+			const uint8_t occupancy = occupancy_grid[tile_index] & context.occupancy_mask;
+			const wyrmgus::tile *mf = nullptr;
+
+			bool explored = AStarKnowUnseenTerrain;
+			if (!explored) {
+				mf = CMap::get()->Field(tile_index, z);
+				explored = mf->player_info->IsTeamExplored(*unit.Player);
+			}
+
+			if (explored) {
+				if ((static_cost.flags & astar_static_cost_grid::impassable_flag) != 0) {
 					//we can't cross fixed units and other unpassable things
 					return -1;
 				}
 
-				CUnit *goal = mf->UnitCache.find(unit_finder);
-				if (!goal) {
-					//shouldn't happen, mask says there is something on this tile
-					throw std::runtime_error("Error in CostMoveToCallBack_Default: tile " + point::to_string(CMap::get()->get_index_pos(index, z)) + " says there is something impassable in its mask (" + std::to_string(enumeration::to_underlying(flags)) + "), but no appropriate unit could be found on the tile for domain \"" + enum_converter<unit_domain>::to_string(unit.Type->get_domain()) + "\" (unit cache size: " + std::to_string(mf->UnitCache.size()) + ").");
-				}
+				if (occupancy != 0) {
+					if (mf == nullptr) {
+						mf = CMap::get()->Field(tile_index, z);
+					}
 
-				//Wyrmgus start
-//				if (goal->Moving)  {
-				if (&unit != goal && goal->Moving)  {
-				//Wyrmgus end
-					// moving unit are crossable
-					cost += AStarMovingUnitCrossingCost;
-				} else {
-					// for non moving unit Always Fail unless goal is unit, or unit can attack the target
-					if (&unit != goal) {
-						//Wyrmgus start
-						/*
-//						if (goal->Player->is_enemy_of(unit) && unit.IsAgressive() && unit.Type->can_target(goal)
-						//Wyrmgus end
-							&& goal->Variable[UNHOLYARMOR_INDEX].Value == 0 && goal->IsVisibleAsGoal(*unit.Player)) {
-								cost += 2 * AStarMovingUnitCrossingCost;
-						} else {
-						*/
-						// FIXME: Need support for moving a fixed unit to add cost
+					const unit_domain_blocker_finder unit_finder(unit.Type->get_domain());
+					CUnit *goal = mf->UnitCache.find(unit_finder);
+					if (!goal) {
+						//shouldn't happen, mask says there is something on this tile
+						throw std::runtime_error("Error in CostMoveToCallBack_Default: tile " + point::to_string(CMap::get()->get_index_pos(tile_index, z)) + " says there is something impassable in its mask (" + std::to_string(enumeration::to_underlying(mf->get_flags() & unit.Type->MovementMask)) + "), but no appropriate unit could be found on the tile for domain \"" + enum_converter<unit_domain>::to_string(unit.Type->get_domain()) + "\" (unit cache size: " + std::to_string(mf->UnitCache.size()) + ").");
+					}
+
+					if (&unit != goal && context.dependencies != nullptr) {
+						context.dependencies->crossed_units.push_back(astar_search_dependencies::crossed_unit{ tile_index, goal, goal->Moving != 0 });
+					}
+
+					//Wyrmgus start
+//					if (goal->Moving)  {
+					if (&unit != goal && goal->Moving)  {
+					//Wyrmgus end
+						// moving unit are crossable
+						cost += AStarMovingUnitCrossingCost;
+					} else {
+						// for non moving unit Always Fail unless goal is unit, or unit can attack the target
+						if (&unit != goal) {
+							// FIXME: Need support for moving a fixed unit to add cost
 							return -1;
-						//Wyrmgus start
-//						}
-						//Wyrmgus end
-						//cost += AStarFixedUnitCrossingCost;
+						}
 					}
 				}
-			}
-
-			// Add cost of crossing unknown tiles if required
-			if (!AStarKnowUnseenTerrain && !mf->player_info->IsTeamExplored(*unit.Player)) {
+			} else {
+				// Add cost of crossing unknown tiles if required
 				// Tend against unknown tiles.
 				cost += AStarUnknownTerrainCost;
 			}
 			
 			//Wyrmgus start
-			if (
-				(mf->has_flag(tile_flag::desert))
-				&& mf->get_owner() != unit.Player
-				&& unit.Type->BoolFlag[ORGANIC_INDEX].value
-				&& unit.get_center_tile_time_of_day() != nullptr
-				&& unit.get_center_tile_time_of_day()->is_day()
-				&& unit.Variable[DEHYDRATIONIMMUNITY_INDEX].Value <= 0
-			) {
-				cost += 32; //increase the cost of moving through deserts for units affected by dehydration, as we want the pathfinding to try to avoid that
+			if (context.avoids_desert && (static_cost.flags & astar_static_cost_grid::desert_flag) != 0) {
+				if (mf == nullptr) {
+					mf = CMap::get()->Field(tile_index, z);
+				}
+
+				if (mf->get_owner() != unit.Player) {
+					cost += 32; //increase the cost of moving through deserts for units affected by dehydration, as we want the pathfinding to try to avoid that
+				}
 			}
 			//Wyrmgus end
 			
 			//add tile movement cost
-			switch (unit.Type->get_domain()) {
-				case unit_domain::air:
-				case unit_domain::air_low:
-				case unit_domain::space:
-					cost += DefaultTileMovementCost;
-					break;
-				default:
-					cost += mf->get_movement_cost();
-
-					if (unit.Variable[RAIL_SPEED_BONUS_INDEX].Value != 0 && !mf->has_flag(tile_flag::railroad)) {
-						//add rail speed bonus to the cost for non-railroad tiles, as it is an implicit penalty for them
-						cost += unit.Variable[RAIL_SPEED_BONUS_INDEX].Value;
-					}
-					break;
+			if (context.uses_tile_movement_cost) {
+				cost += static_cost.movement_cost;
+
+				if (context.rail_speed_bonus != 0 && (static_cost.flags & astar_static_cost_grid::railroad_flag) == 0) {
+					//add rail speed bonus to the cost for non-railroad tiles, as it is an implicit penalty for them
+					cost += context.rail_speed_bonus;
+				}
+			} else {
+				cost += DefaultTileMovementCost;
 			}
 
-			++mf;
+			++tile_index;
 		} while (--i);
 
 		//Wyrmgus start
@@ -429,7 +593,7 @@ static int CostMoveToCallBack_Default(unsigned int index, const CUnit &unit, int
 **                0 -> no induced cost, except move
 **               >0 -> costly tile
 */
-static int CostMoveTo(unsigned int index, const CUnit *unit, int z)
+static int CostMoveTo(astar_context &context, unsigned int index, const CUnit *unit, int z)
 {
 	//Wyrmgus start
 	if (unit == nullptr) {
@@ -438,14 +602,19 @@ static int CostMoveTo(unsigned int index, const CUnit *unit, int z)
 	}
 	//Wyrmgus end
 
-	int &c = CostMoveToCache[z][index];
+	int &c = context.cost_move_to_cache[z][index];
 
 	if (c != CacheNotSet) {
 		return c;
 	}
 
-	c = CostMoveToCallBack_Default(index, *unit, z);
-	cached_tiles[z].push_back(index);
+	c = CostMoveToCallBack_Default(context, index, *unit, z);
+	context.cached_tiles[z].push_back(index);
+
+	if (context.dependencies != nullptr) {
+		const Vec2i pos(static_cast<int>(index) % AStarMapWidth[z], static_cast<int>(index) / AStarMapWidth[z]);
+		context.dependencies->add_searched_tile(pos, context.dependencies->costs.tile_size);
+	}
 
 	return c;
 }
@@ -453,23 +622,24 @@ static int CostMoveTo(unsigned int index, const CUnit *unit, int z)
 class AStarGoalMarker final
 {
 public:
-	explicit AStarGoalMarker(const CUnit &unit, bool &goal_reachable)
-		: unit(unit), goal_reachable(goal_reachable)
+	explicit AStarGoalMarker(astar_context &context, const CUnit &unit, bool &goal_reachable)
+		: context(context), unit(unit), goal_reachable(goal_reachable)
 	{
 	}
 
 	void operator()(int offset, int z) const
 	{
-		if (CostMoveTo(offset, &unit, z) >= 0) {
-			AStarMatrix[z][offset].InGoal = 1;
+		if (CostMoveTo(context, offset, &unit, z) >= 0) {
+			context.matrix[z][offset].InGoal = 1;
 			goal_reachable = true;
 		}
 		//Wyrmgus start
 //		AStarAddToClose(offset);
-		AStarAddToClose(offset, z);
+		AStarAddToClose(context, offset, z);
 		//Wyrmgus end
 	}
 private:
+	astar_context &context;
 	const CUnit &unit;
 	bool &goal_reachable;
 };
@@ -700,7 +870,7 @@ private:
 /**
 **  MarkAStarGoal
 */
-static int AStarMarkGoal(const Vec2i &goal, int gw, int gh,
+static int AStarMarkGoal(astar_context &context, const Vec2i &goal, int gw, int gh,
 						 //Wyrmgus start
 //						 int tilesizex, int tilesizey, int minrange, int maxrange, const CUnit &unit)
 						 int tilesizex, int tilesizey, int minrange, int maxrange, const CUnit &unit, int z)
@@ -715,8 +885,8 @@ static int AStarMarkGoal(const Vec2i &goal, int gw, int gh,
 		}
 
 		unsigned int offset = GetIndex(goal.x, goal.y, z);
-		if (CostMoveTo(offset, &unit, z) >= 0) {
-			AStarMatrix[z][offset].InGoal = 1;
+		if (CostMoveTo(context, offset, &unit, z) >= 0) {
+			context.matrix[z][offset].InGoal = 1;
 			return 1;
 		} else {
 			return 0;
@@ -728,7 +898,7 @@ static int AStarMarkGoal(const Vec2i &goal, int gw, int gh,
 	gw = std::max(gw, 1);
 	gh = std::max(gh, 1);
 
-	AStarGoalMarker aStarGoalMarker(unit, goal_reachable);
+	AStarGoalMarker aStarGoalMarker(context, unit, goal_reachable);
 	MinMaxRangeVisitor<AStarGoalMarker> visitor(aStarGoalMarker);
 
 	const Vec2i goalBottomRigth(goal.x + gw - 1, goal.y + gh - 1);
@@ -754,7 +924,7 @@ static int AStarMarkGoal(const Vec2i &goal, int gw, int gh,
 */
 //Wyrmgus start
 //static int AStarSavePath(const Vec2i &startPos, const Vec2i &endPos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path)
-static int AStarSavePath(const Vec2i &startPos, const Vec2i &endPos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, int z)
+static int AStarSavePath(astar_context &context, const Vec2i &startPos, const Vec2i &endPos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, int z)
 //Wyrmgus end
 {
 	int fullPathLength;
@@ -771,7 +941,7 @@ static int AStarSavePath(const Vec2i &startPos, const Vec2i &endPos, std::array<
 	while (curr != startPos) {
 		//Wyrmgus start
 //		direction = AStarMatrix[currO + curr.x].Direction;
-		direction = AStarMatrix[z][currO + curr.x].Direction;
+		direction = context.matrix[z][currO + curr.x].Direction;
 		//Wyrmgus end
 		curr.x -= Heading2X[direction];
 		curr.y -= Heading2Y[direction];
@@ -794,7 +964,7 @@ static int AStarSavePath(const Vec2i &startPos, const Vec2i &endPos, std::array<
 		while (curr != startPos) {
 			//Wyrmgus start
 //			direction = AStarMatrix[currO + curr.x].Direction;
-			direction = AStarMatrix[z][currO + curr.x].Direction;
+			direction = context.matrix[z][currO + curr.x].Direction;
 			//Wyrmgus end
 			curr.x -= Heading2X[direction];
 			curr.y -= Heading2Y[direction];
@@ -816,7 +986,7 @@ static int AStarSavePath(const Vec2i &startPos, const Vec2i &endPos, std::array<
 **  Optimization to find a simple path
 **  Check if we're at the goal or if it's 1 tile away
 */
-static int AStarFindSimplePath(const Vec2i &startPos, const Vec2i &goal, int gw, int gh,
+static int AStarFindSimplePath(astar_context &context, const Vec2i &startPos, const Vec2i &goal, int gw, int gh,
 							   int, int, int minrange, int maxrange,
 							   //Wyrmgus start
 //							   std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit)
@@ -847,7 +1017,7 @@ static int AStarFindSimplePath(const Vec2i &startPos, const Vec2i &goal, int gw,
 	if (minrange <= distance && number::fast_abs(diff.x) <= 1 && number::fast_abs(diff.y) <= 1) {
 	//Wyrmgus end
 		// Move to adjacent cell
-		if (CostMoveTo(GetIndex(goal.x, goal.y, z), &unit, z) == -1) {
+		if (CostMoveTo(context, GetIndex(goal.x, goal.y, z), &unit, z) == -1) {
 			return PF_UNREACHABLE;
 		}
 
@@ -862,49 +1032,25 @@ static int AStarFindSimplePath(const Vec2i &startPos, const Vec2i &goal, int gw,
 }
 
 /**
-**  Find path.
+**  Find path on the map grid.
 **
 **  @return  _move_return_ or the path length
 */
-int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
-				  const int tilesizex, const int tilesizey, const int minrange, const int maxrange,
-				  //Wyrmgus start
-//				  std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit)
-                  std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int max_length, const int z)
-				  //Wyrmgus end
+static int AStarFindGridPath(astar_context &context, const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
+							 const int tilesizex, const int tilesizey, const int minrange, const int maxrange,
+							 std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int max_length, const int z)
 {
-	assert_throw(CMap::get()->Info->IsPointOnMap(startPos, z));
-	
-	//Wyrmgus start
-	if (unit.MapLayer->ID != z) {
-		return PF_UNREACHABLE;
-	}
-	//Wyrmgus end
-
-	AStarGoalX = goalPos.x;
-	AStarGoalY = goalPos.y;
-
-	AStarGoalZ = z;
-
-	//  Check for simple cases first
-	int ret = AStarFindSimplePath(startPos, goalPos, gw, gh, tilesizex, tilesizey,
-								  //Wyrmgus start
-//								  minrange, maxrange, path, unit);
-								  minrange, maxrange, path, unit, z);
-								  //Wyrmgus end
-	if (ret != PF_FAILED) {
-		return ret;
-	}
+	int ret = PF_FAILED;
 
 	//  Initialize
-	AStarCleanUp(z);
+	AStarCleanUp(context, z);
 
-	OpenSet[z].clear();
-	CloseSet[z].clear();
+	context.open_set[z].clear();
+	context.close_set[z].clear();
 
 	//Wyrmgus start
 //	if (!AStarMarkGoal(goalPos, gw, gh, tilesizex, tilesizey, minrange, maxrange, unit)) {
-	if (!AStarMarkGoal(goalPos, gw, gh, tilesizex, tilesizey, minrange, maxrange, unit, z)) {
+	if (!AStarMarkGoal(context, goalPos, gw, gh, tilesizex, tilesizey, minrange, maxrange, unit, z)) {
 	//Wyrmgus end
 		// goal is not reachable
 		ret = PF_UNREACHABLE;
@@ -919,12 +1065,12 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 	// 0 as a way to represent nodes that we have not visited yet.
 	//Wyrmgus start
 //	AStarMatrix[eo].CostFromStart = 1;
-	AStarMatrix[z][eo].CostFromStart = 1;
+	context.matrix[z][eo].CostFromStart = 1;
 	//Wyrmgus end
 	// 8 to say we are came from nowhere.
 	//Wyrmgus start
 //	AStarMatrix[eo].Direction = 8;
-	AStarMatrix[z][eo].Direction = 8;
+	context.matrix[z][eo].Direction = 8;
 	//Wyrmgus end
 
 	// place start point in open, it that failed, try another pathfinder
@@ -932,16 +1078,16 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 	//Wyrmgus start
 //	AStarMatrix[eo].CostToGoal = costToGoal;
 //	if (AStarAddNode(startPos, eo, 1 + costToGoal) == PF_FAILED) {
-	AStarMatrix[z][eo].CostToGoal = costToGoal;
-	if (AStarAddNode(startPos, eo, 1 + costToGoal, z) == PF_FAILED) {
+	context.matrix[z][eo].CostToGoal = costToGoal;
+	if (AStarAddNode(context, startPos, eo, 1 + costToGoal, z) == PF_FAILED) {
 	//Wyrmgus end
 		ret = PF_FAILED;
 		return ret;
 	}
 
-	AStarAddToClose((*OpenSet[z].begin()).offset, z);
+	AStarAddToClose(context, eo, z);
 
-	if (AStarMatrix[z][eo].InGoal) {
+	if (context.matrix[z][eo].InGoal) {
 		ret = PF_REACHED;
 		return ret;
 	}
@@ -962,14 +1108,13 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 		//Wyrmgus end
 		
 		// Find the best node of from the open set
-		const Open shortest = std::move(*OpenSet[z].begin());
-		OpenSet[z].erase(OpenSet[z].begin());
+		const astar_open_list::entry shortest = context.open_set[z].pop();
 		const int x = shortest.pos.x;
 		const int y = shortest.pos.y;
 		const int o = shortest.offset;
 
 		// If we have reached the goal, then exit.
-		if (AStarMatrix[z][o].InGoal == 1) {
+		if (context.matrix[z][o].InGoal == 1) {
 			endPos.x = x;
 			endPos.y = y;
 			break;
@@ -990,8 +1135,8 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 		// Generate successors of this node.
 
 		// Node that this node was generated from.
-		const int px = x - Heading2X[(int)AStarMatrix[z][o].Direction];
-		const int py = y - Heading2Y[(int)AStarMatrix[z][o].Direction];
+		const int px = x - Heading2X[(int)context.matrix[z][o].Direction];
+		const int py = y - Heading2Y[(int)context.matrix[z][o].Direction];
 
 		for (int i = 0; i < 8; ++i) {
 			endPos.x = x + Heading2X[i];
@@ -1020,7 +1165,7 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 			// if the point is "move to"-able and
 			// if we have not reached this point before,
 			// or if we have a better path to it, we add it to open set
-			int new_cost = CostMoveTo(eo, &unit, z);
+			int new_cost = CostMoveTo(context, eo, &unit, z);
 			if (new_cost == -1) {
 				// uncrossable tile
 				continue;
@@ -1031,57 +1176,42 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 			//Wyrmgus start
 //			new_cost += AStarMatrix[o].CostFromStart;
 //			if (AStarMatrix[eo].CostFromStart == 0) {
-			new_cost += AStarMatrix[z][o].CostFromStart;
-			if (AStarMatrix[z][eo].CostFromStart == 0) {
+			new_cost += context.matrix[z][o].CostFromStart;
+			if (context.matrix[z][eo].CostFromStart == 0) {
 			//Wyrmgus end
 				// we are sure the current node has not been already visited
-				AStarMatrix[z][eo].CostFromStart = new_cost;
-				AStarMatrix[z][eo].Direction = i;
+				context.matrix[z][eo].CostFromStart = new_cost;
+				context.matrix[z][eo].Direction = i;
 				costToGoal = AStarCosts(endPos, goalPos);
 				//Wyrmgus start
 //				AStarMatrix[eo].CostToGoal = costToGoal;
 //				if (AStarAddNode(endPos, eo, AStarMatrix[eo].CostFromStart + costToGoal) == PF_FAILED) {
-				AStarMatrix[z][eo].CostToGoal = costToGoal;
-				if (AStarAddNode(endPos, eo, AStarMatrix[z][eo].CostFromStart + costToGoal, z) == PF_FAILED) {
+				context.matrix[z][eo].CostToGoal = costToGoal;
+				if (AStarAddNode(context, endPos, eo, context.matrix[z][eo].CostFromStart + costToGoal, z) == PF_FAILED) {
 				//Wyrmgus end
 					ret = PF_FAILED;
 					return ret;
 				}
 				// we add the point to the close set
-				AStarAddToClose(eo, z);
-			} else if (new_cost < AStarMatrix[z][eo].CostFromStart) {
+				AStarAddToClose(context, eo, z);
+			} else if (new_cost < context.matrix[z][eo].CostFromStart) {
 				// Already visited node, but we have here a better path
 				// I know, it's redundant (but simpler like this)
-				AStarMatrix[z][eo].CostFromStart = new_cost;
-				AStarMatrix[z][eo].Direction = i;
+				context.matrix[z][eo].CostFromStart = new_cost;
+				context.matrix[z][eo].Direction = i;
 
-				// this point might be already in the OpenSet
-				const Open *j = AStarFindNode(eo, z);
-				if (j == nullptr) {
-					costToGoal = AStarCosts(endPos, goalPos);
-					//Wyrmgus start
-//					AStarMatrix[eo].CostToGoal = costToGoal;
-//					if (AStarAddNode(endPos, eo, AStarMatrix[eo].CostFromStart + costToGoal) == PF_FAILED) {
-					AStarMatrix[z][eo].CostToGoal = costToGoal;
-					if (AStarAddNode(endPos, eo, AStarMatrix[z][eo].CostFromStart + costToGoal, z) == PF_FAILED) {
-					//Wyrmgus end
-						ret = PF_FAILED;
-						return ret;
-					}
-				} else {
-					costToGoal = AStarCosts(endPos, goalPos);
-					//Wyrmgus start
-//					AStarMatrix[eo].CostToGoal = costToGoal;
-//					AStarReplaceNode(j);
-					AStarMatrix[z][eo].CostToGoal = costToGoal;
-					AStarReplaceNode(j, z);
-					//Wyrmgus end
+				// this point might be already in the OpenSet, in which case its cost is lowered
+				costToGoal = AStarCosts(endPos, goalPos);
+				context.matrix[z][eo].CostToGoal = costToGoal;
+				if (AStarAddNode(context, endPos, eo, context.matrix[z][eo].CostFromStart + costToGoal, z) == PF_FAILED) {
+					ret = PF_FAILED;
+					return ret;
 				}
 				// we don't have to add this point to the close set
 			}
 		}
 
-		if (OpenSet[z].size() <= 0) { // no new nodes generated
+		if (context.open_set[z].empty()) { // no new nodes generated
 			ret = PF_UNREACHABLE;
 			return ret;
 		}
@@ -1091,7 +1221,7 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 
 	//Wyrmgus start
 //	const int path_length = AStarSavePath(startPos, endPos, path);
-	const int path_length = AStarSavePath(startPos, endPos, path, z);
+	const int path_length = AStarSavePath(context, startPos, endPos, path, z);
 	//Wyrmgus end
 
 	ret = path_length;
@@ -1099,6 +1229,453 @@ int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, con
 	return ret;
 }
 
+/**
+**  Get whether the movement cost of tiles applies to a unit.
+*/
+bool AStarUsesTileMovementCost(const CUnit &unit)
+{
+	switch (unit.Type->get_domain()) {
+		case unit_domain::air:
+		case unit_domain::air_low:
+		case unit_domain::space:
+			return false;
+		default:
+			return true;
+	}
+}
+
+/**
+**  Get the player whose explored terrain is taken into account for the searches of a unit, or null if all terrain is known.
+*/
+const CPlayer *AStarGetSearchPlayer(const CUnit &unit)
+{
+	return AStarKnowUnseenTerrain ? nullptr : unit.Player;
+}
+
+/**
+**  Get the cost of entering a tile by its terrain, or -1 if the tile is impassable.
+**
+**  This follows the rules of CostMoveToCallBack_Default for the terrain: unexplored tiles are
+**  passable at an extra cost, and the tile movement cost is only used if the unit is affected by it.
+**  Costs which depend on the moving unit itself, such as the rail speed bonus or avoiding deserts,
+**  are left to the grid search. It is used by the cluster graphs and flow fields, which are shared
+**  by several units.
+**
+**  @param pos                      Position of the tile.
+**  @param z                        Map layer of the tile.
+**  @param movement_mask            The movement mask of the units.
+**  @param player                   The player whose explored terrain is used, or null if all terrain is known.
+**  @param uses_tile_movement_cost  Whether the movement cost of the tile applies to the units.
+*/
+int AStarGetTileTerrainCost(const QPoint &pos, const int z, const tile_flag movement_mask, const CPlayer *player, const bool uses_tile_movement_cost)
+{
+	const tile *tile = CMap::get()->Field(pos, z);
+
+	//the base cost of a step, as added to the tile cost in the grid search
+	int cost = 1;
+
+	if (player != nullptr && !tile->player_info->IsTeamExplored(*player)) {
+		cost += AStarUnknownTerrainCost;
+	} else if ((tile->get_flags() & movement_mask & ~UnitOccupancyFlags) != tile_flag::none) {
+		return -1;
+	}
+
+	if (uses_tile_movement_cost) {
+		cost += tile->get_movement_cost();
+	} else {
+		cost += DefaultTileMovementCost;
+	}
+
+	return cost;
+}
+
+/**
+**  Get the cluster graph for the searches of a unit, creating it if necessary.
+*/
+static cluster_graph *GetClusterGraph(const astar_context &context, const CUnit &unit, const int z)
+{
+	const tile_flag movement_mask = unit.Type->MovementMask;
+	const CPlayer *player = AStarGetSearchPlayer(unit);
+	const bool uses_tile_movement_cost = context.uses_tile_movement_cost;
+
+	std::lock_guard<std::mutex> lock(ClusterGraphMutex);
+
+	std::unique_ptr<cluster_graph> &graph = ClusterGraphs[z][cluster_graph_key(movement_mask, player != nullptr ? player->get_index() : -1, uses_tile_movement_cost)];
+	if (graph == nullptr) {
+		const CMapLayer *map_layer = CMap::get()->MapLayers[z].get();
+
+		graph = std::make_unique<cluster_graph>(map_layer->get_size(), [z, movement_mask, player, uses_tile_movement_cost](const QPoint &tile_pos) {
+			return AStarGetTileTerrainCost(tile_pos, z, movement_mask, player, uses_tile_movement_cost);
+		});
+	}
+
+	return graph.get();
+}
+
+/**
+**  Find path on the cluster graph, and then refine it on the grid up to the next waypoint.
+**
+**  @return  _move_return_ or the path length to the waypoint, or PF_FAILED if no hierarchical path could be found
+*/
+static int AStarFindHierarchicalPath(astar_context &context, const Vec2i &startPos, const Vec2i &goalPos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int z)
+{
+	cluster_graph *graph = GetClusterGraph(context, unit, z);
+
+	//the search on the graph is made without holding a lock, as the graph serializes the building of its parts itself; the result does not depend on the order of searches, as each part of the graph reflects the map state when it is built
+	QPoint waypoint;
+	if (!graph->find_waypoint(startPos, goalPos, HIERARCHICAL_WAYPOINT_DISTANCE, waypoint)) {
+		return PF_FAILED;
+	}
+
+	context.goal_x = waypoint.x();
+	context.goal_y = waypoint.y();
+
+	const int ret = AStarFindGridPath(context, startPos, waypoint, 0, 0, 1, 1, 0, 0, path, unit, HIERARCHICAL_REFINEMENT_MAX_LENGTH, z);
+
+	context.goal_x = goalPos.x;
+	context.goal_y = goalPos.y;
+
+	if (ret <= 0) {
+		//the waypoint could not be reached, e.g. because it is occupied by a unit
+		return PF_FAILED;
+	}
+
+	return ret;
+}
+
+/**
+**  Find path.
+**
+**  @return  _move_return_ or the path length
+*/
+int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
+				  const int tilesizex, const int tilesizey, const int minrange, const int maxrange,
+				  //Wyrmgus start
+//				  std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit)
+                  std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int max_length, const int z)
+				  //Wyrmgus end
+{
+	return AStarFindPath(startPos, goalPos, gw, gh, tilesizex, tilesizey, minrange, maxrange, path, unit, max_length, z, 0, nullptr);
+}
+
+/**
+**  Find path, using the search context of a given pathfinding worker.
+**
+**  Searches with different worker indexes can be run concurrently,
+**  as long as the map and units are not modified meanwhile.
+**
+**  @param dependencies  If not null, filled with what the search depended on.
+**
+**  @return  _move_return_ or the path length
+*/
+int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
+				  const int tilesizex, const int tilesizey, const int minrange, const int maxrange,
+				  std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int max_length, const int z, const int worker_index, astar_search_dependencies *dependencies)
+{
+	astar_context &context = *AStarContexts.at(worker_index);
+
+	context.dependencies = dependencies;
+	if (dependencies != nullptr) {
+		dependencies->clear();
+	}
+
+	assert_throw(CMap::get()->Info->IsPointOnMap(startPos, z));
+	
+	//Wyrmgus start
+	if (unit.MapLayer->ID != z) {
+		return PF_UNREACHABLE;
+	}
+	//Wyrmgus end
+
+	context.goal_x = goalPos.x;
+	context.goal_y = goalPos.y;
+
+	//the cost cache is only valid for the unit of the search it was filled by
+	AStarCleanUp(context, z);
+	AStarSetSearchUnit(context, unit, z);
+
+	//  Check for simple cases first
+	int ret = AStarFindSimplePath(context, startPos, goalPos, gw, gh, tilesizex, tilesizey,
+								  //Wyrmgus start
+//								  minrange, maxrange, path, unit);
+								  minrange, maxrange, path, unit, z);
+								  //Wyrmgus end
+	if (ret != PF_FAILED) {
+		return ret;
+	}
+
+	//for long paths of single-tile units, plan the route on the cluster graph and only search the grid up to the next waypoint
+	//with a maximum range, the goal has to be far enough that no tile up to the waypoint can be within range of it, so that the grid search still handles the approach into range
+	if (
+		path != nullptr && max_length == 0
+		&& tilesizex == 1 && tilesizey == 1 && gw <= 1 && gh <= 1 && minrange == 0
+		&& AStarCosts(startPos, goalPos) > HIERARCHICAL_PATH_MIN_DISTANCE + maxrange
+	) {
+		ret = AStarFindHierarchicalPath(context, startPos, goalPos, path, unit, z);
+
+		if (ret != PF_FAILED) {
+			return ret;
+		}
+	}
+
+	return AStarFindGridPath(context, startPos, goalPos, gw, gh, tilesizex, tilesizey, minrange, maxrange, path, unit, max_length, z);
+}
+
+/**
+**  Notify the pathfinder that the passability of a tile has changed.
+**
+**  @param pos            Position of the tile.
+**  @param z              Map layer of the tile.
+**  @param changed_flags  The tile flags which have been changed.
+*/
+void AStarTilePassabilityChanged(const QPoint &pos, const int z, const tile_flag changed_flags)
+{
+	++AStarPassabilityGeneration;
+
+	if (z >= static_cast<int>(ClusterGraphs.size())) {
+		return;
+	}
+
+	AStarTileTerrainChanged(pos, z);
+
+	//units merely occupying tiles are not taken into account for the cluster graphs and flow fields; they are handled when refining the path with A*
+	const tile_flag blocking_flags = changed_flags & ~UnitOccupancyFlags;
+	if (blocking_flags == tile_flag::none) {
+		return;
+	}
+
+	flow_field::on_tile_changed(pos, z);
+
+	for (const auto &[key, graph] : ClusterGraphs[z]) {
+		if ((std::get<tile_flag>(key) & blocking_flags) != tile_flag::none) {
+			graph->on_tile_changed(pos);
+		}
+	}
+}
+
+/**
+**  Notify the pathfinder that the terrain of a tile has changed, which may change its movement cost.
+**
+**  @param pos  Position of the tile.
+**  @param z    Map layer of the tile.
+*/
+void AStarTileTerrainChanged(const QPoint &pos, const int z)
+{
+	++AStarPassabilityGeneration;
+
+	if (z >= static_cast<int>(StaticCostGrids.size())) {
+		return;
+	}
+
+	const unsigned int index = GetIndex(pos.x(), pos.y(), z);
+	const tile &tile = *CMap::get()->Field(index, z);
+
+	//the movement cost is the same for all movement masks, so any of the static cost grids holds the previous one
+	bool movement_cost_changed = StaticCostGrids[z].empty();
+
+	for (const auto &[movement_mask, grid] : StaticCostGrids[z]) {
+		if (grid->get_entry(index).movement_cost != tile.get_movement_cost()) {
+			movement_cost_changed = true;
+		}
+
+		grid->update_tile(index, tile);
+	}
+
+	if (!movement_cost_changed) {
+		return;
+	}
+
+	flow_field::on_tile_changed(pos, z);
+
+	for (const auto &[key, graph] : ClusterGraphs[z]) {
+		if (std::get<bool>(key)) {
+			graph->on_tile_changed(pos);
+		}
+	}
+}
+
+/**
+**  Notify the pathfinder that a player has explored a tile.
+**
+**  @param pos     Position of the tile.
+**  @param z       Map layer of the tile.
+**  @param player  The player who explored the tile.
+*/
+void AStarTileExplored(const QPoint &pos, const int z, const CPlayer &player)
+{
+	//searches take the explored terrain into account
+	++AStarPassabilityGeneration;
+
+	if (z >= static_cast<int>(ClusterGraphs.size())) {
+		return;
+	}
+
+	flow_field::on_tile_explored(pos, z, player);
+
+	for (const auto &[key, graph] : ClusterGraphs[z]) {
+		const int graph_player_index = std::get<int>(key);
+		if (graph_player_index == -1) {
+			continue;
+		}
+
+		//the tiles explored by the player count as explored for those sharing vision with them
+		if (graph_player_index != player.get_index() && !player.has_mutual_shared_vision_with(graph_player_index) && !player.is_revealed()) {
+			continue;
+		}
+
+		graph->on_tile_changed(pos);
+	}
+}
+
+/**
+**  Notify the pathfinder that the exploration of the map has changed as a whole, e.g. because players started or stopped sharing vision.
+*/
+void AStarExplorationChanged()
+{
+	++AStarPassabilityGeneration;
+
+	flow_field::on_exploration_changed();
+
+	for (const std::map<cluster_graph_key, std::unique_ptr<cluster_graph>> &graphs : ClusterGraphs) {
+		for (const auto &[key, graph] : graphs) {
+			if (std::get<int>(key) != -1) {
+				graph->invalidate();
+			}
+		}
+	}
+}
+
+/**
+**  Notify the pathfinder that the units occupying a tile have changed.
+**
+**  @param index  Index of the tile.
+**  @param z      Map layer of the tile.
+**  @param flags  The tile's flags.
+*/
+void AStarTileOccupancyChanged(const unsigned int index, const int z, const tile_flag flags)
+{
+	if (z >= static_cast<int>(OccupancyGrids.size())) {
+		return;
+	}
+
+	uint8_t &occupancy = OccupancyGrids[z][index];
+
+	if (OccupancyChangeLogCycle == GameCycle && !OccupancyChangeLogged[z][index]) {
+		OccupancyChangeLogged[z][index] = true;
+		OccupancyChanges[z].emplace_back(index, occupancy);
+	}
+
+	occupancy = GetOccupancy(flags);
+}
+
+/**
+**  Notify the pathfinder that the owner of a territory has changed, which may change the movement costs of units avoiding deserts.
+*/
+void AStarTerritoryOwnerChanged()
+{
+	++AStarPassabilityGeneration;
+}
+
+/**
+**  Start logging the changes to the occupancy of tiles in the current cycle, clearing the log of the previous one.
+*/
+void AStarStartOccupancyChangeLog()
+{
+	for (size_t z = 0; z < OccupancyChanges.size(); ++z) {
+		for (const auto &[index, occupancy] : OccupancyChanges[z]) {
+			OccupancyChangeLogged[z][index] = false;
+		}
+
+		OccupancyChanges[z].clear();
+	}
+
+	OccupancyChangeLogCycle = GameCycle;
+}
+
+/**
+**  Get the unit occupying a tile which a search for a unit would have to cross, or null if there is none.
+*/
+static const CUnit *AStarGetCrossedUnit(const unsigned int index, const int z, const uint8_t occupancy, const CUnit &unit)
+{
+	if ((occupancy & GetOccupancy(unit.Type->MovementMask)) == 0) {
+		return nullptr;
+	}
+
+	const unit_domain_blocker_finder unit_finder(unit.Type->get_domain());
+	const CUnit *crossed_unit = CMap::get()->Field(index, z)->UnitCache.find(unit_finder);
+
+	//the searching unit itself does not affect the cost of its tiles
+	if (crossed_unit == &unit) {
+		return nullptr;
+	}
+
+	return crossed_unit;
+}
+
+/**
+**  Check whether the tiles and units which a search depended on are still the same, so that a new search would have the same result.
+**
+**  The terrain and exploration are not checked, as changes to them are tracked by the passability generation.
+**
+**  @param dependencies  What the search depended on, as recorded when it was made in this cycle.
+**  @param unit          The unit for which the search was made.
+**  @param z             Map layer of the search.
+*/
+bool AStarSearchDependenciesUnchanged(const astar_search_dependencies &dependencies, const CUnit &unit, const int z)
+{
+	if (AStarGetSearchUnitCosts(unit) != dependencies.costs) {
+		return false;
+	}
+
+	//units which were crossed must still be there, and still be moving or not
+	for (const astar_search_dependencies::crossed_unit &crossed_unit : dependencies.crossed_units) {
+		const CUnit *current_unit = AStarGetCrossedUnit(crossed_unit.tile_index, z, OccupancyGrids[z][crossed_unit.tile_index], unit);
+
+		if (current_unit != crossed_unit.unit || (current_unit->Moving != 0) != crossed_unit.moving) {
+			return false;
+		}
+	}
+
+	//any other tile within the searched area must not have gained or lost a unit to be crossed
+	for (const auto &[index, previous_occupancy] : OccupancyChanges[z]) {
+		const Vec2i pos(static_cast<int>(index) % AStarMapWidth[z], static_cast<int>(index) / AStarMapWidth[z]);
+
+		if (!dependencies.is_searched_tile(pos)) {
+			continue;
+		}
+
+		const bool crossed = std::any_of(dependencies.crossed_units.begin(), dependencies.crossed_units.end(), [index](const astar_search_dependencies::crossed_unit &crossed_unit) {
+			return crossed_unit.tile_index == index;
+		});
+
+		if (crossed) {
+			//already checked
+			continue;
+		}
+
+		if (AStarGetCrossedUnit(index, z, OccupancyGrids[z][index], unit) != nullptr) {
+			return false;
+		}
+
+		//the tile was not crossed by the search, so it had no unit to be crossed, unless it was not evaluated at all, or it was occupied by the searching unit itself
+		if ((previous_occupancy & GetOccupancy(unit.Type->MovementMask)) != 0) {
+			const QRect unit_rect(unit.tilePos, QSize(unit.Type->get_tile_width(), unit.Type->get_tile_height()));
+
+			if (!unit_rect.contains(pos)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+unsigned long AStarGetPassabilityGeneration()
+{
+	return AStarPassabilityGeneration;
+}
+
+
 struct StatsNode {
 	int Direction = 0;
 	int InGoal = 0;
@@ -1143,9 +1720,27 @@ void SetAStarUnknownTerrainCost(int cost)
 		return;
 	}
 	AStarUnknownTerrainCost = cost;
+
+	//the cluster graphs include the cost of unknown terrain
+	AStarExplorationChanged();
 }
 
 int GetAStarUnknownTerrainCost()
 {
 	return AStarUnknownTerrainCost;
 }
+
+// AStarThreadCount
+void SetAStarThreadCount(int count)
+{
+	if (count < 1) {
+		log::log_error("AStarThreadCount must be positive.");
+		return;
+	}
+	AStarThreadCount = count;
+}
+
+int GetAStarThreadCount()
+{
+	return AStarThreadCount;
+}
@@ -0,0 +1,206 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#pragma once
+
+#include "vec2i.h"
+
+namespace wyrmgus {
+
+//the open set of the A* pathfinder, implemented as a bucket queue keyed on the (integer) total cost of a node
+//nodes within the same bucket are kept in a binary heap, ordered by their estimated cost to the goal, then by their distance to the goal and then by their offset, so that the pop order is the same as that of a fully sorted set
+class astar_open_list final
+{
+public:
+	//the handle value of nodes which are not in the open list; it cannot be the cost of a node, as costs are never negative
+	static constexpr int not_in_list = std::numeric_limits<int>::min();
+
+	//the maximum amount of empty buckets kept allocated between searches
+	static constexpr size_t max_kept_bucket_count = 1024;
+
+	struct entry final
+	{
+		Vec2i pos;
+		unsigned int offset = 0;
+		int cost_to_goal = 0;
+		int distance = 0;
+		int costs = 0;
+	};
+
+	//set the amount of nodes (i.e. tiles) which can be present in the open list, allocating the per-node handles
+	void set_node_count(const size_t node_count)
+	{
+		this->handles.assign(node_count, astar_open_list::not_in_list);
+	}
+
+	bool empty() const
+	{
+		return this->count == 0;
+	}
+
+	size_t size() const
+	{
+		return this->count;
+	}
+
+	//add a node to the open list, or lower its cost if it is already present
+	void push(const Vec2i &pos, const unsigned int offset, const int costs, const int cost_to_goal, const int distance)
+	{
+		int &handle = this->handles[offset];
+
+		if (handle == astar_open_list::not_in_list) {
+			++this->count;
+		}
+
+		//the node's handle stores its current cost; entries with a different cost are stale and get skipped when popped, which makes decreasing the key of a node a constant-time operation on the handle
+		handle = costs;
+
+		if (this->buckets_used == 0) {
+			this->base_costs = costs;
+			this->current_bucket = 0;
+		} else if (costs < this->base_costs) {
+			this->rebase(costs);
+		}
+
+		const size_t bucket_index = static_cast<size_t>(costs - this->base_costs);
+
+		if (bucket_index >= this->buckets.size()) {
+			this->buckets.resize(bucket_index + 1);
+		}
+
+		this->buckets_used = std::max(this->buckets_used, bucket_index + 1);
+
+		if (bucket_index < this->current_bucket) {
+			this->current_bucket = bucket_index;
+		}
+
+		std::vector<entry> &bucket = this->buckets[bucket_index];
+		bucket.push_back(entry{ pos, offset, cost_to_goal, distance, costs });
+		std::push_heap(bucket.begin(), bucket.end(), entry_compare());
+	}
+
+	//remove the node with the lowest cost from the open list and return it; must not be called if the list is empty
+	entry pop()
+	{
+		while (true) {
+			std::vector<entry> &bucket = this->buckets[this->current_bucket];
+
+			if (bucket.empty()) {
+				++this->current_bucket;
+				continue;
+			}
+
+			std::pop_heap(bucket.begin(), bucket.end(), entry_compare());
+			const entry top = bucket.back();
+			bucket.pop_back();
+
+			int &handle = this->handles[top.offset];
+			if (handle != top.costs) {
+				//stale entry, the node has since been re-added with a lower cost, or has already been popped
+				continue;
+			}
+
+			handle = astar_open_list::not_in_list;
+			--this->count;
+			return top;
+		}
+	}
+
+	//empty the open list, keeping its allocated memory for the next search
+	void clear()
+	{
+		for (size_t i = 0; i < this->buckets_used; ++i) {
+			std::vector<entry> &bucket = this->buckets[i];
+
+			for (const entry &bucket_entry : bucket) {
+				this->handles[bucket_entry.offset] = astar_open_list::not_in_list;
+			}
+
+			bucket.clear();
+		}
+
+		this->buckets_used = 0;
+		this->current_bucket = 0;
+		this->count = 0;
+
+		if (this->buckets.size() > astar_open_list::max_kept_bucket_count) {
+			this->buckets.resize(astar_open_list::max_kept_bucket_count);
+		}
+	}
+
+	size_t get_bucket_count() const
+	{
+		return this->buckets.size();
+	}
+
+private:
+	struct entry_compare final
+	{
+		//std::push_heap builds a max-heap, so the comparison is inverted
+		bool operator()(const entry &lhs, const entry &rhs) const
+		{
+			if (lhs.cost_to_goal != rhs.cost_to_goal) {
+				return lhs.cost_to_goal > rhs.cost_to_goal;
+			}
+
+			if (lhs.distance != rhs.distance) {
+				return lhs.distance > rhs.distance;
+			}
+
+			return lhs.offset > rhs.offset;
+		}
+	};
+
+	//lower the base cost, shifting the existing buckets up; this can only happen with an inconsistent heuristic, so it should be rare
+	void rebase(const int new_base_costs)
+	{
+		const size_t shift = static_cast<size_t>(this->base_costs - new_base_costs);
+
+		for (size_t i = 0; i < shift; ++i) {
+			if (this->buckets.size() > this->buckets_used + i) {
+				//reuse a spare (empty) bucket from the back, so that rebasing does not make the deque grow with every search
+				std::vector<entry> spare_bucket = std::move(this->buckets.back());
+				this->buckets.pop_back();
+				this->buckets.push_front(std::move(spare_bucket));
+			} else {
+				this->buckets.emplace_front();
+			}
+		}
+
+		this->buckets_used += shift;
+		this->current_bucket += shift;
+		this->base_costs = new_base_costs;
+	}
+
+	std::deque<std::vector<entry>> buckets; //a deque, so that buckets can be added in front when rebasing without moving the others
+	size_t buckets_used = 0;
+	size_t current_bucket = 0;
+	int base_costs = 0;
+	size_t count = 0;
+	std::vector<int> handles; //the cost with which each node is currently in the open list, or not_in_list
+};
+
+}
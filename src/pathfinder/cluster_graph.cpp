@@ -0,0 +1,495 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/cluster_graph.h"
+
+#include "pathfinder/astar_open_list.h"
+#include "util/assert_util.h"
+#include "util/number_util.h"
+
+namespace wyrmgus {
+
+static int get_chebyshev_distance(const QPoint &pos, const QPoint &other_pos)
+{
+	return std::max(number::fast_abs(pos.x() - other_pos.x()), number::fast_abs(pos.y() - other_pos.y()));
+}
+
+cluster_graph::cluster_graph(const QSize &size, const tile_cost_function &get_tile_cost)
+	: width(size.width()), height(size.height()), get_tile_cost(get_tile_cost)
+{
+	this->cluster_width_count = (this->width + cluster_size - 1) / cluster_size;
+	this->cluster_height_count = (this->height + cluster_size - 1) / cluster_size;
+
+	//the clusters can't be moved, as they hold an atomic flag, so the vector is created with its final size
+	const size_t cluster_count = static_cast<size_t>(this->cluster_width_count * this->cluster_height_count);
+	this->clusters = std::vector<cluster>(cluster_count);
+	this->horizontal_borders.resize(cluster_count);
+	this->vertical_borders.resize(cluster_count);
+}
+
+void cluster_graph::on_tile_changed(const QPoint &tile_pos)
+{
+	const int cluster_index = this->get_cluster_index(tile_pos);
+	const int cluster_x = cluster_index % this->cluster_width_count;
+	const int cluster_y = cluster_index / this->cluster_width_count;
+
+	this->invalidate_cluster(cluster_index);
+
+	//the portals on the borders of the cluster may have changed, so the clusters sharing those borders need to be rebuilt as well
+	this->horizontal_borders[cluster_index].dirty = true;
+	this->vertical_borders[cluster_index].dirty = true;
+
+	if (cluster_x > 0) {
+		this->horizontal_borders[cluster_index - 1].dirty = true;
+		this->invalidate_cluster(cluster_index - 1);
+	}
+
+	if (cluster_x < this->cluster_width_count - 1) {
+		this->invalidate_cluster(cluster_index + 1);
+	}
+
+	if (cluster_y > 0) {
+		this->vertical_borders[cluster_index - this->cluster_width_count].dirty = true;
+		this->invalidate_cluster(cluster_index - this->cluster_width_count);
+	}
+
+	if (cluster_y < this->cluster_height_count - 1) {
+		this->invalidate_cluster(cluster_index + this->cluster_width_count);
+	}
+}
+
+void cluster_graph::invalidate()
+{
+	for (size_t i = 0; i < this->clusters.size(); ++i) {
+		this->invalidate_cluster(static_cast<int>(i));
+		this->horizontal_borders[i].dirty = true;
+		this->vertical_borders[i].dirty = true;
+	}
+}
+
+bool cluster_graph::find_waypoint(const QPoint &start_pos, const QPoint &goal_pos, const int max_waypoint_distance, QPoint &waypoint)
+{
+	if (!this->is_tile_passable(start_pos) || !this->is_tile_passable(goal_pos)) {
+		return false;
+	}
+
+	const int start_cluster_index = this->get_cluster_index(start_pos);
+	const int goal_cluster_index = this->get_cluster_index(goal_pos);
+
+	this->ensure_cluster(start_cluster_index);
+	this->ensure_cluster(goal_cluster_index);
+
+	std::vector<int> tile_costs;
+	this->get_cluster_tile_costs(start_cluster_index, tile_costs);
+
+	std::vector<int> start_costs;
+	this->calculate_cluster_costs(start_cluster_index, tile_costs, start_pos, false, start_costs);
+
+	const QRect goal_cluster_rect = this->get_cluster_rect(goal_cluster_index);
+	const auto get_goal_cluster_local_index = [&goal_cluster_rect](const QPoint &pos) {
+		return (pos.y() - goal_cluster_rect.y()) * goal_cluster_rect.width() + (pos.x() - goal_cluster_rect.x());
+	};
+
+	if (start_cluster_index == goal_cluster_index && start_costs[get_goal_cluster_local_index(goal_pos)] != -1) {
+		//no need for hierarchical pathfinding
+		return false;
+	}
+
+	if (goal_cluster_index != start_cluster_index) {
+		this->get_cluster_tile_costs(goal_cluster_index, tile_costs);
+	}
+
+	std::vector<int> goal_costs;
+	this->calculate_cluster_costs(goal_cluster_index, tile_costs, goal_pos, true, goal_costs);
+
+	//A* search on the abstract graph; nodes are keyed by their cluster index and their index within the cluster
+	//the search data is kept per thread between searches, and a node is only valid if its search index is that of the current search, so that the nodes don't need to be cleared
+	struct search_node final
+	{
+		uint32_t search_index = 0;
+		int cost = 0;
+		uint32_t parent_key = 0;
+		bool closed = false;
+	};
+
+	struct search_data final
+	{
+		std::vector<search_node> nodes;
+		uint32_t search_index = 0;
+		astar_open_list open_set; //the open set of the tile pathfinder, keyed by node instead of tile
+	};
+
+	static thread_local search_data thread_search_data;
+
+	//accessed through a reference, as every access to a thread-local variable with a constructor goes through its initialization check
+	search_data &data = thread_search_data;
+	std::vector<search_node> &search_nodes = data.nodes;
+	astar_open_list &open_set = data.open_set;
+
+	const uint32_t goal_key = static_cast<uint32_t>(this->clusters.size() * max_cluster_node_count);
+	const uint32_t no_parent_key = goal_key + 1;
+
+	if (search_nodes.size() < static_cast<size_t>(goal_key) + 1) {
+		search_nodes.resize(static_cast<size_t>(goal_key) + 1);
+		open_set.set_node_count(search_nodes.size());
+	}
+
+	++data.search_index;
+	if (data.search_index == 0) {
+		//the search index wrapped around, so nodes from old searches could be mistaken for nodes of the current one
+		std::fill(search_nodes.begin(), search_nodes.end(), search_node());
+		data.search_index = 1;
+	}
+
+	const uint32_t search_index = data.search_index;
+
+	const auto get_node_key = [](const int cluster_index, const int node_index) {
+		return static_cast<uint32_t>(cluster_index * max_cluster_node_count + node_index);
+	};
+
+	open_set.clear();
+
+	const auto push_node = [&](const uint32_t key, const int cost, const uint32_t parent_key, const QPoint &pos) {
+		search_node &node = search_nodes[key];
+
+		if (node.search_index == search_index) {
+			if (node.closed || node.cost <= cost) {
+				return;
+			}
+		} else {
+			node.search_index = search_index;
+			node.closed = false;
+		}
+
+		node.cost = cost;
+		node.parent_key = parent_key;
+
+		const int cost_to_goal = get_chebyshev_distance(pos, goal_pos);
+		open_set.push(Vec2i(pos), key, cost + cost_to_goal, cost_to_goal, 0);
+	};
+
+	const cluster &start_cluster = this->clusters[start_cluster_index];
+	const QRect start_cluster_rect = this->get_cluster_rect(start_cluster_index);
+	for (size_t i = 0; i < start_cluster.nodes.size(); ++i) {
+		const QPoint &node_pos = start_cluster.nodes[i].pos;
+		const int cost = start_costs[(node_pos.y() - start_cluster_rect.y()) * start_cluster_rect.width() + (node_pos.x() - start_cluster_rect.x())];
+
+		if (cost != -1) {
+			push_node(get_node_key(start_cluster_index, static_cast<int>(i)), cost, no_parent_key, node_pos);
+		}
+	}
+
+	bool found = false;
+
+	while (!open_set.empty()) {
+		const uint32_t key = open_set.pop().offset;
+
+		if (key == goal_key) {
+			found = true;
+			break;
+		}
+
+		search_node &current = search_nodes[key];
+		if (current.closed) {
+			continue;
+		}
+
+		current.closed = true;
+		const int current_cost = current.cost;
+
+		const int cluster_index = static_cast<int>(key / max_cluster_node_count);
+		const int node_index = static_cast<int>(key % max_cluster_node_count);
+		const cluster &cluster = this->clusters[cluster_index];
+		const cluster_node &node = cluster.nodes[node_index];
+
+		if (cluster_index == goal_cluster_index) {
+			const int goal_cost = goal_costs[get_goal_cluster_local_index(node.pos)];
+
+			if (goal_cost != -1) {
+				push_node(goal_key, current_cost + goal_cost, key, goal_pos);
+			}
+		}
+
+		const size_t node_count = cluster.nodes.size();
+		for (size_t i = 0; i < node_count; ++i) {
+			const int edge_cost = cluster.edge_costs[node_index * node_count + i];
+
+			if (static_cast<int>(i) == node_index || edge_cost == -1) {
+				continue;
+			}
+
+			push_node(get_node_key(cluster_index, static_cast<int>(i)), current_cost + edge_cost, key, cluster.nodes[i].pos);
+		}
+
+		this->ensure_cluster(node.twin_cluster_index);
+		const int twin_node_index = this->get_node_index(node.twin_cluster_index, node.twin_pos, node.pos);
+		push_node(get_node_key(node.twin_cluster_index, twin_node_index), current_cost + node.twin_cost, key, node.twin_pos);
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	std::vector<QPoint> path;
+	for (uint32_t key = search_nodes[goal_key].parent_key; key != no_parent_key; key = search_nodes[key].parent_key) {
+		path.push_back(this->clusters[key / max_cluster_node_count].nodes[key % max_cluster_node_count].pos);
+	}
+	std::reverse(path.begin(), path.end());
+
+	bool has_waypoint = false;
+	for (const QPoint &path_pos : path) {
+		if (path_pos == start_pos) {
+			continue;
+		}
+
+		if (has_waypoint && get_chebyshev_distance(start_pos, path_pos) > max_waypoint_distance) {
+			break;
+		}
+
+		waypoint = path_pos;
+		has_waypoint = true;
+	}
+
+	return has_waypoint;
+}
+
+QRect cluster_graph::get_cluster_rect(const int cluster_index) const
+{
+	const int x = (cluster_index % this->cluster_width_count) * cluster_size;
+	const int y = (cluster_index / this->cluster_width_count) * cluster_size;
+
+	return QRect(x, y, std::min(cluster_size, this->width - x), std::min(cluster_size, this->height - y));
+}
+
+void cluster_graph::ensure_border(border &border, const QPoint &first_start_pos, const QPoint &second_start_pos, const QPoint &step)
+{
+	if (!border.dirty) {
+		return;
+	}
+
+	border.portals.clear();
+
+	const int length = step.x() != 0 ? std::min(cluster_size, this->width - first_start_pos.x()) : std::min(cluster_size, this->height - first_start_pos.y());
+
+	const auto add_entrance = [&](const int entrance_start, const int entrance_end) {
+		if (entrance_end - entrance_start + 1 > max_entrance_width) {
+			border.portals.emplace_back(first_start_pos + step * entrance_start, second_start_pos + step * entrance_start);
+			border.portals.emplace_back(first_start_pos + step * entrance_end, second_start_pos + step * entrance_end);
+		} else {
+			const int middle = (entrance_start + entrance_end) / 2;
+			border.portals.emplace_back(first_start_pos + step * middle, second_start_pos + step * middle);
+		}
+	};
+
+	int entrance_start = -1;
+	for (int i = 0; i < length; ++i) {
+		const bool passable = this->is_tile_passable(first_start_pos + step * i) && this->is_tile_passable(second_start_pos + step * i);
+
+		if (passable && entrance_start == -1) {
+			entrance_start = i;
+		} else if (!passable && entrance_start != -1) {
+			add_entrance(entrance_start, i - 1);
+			entrance_start = -1;
+		}
+	}
+
+	if (entrance_start != -1) {
+		add_entrance(entrance_start, length - 1);
+	}
+
+	border.dirty = false;
+}
+
+void cluster_graph::ensure_cluster(const int cluster_index)
+{
+	cluster &cluster = this->clusters[cluster_index];
+
+	if (!cluster.dirty.load(std::memory_order_acquire)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(this->build_mutex);
+
+	//the cluster may have been built by another search while waiting for the lock
+	if (!cluster.dirty.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	const int cluster_x = cluster_index % this->cluster_width_count;
+	const int cluster_y = cluster_index / this->cluster_width_count;
+
+	const auto ensure_horizontal_border = [this](const int border_index) -> const border & {
+		border &horizontal_border = this->horizontal_borders[border_index];
+		const QRect rect = this->get_cluster_rect(border_index);
+		this->ensure_border(horizontal_border, QPoint(rect.right(), rect.top()), QPoint(rect.right() + 1, rect.top()), QPoint(0, 1));
+		return horizontal_border;
+	};
+
+	const auto ensure_vertical_border = [this](const int border_index) -> const border & {
+		border &vertical_border = this->vertical_borders[border_index];
+		const QRect rect = this->get_cluster_rect(border_index);
+		this->ensure_border(vertical_border, QPoint(rect.left(), rect.bottom()), QPoint(rect.left(), rect.bottom() + 1), QPoint(1, 0));
+		return vertical_border;
+	};
+
+	cluster.nodes.clear();
+
+	if (cluster_x > 0) {
+		for (const auto &[first_pos, second_pos] : ensure_horizontal_border(cluster_index - 1).portals) {
+			cluster.nodes.push_back(cluster_node{ second_pos, cluster_index - 1, first_pos, this->get_tile_cost(first_pos) });
+		}
+	}
+
+	if (cluster_x < this->cluster_width_count - 1) {
+		for (const auto &[first_pos, second_pos] : ensure_horizontal_border(cluster_index).portals) {
+			cluster.nodes.push_back(cluster_node{ first_pos, cluster_index + 1, second_pos, this->get_tile_cost(second_pos) });
+		}
+	}
+
+	if (cluster_y > 0) {
+		for (const auto &[first_pos, second_pos] : ensure_vertical_border(cluster_index - this->cluster_width_count).portals) {
+			cluster.nodes.push_back(cluster_node{ second_pos, cluster_index - this->cluster_width_count, first_pos, this->get_tile_cost(first_pos) });
+		}
+	}
+
+	if (cluster_y < this->cluster_height_count - 1) {
+		for (const auto &[first_pos, second_pos] : ensure_vertical_border(cluster_index).portals) {
+			cluster.nodes.push_back(cluster_node{ first_pos, cluster_index + this->cluster_width_count, second_pos, this->get_tile_cost(second_pos) });
+		}
+	}
+
+	assert_throw(cluster.nodes.size() <= static_cast<size_t>(max_cluster_node_count));
+
+	const size_t node_count = cluster.nodes.size();
+	cluster.edge_costs.assign(node_count * node_count, -1);
+
+	const QRect rect = this->get_cluster_rect(cluster_index);
+	std::vector<int> tile_costs;
+	this->get_cluster_tile_costs(cluster_index, tile_costs);
+	std::vector<int> costs;
+
+	for (size_t i = 0; i < node_count; ++i) {
+		this->calculate_cluster_costs(cluster_index, tile_costs, cluster.nodes[i].pos, false, costs);
+
+		for (size_t j = 0; j < node_count; ++j) {
+			const QPoint &other_pos = cluster.nodes[j].pos;
+			cluster.edge_costs[i * node_count + j] = costs[(other_pos.y() - rect.y()) * rect.width() + (other_pos.x() - rect.x())];
+		}
+	}
+
+	cluster.dirty.store(false, std::memory_order_release);
+}
+
+void cluster_graph::invalidate_cluster(const int cluster_index)
+{
+	cluster &cluster = this->clusters[cluster_index];
+	cluster.dirty.store(true, std::memory_order_relaxed);
+	cluster.nodes.clear();
+	cluster.edge_costs.clear();
+}
+
+int cluster_graph::get_node_index(const int cluster_index, const QPoint &pos, const QPoint &twin_pos) const
+{
+	const std::vector<cluster_node> &nodes = this->clusters[cluster_index].nodes;
+
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		if (nodes[i].pos == pos && nodes[i].twin_pos == twin_pos) {
+			return static_cast<int>(i);
+		}
+	}
+
+	throw std::runtime_error("No node found for position " + std::to_string(pos.x()) + ", " + std::to_string(pos.y()) + " in cluster " + std::to_string(cluster_index) + ".");
+}
+
+void cluster_graph::get_cluster_tile_costs(const int cluster_index, std::vector<int> &tile_costs) const
+{
+	const QRect rect = this->get_cluster_rect(cluster_index);
+
+	tile_costs.resize(static_cast<size_t>(rect.width() * rect.height()));
+
+	size_t local_index = 0;
+	for (int y = rect.top(); y <= rect.bottom(); ++y) {
+		for (int x = rect.left(); x <= rect.right(); ++x) {
+			tile_costs[local_index] = this->get_tile_cost(QPoint(x, y));
+			++local_index;
+		}
+	}
+}
+
+void cluster_graph::calculate_cluster_costs(const int cluster_index, const std::vector<int> &tile_costs, const QPoint &source_pos, const bool reverse, std::vector<int> &costs) const
+{
+	static constexpr std::array<QPoint, 8> offsets = { QPoint(0, -1), QPoint(1, -1), QPoint(1, 0), QPoint(1, 1), QPoint(0, 1), QPoint(-1, 1), QPoint(-1, 0), QPoint(-1, -1) };
+
+	const QRect rect = this->get_cluster_rect(cluster_index);
+	const auto get_local_index = [&rect](const QPoint &pos) {
+		return (pos.y() - rect.y()) * rect.width() + (pos.x() - rect.x());
+	};
+
+	costs.assign(static_cast<size_t>(rect.width() * rect.height()), -1);
+
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+
+	costs[get_local_index(source_pos)] = 0;
+	queue.emplace(0, get_local_index(source_pos));
+
+	while (!queue.empty()) {
+		const auto [cost, local_index] = queue.top();
+		queue.pop();
+
+		if (cost > costs[local_index]) {
+			continue;
+		}
+
+		const QPoint pos(rect.x() + local_index % rect.width(), rect.y() + local_index / rect.width());
+
+		for (const QPoint &offset : offsets) {
+			const QPoint adjacent_pos = pos + offset;
+
+			if (!rect.contains(adjacent_pos)) {
+				continue;
+			}
+
+			const int adjacent_local_index = get_local_index(adjacent_pos);
+			if (tile_costs[adjacent_local_index] == -1) {
+				continue;
+			}
+
+			//when calculating costs towards the source, the cost of a step is that of entering the tile closer to the source
+			const int new_cost = cost + tile_costs[reverse ? local_index : adjacent_local_index];
+			int &adjacent_cost = costs[adjacent_local_index];
+
+			if (adjacent_cost == -1 || new_cost < adjacent_cost) {
+				adjacent_cost = new_cost;
+				queue.emplace(new_cost, adjacent_local_index);
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,114 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//an abstract graph of the clusters of a map layer, used for hierarchical pathfinding
+//neighboring clusters are connected through portal nodes placed on the passable segments of their shared borders; the graph is built lazily as searches touch it, and the parts affected by a change in the tiles are rebuilt on demand
+//searches may be run concurrently, as building a part of the graph is serialized; changes to the tiles (and the resulting invalidations) must not happen while searches are running
+class cluster_graph final
+{
+public:
+	static constexpr int cluster_size = 16;
+	static constexpr int max_entrance_width = 6; //entrances wider than this get a portal at each end, instead of a single one in the middle
+	static constexpr int max_cluster_node_count = cluster_size * 2; //a border has at most one entrance for every two tiles, each with a single portal if it is narrow
+
+	//the tile cost function gives the cost of entering a tile, or -1 if the tile is impassable
+	using tile_cost_function = std::function<int(const QPoint &)>;
+
+	explicit cluster_graph(const QSize &size, const tile_cost_function &get_tile_cost);
+
+	//invalidate the parts of the graph affected by a change in the passability or cost of a tile
+	void on_tile_changed(const QPoint &tile_pos);
+
+	//invalidate the whole graph
+	void invalidate();
+
+	//get the next waypoint to which a unit should move on the abstract path from the start to the goal; the waypoint is the farthest portal on the path within the given distance of the start position
+	//returns false if no abstract path was found, or if the start and goal are connected within the same cluster
+	bool find_waypoint(const QPoint &start_pos, const QPoint &goal_pos, const int max_waypoint_distance, QPoint &waypoint);
+
+private:
+	struct border final
+	{
+		bool dirty = true;
+		std::vector<std::pair<QPoint, QPoint>> portals; //the first position is in the left/top cluster, the second one in the right/bottom cluster
+	};
+
+	struct cluster_node final
+	{
+		QPoint pos;
+		int twin_cluster_index = -1;
+		QPoint twin_pos;
+		int twin_cost = 0; //the cost of crossing over to the twin node
+	};
+
+	struct cluster final
+	{
+		std::atomic<bool> dirty = true;
+		std::vector<cluster_node> nodes;
+		std::vector<int> edge_costs; //the cost of moving between each pair of nodes within the cluster, or -1 if they are not connected within it
+	};
+
+	int get_cluster_index(const QPoint &tile_pos) const
+	{
+		return (tile_pos.y() / cluster_size) * this->cluster_width_count + (tile_pos.x() / cluster_size);
+	}
+
+	QRect get_cluster_rect(const int cluster_index) const;
+
+	bool is_tile_passable(const QPoint &tile_pos) const
+	{
+		return this->get_tile_cost(tile_pos) != -1;
+	}
+
+	void ensure_border(border &border, const QPoint &first_start_pos, const QPoint &second_start_pos, const QPoint &step);
+	void ensure_cluster(const int cluster_index);
+	void invalidate_cluster(const int cluster_index);
+
+	int get_node_index(const int cluster_index, const QPoint &pos, const QPoint &twin_pos) const;
+
+	//get the cost of entering each tile of a cluster, or -1 for impassable tiles
+	void get_cluster_tile_costs(const int cluster_index, std::vector<int> &tile_costs) const;
+
+	//calculate the cost of moving from the source position to each tile of the cluster (or from each tile to the source position, if reverse is true), with -1 for unreachable tiles
+	void calculate_cluster_costs(const int cluster_index, const std::vector<int> &tile_costs, const QPoint &source_pos, const bool reverse, std::vector<int> &costs) const;
+
+	int width = 0;
+	int height = 0;
+	tile_cost_function get_tile_cost;
+	int cluster_width_count = 0;
+	int cluster_height_count = 0;
+	std::vector<cluster> clusters;
+	std::vector<border> horizontal_borders; //borders between a cluster and the one to its right
+	std::vector<border> vertical_borders; //borders between a cluster and the one below it
+	std::mutex build_mutex; //serializes building clusters and borders, which can happen during concurrent searches
+};
+
+}
@@ -0,0 +1,487 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/flow_field.h"
+
+#include "map/map.h"
+#include "map/map_layer.h"
+#include "player/player.h"
+#include "unit/unit.h"
+#include "unit/unit_type.h"
+#include "util/number_util.h"
+#include "util/util.h"
+
+namespace wyrmgus {
+
+//the key of a flow field in the cache: goal X and Y position, range, map layer, movement mask, index of the player whose explored terrain is used (-1 if all terrain is known) and whether tile movement costs are used
+using flow_field_key = std::tuple<int, int, int, int, tile_flag, int, bool>;
+
+//the flow fields in use, which are owned by the orders sharing them
+static std::map<flow_field_key, std::weak_ptr<flow_field>> flow_field_cache;
+
+//get the key of the flow field for a path finder input, or none if the input cannot be handled by a flow field
+static std::optional<flow_field_key> get_flow_field_key(const PathFinderInput &input)
+{
+	const CUnit *unit = input.GetUnit();
+
+	if (
+		unit == nullptr || input.GetUnitSize() != Vec2i(1, 1)
+		|| input.GetGoalSize() != Vec2i(0, 0) || input.GetMinRange() != 0
+	) {
+		return std::nullopt;
+	}
+
+	const CPlayer *player = AStarGetSearchPlayer(*unit);
+
+	return flow_field_key(input.GetGoalPos().x, input.GetGoalPos().y, input.GetMaxRange(), input.GetGoalMapLayer(), unit->Type->MovementMask, player != nullptr ? player->get_index() : -1, AStarUsesTileMovementCost(*unit));
+}
+
+flow_field *flow_field::get_for_order(std::shared_ptr<flow_field> &order_flow_field, const PathFinderInput &input)
+{
+	const std::optional<flow_field_key> input_key = get_flow_field_key(input);
+
+	if (!input_key.has_value()) {
+		order_flow_field.reset();
+		return nullptr;
+	}
+
+	const auto &[goal_x, goal_y, range, z, movement_mask, player_index, uses_tile_movement_cost] = input_key.value();
+
+	std::weak_ptr<flow_field> &cached_flow_field = flow_field_cache[input_key.value()];
+
+	if (order_flow_field == nullptr || order_flow_field != cached_flow_field.lock()) {
+		order_flow_field.reset();
+		order_flow_field = cached_flow_field.lock();
+
+		if (order_flow_field == nullptr) {
+			const CPlayer *player = player_index != -1 ? CPlayer::Players[player_index].get() : nullptr;
+			const CMapLayer *map_layer = CMap::get()->MapLayers[z].get();
+
+			order_flow_field = std::make_shared<flow_field>(map_layer->get_size(), input.GetGoalPos(), range, [z, movement_mask, player, uses_tile_movement_cost](const QPoint &tile_pos) {
+				return AStarGetTileTerrainCost(tile_pos, z, movement_mask, player, uses_tile_movement_cost);
+			});
+			cached_flow_field = order_flow_field;
+
+			std::erase_if(flow_field_cache, [](const auto &key_value_pair) {
+				return key_value_pair.second.expired();
+			});
+		}
+	}
+
+	//the orders sharing the field are the only owners of it, so its use count is the amount of orders using it
+	if (order_flow_field.use_count() < flow_field::min_user_count) {
+		return nullptr;
+	}
+
+	return order_flow_field.get();
+}
+
+bool flow_field::may_be_used_for_input(const PathFinderInput &input)
+{
+	const std::optional<flow_field_key> key = get_flow_field_key(input);
+
+	if (!key.has_value()) {
+		return false;
+	}
+
+	const auto find_iterator = flow_field_cache.find(key.value());
+	if (find_iterator == flow_field_cache.end()) {
+		return false;
+	}
+
+	//the order for the input may not be among the field's users yet, in which case it would become one
+	return find_iterator->second.use_count() + 1 >= flow_field::min_user_count;
+}
+
+void flow_field::on_tile_changed(const QPoint &tile_pos, const int z)
+{
+	for (const auto &[key, cached_flow_field] : flow_field_cache) {
+		if (std::get<3>(key) != z) {
+			continue;
+		}
+
+		const std::shared_ptr<flow_field> field = cached_flow_field.lock();
+		if (field == nullptr) {
+			continue;
+		}
+
+		field->on_tile_changed(tile_pos);
+	}
+}
+
+void flow_field::on_tile_explored(const QPoint &tile_pos, const int z, const CPlayer &player)
+{
+	for (const auto &[key, cached_flow_field] : flow_field_cache) {
+		if (std::get<3>(key) != z) {
+			continue;
+		}
+
+		const int field_player_index = std::get<5>(key);
+		if (field_player_index == -1) {
+			continue;
+		}
+
+		//the tiles explored by the player count as explored for those sharing vision with them
+		if (field_player_index != player.get_index() && !player.has_mutual_shared_vision_with(field_player_index) && !player.is_revealed()) {
+			continue;
+		}
+
+		const std::shared_ptr<flow_field> field = cached_flow_field.lock();
+		if (field == nullptr) {
+			continue;
+		}
+
+		field->on_tile_changed(tile_pos);
+	}
+}
+
+void flow_field::on_exploration_changed()
+{
+	for (const auto &[key, cached_flow_field] : flow_field_cache) {
+		if (std::get<5>(key) == -1) {
+			continue;
+		}
+
+		const std::shared_ptr<flow_field> field = cached_flow_field.lock();
+		if (field == nullptr) {
+			continue;
+		}
+
+		field->invalidate();
+	}
+}
+
+void flow_field::clear_cache()
+{
+	flow_field_cache.clear();
+}
+
+flow_field::flow_field(const QSize &size, const QPoint &goal_pos, const int range, const tile_cost_function &get_tile_cost)
+	: width(size.width()), height(size.height()), goal_pos(goal_pos), range(range), get_tile_cost(get_tile_cost)
+{
+}
+
+void flow_field::on_tile_changed(const QPoint &tile_pos)
+{
+	if (this->dirty) {
+		return;
+	}
+
+	if (static_cast<int>(this->changed_tiles.size()) >= flow_field::max_repaired_tile_count) {
+		this->invalidate();
+		return;
+	}
+
+	this->changed_tiles.push_back(this->get_tile_index(tile_pos));
+}
+
+int flow_field::find_path(const QPoint &start_pos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> &path)
+{
+	this->update();
+
+	const int start_index = this->get_tile_index(start_pos);
+	const int step_count = this->step_counts[start_index];
+
+	if (step_count == -1) {
+		return PF_FAILED;
+	}
+
+	if (step_count == 0) {
+		return PF_REACHED;
+	}
+
+	const int path_length = std::min<int>(step_count, path.size());
+
+	QPoint pos = start_pos;
+	for (int i = 0; i < path_length; ++i) {
+		const char direction = this->directions[this->get_tile_index(pos)];
+		path[path_length - i - 1] = direction;
+		pos += QPoint(Heading2X[direction], Heading2Y[direction]);
+	}
+
+	return step_count;
+}
+
+int flow_field::get_path_cost(const QPoint &tile_pos)
+{
+	this->update();
+
+	return this->costs[this->get_tile_index(tile_pos)];
+}
+
+void flow_field::update()
+{
+	if (this->dirty) {
+		this->build();
+	} else if (!this->changed_tiles.empty()) {
+		this->repair();
+	}
+}
+
+void flow_field::build()
+{
+	const size_t tile_count = static_cast<size_t>(this->width * this->height);
+
+	this->tile_costs.resize(tile_count);
+	for (size_t i = 0; i < tile_count; ++i) {
+		this->tile_costs[i] = this->get_tile_cost(this->get_tile_pos(static_cast<int>(i)));
+	}
+
+	this->costs.assign(tile_count, -1);
+	this->directions.assign(tile_count, 0);
+	this->step_counts.assign(tile_count, -1);
+
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+
+	const QRect goal_rect(this->goal_pos - QPoint(this->range, this->range), this->goal_pos + QPoint(this->range, this->range));
+
+	for (int x = std::max(0, goal_rect.left()); x <= std::min(this->width - 1, goal_rect.right()); ++x) {
+		for (int y = std::max(0, goal_rect.top()); y <= std::min(this->height - 1, goal_rect.bottom()); ++y) {
+			const QPoint tile_pos(x, y);
+			const int tile_index = this->get_tile_index(tile_pos);
+
+			if (!this->is_in_goal(tile_pos) || this->tile_costs[tile_index] == -1) {
+				continue;
+			}
+
+			this->costs[tile_index] = 0;
+			this->step_counts[tile_index] = 0;
+			queue.emplace(0, tile_index);
+		}
+	}
+
+	this->propagate(queue);
+
+	this->dirty = false;
+	this->changed_tiles.clear();
+}
+
+void flow_field::repair()
+{
+	std::sort(this->changed_tiles.begin(), this->changed_tiles.end());
+	this->changed_tiles.erase(std::unique(this->changed_tiles.begin(), this->changed_tiles.end()), this->changed_tiles.end());
+
+	static constexpr uint8_t unknown_status = 0;
+	static constexpr uint8_t unaffected_status = 1;
+	static constexpr uint8_t affected_status = 2;
+	static constexpr uint8_t costlier_status = 3;
+
+	std::vector<uint8_t> statuses;
+	bool has_costlier_tiles = false;
+
+	for (const int tile_index : this->changed_tiles) {
+		const int old_tile_cost = this->tile_costs[tile_index];
+		const int new_tile_cost = this->get_tile_cost(this->get_tile_pos(tile_index));
+		this->tile_costs[tile_index] = new_tile_cost;
+
+		if (old_tile_cost != -1 && (new_tile_cost == -1 || new_tile_cost > old_tile_cost)) {
+			if (!has_costlier_tiles) {
+				statuses.resize(this->costs.size(), unknown_status);
+				has_costlier_tiles = true;
+			}
+
+			statuses[tile_index] = costlier_status;
+		}
+	}
+
+	//the tiles whose paths go through a tile which became costlier to enter need to have their paths found anew
+	std::vector<int> affected_tiles;
+
+	if (has_costlier_tiles) {
+		std::vector<int> chain;
+
+		for (int tile_index = 0; tile_index < static_cast<int>(this->costs.size()); ++tile_index) {
+			if (this->costs[tile_index] == -1 || statuses[tile_index] == unaffected_status || statuses[tile_index] == affected_status) {
+				continue;
+			}
+
+			//follow the path from the tile until reaching the goal or a tile whose status is known, and then give that status to the whole chain
+			chain.clear();
+			int current_index = tile_index;
+			uint8_t status = unaffected_status;
+
+			while (this->step_counts[current_index] != 0) {
+				chain.push_back(current_index);
+
+				const char direction = this->directions[current_index];
+				const int next_index = this->get_tile_index(this->get_tile_pos(current_index) + QPoint(Heading2X[direction], Heading2Y[direction]));
+
+				if (statuses[next_index] == costlier_status || statuses[next_index] == affected_status) {
+					status = affected_status;
+					break;
+				} else if (statuses[next_index] == unaffected_status) {
+					break;
+				}
+
+				current_index = next_index;
+			}
+
+			if (chain.empty()) {
+				//a goal tile
+				chain.push_back(tile_index);
+			}
+
+			for (const int chain_index : chain) {
+				if (statuses[chain_index] == costlier_status) {
+					//a tile which became costlier to enter can only be the start of a chain, and it keeps its path unless that is affected, or unless it became impassable
+					if (status == affected_status || this->tile_costs[chain_index] == -1) {
+						affected_tiles.push_back(chain_index);
+					}
+					continue;
+				}
+
+				statuses[chain_index] = status;
+
+				if (status == affected_status) {
+					affected_tiles.push_back(chain_index);
+				}
+			}
+		}
+
+		for (const int tile_index : affected_tiles) {
+			this->costs[tile_index] = -1;
+			this->step_counts[tile_index] = -1;
+		}
+	}
+
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+
+	//the affected tiles get the best path through their unaffected neighbors, from which the paths are then propagated
+	for (const int tile_index : affected_tiles) {
+		if (this->set_from_neighbors(tile_index)) {
+			queue.emplace(this->costs[tile_index], tile_index);
+		}
+	}
+
+	//the tiles which became cheaper to enter may offer better paths to the tiles around them
+	for (const int tile_index : this->changed_tiles) {
+		if (this->costs[tile_index] == -1 && !this->set_from_neighbors(tile_index)) {
+			continue;
+		}
+
+		queue.emplace(this->costs[tile_index], tile_index);
+	}
+
+	this->propagate(queue);
+
+	this->changed_tiles.clear();
+}
+
+void flow_field::propagate(std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> &queue)
+{
+	while (!queue.empty()) {
+		const auto [cost, tile_index] = queue.top();
+		queue.pop();
+
+		if (cost > this->costs[tile_index]) {
+			continue;
+		}
+
+		const QPoint pos = this->get_tile_pos(tile_index);
+
+		//the cost of a step is that of entering the tile closer to the goal, as with A*
+		const int step_cost = this->tile_costs[tile_index];
+
+		for (int i = 0; i < 8; ++i) {
+			//the tiles around are reached from this one by moving in the opposite direction of the heading
+			const QPoint adjacent_pos(pos.x() - Heading2X[i], pos.y() - Heading2Y[i]);
+
+			if (!this->contains(adjacent_pos)) {
+				continue;
+			}
+
+			const int adjacent_index = this->get_tile_index(adjacent_pos);
+
+			if (this->tile_costs[adjacent_index] == -1) {
+				continue;
+			}
+
+			const int new_cost = cost + step_cost;
+			int &adjacent_cost = this->costs[adjacent_index];
+
+			if (adjacent_cost == -1 || new_cost < adjacent_cost) {
+				adjacent_cost = new_cost;
+				this->directions[adjacent_index] = static_cast<char>(i);
+				this->step_counts[adjacent_index] = this->step_counts[tile_index] + 1;
+				queue.emplace(new_cost, adjacent_index);
+			}
+		}
+	}
+}
+
+//set the path of a passable tile to the goal, if it is in it, or to the best one through its neighbors; returns false if no path was found
+bool flow_field::set_from_neighbors(const int tile_index)
+{
+	if (this->tile_costs[tile_index] == -1) {
+		return false;
+	}
+
+	const QPoint pos = this->get_tile_pos(tile_index);
+
+	if (this->is_in_goal(pos)) {
+		this->costs[tile_index] = 0;
+		this->step_counts[tile_index] = 0;
+		return true;
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		const QPoint adjacent_pos(pos.x() + Heading2X[i], pos.y() + Heading2Y[i]);
+
+		if (!this->contains(adjacent_pos)) {
+			continue;
+		}
+
+		const int adjacent_index = this->get_tile_index(adjacent_pos);
+		const int adjacent_cost = this->costs[adjacent_index];
+
+		if (adjacent_cost == -1) {
+			continue;
+		}
+
+		const int new_cost = adjacent_cost + this->tile_costs[adjacent_index];
+
+		if (this->costs[tile_index] == -1 || new_cost < this->costs[tile_index]) {
+			this->costs[tile_index] = new_cost;
+			this->directions[tile_index] = static_cast<char>(i);
+			this->step_counts[tile_index] = this->step_counts[adjacent_index] + 1;
+		}
+	}
+
+	return this->costs[tile_index] != -1;
+}
+
+bool flow_field::is_in_goal(const QPoint &tile_pos) const
+{
+	//the same range check as made by A* for simple paths
+	const QPoint diff = tile_pos - this->goal_pos;
+	const int distance = number::sqrt(square(diff.x()) + square(diff.y()));
+	return distance <= this->range;
+}
+
+}
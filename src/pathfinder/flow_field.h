@@ -0,0 +1,133 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "pathfinder/pathfinder.h"
+
+class CPlayer;
+
+namespace wyrmgus {
+
+enum class tile_flag : uint32_t;
+
+//a flow field towards a goal on a map layer for a given movement mask, shared by the orders of units moving to the same destination
+//the field is built with a single Dijkstra pass from the goal over the map layer, after which units only need to follow the direction stored for their tile, instead of each running its own A* search
+//the terrain costs are the same as those used by A* for the terrain, on the terrain explored by the player if any; changes to tiles are repaired on the next use of the field, only for the part of it whose paths are affected
+class flow_field final
+{
+public:
+	static constexpr int min_user_count = 8; //the minimum amount of orders sharing a flow field for it to be used instead of individual searches
+	static constexpr int max_repaired_tile_count = 256; //the maximum amount of changed tiles to be repaired, beyond which the field is rebuilt instead
+
+	//the tile cost function gives the cost of entering a tile, or -1 if the tile is impassable
+	using tile_cost_function = std::function<int(const QPoint &)>;
+
+	//get the flow field for the path finder input of an order, updating the order's reference to it
+	//returns null if the input cannot be handled by a flow field, or if the field is not shared by enough orders to be worth building
+	static flow_field *get_for_order(std::shared_ptr<flow_field> &order_flow_field, const PathFinderInput &input);
+
+	//check whether the path for a path finder input may be found with a shared flow field, without changing any order's reference or the field cache
+	static bool may_be_used_for_input(const PathFinderInput &input);
+
+	//notify the flow fields of a change in the terrain passability or movement cost of a tile
+	static void on_tile_changed(const QPoint &tile_pos, const int z);
+
+	//notify the flow fields of a tile having been explored by a player
+	static void on_tile_explored(const QPoint &tile_pos, const int z, const CPlayer &player);
+
+	//notify the flow fields of the exploration of the map having changed as a whole
+	static void on_exploration_changed();
+
+	static void clear_cache();
+
+	explicit flow_field(const QSize &size, const QPoint &goal_pos, const int range, const tile_cost_function &get_tile_cost);
+
+	const QPoint &get_goal_pos() const
+	{
+		return this->goal_pos;
+	}
+
+	int get_range() const
+	{
+		return this->range;
+	}
+
+	//mark a tile as having changed, for the field to be repaired around it on its next use
+	void on_tile_changed(const QPoint &tile_pos);
+
+	//mark the whole field as needing to be rebuilt
+	void invalidate()
+	{
+		this->dirty = true;
+		this->changed_tiles.clear();
+	}
+
+	//follow the field from the start position, saving the steps in the path in the same (reversed) order as A* does
+	//returns the length of the whole path to the goal, PF_REACHED if the start position is already in the goal, or PF_FAILED if the goal cannot be reached from it
+	int find_path(const QPoint &start_pos, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> &path);
+
+	//get the cost of the path from a tile to the goal, or -1 if the goal cannot be reached from it
+	int get_path_cost(const QPoint &tile_pos);
+
+private:
+	void update();
+	void build();
+	void repair();
+	void propagate(std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> &queue);
+	bool set_from_neighbors(const int tile_index);
+	bool is_in_goal(const QPoint &tile_pos) const;
+
+	int get_tile_index(const QPoint &tile_pos) const
+	{
+		return tile_pos.y() * this->width + tile_pos.x();
+	}
+
+	QPoint get_tile_pos(const int tile_index) const
+	{
+		return QPoint(tile_index % this->width, tile_index / this->width);
+	}
+
+	bool contains(const QPoint &tile_pos) const
+	{
+		return tile_pos.x() >= 0 && tile_pos.x() < this->width && tile_pos.y() >= 0 && tile_pos.y() < this->height;
+	}
+
+	int width = 0;
+	int height = 0;
+	QPoint goal_pos;
+	int range = 0;
+	tile_cost_function get_tile_cost;
+	bool dirty = true;
+	std::vector<int> changed_tiles; //the indexes of the tiles changed since the field was last updated
+	std::vector<int> tile_costs; //the cost of entering each tile when the field was last updated, or -1 if the tile was impassable
+	std::vector<int> costs; //the cost of the path from each tile to the goal, or -1 if the goal cannot be reached from the tile
+	std::vector<char> directions; //the heading to take from each tile towards the goal
+	std::vector<int> step_counts; //the amount of steps from each tile to the goal, or -1 if the goal cannot be reached from the tile
+};
+
+}
@@ -28,7 +28,10 @@
 
 #include "pathfinder/pathfinder.h"
 
+#include "pathfinder/flow_field.h"
+
 #include "actions.h"
+#include "animation/animation_set.h"
 #include "map/landmass.h"
 #include "map/map.h"
 #include "map/map_info.h"
@@ -41,6 +44,7 @@
 #include "util/log_util.h"
 #include "util/rect_util.h"
 #include "util/size_util.h"
+#include "util/thread_pool.h"
 
 //astar.cpp
 
@@ -53,32 +57,96 @@ extern void InitAStar();
 /// free the a* data structures
 extern void FreeAStar();
 
+TerrainTraversal::TerrainTraversal()
+{
+}
+
+TerrainTraversal::~TerrainTraversal()
+{
+	if (this->m_storage != nullptr) {
+		TerrainTraversal::get_free_storages().push_back(std::move(this->m_storage));
+	}
+}
+
+std::vector<std::unique_ptr<TerrainTraversal::traversal_storage>> &TerrainTraversal::get_free_storages()
+{
+	//the storages not in use by a traversal of the thread; there can be more than one, since traversals can be nested
+	static thread_local std::vector<std::unique_ptr<traversal_storage>> free_storages;
+	return free_storages;
+}
+
 void TerrainTraversal::SetSize(unsigned int width, unsigned int height)
 {
-	m_values.resize((width + 2) * (height + 2));
-	m_extented_width = width + 2;
-	m_height = height;
+	const unsigned int extended_width = width + 2;
+
+	if (this->m_storage == nullptr) {
+		std::vector<std::unique_ptr<traversal_storage>> &free_storages = TerrainTraversal::get_free_storages();
+
+		if (!free_storages.empty()) {
+			//prefer a storage already used for a map layer of the same size
+			auto find_iterator = std::find_if(free_storages.begin(), free_storages.end(), [extended_width, height](const std::unique_ptr<traversal_storage> &free_storage) {
+				return free_storage->extended_width == extended_width && free_storage->height == height;
+			});
+
+			if (find_iterator == free_storages.end()) {
+				find_iterator = free_storages.end() - 1;
+			}
+
+			this->m_storage = std::move(*find_iterator);
+			free_storages.erase(find_iterator);
+		} else {
+			this->m_storage = std::make_unique<traversal_storage>();
+		}
+	}
+
+	traversal_storage &storage = *this->m_storage;
+
+	if (storage.extended_width == extended_width && storage.height == height) {
+		return;
+	}
+
+	storage.nodes.assign(extended_width * (height + 2), tile_node());
+	storage.extended_width = extended_width;
+	storage.height = height;
+	storage.generation = 0;
+
+	//the border nodes are invalid in every search
+	for (unsigned int x = 0; x < extended_width; ++x) {
+		storage.nodes[x] = tile_node{ TerrainTraversal::border_generation, -1 };
+		storage.nodes[(height + 1) * extended_width + x] = tile_node{ TerrainTraversal::border_generation, -1 };
+	}
+
+	for (unsigned int y = 1; y < height + 1; ++y) {
+		storage.nodes[y * extended_width] = tile_node{ TerrainTraversal::border_generation, -1 };
+		storage.nodes[y * extended_width + width + 1] = tile_node{ TerrainTraversal::border_generation, -1 };
+	}
 }
 
 void TerrainTraversal::Init()
 {
-	const unsigned int height = m_height;
-	const unsigned int width = m_extented_width - 2;
-	const unsigned int width_ext = m_extented_width;
+	traversal_storage &storage = *this->m_storage;
+
+	++storage.generation;
 
-	memset(&m_values[0], '\xFF', width_ext * sizeof(dataType));
-	for (unsigned i = 1; i < 1 + height; ++i) {
-		m_values[i * width_ext] = -1;
-		memset(&m_values[i * width_ext + 1], '\0', width * sizeof(dataType));
-		m_values[i * width_ext + width + 1] = -1;
+	if (storage.generation == TerrainTraversal::border_generation) {
+		//the generation counter has wrapped around, so the nodes of the map itself need to be cleared
+		for (tile_node &node : storage.nodes) {
+			if (node.generation != TerrainTraversal::border_generation) {
+				node = TerrainTraversal::tile_node();
+			}
+		}
+
+		storage.generation = 1;
 	}
-	memset(&m_values[(height + 1) * width_ext], '\xFF', width_ext * sizeof(dataType));
+
+	storage.queue.clear();
+	storage.queue_front = 0;
 }
 
 void TerrainTraversal::PushPos(const Vec2i &pos)
 {
 	if (IsVisited(pos) == false) {
-		m_queue.push(PosNode(pos, pos));
+		this->m_storage->queue.push_back(PosNode(pos, pos));
 		Set(pos, 1);
 	}
 }
@@ -100,7 +168,7 @@ void TerrainTraversal::PushNeighbor(const Vec2i &pos)
 		const Vec2i newPos = pos + offset;
 
 		if (IsVisited(newPos) == false) {
-			m_queue.push(PosNode(newPos, pos));
+			this->m_storage->queue.push_back(PosNode(newPos, pos));
 			Set(newPos, Get(pos) + 1);
 		}
 	}
@@ -215,16 +283,6 @@ bool TerrainTraversal::IsInvalid(const Vec2i &pos) const
 	return Get(pos) != -1;
 }
 
-TerrainTraversal::dataType TerrainTraversal::Get(const Vec2i &pos) const
-{
-	return m_values[m_extented_width + 1 + pos.y * m_extented_width + pos.x];
-}
-
-void TerrainTraversal::Set(const Vec2i &pos, TerrainTraversal::dataType value)
-{
-	m_values[m_extented_width + 1 + pos.y * m_extented_width + pos.x] = value;
-}
-
 /**
 **  Init the pathfinder
 */
@@ -447,6 +505,7 @@ void PathFinderInput::SetGoal(const Vec2i &pos, const Vec2i &size, int z)
 	}
 	goalPos = newPos;
 	goalSize = size;
+	goal_flow_field = nullptr;
 	//Wyrmgus start
 	MapLayer = z;
 	//Wyrmgus end
@@ -475,6 +534,76 @@ void PathFinderInput::PathRacalculated()
 	isRecalculatePathNeeded = false;
 }
 
+/**
+**  Check whether a path calculated in advance can be used for the current path request of a unit.
+**
+**  Besides the request having to be the same, no tile must have changed its passability in the
+**  meantime, and none of the tiles evaluated by the search may have gained or lost a unit, as
+**  units handled earlier in the cycle may have moved or placed buildings, which could have
+**  changed the path found, not just the tiles along it.
+*/
+static bool HasPrecalculatedPath(const PathFinderData &data)
+{
+	if (!data.has_precalculated_path || data.precalculated_cycle != GameCycle) {
+		return false;
+	}
+
+	const PathFinderInput &input = data.input;
+	const PathFinderInput &precalculated_input = data.precalculated_input;
+
+	if (
+		data.precalculated_start_pos != input.GetUnitPos()
+		|| precalculated_input.GetGoalPos() != input.GetGoalPos()
+		|| precalculated_input.GetGoalSize() != input.GetGoalSize()
+		|| precalculated_input.GetGoalMapLayer() != input.GetGoalMapLayer()
+		|| precalculated_input.GetMinRange() != input.GetMinRange()
+		|| precalculated_input.GetMaxRange() != input.GetMaxRange()
+		|| precalculated_input.GetUnitSize() != input.GetUnitSize()
+	) {
+		return false;
+	}
+
+	//a path along a shared flow field would be taken instead
+	if (input.get_flow_field() != nullptr) {
+		return false;
+	}
+
+	if (data.precalculated_passability_generation != AStarGetPassabilityGeneration()) {
+		return false;
+	}
+
+	return AStarSearchDependenciesUnchanged(data.precalculated_dependencies, *input.GetUnit(), input.GetGoalMapLayer());
+}
+
+/**
+**  Find a path for a unit by following the flow field of its goal.
+**
+**  @return  _move_return_ or the path length, or PF_FAILED if a regular search is needed
+*/
+static int FindFlowFieldPath(const PathFinderInput &input, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> &path)
+{
+	const CUnit &unit = *input.GetUnit();
+	flow_field *field = input.get_flow_field();
+
+	if (field->get_map_layer() != unit.MapLayer->ID) {
+		return PF_FAILED;
+	}
+
+	const int result = field->find_path(unit.tilePos, path);
+
+	if (result > 0) {
+		//the field only takes terrain and buildings into account, so if the next step is blocked by another unit, a regular search is made to find a way around it
+		const char direction = path[std::min<int>(result, PathFinderOutput::MAX_PATH_LENGTH) - 1];
+		const Vec2i next_pos(unit.tilePos.x + Heading2X[direction], unit.tilePos.y + Heading2Y[direction]);
+
+		if (!UnitCanBeAt(unit, next_pos, unit.MapLayer->ID)) {
+			return PF_FAILED;
+		}
+	}
+
+	return result;
+}
+
 /**
 **  Find new path.
 **
@@ -488,18 +617,35 @@ void PathFinderInput::PathRacalculated()
 **  @return      >0 remaining path length, 0 wait for path, -1
 **               reached goal, -2 can't reach the goal.
 */
-static int NewPath(PathFinderInput &input, PathFinderOutput &output)
-{
-	int i = AStarFindPath(input.GetUnitPos(),
-						  input.GetGoalPos(),
-						  input.GetGoalSize().x, input.GetGoalSize().y,
-						  input.GetUnitSize().x, input.GetUnitSize().y,
-						  input.GetMinRange(), input.GetMaxRange(),
-						  &output.Path,
-						  //Wyrmgus start
-//						  *input.GetUnit());
-						  *input.GetUnit(), 0, input.GetGoalMapLayer());
-						  //Wyrmgus end
+static int NewPath(PathFinderData &data)
+{
+	PathFinderInput &input = data.input;
+	PathFinderOutput &output = data.output;
+
+	int i = PF_FAILED;
+	if (HasPrecalculatedPath(data)) {
+		i = data.precalculated_result;
+		output.Path = data.precalculated_path;
+	} else {
+		if (input.get_flow_field() != nullptr) {
+			i = FindFlowFieldPath(input, output.Path);
+		}
+
+		if (i == PF_FAILED) {
+			i = AStarFindPath(input.GetUnitPos(),
+							  input.GetGoalPos(),
+							  input.GetGoalSize().x, input.GetGoalSize().y,
+							  input.GetUnitSize().x, input.GetUnitSize().y,
+							  input.GetMinRange(), input.GetMaxRange(),
+							  &output.Path,
+							  //Wyrmgus start
+//							  *input.GetUnit());
+							  *input.GetUnit(), 0, input.GetGoalMapLayer());
+							  //Wyrmgus end
+		}
+	}
+	data.has_precalculated_path = false;
+
 	input.PathRacalculated();
 	if (i == PF_FAILED) {
 		i = PF_UNREACHABLE;
@@ -538,7 +684,7 @@ int NextPathElement(CUnit &unit, int &pxd, int &pyd)
 
 	// Goal has moved, need to recalculate path or no cached path
 	if (output.Length <= 0 || input.IsRecalculateNeeded()) {
-		const int result = NewPath(input, output);
+		const int result = NewPath(*unit.pathFinderData);
 
 		if (result == PF_UNREACHABLE) {
 			output.Length = 0;
@@ -567,7 +713,7 @@ int NextPathElement(CUnit &unit, int &pxd, int &pyd)
 		}
 		if (output.Fast == 0 && result != 0) {
 			AstarDebugPrint("WAIT expired\n");
-			result = NewPath(input, output);
+			result = NewPath(*unit.pathFinderData);
 			if (result > 0) {
 				pxd = Heading2X[(int)output.Path[(int)output.Length - 1]];
 				pyd = Heading2Y[(int)output.Path[(int)output.Length - 1]];
@@ -588,3 +734,162 @@ int NextPathElement(CUnit &unit, int &pxd, int &pyd)
 	}
 	return result;
 }
+
+/**
+**  Check whether a unit will look for a path when its actions are handled this cycle, so that the path can be calculated in advance.
+**
+**  Only units about to take their next step with an order moving them towards a valid goal are considered.
+**  Units larger than a tile are left out, as their own tiles lie along their path, so it could not be checked
+**  for changes in occupancy once they have been unmarked from the map to move.
+*/
+static bool CanPrecalculatePath(const CUnit &unit)
+{
+	if (unit.Destroyed || !unit.IsAliveOnMap() || unit.Moving || !unit.CanMove()) {
+		return false;
+	}
+
+	if (unit.pathFinderData == nullptr || unit.pathFinderData->input.GetUnit() != &unit || unit.Orders.empty()) {
+		return false;
+	}
+
+	if (unit.Type->get_tile_size() != QSize(1, 1)) {
+		return false;
+	}
+
+	//units which are waiting, or in the middle of their move animation, don't take a step this cycle
+	if (unit.Wait != 0 || (unit.get_animation_set()->Move == unit.Anim.CurrAnim && unit.Anim.Wait)) {
+		return false;
+	}
+
+	//the current order will be replaced or finished before it is executed
+	if (unit.CriticalOrder != nullptr || unit.CurrentOrder()->Finished) {
+		return false;
+	}
+
+	const COrder *order = unit.CurrentOrder();
+
+	if (order->has_goal() && !order->get_goal()->IsAliveOnMap()) {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+**  Calculate in parallel the paths which the units will need this cycle.
+**
+**  The path requests are gathered from the units' path finder data, and then solved by
+**  the pathfinding workers, each with its own search context. As the map and units are
+**  not modified while the paths are calculated, the results do not depend on the amount
+**  of workers, and they are applied back in unit slot order, so the game state stays
+**  the same for any thread count.
+**
+**  @param units  The units for which to calculate paths.
+*/
+void CalculatePendingPaths(const std::vector<CUnit *> &units)
+{
+	struct path_request final
+	{
+		CUnit *unit = nullptr;
+		PathFinderInput input;
+		int result = PF_FAILED;
+		std::array<char, PathFinderOutput::MAX_PATH_LENGTH> path{};
+		astar_search_dependencies dependencies;
+	};
+
+	//the occupancy changes made after the paths are calculated are checked against the tiles each search depended on
+	AStarStartOccupancyChangeLog();
+
+	std::vector<path_request> requests;
+
+	for (CUnit *unit : units) {
+		if (!CanPrecalculatePath(*unit)) {
+			continue;
+		}
+
+		//update a copy of the input with the order's goal, leaving the unit and its order as they are, so that gathering the requests has no effect on the game state
+		PathFinderInput input = unit->pathFinderData->input;
+		if (!unit->CurrentOrder()->update_path_finder_goal(input)) {
+			continue;
+		}
+
+		//only units which have run out of path, or whose goal has changed, look for a new one
+		if (unit->pathFinderData->output.Length > 0 && !input.IsRecalculateNeeded()) {
+			continue;
+		}
+
+		if (input.GetGoalMapLayer() != unit->MapLayer->ID) {
+			continue;
+		}
+
+		//paths along a shared flow field are cheap to find, and building the field is not thread-safe
+		if (flow_field::may_be_used_for_input(input)) {
+			continue;
+		}
+
+		path_request &request = requests.emplace_back();
+		request.unit = unit;
+		request.input = input;
+	}
+
+	if (requests.empty()) {
+		return;
+	}
+
+	std::sort(requests.begin(), requests.end(), [](const path_request &lhs, const path_request &rhs) {
+		return UnitNumber(*lhs.unit) < UnitNumber(*rhs.unit);
+	});
+
+	const int worker_count = std::min<int>(AStarThreadCount, static_cast<int>(requests.size()));
+	AStarPrepareWorkers(worker_count);
+
+	std::atomic<size_t> next_request_index = 0;
+
+	const auto solve_requests = [&requests, &next_request_index](const int worker_index) {
+		for (size_t i = next_request_index++; i < requests.size(); i = next_request_index++) {
+			path_request &request = requests[i];
+			const PathFinderInput &input = request.input;
+
+			request.result = AStarFindPath(input.GetUnitPos(),
+										   input.GetGoalPos(),
+										   input.GetGoalSize().x, input.GetGoalSize().y,
+										   input.GetUnitSize().x, input.GetUnitSize().y,
+										   input.GetMinRange(), input.GetMaxRange(),
+										   &request.path,
+										   *input.GetUnit(), 0, input.GetGoalMapLayer(), worker_index, &request.dependencies);
+		}
+	};
+
+	std::vector<std::future<void>> futures;
+	for (int worker_index = 1; worker_index < worker_count; ++worker_index) {
+		futures.push_back(thread_pool::get()->co_spawn_future([&solve_requests, worker_index]() -> boost::asio::awaitable<void> {
+			solve_requests(worker_index);
+			co_return;
+		}));
+	}
+
+	solve_requests(0);
+
+	for (std::future<void> &future : futures) {
+		future.get();
+	}
+
+	const unsigned long passability_generation = AStarGetPassabilityGeneration();
+
+	for (path_request &request : requests) {
+		//only paths which could still be found the same way when the unit takes its step are kept, as the reasons for a search failing may be anywhere on the map
+		if (request.result <= 0 && request.result != PF_REACHED) {
+			continue;
+		}
+
+		PathFinderData &data = *request.unit->pathFinderData;
+		data.has_precalculated_path = true;
+		data.precalculated_cycle = GameCycle;
+		data.precalculated_start_pos = request.unit->tilePos;
+		data.precalculated_input = request.input;
+		data.precalculated_result = request.result;
+		data.precalculated_path = request.path;
+		data.precalculated_passability_generation = passability_generation;
+		data.precalculated_dependencies = std::move(request.dependencies);
+	}
+}
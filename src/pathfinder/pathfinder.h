@@ -35,11 +35,13 @@
 #include "util/assert_util.h"
 #include "vec2i.h"
 
+class CPlayer;
 class CUnit;
 class CFile;
 struct lua_State;
 
 namespace wyrmgus {
+	class flow_field;
 	enum class tile_flag : uint32_t;
 }
 
@@ -77,6 +79,16 @@ public:
 	int GetMaxRange() const { return maxRange; }
 	bool IsRecalculateNeeded() const { return isRecalculatePathNeeded; }
 
+	wyrmgus::flow_field *get_flow_field() const
+	{
+		return this->goal_flow_field;
+	}
+
+	void set_flow_field(wyrmgus::flow_field *flow_field)
+	{
+		this->goal_flow_field = flow_field;
+	}
+
 	void SetUnit(CUnit &_unit);
 	//Wyrmgus start
 //	void SetGoal(const Vec2i &pos, const Vec2i &size);
@@ -101,6 +113,7 @@ private:
 	int MapLayer = 0;
 	//Wyrmgus end
 	bool isRecalculatePathNeeded = true;
+	wyrmgus::flow_field *goal_flow_field = nullptr; //the flow field shared by the unit's order with those of other units moving to the same goal; set together with the goal, as it is owned by the order
 };
 
 class PathFinderOutput final
@@ -117,11 +130,74 @@ public:
 	std::array<char, MAX_PATH_LENGTH> Path{}; /// directions of stored path
 };
 
+//what an A* search depended on besides the terrain and exploration, which are tracked by the passability generation
+//used to check whether a path calculated in advance is still the one which a new search would find
+class astar_search_dependencies final
+{
+public:
+	//a unit occupying a searched tile, which may be crossed if it is moving
+	struct crossed_unit final
+	{
+		unsigned int tile_index = 0;
+		const CUnit *unit = nullptr;
+		bool moving = false;
+	};
+
+	//the parts of the searching unit's movement costs which don't depend on the tile
+	struct unit_costs final
+	{
+		bool operator ==(const unit_costs &rhs) const = default;
+
+		const CPlayer *player = nullptr;
+		tile_flag movement_mask{};
+		Vec2i tile_size;
+		bool uses_tile_movement_cost = false;
+		int rail_speed_bonus = 0;
+		bool avoids_desert = false;
+	};
+
+	void clear()
+	{
+		this->min_pos = Vec2i(std::numeric_limits<int>::max(), std::numeric_limits<int>::max());
+		this->max_pos = Vec2i(-1, -1);
+		this->crossed_units.clear();
+	}
+
+	//add a tile whose cost has been evaluated, covering the tiles of the unit's size from it
+	void add_searched_tile(const Vec2i &pos, const Vec2i &tile_size)
+	{
+		this->min_pos.x = std::min(this->min_pos.x, pos.x);
+		this->min_pos.y = std::min(this->min_pos.y, pos.y);
+		this->max_pos.x = std::max(this->max_pos.x, pos.x + tile_size.x - 1);
+		this->max_pos.y = std::max(this->max_pos.y, pos.y + tile_size.y - 1);
+	}
+
+	bool is_searched_tile(const Vec2i &pos) const
+	{
+		return pos.x >= this->min_pos.x && pos.y >= this->min_pos.y && pos.x <= this->max_pos.x && pos.y <= this->max_pos.y;
+	}
+
+	unit_costs costs;
+	Vec2i min_pos = Vec2i(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()); //the bounds of the tiles whose costs were evaluated
+	Vec2i max_pos = Vec2i(-1, -1);
+	std::vector<crossed_unit> crossed_units; //the units other than the searching one occupying the evaluated tiles
+};
+
 class PathFinderData final
 {
 public:
 	PathFinderInput input;
 	PathFinderOutput output;
+
+	//a path calculated in advance by the parallel path calculation, which is only valid for the game cycle and input with which it was calculated
+	bool has_precalculated_path = false;
+	unsigned long precalculated_cycle = 0;
+	Vec2i precalculated_start_pos;
+	PathFinderInput precalculated_input;
+	int precalculated_result = 0;
+	std::array<char, PathFinderOutput::MAX_PATH_LENGTH> precalculated_path{};
+	unsigned long precalculated_passability_generation = 0;
+	astar_search_dependencies precalculated_dependencies; //the path may only be used if the tiles and units its search depended on are still the same
 };
 
 //  Terrain traversal stuff.
@@ -133,11 +209,19 @@ enum class VisitResult {
 	Cancel
 };
 
-class TerrainTraversal
+//a breadth-first traversal of the tiles of a map layer
+//the visit marks are stamped with the search's generation, so that initializing a new search doesn't need to clear them; the marks and frontier are borrowed from a pool of the calling thread, so that their memory is reused by later traversals
+class TerrainTraversal final
 {
 public:
 	using dataType = short int;
 
+	TerrainTraversal();
+	~TerrainTraversal();
+
+	TerrainTraversal(const TerrainTraversal &other) = delete;
+	TerrainTraversal &operator =(const TerrainTraversal &other) = delete;
+
 	void SetSize(unsigned int width, unsigned int height);
 	void Init();
 
@@ -159,10 +243,30 @@ public:
 	bool IsInvalid(const Vec2i &pos) const;
 
 	// Accept pos to be at one inside the real map
-	dataType Get(const Vec2i &pos) const;
+	dataType Get(const Vec2i &pos) const
+	{
+		const tile_node &node = this->m_storage->nodes[this->get_node_index(pos)];
+
+		//nodes set in previous searches are treated as unvisited; the border nodes have the highest generation, so that they are always treated as invalid
+		if (node.generation < this->m_storage->generation) {
+			return 0;
+		}
+
+		return node.value;
+	}
 
 private:
-	void Set(const Vec2i &pos, dataType value);
+	void Set(const Vec2i &pos, const dataType value)
+	{
+		tile_node &node = this->m_storage->nodes[this->get_node_index(pos)];
+		node.generation = this->m_storage->generation;
+		node.value = value;
+	}
+
+	size_t get_node_index(const Vec2i &pos) const
+	{
+		return this->m_storage->extended_width + 1 + pos.y * this->m_storage->extended_width + pos.x;
+	}
 
 	struct PosNode {
 		PosNode(const Vec2i &pos, const Vec2i &from) : pos(pos), from(from) {}
@@ -170,18 +274,40 @@ private:
 		Vec2i from;
 	};
 
-private:
-	std::vector<dataType> m_values;
-	std::queue<PosNode> m_queue;
-	unsigned int m_extented_width = 0;
-	unsigned int m_height = 0;
+	struct tile_node final
+	{
+		uint16_t generation = 0;
+		dataType value = 0;
+	};
+
+	static constexpr uint16_t border_generation = std::numeric_limits<uint16_t>::max();
+
+	struct traversal_storage final
+	{
+		std::vector<tile_node> nodes;
+
+		//the frontier; since each tile is queued at most once per search, the queue never needs to wrap around, and it is only cleared when initializing a new search
+		std::vector<PosNode> queue;
+		size_t queue_front = 0;
+
+		uint16_t generation = 0;
+		unsigned int extended_width = 0;
+		unsigned int height = 0;
+	};
+
+	static std::vector<std::unique_ptr<traversal_storage>> &get_free_storages();
+
+	std::unique_ptr<traversal_storage> m_storage;
 };
 
 template <typename T>
 bool TerrainTraversal::Run(T &context)
 {
-	for (; m_queue.empty() == false; m_queue.pop()) {
-		const PosNode &posNode = m_queue.front();
+	std::vector<PosNode> &queue = this->m_storage->queue;
+
+	for (size_t &i = this->m_storage->queue_front; i < queue.size(); ++i) {
+		//copy the node, since visiting it may push new nodes to the queue
+		const PosNode posNode = queue[i];
 
 		switch (context.Visit(*this, posNode.pos, posNode.from)) {
 			case VisitResult::Finished: return true;
@@ -202,6 +328,8 @@ extern int AStarMovingUnitCrossingCost;
 extern bool AStarKnowUnseenTerrain;
 /// Cost of using a square we haven't seen before.
 extern int AStarUnknownTerrainCost;
+/// Amount of threads used to calculate paths in parallel
+extern int AStarThreadCount;
 
 //
 //  Convert heading into direction.
@@ -229,6 +357,9 @@ extern int PlaceReachable(const CUnit &src, const QPoint &goal_pos, const QSize
 						  const int min_range, const int max_range, const int max_length, const int z, const bool from_outside_container = false);
 						  //Wyrmgus end
 
+/// Calculate in parallel the paths which the units will need this cycle
+extern void CalculatePendingPaths(const std::vector<CUnit *> &units);
+
 // in astar.cpp
 
 extern void SetAStarFixedUnitCrossingCost(int cost);
@@ -240,6 +371,37 @@ extern int GetAStarMovingUnitCrossingCost();
 extern void SetAStarUnknownTerrainCost(int cost);
 extern int GetAStarUnknownTerrainCost();
 
+extern void SetAStarThreadCount(int count);
+extern int GetAStarThreadCount();
+
+/// Make sure a search context exists for each pathfinding worker
+extern void AStarPrepareWorkers(const int worker_count);
+
+/// Notify the pathfinder that the passability of a tile has changed
+extern void AStarTilePassabilityChanged(const QPoint &pos, const int z, const tile_flag changed_flags);
+/// Notify the pathfinder that the terrain of a tile has changed
+extern void AStarTileTerrainChanged(const QPoint &pos, const int z);
+/// Notify the pathfinder that a player has explored a tile
+extern void AStarTileExplored(const QPoint &pos, const int z, const CPlayer &player);
+/// Notify the pathfinder that the exploration of the map has changed as a whole
+extern void AStarExplorationChanged();
+/// Notify the pathfinder that the units occupying a tile have changed
+extern void AStarTileOccupancyChanged(const unsigned int index, const int z, const tile_flag flags);
+/// Get the amount of changes to the passability of tiles so far
+extern unsigned long AStarGetPassabilityGeneration();
+/// Notify the pathfinder that the owner of a territory has changed, which may change the movement costs of units avoiding deserts
+extern void AStarTerritoryOwnerChanged();
+/// Start logging the changes to the occupancy of tiles in this cycle, so that paths calculated in advance can be checked against them
+extern void AStarStartOccupancyChangeLog();
+/// Get whether the tiles and units which a search depended on are still the same, so that the search would have the same result
+extern bool AStarSearchDependenciesUnchanged(const astar_search_dependencies &dependencies, const CUnit &unit, const int z);
+/// Get whether the movement cost of tiles applies to a unit
+extern bool AStarUsesTileMovementCost(const CUnit &unit);
+/// Get the player whose explored terrain is taken into account for the searches of a unit
+extern const CPlayer *AStarGetSearchPlayer(const CUnit &unit);
+/// Get the cost of entering a tile by its terrain, or -1 if the tile is impassable
+extern int AStarGetTileTerrainCost(const QPoint &pos, const int z, const tile_flag movement_mask, const CPlayer *player, const bool uses_tile_movement_cost);
+
 //Wyrmgus start
 /// Find and a* path for a unit
 extern int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
@@ -250,4 +412,9 @@ extern int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int
 						 //Wyrmgus end
 //Wyrmgus end
 
+/// Find an a* path for a unit, using the search context of the given pathfinding worker, and recording what the search depended on if dependencies are given
+extern int AStarFindPath(const Vec2i &startPos, const Vec2i &goalPos, const int gw, const int gh,
+						 const int tilesizex, const int tilesizey, const int minrange,
+						 const int maxrange, std::array<char, PathFinderOutput::MAX_PATH_LENGTH> *path, const CUnit &unit, const int max_length, const int z, const int worker_index, astar_search_dependencies *dependencies);
+
 extern void PathfinderCclRegister();
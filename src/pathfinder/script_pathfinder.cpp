@@ -82,6 +82,15 @@ static int CclAStar(lua_State *l)
 			} else {
 				AStarUnknownTerrainCost = i;
 			}
+		} else if (!strcmp(value, "thread-count")) {
+			++j;
+			i = LuaToNumber(l, j + 1);
+			if (i < 1) {
+				PrintFunction();
+				fprintf(stdout, "Thread count must be strictly > 0\n");
+			} else {
+				AStarThreadCount = i;
+			}
 		} else {
 			LuaError(l, "Unsupported tag: %s" _C_ value);
 		}
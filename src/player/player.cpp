@@ -71,6 +71,7 @@
 //Wyrmgus start
 #include "parameters.h"
 //Wyrmgus end
+#include "pathfinder/pathfinder.h"
 #include "player/civilization.h"
 #include "player/civilization_group.h"
 #include "player/civilization_history.h"
@@ -535,6 +536,8 @@ void CPlayer::set_revealed(const bool revealed)
 	} else {
 		vector::remove(CPlayer::revealed_player_indexes, this->get_index());
 	}
+
+	AStarExplorationChanged();
 }
 
 void CPlayer::set_population(const int64_t population)
@@ -1290,6 +1293,8 @@ void CPlayer::add_settlement_to_explored_territory(const site *settlement)
 
 			if (tile_player_info->get_visibility_state(player_index) == 0) {
 				tile_player_info->get_visibility_state_ref(player_index) = 1;
+				CMap::get()->MapLayers[z]->mark_fog_dirty_tile(tile_pos);
+				AStarTileExplored(tile_pos, z, *this);
 
 				if (this == CPlayer::GetThisPlayer()) {
 					if (GameRunning) {
@@ -5108,6 +5113,8 @@ void CPlayer::set_shared_vision_with(CPlayer *player, const bool shared_vision)
 		}
 	}
 
+	AStarExplorationChanged();
+
 	emit shared_vision_changed();
 }
 
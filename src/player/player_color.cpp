@@ -30,6 +30,7 @@
 
 #include "database/defines.h"
 #include "util/container_util.h"
+#include "video/pixel_kernels.h"
 
 namespace wyrmgus {
 
@@ -51,4 +52,71 @@ const QColor &player_color::get_minimap_color() const
 	return this->get_colors().at(defines::get()->get_minimap_color_index());
 }
 
+std::vector<pixel_kernels::color_swap> player_color::get_color_swaps(const player_color *conversible_player_color) const
+{
+	const std::vector<QColor> &conversible_colors = conversible_player_color->get_colors();
+	const std::vector<QColor> &colors = this->get_colors();
+
+	const auto to_rgb = [](const QColor &color) {
+		return static_cast<uint32_t>(color.red()) | (static_cast<uint32_t>(color.green()) << 8) | (static_cast<uint32_t>(color.blue()) << 16);
+	};
+
+	std::vector<pixel_kernels::color_swap> color_swaps;
+
+	for (const QColor &conversible_color : conversible_colors) {
+		const uint32_t rgb = to_rgb(conversible_color);
+
+		if (std::find_if(color_swaps.begin(), color_swaps.end(), [rgb](const pixel_kernels::color_swap &swap) { return swap.rgb == rgb; }) != color_swaps.end()) {
+			continue;
+		}
+
+		//the shades are replaced in order, with a replaced shade being checked against the later shades too, so follow the same chain of replacements here
+		uint32_t new_rgb = rgb;
+		for (size_t z = 0; z < conversible_colors.size(); ++z) {
+			if (new_rgb == to_rgb(conversible_colors[z])) {
+				new_rgb = to_rgb(colors[z]);
+			}
+		}
+
+		if (new_rgb != rgb) {
+			color_swaps.push_back(pixel_kernels::color_swap{ rgb, new_rgb });
+		}
+	}
+
+	return color_swaps;
+}
+
+void player_color::apply_to_image(QImage &image, const player_color *conversible_player_color) const
+{
+	const int bpp = image.depth() / 8;
+
+	if (bpp < 3) {
+		throw std::runtime_error("Image BPP must be at least 3.");
+	}
+
+	if (image.format() == QImage::Format_RGBA8888) {
+		pixel_kernels::apply_color_swaps(reinterpret_cast<uint32_t *>(image.bits()), static_cast<size_t>(image.sizeInBytes()) / 4, this->get_color_swaps(conversible_player_color));
+		return;
+	}
+
+	unsigned char *image_data = image.bits();
+	const std::vector<QColor> &conversible_colors = conversible_player_color->get_colors();
+	const std::vector<QColor> &colors = this->get_colors();
+
+	for (int i = 0; i < image.sizeInBytes(); i += bpp) {
+		unsigned char &red = image_data[i];
+		unsigned char &green = image_data[i + 1];
+		unsigned char &blue = image_data[i + 2];
+
+		for (size_t z = 0; z < conversible_colors.size(); ++z) {
+			const QColor &color = conversible_colors[z];
+			if (red == color.red() && green == color.green() && blue == color.blue()) {
+				red = colors[z].red();
+				green = colors[z].green();
+				blue = colors[z].blue();
+			}
+		}
+	}
+}
+
 }
\ No newline at end of file
@@ -31,6 +31,10 @@
 
 namespace wyrmgus {
 
+namespace pixel_kernels {
+	struct color_swap;
+}
+
 class player_color final : public named_data_entry, public data_type<player_color>
 {
 	Q_OBJECT
@@ -68,33 +72,10 @@ public:
 
 	const QColor &get_minimap_color() const;
 
-	void apply_to_image(QImage &image, const player_color *conversible_player_color) const
-	{
-		const int bpp = image.depth() / 8;
-
-		if (bpp < 3) {
-			throw std::runtime_error("Image BPP must be at least 3.");
-		}
-
-		unsigned char *image_data = image.bits();
-		const std::vector<QColor> &conversible_colors = conversible_player_color->get_colors();
-		const std::vector<QColor> &colors = this->get_colors();
-
-		for (int i = 0; i < image.sizeInBytes(); i += bpp) {
-			unsigned char &red = image_data[i];
-			unsigned char &green = image_data[i + 1];
-			unsigned char &blue = image_data[i + 2];
-
-			for (size_t z = 0; z < conversible_colors.size(); ++z) {
-				const QColor &color = conversible_colors[z];
-				if (red == color.red() && green == color.green() && blue == color.blue()) {
-					red = colors[z].red();
-					green = colors[z].green();
-					blue = colors[z].blue();
-				}
-			}
-		}
-	}
+	//get the palette swaps which replace the shades of the conversible player color with those of this one
+	std::vector<pixel_kernels::color_swap> get_color_swaps(const player_color *conversible_player_color) const;
+
+	void apply_to_image(QImage &image, const player_color *conversible_player_color) const;
 
 private:
 	bool hidden = false;
@@ -58,8 +58,8 @@
 #include "unit/unit.h"
 #include "unit/unit_find.h"
 #include "unit/unit_type.h"
+#include "util/fenwick_tree.h"
 #include "util/random.h"
-#include "util/vector_random_util.h"
 #include "util/vector_util.h"
 
 /// Some data accessible for script during the game.
@@ -782,23 +782,42 @@ void trigger::check_triggers_for_player(CPlayer *player, const trigger_type type
 
 void trigger::check_random_triggers_for_player(CPlayer *player, const std::vector<const trigger *> &triggers)
 {
-	std::vector<const trigger *> random_triggers;
+	//the buffers are reused across players and pulses, to avoid reallocating them for every check
+	static std::vector<const trigger *> random_triggers;
+	static std::vector<int> random_weights;
+	static fenwick_tree random_weight_tree;
+
+	random_triggers.clear();
+	random_weights.clear();
 
 	for (const trigger *trigger : triggers) {
 		if (trigger == nullptr) {
-			random_triggers.push_back(trigger);
+			//consecutive null triggers are merged into a single entry, which preserves the cumulative weights
+			if (!random_triggers.empty() && random_triggers.back() == nullptr) {
+				++random_weights.back();
+			} else {
+				random_triggers.push_back(nullptr);
+				random_weights.push_back(1);
+			}
 			continue;
 		}
 
 		const int weight = trigger->get_random_weight_factor()->calculate(player);
 
-		for (int i = 0; i < weight; ++i) {
-			random_triggers.push_back(trigger);
+		if (weight <= 0) {
+			continue;
 		}
+
+		random_triggers.push_back(trigger);
+		random_weights.push_back(weight);
 	}
 
-	while (!random_triggers.empty()) {
-		const trigger *trigger = vector::get_random(random_triggers);
+	random_weight_tree.assign(random_weights);
+
+	//selecting by cumulative weight consumes the same random numbers and gives the same results as picking from a vector with each trigger repeated as many times as its weight
+	while (random_weight_tree.get_total_weight() > 0) {
+		const size_t index = random_weight_tree.find(random::get()->generate(random_weight_tree.get_total_weight()));
+		const trigger *trigger = random_triggers[index];
 
 		if (trigger == nullptr) {
 			//a null trigger represents no trigger happening for the player for this check
@@ -809,7 +828,7 @@ void trigger::check_random_triggers_for_player(CPlayer *player, const std::vecto
 			break;
 		}
 
-		std::erase(random_triggers, trigger);
+		random_weight_tree.remove(index);
 	}
 }
 
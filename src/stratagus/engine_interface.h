@@ -62,6 +62,7 @@ class engine_interface final : public QObject, public singleton<engine_interface
 	Q_PROPERTY(QString shaders_path READ get_shaders_path CONSTANT)
 	Q_PROPERTY(QString user_maps_path READ get_user_maps_path CONSTANT)
 	Q_PROPERTY(QString loading_message READ get_loading_message NOTIFY loading_message_changed)
+	Q_PROPERTY(QStringList loading_log READ get_loading_log NOTIFY loading_log_changed)
 	Q_PROPERTY(QStringList game_messages READ get_game_messages NOTIFY game_messages_changed)
 	Q_PROPERTY(QStringList objective_strings READ get_objective_strings NOTIFY objective_strings_changed)
 	Q_PROPERTY(QVariantList custom_heroes READ get_custom_heroes NOTIFY custom_heroes_changed)
@@ -129,6 +130,30 @@ public:
 		emit loading_message_changed();
 	}
 
+	const QStringList &get_loading_log() const
+	{
+		return this->loading_log;
+	}
+
+	//add a line to the log shown on the loading screen, e.g. with how long a loading phase took
+	void add_loading_log_line(const std::string &line)
+	{
+		this->loading_log.push_back(QString::fromStdString(line));
+
+		emit loading_log_changed();
+	}
+
+	void clear_loading_log()
+	{
+		if (this->loading_log.empty()) {
+			return;
+		}
+
+		this->loading_log.clear();
+
+		emit loading_log_changed();
+	}
+
 	const QStringList &get_game_messages() const
 	{
 		return this->game_messages;
@@ -359,6 +384,7 @@ signals:
 	void running_changed();
 	void scale_factor_changed();
 	void loading_message_changed();
+	void loading_log_changed();
 	void game_messages_changed();
 	void objective_strings_changed();
 	void custom_heroes_changed();
@@ -386,6 +412,7 @@ private:
 	std::queue<std::unique_ptr<QInputEvent>> stored_input_events;
 	QRect cursor_restriction_rect;
 	QString loading_message; //the loading message to be displayed
+	QStringList loading_log; //the lines logged while the current game was being loaded
 	QStringList game_messages; //in-game messages to be displayed
 	QStringList objective_strings;
 	interface_style *current_interface_style = nullptr;
@@ -65,7 +65,7 @@ std::map<std::string, int> GrandStrategyHeroStringToIndex;
 std::vector<std::unique_ptr<CGrandStrategyEvent>> GrandStrategyEvents;
 std::map<std::string, CGrandStrategyEvent *> GrandStrategyEventStringToPointer;
 
-void CGrandStrategyGame::DrawInterface(std::vector<std::function<void(renderer *)>> &render_commands)
+void CGrandStrategyGame::DrawInterface(render_command_buffer &render_commands)
 {
 	if (this->PlayerFaction != nullptr && this->PlayerFaction->OwnedProvinces.size() > 0) { //draw resource bar
 		std::vector<int> stored_resources;
@@ -58,12 +58,14 @@ public:
 	~PImpl();
 
 	int open(const std::string &filepath_str, const long flags);
+	int open_memory();
 	int close();
 	void flush();
 	int read(void *buf, size_t len);
 	int seek(long offset, int whence);
 	long tell();
 	int write(const void *buf, size_t len);
+	std::string take_memory_data();
 
 private:
 	PImpl(const PImpl &rhs); // No implementation
@@ -75,6 +77,7 @@ private:
 #ifdef USE_ZLIB
 	gzFile cl_gz;    /// gzip file pointer
 #endif // !USE_ZLIB
+	std::string cl_memory; /// in-memory buffer
 };
 
 CFile::CFile() : pimpl(std::make_unique<CFile::PImpl>())
@@ -99,6 +102,15 @@ int CFile::open(const char *name, long flags)
 	return pimpl->open(name, flags);
 }
 
+/**
+**  Open a file which is written to an in-memory buffer, e.g. to take a
+**  snapshot of the game state which is then written to disk elsewhere
+*/
+int CFile::open_memory()
+{
+	return pimpl->open_memory();
+}
+
 /**
 **  CLclose Library file close
 */
@@ -181,6 +193,27 @@ int CFile::printf(const char *format, ...)
 	return ret;
 }
 
+/**
+**  Write raw data to the file
+**
+**  @param buf  Pointer to the data to write.
+**  @param len  Length of the data in bytes.
+**
+**  @return     The return value of the underlying write, or -1 on error.
+*/
+int CFile::write(const void *buf, size_t len)
+{
+	return pimpl->write(buf, len);
+}
+
+/**
+**  Take the data written to an in-memory file, leaving its buffer empty
+*/
+std::string CFile::take_memory_data()
+{
+	return pimpl->take_memory_data();
+}
+
 //  Implementation.
 
 CFile::PImpl::PImpl()
@@ -291,6 +324,18 @@ int CFile::PImpl::open(const std::string &filepath_str, const long openflags)
 	return 0;
 }
 
+int CFile::PImpl::open_memory()
+{
+	cl_memory.clear();
+	cl_type = CLF_TYPE_MEMORY;
+	return 0;
+}
+
+std::string CFile::PImpl::take_memory_data()
+{
+	return std::move(cl_memory);
+}
+
 int CFile::PImpl::close()
 {
 	int ret = EOF;
@@ -305,6 +350,9 @@ int CFile::PImpl::close()
 			ret = gzclose(cl_gz);
 		}
 #endif // USE_ZLIB
+		if (tp == CLF_TYPE_MEMORY) {
+			ret = 0;
+		}
 	} else {
 		errno = EBADF;
 	}
@@ -361,6 +409,10 @@ int CFile::PImpl::write(const void *buf, size_t size)
 			ret = gzwrite(cl_gz, buf, size);
 		}
 #endif // USE_ZLIB
+		if (tp == CLF_TYPE_MEMORY) {
+			cl_memory.append(static_cast<const char *>(buf), size);
+			ret = static_cast<int>(size);
+		}
 	} else {
 		errno = EBADF;
 	}
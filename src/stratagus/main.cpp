@@ -34,6 +34,7 @@
 #include "game/game.h"
 #include "game/results_info.h"
 #include "game/player_results_info.h"
+#include "game/save_writer.h"
 #include "map/map_grid_model.h"
 #include "map/map_info.h"
 #include "map/map_presets.h"
@@ -89,6 +90,15 @@ int main(int argc, char **argv)
 	try {
 		qInstallMessageHandler(log::log_qt_message);
 
+		//the headless mode must be able to run on machines without a display, so it does not use the platform's windowing system
+		for (int i = 1; i < argc; ++i) {
+			if (strncmp(argv[i], "--headless-", 11) == 0) {
+				qputenv("QT_QPA_PLATFORM", "offscreen");
+				qputenv("QT_QUICK_BACKEND", "software");
+				break;
+			}
+		}
+
 		QApplication app(argc, argv);
 		app.setApplicationName(NAME);
 		app.setApplicationVersion(VERSION);
@@ -193,6 +203,9 @@ int main(int argc, char **argv)
 
 		const int result = app.exec();
 
+		//let an autosave which is being written in the background finish
+		save_writer::get()->wait();
+
 		thread_pool::get()->stop();
 
 		stratagus_on_exit_cleanup();
@@ -36,7 +36,9 @@
 #include "dialogue.h"
 #include "editor.h"
 #include "engine_interface.h"
+#include "game/cycle_profiler.h"
 #include "game/game.h"
+#include "game/headless_simulation.h"
 //Wyrmgus start
 #include "grand_strategy.h"
 #include "luacallback.h"
@@ -85,12 +87,13 @@
 #include "util/string_util.h"
 #include "util/thread_pool.h"
 #include "video/font.h"
+#include "video/graphic_loader.h"
 #include "video/render_context.h"
 #include "video/video.h"
 
 #include <guichan.h>
 
-void DrawGuichanWidgets(std::vector<std::function<void(renderer *)>> &render_commands);
+void DrawGuichanWidgets(render_command_buffer &render_commands);
 
 /// variable set when we are scrolling via keyboard
 int KeyScrollState = ScrollNone;
@@ -178,7 +181,7 @@ void DoScrollArea(int state, bool fast, bool isKeyboard, const Qt::KeyboardModif
 /**
 **  Draw map area
 */
-void DrawMapArea(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawMapArea(render_command_buffer &render_commands)
 {
 	// Draw all of the viewports
 	for (CViewport *vp = UI.Viewports; vp < UI.Viewports + UI.NumViewports; ++vp) {
@@ -205,7 +208,7 @@ void DrawMapArea(std::vector<std::function<void(renderer *)>> &render_commands)
 */
 void UpdateDisplay()
 {
-	std::vector<std::function<void(renderer *)>> render_commands;
+	render_command_buffer render_commands = render_context::get()->take_recycled_commands();
 
 	if (GameRunning || CEditor::get()->is_running()) {
 		//to prevent empty spaces in the UI
@@ -265,6 +268,8 @@ void UpdateDisplay()
 		
 		DrawPopups(render_commands);
 		//Wyrmgus end
+
+		cycle_profiler::get()->draw_overlay(render_commands);
 	}
 
 	DrawGuichanWidgets(render_commands);
@@ -294,24 +299,48 @@ static boost::asio::awaitable<void> GameLogicLoop()
 	// FIXME: We need to find a better place!
 	SaveGameLoading = false;
 
+	const bool headless = headless_simulation::get()->is_running();
+
 	//
 	// Game logic part
 	//
 	if (!game::get()->is_paused() && NetworkInSync && !SkipGameCycle) {
+		ReplayCheckpointEachCycle();
 		SinglePlayerReplayEachCycle();
 		++GameCycle;
 		MultiPlayerReplayEachCycle();
 
+		cycle_profiler::get()->begin_cycle(GameCycle);
+
 		if (game::get()->is_multiplayer()) {
+			scoped_cycle_timer timer(cycle_profiler_stage::network);
 			co_await NetworkCommands(); //get network commands
 		}
 
-		TriggersEachCycle(); //handle triggers
-		UnitActions(); //handle units
-		MissileActions(); //handle missiles
-		PlayersEachCycle(); //handle players
+		{
+			scoped_cycle_timer timer(cycle_profiler_stage::triggers);
+			TriggersEachCycle(); //handle triggers
+		}
+
+		{
+			scoped_cycle_timer timer(cycle_profiler_stage::unit_actions);
+			UnitActions(); //handle units
+		}
+
+		{
+			scoped_cycle_timer timer(cycle_profiler_stage::missile_actions);
+			MissileActions(); //handle missiles
+		}
+
+		{
+			scoped_cycle_timer timer(cycle_profiler_stage::players_each_cycle);
+			PlayersEachCycle(); //handle players
+		}
 
-		CMap::get()->do_per_cycle_loop();
+		{
+			scoped_cycle_timer timer(cycle_profiler_stage::map);
+			CMap::get()->do_per_cycle_loop();
+		}
 		
 		//
 		// Work todo each second.
@@ -326,6 +355,8 @@ static boost::asio::awaitable<void> GameLogicLoop()
 		switch (GameCycle % CYCLES_PER_SECOND) {
 			case 0: // At cycle 0, start all ai players...
 				if (GameCycle == 0) {
+					scoped_cycle_timer timer(cycle_profiler_stage::players_each_second);
+
 					for (int player = 0; player < NumPlayers; ++player) {
 						PlayersEachSecond(player);
 					}
@@ -344,9 +375,11 @@ static boost::asio::awaitable<void> GameLogicLoop()
 				//regrow forests and remove other destroyed overlay tiles after a delay
 				CMap::get()->handle_destroyed_overlay_terrain();
 				break;
-			case 6: // overtaking units
+			case 6: { // overtaking units
+				scoped_cycle_timer timer(cycle_profiler_stage::rescue_units);
 				RescueUnits();
 				break;
+			}
 			//Wyrmgus start
 			/*
 			default: {
@@ -365,23 +398,27 @@ static boost::asio::awaitable<void> GameLogicLoop()
 		int player = (GameCycle - 1) % CYCLES_PER_SECOND;
 		assert_throw(player >= 0);
 		for (; player < NumPlayers; player += CYCLES_PER_SECOND) {
+			scoped_cycle_timer timer(cycle_profiler_stage::players_each_second);
 			PlayersEachSecond(player);
 		}
 		
 		player = (GameCycle - 1) % (CYCLES_PER_MINUTE / 2);
 		assert_throw(player >= 0);
 		if (player < NumPlayers) {
+			scoped_cycle_timer timer(cycle_profiler_stage::players_each_half_minute);
 			PlayersEachHalfMinute(player);
 		}
 
 		player = (GameCycle - 1) % CYCLES_PER_MINUTE;
 		assert_throw(player >= 0);
 		if (player < NumPlayers) {
+			scoped_cycle_timer timer(cycle_profiler_stage::players_each_minute);
 			PlayersEachMinute(player);
 		}
 		//Wyrmgus end
 		
 		if (GameCycle > 0) {
+			scoped_cycle_timer timer(cycle_profiler_stage::game);
 			game::get()->do_cycle();
 		}
 
@@ -389,24 +426,40 @@ static boost::asio::awaitable<void> GameLogicLoop()
 			game::get()->update_neutral_faction_presence();
 		}
 		
-		if (preferences::get()->is_autosave_enabled() && !IsNetworkGame() && GameCycle > 0 && (GameCycle % (CYCLES_PER_MINUTE * preferences::autosave_minutes)) == 0) {
+		if (preferences::get()->is_autosave_enabled() && !IsNetworkGame() && !headless && GameCycle > 0 && (GameCycle % (CYCLES_PER_MINUTE * preferences::autosave_minutes)) == 0) {
 			//autosave every X minutes, if the option is enabled
+			scoped_cycle_timer timer(cycle_profiler_stage::autosave);
+
 			const std::filesystem::path filepath = database::get_save_path() / "autosave.sav";
 
-			//Wyrmgus start
-//			SaveGame(path::to_string(filepath));
-			CclCommand("if (RunSaveGame ~= nil) then RunSaveGame(\""+ string::escaped("file:" + path::to_string(filepath)) + "\") end;");
-			//Wyrmgus end
+			{
+				//take a snapshot of the game state for the autosave, and write it in the background instead of stalling the game
+				const scoped_asynchronous_save asynchronous_save;
+
+				//Wyrmgus start
+//				SaveGame(path::to_string(filepath));
+				CclCommand("if (RunSaveGame ~= nil) then RunSaveGame(\""+ string::escaped("file:" + path::to_string(filepath)) + "\") end;");
+				//Wyrmgus end
+			}
 
 			UI.StatusLine.Set(_("Autosave"));
 		}
+
+		cycle_profiler::get()->end_cycle();
+
+		if (headless) {
+			headless_simulation::get()->on_cycle_end();
+		}
 	}
 
-	ParticleManager.update(); // handle particles
-	CheckMusicFinished(); // Check for next song
+	//the headless simulation has no display, sound or input, so its cycles are run back to back
+	if (!headless) {
+		ParticleManager.update(); // handle particles
+		CheckMusicFinished(); // Check for next song
 
-	if (FastForwardCycle <= GameCycle || !(GameCycle & 0x3f)) {
-		co_await WaitEventsOneFrame();
+		if (FastForwardCycle <= GameCycle || !(GameCycle & 0x3f)) {
+			co_await WaitEventsOneFrame();
+		}
 	}
 
 	//process functions which are a result of user interaction, and which need to occur at a certain point in the loop, since they can have gameplay effects
@@ -447,8 +500,13 @@ static void DisplayLoop()
 [[nodiscard]]
 static boost::asio::awaitable<void> SingleGameLoop()
 {
+	const bool headless = headless_simulation::get()->is_running();
+
 	while (GameRunning) {
-		DisplayLoop();
+		if (!headless) {
+			DisplayLoop();
+		}
+
 		co_await GameLogicLoop();
 	}
 }
@@ -487,17 +545,24 @@ boost::asio::awaitable<void> GameMainLoop()
 	
 	game::get()->set_running(true);
 
-	engine_interface::get()->set_waiting_for_interface(true);
+	const bool headless = headless_simulation::get()->is_running();
 
-	//run the display loop once, so that the map is visible when we start
-	DisplayLoop();
+	if (!headless) {
+		engine_interface::get()->set_waiting_for_interface(true);
 
-	co_await thread_pool::get()->await_future(engine_interface::get()->get_map_view_created_future());
+		//run the display loop once, so that the map is visible when we start
+		DisplayLoop();
 
-	engine_interface::get()->reset_map_view_created_promise();
-	engine_interface::get()->set_waiting_for_interface(false);
+		co_await thread_pool::get()->await_future(engine_interface::get()->get_map_view_created_future());
 
-	engine_interface::get()->set_loading_message("");
+		engine_interface::get()->reset_map_view_created_promise();
+		engine_interface::get()->set_waiting_for_interface(false);
+
+		engine_interface::get()->set_loading_message("");
+
+		//the map is now visible and can be interacted with, so the graphics not needed yet can be streamed in
+		graphic_loader::get()->on_first_playable_frame();
+	}
 
 	if (GameCycle == 0) {
 		if (game::get()->get_current_campaign() != nullptr) {
@@ -518,7 +583,8 @@ boost::asio::awaitable<void> GameMainLoop()
 
 			std::vector<faction *> potential_factions = CPlayer::GetThisPlayer()->get_potential_factions();
 
-			if (!potential_factions.empty()) {
+			//the headless simulation has no input with which a faction could be chosen
+			if (!potential_factions.empty() && !headless) {
 				std::sort(potential_factions.begin(), potential_factions.end(), [](const faction *lhs, const faction *rhs) {
 					return lhs->get_name() < rhs->get_name();
 				});
@@ -533,8 +599,19 @@ boost::asio::awaitable<void> GameMainLoop()
 		}
 	}
 
+	//the cycles of a previous game are not part of the profile of this one
+	cycle_profiler::get()->clear();
+
+	if (headless) {
+		headless_simulation::get()->on_game_started();
+	}
+
 	co_await SingleGameLoop();
 
+	if (headless) {
+		headless_simulation::get()->on_game_ended();
+	}
+
 	co_await NetworkQuitGame();
 	EndReplayLog();
 
@@ -81,6 +81,24 @@ void parameters::process()
 			"idx"
 		},
 		{ { "Z", "retro-scale" }, "Use OpenGL to scale the screen to the viewport (retro-style). Implies -O." },
+		{ { "headless-map" }, "Run a map without display, sound or input, print the simulation statistics and exit.", "map file" },
+		{ { "headless-replay" }, "Run a replay without display, sound or input, print the simulation statistics and exit.", "replay file" },
+		{
+			{ "headless-cycles" },
+			"Number of game cycles to run in headless mode (default: until the replay ends, or 10 minutes of game time for a map).",
+			"cycles"
+		},
+		{ { "convert-replay" }, "Convert a replay log to the binary replay format and exit.", "replay file" },
+		{
+			{ "convert-replay-output" },
+			"File to which the converted replay is written (default: the replay file with the .wrpl extension).",
+			"binary replay file"
+		},
+		{
+			{ "pathfinding-threads" },
+			"Number of threads with which paths are calculated (default: the number of hardware threads). The game state does not depend on it, so running a replay with different values must give the same final SyncHash.",
+			"threads"
+		},
 	};
 	cmd_parser.addOptions(options);
 
@@ -181,6 +199,41 @@ void parameters::process()
 		ZoomNoResize = 1;
 		set_retroscale();
 	}
+
+	option = "headless-map";
+	if (cmd_parser.isSet(option)) {
+		this->headless_filepath = path::from_qstring(cmd_parser.value(option));
+		this->headless_cycle_count = CYCLES_PER_MINUTE * 10;
+	}
+
+	option = "headless-replay";
+	if (cmd_parser.isSet(option)) {
+		this->headless_filepath = path::from_qstring(cmd_parser.value(option));
+		this->headless_replay = true;
+	}
+
+	option = "headless-cycles";
+	if (cmd_parser.isSet(option)) {
+		this->headless_cycle_count = cmd_parser.value(option).toULong();
+	}
+
+	option = "convert-replay";
+	if (cmd_parser.isSet(option)) {
+		this->replay_conversion_source_filepath = path::from_qstring(cmd_parser.value(option));
+
+		option = "convert-replay-output";
+		if (cmd_parser.isSet(option)) {
+			this->replay_conversion_destination_filepath = path::from_qstring(cmd_parser.value(option));
+		} else {
+			this->replay_conversion_destination_filepath = this->replay_conversion_source_filepath;
+			this->replay_conversion_destination_filepath.replace_extension(".wrpl");
+		}
+	}
+
+	option = "pathfinding-threads";
+	if (cmd_parser.isSet(option)) {
+		this->pathfinding_thread_count = cmd_parser.value(option).toInt();
+	}
 }
 
 void parameters::SetDefaultUserDirectory()
@@ -45,6 +45,50 @@ public:
 		return this->test_run;
 	}
 
+	//whether a map or replay is to be simulated without display, sound or input
+	bool is_headless() const
+	{
+		return !this->headless_filepath.empty();
+	}
+
+	const std::filesystem::path &get_headless_filepath() const
+	{
+		return this->headless_filepath;
+	}
+
+	bool is_headless_replay() const
+	{
+		return this->headless_replay;
+	}
+
+	//get the amount of cycles to simulate in headless mode, 0 for no limit
+	unsigned long get_headless_cycle_count() const
+	{
+		return this->headless_cycle_count;
+	}
+
+	//whether a replay log is to be converted to the binary replay format
+	bool is_replay_conversion() const
+	{
+		return !this->replay_conversion_source_filepath.empty();
+	}
+
+	const std::filesystem::path &get_replay_conversion_source_filepath() const
+	{
+		return this->replay_conversion_source_filepath;
+	}
+
+	const std::filesystem::path &get_replay_conversion_destination_filepath() const
+	{
+		return this->replay_conversion_destination_filepath;
+	}
+
+	//get the amount of pathfinding threads set from the command line, 0 if not set
+	int get_pathfinding_thread_count() const
+	{
+		return this->pathfinding_thread_count;
+	}
+
 	void SetUserDirectory(const std::filesystem::path &path)
 	{
 		this->user_directory = path;
@@ -64,6 +108,12 @@ public:
 	std::string luaScriptArguments;
 private:
 	bool test_run = false;
+	std::filesystem::path headless_filepath;
+	bool headless_replay = false;
+	unsigned long headless_cycle_count = 0;
+	std::filesystem::path replay_conversion_source_filepath;
+	std::filesystem::path replay_conversion_destination_filepath;
+	int pathfinding_thread_count = 0;
 	std::filesystem::path user_directory; //directory containing user settings and data
 };
 
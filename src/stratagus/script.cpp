@@ -190,7 +190,7 @@ int LuaCall(int narg, int clear, bool exitOnError)
 /**
 **  Get the (uncompressed) content of the file into a string
 */
-static bool GetFileContent(const std::string &file, std::string &content)
+bool GetFileContent(const std::string &file, std::string &content)
 {
 	CFile fp;
 
@@ -234,7 +234,20 @@ int LuaLoadFile(const std::string &file, const std::string &strArg)
 		throw std::runtime_error("Failed to load Lua file: \"" + file + "\"");
 	}
 
-	const int status = luaL_loadbuffer(Lua, content.c_str(), content.size(), file.c_str());
+	return LuaLoadBuffer(content, file, strArg);
+}
+
+/**
+**  Load a Lua script from a buffer and execute it
+**
+**  @param buffer  The script
+**  @param name    The name of the script, used in error messages
+**
+**  @return        0 for success, else exit.
+*/
+int LuaLoadBuffer(const std::string_view &buffer, const std::string &name, const std::string &strArg)
+{
+	const int status = luaL_loadbuffer(Lua, buffer.data(), buffer.size(), name.c_str());
 
 	if (!status) {
 		if (!strArg.empty()) {
@@ -172,6 +172,7 @@ extern void beos_init(int argc, char **argv);
 #include "editor.h"
 #include "engine_interface.h"
 #include "game/game.h"
+#include "game/headless_simulation.h"
 #include "guichan.h"
 #include "iocompat.h"
 #include "iolib.h"
@@ -180,6 +181,7 @@ extern void beos_init(int argc, char **argv);
 #include "network/netconnect.h"
 #include "network/network.h"
 #include "parameters.h"
+#include "pathfinder/pathfinder.h"
 #include "player/player.h"
 #include "replay.h"
 #include "results.h"
@@ -470,14 +472,21 @@ boost::asio::awaitable<void> stratagusMain(int argc, char **argv)
 
 	LoadCcl(parameters->luaStartFilename, parameters->luaScriptArguments);
 
+	//the command line takes precedence over the thread count set by the scripts
+	if (parameters->get_pathfinding_thread_count() > 0) {
+		SetAStarThreadCount(parameters->get_pathfinding_thread_count());
+	}
+
 	PrintHeader();
 	PrintLicense();
 
 	// Setup video display
 	InitVideo();
 
-	//setup sound
-	InitSound();
+	//setup sound, which the headless mode and replay conversion run without
+	if (!parameters->is_headless() && !parameters->is_replay_conversion()) {
+		InitSound();
+	}
 
 	//  Show title screens.
 	SetClipping(0, 0, Video.Width - 1, Video.Height - 1);
@@ -500,6 +509,26 @@ boost::asio::awaitable<void> stratagusMain(int argc, char **argv)
 		co_return;
 	}
 
+	if (parameters->is_replay_conversion()) {
+		int conversion_exit_code = EXIT_SUCCESS;
+
+		try {
+			ConvertReplayToBinary(parameters->get_replay_conversion_source_filepath(), parameters->get_replay_conversion_destination_filepath());
+		} catch (const std::exception &exception) {
+			exception::report(exception);
+			conversion_exit_code = EXIT_FAILURE;
+		}
+
+		co_await Exit(conversion_exit_code);
+		co_return;
+	}
+
+	if (parameters->is_headless()) {
+		const int headless_exit_code = co_await headless_simulation::get()->run(parameters->get_headless_filepath(), parameters->is_headless_replay(), parameters->get_headless_cycle_count());
+		co_await Exit(headless_exit_code);
+		co_return;
+	}
+
 	CurrentCursorState = CursorState::Point;
 	CursorOn = cursor_on::unknown;
 
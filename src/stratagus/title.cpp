@@ -90,7 +90,7 @@ static void WaitCallbackExit()
 {
 }
 
-void TitleScreen::ShowLabels(std::vector<std::function<void(renderer *)>> &render_commands) const
+void TitleScreen::ShowLabels(render_command_buffer &render_commands) const
 {
 	const std::vector<TitleScreenLabel> &labels = this->Labels;
 
@@ -115,7 +115,7 @@ void TitleScreen::ShowLabels(std::vector<std::function<void(renderer *)>> &rende
 	}
 }
 
-boost::asio::awaitable<void> TitleScreen::ShowTitleImage(std::vector<std::function<void(renderer *)>> &render_commands) const
+boost::asio::awaitable<void> TitleScreen::ShowTitleImage(render_command_buffer &render_commands) const
 {
 	const EventCallback *old_callbacks = GetCallbacks();
 	EventCallback callbacks;
@@ -153,7 +153,7 @@ boost::asio::awaitable<void> TitleScreen::ShowTitleImage(std::vector<std::functi
 /**
 **  Show the title screens
 */
-boost::asio::awaitable<void> ShowTitleScreens(std::vector<std::function<void(renderer *)>> &render_commands)
+boost::asio::awaitable<void> ShowTitleScreens(render_command_buffer &render_commands)
 {
 	if (TitleScreens.empty()) {
 		co_return;
@@ -63,6 +63,7 @@
 #include "player/faction.h"
 #include "player/player.h"
 #include "quest/achievement.h"
+#include "replay.h"
 #include "script/condition/and_condition.h"
 #include "script/context.h"
 #include "script/trigger.h"
@@ -822,7 +823,7 @@ static struct PopupDrawCache {
 /**
 **  Draw popup
 */
-void DrawPopup(const wyrmgus::button &button, int x, int y, bool above, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawPopup(const wyrmgus::button &button, int x, int y, bool above, render_command_buffer &render_commands)
 {
 	CPopup *popup = PopupByIdent(button.Popup);
 	bool useCache = false;
@@ -923,7 +924,7 @@ void DrawPopup(const wyrmgus::button &button, int x, int y, bool above, std::vec
 /**
 **  Draw popup
 */
-void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, bool above, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, bool above, render_command_buffer &render_commands)
 {
 	wyrmgus::font *font = wyrmgus::defines::get()->get_game_font();
 	
@@ -1062,7 +1063,7 @@ void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_co
 **
 **  Draw all action buttons.
 */
-void CButtonPanel::Draw(std::vector<std::function<void(renderer *)>> &render_commands)
+void CButtonPanel::Draw(render_command_buffer &render_commands)
 {
 	//  Draw background
 	if (UI.ButtonPanel.G) {
@@ -2047,16 +2048,20 @@ void CButtonPanel::DoClicked_Return(const Qt::KeyboardModifiers key_modifiers)
 
 void CButtonPanel::DoClicked_Stop()
 {
+	BeginCommandLogGroup();
 	for (size_t i = 0; i != Selected.size(); ++i) {
 		SendCommandStopUnit(*Selected[i]);
 	}
+	EndCommandLogGroup();
 }
 
 void CButtonPanel::DoClicked_StandGround(const Qt::KeyboardModifiers key_modifiers)
 {
+	BeginCommandLogGroup();
 	for (size_t i = 0; i != Selected.size(); ++i) {
 		SendCommandStandGround(*Selected[i], !(key_modifiers & Qt::ShiftModifier));
 	}
+	EndCommandLogGroup();
 }
 
 void CButtonPanel::DoClicked_Button(const int button)
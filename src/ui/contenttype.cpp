@@ -60,7 +60,7 @@ CContentTypeText::~CContentTypeText()
 **  @param unit         unit with variable to show.
 **  @param defaultfont  default font if no specific font in extra data.
 */
-void CContentTypeText::Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeText::Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const
 {
 	std::string text;       // Optional text to display.
 	int x = this->Pos.x;
@@ -141,7 +141,7 @@ CContentTypeFormattedText::CContentTypeFormattedText() : Component(VariableAttri
 **  @note text must have exactly 1 %d.
 **  @bug if text format is incorrect.
 */
-void CContentTypeFormattedText::Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeFormattedText::Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const
 {
 	char buf[256];
 	UStrInt usi1;
@@ -187,7 +187,7 @@ CContentTypeFormattedText2::CContentTypeFormattedText2() : Component1(VariableAt
 **  @note text must have exactly 2 %d.
 **  @bug if text format is incorrect.
 */
-void CContentTypeFormattedText2::Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeFormattedText2::Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const
 {
 	char buf[256];
 	UStrInt usi1, usi2;
@@ -273,7 +273,7 @@ static const CUnit *GetUnitRef(const CUnit &unit, EnumUnit e)
 **  @param unit         unit with icon to show.
 **  @param defaultfont  unused.
 */
-void CContentTypeIcon::Draw(const CUnit &unit, font *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeIcon::Draw(const CUnit &unit, font *, render_command_buffer &render_commands) const
 {
 	const CUnit *unitToDraw = GetUnitRef(unit, this->UnitRef);
 
@@ -292,7 +292,7 @@ void CContentTypeIcon::Draw(const CUnit &unit, font *, std::vector<std::function
 **
 **  @todo Color and percent value Parametrisation.
 */
-void CContentTypeLifeBar::Draw(const CUnit &unit, font *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeLifeBar::Draw(const CUnit &unit, font *, render_command_buffer &render_commands) const
 {
 	assert_throw((unsigned int) this->Index < UnitTypeVar.GetNumberVariable());
 	//Wyrmgus start
@@ -404,7 +404,7 @@ void CContentTypeLifeBar::Draw(const CUnit &unit, font *, std::vector<std::funct
 **
 **  @todo Color and percent value Parametrisation.
 */
-void CContentTypeCompleteBar::Draw(const CUnit &unit, font *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CContentTypeCompleteBar::Draw(const CUnit &unit, font *, render_command_buffer &render_commands) const
 {
 	assert_throw((unsigned int) this->varIndex < UnitTypeVar.GetNumberVariable());
 	//Wyrmgus start
@@ -40,6 +40,7 @@ struct StringDesc;
 namespace wyrmgus {
 	class font;
 	class font_color;
+	class render_command_buffer;
 	class renderer;
 }
 
@@ -52,7 +53,7 @@ public:
 	virtual ~CContentType();
 
 	/// Tell how show the variable Index.
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const = 0;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const = 0;
 
 	virtual void Parse(lua_State *l) = 0;
 
@@ -72,7 +73,7 @@ public:
 	CContentTypeText();
 	virtual ~CContentTypeText();
 
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -94,7 +95,7 @@ public:
 	CContentTypeFormattedText();
 	virtual ~CContentTypeFormattedText() {}
 
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -114,7 +115,7 @@ public:
 	CContentTypeFormattedText2();
 	virtual ~CContentTypeFormattedText2() {}
 
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -133,7 +134,7 @@ private:
 class CContentTypeIcon final : public CContentType
 {
 public:
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -148,7 +149,7 @@ class CContentTypeLifeBar final : public CContentType
 public:
 	CContentTypeLifeBar() : Index(-1), Width(0), Height(0) {}
 
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -169,7 +170,7 @@ class CContentTypeCompleteBar final : public CContentType
 public:
 	CContentTypeCompleteBar() : varIndex(-1), width(0), height(0), hasBorder(false), colorIndex(-1) {}
 
-	virtual void Draw(const CUnit &unit, font *defaultfont, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(const CUnit &unit, font *defaultfont, render_command_buffer &render_commands) const override;
 	virtual void Parse(lua_State *l) override;
 
 private:
@@ -50,6 +50,7 @@
 //Wyrmgus start
 #include "upgrade/upgrade.h"
 //Wyrmgus end
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -184,7 +185,7 @@ int GetCursorsCount()
 **  @param corner1   Screen start position of rectangle
 **  @param corner2   Screen end position of rectangle
 */
-static void DrawVisibleRectangleCursor(PixelPos corner1, PixelPos corner2, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawVisibleRectangleCursor(PixelPos corner1, PixelPos corner2, render_command_buffer &render_commands)
 {
 	const CViewport &vp = *UI.SelectedViewport;
 
@@ -209,7 +210,7 @@ static void DrawVisibleRectangleCursor(PixelPos corner1, PixelPos corner2, std::
 */
 //Wyrmgus start
 //static void DrawBuildingCursor()
-void DrawBuildingCursor(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawBuildingCursor(render_command_buffer &render_commands)
 //Wyrmgus end
 {
 	// Align to grid
@@ -363,7 +364,7 @@ void DrawBuildingCursor(std::vector<std::function<void(renderer *)>> &render_com
 /**
 **  Draw the cursor.
 */
-void DrawCursor(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawCursor(render_command_buffer &render_commands)
 {
 	// Selecting rectangle
 	if (CurrentCursorState == CursorState::Rectangle && CursorStartScreenPos != CursorScreenPos) {
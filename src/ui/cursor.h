@@ -37,6 +37,7 @@ namespace wyrmgus {
 
 class civilization;
 class civilization_group;
+class render_command_buffer;
 class renderer;
 class unit_type;
 enum class cursor_type;
@@ -203,10 +204,10 @@ extern PixelPos CursorStartMapPos; /// the same in screen map coordinate system
 extern int GetCursorsCount();
 
 /// Draw any cursor
-extern void DrawCursor(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawCursor(render_command_buffer &render_commands);
 //Wyrmgus start
 /// Draw building cursor
-extern void DrawBuildingCursor(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawBuildingCursor(render_command_buffer &render_commands);
 //Wyrmgus end
 /// Animate the cursor
 extern void CursorAnimate(unsigned ticks);
@@ -38,6 +38,7 @@
 #include "unit/unit.h"
 #include "util/assert_util.h"
 #include "util/colorization_type.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -119,7 +120,7 @@ std::shared_ptr<CPlayerColorGraphic> icon::get_graphics() const
 **  @param player  Player pointer used for icon colors
 **  @param pos     display pixel position
 */
-void icon::DrawIcon(const PixelPos &pos, const player_color *player_color, std::vector<std::function<void(renderer *)>> &render_commands) const
+void icon::DrawIcon(const PixelPos &pos, const player_color *player_color, render_command_buffer &render_commands) const
 {
 	this->get_graphics()->render_frame(this->get_frame(), pos, color_modification(this->get_hue_rotation(), this->get_colorization(), this->get_hue_ignored_colors(), player_color), render_commands);
 }
@@ -129,7 +130,7 @@ void icon::DrawIcon(const PixelPos &pos, const player_color *player_color, std::
 **
 **  @param pos     display pixel position
 */
-void icon::DrawGrayscaleIcon(const PixelPos &pos, std::vector<std::function<void(renderer *)>> &render_commands) const
+void icon::DrawGrayscaleIcon(const PixelPos &pos, render_command_buffer &render_commands) const
 {
 	this->get_graphics()->DrawGrayscaleFrameClip(this->get_frame(), pos.x, pos.y, render_commands);
 }
@@ -140,7 +141,7 @@ void icon::DrawGrayscaleIcon(const PixelPos &pos, std::vector<std::function<void
 **  @param pos       display pixel position
 **  @param percent   cooldown percent
 */
-void icon::DrawCooldownSpellIcon(const PixelPos &pos, const int percent, std::vector<std::function<void(renderer *)>> &render_commands) const
+void icon::DrawCooldownSpellIcon(const PixelPos &pos, const int percent, render_command_buffer &render_commands) const
 {
 	// TO-DO: implement more effect types (clock-like)
 	this->get_graphics()->DrawGrayscaleFrameClip(this->get_frame(), pos.x, pos.y, render_commands);
@@ -156,7 +157,7 @@ void icon::DrawCooldownSpellIcon(const PixelPos &pos, const int percent, std::ve
 **  @param pos     display pixel position
 **  @param text    Optional text to display
 */
-void icon::DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player_color, QColor border_color, const bool transparent, const bool grayscale, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands) const
+void icon::DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player_color, QColor border_color, const bool transparent, const bool grayscale, const int show_percent, render_command_buffer &render_commands) const
 {
 	const color_modification color_modification(this->get_hue_rotation(), this->get_colorization(), this->get_hue_ignored_colors(), player_color);
 
@@ -71,6 +71,7 @@ namespace archimedes {
 namespace wyrmgus {
 
 class player_color;
+class render_command_buffer;
 class renderer;
 
 /// Icon: rectangle image used in menus
@@ -120,16 +121,16 @@ public:
 	std::shared_ptr<CPlayerColorGraphic> get_graphics() const;
 
 	/// Draw icon
-	void DrawIcon(const PixelPos &pos, const player_color *player_color, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawIcon(const PixelPos &pos, const player_color *player_color, render_command_buffer &render_commands) const;
 	/// Draw grayscale icon
-	void DrawGrayscaleIcon(const PixelPos &pos, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawGrayscaleIcon(const PixelPos &pos, render_command_buffer &render_commands) const;
 	/// Draw cooldown spell
-	void DrawCooldownSpellIcon(const PixelPos &pos, const int percent, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawCooldownSpellIcon(const PixelPos &pos, const int percent, render_command_buffer &render_commands) const;
 
 	/// Draw icon of a unit
-	void DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player, QColor border_color, const bool transparent, const bool grayscale, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player, QColor border_color, const bool transparent, const bool grayscale, const int show_percent, render_command_buffer &render_commands) const;
 
-	void DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player, std::vector<std::function<void(renderer *)>> &render_commands) const
+	void DrawUnitIcon(const ButtonStyle &style, const unsigned flags, const PixelPos &pos, const std::string &text, const player_color *player, render_command_buffer &render_commands) const
 	{
 		this->DrawUnitIcon(style, flags, pos, text, player, QColor(), false, false, 100, render_commands);
 	}
@@ -991,6 +991,11 @@ static int InputKey(int key)
 				FastForwardCycle = atoi(&message_input[4]);
 			}
 
+			// Check for Replay and seek to minute x
+			if (strncmp(message_input.data(), "seek ", 5) == 0 && ReplayGameType != ReplayNone) {
+				SeekReplay(static_cast<unsigned long>(std::max(atoi(&message_input[5]), 0)) * CYCLES_PER_SECOND * 60);
+			}
+
 			if (message_input[0]) {
 				// Replace ~ with ~~
 				ReplaceTildeBy2Tilde(message_input.data());
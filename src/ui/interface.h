@@ -38,6 +38,7 @@ namespace wyrmgus {
 	class button;
 	class button_level;
 	class font_color;
+	class render_command_buffer;
 	class renderer;
 }
 
@@ -260,12 +261,12 @@ bool HandleCommandKey(int key, const Qt::KeyboardModifiers key_modifiers);
 extern void CancelBuildingMode();
 
 /// Draw user defined buttons
-extern void DrawUserDefinedButtons(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawUserDefinedButtons(render_command_buffer &render_commands);
 /// Draw the map layer buttons
-extern void DrawMapLayerButtons(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawMapLayerButtons(render_command_buffer &render_commands);
 //Wyrmgus start
 /// Draw certain popups if something is being hovered over
-extern void DrawPopups(std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawPopups(render_command_buffer &render_commands);
 //Wyrmgus end
 /// Set message to display
 extern void SetMessage(const char *fmt, ...) PRINTF_VAARG_ATTRIBUTE(1, 2);
@@ -286,23 +287,23 @@ extern void CleanMessages();
 extern void ToggleShowMessages();
 
 /// Draw the button popup
-extern void DrawPopup(const wyrmgus::button &button, int x, int y, bool above, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawPopup(const wyrmgus::button &button, int x, int y, bool above, render_command_buffer &render_commands);
 
-inline void DrawPopup(const wyrmgus::button &button, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+inline void DrawPopup(const wyrmgus::button &button, int x, int y, render_command_buffer &render_commands)
 {
 	DrawPopup(button, x, y, true, render_commands);
 }
 
 //Wyrmgus start
-extern void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, bool above, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, bool above, render_command_buffer &render_commands);
 //Wyrmgus end
 
-inline void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, std::vector<std::function<void(renderer *)>> &render_commands)
+inline void DrawGenericPopup(const std::string &popup_text, int x, int y, const font_color *text_color, const font_color *highlight_color, render_command_buffer &render_commands)
 {
 	DrawGenericPopup(popup_text, x, y, text_color, highlight_color, true, render_commands);
 }
 
-inline void DrawGenericPopup(const std::string &popup_text, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+inline void DrawGenericPopup(const std::string &popup_text, int x, int y, render_command_buffer &render_commands)
 {
 	DrawGenericPopup(popup_text, x, y, nullptr, nullptr, render_commands);
 }
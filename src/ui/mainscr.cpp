@@ -87,6 +87,7 @@
 #include "upgrade/upgrade.h"
 #include "video/font.h"
 #include "video/font_color.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -94,7 +95,7 @@
 --  UI BUTTONS
 ----------------------------------------------------------------------------*/
 
-void DrawUserDefinedButtons(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawUserDefinedButtons(render_command_buffer &render_commands)
 {
 	for (size_t i = 0; i < UI.UserButtons.size(); ++i) {
 		const CUIUserButton &button = UI.UserButtons[i];
@@ -122,7 +123,7 @@ void DrawUserDefinedButtons(std::vector<std::function<void(renderer *)>> &render
 **  @param x     Screen X position of icon
 **  @param y     Screen Y position of icon
 */
-static void UiDrawLifeBar(const CUnit &unit, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+static void UiDrawLifeBar(const CUnit &unit, int x, int y, render_command_buffer &render_commands)
 {
 	// FIXME: add icon borders
 	int hBar, hAll;
@@ -424,7 +425,7 @@ UStrInt GetComponent(const unit_type &type, const int index, const VariableAttri
 	return val;
 }
 
-static void DrawUnitInfo_Training(const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitInfo_Training(const CUnit &unit, render_command_buffer &render_commands)
 {
 	if (unit.Orders.size() == 1 || unit.Orders[1]->Action != UnitAction::Train) {
 		if (!UI.SingleTrainingText.empty()) {
@@ -497,7 +498,7 @@ static void DrawUnitInfo_Training(const CUnit &unit, std::vector<std::function<v
 	}
 }
 
-static void DrawUnitInfo_portrait(const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitInfo_portrait(const CUnit &unit, render_command_buffer &render_commands)
 {
 	if (UI.SingleSelectedButton) {
 		const PixelPos pos(UI.SingleSelectedButton->X, UI.SingleSelectedButton->Y);
@@ -516,7 +517,7 @@ static void DrawUnitInfo_portrait(const CUnit &unit, std::vector<std::function<v
 	}
 }
 
-static bool DrawUnitInfo_single_selection(const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static bool DrawUnitInfo_single_selection(const CUnit &unit, render_command_buffer &render_commands)
 {
 	switch (unit.CurrentAction()) {
 		case UnitAction::Train: { //  Building training units.
@@ -575,7 +576,7 @@ static bool DrawUnitInfo_single_selection(const CUnit &unit, std::vector<std::fu
 	}
 }
 
-static void DrawUnitInfo_transporter(CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitInfo_transporter(CUnit &unit, render_command_buffer &render_commands)
 {
 	size_t j = 0;
 
@@ -601,7 +602,7 @@ static void DrawUnitInfo_transporter(CUnit &unit, std::vector<std::function<void
 }
 
 //Wyrmgus start
-static void DrawUnitInfo_inventory(CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitInfo_inventory(CUnit &unit, render_command_buffer &render_commands)
 {
 	size_t j = 0;
 
@@ -631,7 +632,7 @@ static void DrawUnitInfo_inventory(CUnit &unit, std::vector<std::function<void(r
 **
 **  @param unit  Pointer to unit.
 */
-static void DrawUnitInfo(CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawUnitInfo(CUnit &unit, render_command_buffer &render_commands)
 {
 	UpdateUnitVariables(unit);
 	
@@ -686,7 +687,7 @@ static void DrawUnitInfo(CUnit &unit, std::vector<std::function<void(renderer *)
 /**
 **	@brief	Draw the map layer buttons.
 */
-void DrawMapLayerButtons(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawMapLayerButtons(render_command_buffer &render_commands)
 {
 	for (size_t i = 0; i < UI.WorldButtons.size(); ++i) {
 		if (UI.WorldButtons[i].X != -1) {
@@ -714,7 +715,7 @@ static std::unique_ptr<button> get_territory_tooltip_button(const CPlayer *playe
 /**
 **	@brief	Draw certain popups if something is being hovered over
 */
-void DrawPopups(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawPopups(render_command_buffer &render_commands)
 {
 	if (engine_interface::get()->is_modal_dialog_open()) {
 		return;
@@ -1106,14 +1107,14 @@ void CenterOnMessage()
 **
 **  @param frame  frame nr. of the info panel background.
 */
-static void DrawInfoPanelBackground(unsigned frame, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawInfoPanelBackground(unsigned frame, render_command_buffer &render_commands)
 {
 	if (UI.InfoPanel.G) {
 		UI.InfoPanel.G->DrawFrame(frame, UI.InfoPanel.X, UI.InfoPanel.Y, render_commands);
 	}
 }
 
-static void InfoPanel_draw_no_selection(std::vector<std::function<void(renderer *)>> &render_commands)
+static void InfoPanel_draw_no_selection(render_command_buffer &render_commands)
 {
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
 
@@ -1179,7 +1180,7 @@ static void InfoPanel_draw_no_selection(std::vector<std::function<void(renderer
 	}
 }
 
-static void InfoPanel_draw_single_selection(CUnit *selUnit, std::vector<std::function<void(renderer *)>> &render_commands)
+static void InfoPanel_draw_single_selection(CUnit *selUnit, render_command_buffer &render_commands)
 {
 	CUnit &unit = (selUnit ? *selUnit : *Selected[0]);
 	int panelIndex;
@@ -1241,7 +1242,7 @@ static void InfoPanel_draw_single_selection(CUnit *selUnit, std::vector<std::fun
 	//Wyrmgus end
 }
 
-static void InfoPanel_draw_multiple_selection(std::vector<std::function<void(renderer *)>> &render_commands)
+static void InfoPanel_draw_multiple_selection(render_command_buffer &render_commands)
 {
 	//  If there are more units selected draw their pictures and a health bar
 	DrawInfoPanelBackground(0, render_commands);
@@ -1287,7 +1288,7 @@ static void InfoPanel_draw_multiple_selection(std::vector<std::function<void(ren
 **    magic unit   - magic units
 **    construction - under construction
 */
-void CInfoPanel::Draw(std::vector<std::function<void(renderer *)>> &render_commands)
+void CInfoPanel::Draw(render_command_buffer &render_commands)
 {
 	if (UnitUnderCursor && Selected.empty() && !UnitUnderCursor->Type->BoolFlag[ISNOTSELECTABLE_INDEX].value
 		&& (ReplayRevealMap || UnitUnderCursor->IsVisible(*CPlayer::GetThisPlayer()))) {
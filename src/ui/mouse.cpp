@@ -56,6 +56,7 @@
 #include "province.h"
 //Wyrmgus end
 #include "religion/deity.h"
+#include "replay.h"
 #include "script.h"
 #include "script/condition/condition.h"
 #include "sound/game_sound_set.h"
@@ -1002,12 +1003,14 @@ static void DoRightButton(const PixelPos &mapPixelPos, const Qt::KeyboardModifie
 	}
 
 	int acknowledged = 0; // to play sound
+	BeginCommandLogGroup();
 	for (size_t i = 0; i != Selected.size(); ++i) {
 		assert_throw(Selected[i] != nullptr);
 		CUnit &unit = *Selected[i];
 
 		DoRightButton_ForSelectedUnit(unit, dest, pos, acknowledged, key_modifiers);
 	}
+	EndCommandLogGroup();
 	ShowOrdersCount = GameCycle + Preference.ShowOrders * CYCLES_PER_SECOND;
 }
 
@@ -2004,6 +2007,8 @@ static void SendCommand(const Vec2i &tilePos, const Qt::KeyboardModifiers key_mo
 	UI.ButtonPanel.Update();
 	
 	const int flush = !(key_modifiers & Qt::ShiftModifier);
+
+	BeginCommandLogGroup();
 	
 	switch (CursorAction) {
 		case ButtonCmd::Move:
@@ -2063,6 +2068,9 @@ static void SendCommand(const Vec2i &tilePos, const Qt::KeyboardModifiers key_mo
 			DebugPrint("Unsupported send action %d\n" _C_ CursorAction);
 			break;
 	}
+
+	EndCommandLogGroup();
+
 	if (ret) {
 		// Acknowledge the command with first selected unit.
 		for (size_t i = 0; i != Selected.size(); ++i) {
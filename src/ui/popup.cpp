@@ -133,7 +133,7 @@ int CPopupContentTypeButtonInfo::GetHeight(const wyrmgus::button &button, int *)
 	return height;
 }
 
-void CPopupContentTypeButtonInfo::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CPopupContentTypeButtonInfo::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *, render_command_buffer &render_commands) const
 {
 	wyrmgus::font *font = this->Font ? this->Font : defines::get()->get_small_font();
 	CLabel label(font, this->TextColor, this->HighlightColor);
@@ -263,7 +263,7 @@ CPopupContentTypeText::~CPopupContentTypeText()
 {
 }
 
-void CPopupContentTypeText::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CPopupContentTypeText::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *, render_command_buffer &render_commands) const
 {
 	wyrmgus::font *font = this->Font ? this->Font : defines::get()->get_small_font();
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
@@ -407,7 +407,7 @@ int CPopupContentTypeCosts::GetHeight(const wyrmgus::button &button, int *Costs)
 	return std::max(popupHeight, font->Height());
 }
 
-void CPopupContentTypeCosts::Draw(int x, int y, const CPopup &, const unsigned int, const wyrmgus::button &button, int *Costs, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CPopupContentTypeCosts::Draw(int x, int y, const CPopup &, const unsigned int, const wyrmgus::button &button, int *Costs, render_command_buffer &render_commands) const
 {
 	wyrmgus::font *font = this->Font ? this->Font : defines::get()->get_small_font();
 	CLabel label(font, this->TextColor, this->HighlightColor);
@@ -506,7 +506,7 @@ int CPopupContentTypeLine::GetHeight(const wyrmgus::button &button, int *Costs)
 	return this->Height;
 }
 
-void CPopupContentTypeLine::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *Costs, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CPopupContentTypeLine::Draw(int x, int y, const CPopup &popup, const unsigned int popupWidth, const wyrmgus::button &button, int *Costs, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(button)
 	Q_UNUSED(Costs)
@@ -564,7 +564,7 @@ CPopupContentTypeVariable::~CPopupContentTypeVariable()
 {
 }
 
-void CPopupContentTypeVariable::Draw(int x, int y, const CPopup &, const unsigned int, const wyrmgus::button &button, int *, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CPopupContentTypeVariable::Draw(int x, int y, const CPopup &, const unsigned int, const wyrmgus::button &button, int *, render_command_buffer &render_commands) const
 {
 	wyrmgus::font *font = this->Font ? this->Font : defines::get()->get_small_font(); // Font to use.
 
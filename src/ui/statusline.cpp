@@ -38,7 +38,7 @@
 #include "video/font.h"
 #include "video/video.h"
 
-void CStatusLine::Draw(std::vector<std::function<void(renderer *)>> &render_commands)
+void CStatusLine::Draw(render_command_buffer &render_commands)
 {
 	if (!this->StatusLine.empty()) {
 		PushClipping();
@@ -94,7 +94,7 @@ void CStatusLine::ClearCosts()
 **
 **  @internal MaxCost == FoodCost.
 */
-void CStatusLine::DrawCosts(std::vector<std::function<void(renderer *)>> &render_commands)
+void CStatusLine::DrawCosts(render_command_buffer &render_commands)
 {
 	int x = UI.StatusLine.TextX + 268;
 	CLabel label(wyrmgus::defines::get()->get_game_font());
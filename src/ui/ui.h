@@ -220,7 +220,7 @@ private:
 class CButtonPanel final
 {
 public:
-	void Draw(std::vector<std::function<void(renderer *)>> &render_commands);
+	void Draw(render_command_buffer &render_commands);
 	void Update();
 	void DoClicked(int button, const Qt::KeyboardModifiers key_modifiers);
 	int DoKey(int key, const Qt::KeyboardModifiers key_modifiers);
@@ -264,7 +264,7 @@ public:
 class CInfoPanel final
 {
 public:
-	void Draw(std::vector<std::function<void(renderer *)>> &render_commands);
+	void Draw(render_command_buffer &render_commands);
 
 	std::shared_ptr<CGraphic> G;
 	int X = 0;
@@ -51,7 +51,7 @@
 **  @param text   text to print on button
 */
 void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y,
-				  const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+				  const std::string &text, const bool grayscale, const color_modification &color_modification, bool transparent, int show_percent, render_command_buffer &render_commands)
 {
 	ButtonStyleProperties *p;
 
@@ -111,7 +111,7 @@ void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y,
 	}
 }
 
-void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawUIButton(ButtonStyle *style, unsigned flags, int x, int y, const std::string &text, render_command_buffer &render_commands)
 {
 	DrawUIButton(style, flags, x, y, text, false, color_modification(), false, render_commands);
 }
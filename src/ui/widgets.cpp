@@ -172,7 +172,7 @@ void handleInput(const SDL_Event *event)
 	}
 }
 
-void DrawGuichanWidgets(std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawGuichanWidgets(render_command_buffer &render_commands)
 {
 	if (Gui && Gui->getTop() != nullptr) {
 		Gui->setUseDirtyDrawing(false);
@@ -233,7 +233,7 @@ void MyOpenGLGraphics::_endDraw()
 	popClipArea();
 }
 
-void MyOpenGLGraphics::drawImage(const gcn::Image *image, int srcX, int srcY, int dstX, int dstY, int width, int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, std::vector<std::function<void(renderer *)>> &render_commands) const
+void MyOpenGLGraphics::drawImage(const gcn::Image *image, int srcX, int srcY, int dstX, int dstY, int width, int height, const color_modification &color_modification, unsigned int transparency, bool grayscale, render_command_buffer &render_commands) const
 {
 	Q_UNUSED(transparency)
 
@@ -264,7 +264,7 @@ void MyOpenGLGraphics::drawImage(const gcn::Image *image, int srcX, int srcY, in
 	PopClipping();
 }
 
-void MyOpenGLGraphics::drawLine(int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void MyOpenGLGraphics::drawLine(int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	gcn::Color c = this->getColor();
 	const PixelPos pos1(x1 + mClipStack.top().xOffset, y1 + mClipStack.top().yOffset);
@@ -273,7 +273,7 @@ void MyOpenGLGraphics::drawLine(int x1, int y1, int x2, int y2, std::vector<std:
 	Video.DrawLineClip(CVideo::MapRGBA(c.r, c.g, c.b, c.a), pos1, pos2, render_commands);
 }
 
-void MyOpenGLGraphics::drawRectangle(const gcn::Rectangle &rectangle, std::vector<std::function<void(renderer *)>> &render_commands)
+void MyOpenGLGraphics::drawRectangle(const gcn::Rectangle &rectangle, render_command_buffer &render_commands)
 {
 	gcn::Color c = this->getColor();
 	if (c.a == 0) {
@@ -298,7 +298,7 @@ void MyOpenGLGraphics::drawRectangle(const gcn::Rectangle &rectangle, std::vecto
 							 x1, y1, x2 - x1, y2 - y1, mColor.a, render_commands);
 }
 
-void MyOpenGLGraphics::fillRectangle(const gcn::Rectangle &rectangle, std::vector<std::function<void(renderer *)>> &render_commands)
+void MyOpenGLGraphics::fillRectangle(const gcn::Rectangle &rectangle, render_command_buffer &render_commands)
 {
 	const gcn::Color c = this->getColor();
 
@@ -364,7 +364,7 @@ PlayerColorImageWidget::PlayerColorImageWidget(const std::string &image_path, co
 	setWidth(graphic->getWidth());
 }
 
-void PlayerColorImageWidget::draw(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void PlayerColorImageWidget::draw(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	const player_color *player_color = nullptr;
 	if (!this->WidgetPlayerColor.empty()) {
@@ -430,7 +430,7 @@ ImageButton::~ImageButton()
 **
 **  @param graphics  Graphics object to draw with
 */
-void ImageButton::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageButton::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	if (!normalImage) {
 		Button::draw(graphics, render_commands);
@@ -655,7 +655,7 @@ PlayerColorImageButton::PlayerColorImageButton(const std::string &caption, const
 **
 **  @param graphics  Graphics object to draw with
 */
-void PlayerColorImageButton::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void PlayerColorImageButton::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	if (!normalImage) {
 		Button::draw(graphics, render_commands);
@@ -850,7 +850,7 @@ ImageCheckBox::ImageCheckBox(const std::string &caption, bool marked) :
 /**
 **  Draw the image checkbox
 */
-void ImageCheckBox::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageCheckBox::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	drawBox(graphics, render_commands);
 
@@ -876,7 +876,7 @@ void ImageCheckBox::draw(gcn::Graphics *graphics, std::vector<std::function<void
 /**
 **  Draw the checkbox (not the caption)
 */
-void ImageCheckBox::drawBox(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageCheckBox::drawBox(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	std::shared_ptr<CGraphic> img;
 
@@ -1109,7 +1109,7 @@ void MultiLineLabel::adjustSize()
 /**
 **  Draw the label
 */
-void MultiLineLabel::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void MultiLineLabel::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	graphics->setFont(getFont());
 	graphics->setColor(getForegroundColor());
@@ -1153,7 +1153,7 @@ void MultiLineLabel::draw(gcn::Graphics *graphics, std::vector<std::function<voi
 /**
 **  Draw the border
 */
-void MultiLineLabel::drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void MultiLineLabel::drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Color faceColor = getBaseColor();
 	gcn::Color highlightColor, shadowColor;
@@ -1330,7 +1330,7 @@ void ScrollingWidget::restart()
 --  ImageTextField
 ----------------------------------------------------------------------------*/
 
-void ImageTextField::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageTextField::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Font *font;
 	int x, y;
@@ -1376,7 +1376,7 @@ void ImageTextField::draw(gcn::Graphics *graphics, std::vector<std::function<voi
 	graphics->drawText(mText, x, y, render_commands);
 }
 
-void ImageTextField::drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageTextField::drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Color faceColor = getBaseColor();
 	gcn::Color highlightColor, shadowColor;
@@ -1430,7 +1430,7 @@ ImageListBox::ImageListBox(gcn::ListModel *listModel) : gcn::ListBox(listModel),
 {
 }
 
-void ImageListBox::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBox::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	if (mListModel == nullptr) {
 		return;
@@ -1464,7 +1464,7 @@ void ImageListBox::draw(gcn::Graphics *graphics, std::vector<std::function<void(
 	//img->SetOriginalSize();
 }
 
-void ImageListBox::drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBox::drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Color faceColor = getBaseColor();
 	gcn::Color highlightColor, shadowColor;
@@ -1776,7 +1776,7 @@ void ImageListBoxWidget::setVBarImage(CGraphic *image) {
 **
 **  @param  graphics Graphics to use
 */
-void ImageListBoxWidget::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	CGraphic *img = nullptr;
 
@@ -1857,7 +1857,7 @@ void ImageListBoxWidget::draw(gcn::Graphics *graphics, std::vector<std::function
 **
 **  @param  graphics Graphics to use
 */
-void ImageListBoxWidget::drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Color faceColor = getBaseColor();
 	gcn::Color highlightColor, shadowColor;
@@ -1881,7 +1881,7 @@ void ImageListBoxWidget::drawBorder(gcn::Graphics *graphics, std::vector<std::fu
 	}
 }
 
-void ImageListBoxWidget::drawUpButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawUpButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getUpButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1893,7 +1893,7 @@ void ImageListBoxWidget::drawUpButton(gcn::Graphics* graphics, std::vector<std::
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawDownButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawDownButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getDownButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1905,7 +1905,7 @@ void ImageListBoxWidget::drawDownButton(gcn::Graphics* graphics, std::vector<std
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawLeftButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawLeftButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getLeftButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1917,7 +1917,7 @@ void ImageListBoxWidget::drawLeftButton(gcn::Graphics* graphics, std::vector<std
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawRightButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawRightButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getRightButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1929,7 +1929,7 @@ void ImageListBoxWidget::drawRightButton(gcn::Graphics* graphics, std::vector<st
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawUpPressedButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawUpPressedButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getUpButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1941,7 +1941,7 @@ void ImageListBoxWidget::drawUpPressedButton(gcn::Graphics* graphics, std::vecto
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawDownPressedButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawDownPressedButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getDownButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1953,7 +1953,7 @@ void ImageListBoxWidget::drawDownPressedButton(gcn::Graphics* graphics, std::vec
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawLeftPressedButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawLeftPressedButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getLeftButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1965,7 +1965,7 @@ void ImageListBoxWidget::drawLeftPressedButton(gcn::Graphics* graphics, std::vec
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawRightPressedButton(gcn::Graphics* graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawRightPressedButton(gcn::Graphics* graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getRightButtonDimension();
 	graphics->pushClipArea(dim);
@@ -1977,7 +1977,7 @@ void ImageListBoxWidget::drawRightPressedButton(gcn::Graphics* graphics, std::ve
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawHBar(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawHBar(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getHorizontalBarDimension();
 	graphics->pushClipArea(dim);
@@ -1992,7 +1992,7 @@ void ImageListBoxWidget::drawHBar(gcn::Graphics *graphics, std::vector<std::func
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawVBar(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawVBar(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getVerticalBarDimension();
 	graphics->pushClipArea(dim);
@@ -2007,7 +2007,7 @@ void ImageListBoxWidget::drawVBar(gcn::Graphics *graphics, std::vector<std::func
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawHMarker(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawHMarker(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getHorizontalMarkerDimension();
 	graphics->pushClipArea(dim);
@@ -2020,7 +2020,7 @@ void ImageListBoxWidget::drawHMarker(gcn::Graphics *graphics, std::vector<std::f
 	graphics->popClipArea();
 }
 
-void ImageListBoxWidget::drawVMarker(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageListBoxWidget::drawVMarker(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Rectangle dim = getVerticalMarkerDimension();
 	graphics->pushClipArea(dim);
@@ -2196,7 +2196,7 @@ void ImageDropDownWidget::setDownPressedImage(const std::string &image_path)
 	DownPressedImage->Load(preferences::get()->get_scale_factor());
 }
 
-void ImageDropDownWidget::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageDropDownWidget::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	assert_throw(mScrollArea && mScrollArea->getContent() != nullptr);
 	int h;
@@ -2235,7 +2235,7 @@ void ImageDropDownWidget::draw(gcn::Graphics *graphics, std::vector<std::functio
 	}
 }
 
-void ImageDropDownWidget::drawBorder(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageDropDownWidget::drawBorder(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	gcn::Color faceColor = getBaseColor();
 	gcn::Color highlightColor, shadowColor;
@@ -2259,7 +2259,7 @@ void ImageDropDownWidget::drawBorder(gcn::Graphics *graphics, std::vector<std::f
 	}
 }
 
-void ImageDropDownWidget::drawButton(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void ImageDropDownWidget::drawButton(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	int h;
 	if (mDroppedDown)
@@ -2414,7 +2414,7 @@ StatBoxWidget::StatBoxWidget(int width, int height) : percent(100)
 **  @todo caption seem to be placed upper than the middle.
 **  @todo set direction (hor./vert.) and growing direction(up/down, left/rigth).
 */
-void StatBoxWidget::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void StatBoxWidget::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	int width;
 	int height;
@@ -2577,7 +2577,7 @@ void MenuScreen::addLogicCallback(LuaActionListener *listener)
 	logiclistener = listener;
 }
 
-void MenuScreen::draw(gcn::Graphics *graphics, std::vector<std::function<void(renderer *)>> &render_commands)
+void MenuScreen::draw(gcn::Graphics *graphics, render_command_buffer &render_commands)
 {
 	if (this->drawUnder) {
 		gcn::Rectangle r = Gui->getGraphics()->getCurrentClipArea();
@@ -103,6 +103,18 @@ static int CclSetRevealAttacker(lua_State *l)
 	return 0;
 }
 
+/**
+**  Set whether units are allocated in contiguous slabs, taking effect once there are no units allocated.
+**
+**  @param l  Lua state.
+*/
+static int CclSetUnitSlabAllocation(lua_State *l)
+{
+	LuaCheckArgs(l, 1);
+	wyrmgus::unit_manager::get()->set_slab_allocation_enabled(LuaToBoolean(l, 1));
+	return 0;
+}
+
 /**
 **  Set cost multiplier to RepairCost for buildings additional workers helping (0 = no additional cost)
 **
@@ -765,6 +777,8 @@ int CclUnit(lua_State *l)
 		MapMarkUnitSight(*unit);
 	}
 
+	unit->invalidate_derived_stats();
+
 	return 0;
 }
 
@@ -2132,6 +2146,7 @@ void UnitCclRegister()
 {
 	lua_register(Lua, "SetTrainingQueue", CclSetTrainingQueue);
 	lua_register(Lua, "SetRevealAttacker", CclSetRevealAttacker);
+	lua_register(Lua, "SetUnitSlabAllocation", CclSetUnitSlabAllocation);
 	lua_register(Lua, "ResourcesMultiBuildersMultiplier", CclResourcesMultiBuildersMultiplier);
 
 	lua_register(Lua, "Unit", CclUnit);
@@ -556,6 +556,7 @@ void CUnit::Release(const bool final)
 	this->pathFinderData.reset();
 	this->autocast_spells.clear();
 	this->spell_cooldown_timers.clear();
+	this->status_effect_timers.clear();
 	this->Variable.clear();
 	this->Orders.clear();
 	this->clear_special_orders();
@@ -1019,6 +1020,9 @@ void CUnit::set_character(wyrmgus::character *character)
 		this->apply_character_properties();
 	}
 
+	//the character's variables and upgrades replace the ones the cached stats were derived from
+	this->invalidate_derived_stats();
+
 	this->ChooseVariation(); //choose a new variation now
 	for (int i = 0; i < MaxImageLayers; ++i) {
 		ChooseVariation(nullptr, false, i);
@@ -1733,6 +1737,8 @@ void CUnit::EquipItem(CUnit &item, bool affect_character)
 			}
 		}
 	}
+
+	this->invalidate_derived_stats();
 }
 
 void CUnit::DeequipItem(CUnit &item, bool affect_character)
@@ -1766,6 +1772,8 @@ void CUnit::DeequipItem(CUnit &item, bool affect_character)
 			MapMarkUnitSight(*this);
 		}
 	}
+
+	this->invalidate_derived_stats();
 	
 	if (item.get_unique() != nullptr && item.get_unique()->get_set() != nullptr && this->DeequippingItemBreaksSet(&item)) {
 		for (const auto &modifier : item.get_unique()->get_set()->get_modifiers()) {
@@ -3261,6 +3269,8 @@ void CUnit::Init(const wyrmgus::unit_type &type, const bool loading_saved_unit)
 		this->Variable.clear();
 	}
 
+	this->invalidate_derived_stats();
+
 	IndividualUpgrades.clear();
 
 	// Set a heading for the unit if it Handles Directions
@@ -3388,6 +3398,9 @@ void CUnit::AssignToPlayer(CPlayer &player)
 		}
 	}
 
+	//the stats of the new player replace the ones the cached stats were derived from
+	this->invalidate_derived_stats();
+
 	// Build player unit table
 	//Wyrmgus start
 //	if (!type.BoolFlag[VANISHES_INDEX].value && CurrentAction() != UnitAction::Die) {
@@ -3710,6 +3723,127 @@ void MapUnmarkUnitSight(CUnit &unit)
 	}
 }
 
+/**
+**  Get the ranges with which the sight of the unit (and units inside) is marked on the vision table.
+**
+**  @param unit      Unit whose sight markings to get.
+**  @param markings  Vector to which the markings are added, for the unit and then recursively for the units inside.
+*/
+static void GetUnitSightMarkingsRec(const CUnit &unit, std::vector<unit_sight_marking> &markings)
+{
+	unit_sight_marking &marking = markings.emplace_back();
+
+	marking.sight_range = unit.Container && unit.Container->CurrentSightRange >= unit.CurrentSightRange ? unit.Container->CurrentSightRange : unit.CurrentSightRange;
+
+	if (unit.Type && unit.Type->BoolFlag[DETECTCLOAK_INDEX].value) {
+		marking.detect_cloak_range = marking.sight_range;
+	}
+
+	if (unit.Variable[ETHEREALVISION_INDEX].Value) {
+		marking.ethereal_vision_range = marking.sight_range;
+	}
+
+	for (const CUnit *unit_inside : unit.get_units_inside()) {
+		GetUnitSightMarkingsRec(*unit_inside, markings);
+	}
+}
+
+/**
+**  Get the ranges with which the sight of the unit (and units inside for
+**  transporter) is marked on the vision table, as done by MapMarkUnitSight.
+**
+**  @param unit      Unit whose sight markings to get; it must not be inside a container.
+**  @param markings  Vector to fill with the markings.
+*/
+void GetUnitSightMarkings(const CUnit &unit, std::vector<unit_sight_marking> &markings)
+{
+	assert_throw(unit.Container == nullptr);
+
+	markings.clear();
+	GetUnitSightMarkingsRec(unit, markings);
+
+	// Radar is only marked for the top unit, and if the unit is usable
+	if (!unit.IsUnusable()) {
+		markings.front().radar_range = unit.Stats->Variables[RADAR_INDEX].Value;
+		markings.front().radar_jammer_range = unit.Stats->Variables[RADARJAMMER_INDEX].Value;
+	}
+}
+
+/**
+**  Move a sight area on the vision table.
+**
+**  If the range is the same as the one with which the area was marked,
+**  only the tiles which differ between the positions are marked or
+**  unmarked; otherwise the area is unmarked with its old range and marked
+**  again with the new one.
+*/
+template <map_marker_func_ptr marker, map_marker_func_ptr unmarker>
+static void MapMoveSight(const CPlayer &player, const Vec2i &old_pos, const int old_range, const Vec2i &pos, const int range, const int width, const int height, const int z)
+{
+	if (old_range == range) {
+		MapSightDelta<marker, unmarker>(player, old_pos, pos, width, height, range, z);
+		return;
+	}
+
+	MapSight<unmarker>(player, old_pos, width, height, old_range, z);
+	MapSight<marker>(player, pos, width, height, range, z);
+}
+
+/**
+**  Move on vision table the Sight of the unit (and units inside for
+**  transporter), after it has moved within the same map layer.
+**
+**  The sight is unmarked with the ranges with which it was marked at the
+**  old position, so this is equivalent to MapUnmarkUnitSight before the
+**  move followed by MapMarkUnitSight after it, but for ranges which did
+**  not change, only the tiles which entered or left the unit's sight are
+**  marked or unmarked.
+**
+**  @param unit          unit to move its vision.
+**  @param old_pos       position of the unit before it moved.
+**  @param old_markings  sight markings of the unit before it moved, as given by GetUnitSightMarkings.
+**  @see MapMarkUnitSight.
+*/
+void MapMoveUnitSight(CUnit &unit, const Vec2i &old_pos, const std::vector<unit_sight_marking> &old_markings)
+{
+	assert_throw(unit.Type != nullptr);
+	assert_throw(unit.Container == nullptr);
+
+	static std::vector<unit_sight_marking> markings;
+	GetUnitSightMarkings(unit, markings);
+
+	const int width = unit.Type->get_tile_width();
+	const int height = unit.Type->get_tile_height();
+	const int z = unit.MapLayer->ID;
+
+	if (markings.size() != old_markings.size()) {
+		//the units inside changed, which should not happen when moving; unmark all of the old sight, and mark the new one
+		for (const unit_sight_marking &old_marking : old_markings) {
+			MapSight<MapUnmarkTileSight>(*unit.Player, old_pos, width, height, old_marking.sight_range, z);
+			MapSight<MapUnmarkTileDetectCloak>(*unit.Player, old_pos, width, height, old_marking.detect_cloak_range, z);
+			MapSight<MapUnmarkTileDetectEthereal>(*unit.Player, old_pos, width, height, old_marking.ethereal_vision_range, z);
+		}
+
+		MapSight<MapUnmarkTileRadar>(*unit.Player, old_pos, width, height, old_markings.front().radar_range, z);
+		MapSight<MapUnmarkTileRadarJammer>(*unit.Player, old_pos, width, height, old_markings.front().radar_jammer_range, z);
+
+		MapMarkUnitSight(unit);
+		return;
+	}
+
+	for (size_t i = 0; i < markings.size(); ++i) {
+		const unit_sight_marking &old_marking = old_markings[i];
+		const unit_sight_marking &marking = markings[i];
+
+		MapMoveSight<MapMarkTileSight, MapUnmarkTileSight>(*unit.Player, old_pos, old_marking.sight_range, unit.tilePos, marking.sight_range, width, height, z);
+		MapMoveSight<MapMarkTileDetectCloak, MapUnmarkTileDetectCloak>(*unit.Player, old_pos, old_marking.detect_cloak_range, unit.tilePos, marking.detect_cloak_range, width, height, z);
+		MapMoveSight<MapMarkTileDetectEthereal, MapUnmarkTileDetectEthereal>(*unit.Player, old_pos, old_marking.ethereal_vision_range, unit.tilePos, marking.ethereal_vision_range, width, height, z);
+	}
+
+	MapMoveSight<MapMarkTileRadar, MapUnmarkTileRadar>(*unit.Player, old_pos, old_markings.front().radar_range, unit.tilePos, markings.front().radar_range, width, height, z);
+	MapMoveSight<MapMarkTileRadarJammer, MapUnmarkTileRadarJammer>(*unit.Player, old_pos, old_markings.front().radar_jammer_range, unit.tilePos, markings.front().radar_jammer_range, width, height, z);
+}
+
 /**
 **  Update the Unit Current sight range to good value and transported units inside.
 **
@@ -3759,11 +3893,35 @@ void UpdateUnitSightRange(CUnit &unit)
 		}
 	}
 
+	unit.invalidate_derived_stats();
+
 	for (CUnit *unit_inside : unit.get_units_inside()) {
 		UpdateUnitSightRange(*unit_inside);
 	}
 }
 
+/**
+**  Check whether unit field flags make the tiles impassable beyond merely being occupied by a unit.
+*/
+static bool AffectsTilePassability(const tile_flag flags)
+{
+	return (flags & ~(tile_flag::land_unit | tile_flag::sea_unit | tile_flag::air_unit)) != tile_flag::none;
+}
+
+/**
+**  Notify the pathfinder that the passability of the tiles under a unit has changed.
+*/
+static void NotifyUnitTilesPassabilityChanged(const CUnit &unit, const tile_flag flags)
+{
+	const QRect tile_rect = unit.get_tile_rect();
+
+	for (int x = tile_rect.left(); x <= tile_rect.right(); ++x) {
+		for (int y = tile_rect.top(); y <= tile_rect.bottom(); ++y) {
+			AStarTilePassabilityChanged(QPoint(x, y), unit.MapLayer->ID, flags);
+		}
+	}
+}
+
 /**
 **  Mark the field with the FieldFlags.
 **
@@ -3794,12 +3952,19 @@ void MarkUnitFieldFlags(const CUnit &unit)
 	do {
 		wyrmgus::tile *mf = unit.MapLayer->Field(index);
 		int w = width;
+		unsigned int tile_index = index;
 		do {
 			mf->Flags |= flags;
+			AStarTileOccupancyChanged(tile_index, unit.MapLayer->ID, mf->get_flags());
 			++mf;
+			++tile_index;
 		} while (--w);
 		index += unit.MapLayer->get_width();
 	} while (--h);
+
+	if (AffectsTilePassability(flags)) {
+		NotifyUnitTilesPassabilityChanged(unit, flags);
+	}
 }
 
 class _UnmarkUnitFieldFlags final
@@ -3849,15 +4014,22 @@ void UnmarkUnitFieldFlags(const CUnit &unit)
 		wyrmgus::tile *mf = unit.MapLayer->Field(index);
 
 		int w = width;
+		unsigned int tile_index = index;
 		do {
 			mf->Flags &= flags;//clean flags
 			_UnmarkUnitFieldFlags funct(unit, mf);
 
 			mf->UnitCache.for_each(funct);
+			AStarTileOccupancyChanged(tile_index, unit.MapLayer->ID, mf->get_flags());
 			++mf;
+			++tile_index;
 		} while (--w);
 		index += unit.MapLayer->get_width();
 	} while (--h);
+
+	if (AffectsTilePassability(unit.Type->FieldFlags)) {
+		NotifyUnitTilesPassabilityChanged(unit, unit.Type->FieldFlags);
+	}
 }
 
 /**
@@ -3870,6 +4042,7 @@ void CUnit::AddInContainer(CUnit &host)
 	assert_throw(this->Container == nullptr);
 	this->Container = &host;
 	host.add_unit_inside(this);
+	this->invalidate_derived_stats();
 
 	//Wyrmgus start
 	if (!SaveGameLoading) {
@@ -3892,6 +4065,7 @@ static void RemoveUnitFromContainer(CUnit &unit)
 	
 	host->remove_unit_inside(&unit);
 	unit.Container = nullptr;
+	unit.invalidate_derived_stats();
 	//Wyrmgus start
 	//reset host attack range
 	host->update_for_transported_units();
@@ -4169,6 +4343,11 @@ void CUnit::UpdateBuildingSettlementAssignment(const wyrmgus::site *old_settleme
 
 void CUnit::on_variable_changed(const int var_index, const int change)
 {
+	//the variable may have had other components than its value changed (e.g. whether it is enabled), so invalidate the derived stats even if the value has not changed
+	if (CUnit::is_derived_stat_dependency(var_index)) {
+		this->invalidate_derived_stats();
+	}
+
 	if (change == 0) {
 		return;
 	}
@@ -4266,6 +4445,7 @@ static void UnitInXY(CUnit &unit, const Vec2i &pos, const int z)
 	unit.tilePos = pos;
 	unit.Offset = CMap::get()->get_pos_index(pos, z);
 	unit.MapLayer = CMap::get()->MapLayers[z].get();
+	unit.invalidate_derived_stats();
 
 	const time_of_day *new_time_of_day = unit.get_center_tile_time_of_day();
 
@@ -4292,7 +4472,19 @@ static void UnitInXY(CUnit &unit, const Vec2i &pos, const int z)
 void CUnit::MoveToXY(const Vec2i &pos, const int z)
 //Wyrmgus end
 {
-	MapUnmarkUnitSight(*this);
+	const Vec2i old_pos = this->tilePos;
+
+	//when moving within the same map layer, the sight is moved after the unit is placed, unmarking it with the ranges with which it was marked, but only (un)marking the tiles which changed for ranges which stayed the same
+	const bool move_sight = this->MapLayer->ID == z && this->Container == nullptr;
+
+	std::vector<unit_sight_marking> old_sight_markings;
+
+	if (move_sight) {
+		GetUnitSightMarkings(*this, old_sight_markings);
+	} else {
+		MapUnmarkUnitSight(*this);
+	}
+
 	CMap::get()->Remove(*this);
 	UnmarkUnitFieldFlags(*this);
 
@@ -4310,7 +4502,12 @@ void CUnit::MoveToXY(const Vec2i &pos, const int z)
 	MarkUnitFieldFlags(*this);
 	//  Recalculate the seen count.
 	UnitCountSeen(*this);
-	MapMarkUnitSight(*this);
+
+	if (move_sight) {
+		MapMoveUnitSight(*this, old_pos, old_sight_markings);
+	} else {
+		MapMarkUnitSight(*this);
+	}
 
 	if (game::get()->is_running()) {
 		emit this->MapLayer->unit_tile_pos_changed(UnitNumber(*this), this->tilePos);
@@ -4687,6 +4884,7 @@ CUnit *CreateUnit(const Vec2i &pos, const unit_type &type, CPlayer *player, cons
 
 	if (unit != nullptr) {
 		unit->MapLayer = CMap::get()->MapLayers[z].get();
+		unit->invalidate_derived_stats();
 
 		const int heading = SyncRand(256);
 		const QPoint res_pos = FindNearestDrop(type, pos, heading, z, no_building_bordering_impassable, ignore_ontop, settlement);
@@ -6158,6 +6356,70 @@ void CUnit::remove_bonus_ability(const CUpgrade *ability)
 }
 
 int CUnit::GetModifiedVariable(const int index, const VariableAttribute variable_type) const
+{
+	if (variable_type == VariableAttribute::Value) {
+		switch (index) {
+			case ATTACKRANGE_INDEX:
+				return this->get_cached_modified_variable(index, this->cached_modified_attack_range);
+			case SPEED_INDEX:
+				return this->get_cached_modified_variable(index, this->cached_modified_speed);
+			default:
+				break;
+		}
+	}
+
+	return this->calculate_modified_variable(index, variable_type);
+}
+
+int CUnit::GetModifiedVariable(const int index) const
+{
+	return this->GetModifiedVariable(index, VariableAttribute::Value);
+}
+
+int CUnit::get_cached_modified_variable(const int index, std::optional<int> &cached_value) const
+{
+	if (!cached_value.has_value()) {
+		cached_value = this->calculate_modified_variable(index, VariableAttribute::Value);
+		return cached_value.value();
+	}
+
+#ifdef DEBUG
+	//check the cached value against a fresh calculation, to catch missing invalidations
+	const int calculated_value = this->calculate_modified_variable(index, VariableAttribute::Value);
+	if (calculated_value != cached_value.value()) {
+		log::log_error("Cached modified value (" + std::to_string(cached_value.value()) + ") for variable \"" + UnitTypeVar.VariableNameLookup[index] + "\" of unit of type \"" + this->Type->get_identifier() + "\" differs from its calculated value (" + std::to_string(calculated_value) + ").");
+		cached_value = calculated_value;
+	}
+#endif
+
+	return cached_value.value();
+}
+
+bool CUnit::is_derived_stat_dependency(const int var_index)
+{
+	switch (var_index) {
+		case ATTACKRANGE_INDEX:
+		case SPEED_INDEX:
+		case RAIL_SPEED_BONUS_INDEX:
+		case GARRISONEDRANGEBONUS_INDEX:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void CUnit::invalidate_derived_stats()
+{
+	this->cached_modified_attack_range.reset();
+	this->cached_modified_speed.reset();
+
+	//the attack range of units inside depends on the container's garrisoned range bonus
+	for (CUnit *unit_inside : this->get_units_inside()) {
+		unit_inside->invalidate_derived_stats();
+	}
+}
+
+int CUnit::calculate_modified_variable(const int index, const VariableAttribute variable_type) const
 {
 	int value = 0;
 
@@ -6230,11 +6492,6 @@ int CUnit::GetModifiedVariable(const int index, const VariableAttribute variable
 	return value;
 }
 
-int CUnit::GetModifiedVariable(const int index) const
-{
-	return this->GetModifiedVariable(index, VariableAttribute::Value);
-}
-
 int CUnit::get_best_attack_range() const
 {
 	return std::max(this->GetModifiedVariable(ATTACKRANGE_INDEX), this->best_contained_unit_attack_range);
@@ -7713,6 +7970,8 @@ void LetUnitDie(CUnit &unit, bool suicide)
 		unit.CurrentSightRange = 0;
 	}
 
+	unit.invalidate_derived_stats();
+
 	// If we have a corpse, or a death animation, we are put back on the map
 	// This enables us to be tracked.  Possibly for spells (eg raise dead)
 	if (type->get_corpse_type() != nullptr || (unit.get_animation_set() && unit.get_animation_set()->Death)) {
@@ -66,6 +66,7 @@ namespace wyrmgus {
 	class map_template;
 	class on_top_build_restriction;
 	class player_color;
+	class render_command_buffer;
 	class renderer;
 	class site;
 	class spell;
@@ -185,7 +186,7 @@ public:
 	const civilization_base *get_civilization_base() const;
 
 	/// Draw a single unit
-	void Draw(const CViewport &vp, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	void Draw(const CViewport &vp, render_command_buffer &render_commands) const;
 	/// Place a unit on map
 	//Wyrmgus start
 //	void Place(const Vec2i &pos);
@@ -601,6 +602,10 @@ public:
 	void set_variable_value(const int var_index, const int value)
 	{
 		this->Variable[var_index].Value = value;
+
+		if (CUnit::is_derived_stat_dependency(var_index)) {
+			this->invalidate_derived_stats();
+		}
 	}
 
 	void change_variable_value(const int var_index, const int change)
@@ -616,6 +621,10 @@ public:
 	void set_variable_max(const int var_index, const int max)
 	{
 		this->Variable[var_index].Max = max;
+
+		if (CUnit::is_derived_stat_dependency(var_index)) {
+			this->invalidate_derived_stats();
+		}
 	}
 
 	char get_variable_increase(const int var_index) const
@@ -626,6 +635,17 @@ public:
 	int GetModifiedVariable(const int index, const VariableAttribute variable_type) const;
 	int GetModifiedVariable(const int index) const;
 
+private:
+	int calculate_modified_variable(const int index, const VariableAttribute variable_type) const;
+	int get_cached_modified_variable(const int index, std::optional<int> &cached_value) const;
+
+public:
+	//whether changes to the variable affect the derived stats of the unit (or of the units inside it)
+	static bool is_derived_stat_dependency(const int var_index);
+
+	//clear the cached derived stats of the unit and of the units inside it, so that they are recalculated when next requested; must be called whenever something they depend on changes (e.g. the tiles under the unit, its container, its type or its variables)
+	void invalidate_derived_stats();
+
 	int get_best_attack_range() const;
 
 	int GetReactionRange() const;
@@ -1072,6 +1092,11 @@ public:
 	CPlayer    *Player;            /// Owner of this unit
 	const unit_stats *Stats = nullptr;       /// Current unit stats
 	int         CurrentSightRange; /// Unit's Current Sight Range
+private:
+	//cached values for the modified variables which are expensive to calculate
+	mutable std::optional<int> cached_modified_attack_range;
+	mutable std::optional<int> cached_modified_speed;
+public:
 
 	// Pathfinding stuff:
 	std::unique_ptr<PathFinderData> pathFinderData;
@@ -1245,8 +1270,8 @@ extern bool EnableTrainingQueue;               /// Config: training queues enabl
 extern bool RevealAttacker;                    /// Config: reveal attacker enabled
 extern int ResourcesMultiBuildersMultiplier;   /// Config: spend resources for building with multiple workers
 extern const CViewport *CurrentViewport; /// CurrentViewport
-extern void DrawUnitSelection(const CViewport &vp, const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands);
-extern void (*DrawSelection)(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawUnitSelection(const CViewport &vp, const CUnit &unit, render_command_buffer &render_commands);
+extern void (*DrawSelection)(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 
 extern unsigned int MaxSelectable;    /// How many units could be selected
 extern std::vector<CUnit *> Selected; /// currently selected units
@@ -1351,17 +1376,17 @@ extern void CleanUnits();
 // in unit_draw.c
 //--------------------
 /// Draw nothing around unit
-extern void DrawSelectionNone(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionNone(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 /// Draw circle around unit
-extern void DrawSelectionCircle(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionCircle(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 /// Draw circle filled with alpha around unit
-extern void DrawSelectionCircleWithTrans(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionCircleWithTrans(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 /// Draw rectangle around unit
-extern void DrawSelectionRectangle(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionRectangle(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 /// Draw rectangle filled with alpha around unit
-extern void DrawSelectionRectangleWithTrans(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionRectangleWithTrans(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 /// Draw corners around unit
-extern void DrawSelectionCorners(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawSelectionCorners(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands);
 
 /// Register CCL decorations features
 extern void DecorationCclRegister();
@@ -1373,17 +1398,17 @@ extern void LoadDecorations();
 extern void CleanDecorations();
 
 /// Draw unit's shadow
-extern void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int frame, const PixelPos &screenPos, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int frame, const PixelPos &screenPos, render_command_buffer &render_commands);
 //Wyrmgus start
 /// Draw unit's overlay
-extern void DrawPlayerColorOverlay(const unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, const int player, int frame, const PixelPos &screenPos, const wyrmgus::time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
-extern void DrawOverlay(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void DrawPlayerColorOverlay(const unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, const int player, int frame, const PixelPos &screenPos, const wyrmgus::time_of_day *time_of_day, render_command_buffer &render_commands);
+extern void DrawOverlay(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, render_command_buffer &render_commands);
 //Wyrmgus end
 /// Draw all units visible on map in viewport
 extern int FindAndSortUnits(const CViewport &vp, std::vector<CUnit *> &table);
 
 /// Show a unit's orders.
-extern void ShowOrder(const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands);
+extern void ShowOrder(const CUnit &unit, render_command_buffer &render_commands);
 
 // in groups.c
 
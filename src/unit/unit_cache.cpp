@@ -76,6 +76,8 @@ void CMap::Insert(CUnit &unit)
 		} while (--j && unit.tilePos.x + (j - w) < unit.MapLayer->get_width());
 		index += unit.MapLayer->get_width();
 	} while (--i && unit.tilePos.y + (i - h) < unit.MapLayer->get_height());
+
+	unit.MapLayer->get_unit_cell_grid().insert(&unit, QRect(unit.tilePos, unit.Type->get_tile_size()));
 }
 
 /**
@@ -100,4 +102,6 @@ void CMap::Remove(CUnit &unit)
 		} while (--j && unit.tilePos.x + (j - w) < unit.MapLayer->get_width());
 		index += unit.MapLayer->get_width();
 	} while (--i && unit.tilePos.y + (i - h) < unit.MapLayer->get_height());
+
+	unit.MapLayer->get_unit_cell_grid().remove(&unit, QRect(unit.tilePos, unit.Type->get_tile_size()));
 }
@@ -61,6 +61,8 @@
 #include "util/assert_util.h"
 #include "util/size_util.h"
 #include "video/font.h"
+#include "video/graphic_loader.h"
+#include "video/render_command_buffer.h"
 #include "video/renderer.h"
 #include "video/video.h"
 
@@ -107,7 +109,7 @@ unsigned long ShowNameTime;                  /// Show unit's name for some time
 **  @param x1,y1    Coordinates of the top left corner.
 **  @param x2,y2    Coordinates of the bottom right corner.
 */
-void (*DrawSelection)(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands) = DrawSelectionNone;
+void (*DrawSelection)(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands) = DrawSelectionNone;
 
 // FIXME: clean split screen support
 // FIXME: integrate this with global versions of these functions in map.c
@@ -121,7 +123,7 @@ const CViewport *CurrentViewport;  /// FIXME: quick hack for split screen
 **
 **  @param unit  Pointer to unit.
 */
-void DrawUnitSelection(const CViewport &vp, const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawUnitSelection(const CViewport &vp, const CUnit &unit, render_command_buffer &render_commands)
 {
 	const QPoint unit_screen_center_pos = vp.scaled_map_to_screen_pixel_pos(unit.get_scaled_map_pixel_pos_center());
 	const QRect box_rect = unit.Type->get_scaled_box_rect(unit_screen_center_pos);
@@ -192,7 +194,7 @@ void DrawUnitSelection(const CViewport &vp, const CUnit &unit, std::vector<std::
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionNone(IntColor, IntColor, int, int, int, int, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionNone(IntColor, IntColor, int, int, int, int, render_command_buffer &render_commands)
 {
 	Q_UNUSED(render_commands)
 }
@@ -204,7 +206,7 @@ void DrawSelectionNone(IntColor, IntColor, int, int, int, int, std::vector<std::
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionCircle(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionCircle(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	Q_UNUSED(secondary_color);
 
@@ -220,7 +222,7 @@ void DrawSelectionCircle(IntColor color, IntColor secondary_color, int x1, int y
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionCircleWithTrans(IntColor int_color, IntColor secondary_int_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionCircleWithTrans(IntColor int_color, IntColor secondary_int_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	Q_UNUSED(secondary_int_color);
 
@@ -239,7 +241,7 @@ void DrawSelectionCircleWithTrans(IntColor int_color, IntColor secondary_int_col
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionRectangle(const IntColor int_color, const IntColor secondary_int_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionRectangle(const IntColor int_color, const IntColor secondary_int_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	const QColor color = Video.GetRGBA(int_color);
 	const QColor secondary_color = Video.GetRGBA(secondary_int_color);
@@ -286,7 +288,7 @@ void DrawSelectionRectangle(const IntColor int_color, const IntColor secondary_i
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionRectangleWithTrans(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionRectangleWithTrans(IntColor color, IntColor secondary_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	Q_UNUSED(secondary_color);
 
@@ -302,7 +304,7 @@ void DrawSelectionRectangleWithTrans(IntColor color, IntColor secondary_color, i
 **  @param x1,y1  Coordinates of the top left corner.
 **  @param x2,y2  Coordinates of the bottom right corner.
 */
-void DrawSelectionCorners(const IntColor int_color, const IntColor secondary_int_color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawSelectionCorners(const IntColor int_color, const IntColor secondary_int_color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	static constexpr int base_corner_pixels = 6;
 
@@ -448,7 +450,7 @@ void CleanDecorations()
 **  @param unit    Unit pointer
 **  @todo fix color configuration.
 */
-void CDecoVarBar::Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CDecoVarBar::Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const
 {
 	assert_throw(var.Max > 0);
 
@@ -509,7 +511,7 @@ void CDecoVarBar::Draw(int x, int y, const unit_type &type, const unit_variable
 **  @param unit    Unit pointer
 **  @todo fix font/color configuration.
 */
-void CDecoVarText::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CDecoVarText::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, render_command_buffer &render_commands) const
 {
 	if (this->IsCenteredInX) {
 		x -= 2; // wyrmgus::defines::get()->get_game_font()->Width(buf) / 2, with buf = str(Value)
@@ -528,7 +530,7 @@ void CDecoVarText::Draw(int x, int y, const unit_type &/*type*/, const unit_vari
 **  @param unit    Unit pointer
 **  @todo fix sprite configuration.
 */
-void CDecoVarSpriteBar::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CDecoVarSpriteBar::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, render_command_buffer &render_commands) const
 {
 	assert_throw(var.Max > 0);
 	assert_throw(this->NSprite != -1);
@@ -565,7 +567,7 @@ void CDecoVarSpriteBar::Draw(int x, int y, const unit_type &/*type*/, const unit
 **
 **  @todo fix sprite configuration configuration.
 */
-void CDecoVarStaticSprite::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CDecoVarStaticSprite::Draw(int x, int y, const unit_type &/*type*/, const unit_variable &var, render_command_buffer &render_commands) const
 {
 	Decoration &decosprite = DecoSprite.SpriteArray[(int)this->NSprite];
 	CGraphic &sprite = *decosprite.Sprite;
@@ -593,7 +595,7 @@ void CDecoVarStaticSprite::Draw(int x, int y, const unit_type &/*type*/, const u
 **  @param type       Type of the unit.
 **  @param screenPos  Screen position of the unit.
 */
-static void DrawDecoration(const CUnit &unit, const wyrmgus::unit_type &type, const PixelPos &screenPos, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawDecoration(const CUnit &unit, const wyrmgus::unit_type &type, const PixelPos &screenPos, render_command_buffer &render_commands)
 {
 	int x = screenPos.x;
 	int y = screenPos.y;
@@ -688,7 +690,7 @@ static void DrawDecoration(const CUnit &unit, const wyrmgus::unit_type &type, co
 **
 **  @todo FIXME: combine new shadow code with old shadow code.
 */
-void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int frame, const PixelPos &screenPos, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int frame, const PixelPos &screenPos, render_command_buffer &render_commands)
 {
 	// Draw normal shadow sprite if available
 	//Wyrmgus start
@@ -697,6 +699,9 @@ void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite,
 	//Wyrmgus end
 		return;
 	}
+
+	graphic_loader::get()->ensure_loaded(*sprite);
+
 	PixelPos pos = screenPos;
 	pos -= PixelPos((sprite->get_frame_size() - type.get_tile_size() * defines::get()->get_scaled_tile_size()) / 2);
 	pos.x += ((type.get_offset().x() + type.ShadowOffsetX) * preferences::get()->get_scale_factor()).to_int();
@@ -723,12 +728,14 @@ void DrawShadow(const unit_type &type, const std::shared_ptr<CGraphic> &sprite,
 }
 
 //Wyrmgus start
-void DrawPlayerColorOverlay(const wyrmgus::unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, const int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawPlayerColorOverlay(const wyrmgus::unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, const int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	if (!sprite) {
 		return;
 	}
 
+	graphic_loader::get()->ensure_loaded(*sprite);
+
 	const player_color *player_color = CPlayer::Players[player]->get_player_color();
 
 	PixelPos pos = screenPos;
@@ -763,11 +770,14 @@ void DrawPlayerColorOverlay(const wyrmgus::unit_type &type, const std::shared_pt
 	sprite->render_frame(frame, pos, color_modification, false, flip, opacity, 100, render_commands);
 }
 
-void DrawOverlay(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawOverlay(const unit_type &type, const std::shared_ptr<CGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	if (!sprite) {
 		return;
 	}
+
+	graphic_loader::get()->ensure_loaded(*sprite);
+
 	PixelPos pos = screenPos;
 	// FIXME: move this calculation to high level.
 	pos -= PixelPos((sprite->get_frame_size() - type.get_tile_size() * wyrmgus::defines::get()->get_scaled_tile_size()) / 2);
@@ -810,7 +820,7 @@ void DrawOverlay(const unit_type &type, const std::shared_ptr<CGraphic> &sprite,
 **
 **  @param unit  Pointer to the unit.
 */
-void ShowOrder(const CUnit &unit, std::vector<std::function<void(renderer *)>> &render_commands)
+void ShowOrder(const CUnit &unit, render_command_buffer &render_commands)
 {
 	if (unit.Destroyed || unit.Removed) {
 		return;
@@ -861,7 +871,7 @@ void ShowOrder(const CUnit &unit, std::vector<std::function<void(renderer *)>> &
 **
 **  @todo FIXME: The different styles should become a function call.
 */
-static void DrawInformations(const CUnit &unit, const unit_type &type, const PixelPos &screenPos, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawInformations(const CUnit &unit, const unit_type &type, const PixelPos &screenPos, render_command_buffer &render_commands)
 {
 	// For debug draw sight, react and attack range!
 	if (IsOnlySelected(unit)) {
@@ -942,7 +952,7 @@ static void DrawInformations(const CUnit &unit, const unit_type &type, const Pix
 **  @param frame   Frame number to draw.
 **  @param screenPos  screen (top left) position of the unit.
 */
-static void DrawConstructionShadow(const CUnit &unit, const unit_type &type, const construction_frame *cframe, int frame, const PixelPos &screenPos, std::vector<std::function<void(renderer *)>> &render_commands)
+static void DrawConstructionShadow(const CUnit &unit, const unit_type &type, const construction_frame *cframe, int frame, const PixelPos &screenPos, render_command_buffer &render_commands)
 {
 	PixelPos pos = screenPos;
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
@@ -980,7 +990,7 @@ static void DrawConstructionShadow(const CUnit &unit, const unit_type &type, con
 **  @param screenPos  screen (top left) position of the unit.
 */
 static void DrawConstruction(const int player, const construction_frame *cframe,
-							 const CUnit &unit, const unit_type &type, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+							 const CUnit &unit, const unit_type &type, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	PixelPos pos = screenPos;
 	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
@@ -1031,7 +1041,7 @@ static void DrawConstruction(const int player, const construction_frame *cframe,
 /**
 **  Draw unit on map.
 */
-void CUnit::Draw(const CViewport &vp, std::vector<std::function<void(renderer *)>> &render_commands) const
+void CUnit::Draw(const CViewport &vp, render_command_buffer &render_commands) const
 {
 	int frame;
 	int state;
@@ -1097,6 +1107,8 @@ void CUnit::Draw(const CViewport &vp, std::vector<std::function<void(renderer *)
 		return;
 	}
 
+	EnsureUnitTypeSpriteLoaded(*type);
+
 	//Wyrmgus start
 	//
 	// Show that the unit is selected
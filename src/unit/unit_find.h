@@ -331,31 +331,50 @@ inline void SelectFixed(const Vec2i &ltPos, const Vec2i &rbPos, std::vector<CUni
 		radius_squared = radius * radius;
 	}
 
-	for (Vec2i posIt = ltPos; posIt.y != rbPos.y + 1; ++posIt.y) {
-		for (posIt.x = ltPos.x; posIt.x != rbPos.x + 1; ++posIt.x) {
-			if constexpr (circle) {
-				const decimillesimal_int rel_x = posIt.x - middle_x;
-				const decimillesimal_int rel_y = posIt.y - middle_y;
-				const decimillesimal_int my = radius_squared - rel_x * rel_x;
-				if ((rel_y * rel_y) > my) {
-					continue;
+	//the units are found through the coarse cell grid of the map layer, which visits each unit once, so that only the tiles of units near the area need to be checked
+	//the found units are then sorted in the order in which a scan of the area's tiles would find them, i.e. by the first tile of theirs in the area (in row order), and then by their order in that tile's unit cache
+	const QRect rect(ltPos, rbPos);
+
+	std::vector<std::pair<uint64_t, CUnit *>> found_units;
+
+	CMap::get()->MapLayers[z]->get_unit_cell_grid().for_each_in_rect(rect, [&](CUnit *unit, const QRect &intersection) {
+		Vec2i first_pos(-1, -1);
+
+		if constexpr (circle) {
+			for (int y = intersection.top(); y <= intersection.bottom() && first_pos.x == -1; ++y) {
+				for (int x = intersection.left(); x <= intersection.right(); ++x) {
+					const decimillesimal_int rel_x = x - middle_x;
+					const decimillesimal_int rel_y = y - middle_y;
+					const decimillesimal_int my = radius_squared - rel_x * rel_x;
+					if (!((rel_y * rel_y) > my)) {
+						first_pos = Vec2i(x, y);
+						break;
+					}
 				}
 			}
 
-			const CUnitCache &cache = CMap::get()->get_tile_unit_cache(posIt, z);
-			const std::vector<CUnit *> &cache_units = cache.get_units();
-
-			for (CUnit *unit : cache_units) {
-				if (unit->CacheLock == 0 && pred(unit)) {
-					unit->CacheLock = 1;
-					units.push_back(unit);
-				}
+			if (first_pos.x == -1) {
+				return;
 			}
+		} else {
+			first_pos = intersection.topLeft();
 		}
-	}
 
-	for (size_t i = 0; i != units.size(); ++i) {
-		units[i]->CacheLock = 0;
+		const std::vector<CUnit *> &tile_units = CMap::get()->get_tile_unit_cache(first_pos, z).get_units();
+		const uint64_t cache_index = std::find(tile_units.begin(), tile_units.end(), unit) - tile_units.begin();
+		const uint64_t tile_index = static_cast<uint64_t>((first_pos.y - rect.top()) * rect.width() + (first_pos.x - rect.left()));
+
+		found_units.emplace_back((tile_index << 32) | cache_index, unit);
+	});
+
+	std::sort(found_units.begin(), found_units.end(), [](const std::pair<uint64_t, CUnit *> &lhs, const std::pair<uint64_t, CUnit *> &rhs) {
+		return lhs.first < rhs.first;
+	});
+
+	for (const auto &[order, unit] : found_units) {
+		if (pred(unit)) {
+			units.push_back(unit);
+		}
 	}
 }
 
@@ -35,7 +35,6 @@
 #include "unit/unit.h"
 #include "util/assert_util.h"
 #include "util/exception_util.h"
-#include "util/list_util.h"
 
 namespace wyrmgus {
 
@@ -56,6 +55,7 @@ void unit_manager::init()
 	this->units.clear();
 	this->released_units.clear();
 	this->unit_slots.clear();
+	this->unit_slab_slots.clear();
 }
 
 void unit_manager::clean_units()
@@ -109,7 +109,8 @@ CUnit *unit_manager::AllocUnit()
 {
 	// Can use released unit?
 	if (!this->released_units.empty() && this->released_units.front()->ReleaseCycle < GameCycle) {
-		CUnit *unit = list::take_front(this->released_units);
+		CUnit *unit = this->released_units.front();
+		this->released_units.pop_front();
 
 		if (!unit->Destroyed) {
 			throw std::runtime_error("Fetched a non-destroyed unit from the released units list.");
@@ -125,13 +126,29 @@ CUnit *unit_manager::AllocUnit()
 		unit->UnitManagerData.unitSlot = -1;
 		return unit;
 	} else {
-		auto unit = std::make_unique<CUnit>();
-		unit->UnitManagerData.slot = this->unit_slots.size();
-		CUnit *unit_ptr = unit.get();
-		this->unit_slots.push_back(std::move(unit));
+		return this->create_slot_unit();
+	}
+}
+
+CUnit *unit_manager::create_slot_unit()
+{
+	const int slot = static_cast<int>(this->GetUsedSlotCount());
+	CUnit *unit = nullptr;
 
-		return unit_ptr;
+	if (slot == 0) {
+		//the allocation method can only change while there are no units
+		this->slab_allocation_active = this->slab_allocation_enabled;
+	}
+
+	if (this->slab_allocation_active) {
+		unit = this->unit_slab_slots.emplace_back();
+	} else {
+		this->unit_slots.push_back(std::make_unique<CUnit>());
+		unit = this->unit_slots.back().get();
 	}
+
+	unit->UnitManagerData.slot = slot;
+	return unit;
 }
 
 /**
@@ -172,11 +189,19 @@ void unit_manager::ReleaseUnit(CUnit *unit)
 
 CUnit &unit_manager::GetSlotUnit(const int index) const
 {
+	if (this->slab_allocation_active) {
+		return this->unit_slab_slots.at(index);
+	}
+
 	return *this->unit_slots.at(index);
 }
 
 unsigned int unit_manager::GetUsedSlotCount() const
 {
+	if (this->slab_allocation_active) {
+		return static_cast<unsigned int>(this->unit_slab_slots.size());
+	}
+
 	return static_cast<unsigned int>(this->unit_slots.size());
 }
 
@@ -204,7 +229,7 @@ void unit_manager::Add(CUnit *unit)
 */
 void unit_manager::Save(CFile &file) const
 {
-	file.printf("SlotUsage(%lu, {", (long unsigned int)this->unit_slots.size());
+	file.printf("SlotUsage(%lu, {", (long unsigned int)this->GetUsedSlotCount());
 
 	for (const CUnit *unit : this->released_units) {
 		file.printf("{Slot = %d, FreeCycle = %u}, ", UnitNumber(*unit), unit->ReleaseCycle);
@@ -242,9 +267,7 @@ void unit_manager::Load(lua_State *l)
 		LuaError(l, "incorrect argument");
 	}
 	for (unsigned int i = 0; i < unitCount; i++) {
-		auto unit = std::make_unique<CUnit>();
-		unit->UnitManagerData.slot = i;
-		this->unit_slots.push_back(std::move(unit));
+		this->create_slot_unit();
 	}
 
 	const unsigned int args = lua_rawlen(l, 2);
@@ -265,19 +288,22 @@ void unit_manager::Load(lua_State *l)
 			}
 		}
 		assert_throw(unit_index != -1 && cycle != static_cast<unsigned long>(-1));
-		this->unit_slots[unit_index]->Destroyed = 1;
-		this->ReleaseUnit(this->unit_slots[unit_index].get());
-		this->unit_slots[unit_index]->ReleaseCycle = cycle;
+		CUnit &unit = this->GetSlotUnit(unit_index);
+		unit.Destroyed = 1;
+		this->ReleaseUnit(&unit);
+		unit.ReleaseCycle = cycle;
 		lua_pop(l, 1);
 	}
 
 	//initialize the base reference for all non-destroyed units
-	for (const std::unique_ptr<CUnit> &unit : this->unit_slots) {
-		if (unit->Destroyed) {
+	for (unsigned int i = 0; i < this->GetUsedSlotCount(); ++i) {
+		CUnit &unit = this->GetSlotUnit(i);
+
+		if (unit.Destroyed) {
 			continue;
 		}
 
-		unit->initialize_base_reference();
+		unit.initialize_base_reference();
 	}
 }
 
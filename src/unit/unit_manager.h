@@ -27,6 +27,7 @@
 #pragma once
 
 #include "util/singleton.h"
+#include "util/slab_storage.h"
 
 class CUnit;
 class CFile;
@@ -44,6 +45,17 @@ public:
 
 	void init();
 
+	bool is_slab_allocation_enabled() const
+	{
+		return this->slab_allocation_enabled;
+	}
+
+	//set whether units are allocated in contiguous slabs, or each on its own on the heap; this takes effect once there are no units allocated, and exists to compare the two in cycle time measurements
+	void set_slab_allocation_enabled(const bool enabled)
+	{
+		this->slab_allocation_enabled = enabled;
+	}
+
 	void clean_units();
 
 	CUnit *AllocUnit();
@@ -70,13 +82,21 @@ public:
 	void remove_unit_seen_under_fog(CUnit *unit);
 
 private:
+	//create a unit in a new slot
+	CUnit *create_slot_unit();
+
 	//units currently in use
 	std::vector<CUnit *> units;
 
 	//all units, including released ones; the unit's index here is its slot
+	//units are stored in contiguous slabs in slot order, so that iterating over them doesn't touch scattered memory, unless slab allocation is disabled, in which case each unit is allocated on its own
+	slab_storage<CUnit> unit_slab_slots;
 	std::vector<std::unique_ptr<CUnit>> unit_slots;
+	bool slab_allocation_enabled = true;
+	bool slab_allocation_active = true; //whether the current units are in slabs
 
-	std::list<CUnit *> released_units;
+	//released units, in the order in which they can be reused
+	std::deque<CUnit *> released_units;
 	CUnit *lastCreated = nullptr;
 
 	//units seen under fog, which we need to keep references to in order to prevent them from being released
@@ -46,6 +46,7 @@
 #include "luacallback.h"
 #include "map/map.h"
 #include "map/map_info.h"
+#include "map/map_layer.h"
 #include "map/terrain_type.h"
 #include "map/tile.h"
 #include "map/tile_flag.h"
@@ -74,6 +75,7 @@
 #include "unit/unit.h"
 #include "unit/unit_class.h"
 #include "unit/unit_domain.h"
+#include "unit/unit_manager.h"
 #include "unit/unit_type_variation.h"
 #include "unit/variation_tag.h"
 #include "upgrade/upgrade.h"
@@ -88,6 +90,7 @@
 #include "util/util.h"
 #include "util/vector_util.h"
 #include "util/vector_random_util.h"
+#include "video/graphic_loader.h"
 #include "video/video.h"
 
 /**
@@ -2903,13 +2906,15 @@ void SaveUnitTypes(CFile &file)
 **  @todo  Do screen position caculation in high level.
 **         Better way to handle in x mirrored sprites.
 */
-void DrawUnitType(const unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawUnitType(const unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite, int player, int frame, const PixelPos &screenPos, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	//Wyrmgus start
 	if (sprite == nullptr) {
 		return;
 	}
 	//Wyrmgus end
+
+	graphic_loader::get()->ensure_loaded(*sprite);
 	
 	const player_color *player_color = CPlayer::Players[player]->get_player_color();
 
@@ -2998,15 +3003,14 @@ void InitUnitType(wyrmgus::unit_type &type)
 //Wyrmgus end
 
 /**
-**  Loads the Sprite for a unit type
+**  Creates the sprites for a unit type, without loading them
 **
-**  @param type  type of unit to load
+**  @param type  type of unit for which to create the sprites
 */
-void LoadUnitTypeSprite(unit_type &type)
+static void CreateUnitTypeSprites(unit_type &type)
 {
 	if (!type.ShadowFile.empty()) {
 		type.ShadowSprite = CGraphic::New(type.ShadowFile, type.ShadowWidth, type.ShadowHeight);
-		type.ShadowSprite->Load(preferences::get()->get_scale_factor());
 	}
 
 	if (type.BoolFlag[HARVESTER_INDEX].value) {
@@ -3015,29 +3019,24 @@ void LoadUnitTypeSprite(unit_type &type)
 
 			if (!res_info->get_image_file().empty()) {
 				res_info->SpriteWhenEmpty = CPlayerColorGraphic::New(res_info->get_image_file().string(), type.get_frame_size(), type.get_conversible_player_color());
-				res_info->SpriteWhenEmpty->Load(preferences::get()->get_scale_factor());
 			}
 
 			if (!res_info->get_loaded_image_file().empty()) {
 				res_info->SpriteWhenLoaded = CPlayerColorGraphic::New(res_info->get_loaded_image_file().string(), type.get_frame_size(), type.get_conversible_player_color());
-				res_info->SpriteWhenLoaded->Load(preferences::get()->get_scale_factor());
 			}
 		}
 	}
 
 	if (!type.get_image_file().empty()) {
 		type.Sprite = CPlayerColorGraphic::New(type.get_image_file().string(), type.get_frame_size(), type.get_conversible_player_color());
-		type.Sprite->Load(preferences::get()->get_scale_factor());
 	}
 
 	if (!type.LightFile.empty()) {
 		type.LightSprite = CGraphic::New(type.LightFile, type.get_frame_size());
-		type.LightSprite->Load(preferences::get()->get_scale_factor());
 	}
 	for (int i = 0; i < MaxImageLayers; ++i) {
 		if (!type.LayerFiles[i].empty()) {
 			type.LayerSprites[i] = CPlayerColorGraphic::New(type.LayerFiles[i], type.get_frame_size(), type.get_conversible_player_color());
-			type.LayerSprites[i]->Load(preferences::get()->get_scale_factor());
 		}
 	}
 
@@ -3048,31 +3047,25 @@ void LoadUnitTypeSprite(unit_type &type)
 		}
 		if (!variation->get_image_file().empty()) {
 			variation->Sprite = CPlayerColorGraphic::New(variation->get_image_file().string(), frame_size, type.get_conversible_player_color());
-			variation->Sprite->Load(preferences::get()->get_scale_factor());
 		}
 		if (!variation->ShadowFile.empty()) {
 			variation->ShadowSprite = CGraphic::New(variation->ShadowFile, type.ShadowWidth, type.ShadowHeight);
-			variation->ShadowSprite->Load(preferences::get()->get_scale_factor());
 		}
 		if (!variation->LightFile.empty()) {
 			variation->LightSprite = CGraphic::New(variation->LightFile, frame_size);
-			variation->LightSprite->Load(preferences::get()->get_scale_factor());
 		}
 		for (int j = 0; j < MaxImageLayers; ++j) {
 			if (!variation->LayerFiles[j].empty()) {
 				variation->LayerSprites[j] = CPlayerColorGraphic::New(variation->LayerFiles[j], frame_size, type.get_conversible_player_color());
-				variation->LayerSprites[j]->Load(preferences::get()->get_scale_factor());
 			}
 		}
 	
 		for (int j = 0; j < MaxCosts; ++j) {
 			if (!variation->FileWhenLoaded[j].empty()) {
 				variation->SpriteWhenLoaded[j] = CPlayerColorGraphic::New(variation->FileWhenLoaded[j], frame_size, type.get_conversible_player_color());
-				variation->SpriteWhenLoaded[j]->Load(preferences::get()->get_scale_factor());
 			}
 			if (!variation->FileWhenEmpty[j].empty()) {
 				variation->SpriteWhenEmpty[j] = CPlayerColorGraphic::New(variation->FileWhenEmpty[j], frame_size, type.get_conversible_player_color());
-				variation->SpriteWhenEmpty[j]->Load(preferences::get()->get_scale_factor());
 			}
 		}
 	}
@@ -3081,12 +3074,147 @@ void LoadUnitTypeSprite(unit_type &type)
 		for (const auto &layer_variation : type.LayerVariations[i]) {
 			if (!layer_variation->get_image_file().empty()) {
 				layer_variation->Sprite = CPlayerColorGraphic::New(layer_variation->get_image_file().string(), type.get_frame_size(), type.get_conversible_player_color());
-				layer_variation->Sprite->Load(preferences::get()->get_scale_factor());
 			}
 		}
 	}
 }
 
+/**
+**  Calls a function for each of the sprites of a unit type
+**
+**  @param type      type of unit whose sprites to process
+**  @param function  function to call for each sprite
+*/
+template <typename function_type>
+static void ForEachUnitTypeSprite(const unit_type &type, const function_type &function)
+{
+	if (type.ShadowSprite != nullptr) {
+		function(type.ShadowSprite);
+	}
+
+	for (const auto &kv_pair : type.get_resource_infos()) {
+		const resource_info *res_info = kv_pair.second.get();
+
+		if (res_info->SpriteWhenEmpty != nullptr) {
+			function(res_info->SpriteWhenEmpty);
+		}
+
+		if (res_info->SpriteWhenLoaded != nullptr) {
+			function(res_info->SpriteWhenLoaded);
+		}
+	}
+
+	if (type.Sprite != nullptr) {
+		function(type.Sprite);
+	}
+
+	if (type.LightSprite != nullptr) {
+		function(type.LightSprite);
+	}
+
+	for (const std::shared_ptr<CPlayerColorGraphic> &layer_sprite : type.LayerSprites) {
+		if (layer_sprite != nullptr) {
+			function(layer_sprite);
+		}
+	}
+
+	for (const auto &variation : type.get_variations()) {
+		if (variation->Sprite != nullptr) {
+			function(variation->Sprite);
+		}
+		if (variation->ShadowSprite != nullptr) {
+			function(variation->ShadowSprite);
+		}
+		if (variation->LightSprite != nullptr) {
+			function(variation->LightSprite);
+		}
+		for (const std::shared_ptr<CPlayerColorGraphic> &layer_sprite : variation->LayerSprites) {
+			if (layer_sprite != nullptr) {
+				function(layer_sprite);
+			}
+		}
+		for (int j = 0; j < MaxCosts; ++j) {
+			if (variation->SpriteWhenLoaded[j] != nullptr) {
+				function(variation->SpriteWhenLoaded[j]);
+			}
+			if (variation->SpriteWhenEmpty[j] != nullptr) {
+				function(variation->SpriteWhenEmpty[j]);
+			}
+		}
+	}
+
+	for (int i = 0; i < MaxImageLayers; ++i) {
+		for (const auto &layer_variation : type.LayerVariations[i]) {
+			if (layer_variation->Sprite != nullptr) {
+				function(layer_variation->Sprite);
+			}
+		}
+	}
+}
+
+/**
+**  Loads the Sprite for a unit type
+**
+**  @param type  type of unit to load
+*/
+void LoadUnitTypeSprite(unit_type &type)
+{
+	CreateUnitTypeSprites(type);
+
+	ForEachUnitTypeSprite(type, [](const std::shared_ptr<CGraphic> &graphic) {
+		graphic->Load(preferences::get()->get_scale_factor());
+	});
+}
+
+/**
+**  Ensures the Sprite for a unit type is loaded, if it may still be being streamed in
+**
+**  @param type  type of unit whose sprite is to be drawn
+*/
+void EnsureUnitTypeSpriteLoaded(const unit_type &type)
+{
+	if (!graphic_loader::get()->is_streaming()) {
+		return;
+	}
+
+	//load the sprites now if they have not been streamed in yet, or wait for them if they are being streamed in
+	ForEachUnitTypeSprite(type, [](const std::shared_ptr<CGraphic> &graphic) {
+		graphic_loader::get()->ensure_loaded(*graphic);
+	});
+}
+
+/**
+**  Get the types of the units in the area initially shown by the viewport, whose sprites are needed for the first frames
+**
+**  @return  the unit types
+*/
+static std::set<const unit_type *> GetStartingViewportUnitTypes()
+{
+	//margin in tiles around the starting viewport, for large units and for a bit of scrolling
+	static constexpr int viewport_margin = 4;
+
+	std::set<const unit_type *> unit_types;
+
+	const CPlayer *player = CPlayer::GetThisPlayer();
+	const QSize tile_size = defines::get()->get_scaled_tile_size();
+	const int half_width = Video.Width / tile_size.width() / 2 + viewport_margin;
+	const int half_height = Video.Height / tile_size.height() / 2 + viewport_margin;
+
+	for (const CUnit *unit : unit_manager::get()->get_units()) {
+		if (unit->Destroyed || unit->MapLayer == nullptr || unit->MapLayer->ID != player->StartMapLayer) {
+			continue;
+		}
+
+		if (std::abs(unit->tilePos.x - player->StartPos.x) > half_width || std::abs(unit->tilePos.y - player->StartPos.y) > half_height) {
+			continue;
+		}
+
+		unit_types.insert(unit->Type);
+	}
+
+	return unit_types;
+}
+
 /**
 ** Return the amount of unit-types.
 */
@@ -3106,17 +3234,9 @@ int GetUnitTypesCount()
 }
 
 /**
-** Load the graphics for the unit-types.
+** Load the icons of a unit type, and look up its missiles.
 */
-void LoadUnitTypes()
-{
-	for (unit_type *unit_type : unit_type::get_all()) {
-		ShowLoadProgress(_("Loading Unit Types... (%d%%)"), (unit_type->get_index() + 1) * 100 / unit_type::get_all().size());
-		LoadUnitType(unit_type);
-	}
-}
-
-void LoadUnitType(unit_type *unit_type)
+static void LoadUnitTypeData(unit_type *unit_type)
 {
 	for (const auto &variation : unit_type->get_variations()) {
 		if (!variation->Icon.Name.empty()) {
@@ -3133,6 +3253,52 @@ void LoadUnitType(unit_type *unit_type)
 	for (int i = 0; i < ANIMATIONS_DEATHTYPES + 2; ++i) {
 		unit_type->Impact[i].MapMissile();
 	}
+}
+
+/**
+** Load the graphics for the unit-types.
+**
+** The sprites of unit types in the starting viewport are loaded in parallel while the game waits, and the rest are streamed in after the game has begun.
+*/
+void LoadUnitTypes()
+{
+	//everything is needed at once in the editor
+	const bool stream_sprites = CPlayer::GetThisPlayer() != nullptr && !CEditor::get()->is_running();
+
+	std::set<const unit_type *> starting_viewport_unit_types;
+	if (stream_sprites) {
+		starting_viewport_unit_types = GetStartingViewportUnitTypes();
+	}
+
+	std::vector<std::shared_ptr<CGraphic>> graphics;
+	std::vector<std::shared_ptr<CGraphic>> streamed_graphics;
+
+	for (unit_type *unit_type : unit_type::get_all()) {
+		ShowLoadProgress(_("Loading Unit Types... (%d%%)"), (unit_type->get_index() + 1) * 100 / unit_type::get_all().size());
+		LoadUnitTypeData(unit_type);
+
+#ifndef DYNAMIC_LOAD
+		if (unit_type->Sprite == nullptr) {
+			CreateUnitTypeSprites(*unit_type);
+
+			std::vector<std::shared_ptr<CGraphic>> &unit_type_graphics = stream_sprites && !starting_viewport_unit_types.contains(unit_type) ? streamed_graphics : graphics;
+
+			ForEachUnitTypeSprite(*unit_type, [&unit_type_graphics](const std::shared_ptr<CGraphic> &graphic) {
+				unit_type_graphics.push_back(graphic);
+			});
+
+			IncItemsLoaded();
+		}
+#endif
+	}
+
+	graphic_loader::get()->load(graphics);
+	graphic_loader::get()->queue_for_streaming(streamed_graphics);
+}
+
+void LoadUnitType(unit_type *unit_type)
+{
+	LoadUnitTypeData(unit_type);
 
 #ifndef DYNAMIC_LOAD
 	// Load Sprite
@@ -74,6 +74,7 @@ namespace wyrmgus {
 	class icon;
 	class missile_type;
 	class player_color;
+	class render_command_buffer;
 	class renderer;
 	class resource;
 	class site;
@@ -439,7 +440,7 @@ public:
 	}
 
 	/// function to draw the decorations.
-	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const = 0;
+	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const = 0;
 
 	unsigned int Index = 0;	/// Index of the variable. @see DefineVariables
 
@@ -482,7 +483,7 @@ class CDecoVarBar final : public CDecoVar
 {
 public:
 	/// function to draw the decorations.
-	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const override;
 
 	bool IsVertical;            /// if true, vertical bar, else horizontal.
 	bool SEToNW;                /// (SouthEastToNorthWest), if false value 0 is on the left or up of the bar.
@@ -499,7 +500,7 @@ class CDecoVarText final : public CDecoVar
 {
 public:
 	/// function to draw the decorations.
-	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const override;
 
 	wyrmgus::font *Font = nullptr;  /// Font to use to display value.
 	// FIXME : Add Color, format
@@ -511,7 +512,7 @@ class CDecoVarSpriteBar final : public CDecoVar
 public:
 	CDecoVarSpriteBar() : NSprite(-1) {};
 	/// function to draw the decorations.
-	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const override;
 
 	char NSprite; /// Index of number. (@see DefineSprites and @see GetSpriteIndex)
 	// FIXME Sprite info. better way ?
@@ -521,7 +522,7 @@ public:
 class CDecoVarStaticSprite final : public CDecoVar
 {
 public:
-	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, std::vector<std::function<void(renderer *)>> &render_commands) const override;
+	virtual void Draw(int x, int y, const unit_type &type, const unit_variable &var, render_command_buffer &render_commands) const override;
 
 	// FIXME Sprite info. and Replace n with more appropriate var.
 	char NSprite = -1;  /// Index of sprite. (@see DefineSprites and @see GetSpriteIndex)
@@ -1513,13 +1514,14 @@ extern std::string GetUnitTypeStatsString(const std::string &unit_type_ident);
 extern void SaveUnitTypes(CFile &file);              /// Save the unit-type table
 /// Draw the sprite frame of unit-type
 extern void DrawUnitType(const wyrmgus::unit_type &type, const std::shared_ptr<CPlayerColorGraphic> &sprite,
-						 int player, int frame, const PixelPos &screenPos, const wyrmgus::time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
+						 int player, int frame, const PixelPos &screenPos, const wyrmgus::time_of_day *time_of_day, render_command_buffer &render_commands);
 
 extern void InitUnitTypes(int reset_player_stats);   /// Init unit-type table
 //Wyrmgus start
 extern void InitUnitType(wyrmgus::unit_type &type);			/// Init unit-type
 //Wyrmgus end
 extern void LoadUnitTypeSprite(wyrmgus::unit_type &unittype); /// Load the sprite for a unittype
+extern void EnsureUnitTypeSpriteLoaded(const wyrmgus::unit_type &unittype); /// Ensure the sprite for a unittype is loaded, if it may still be streamed in
 extern int GetUnitTypesCount();                     /// Get the amount of unit-types
 extern void LoadUnitTypes();                     /// Load the unit-type data
 extern void LoadUnitType(unit_type *unit_type);	/// Load a unittype
@@ -0,0 +1,118 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//a binary indexed tree over non-negative integer weights, used for weighted random selection with removal
+//the element selected for a given value in [0, total weight) is the same as the one which would be at that index if each element were repeated in a vector as many times as its weight
+class fenwick_tree final
+{
+public:
+	//replace the contents of the tree with the given weights, building it in linear time
+	void assign(const std::vector<int> &weights)
+	{
+		this->weights = weights;
+		this->tree.assign(weights.size() + 1, 0);
+		this->total_weight = 0;
+
+		for (size_t i = 0; i < weights.size(); ++i) {
+			assert_throw(weights[i] >= 0);
+
+			const size_t node = i + 1;
+			this->tree[node] += weights[i];
+			this->total_weight += weights[i];
+
+			const size_t parent = node + (node & (~node + 1));
+			if (parent < this->tree.size()) {
+				this->tree[parent] += this->tree[node];
+			}
+		}
+
+		this->highest_bit = this->weights.empty() ? 0 : std::bit_floor(this->weights.size());
+	}
+
+	size_t size() const
+	{
+		return this->weights.size();
+	}
+
+	int get_weight(const size_t index) const
+	{
+		return this->weights[index];
+	}
+
+	int get_total_weight() const
+	{
+		return this->total_weight;
+	}
+
+	//set the weight of an element to zero, so that it can no longer be selected
+	void remove(const size_t index)
+	{
+		const int weight = this->weights[index];
+		if (weight == 0) {
+			return;
+		}
+
+		this->weights[index] = 0;
+		this->total_weight -= weight;
+
+		for (size_t node = index + 1; node < this->tree.size(); node += node & (~node + 1)) {
+			this->tree[node] -= weight;
+		}
+	}
+
+	//get the index of the element covering a value in [0, total weight) of the cumulative weights
+	size_t find(int value) const
+	{
+		assert_throw(value >= 0 && value < this->total_weight);
+
+		size_t node = 0;
+
+		for (size_t step = this->highest_bit; step != 0; step >>= 1) {
+			const size_t next_node = node + step;
+
+			if (next_node < this->tree.size() && this->tree[next_node] <= value) {
+				node = next_node;
+				value -= this->tree[node];
+			}
+		}
+
+		//node is the amount of elements whose cumulative weight does not exceed the value, so it is the index of the element covering it
+		return node;
+	}
+
+private:
+	std::vector<int> weights;
+	std::vector<int> tree; //1-indexed, with each node holding the sum of the weights of the range it covers
+	size_t highest_bit = 0;
+	int total_weight = 0;
+};
+
+}
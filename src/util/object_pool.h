@@ -0,0 +1,131 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/slab_storage.h"
+
+namespace wyrmgus {
+
+//a pool of fixed-size slots in which objects of a polymorphic base type (or of types derived from it with no further members) are created, so that they don't need to be allocated on their own
+//the slots are kept in a slab storage, and slots of destroyed objects are reused for new ones; objects keep their address while they exist, and any objects still alive are destroyed with the pool
+template <typename base_type, size_t slab_size = 256>
+class object_pool final
+{
+public:
+	object_pool()
+	{
+	}
+
+	object_pool(const object_pool &other) = delete;
+	object_pool &operator =(const object_pool &other) = delete;
+
+	~object_pool()
+	{
+		this->clear();
+	}
+
+	size_t size() const
+	{
+		return this->count;
+	}
+
+	bool empty() const
+	{
+		return this->count == 0;
+	}
+
+	template <typename T, typename... arg_types>
+	T *create(arg_types &&...args)
+	{
+		static_assert(std::is_base_of_v<base_type, T>);
+		static_assert(sizeof(T) <= sizeof(slot) && alignof(T) <= alignof(slot), "The type is larger than the slots of the object pool.");
+
+		slot *free_slot = nullptr;
+
+		if (this->free_slots.empty()) {
+			free_slot = this->slots.emplace_back();
+		} else {
+			free_slot = this->free_slots.back();
+			this->free_slots.pop_back();
+		}
+
+		T *object = std::construct_at(reinterpret_cast<T *>(free_slot->data.data()), std::forward<arg_types>(args)...);
+		++this->count;
+		return object;
+	}
+
+	void destroy(base_type *object)
+	{
+		//the slot starts at the address of the most derived object, which may differ from that of the base
+		slot *object_slot = static_cast<slot *>(dynamic_cast<void *>(object));
+
+		std::destroy_at(object);
+		this->free_slots.push_back(object_slot);
+		--this->count;
+	}
+
+	//destroy all objects still alive in the pool, and free its slots
+	void clear()
+	{
+		if (this->count > 0) {
+			std::sort(this->free_slots.begin(), this->free_slots.end());
+
+			for (size_t i = 0; i < this->slots.size(); ++i) {
+				slot *live_slot = &this->slots[i];
+
+				if (std::binary_search(this->free_slots.begin(), this->free_slots.end(), live_slot)) {
+					continue;
+				}
+
+				//the types created in the pool add no members to the base type, so the base is at the start of the slot
+				std::destroy_at(std::launder(reinterpret_cast<base_type *>(live_slot->data.data())));
+			}
+		}
+
+		this->free_slots.clear();
+		this->slots.clear();
+		this->count = 0;
+	}
+
+private:
+	struct slot final
+	{
+		//the slot's memory is left uninitialized, since an object is constructed in it afterwards
+		slot()
+		{
+		}
+
+		alignas(base_type) std::array<std::byte, sizeof(base_type)> data;
+	};
+
+	slab_storage<slot, slab_size> slots;
+	std::vector<slot *> free_slots;
+	size_t count = 0;
+};
+
+}
@@ -0,0 +1,94 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#pragma once
+
+namespace wyrmgus {
+
+//a small deterministic random number generator, independent of the synced one, for work split across threads which must give the same results regardless of how the work is scheduled
+class random_stream final
+{
+public:
+	//combine a seed with a value identifying part of the work, e.g. a region index, to get the seed for that part
+	static constexpr uint64_t mix_seed(const uint64_t seed, const uint64_t value)
+	{
+		uint64_t result = seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+		result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+		result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+		return result ^ (result >> 31);
+	}
+
+	explicit random_stream(const uint64_t seed) : state(seed)
+	{
+	}
+
+	uint64_t next()
+	{
+		//splitmix64
+		this->state += 0x9E3779B97F4A7C15ull;
+		uint64_t result = this->state;
+		result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+		result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+		return result ^ (result >> 31);
+	}
+
+	//generate a number in the [0, max) range
+	int generate(const int max)
+	{
+		assert_throw(max > 0);
+
+		return static_cast<int>(this->next() % static_cast<uint64_t>(max));
+	}
+
+	template <typename T>
+	const T &get_random(const std::vector<T> &vector)
+	{
+		assert_throw(!vector.empty());
+
+		return vector[static_cast<size_t>(this->generate(static_cast<int>(vector.size())))];
+	}
+
+	//remove a random element from the vector and return it; the order of the remaining elements is not preserved
+	template <typename T>
+	T take_random(std::vector<T> &vector)
+	{
+		assert_throw(!vector.empty());
+
+		const size_t index = static_cast<size_t>(this->generate(static_cast<int>(vector.size())));
+		T element = std::move(vector[index]);
+		if (index != vector.size() - 1) {
+			vector[index] = std::move(vector.back());
+		}
+		vector.pop_back();
+
+		return element;
+	}
+
+private:
+	uint64_t state = 0;
+};
+
+}
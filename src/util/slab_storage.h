@@ -0,0 +1,115 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus {
+
+//stores objects contiguously in fixed-size slabs, in the order in which they were added; since slabs are never reallocated, objects keep their address until the storage is cleared
+template <typename T, size_t slab_size = 256>
+class slab_storage final
+{
+public:
+	slab_storage()
+	{
+	}
+
+	slab_storage(const slab_storage &other) = delete;
+	slab_storage &operator =(const slab_storage &other) = delete;
+
+	~slab_storage()
+	{
+		this->clear();
+	}
+
+	size_t size() const
+	{
+		return this->count;
+	}
+
+	bool empty() const
+	{
+		return this->count == 0;
+	}
+
+	T &operator [](const size_t index) const
+	{
+		return *this->slabs[index / slab_size]->get(index % slab_size);
+	}
+
+	T &at(const size_t index) const
+	{
+		if (index >= this->count) {
+			throw std::out_of_range("Index " + std::to_string(index) + " is out of range for a slab storage of size " + std::to_string(this->count) + ".");
+		}
+
+		return (*this)[index];
+	}
+
+	//construct a new object after the last one, allocating a new slab if the last one is full
+	template <typename... arg_types>
+	T *emplace_back(arg_types &&...args)
+	{
+		const size_t slab_index = this->count / slab_size;
+
+		if (slab_index == this->slabs.size()) {
+			//the slab's memory is left uninitialized, since objects are constructed in it one by one
+			this->slabs.push_back(std::make_unique_for_overwrite<slab>());
+		}
+
+		T *object = std::construct_at(this->slabs[slab_index]->get(this->count % slab_size), std::forward<arg_types>(args)...);
+		++this->count;
+		return object;
+	}
+
+	//destroy all objects, in reverse order, and free the slabs
+	void clear()
+	{
+		while (this->count > 0) {
+			--this->count;
+			std::destroy_at(&(*this)[this->count]);
+		}
+
+		this->slabs.clear();
+	}
+
+private:
+	struct slab final
+	{
+		T *get(const size_t index)
+		{
+			return std::launder(reinterpret_cast<T *>(this->data.data() + index * sizeof(T)));
+		}
+
+		alignas(T) std::array<std::byte, sizeof(T) * slab_size> data;
+	};
+
+	std::vector<std::unique_ptr<slab>> slabs;
+	size_t count = 0;
+};
+
+}
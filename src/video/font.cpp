@@ -46,7 +46,7 @@ namespace wyrmgus {
 
 //Wyrmgus start
 //void font::drawString(gcn::Graphics *graphics, const std::string &txt, int x, int y)
-void font::drawString(gcn::Graphics *graphics, const std::string &txt, int x, int y, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands)
+void font::drawString(gcn::Graphics *graphics, const std::string &txt, int x, int y, bool is_normal, render_command_buffer &render_commands)
 //Wyrmgus end
 {
 	const gcn::ClipRectangle &r = graphics->getCurrentClipArea();
@@ -80,7 +80,7 @@ void font::drawString(gcn::Graphics *graphics, const std::string &txt, int x, in
 **  @param y   Y screen position
 */
 static void VideoDrawChar(CGraphic &g,
-						  int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+						  int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	g.DrawSub(gx, gy, w, h, x, y, render_commands);
 }
@@ -268,7 +268,7 @@ font::~font()
 **  @param y   Y screen position
 */
 static void VideoDrawCharClip(CGraphic &g, int gx, int gy, int w, int h,
-							  int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+							  int x, int y, render_command_buffer &render_commands)
 {
 	int ox;
 	int oy;
@@ -281,7 +281,7 @@ static void VideoDrawCharClip(CGraphic &g, int gx, int gy, int w, int h,
 namespace wyrmgus {
 
 template<bool CLIP>
-unsigned int font::DrawChar(CGraphic &g, int utf8, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands) const
+unsigned int font::DrawChar(CGraphic &g, int utf8, int x, int y, render_command_buffer &render_commands) const
 {
 	int c = utf8 - 32;
 	assert_throw(c >= 0);
@@ -338,7 +338,7 @@ CGraphic *font::get_font_color_graphic(const wyrmgus::font_color *font_color)
 **  @return      The length of the printed text.
 */
 template <const bool CLIP>
-int CLabel::DoDrawText(int x, int y, const std::string &text, const font_color *fc, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DoDrawText(int x, int y, const std::string &text, const font_color *fc, render_command_buffer &render_commands) const
 {
 	int widths = 0;
 	int utf8;
@@ -458,12 +458,12 @@ void CLabel::SetNormalColor(const wyrmgus::font_color *nc)
 }
 
 /// Draw text/number unclipped
-int CLabel::Draw(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::Draw(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 {
 	return DoDrawText<false>(x, y, text, normal, render_commands);
 }
 
-int CLabel::Draw(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::Draw(int x, int y, int number, render_command_buffer &render_commands) const
 {
 	const std::string str = FormatNumber(number);
 	return DoDrawText<false>(x, y, str, normal, render_commands);
@@ -472,7 +472,7 @@ int CLabel::Draw(int x, int y, int number, std::vector<std::function<void(render
 /// Draw text/number clipped
 //Wyrmgus start
 //int CLabel::DrawClip(int x, int y, const std::string &text) const
-int CLabel::DrawClip(int x, int y, const std::string &text, const bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawClip(int x, int y, const std::string &text, const bool is_normal, render_command_buffer &render_commands) const
 //Wyrmgus end
 {
 	//Wyrmgus start
@@ -485,44 +485,44 @@ int CLabel::DrawClip(int x, int y, const std::string &text, const bool is_normal
 	//Wyrmgus end
 }
 
-int CLabel::DrawClip(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawClip(int x, int y, int number, render_command_buffer &render_commands) const
 {
 	std::string str = FormatNumber(number);
 	return DoDrawText<true>(x, y, str, normal, render_commands);
 }
 
 /// Draw reverse text/number unclipped
-int CLabel::DrawReverse(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawReverse(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 {
 	return DoDrawText<false>(x, y, text, reverse, render_commands);
 }
 
-int CLabel::DrawReverse(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawReverse(int x, int y, int number, render_command_buffer &render_commands) const
 {
 	std::string str = FormatNumber(number);
 	return DoDrawText<false>(x, y, str, reverse, render_commands);
 }
 
 /// Draw reverse text/number clipped
-int CLabel::DrawReverseClip(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawReverseClip(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 {
 	return DoDrawText<true>(x, y, text, reverse, render_commands);
 }
 
-int CLabel::DrawReverseClip(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawReverseClip(int x, int y, int number, render_command_buffer &render_commands) const
 {
 	std::string str = FormatNumber(number);
 	return DoDrawText<true>(x, y, str, reverse, render_commands);
 }
 
-int CLabel::DrawCentered(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawCentered(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 {
 	int dx = font->Width(text);
 	DoDrawText<false>(x - dx / 2, y, text, normal, render_commands);
 	return dx / 2;
 }
 
-int CLabel::DrawReverseCentered(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+int CLabel::DrawReverseCentered(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 {
 	int dx = font->Width(text);
 	DoDrawText<false>(x - dx / 2, y, text, reverse, render_commands);
@@ -683,6 +683,8 @@ void font::make_font_color_texture(const wyrmgus::font_color *fc)
 		newg->image.setColor(j, qRgba(color.red(), color.green(), color.blue(), j == 0 ? 0 : 255));
 	}
 
+	newg->loaded = true;
+
 	this->font_color_graphics[fc] = std::move(newg);
 }
 
@@ -36,6 +36,7 @@ class CGraphic;
 namespace wyrmgus {
 
 class font_color;
+class render_command_buffer;
 class renderer;
 
 class font final : public data_entry, public gcn::Font, public data_type<font>
@@ -74,13 +75,13 @@ public:
 	virtual int getWidth(const std::string &text) override { return Width(text); }
 	//Wyrmgus start
 //	virtual void drawString(gcn::Graphics *graphics, const std::string &text, int x, int y);
-	virtual void drawString(gcn::Graphics *graphics, const std::string &text, int x, int y, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands) override;
+	virtual void drawString(gcn::Graphics *graphics, const std::string &text, int x, int y, bool is_normal, render_command_buffer &render_commands) override;
 	//Wyrmgus end
 
 	CGraphic *get_font_color_graphic(const wyrmgus::font_color *font_color);
 
 	template<bool CLIP>
-	unsigned int DrawChar(CGraphic &g, int utf8, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	unsigned int DrawChar(CGraphic &g, int utf8, int x, int y, render_command_buffer &render_commands) const;
 
 	void free_textures(std::vector<std::function<void()>> &render_commands);
 	void unload_graphics();
@@ -121,31 +122,31 @@ public:
 	void SetNormalColor(const wyrmgus::font_color *nc);
 
 	/// Draw text/number unclipped
-	int Draw(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	int Draw(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int Draw(int x, int y, const std::string &text, render_command_buffer &render_commands) const;
+	int Draw(int x, int y, int number, render_command_buffer &render_commands) const;
 	//Wyrmgus start
 //	int DrawClip(int x, int y, const std::string &text) const;
-	int DrawClip(int x, int y, const std::string &text, bool is_normal, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DrawClip(int x, int y, const std::string &text, bool is_normal, render_command_buffer &render_commands) const;
 	//Wyrmgus end
 
-	int DrawClip(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const
+	int DrawClip(int x, int y, const std::string &text, render_command_buffer &render_commands) const
 	{
 		return this->DrawClip(x, y, text, true, render_commands);
 	}
 
-	int DrawClip(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DrawClip(int x, int y, int number, render_command_buffer &render_commands) const;
 	/// Draw reverse text/number unclipped
-	int DrawReverse(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	int DrawReverse(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DrawReverse(int x, int y, const std::string &text, render_command_buffer &render_commands) const;
+	int DrawReverse(int x, int y, int number, render_command_buffer &render_commands) const;
 	/// Draw reverse text/number clipped
-	int DrawReverseClip(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	int DrawReverseClip(int x, int y, int number, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DrawReverseClip(int x, int y, const std::string &text, render_command_buffer &render_commands) const;
+	int DrawReverseClip(int x, int y, int number, render_command_buffer &render_commands) const;
 
-	int DrawCentered(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const;
-	int DrawReverseCentered(int x, int y, const std::string &text, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DrawCentered(int x, int y, const std::string &text, render_command_buffer &render_commands) const;
+	int DrawReverseCentered(int x, int y, const std::string &text, render_command_buffer &render_commands) const;
 private:
 	template <const bool CLIP>
-	int DoDrawText(int x, int y, const std::string &text, const font_color *fc, std::vector<std::function<void(renderer *)>> &render_commands) const;
+	int DoDrawText(int x, int y, const std::string &text, const font_color *fc, render_command_buffer &render_commands) const;
 private:
 	const wyrmgus::font_color *normal;
 	const wyrmgus::font_color *reverse;
@@ -57,17 +57,24 @@
 #include "util/set_util.h"
 #include "util/thread_pool.h"
 #include "video/font.h"
+#include "video/graphic_loader.h"
+#include "video/image_cache.h"
+#include "video/pixel_kernels.h"
+#include "video/render_command_buffer.h"
 #include "video/render_context.h"
-#include "video/renderer.h"
 #include "video/video.h"
 
 #include "xbrz/include/xbrz.h"
 
+#include <QCryptographicHash>
+
 std::map<std::string, std::weak_ptr<CGraphic>> CGraphic::graphics_by_filepath;
 std::list<CGraphic *> CGraphic::graphics;
 
 void CGraphic::unload_all()
 {
+	graphic_loader::get()->stop_streaming();
+
 	CGraphic::free_all_textures();
 
 	std::unique_lock<std::shared_mutex> lock(CGraphic::mutex);
@@ -129,7 +136,7 @@ CGraphic::~CGraphic()
 **  @param x   X screen position
 **  @param y   Y screen position
 */
-void CGraphic::DrawClip(int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawClip(int x, int y, render_command_buffer &render_commands)
 {
 	int oldx = x;
 	int oldy = y;
@@ -149,22 +156,22 @@ void CGraphic::DrawClip(int x, int y, std::vector<std::function<void(renderer *)
 **  @param x   X screen position
 **  @param y   Y screen position
 */
-void CGraphic::DrawSub(const int gx, const int gy, const int w, const int h, const int x, const int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawSub(const int gx, const int gy, const int w, const int h, const int x, const int y, render_command_buffer &render_commands)
 {
 	this->render_rect(QRect(gx, gy, w, h), QPoint(x, y), color_modification(), false, 255, render_commands);
 }
 
-void CGraphic::DrawGrayscaleSub(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawGrayscaleSub(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	this->render_rect(QRect(gx, gy, w, h), QPoint(x, y), color_modification(), true, 255, render_commands);
 }
 
-void CPlayerColorGraphic::DrawPlayerColorSub(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorSub(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	this->render_rect(QRect(gx, gy, w, h), QPoint(x, y), color_modification, false, 255, render_commands);
 }
 
-void CGraphic::DrawSubClip(const int gx, const int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawSubClip(const int gx, const int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	int oldx = x;
 	int oldy = y;
@@ -172,7 +179,7 @@ void CGraphic::DrawSubClip(const int gx, const int gy, int w, int h, int x, int
 	DrawSub(gx + x - oldx, gy + y - oldy, w, h, x, y, render_commands);
 }
 
-void CGraphic::DrawGrayscaleSubClip(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawGrayscaleSubClip(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	int oldx = x;
 	int oldy = y;
@@ -180,7 +187,7 @@ void CGraphic::DrawGrayscaleSubClip(int gx, int gy, int w, int h, int x, int y,
 	DrawGrayscaleSub(gx + x - oldx, gy + y - oldy, w, h, x, y, render_commands);
 }
 
-void CPlayerColorGraphic::DrawPlayerColorSubClip(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorSubClip(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands)
 {
 	int oldx = x;
 	int oldy = y;
@@ -199,7 +206,7 @@ void CPlayerColorGraphic::DrawPlayerColorSubClip(const color_modification &color
 **  @param y      Y screen position
 **  @param alpha  Alpha
 */
-void CGraphic::DrawSubTrans(const int gx, const int gy, const int w, const int h, const int x, const int y, const unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawSubTrans(const int gx, const int gy, const int w, const int h, const int x, const int y, const unsigned char alpha, render_command_buffer &render_commands)
 {
 	this->render_rect(QRect(gx, gy, w, h), QPoint(x, y), color_modification(), false, alpha, render_commands);
 }
@@ -215,7 +222,7 @@ void CGraphic::DrawSubTrans(const int gx, const int gy, const int w, const int h
 **  @param y      Y screen position
 **  @param alpha  Alpha
 */
-void CGraphic::DrawSubClipTrans(const int gx, const int gy, int w, int h, int x, int y, const unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawSubClipTrans(const int gx, const int gy, int w, int h, int x, int y, const unsigned char alpha, render_command_buffer &render_commands)
 {
 	int oldx = x;
 	int oldy = y;
@@ -230,7 +237,7 @@ void CGraphic::DrawSubClipTrans(const int gx, const int gy, int w, int h, int x,
 **  @param x       x coordinate on the screen
 **  @param y       y coordinate on the screen
 */
-void CGraphic::DrawFrame(unsigned frame, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawFrame(unsigned frame, int x, int y, render_command_buffer &render_commands)
 {
 	this->render_frame(frame, QPoint(x, y), render_commands);
 }
@@ -242,33 +249,33 @@ void CGraphic::DrawFrame(unsigned frame, int x, int y, std::vector<std::function
 **  @param x       x coordinate on the screen
 **  @param y       y coordinate on the screen
 */
-void CGraphic::DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands)
 {
 	this->render_frame(frame, QPoint(x, y), nullptr, time_of_day, false, false, 255, show_percent, render_commands);
 }
 
-void CGraphic::DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands)
 {
 	this->render_frame(frame, QPoint(x, y), nullptr, time_of_day, false, false, alpha, show_percent, render_commands);
 }
 
-void CGraphic::DrawGrayscaleFrameClip(unsigned frame, int x, int y, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawGrayscaleFrameClip(unsigned frame, int x, int y, int show_percent, render_command_buffer &render_commands)
 {
 	this->render_grayscale_frame(frame, QPoint(x, y), show_percent, render_commands);
 }
 
-void CPlayerColorGraphic::DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands)
 {
 	this->render_player_color_frame(frame, QPoint(x, y), player_color, time_of_day, false, 255, show_percent, render_commands);
 }
 
 //Wyrmgus start
-void CPlayerColorGraphic::DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, int show_percent, render_command_buffer &render_commands)
 {
 	this->render_player_color_frame(frame, QPoint(x, y), player_color, time_of_day, false, alpha, show_percent, render_commands);
 }
 
-void CPlayerColorGraphic::DrawPlayerColorFrameClipTransX(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorFrameClipTransX(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	this->render_player_color_frame(frame, QPoint(x, y), player_color, time_of_day, true, alpha, 100, render_commands);
 }
@@ -283,7 +290,7 @@ void CPlayerColorGraphic::DrawPlayerColorFrameClipTransX(const player_color *pla
 */
 //Wyrmgus start
 //void CGraphic::DrawFrameClipX(unsigned frame, int x, int y) const
-void CGraphic::DrawFrameClipX(unsigned frame, int x, int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawFrameClipX(unsigned frame, int x, int y, const time_of_day *time_of_day, render_command_buffer &render_commands)
 //Wyrmgus end
 {
 	this->render_frame(frame, QPoint(x, y), nullptr, time_of_day, false, true, 255, 100, render_commands);
@@ -291,7 +298,7 @@ void CGraphic::DrawFrameClipX(unsigned frame, int x, int y, const time_of_day *t
 
 //Wyrmgus start
 //void CGraphic::DrawFrameClipTransX(unsigned frame, int x, int y, int alpha) const
-void CGraphic::DrawFrameClipTransX(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::DrawFrameClipTransX(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands)
 //Wyrmgus end
 {
 	this->render_frame(frame, QPoint(x, y), nullptr, time_of_day, false, true, alpha, 100, render_commands);
@@ -305,7 +312,7 @@ void CGraphic::DrawFrameClipTransX(const unsigned frame, const int x, const int
 **  @param x       x coordinate on the screen
 **  @param y       y coordinate on the screen
 */
-void CPlayerColorGraphic::DrawPlayerColorFrameClipX(const player_color *player_color, unsigned frame, int x, int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+void CPlayerColorGraphic::DrawPlayerColorFrameClipX(const player_color *player_color, unsigned frame, int x, int y, const time_of_day *time_of_day, render_command_buffer &render_commands)
 {
 	this->render_player_color_frame(frame, QPoint(x, y), player_color, time_of_day, true, 255, 100, render_commands);
 }
@@ -486,6 +493,11 @@ static void ApplyGrayScale(QImage &image)
 				image = image.convertToFormat(QImage::Format_RGBA8888);
 			}
 
+			if (bpp == 4) {
+				pixel_kernels::apply_grayscale(reinterpret_cast<uint32_t *>(image.bits()), static_cast<size_t>(image.width()) * image.height());
+				break;
+			}
+
 			unsigned char *image_data = image.bits();
 			for (int x = 0; x < image.width(); ++x) {
 				for (int y = 0; y < image.height(); ++y) {
@@ -535,6 +547,11 @@ static void ApplySepiaScale(QImage &image)
 				image = image.convertToFormat(QImage::Format_RGBA8888);
 			}
 
+			if (bpp == 4) {
+				pixel_kernels::apply_sepia(reinterpret_cast<uint32_t *>(image.bits()), static_cast<size_t>(image.width()) * image.height());
+				break;
+			}
+
 			unsigned char *image_data = image.bits();
 			for (int x = 0; x < image.width(); ++x) {
 				for (int y = 0; y < image.height(); ++y) {
@@ -624,13 +641,18 @@ void CGraphic::Load(const centesimal_int &scale_factor)
 		}
 	}
 	
-	CGraphic::graphics.push_back(this);
+	{
+		std::unique_lock<std::shared_mutex> graphics_lock(CGraphic::mutex);
+		CGraphic::graphics.push_back(this);
+	}
 
 	GenFramesMap();
 
 	if (scale_factor != this->custom_scale_factor) {
 		this->Resize((this->GraphicWidth * scale_factor / this->custom_scale_factor).to_int(), (this->GraphicHeight * scale_factor / this->custom_scale_factor).to_int());
 	}
+
+	this->loaded = true;
 }
 
 void CGraphic::unload()
@@ -641,10 +663,12 @@ void CGraphic::unload()
 		return;
 	}
 
+	this->loaded = false;
 	this->frame_map.clear();
 	this->Width = this->original_frame_size.width();
 	this->Height = this->original_frame_size.height();
 	this->image = QImage();
+	this->clear_image_hash();
 	this->frame_images.clear();
 	this->grayscale_frame_images.clear();
 	this->modified_frame_images.clear();
@@ -660,7 +684,7 @@ void CGraphic::unload()
 */
 void CGraphic::Resize(int w, int h)
 {
-	assert_throw(this->IsLoaded()); // can't resize before it's been loaded
+	assert_throw(!this->image.isNull()); // can't resize before it's been loaded
 
 	if (this->GraphicWidth == w && this->GraphicHeight == h) {
 		return;
@@ -719,6 +743,29 @@ QPoint CGraphic::get_frame_pos(const int frame_index) const
 }
 
 QImage CGraphic::create_modified_image(const color_modification &color_modification, const bool grayscale) const
+{
+	const centesimal_int &scale_factor = preferences::get()->get_scale_factor();
+	const bool rescale = scale_factor > 1 && scale_factor != this->custom_scale_factor;
+
+	if (!grayscale && color_modification.is_null() && !rescale) {
+		//nothing expensive to be done, so there is no point in using the image cache
+		return this->create_modified_image_uncached(color_modification, grayscale);
+	}
+
+	const QByteArray cache_key = this->get_modified_image_cache_key(color_modification, grayscale);
+
+	QImage image = image_cache::get()->get_image(cache_key);
+	if (!image.isNull()) {
+		return image;
+	}
+
+	image = this->create_modified_image_uncached(color_modification, grayscale);
+	image_cache::get()->add_image(cache_key, image);
+
+	return image;
+}
+
+QImage CGraphic::create_modified_image_uncached(const color_modification &color_modification, const bool grayscale) const
 {
 	QImage image = this->get_image();
 
@@ -761,25 +808,83 @@ QImage CGraphic::create_modified_image(const color_modification &color_modificat
 	}
 
 	if (color_modification.has_rgb_change() && !grayscale) {
-		unsigned char *image_data = image.bits();
-		const int bpp = image.depth() / 8;
+		if (image.format() != QImage::Format_RGBA8888) {
+			image = image.convertToFormat(QImage::Format_RGBA8888);
+		}
+
+		pixel_kernels::apply_rgb_change(reinterpret_cast<uint32_t *>(image.bits()), static_cast<size_t>(image.sizeInBytes()) / 4, color_modification.get_red_change(), color_modification.get_green_change(), color_modification.get_blue_change());
+	}
+
+	return image;
+}
+
+const QByteArray &CGraphic::get_image_hash() const
+{
+	std::lock_guard lock(this->image_hash_mutex);
+
+	if (this->image_hash.isEmpty()) {
+		QCryptographicHash hash(QCryptographicHash::Sha1);
+		hash.addData(reinterpret_cast<const char *>(this->get_image().constBits()), static_cast<int>(this->get_image().sizeInBytes()));
+		this->image_hash = hash.result();
+	}
+
+	return this->image_hash;
+}
 
-		const int red_change = color_modification.get_red_change();
-		const int green_change = color_modification.get_green_change();
-		const int blue_change = color_modification.get_blue_change();
+QByteArray CGraphic::get_modified_image_cache_key(const color_modification &color_modification, const bool grayscale) const
+{
+	//the key must include everything which affects the result of creating the modified image
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+
+	const auto add_int = [&hash](const int64_t value) {
+		hash.addData(reinterpret_cast<const char *>(&value), sizeof(value));
+	};
+
+	const auto add_string = [&hash, &add_int](const std::string &str) {
+		add_int(static_cast<int64_t>(str.size()));
+		hash.addData(str.data(), static_cast<int>(str.size()));
+	};
 
-		for (int i = 0; i < image.sizeInBytes(); i += bpp) {
-			unsigned char &red = image_data[i];
-			unsigned char &green = image_data[i + 1];
-			unsigned char &blue = image_data[i + 2];
+	const auto add_player_color = [&add_int, &add_string](const wyrmgus::player_color *player_color_entry) {
+		if (player_color_entry == nullptr) {
+			add_string(std::string());
+			return;
+		}
 
-			red = std::clamp<int>(red + red_change, 0, 255);
-			green = std::clamp<int>(green + green_change, 0, 255);
-			blue = std::clamp<int>(blue + blue_change, 0, 255);
+		add_string(player_color_entry->get_identifier());
+		add_int(static_cast<int64_t>(player_color_entry->get_colors().size()));
+		for (const QColor &color : player_color_entry->get_colors()) {
+			add_int(color.rgba());
+		}
+	};
+
+	hash.addData(this->get_image_hash());
+	add_int(this->get_image().width());
+	add_int(this->get_image().height());
+	add_int(static_cast<int64_t>(this->get_image().format()));
+	add_string(preferences::get()->get_scale_factor().to_string());
+	add_string(this->custom_scale_factor.to_string());
+	add_int(this->get_loaded_frame_size().width());
+	add_int(this->get_loaded_frame_size().height());
+	add_player_color(this->get_conversible_player_color());
+
+	add_int(grayscale ? 1 : 0);
+	if (grayscale) {
+		add_int(Preference.SepiaForGrayscale ? 1 : 0);
+	} else {
+		add_int(color_modification.get_hue_rotation());
+		add_int(static_cast<int64_t>(color_modification.get_colorization()));
+		add_int(static_cast<int64_t>(color_modification.get_hue_ignored_colors().size()));
+		for (const QColor &color : color_modification.get_hue_ignored_colors()) {
+			add_int(color.rgba());
 		}
+		add_player_color(color_modification.get_player_color());
+		add_int(color_modification.get_red_change());
+		add_int(color_modification.get_green_change());
+		add_int(color_modification.get_blue_change());
 	}
 
-	return image;
+	return hash.result();
 }
 
 void CGraphic::create_frame_images(const color_modification &color_modification, const bool grayscale)
@@ -833,38 +938,26 @@ void CGraphic::create_texture(const color_modification &color_modification, cons
 	}
 }
 
-void CGraphic::render(const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::render(const QPoint &pixel_pos, render_command_buffer &render_commands)
 {
-	render_commands.push_back([this, pixel_pos](renderer *renderer) {
-		const QOpenGLTexture *texture = this->get_or_create_texture(color_modification(), false);
-
-		renderer->blit_texture(texture, pixel_pos, this->get_size(), false, 255, this->get_size());
-	});
+	render_commands.add_texture(this, pixel_pos);
 }
 
-void CGraphic::render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, render_command_buffer &render_commands)
 {
-	render_commands.push_back([this, frame_index, pixel_pos, color_modification, grayscale, flip, opacity, show_percent](renderer *renderer) {
-		const QOpenGLTexture *texture = this->get_or_create_texture(color_modification, grayscale);
-
-		renderer->blit_texture_frame(texture, pixel_pos, this->get_size(), frame_index, this->get_frame_size(), flip, opacity, show_percent);
-	});
+	render_commands.add_texture_frame(this, frame_index, pixel_pos, color_modification, grayscale, flip, opacity, show_percent);
 }
 
-void CGraphic::render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, render_command_buffer &render_commands)
 {
 	const color_modification color_modification(0, colorization_type::none, color_set(), player_color, time_of_day);
 
 	this->render_frame(frame_index, pixel_pos, color_modification, grayscale, flip, opacity, show_percent, render_commands);
 }
 
-void CGraphic::render_rect(const QRect &rect, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity, std::vector<std::function<void(renderer *)>> &render_commands)
+void CGraphic::render_rect(const QRect &rect, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity, render_command_buffer &render_commands)
 {
-	render_commands.push_back([this, rect, pixel_pos, color_modification, grayscale, opacity](renderer *renderer) {
-		const QOpenGLTexture *texture = this->get_or_create_texture(color_modification, grayscale);
-
-		renderer->blit_texture_frame(texture, pixel_pos, rect.topLeft(), rect.size(), false, opacity, 100, rect.size());
-	});
+	render_commands.add_texture_rect(this, rect, pixel_pos, color_modification, grayscale, opacity);
 }
 
 void CGraphic::free_textures()
@@ -0,0 +1,225 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/graphic_loader.h"
+
+#include "database/preferences.h"
+#include "util/exception_util.h"
+#include "util/thread_pool.h"
+#include "util/vector_util.h"
+#include "video/video.h"
+
+namespace wyrmgus {
+
+graphic_loader::~graphic_loader()
+{
+	this->stop_streaming();
+}
+
+void graphic_loader::load(const std::vector<std::shared_ptr<CGraphic>> &graphics)
+{
+	const auto start_time = std::chrono::steady_clock::now();
+
+	const size_t loaded_count = this->load_graphics(graphics, std::max(std::thread::hardware_concurrency(), 1u), false);
+
+	const std::chrono::nanoseconds load_duration = std::chrono::steady_clock::now() - start_time;
+
+	std::lock_guard lock(this->mutex);
+	this->last_statistics.loaded_count += loaded_count;
+	this->last_statistics.load_duration += load_duration;
+}
+
+void graphic_loader::queue_for_streaming(const std::vector<std::shared_ptr<CGraphic>> &graphics)
+{
+	if (graphics.empty()) {
+		return;
+	}
+
+	if (this->streaming_future.valid()) {
+		//wait for the previous graphics to be streamed in, so that the new ones are not left without a stream
+		this->streaming_future.get();
+	}
+
+	vector::merge(this->streaming_queue, graphics);
+	this->streaming = true;
+}
+
+void graphic_loader::stop_streaming()
+{
+	this->stop_requested = true;
+
+	if (this->streaming_future.valid()) {
+		this->streaming_future.get();
+	}
+
+	this->streaming_queue.clear();
+	this->streaming = false;
+	this->stop_requested = false;
+}
+
+void graphic_loader::ensure_loaded(CGraphic &graphic) const
+{
+	if (!this->is_streaming() || graphic.IsLoaded()) {
+		return;
+	}
+
+	graphic.Load(preferences::get()->get_scale_factor());
+}
+
+void graphic_loader::on_game_load_started()
+{
+	this->stop_streaming();
+
+	this->game_load_start_time = std::chrono::steady_clock::now();
+
+	std::lock_guard lock(this->mutex);
+	this->last_statistics = statistics();
+}
+
+void graphic_loader::on_first_playable_frame()
+{
+	const std::chrono::nanoseconds first_playable_frame_duration = std::chrono::steady_clock::now() - this->game_load_start_time;
+
+	statistics load_statistics;
+
+	{
+		std::lock_guard lock(this->mutex);
+		this->last_statistics.first_playable_frame_duration = first_playable_frame_duration;
+		load_statistics = this->last_statistics;
+	}
+
+	DebugPrint("Time to first playable frame: %lld ms (%zu graphics loaded in %lld ms, %zu graphics queued for streaming).\n" _C_ static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(first_playable_frame_duration).count()) _C_ load_statistics.loaded_count _C_ static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(load_statistics.load_duration).count()) _C_ this->streaming_queue.size());
+
+	this->start_streaming();
+}
+
+void graphic_loader::start_streaming()
+{
+	if (this->streaming_queue.empty() || this->streaming_future.valid()) {
+		return;
+	}
+
+	this->streaming_future = thread_pool::get()->co_spawn_future([this, graphics = std::move(this->streaming_queue)]() -> boost::asio::awaitable<void> {
+		this->stream(graphics);
+		this->streaming = false;
+		co_return;
+	});
+
+	this->streaming_queue.clear();
+}
+
+void graphic_loader::stream(const std::vector<std::shared_ptr<CGraphic>> &graphics)
+{
+	const auto start_time = std::chrono::steady_clock::now();
+
+	//use only part of the available threads, so that the game and render threads are not starved while the graphics are streamed in
+	const size_t streamed_count = this->load_graphics(graphics, std::max(std::thread::hardware_concurrency() / 2, 1u), true);
+
+	const std::chrono::nanoseconds stream_duration = std::chrono::steady_clock::now() - start_time;
+
+	DebugPrint("Streamed in %zu graphics in %lld ms.\n" _C_ streamed_count _C_ static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(stream_duration).count()));
+
+	std::lock_guard lock(this->mutex);
+	this->last_statistics.streamed_count += streamed_count;
+	this->last_statistics.stream_duration += stream_duration;
+}
+
+size_t graphic_loader::load_graphics(const std::vector<std::shared_ptr<CGraphic>> &graphics, const size_t thread_count, const bool background)
+{
+	//skip graphics which have already been loaded, as well as duplicates, since different data entries can share the same graphic
+	std::vector<CGraphic *> unloaded_graphics;
+	std::set<const CGraphic *> graphic_set;
+
+	for (const std::shared_ptr<CGraphic> &graphic : graphics) {
+		if (graphic->IsLoaded()) {
+			continue;
+		}
+
+		if (!graphic_set.insert(graphic.get()).second) {
+			continue;
+		}
+
+		unloaded_graphics.push_back(graphic.get());
+	}
+
+	if (unloaded_graphics.empty()) {
+		return 0;
+	}
+
+	const centesimal_int scale_factor = preferences::get()->get_scale_factor();
+	std::atomic<size_t> next_index = 0;
+	std::atomic<size_t> loaded_count = 0;
+
+	//CGraphic::Load locks the graphic, so a graphic being drawn while it is being streamed in waits for it instead of loading it again
+	const auto load_next_graphics = [&]() {
+		while (!background || !this->stop_requested) {
+			const size_t index = next_index.fetch_add(1);
+
+			if (index >= unloaded_graphics.size()) {
+				break;
+			}
+
+			CGraphic *graphic = unloaded_graphics[index];
+
+			if (background) {
+				//report the failure, but keep streaming the other graphics; the graphic will be tried again when it is drawn
+				try {
+					graphic->Load(scale_factor);
+				} catch (const std::exception &exception) {
+					exception::report(exception);
+					continue;
+				}
+			} else {
+				graphic->Load(scale_factor);
+			}
+
+			++loaded_count;
+		}
+	};
+
+	//the calling thread loads graphics as well, so one less thread needs to be started
+	std::vector<std::future<void>> futures;
+	const size_t worker_count = std::min(thread_count, unloaded_graphics.size());
+	for (size_t i = 1; i < worker_count; ++i) {
+		futures.push_back(thread_pool::get()->co_spawn_future([&load_next_graphics]() -> boost::asio::awaitable<void> {
+			load_next_graphics();
+			co_return;
+		}));
+	}
+
+	load_next_graphics();
+
+	for (std::future<void> &future : futures) {
+		future.get();
+	}
+
+	return loaded_count;
+}
+
+}
@@ -0,0 +1,94 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/singleton.h"
+
+class CGraphic;
+
+namespace wyrmgus {
+
+//loads graphics in parallel when a game is being started: graphics needed for the first frames are loaded while the game waits, and the remaining ones are streamed in the background once the game has begun
+class graphic_loader final : public singleton<graphic_loader>
+{
+public:
+	struct statistics final
+	{
+		size_t loaded_count = 0; //the amount of graphics loaded while the game waited for them
+		std::chrono::nanoseconds load_duration = std::chrono::nanoseconds(0);
+		size_t streamed_count = 0; //the amount of graphics loaded in the background after the game began
+		std::chrono::nanoseconds stream_duration = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds first_playable_frame_duration = std::chrono::nanoseconds(0); //the time from the start of loading the game until its first playable frame
+	};
+
+	~graphic_loader();
+
+	//load the graphics in parallel, returning when all of them have been loaded
+	void load(const std::vector<std::shared_ptr<CGraphic>> &graphics);
+
+	//queue graphics which are not needed for the first frames, to be loaded in the background once the game has begun
+	void queue_for_streaming(const std::vector<std::shared_ptr<CGraphic>> &graphics);
+
+	//whether there are queued graphics which have not been streamed in yet; while this is the case, code drawing graphics must ensure they are loaded
+	bool is_streaming() const
+	{
+		return this->streaming;
+	}
+
+	//stop streaming graphics, waiting for those being loaded; graphics which have not been loaded yet will be loaded on demand instead
+	void stop_streaming();
+
+	//load the graphic now if it has not been streamed in yet, or wait for it if it is being streamed in; must be called before using a graphic which may be queued for streaming
+	void ensure_loaded(CGraphic &graphic) const;
+
+	void on_game_load_started();
+	void on_first_playable_frame();
+
+	statistics get_last_statistics() const
+	{
+		std::lock_guard lock(this->mutex);
+		return this->last_statistics;
+	}
+
+private:
+	void start_streaming();
+	void stream(const std::vector<std::shared_ptr<CGraphic>> &graphics);
+
+	//load the graphics with the given amount of threads, returning the amount of graphics which were loaded
+	size_t load_graphics(const std::vector<std::shared_ptr<CGraphic>> &graphics, const size_t thread_count, const bool report_errors);
+
+	std::vector<std::shared_ptr<CGraphic>> streaming_queue;
+	std::future<void> streaming_future;
+	std::atomic<bool> streaming = false;
+	std::atomic<bool> stop_requested = false;
+	std::chrono::steady_clock::time_point game_load_start_time;
+	statistics last_statistics;
+	mutable std::mutex mutex;
+};
+
+}
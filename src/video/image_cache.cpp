@@ -0,0 +1,160 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/image_cache.h"
+
+#include "parameters.h"
+#include "util/assert_util.h"
+#include "util/exception_util.h"
+#include "util/path_util.h"
+
+#include <QSaveFile>
+
+namespace wyrmgus {
+
+namespace {
+
+//the header of a cached image file, followed by the image's RGBA data
+struct image_cache_header final
+{
+	std::array<char, 8> magic{};
+	uint32_t version = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t bytes_per_line = 0;
+};
+
+}
+
+const std::filesystem::path &image_cache::get_directory()
+{
+	std::call_once(this->directory_once_flag, [this]() {
+		this->directory = parameters::get()->GetUserDirectory() / "cache" / "images" / ("v" + std::to_string(image_cache::version));
+		std::filesystem::create_directories(this->directory);
+	});
+
+	return this->directory;
+}
+
+std::filesystem::path image_cache::get_image_filepath(const QByteArray &key)
+{
+	return this->get_directory() / (key.toHex().toStdString() + ".rgba");
+}
+
+QImage image_cache::get_image(const QByteArray &key)
+{
+	try {
+		QFile file(path::to_qstring(this->get_image_filepath(key)));
+
+		if (!file.exists()) {
+			++this->miss_count;
+			return QImage();
+		}
+
+		if (!file.open(QIODevice::ReadOnly)) {
+			throw std::runtime_error("Failed to open cached image file \"" + file.fileName().toStdString() + "\".");
+		}
+
+		const qint64 file_size = file.size();
+
+		if (file_size < static_cast<qint64>(sizeof(image_cache_header))) {
+			throw std::runtime_error("Cached image file \"" + file.fileName().toStdString() + "\" is truncated.");
+		}
+
+		//map the file instead of reading it into an intermediate buffer, copying its data directly into the image
+		const uchar *file_data = file.map(0, file_size);
+		if (file_data == nullptr) {
+			throw std::runtime_error("Failed to map cached image file \"" + file.fileName().toStdString() + "\".");
+		}
+
+		image_cache_header header;
+		memcpy(&header, file_data, sizeof(header));
+
+		if (header.magic != image_cache::magic || header.version != image_cache::version || static_cast<qint64>(sizeof(header)) + static_cast<qint64>(header.bytes_per_line) * header.height != file_size) {
+			file.unmap(const_cast<uchar *>(file_data));
+			throw std::runtime_error("Cached image file \"" + file.fileName().toStdString() + "\" is invalid.");
+		}
+
+		QImage image(static_cast<int>(header.width), static_cast<int>(header.height), QImage::Format_RGBA8888);
+
+		if (image.bytesPerLine() == static_cast<qsizetype>(header.bytes_per_line)) {
+			memcpy(image.bits(), file_data + sizeof(header), static_cast<size_t>(header.bytes_per_line) * header.height);
+		} else {
+			for (uint32_t y = 0; y < header.height; ++y) {
+				memcpy(image.scanLine(static_cast<int>(y)), file_data + sizeof(header) + static_cast<size_t>(header.bytes_per_line) * y, std::min<size_t>(header.bytes_per_line, image.bytesPerLine()));
+			}
+		}
+
+		file.unmap(const_cast<uchar *>(file_data));
+
+		++this->hit_count;
+		return image;
+	} catch (const std::exception &exception) {
+		//a corrupt cache entry is treated as a miss, and then gets overwritten
+		exception::report(exception);
+		++this->error_count;
+		++this->miss_count;
+		return QImage();
+	}
+}
+
+void image_cache::add_image(const QByteArray &key, const QImage &image)
+{
+	try {
+		assert_throw(image.format() == QImage::Format_RGBA8888);
+
+		//the file is written to a temporary file and then renamed, so that a partially written file is never read
+		QSaveFile file(path::to_qstring(this->get_image_filepath(key)));
+
+		if (!file.open(QIODevice::WriteOnly)) {
+			throw std::runtime_error("Failed to open cached image file \"" + file.fileName().toStdString() + "\" for writing.");
+		}
+
+		image_cache_header header;
+		header.magic = image_cache::magic;
+		header.version = image_cache::version;
+		header.width = static_cast<uint32_t>(image.width());
+		header.height = static_cast<uint32_t>(image.height());
+		header.bytes_per_line = static_cast<uint32_t>(image.bytesPerLine());
+
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+
+		if (!file.commit()) {
+			throw std::runtime_error("Failed to write cached image file \"" + file.fileName().toStdString() + "\".");
+		}
+
+		++this->write_count;
+	} catch (const std::exception &exception) {
+		exception::report(exception);
+		++this->error_count;
+	}
+}
+
+}
@@ -0,0 +1,80 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "util/singleton.h"
+
+namespace wyrmgus {
+
+//a persistent on-disk cache of modified (e.g. rescaled or recolored) images, so that they don't need to be created again on each launch
+//images are stored as raw RGBA data, in files named after a hash of everything which affects the modified image
+class image_cache final : public singleton<image_cache>
+{
+public:
+	//the version of the cache, which must be increased whenever the way modified images are created changes, so that stale images are not used
+	static constexpr int version = 1;
+
+	static constexpr std::array<char, 8> magic = { 'W', 'Y', 'R', 'M', 'I', 'M', 'G', '\0' };
+
+	struct statistics final
+	{
+		uint64_t hit_count = 0;
+		uint64_t miss_count = 0;
+		uint64_t write_count = 0;
+		uint64_t error_count = 0;
+	};
+
+	const std::filesystem::path &get_directory();
+
+	//get the cached image for a key, returning a null image if it is not in the cache
+	QImage get_image(const QByteArray &key);
+
+	void add_image(const QByteArray &key, const QImage &image);
+
+	statistics get_statistics() const
+	{
+		statistics cache_statistics;
+		cache_statistics.hit_count = this->hit_count;
+		cache_statistics.miss_count = this->miss_count;
+		cache_statistics.write_count = this->write_count;
+		cache_statistics.error_count = this->error_count;
+		return cache_statistics;
+	}
+
+private:
+	std::filesystem::path get_image_filepath(const QByteArray &key);
+
+	std::filesystem::path directory;
+	std::once_flag directory_once_flag;
+	std::atomic<uint64_t> hit_count = 0;
+	std::atomic<uint64_t> miss_count = 0;
+	std::atomic<uint64_t> write_count = 0;
+	std::atomic<uint64_t> error_count = 0;
+};
+
+}
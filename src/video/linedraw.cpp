@@ -34,7 +34,7 @@
 #include "intern_video.h"
 
 #include "util/assert_util.h"
-#include "video/renderer.h"
+#include "video/render_command_buffer.h"
 
 /**
 ** Bitmask, denoting a position left/right/above/below clip rectangle
@@ -56,15 +56,13 @@ namespace linedraw_gl
 **  @param x      x coordinate on the screen
 **  @param y      y coordinate on the screen
 */
-void DrawPixel(uint32_t color, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawPixel(uint32_t color, int x, int y, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([x, y, r, g, b, a](renderer *renderer) {
-		renderer->draw_pixel(QPoint(x, y), QColor(r, g, b, a));
-	});
+	render_commands.add_pixel(QPoint(x, y), QColor(r, g, b, a));
 }
 
 /**
@@ -75,14 +73,12 @@ void DrawPixel(uint32_t color, int x, int y, std::vector<std::function<void(rend
 **  @param y      y coordinate on the screen
 **  @param width  width of line (0=don't draw).
 */
-void DrawHLine(uint32_t color, int x, int y, int width, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawHLine(uint32_t color, int x, int y, int width, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([x, y, width, r, g, b, a](renderer *renderer) {
-		renderer->draw_horizontal_line(QPoint(x, y), width, QColor(r, g, b, a));
-	});
+	render_commands.add_horizontal_line(QPoint(x, y), width, QColor(r, g, b, a));
 }
 
 /**
@@ -93,15 +89,13 @@ void DrawHLine(uint32_t color, int x, int y, int width, std::vector<std::functio
 **  @param y       y coordinate on the screen
 **  @param height  height of line (0=don't draw).
 */
-void DrawVLine(uint32_t color, int x, int y, int height, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawVLine(uint32_t color, int x, int y, int height, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([x, y, height, r, g, b, a](renderer *renderer) {
-		renderer->draw_vertical_line(QPoint(x, y), height, QColor(r, g, b, a));
-	});
+	render_commands.add_vertical_line(QPoint(x, y), height, QColor(r, g, b, a));
 }
 
 /**
@@ -113,7 +107,7 @@ void DrawVLine(uint32_t color, int x, int y, int height, std::vector<std::functi
 **  @param x2     Destination x coordinate on the screen
 **  @param y2     Destination y coordinate on the screen
 */
-void DrawLine(uint32_t color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawLine(uint32_t color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 
@@ -135,9 +129,7 @@ void DrawLine(uint32_t color, int x1, int y1, int x2, int y2, std::vector<std::f
 
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([xx1, yy1, xx2, yy2, r, g, b, a](renderer *renderer) {
-		renderer->draw_line(QPoint(xx1, yy1), QPoint(xx2, yy2), QColor(r, g, b, a));
-	});
+	render_commands.add_line(QPoint(xx1, yy1), QPoint(xx2, yy2), QColor(r, g, b, a));
 }
 
 /**
@@ -204,7 +196,7 @@ static int LineIsUnclipped(int code1, int code2)
 **  @param x2     Destination x coordinate on the screen
 **  @param y2     Destination y coordinate on the screen
 */
-void DrawLineClip(uint32_t color, int x1, int y1, int x2, int y2, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawLineClip(uint32_t color, int x1, int y1, int x2, int y2, render_command_buffer &render_commands)
 {
 	int code1;
 	int code2;
@@ -260,15 +252,13 @@ void DrawLineClip(uint32_t color, int x1, int y1, int x2, int y2, std::vector<st
 **  @param h      height of rectangle (0=don't draw).
 **  @param w      width of rectangle (0=don't draw).
 */
-void DrawRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+void DrawRectangle(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([x, y, w, h, r, g, b, a](renderer *renderer) {
-		renderer->draw_rect(QPoint(x, y), QSize(w, h), QColor(r, g, b, a));
-	});
+	render_commands.add_rect(QPoint(x, y), QSize(w, h), QColor(r, g, b, a));
 }
 
 /**
@@ -282,7 +272,7 @@ void DrawRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::
 **  @param alpha  alpha value of pixel.
 */
 void DrawTransRectangle(uint32_t color, int x, int y,
-						int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+						int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b;
 
@@ -301,7 +291,7 @@ void DrawTransRectangle(uint32_t color, int x, int y,
 **  @param w      width of rectangle (0=don't draw).
 */
 void DrawRectangleClip(uint32_t color, int x, int y,
-					   int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+					   int w, int h, render_command_buffer &render_commands)
 {
 	// Ensure non-empty rectangle
 	if (!w || !h) {
@@ -389,15 +379,13 @@ void DrawRectangleClip(uint32_t color, int x, int y,
 **  @param w      width of rectangle (0=don't draw).
 */
 void FillRectangle(uint32_t color, int x, int y,
-				   int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+				   int w, int h, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b, a;
 
 	CVideo::GetRGBA(color, &r, &g, &b, &a);
 
-	render_commands.push_back([x, y, w, h, r, g, b, a](renderer *renderer) {
-		renderer->fill_rect(QPoint(x, y), QSize(w, h), QColor(r, g, b, a));
-	});
+	render_commands.add_filled_rect(QPoint(x, y), QSize(w, h), QColor(r, g, b, a));
 }
 
 /**
@@ -411,7 +399,7 @@ void FillRectangle(uint32_t color, int x, int y,
 **  @param alpha  alpha value of pixel.
 */
 void FillTransRectangle(uint32_t color, int x, int y,
-						int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+						int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b;
 
@@ -430,7 +418,7 @@ void FillTransRectangle(uint32_t color, int x, int y,
 **  @param w      width of rectangle (0=don't draw).
 */
 void FillRectangleClip(uint32_t color, int x, int y,
-					   int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+					   int w, int h, render_command_buffer &render_commands)
 {
 	CLIP_RECTANGLE(x, y, w, h);
 	FillRectangle(color, x, y, w, h, render_commands);
@@ -447,7 +435,7 @@ void FillRectangleClip(uint32_t color, int x, int y,
 **  @param alpha  alpha value of pixels.
 */
 void FillTransRectangleClip(uint32_t color, int x, int y,
-							int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+							int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	GLubyte r, g, b;
 
@@ -458,57 +446,57 @@ void FillTransRectangleClip(uint32_t color, int x, int y,
 
 }
 
-void CVideo::DrawVLine(uint32_t color, int x, int y, int height, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawVLine(uint32_t color, int x, int y, int height, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawVLine(color, x, y, height, render_commands);
 }
 
-void CVideo::DrawHLine(uint32_t color, int x, int y, int width, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawHLine(uint32_t color, int x, int y, int width, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawHLine(color, x, y, width, render_commands);
 }
 
-void CVideo::DrawLine(uint32_t color, int sx, int sy, int dx, int dy, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawLine(uint32_t color, int sx, int sy, int dx, int dy, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawLine(color, sx, sy, dx, dy, render_commands);
 }
 
-void CVideo::DrawLineClip(uint32_t color, const PixelPos &pos1, const PixelPos &pos2, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawLineClip(uint32_t color, const PixelPos &pos1, const PixelPos &pos2, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawLineClip(color, pos1.x, pos1.y, pos2.x, pos2.y, render_commands);
 }
 
-void CVideo::DrawRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawRectangle(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawRectangle(color, x, y, w, h, render_commands);
 }
 
-void CVideo::DrawTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawTransRectangle(color, x, y, w, h, alpha, render_commands);
 }
 
-void CVideo::DrawRectangleClip(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::DrawRectangleClip(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands)
 {
 	linedraw_gl::DrawRectangleClip(color, x, y, w, h, render_commands);
 }
 
-void CVideo::FillRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::FillRectangle(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands)
 {
 	linedraw_gl::FillRectangle(color, x, y, w, h, render_commands);
 }
 
-void CVideo::FillTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::FillTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	linedraw_gl::FillTransRectangle(color, x, y, w, h, alpha, render_commands);
 }
 
-void CVideo::FillRectangleClip(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::FillRectangleClip(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands)
 {
 	linedraw_gl::FillRectangleClip(color, x, y, w, h, render_commands);
 }
 
-void CVideo::FillTransRectangleClip(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+void CVideo::FillTransRectangleClip(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands)
 {
 	linedraw_gl::FillTransRectangleClip(color, x, y, w, h, alpha, render_commands);
 }
@@ -0,0 +1,517 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/pixel_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PIXEL_KERNELS_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+#define PIXEL_KERNELS_SSE2_TARGET
+#define PIXEL_KERNELS_AVX2_TARGET
+#else
+#define PIXEL_KERNELS_SSE2_TARGET __attribute__((target("sse2")))
+#define PIXEL_KERNELS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace wyrmgus::pixel_kernels {
+
+//the weights are the same as those used before the kernels were vectorized; the vectorized kernels use double precision with the same operation order as the scalar code, so that the results are bit-exact
+static constexpr double gray_red_weight = 0.21;
+static constexpr double gray_green_weight = 0.72;
+static constexpr double gray_blue_weight = 0.07;
+
+static constexpr std::array<std::array<double, 3>, 3> sepia_weights = {{
+	{ .393, .769, .189 },
+	{ .349, .686, .168 },
+	{ .272, .534, .131 }
+}};
+
+static constexpr uint32_t rgb_mask = 0x00FFFFFF;
+static constexpr uint32_t alpha_mask = 0xFF000000;
+
+static void apply_grayscale_scalar(uint32_t *pixels, const size_t pixel_count)
+{
+	for (size_t i = 0; i < pixel_count; ++i) {
+		const uint32_t pixel = pixels[i];
+		const int red = pixel & 0xFF;
+		const int green = (pixel >> 8) & 0xFF;
+		const int blue = (pixel >> 16) & 0xFF;
+
+		const uint32_t gray = static_cast<uint32_t>(static_cast<int>(gray_red_weight * red + gray_green_weight * green + gray_blue_weight * blue));
+		pixels[i] = (pixel & alpha_mask) | gray | (gray << 8) | (gray << 16);
+	}
+}
+
+static void apply_sepia_scalar(uint32_t *pixels, const size_t pixel_count)
+{
+	for (size_t i = 0; i < pixel_count; ++i) {
+		const uint32_t pixel = pixels[i];
+		const int input_red = pixel & 0xFF;
+		const int input_green = (pixel >> 8) & 0xFF;
+		const int input_blue = (pixel >> 16) & 0xFF;
+
+		uint32_t result = pixel & alpha_mask;
+
+		for (size_t j = 0; j < sepia_weights.size(); ++j) {
+			const std::array<double, 3> &weights = sepia_weights[j];
+			const uint32_t value = static_cast<uint32_t>(std::min<int>(255, (input_red * weights[0]) + (input_green * weights[1]) + (input_blue * weights[2])));
+			result |= value << (j * 8);
+		}
+
+		pixels[i] = result;
+	}
+}
+
+static void apply_rgb_change_scalar(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change)
+{
+	for (size_t i = 0; i < pixel_count; ++i) {
+		const uint32_t pixel = pixels[i];
+
+		const uint32_t red = static_cast<uint32_t>(std::clamp<int>(static_cast<int>(pixel & 0xFF) + red_change, 0, 255));
+		const uint32_t green = static_cast<uint32_t>(std::clamp<int>(static_cast<int>((pixel >> 8) & 0xFF) + green_change, 0, 255));
+		const uint32_t blue = static_cast<uint32_t>(std::clamp<int>(static_cast<int>((pixel >> 16) & 0xFF) + blue_change, 0, 255));
+
+		pixels[i] = (pixel & alpha_mask) | red | (green << 8) | (blue << 16);
+	}
+}
+
+static void apply_color_swaps_scalar(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps)
+{
+	for (size_t i = 0; i < pixel_count; ++i) {
+		const uint32_t pixel = pixels[i];
+		const uint32_t rgb = pixel & rgb_mask;
+
+		for (const color_swap &swap : color_swaps) {
+			if (rgb == swap.rgb) {
+				pixels[i] = (pixel & alpha_mask) | swap.new_rgb;
+				break;
+			}
+		}
+	}
+}
+
+#ifdef PIXEL_KERNELS_X86
+
+//calculate the weighted sum of the channel values in the lower two lanes, truncated to integers
+PIXEL_KERNELS_SSE2_TARGET
+static inline __m128i weighted_pair_sum_sse2(const __m128i red, const __m128i green, const __m128i blue, const std::array<double, 3> &weights)
+{
+	const __m128d sum = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(red), _mm_set1_pd(weights[0])), _mm_mul_pd(_mm_cvtepi32_pd(green), _mm_set1_pd(weights[1]))), _mm_mul_pd(_mm_cvtepi32_pd(blue), _mm_set1_pd(weights[2])));
+	return _mm_cvttpd_epi32(sum);
+}
+
+//calculate the weighted sum of the channel values of four pixels, truncated to integers
+PIXEL_KERNELS_SSE2_TARGET
+static inline __m128i weighted_sum_sse2(const __m128i red, const __m128i green, const __m128i blue, const std::array<double, 3> &weights)
+{
+	const __m128i low = weighted_pair_sum_sse2(red, green, blue, weights);
+	const __m128i high = weighted_pair_sum_sse2(_mm_shuffle_epi32(red, _MM_SHUFFLE(3, 2, 3, 2)), _mm_shuffle_epi32(green, _MM_SHUFFLE(3, 2, 3, 2)), _mm_shuffle_epi32(blue, _MM_SHUFFLE(3, 2, 3, 2)), weights);
+
+	return _mm_unpacklo_epi64(low, high);
+}
+
+PIXEL_KERNELS_SSE2_TARGET
+static void apply_grayscale_sse2(uint32_t *pixels, const size_t pixel_count)
+{
+	const __m128i byte_mask = _mm_set1_epi32(0xFF);
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(alpha_mask));
+	static constexpr std::array<double, 3> weights = { gray_red_weight, gray_green_weight, gray_blue_weight };
+
+	size_t i = 0;
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i *pixel_ptr = reinterpret_cast<__m128i *>(pixels + i);
+		const __m128i pixel = _mm_loadu_si128(pixel_ptr);
+
+		const __m128i red = _mm_and_si128(pixel, byte_mask);
+		const __m128i green = _mm_and_si128(_mm_srli_epi32(pixel, 8), byte_mask);
+		const __m128i blue = _mm_and_si128(_mm_srli_epi32(pixel, 16), byte_mask);
+
+		const __m128i gray = weighted_sum_sse2(red, green, blue, weights);
+		const __m128i result = _mm_or_si128(_mm_or_si128(_mm_and_si128(pixel, alpha), gray), _mm_or_si128(_mm_slli_epi32(gray, 8), _mm_slli_epi32(gray, 16)));
+
+		_mm_storeu_si128(pixel_ptr, result);
+	}
+
+	apply_grayscale_scalar(pixels + i, pixel_count - i);
+}
+
+PIXEL_KERNELS_SSE2_TARGET
+static void apply_sepia_sse2(uint32_t *pixels, const size_t pixel_count)
+{
+	const __m128i byte_mask = _mm_set1_epi32(0xFF);
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(alpha_mask));
+	const __m128i max_value = _mm_set1_epi32(255);
+
+	size_t i = 0;
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i *pixel_ptr = reinterpret_cast<__m128i *>(pixels + i);
+		const __m128i pixel = _mm_loadu_si128(pixel_ptr);
+
+		const __m128i red = _mm_and_si128(pixel, byte_mask);
+		const __m128i green = _mm_and_si128(_mm_srli_epi32(pixel, 8), byte_mask);
+		const __m128i blue = _mm_and_si128(_mm_srli_epi32(pixel, 16), byte_mask);
+
+		__m128i result = _mm_and_si128(pixel, alpha);
+
+		for (size_t j = 0; j < sepia_weights.size(); ++j) {
+			__m128i value = weighted_sum_sse2(red, green, blue, sepia_weights[j]);
+
+			//SSE2 has no 32-bit integer minimum, so clamp with a comparison mask
+			const __m128i over_max = _mm_cmpgt_epi32(value, max_value);
+			value = _mm_or_si128(_mm_andnot_si128(over_max, value), _mm_and_si128(over_max, max_value));
+
+			result = _mm_or_si128(result, _mm_sll_epi32(value, _mm_cvtsi32_si128(static_cast<int>(j * 8))));
+		}
+
+		_mm_storeu_si128(pixel_ptr, result);
+	}
+
+	apply_sepia_scalar(pixels + i, pixel_count - i);
+}
+
+//get the per-channel saturating addition and subtraction values which together produce a clamped addition of the changes
+static std::pair<uint32_t, uint32_t> get_rgb_change_saturation_values(const short red_change, const short green_change, const short blue_change)
+{
+	uint32_t addition = 0;
+	uint32_t subtraction = 0;
+
+	const std::array<int, 3> changes = { red_change, green_change, blue_change };
+	for (size_t i = 0; i < changes.size(); ++i) {
+		addition |= static_cast<uint32_t>(std::clamp(changes[i], 0, 255)) << (i * 8);
+		subtraction |= static_cast<uint32_t>(std::clamp(-changes[i], 0, 255)) << (i * 8);
+	}
+
+	return { addition, subtraction };
+}
+
+PIXEL_KERNELS_SSE2_TARGET
+static void apply_rgb_change_sse2(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change)
+{
+	const auto [addition_value, subtraction_value] = get_rgb_change_saturation_values(red_change, green_change, blue_change);
+	const __m128i addition = _mm_set1_epi32(static_cast<int>(addition_value));
+	const __m128i subtraction = _mm_set1_epi32(static_cast<int>(subtraction_value));
+
+	size_t i = 0;
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i *pixel_ptr = reinterpret_cast<__m128i *>(pixels + i);
+		const __m128i pixel = _mm_loadu_si128(pixel_ptr);
+		_mm_storeu_si128(pixel_ptr, _mm_subs_epu8(_mm_adds_epu8(pixel, addition), subtraction));
+	}
+
+	apply_rgb_change_scalar(pixels + i, pixel_count - i, red_change, green_change, blue_change);
+}
+
+PIXEL_KERNELS_SSE2_TARGET
+static void apply_color_swaps_sse2(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps)
+{
+	const __m128i rgb = _mm_set1_epi32(static_cast<int>(rgb_mask));
+	const __m128i alpha = _mm_set1_epi32(static_cast<int>(alpha_mask));
+
+	size_t i = 0;
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i *pixel_ptr = reinterpret_cast<__m128i *>(pixels + i);
+		const __m128i pixel = _mm_loadu_si128(pixel_ptr);
+		const __m128i pixel_rgb = _mm_and_si128(pixel, rgb);
+		const __m128i pixel_alpha = _mm_and_si128(pixel, alpha);
+
+		__m128i result = pixel;
+
+		for (const color_swap &swap : color_swaps) {
+			const __m128i match = _mm_cmpeq_epi32(pixel_rgb, _mm_set1_epi32(static_cast<int>(swap.rgb)));
+			const __m128i swapped = _mm_or_si128(pixel_alpha, _mm_set1_epi32(static_cast<int>(swap.new_rgb)));
+			result = _mm_or_si128(_mm_andnot_si128(match, result), _mm_and_si128(match, swapped));
+		}
+
+		_mm_storeu_si128(pixel_ptr, result);
+	}
+
+	apply_color_swaps_scalar(pixels + i, pixel_count - i, color_swaps);
+}
+
+//calculate the weighted sum of the channel values of four pixels, truncated to integers
+PIXEL_KERNELS_AVX2_TARGET
+static inline __m128i weighted_quad_sum_avx2(const __m128i red, const __m128i green, const __m128i blue, const std::array<double, 3> &weights)
+{
+	const __m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(red), _mm256_set1_pd(weights[0])), _mm256_mul_pd(_mm256_cvtepi32_pd(green), _mm256_set1_pd(weights[1]))), _mm256_mul_pd(_mm256_cvtepi32_pd(blue), _mm256_set1_pd(weights[2])));
+	return _mm256_cvttpd_epi32(sum);
+}
+
+//calculate the weighted sum of the channel values of eight pixels, truncated to integers
+PIXEL_KERNELS_AVX2_TARGET
+static inline __m256i weighted_sum_avx2(const __m256i red, const __m256i green, const __m256i blue, const std::array<double, 3> &weights)
+{
+	const __m128i low = weighted_quad_sum_avx2(_mm256_castsi256_si128(red), _mm256_castsi256_si128(green), _mm256_castsi256_si128(blue), weights);
+	const __m128i high = weighted_quad_sum_avx2(_mm256_extracti128_si256(red, 1), _mm256_extracti128_si256(green, 1), _mm256_extracti128_si256(blue, 1), weights);
+
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+PIXEL_KERNELS_AVX2_TARGET
+static void apply_grayscale_avx2(uint32_t *pixels, const size_t pixel_count)
+{
+	const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(alpha_mask));
+	static constexpr std::array<double, 3> weights = { gray_red_weight, gray_green_weight, gray_blue_weight };
+
+	size_t i = 0;
+	for (; i + 8 <= pixel_count; i += 8) {
+		__m256i *pixel_ptr = reinterpret_cast<__m256i *>(pixels + i);
+		const __m256i pixel = _mm256_loadu_si256(pixel_ptr);
+
+		const __m256i red = _mm256_and_si256(pixel, byte_mask);
+		const __m256i green = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), byte_mask);
+		const __m256i blue = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), byte_mask);
+
+		const __m256i gray = weighted_sum_avx2(red, green, blue, weights);
+		const __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(pixel, alpha), gray), _mm256_or_si256(_mm256_slli_epi32(gray, 8), _mm256_slli_epi32(gray, 16)));
+
+		_mm256_storeu_si256(pixel_ptr, result);
+	}
+
+	apply_grayscale_scalar(pixels + i, pixel_count - i);
+}
+
+PIXEL_KERNELS_AVX2_TARGET
+static void apply_sepia_avx2(uint32_t *pixels, const size_t pixel_count)
+{
+	const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(alpha_mask));
+	const __m256i max_value = _mm256_set1_epi32(255);
+
+	size_t i = 0;
+	for (; i + 8 <= pixel_count; i += 8) {
+		__m256i *pixel_ptr = reinterpret_cast<__m256i *>(pixels + i);
+		const __m256i pixel = _mm256_loadu_si256(pixel_ptr);
+
+		const __m256i red = _mm256_and_si256(pixel, byte_mask);
+		const __m256i green = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), byte_mask);
+		const __m256i blue = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), byte_mask);
+
+		__m256i result = _mm256_and_si256(pixel, alpha);
+
+		for (size_t j = 0; j < sepia_weights.size(); ++j) {
+			const __m256i value = _mm256_min_epi32(weighted_sum_avx2(red, green, blue, sepia_weights[j]), max_value);
+			result = _mm256_or_si256(result, _mm256_sll_epi32(value, _mm_cvtsi32_si128(static_cast<int>(j * 8))));
+		}
+
+		_mm256_storeu_si256(pixel_ptr, result);
+	}
+
+	apply_sepia_scalar(pixels + i, pixel_count - i);
+}
+
+PIXEL_KERNELS_AVX2_TARGET
+static void apply_rgb_change_avx2(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change)
+{
+	const auto [addition_value, subtraction_value] = get_rgb_change_saturation_values(red_change, green_change, blue_change);
+	const __m256i addition = _mm256_set1_epi32(static_cast<int>(addition_value));
+	const __m256i subtraction = _mm256_set1_epi32(static_cast<int>(subtraction_value));
+
+	size_t i = 0;
+	for (; i + 8 <= pixel_count; i += 8) {
+		__m256i *pixel_ptr = reinterpret_cast<__m256i *>(pixels + i);
+		const __m256i pixel = _mm256_loadu_si256(pixel_ptr);
+		_mm256_storeu_si256(pixel_ptr, _mm256_subs_epu8(_mm256_adds_epu8(pixel, addition), subtraction));
+	}
+
+	apply_rgb_change_scalar(pixels + i, pixel_count - i, red_change, green_change, blue_change);
+}
+
+PIXEL_KERNELS_AVX2_TARGET
+static void apply_color_swaps_avx2(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps)
+{
+	const __m256i rgb = _mm256_set1_epi32(static_cast<int>(rgb_mask));
+	const __m256i alpha = _mm256_set1_epi32(static_cast<int>(alpha_mask));
+
+	size_t i = 0;
+	for (; i + 8 <= pixel_count; i += 8) {
+		__m256i *pixel_ptr = reinterpret_cast<__m256i *>(pixels + i);
+		const __m256i pixel = _mm256_loadu_si256(pixel_ptr);
+		const __m256i pixel_rgb = _mm256_and_si256(pixel, rgb);
+
+		const __m256i pixel_alpha = _mm256_and_si256(pixel, alpha);
+		__m256i result = pixel;
+
+		for (const color_swap &swap : color_swaps) {
+			const __m256i match = _mm256_cmpeq_epi32(pixel_rgb, _mm256_set1_epi32(static_cast<int>(swap.rgb)));
+			const __m256i swapped = _mm256_or_si256(pixel_alpha, _mm256_set1_epi32(static_cast<int>(swap.new_rgb)));
+			result = _mm256_blendv_epi8(result, swapped, match);
+		}
+
+		_mm256_storeu_si256(pixel_ptr, result);
+	}
+
+	apply_color_swaps_scalar(pixels + i, pixel_count - i, color_swaps);
+}
+
+static simd_level detect_simd_level()
+{
+#ifdef _MSC_VER
+	std::array<int, 4> cpu_info{};
+	__cpuid(cpu_info.data(), 0);
+	const int max_leaf = cpu_info[0];
+
+	__cpuid(cpu_info.data(), 1);
+	const bool has_sse2 = (cpu_info[3] & (1 << 26)) != 0;
+	const bool has_os_avx_support = (cpu_info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+	if (max_leaf >= 7 && has_os_avx_support) {
+		__cpuidex(cpu_info.data(), 7, 0);
+		if ((cpu_info[1] & (1 << 5)) != 0) {
+			return simd_level::avx2;
+		}
+	}
+
+	if (has_sse2) {
+		return simd_level::sse2;
+	}
+#else
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2")) {
+		return simd_level::avx2;
+	}
+
+	if (__builtin_cpu_supports("sse2")) {
+		return simd_level::sse2;
+	}
+#endif
+
+	return simd_level::scalar;
+}
+
+#endif
+
+simd_level get_supported_simd_level()
+{
+#ifdef PIXEL_KERNELS_X86
+	static const simd_level level = detect_simd_level();
+	return level;
+#else
+	return simd_level::scalar;
+#endif
+}
+
+const char *get_simd_level_name(const simd_level level)
+{
+	switch (level) {
+		case simd_level::scalar:
+			return "scalar";
+		case simd_level::sse2:
+			return "SSE2";
+		case simd_level::avx2:
+			return "AVX2";
+	}
+
+	return "";
+}
+
+void apply_grayscale(uint32_t *pixels, const size_t pixel_count, const simd_level level)
+{
+#ifdef PIXEL_KERNELS_X86
+	switch (level) {
+		case simd_level::avx2:
+			apply_grayscale_avx2(pixels, pixel_count);
+			return;
+		case simd_level::sse2:
+			apply_grayscale_sse2(pixels, pixel_count);
+			return;
+		default:
+			break;
+	}
+#endif
+
+	apply_grayscale_scalar(pixels, pixel_count);
+}
+
+void apply_sepia(uint32_t *pixels, const size_t pixel_count, const simd_level level)
+{
+#ifdef PIXEL_KERNELS_X86
+	switch (level) {
+		case simd_level::avx2:
+			apply_sepia_avx2(pixels, pixel_count);
+			return;
+		case simd_level::sse2:
+			apply_sepia_sse2(pixels, pixel_count);
+			return;
+		default:
+			break;
+	}
+#endif
+
+	apply_sepia_scalar(pixels, pixel_count);
+}
+
+void apply_rgb_change(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change, const simd_level level)
+{
+#ifdef PIXEL_KERNELS_X86
+	switch (level) {
+		case simd_level::avx2:
+			apply_rgb_change_avx2(pixels, pixel_count, red_change, green_change, blue_change);
+			return;
+		case simd_level::sse2:
+			apply_rgb_change_sse2(pixels, pixel_count, red_change, green_change, blue_change);
+			return;
+		default:
+			break;
+	}
+#endif
+
+	apply_rgb_change_scalar(pixels, pixel_count, red_change, green_change, blue_change);
+}
+
+void apply_color_swaps(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps, const simd_level level)
+{
+	if (color_swaps.empty()) {
+		return;
+	}
+
+#ifdef PIXEL_KERNELS_X86
+	switch (level) {
+		case simd_level::avx2:
+			apply_color_swaps_avx2(pixels, pixel_count, color_swaps);
+			return;
+		case simd_level::sse2:
+			apply_color_swaps_sse2(pixels, pixel_count, color_swaps);
+			return;
+		default:
+			break;
+	}
+#endif
+
+	apply_color_swaps_scalar(pixels, pixel_count, color_swaps);
+}
+
+}
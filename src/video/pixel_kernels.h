@@ -0,0 +1,80 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+namespace wyrmgus::pixel_kernels {
+
+//the instruction set used for the pixel kernels; the best one supported by the CPU is chosen at runtime
+enum class simd_level {
+	scalar,
+	sse2,
+	avx2
+};
+
+//a replacement of a pixel's RGB value, with the alpha value being kept
+struct color_swap final
+{
+	uint32_t rgb = 0; //the RGB value to be replaced, in the RGBA8888 byte order (i.e. with red as the lowest byte)
+	uint32_t new_rgb = 0;
+};
+
+//the kernels operate on RGBA8888 pixels, and produce exactly the same output regardless of the SIMD level
+
+extern simd_level get_supported_simd_level();
+extern const char *get_simd_level_name(const simd_level level);
+
+extern void apply_grayscale(uint32_t *pixels, const size_t pixel_count, const simd_level level);
+extern void apply_sepia(uint32_t *pixels, const size_t pixel_count, const simd_level level);
+
+//add the changes to the RGB values of the pixels, clamping the results to the 0-255 range
+extern void apply_rgb_change(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change, const simd_level level);
+
+//replace the RGB values of pixels according to a palette swap table; the RGB values to be replaced must be unique in the table
+extern void apply_color_swaps(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps, const simd_level level);
+
+inline void apply_grayscale(uint32_t *pixels, const size_t pixel_count)
+{
+	apply_grayscale(pixels, pixel_count, get_supported_simd_level());
+}
+
+inline void apply_sepia(uint32_t *pixels, const size_t pixel_count)
+{
+	apply_sepia(pixels, pixel_count, get_supported_simd_level());
+}
+
+inline void apply_rgb_change(uint32_t *pixels, const size_t pixel_count, const short red_change, const short green_change, const short blue_change)
+{
+	apply_rgb_change(pixels, pixel_count, red_change, green_change, blue_change, get_supported_simd_level());
+}
+
+inline void apply_color_swaps(uint32_t *pixels, const size_t pixel_count, const std::vector<color_swap> &color_swaps)
+{
+	apply_color_swaps(pixels, pixel_count, color_swaps, get_supported_simd_level());
+}
+
+}
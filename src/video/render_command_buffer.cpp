@@ -0,0 +1,164 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/render_command_buffer.h"
+
+#include "video/renderer.h"
+#include "video/video.h"
+
+namespace wyrmgus {
+
+void render_command_buffer::add_texture_frame(CGraphic *graphic, const int frame_index, const QPoint &pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent)
+{
+	const int color_modification_index = this->add_color_modification(color_modification);
+
+	command &command = this->add_command(render_command_type::texture_frame);
+	command.graphic = graphic;
+	command.frame_index = frame_index;
+	command.pos = pos;
+	command.color_modification_index = color_modification_index;
+	command.grayscale = grayscale;
+	command.flip = flip;
+	command.opacity = opacity;
+	command.show_percent = show_percent;
+}
+
+void render_command_buffer::add_texture_rect(CGraphic *graphic, const QRect &rect, const QPoint &pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity)
+{
+	const int color_modification_index = this->add_color_modification(color_modification);
+
+	command &command = this->add_command(render_command_type::texture_rect);
+	command.graphic = graphic;
+	command.source_pos = rect.topLeft();
+	command.size = rect.size();
+	command.pos = pos;
+	command.color_modification_index = color_modification_index;
+	command.grayscale = grayscale;
+	command.opacity = opacity;
+}
+
+int render_command_buffer::add_color_modification(const color_modification &color_modification)
+{
+	if (color_modification.is_null()) {
+		return -1;
+	}
+
+	//consecutive draws often use the same color modification (e.g. the frames of units of the same player), so reuse the last one if it is equal
+	if (!this->color_modifications.empty()) {
+		const wyrmgus::color_modification &last_color_modification = this->color_modifications.back();
+
+		if (!(last_color_modification < color_modification) && !(color_modification < last_color_modification)) {
+			return static_cast<int>(this->color_modifications.size()) - 1;
+		}
+	}
+
+	if (this->color_modifications.size() == this->color_modifications.capacity()) {
+		++this->allocation_count;
+	}
+
+	this->color_modifications.push_back(color_modification);
+	return static_cast<int>(this->color_modifications.size()) - 1;
+}
+
+render_command_buffer::statistics render_command_buffer::run(renderer *renderer) const
+{
+	static const color_modification null_color_modification;
+
+	statistics run_statistics;
+	run_statistics.command_count = this->commands.size();
+	run_statistics.custom_command_count = this->custom_commands.size();
+	run_statistics.allocation_count = this->allocation_count;
+
+	bool in_texture_batch = false;
+
+	for (const command &command : this->commands) {
+		const bool is_texture_command = command.type == render_command_type::texture || command.type == render_command_type::texture_frame || command.type == render_command_type::texture_rect;
+
+		if (is_texture_command != in_texture_batch) {
+			if (is_texture_command) {
+				renderer->begin_texture_batch();
+				++run_statistics.texture_batch_count;
+			} else {
+				renderer->end_texture_batch();
+			}
+
+			in_texture_batch = is_texture_command;
+		}
+
+		switch (command.type) {
+			case render_command_type::texture: {
+				const QOpenGLTexture *texture = command.graphic->get_or_create_texture(null_color_modification, false);
+				const QSize graphic_size = command.graphic->get_size();
+				renderer->blit_texture_frame_in_batch(texture, command.pos, QPoint(0, 0), graphic_size, false, 255, 100, graphic_size);
+				break;
+			}
+			case render_command_type::texture_frame:
+			case render_command_type::texture_rect: {
+				const color_modification &color_modification = command.color_modification_index != -1 ? this->color_modifications[command.color_modification_index] : null_color_modification;
+				const QOpenGLTexture *texture = command.graphic->get_or_create_texture(color_modification, command.grayscale);
+
+				if (command.type == render_command_type::texture_frame) {
+					renderer->blit_texture_frame_in_batch(texture, command.pos, command.graphic->get_size(), command.frame_index, command.graphic->get_frame_size(), command.flip, command.opacity, command.show_percent);
+				} else {
+					renderer->blit_texture_frame_in_batch(texture, command.pos, command.source_pos, command.size, false, command.opacity, 100, command.size);
+				}
+				break;
+			}
+			case render_command_type::pixel:
+				renderer->draw_pixel(command.pos, QColor::fromRgba(command.color));
+				break;
+			case render_command_type::horizontal_line:
+				renderer->draw_horizontal_line(command.pos, command.size.width(), QColor::fromRgba(command.color));
+				break;
+			case render_command_type::vertical_line:
+				renderer->draw_vertical_line(command.pos, command.size.height(), QColor::fromRgba(command.color));
+				break;
+			case render_command_type::line:
+				renderer->draw_line(command.pos, command.source_pos, QColor::fromRgba(command.color));
+				break;
+			case render_command_type::rect:
+				renderer->draw_rect(command.pos, command.size, QColor::fromRgba(command.color));
+				break;
+			case render_command_type::filled_rect:
+				renderer->fill_rect(command.pos, command.size, QColor::fromRgba(command.color));
+				break;
+			case render_command_type::custom:
+				this->custom_commands[command.custom_command_index](renderer);
+				break;
+		}
+	}
+
+	if (in_texture_batch) {
+		renderer->end_texture_batch();
+	}
+
+	return run_statistics;
+}
+
+}
@@ -0,0 +1,203 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "video/color_modification.h"
+
+class CGraphic;
+
+namespace wyrmgus {
+
+class renderer;
+
+enum class render_command_type : uint8_t {
+	texture,
+	texture_frame,
+	texture_rect,
+	pixel,
+	horizontal_line,
+	vertical_line,
+	line,
+	rect,
+	filled_rect,
+	custom
+};
+
+//a buffer of render commands, which stores the common drawing operations as plain records instead of closures, and is reused from frame to frame to avoid reallocating its memory
+class render_command_buffer final
+{
+public:
+	//a render command record; only the fields relevant for its type are used
+	struct command final
+	{
+		render_command_type type = render_command_type::custom;
+		bool grayscale = false;
+		bool flip = false;
+		unsigned char opacity = 255;
+		int show_percent = 100;
+		int frame_index = 0;
+		int color_modification_index = -1; //the index of the color modification in the buffer, or -1 if there is none
+		int custom_command_index = -1;
+		CGraphic *graphic = nullptr;
+		QPoint pos;
+		QPoint source_pos; //the source position in the texture, or the end position for lines
+		QSize size; //the source size in the texture, the size of rectangles, or the length of horizontal and vertical lines
+		QRgb color = 0;
+	};
+
+	static_assert(std::is_trivially_copyable_v<command>);
+
+	//statistics about the commands of a frame
+	struct statistics final
+	{
+		size_t command_count = 0;
+		size_t custom_command_count = 0;
+		size_t texture_batch_count = 0; //the amount of runs of consecutive texture blits, each of which is drawn with a single bind of the texture blitter
+		size_t allocation_count = 0; //the amount of heap allocations made by the buffer when adding commands, including those for closures
+	};
+
+	void add_texture(CGraphic *graphic, const QPoint &pos)
+	{
+		command &command = this->add_command(render_command_type::texture);
+		command.graphic = graphic;
+		command.pos = pos;
+	}
+
+	void add_texture_frame(CGraphic *graphic, const int frame_index, const QPoint &pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent);
+	void add_texture_rect(CGraphic *graphic, const QRect &rect, const QPoint &pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity);
+
+	void add_pixel(const QPoint &pos, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::pixel);
+		command.pos = pos;
+		command.color = color.rgba();
+	}
+
+	void add_horizontal_line(const QPoint &pos, const int width, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::horizontal_line);
+		command.pos = pos;
+		command.size = QSize(width, 1);
+		command.color = color.rgba();
+	}
+
+	void add_vertical_line(const QPoint &pos, const int height, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::vertical_line);
+		command.pos = pos;
+		command.size = QSize(1, height);
+		command.color = color.rgba();
+	}
+
+	void add_line(const QPoint &start_pos, const QPoint &end_pos, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::line);
+		command.pos = start_pos;
+		command.source_pos = end_pos;
+		command.color = color.rgba();
+	}
+
+	void add_rect(const QPoint &pos, const QSize &size, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::rect);
+		command.pos = pos;
+		command.size = size;
+		command.color = color.rgba();
+	}
+
+	void add_filled_rect(const QPoint &pos, const QSize &size, const QColor &color)
+	{
+		command &command = this->add_command(render_command_type::filled_rect);
+		command.pos = pos;
+		command.size = size;
+		command.color = color.rgba();
+	}
+
+	//add a custom command, for drawing operations which have no record type
+	void push_back(std::function<void(renderer *)> &&function)
+	{
+		if (this->custom_commands.size() == this->custom_commands.capacity()) {
+			++this->allocation_count;
+		}
+
+		//the closure may need a heap allocation of its own
+		++this->allocation_count;
+
+		command &command = this->add_command(render_command_type::custom);
+		command.custom_command_index = static_cast<int>(this->custom_commands.size());
+		this->custom_commands.push_back(std::move(function));
+	}
+
+	bool empty() const
+	{
+		return this->commands.empty();
+	}
+
+	size_t size() const
+	{
+		return this->commands.size();
+	}
+
+	const std::vector<command> &get_commands() const
+	{
+		return this->commands;
+	}
+
+	//clear the commands, keeping the allocated memory for the next frame
+	void clear()
+	{
+		this->commands.clear();
+		this->color_modifications.clear();
+		this->custom_commands.clear();
+		this->allocation_count = 0;
+	}
+
+	//run the commands, drawing consecutive texture blits as a batch; returns the statistics for the run
+	statistics run(renderer *renderer) const;
+
+private:
+	command &add_command(const render_command_type type)
+	{
+		if (this->commands.size() == this->commands.capacity()) {
+			++this->allocation_count;
+		}
+
+		command &command = this->commands.emplace_back();
+		command.type = type;
+		return command;
+	}
+
+	int add_color_modification(const color_modification &color_modification);
+
+	std::vector<command> commands;
+	std::vector<color_modification> color_modifications;
+	std::vector<std::function<void(renderer *)>> custom_commands;
+	size_t allocation_count = 0;
+};
+
+}
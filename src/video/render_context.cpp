@@ -37,10 +37,24 @@
 
 namespace wyrmgus {
 
-void render_context::set_commands(std::vector<std::function<void(renderer *)>> &&commands)
+render_command_buffer render_context::take_recycled_commands()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	render_command_buffer commands = std::move(this->recycled_commands);
+	commands.clear();
+	return commands;
+}
+
+void render_context::set_commands(render_command_buffer &&commands)
 {
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
+
+		//the commands of the previous frame are no longer needed, so keep them for their memory to be reused
+		if (!this->commands.empty()) {
+			this->recycled_commands = std::move(this->commands);
+		}
+
 		this->commands = std::move(commands);
 	}
 
@@ -49,18 +63,23 @@ void render_context::set_commands(std::vector<std::function<void(renderer *)>> &
 
 void render_context::run(renderer *renderer)
 {
-	std::vector<std::function<void(wyrmgus::renderer *)>> commands;
+	render_command_buffer commands;
 
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
 		commands = std::move(this->commands);
 	}
 
+	const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
 	//run the posted OpenGL commands
 	try {
-		for (const std::function<void(wyrmgus::renderer *)> &command : commands) {
-			command(renderer);
-		}
+		const render_command_buffer::statistics statistics = commands.run(renderer);
+		const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->last_frame_statistics = statistics;
+		this->last_frame_duration = duration;
 	} catch (const std::exception &exception) {
 		exception::report(exception);
 
@@ -71,9 +90,11 @@ void render_context::run(renderer *renderer)
 
 	{
 		std::lock_guard<std::mutex> lock(this->mutex);
-		//if no new commands have been set while we were rendering, store the old commands for being run again if necessary (e.g. if the window is resized)
+		//if no new commands have been set while we were rendering, store the old commands for being run again if necessary (e.g. if the window is resized); otherwise, keep them so that their memory can be reused for a new frame
 		if (this->commands.empty()) {
 			this->commands = std::move(commands);
+		} else {
+			this->recycled_commands = std::move(commands);
 		}
 	}
 
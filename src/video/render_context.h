@@ -27,6 +27,7 @@
 #pragma once
 
 #include "util/singleton.h"
+#include "video/render_command_buffer.h"
 
 namespace wyrmgus {
 
@@ -36,17 +37,36 @@ class renderer;
 class render_context final : public singleton<render_context>
 {
 public:
-	void set_commands(std::vector<std::function<void(renderer *)>> &&commands);
+	//get a buffer to record the commands of a new frame in, reusing the memory of a previously rendered frame if possible
+	render_command_buffer take_recycled_commands();
+
+	void set_commands(render_command_buffer &&commands);
 
 	void run(renderer *renderer);
 
 	void set_free_texture_commands(std::vector<std::function<void()>> &&commands);
 	void run_free_texture_commands();
 
+	//get the statistics of the last rendered frame
+	render_command_buffer::statistics get_last_frame_statistics() const
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->last_frame_statistics;
+	}
+
+	std::chrono::microseconds get_last_frame_duration() const
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->last_frame_duration;
+	}
+
 private:
-	std::vector<std::function<void(renderer *)>> commands;
+	render_command_buffer commands;
+	render_command_buffer recycled_commands;
+	render_command_buffer::statistics last_frame_statistics;
+	std::chrono::microseconds last_frame_duration{};
 	std::vector<std::function<void()>> free_texture_commands;
-	std::mutex mutex;
+	mutable std::mutex mutex;
 };
 
 }
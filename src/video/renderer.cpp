@@ -112,11 +112,23 @@ void renderer::reset_opengl()
 	this->fbo->window()->resetOpenGLState();
 }
 
-void renderer::blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QPoint &frame_pixel_pos, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent, const QSize &rendered_size)
+void renderer::begin_texture_batch()
 {
 	this->painter->beginNativePainting();
 	this->setup_native_opengl_state();
 
+	this->blitter.bind();
+}
+
+void renderer::end_texture_batch()
+{
+	this->blitter.release();
+
+	this->painter->endNativePainting();
+}
+
+void renderer::blit_texture_frame_in_batch(const QOpenGLTexture *texture, const QPoint &pos, const QPoint &frame_pixel_pos, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent, const QSize &rendered_size)
+{
 	const QSize target_size = this->get_target_size();
 
 	QRect source_rect;
@@ -140,8 +152,6 @@ void renderer::blit_texture_frame(const QOpenGLTexture *texture, const QPoint &p
 	const QRect target_rect(this->get_mirrored_pos(pos, source_rendered_size), source_rendered_size);
 	const QMatrix4x4 target = QOpenGLTextureBlitter::targetTransform(target_rect, QRect(QPoint(0, 0), target_size));
 
-	this->blitter.bind();
-
 	if (opacity != 255) {
 		this->blitter.setOpacity(opacity / 255.0);
 	}
@@ -151,18 +161,14 @@ void renderer::blit_texture_frame(const QOpenGLTexture *texture, const QPoint &p
 	if (opacity != 255) {
 		this->blitter.setOpacity(1.0);
 	}
-
-	this->blitter.release();
-
-	this->painter->endNativePainting();
 }
 
-void renderer::blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const int frame_index, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent)
+void renderer::blit_texture_frame_in_batch(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const int frame_index, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent)
 {
 	const int frames_per_row = size.width() / frame_size.width();
 	const QPoint frame_pos = point::from_index(frame_index, frames_per_row);
 	const QPoint frame_pixel_pos(frame_pos.x() * frame_size.width(), frame_pos.y() * frame_size.height());
-	this->blit_texture_frame(texture, pos, frame_pixel_pos, frame_size, flip, opacity, show_percent, frame_size);
+	this->blit_texture_frame_in_batch(texture, pos, frame_pixel_pos, frame_size, flip, opacity, show_percent, frame_size);
 }
 
 void renderer::draw_image(const QImage &image, const QPoint &pos)
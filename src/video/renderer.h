@@ -85,8 +85,27 @@ public:
 		glDisable(GL_DEPTH_TEST);
 	}
 
-	void blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QPoint &frame_pixel_pos, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent, const QSize &rendered_size);
-	void blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const int frame_index, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent);
+	void blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QPoint &frame_pixel_pos, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent, const QSize &rendered_size)
+	{
+		this->begin_texture_batch();
+		this->blit_texture_frame_in_batch(texture, pos, frame_pixel_pos, frame_size, flip, opacity, show_percent, rendered_size);
+		this->end_texture_batch();
+	}
+
+	void blit_texture_frame(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const int frame_index, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent)
+	{
+		this->begin_texture_batch();
+		this->blit_texture_frame_in_batch(texture, pos, size, frame_index, frame_size, flip, opacity, show_percent);
+		this->end_texture_batch();
+	}
+
+	//begin a batch of texture blits, switching to native painting and binding the texture blitter only once for all of them
+	void begin_texture_batch();
+	void end_texture_batch();
+
+	//blit a texture frame; must be called between beginning and ending a texture batch
+	void blit_texture_frame_in_batch(const QOpenGLTexture *texture, const QPoint &pos, const QPoint &frame_pixel_pos, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent, const QSize &rendered_size);
+	void blit_texture_frame_in_batch(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const int frame_index, const QSize &frame_size, const bool flip, const unsigned char opacity, const int show_percent);
 
 	void blit_texture(const QOpenGLTexture *texture, const QPoint &pos, const QSize &size, const bool flip, const unsigned char opacity, const QSize &rendered_size)
 	{
@@ -90,6 +90,7 @@
 #include "util/assert_util.h"
 #include "util/image_util.h"
 #include "video/font.h"
+#include "video/render_command_buffer.h"
 
 #include <SDL.h>
 
@@ -202,7 +203,7 @@ void PopClipping()
 */
 void CVideo::ClearScreen()
 {
-	std::vector<std::function<void(renderer *)>> render_commands;
+	render_command_buffer render_commands;
 	FillRectangle(ColorBlack, 0, 0, Video.Width, Video.Height, render_commands);
 
 	//FIXME: do something with the render commands, or remove this function altogether
@@ -43,6 +43,7 @@ namespace wyrmgus {
 	class font;
 	class map_template;
 	class player_color;
+	class render_command_buffer;
 	class renderer;
 	class time_of_day;
 }
@@ -82,59 +83,59 @@ public:
 	virtual ~CGraphic();
 
 	// Draw
-	void DrawClip(int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawSub(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawGrayscaleSub(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawSubClip(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawGrayscaleSubClip(int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawSubTrans(int gx, int gy, int w, int h, int x, int y, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawSubClipTrans(int gx, int gy, int w, int h, int x, int y, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawClip(int x, int y, render_command_buffer &render_commands);
+	void DrawSub(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawGrayscaleSub(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawSubClip(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawGrayscaleSubClip(int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawSubTrans(int gx, int gy, int w, int h, int x, int y, unsigned char alpha, render_command_buffer &render_commands);
+	void DrawSubClipTrans(int gx, int gy, int w, int h, int x, int y, unsigned char alpha, render_command_buffer &render_commands);
 
 	// Draw frame
-	void DrawFrame(unsigned frame, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawFrame(unsigned frame, int x, int y, render_command_buffer &render_commands);
 
-	void DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands);
 
-	void DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClip(const unsigned frame, const int x, const int y, const time_of_day *time_of_day, render_command_buffer &render_commands)
 	{
 		this->DrawFrameClip(frame, x, y, time_of_day, 100, render_commands);
 	}
 
-	void DrawFrameClip(const unsigned frame, const int x, const int y, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClip(const unsigned frame, const int x, const int y, render_command_buffer &render_commands)
 	{
 		this->DrawFrameClip(frame, x, y, nullptr, render_commands);
 	}
 
-	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands);
 
-	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands)
 	{
 		this->DrawFrameClipTrans(frame, x, y, alpha, time_of_day, 100, render_commands);
 	}
 
-	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClipTrans(const unsigned frame, const int x, const int y, const int alpha, render_command_buffer &render_commands)
 	{
 		this->DrawFrameClipTrans(frame, x, y, alpha, nullptr, render_commands);
 	}
 
-	void DrawGrayscaleFrameClip(unsigned frame, int x, int y, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawGrayscaleFrameClip(unsigned frame, int x, int y, int show_percent, render_command_buffer &render_commands);
 
-	void DrawGrayscaleFrameClip(unsigned frame, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawGrayscaleFrameClip(unsigned frame, int x, int y, render_command_buffer &render_commands)
 	{
 		this->DrawGrayscaleFrameClip(frame, x, y, 100, render_commands);
 	}
 
 	// Draw frame flipped horizontally
-	void DrawFrameClipX(unsigned frame, int x, int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawFrameClipX(unsigned frame, int x, int y, const time_of_day *time_of_day, render_command_buffer &render_commands);
 
-	void DrawFrameClipX(unsigned frame, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClipX(unsigned frame, int x, int y, render_command_buffer &render_commands)
 	{
 		this->DrawFrameClipX(frame, x, y, nullptr, render_commands);
 	}
 
-	void DrawFrameClipTransX(unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawFrameClipTransX(unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands);
 
-	void DrawFrameClipTransX(unsigned frame, int x, int y, int alpha, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawFrameClipTransX(unsigned frame, int x, int y, int alpha, render_command_buffer &render_commands)
 	{
 		return this->DrawFrameClipTransX(frame, x, y, alpha, nullptr, render_commands);
 	}
@@ -158,7 +159,7 @@ public:
 
 	bool IsLoaded() const
 	{
-		return !this->image.isNull();
+		return this->loaded;
 	}
 
 	const std::filesystem::path &get_filepath() const
@@ -249,6 +250,22 @@ public:
 
 	QImage create_modified_image(const color_modification &color_modification, const bool grayscale) const;
 
+private:
+	QImage create_modified_image_uncached(const color_modification &color_modification, const bool grayscale) const;
+
+	//get the hash of the image's content, which is computed when first needed
+	const QByteArray &get_image_hash() const;
+
+	void clear_image_hash()
+	{
+		std::lock_guard lock(this->image_hash_mutex);
+		this->image_hash.clear();
+	}
+
+	QByteArray get_modified_image_cache_key(const color_modification &color_modification, const bool grayscale) const;
+
+public:
+
 	const QImage *get_frame_image(const size_t frame_index, const color_modification &color_modification = {}, const bool grayscale = false) const
 	{
 		if (grayscale) {
@@ -342,38 +359,38 @@ public:
 
 	void create_texture(const color_modification &color_modification, const bool grayscale);
 
-	void render(const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands);
+	void render(const QPoint &pixel_pos, render_command_buffer &render_commands);
 
-	void render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, render_command_buffer &render_commands);
 
-	void render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, std::vector<std::function<void(renderer *)>> &render_commands)
+	void render_frame(const int frame_index, const QPoint &pixel_pos, const color_modification &color_modification, render_command_buffer &render_commands)
 	{
 		this->render_frame(frame_index, pixel_pos, color_modification, false, false, 255, 100, render_commands);
 	}
 
-	void render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool grayscale, const bool flip, const unsigned char opacity, const int show_percent, render_command_buffer &render_commands);
 
-	void render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+	void render_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, render_command_buffer &render_commands)
 	{
 		this->render_frame(frame_index, pixel_pos, player_color, time_of_day, false, false, 255, 100, render_commands);
 	}
 
-	void render_frame(const int frame_index, const QPoint &pixel_pos, std::vector<std::function<void(renderer *)>> &render_commands)
+	void render_frame(const int frame_index, const QPoint &pixel_pos, render_command_buffer &render_commands)
 	{
 		this->render_frame(frame_index, pixel_pos, nullptr, nullptr, render_commands);
 	}
 
-	void render_player_color_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool flip, const unsigned char opacity, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+	void render_player_color_frame(const int frame_index, const QPoint &pixel_pos, const player_color *player_color, const time_of_day *time_of_day, const bool flip, const unsigned char opacity, const int show_percent, render_command_buffer &render_commands)
 	{
 		this->render_frame(frame_index, pixel_pos, player_color, time_of_day, false, flip, opacity, show_percent, render_commands);
 	}
 
-	void render_grayscale_frame(const int frame_index, const QPoint &pixel_pos, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands)
+	void render_grayscale_frame(const int frame_index, const QPoint &pixel_pos, const int show_percent, render_command_buffer &render_commands)
 	{
 		this->render_frame(frame_index, pixel_pos, nullptr, nullptr, true, false, 255, show_percent, render_commands);
 	}
 
-	void render_rect(const QRect &rect, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity, std::vector<std::function<void(renderer *)>> &render_commands);
+	void render_rect(const QRect &rect, const QPoint &pixel_pos, const color_modification &color_modification, const bool grayscale, const unsigned char opacity, render_command_buffer &render_commands);
 
 	bool has_textures() const
 	{
@@ -414,6 +431,9 @@ private:
 	centesimal_int custom_scale_factor = centesimal_int(1); //the scale factor of the loaded image, if it is a custom scaled image
 	bool has_player_color_value = false;
 	std::mutex load_mutex;
+	std::atomic<bool> loaded = false; //set only once loading has finished, since graphics can be loaded in other threads while the game is running
+	mutable QByteArray image_hash; //the hash of the image's content, used for the keys of modified images in the image cache
+	mutable std::mutex image_hash_mutex;
 
 	friend wyrmgus::font;
 	friend int LoadGraphicPNG(CGraphic *g, const centesimal_int &scale_factor);
@@ -427,21 +447,21 @@ public:
 	{
 	}
 
-	void DrawPlayerColorSub(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawPlayerColorSubClip(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawPlayerColorFrameClipX(const player_color *player_color, unsigned frame, int x, int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawPlayerColorSub(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawPlayerColorSubClip(const color_modification &color_modification, int gx, int gy, int w, int h, int x, int y, render_command_buffer &render_commands);
+	void DrawPlayerColorFrameClipX(const player_color *player_color, unsigned frame, int x, int y, const time_of_day *time_of_day, render_command_buffer &render_commands);
 
-	void DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, const int show_percent, render_command_buffer &render_commands);
 
-	void DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawPlayerColorFrameClip(const player_color *player_color, const unsigned frame, const int x, const int y, const time_of_day *time_of_day, render_command_buffer &render_commands)
 	{
 		this->DrawPlayerColorFrameClip(player_color, frame, x, y, time_of_day, 100, render_commands);
 	}
 
-	void DrawPlayerColorFrameClipTransX(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, int show_percent, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawPlayerColorFrameClipTransX(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands);
+	void DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, int show_percent, render_command_buffer &render_commands);
 
-	void DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, std::vector<std::function<void(renderer *)>> &render_commands)
+	void DrawPlayerColorFrameClipTrans(const player_color *player_color, unsigned frame, int x, int y, int alpha, const time_of_day *time_of_day, render_command_buffer &render_commands)
 	{
 		this->DrawPlayerColorFrameClipTrans(player_color, frame, x, y, alpha, time_of_day, 100, render_commands);
 	}
@@ -487,21 +507,21 @@ public:
 	void ClearScreen();
 	bool ResizeScreen(int width, int height);
 
-	void DrawVLine(uint32_t color, int x, int y, int height, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawVLine(uint32_t color, int x, int y, int height, render_command_buffer &render_commands);
 
-	void DrawHLine(uint32_t color, int x, int y, int width, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawHLine(uint32_t color, int x, int y, int width, render_command_buffer &render_commands);
 
-	void DrawLine(uint32_t color, int sx, int sy, int dx, int dy, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawLineClip(uint32_t color, const PixelPos &pos1, const PixelPos &pos2, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawLine(uint32_t color, int sx, int sy, int dx, int dy, render_command_buffer &render_commands);
+	void DrawLineClip(uint32_t color, const PixelPos &pos1, const PixelPos &pos2, render_command_buffer &render_commands);
 
-	void DrawRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands);
-	void DrawRectangleClip(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands);
+	void DrawRectangle(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands);
+	void DrawTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands);
+	void DrawRectangleClip(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands);
 
-	void FillRectangle(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands);
-	void FillTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands);
-	void FillRectangleClip(uint32_t color, int x, int y, int w, int h, std::vector<std::function<void(renderer *)>> &render_commands);
-	void FillTransRectangleClip(uint32_t color, int x, int y, int w, int h, unsigned char alpha, std::vector<std::function<void(renderer *)>> &render_commands);
+	void FillRectangle(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands);
+	void FillTransRectangle(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands);
+	void FillRectangleClip(uint32_t color, int x, int y, int w, int h, render_command_buffer &render_commands);
+	void FillTransRectangleClip(uint32_t color, int x, int y, int w, int h, unsigned char alpha, render_command_buffer &render_commands);
 
 	static uint32_t MapRGB(const uint8_t r, const uint8_t g, const uint8_t b)
 	{
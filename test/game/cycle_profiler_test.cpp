@@ -0,0 +1,133 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "game/cycle_profiler.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(cycle_profiler_tests)
+
+using wyrmgus::cycle_profiler;
+using wyrmgus::cycle_profiler_stage;
+
+BOOST_AUTO_TEST_CASE(cycle_profiler_disabled_test)
+{
+	const std::unique_ptr<cycle_profiler> profiler = std::make_unique<cycle_profiler>();
+
+	//profiling is opt-in, so nothing must be recorded until it is enabled
+	BOOST_CHECK(!profiler->is_enabled());
+
+	profiler->begin_cycle(1);
+	profiler->add_stage_duration(cycle_profiler_stage::unit_actions, std::chrono::milliseconds(1));
+	profiler->end_cycle();
+
+	BOOST_CHECK(profiler->get_recorded_cycle_count() == 0);
+	BOOST_CHECK(profiler->get_stage_total_duration(cycle_profiler_stage::unit_actions) == std::chrono::nanoseconds(0));
+
+	//showing the overlay enables profiling
+	profiler->set_overlay_shown(true);
+	BOOST_CHECK(profiler->is_enabled());
+}
+
+BOOST_AUTO_TEST_CASE(cycle_profiler_record_test)
+{
+	const std::unique_ptr<cycle_profiler> profiler = std::make_unique<cycle_profiler>();
+	profiler->set_enabled(true);
+
+	profiler->begin_cycle(5);
+	profiler->add_stage_duration(cycle_profiler_stage::rescue_units, std::chrono::milliseconds(3));
+	profiler->add_stage_duration(cycle_profiler_stage::autosave, std::chrono::milliseconds(1));
+	profiler->add_stage_duration(cycle_profiler_stage::autosave, std::chrono::milliseconds(1));
+	profiler->end_cycle();
+
+	//stage durations added outside of a cycle are not recorded
+	profiler->add_stage_duration(cycle_profiler_stage::autosave, std::chrono::milliseconds(1));
+
+	const std::vector<cycle_profiler::cycle_record> history = profiler->get_history();
+	BOOST_REQUIRE(history.size() == 1);
+	BOOST_CHECK(history.front().cycle == 5);
+	BOOST_CHECK(history.front().stage_durations[static_cast<size_t>(cycle_profiler_stage::rescue_units)] == std::chrono::milliseconds(3));
+	BOOST_CHECK(history.front().stage_durations[static_cast<size_t>(cycle_profiler_stage::autosave)] == std::chrono::milliseconds(2));
+	BOOST_CHECK(profiler->get_stage_total_duration(cycle_profiler_stage::autosave) == std::chrono::milliseconds(2));
+
+	//2 ms fall in the bucket for durations of 1024 to 2047 microseconds
+	BOOST_CHECK(profiler->get_stage_histogram(cycle_profiler_stage::autosave)[11] == 1);
+
+	profiler->clear();
+	BOOST_CHECK(profiler->get_recorded_cycle_count() == 0);
+	BOOST_CHECK(profiler->get_history().empty());
+	BOOST_CHECK(profiler->get_stage_total_duration(cycle_profiler_stage::autosave) == std::chrono::nanoseconds(0));
+	BOOST_CHECK(profiler->get_stage_histogram(cycle_profiler_stage::autosave)[11] == 0);
+}
+
+BOOST_AUTO_TEST_CASE(cycle_profiler_history_test)
+{
+	const std::unique_ptr<cycle_profiler> profiler = std::make_unique<cycle_profiler>();
+	profiler->set_enabled(true);
+
+	static constexpr size_t cycle_count = cycle_profiler::history_size + 10;
+
+	for (size_t i = 1; i <= cycle_count; ++i) {
+		profiler->begin_cycle(static_cast<unsigned long>(i));
+		profiler->end_cycle();
+	}
+
+	//only the most recent cycles are kept, from oldest to newest
+	const std::vector<cycle_profiler::cycle_record> history = profiler->get_history();
+	BOOST_CHECK(profiler->get_recorded_cycle_count() == cycle_count);
+	BOOST_REQUIRE(!history.empty());
+	BOOST_CHECK(history.size() <= cycle_profiler::history_size);
+	BOOST_CHECK(history.back().cycle == cycle_count);
+
+	for (size_t i = 1; i < history.size(); ++i) {
+		BOOST_CHECK(history[i].cycle == history[i - 1].cycle + 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cycle_profiler_scoped_timer_test)
+{
+	cycle_profiler *profiler = cycle_profiler::get();
+	const bool was_enabled = profiler->is_enabled();
+
+	profiler->set_enabled(true);
+	profiler->clear();
+
+	profiler->begin_cycle(1);
+	{
+		wyrmgus::scoped_cycle_timer timer(cycle_profiler_stage::rescue_units);
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	profiler->end_cycle();
+
+	BOOST_CHECK(profiler->get_stage_total_duration(cycle_profiler_stage::rescue_units) >= std::chrono::milliseconds(2));
+
+	profiler->clear();
+	profiler->set_enabled(was_enabled);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
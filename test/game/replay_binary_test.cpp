@@ -0,0 +1,284 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "game/replay_binary.h"
+
+#include <boost/test/unit_test.hpp>
+
+using wyrmgus::binary_replay;
+using wyrmgus::replay_checkpoint;
+using wyrmgus::replay_command;
+using wyrmgus::save_container;
+
+namespace {
+
+constexpr size_t command_count = 20000;
+
+//commands similar to those of a long game, in which most commands are moves and attacks given to units or groups of units
+std::vector<replay_command> create_replay_commands()
+{
+	static const std::array<const char *, 6> actions = { "move", "attack", "stop", "build", "train", "research" };
+	static const std::array<const char *, 4> unit_idents = { "unit_dwarven_axefighter", "unit_dwarven_scout", "unit_dwarven_miner", "unit_dwarven_town_hall" };
+
+	std::vector<replay_command> commands;
+	commands.reserve(command_count);
+
+	uint32_t seed = 0x2545F491;
+	unsigned long game_cycle = 0;
+
+	for (size_t i = 0; i < command_count; ++i) {
+		seed = seed * 1103515245 + 12345;
+		const uint32_t random_value = seed >> 8;
+
+		replay_command command;
+		game_cycle += random_value % 40;
+		command.game_cycle = game_cycle;
+		command.action = actions[random_value % actions.size()];
+		command.unit_number = static_cast<int>((random_value >> 4) % 500);
+		command.unit_ident = unit_idents[(random_value >> 8) % unit_idents.size()];
+		command.flush = (random_value >> 10) % 2;
+
+		if (command.action == "move" || command.action == "attack" || command.action == "build") {
+			command.pos_x = static_cast<int>((random_value >> 12) % 256);
+			command.pos_y = static_cast<int>((random_value >> 14) % 256);
+		}
+
+		if (command.action == "attack" && (random_value % 3) == 0) {
+			command.dest_unit_number = static_cast<int>((random_value >> 16) % 500);
+		}
+
+		if (command.action == "build" || command.action == "train") {
+			command.value = unit_idents[(random_value >> 18) % unit_idents.size()];
+		} else if (command.action == "research") {
+			command.value = "upgrade_dwarven_broad_axe";
+		}
+
+		if ((command.action == "move" || command.action == "attack") && (random_value % 4) == 0) {
+			for (int j = 1; j <= static_cast<int>((random_value >> 20) % 12); ++j) {
+				command.group_unit_numbers.push_back(command.unit_number + j);
+			}
+		}
+
+		command.sync_rand_seed = seed;
+		commands.push_back(std::move(command));
+	}
+
+	return commands;
+}
+
+replay_checkpoint create_replay_checkpoint(const unsigned long game_cycle, const size_t command_index)
+{
+	std::string state;
+	for (int i = 0; i < 1000; ++i) {
+		state += "Unit(" + std::to_string(i) + ", {\"type\", \"unit_dwarven_axefighter\", \"cycle\", " + std::to_string(game_cycle) + "})\n";
+	}
+
+	replay_checkpoint checkpoint;
+	checkpoint.game_cycle = game_cycle;
+	checkpoint.command_index = command_index;
+	checkpoint.sync_hash = static_cast<unsigned>(game_cycle * 2654435761u);
+	checkpoint.sync_rand_seed = static_cast<unsigned>(command_index);
+	checkpoint.state = save_container::compress_chunk(state);
+	return checkpoint;
+}
+
+//write the commands as Lua log entries, omitting absent fields in the same way as the text replay log does
+std::string save_replay_commands_as_text(const std::vector<replay_command> &commands)
+{
+	std::string text;
+
+	for (const replay_command &command : commands) {
+		text += "Log( { GameCycle = " + std::to_string(command.game_cycle) + ", ";
+		if (command.unit_number != -1) {
+			text += "UnitNumber = " + std::to_string(command.unit_number) + ", ";
+		}
+		if (!command.group_unit_numbers.empty()) {
+			text += "GroupUnitNumbers = {";
+			for (size_t i = 0; i < command.group_unit_numbers.size(); ++i) {
+				text += (i != 0 ? ", " : "") + std::to_string(command.group_unit_numbers[i]);
+			}
+			text += "}, ";
+		}
+		if (!command.unit_ident.empty()) {
+			text += "UnitIdent = \"" + command.unit_ident + "\", ";
+		}
+		text += "Action = \"" + command.action + "\", ";
+		text += "Flush = " + std::to_string(command.flush) + ", ";
+		if (command.pos_x != -1 || command.pos_y != -1) {
+			text += "PosX = " + std::to_string(command.pos_x) + ", PosY = " + std::to_string(command.pos_y) + ", ";
+		}
+		if (command.dest_unit_number != -1) {
+			text += "DestUnitNumber = " + std::to_string(command.dest_unit_number) + ", ";
+		}
+		if (!command.value.empty()) {
+			text += "Value = [[" + command.value + "]], ";
+		}
+		if (command.num != -1) {
+			text += "Num = " + std::to_string(command.num) + ", ";
+		}
+		text += "SyncRandSeed = " + std::to_string(static_cast<int>(command.sync_rand_seed)) + " } )\n";
+	}
+
+	return text;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(binary_replay_roundtrip_test)
+{
+	const std::vector<replay_command> commands = create_replay_commands();
+
+	binary_replay replay;
+	replay.set_header("ReplayLog( { Comment1 = \"Test\" } )\n");
+
+	for (const replay_command &command : commands) {
+		replay.add_command(replay_command(command));
+	}
+
+	const std::vector<replay_checkpoint> checkpoints = {
+		create_replay_checkpoint(CYCLES_PER_SECOND * 60, 120),
+		create_replay_checkpoint(CYCLES_PER_SECOND * 120, 250)
+	};
+
+	for (const replay_checkpoint &checkpoint : checkpoints) {
+		replay.add_checkpoint(replay_checkpoint(checkpoint));
+	}
+
+	const std::string replay_data = replay.to_bytes();
+	BOOST_CHECK(binary_replay::is_binary_replay(replay_data));
+
+	binary_replay loaded_replay = binary_replay::from_bytes(replay_data);
+
+	//the replay must give exactly the same commands as before being encoded, so that playing it results in the same game
+	BOOST_CHECK(loaded_replay.get_header() == replay.get_header());
+	BOOST_CHECK(loaded_replay.get_commands() == commands);
+
+	const std::vector<replay_checkpoint> loaded_checkpoints = loaded_replay.take_checkpoints();
+	BOOST_REQUIRE(loaded_checkpoints.size() == checkpoints.size());
+
+	for (size_t i = 0; i < checkpoints.size(); ++i) {
+		BOOST_CHECK(loaded_checkpoints[i].game_cycle == checkpoints[i].game_cycle);
+		BOOST_CHECK(loaded_checkpoints[i].command_index == checkpoints[i].command_index);
+		BOOST_CHECK(loaded_checkpoints[i].sync_hash == checkpoints[i].sync_hash);
+		BOOST_CHECK(loaded_checkpoints[i].sync_rand_seed == checkpoints[i].sync_rand_seed);
+
+		std::string state;
+		std::string loaded_state;
+		save_container::decompress_chunk(checkpoints[i].state.data, checkpoints[i].state.uncompressed_size, state);
+		save_container::decompress_chunk(loaded_checkpoints[i].state.data, loaded_checkpoints[i].state.uncompressed_size, loaded_state);
+		BOOST_CHECK(loaded_state == state);
+	}
+
+	//a truncated replay must be rejected rather than partially loaded
+	BOOST_CHECK_THROW(binary_replay::from_bytes(std::string_view(replay_data).substr(0, replay_data.size() / 2)), std::runtime_error);
+
+	const std::string text = save_replay_commands_as_text(commands);
+	//the checkpoints have been taken from the loaded replay, so its data only consists of the header and commands
+	const std::string command_data = loaded_replay.to_bytes();
+	BOOST_TEST_MESSAGE("Binary replay (" << commands.size() << " commands): text log " << text.size() << " bytes, binary " << command_data.size() << " bytes");
+}
+
+BOOST_AUTO_TEST_CASE(replay_checkpoint_find_test)
+{
+	const std::vector<replay_checkpoint> checkpoints = {
+		create_replay_checkpoint(1800, 10),
+		create_replay_checkpoint(3600, 20),
+		create_replay_checkpoint(5400, 30)
+	};
+
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 0) == nullptr);
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 1799) == nullptr);
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 1800) == &checkpoints[0]);
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 3599) == &checkpoints[0]);
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 3600) == &checkpoints[1]);
+	BOOST_CHECK(wyrmgus::find_replay_checkpoint(checkpoints, 100000) == &checkpoints[2]);
+
+	binary_replay replay;
+	replay.add_checkpoint(create_replay_checkpoint(3600, 20));
+	BOOST_CHECK_THROW(replay.add_checkpoint(create_replay_checkpoint(1800, 10)), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(replay_group_command_test)
+{
+	replay_command command;
+	command.game_cycle = 100;
+	command.unit_number = 5;
+	command.unit_ident = "unit_dwarven_axefighter";
+	command.action = "move";
+	command.flush = 1;
+	command.pos_x = 10;
+	command.pos_y = 20;
+
+	//another unit given the same order in the same cycle can join the command's group, regardless of its type or the random seed at the time
+	replay_command other_command = command;
+	other_command.unit_number = 9;
+	other_command.unit_ident = "unit_dwarven_scout";
+	other_command.sync_rand_seed = 1234;
+	BOOST_CHECK(command.has_same_order(other_command));
+
+	const std::vector<std::function<void(replay_command &)>> order_changes = {
+		[](replay_command &changed_command) { changed_command.unit_number = -1; },
+		[](replay_command &changed_command) { ++changed_command.game_cycle; },
+		[](replay_command &changed_command) { changed_command.action = "attack"; },
+		[](replay_command &changed_command) { changed_command.flush = 0; },
+		[](replay_command &changed_command) { ++changed_command.pos_x; },
+		[](replay_command &changed_command) { ++changed_command.pos_y; },
+		[](replay_command &changed_command) { changed_command.dest_unit_number = 3; },
+		[](replay_command &changed_command) { changed_command.value = "unit_dwarven_town_hall"; },
+		[](replay_command &changed_command) { changed_command.num = 1; }
+	};
+
+	for (const std::function<void(replay_command &)> &order_change : order_changes) {
+		replay_command changed_command = other_command;
+		order_change(changed_command);
+		BOOST_CHECK(!command.has_same_order(changed_command));
+	}
+
+	//playback gives the command to the group's units in their listed order, so the order must survive the binary encoding
+	command.group_unit_numbers = { 9, 3, 7 };
+
+	binary_replay replay;
+	replay.add_command(replay_command(command));
+
+	const binary_replay loaded_replay = binary_replay::from_bytes(replay.to_bytes());
+	BOOST_REQUIRE(loaded_replay.get_commands().size() == 1);
+	BOOST_CHECK(loaded_replay.get_commands().front() == command);
+	BOOST_CHECK(loaded_replay.get_commands().front().group_unit_numbers == std::vector<int>({ 9, 3, 7 }));
+}
+
+BOOST_AUTO_TEST_CASE(binary_replay_invalid_count_test)
+{
+	//a command count which the data cannot hold must be rejected before any memory is reserved for it
+	wyrmgus::save_buffer_writer writer;
+	writer.write_bytes(binary_replay::magic.data(), binary_replay::magic.size());
+	writer.write_uint32(binary_replay::version);
+	writer.write_string("ReplayLog( { Comment1 = \"Test\" } )\n");
+	writer.write_varint(std::numeric_limits<uint32_t>::max());
+
+	BOOST_CHECK_THROW(binary_replay::from_bytes(writer.take_data()), std::runtime_error);
+}
@@ -0,0 +1,110 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "game/save_container.h"
+
+#include "game/save_container_test_data.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(save_container_tests)
+
+using namespace save_container_test_data;
+
+BOOST_AUTO_TEST_CASE(save_buffer_roundtrip_test)
+{
+	save_buffer_writer writer;
+	writer.write_uint8(200);
+	writer.write_uint32(0xDEADBEEF);
+	writer.write_varint(0);
+	writer.write_varint(127);
+	writer.write_varint(128);
+	writer.write_varint(std::numeric_limits<uint64_t>::max());
+	writer.write_signed_varint(-1);
+	writer.write_signed_varint(std::numeric_limits<int64_t>::min());
+	writer.write_string("wyrmgus");
+
+	save_buffer_reader reader(writer.get_data());
+	BOOST_CHECK(reader.read_uint8() == 200);
+	BOOST_CHECK(reader.read_uint32() == 0xDEADBEEF);
+	BOOST_CHECK(reader.read_varint() == 0);
+	BOOST_CHECK(reader.read_varint() == 127);
+	BOOST_CHECK(reader.read_varint() == 128);
+	BOOST_CHECK(reader.read_varint() == std::numeric_limits<uint64_t>::max());
+	BOOST_CHECK(reader.read_signed_varint() == -1);
+	BOOST_CHECK(reader.read_signed_varint() == std::numeric_limits<int64_t>::min());
+	BOOST_CHECK(reader.read_string() == "wyrmgus");
+	BOOST_CHECK(reader.is_at_end());
+
+	BOOST_CHECK_THROW(reader.read_uint8(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(save_container_roundtrip_test)
+{
+	const std::vector<tile_record> records = create_tile_records();
+
+	const std::string container_data = save_tile_records(records);
+	BOOST_CHECK(load_tile_records(container_data) == records);
+
+	//a truncated container must be rejected rather than partially loaded
+	const std::string_view truncated_data = std::string_view(container_data).substr(0, container_data.size() / 2);
+	BOOST_CHECK_THROW(load_tile_records(truncated_data), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(save_container_save_data_split_test)
+{
+	const std::string script = "GameCycle = 100\nSetGodMode(false)\n";
+
+	save_container container;
+	container.add_section(save_section::map_tiles, { save_container::compress_chunk("tile data") });
+	const std::string container_data = container.to_bytes();
+
+	const std::string save_data = script + container.to_save_trailer_bytes();
+
+	const auto [split_script, split_container_data] = save_container::split_save_data(save_data);
+	BOOST_CHECK(split_script == script);
+	BOOST_CHECK(split_container_data == container_data);
+
+	std::vector<std::string> chunks;
+	save_container::for_each_chunk(split_container_data, save_section::map_tiles, [&chunks](const std::string_view &chunk_data) {
+		chunks.emplace_back(chunk_data);
+	});
+	BOOST_CHECK(chunks == std::vector<std::string>{ "tile data" });
+
+	//save data without a container is entirely a Lua script
+	const auto [script_only, empty_container_data] = save_container::split_save_data(script);
+	BOOST_CHECK(script_only == script);
+	BOOST_CHECK(empty_container_data.empty());
+
+	//a footer with a size larger than the save data must be rejected
+	std::string corrupted_save_data = save_data.substr(script.size() + 1);
+	BOOST_CHECK_THROW(save_container::split_save_data(corrupted_save_data), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
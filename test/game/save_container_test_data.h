@@ -0,0 +1,204 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "game/save_container.h"
+
+//the test data shared by the unit test and the benchmark
+namespace save_container_test_data {
+
+using wyrmgus::save_buffer_reader;
+using wyrmgus::save_buffer_writer;
+using wyrmgus::save_container;
+using wyrmgus::save_identifier_reader;
+using wyrmgus::save_identifier_writer;
+using wyrmgus::save_section;
+
+class test_data_entry final
+{
+public:
+	static test_data_entry *get(const std::string &identifier)
+	{
+		for (test_data_entry &data_entry : test_data_entry::data_entries) {
+			if (data_entry.identifier == identifier) {
+				return &data_entry;
+			}
+		}
+
+		throw std::runtime_error("Invalid test data entry: \"" + identifier + "\".");
+	}
+
+	static std::array<test_data_entry, 4> data_entries;
+
+	explicit test_data_entry(const std::string &identifier) : identifier(identifier)
+	{
+	}
+
+	const std::string &get_identifier() const
+	{
+		return this->identifier;
+	}
+
+private:
+	std::string identifier;
+};
+
+inline std::array<test_data_entry, 4> test_data_entry::data_entries = {
+	test_data_entry("grass"),
+	test_data_entry("dirt"),
+	test_data_entry("water"),
+	test_data_entry("pine_tree")
+};
+
+//a record with a layout similar to that of a saved map tile
+struct tile_record final
+{
+	bool operator ==(const tile_record &rhs) const = default;
+
+	const test_data_entry *terrain = nullptr;
+	const test_data_entry *overlay_terrain = nullptr;
+	int value = 0;
+	int movement_cost = 0;
+	int landmass = 0;
+	uint64_t explored = 0;
+	uint32_t flags = 0;
+};
+
+inline constexpr int map_size = 512;
+inline constexpr int rows_per_chunk = 32;
+
+inline std::vector<tile_record> create_tile_records()
+{
+	std::vector<tile_record> records(map_size * map_size);
+
+	uint32_t seed = 0x9E3779B9;
+	for (tile_record &record : records) {
+		seed = seed * 1103515245 + 12345;
+		const uint32_t random_value = seed >> 8;
+
+		record.terrain = &test_data_entry::data_entries[random_value % 3];
+		record.overlay_terrain = (random_value % 7) == 0 ? &test_data_entry::data_entries[3] : nullptr;
+		record.value = record.overlay_terrain != nullptr ? 100 : 0;
+		record.movement_cost = 1 + random_value % 4;
+		record.landmass = 1 + (random_value >> 12) % 3;
+		record.explored = (random_value % 5) == 0 ? 0x3 : 0;
+		record.flags = random_value & 0xFFF;
+	}
+
+	return records;
+}
+
+inline void write_tile_record(save_buffer_writer &writer, save_identifier_writer<test_data_entry> &identifier_writer, const tile_record &record)
+{
+	identifier_writer.write(writer, record.terrain);
+	identifier_writer.write(writer, record.overlay_terrain);
+	writer.write_signed_varint(record.value);
+	writer.write_signed_varint(record.movement_cost);
+	writer.write_varint(record.landmass);
+	writer.write_varint(record.explored);
+	writer.write_varint(record.flags);
+}
+
+inline tile_record read_tile_record(save_buffer_reader &reader, save_identifier_reader<test_data_entry> &identifier_reader)
+{
+	tile_record record;
+	record.terrain = identifier_reader.read(reader);
+	record.overlay_terrain = identifier_reader.read(reader);
+	record.value = static_cast<int>(reader.read_signed_varint());
+	record.movement_cost = static_cast<int>(reader.read_signed_varint());
+	record.landmass = static_cast<int>(reader.read_varint());
+	record.explored = reader.read_varint();
+	record.flags = static_cast<uint32_t>(reader.read_varint());
+	return record;
+}
+
+//save the records in the same way as the map tiles are saved, with chunks being serialized and compressed in parallel
+inline std::string save_tile_records(const std::vector<tile_record> &records)
+{
+	const size_t chunk_count = map_size / rows_per_chunk;
+	std::vector<save_container::compressed_chunk> chunks(chunk_count);
+	std::atomic<size_t> next_chunk_index = 0;
+
+	const auto serialize_chunks = [&records, &chunks, &next_chunk_index, chunk_count]() {
+		while (true) {
+			const size_t chunk_index = next_chunk_index.fetch_add(1);
+			if (chunk_index >= chunk_count) {
+				break;
+			}
+
+			const size_t start_index = chunk_index * rows_per_chunk * map_size;
+
+			save_buffer_writer writer;
+			save_identifier_writer<test_data_entry> identifier_writer;
+			writer.write_varint(start_index);
+
+			for (size_t i = start_index; i < start_index + rows_per_chunk * map_size; ++i) {
+				write_tile_record(writer, identifier_writer, records[i]);
+			}
+
+			chunks[chunk_index] = save_container::compress_chunk(writer.get_data());
+		}
+	};
+
+	const size_t worker_count = std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<std::future<void>> futures;
+	for (size_t i = 1; i < worker_count; ++i) {
+		futures.push_back(std::async(std::launch::async, serialize_chunks));
+	}
+
+	serialize_chunks();
+
+	for (std::future<void> &future : futures) {
+		future.get();
+	}
+
+	save_container container;
+	container.add_section(save_section::map_tiles, std::move(chunks));
+	return container.to_bytes();
+}
+
+inline std::vector<tile_record> load_tile_records(const std::string_view &container_data)
+{
+	std::vector<tile_record> records(map_size * map_size);
+
+	save_container::for_each_chunk(container_data, save_section::map_tiles, [&records](const std::string_view &chunk_data) {
+		save_buffer_reader reader(chunk_data);
+		save_identifier_reader<test_data_entry> identifier_reader;
+
+		const size_t start_index = static_cast<size_t>(reader.read_varint());
+
+		for (size_t i = start_index; !reader.is_at_end(); ++i) {
+			records.at(i) = read_tile_record(reader, identifier_reader);
+		}
+	});
+
+	return records;
+}
+
+}
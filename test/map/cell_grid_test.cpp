@@ -0,0 +1,126 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/cell_grid.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(cell_grid_tests)
+
+namespace {
+
+struct test_unit final
+{
+	QRect rect;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(cell_grid_insert_remove_test)
+{
+	test_unit unit;
+	unit.rect = QRect(QPoint(7, 7), QSize(2, 2));
+
+	wyrmgus::cell_grid<test_unit> grid(QSize(256, 256));
+	grid.insert(&unit, unit.rect);
+
+	//the unit overlaps four cells, but must be visited only once
+	int visit_count = 0;
+	grid.for_each_in_rect(QRect(0, 0, 16, 16), [&visit_count](test_unit *, const QRect &) {
+		++visit_count;
+	});
+	BOOST_CHECK(visit_count == 1);
+
+	visit_count = 0;
+	grid.for_each_in_rect(QRect(8, 8, 1, 1), [&visit_count](test_unit *, const QRect &intersection) {
+		++visit_count;
+		BOOST_CHECK(intersection == QRect(8, 8, 1, 1));
+	});
+	BOOST_CHECK(visit_count == 1);
+
+	grid.remove(&unit, unit.rect);
+
+	visit_count = 0;
+	grid.for_each_in_rect(QRect(0, 0, 16, 16), [&visit_count](test_unit *, const QRect &) {
+		++visit_count;
+	});
+	BOOST_CHECK(visit_count == 0);
+}
+
+BOOST_AUTO_TEST_CASE(cell_grid_rect_query_test)
+{
+	static constexpr int map_size = 32;
+
+	//units of sizes from 1x1 to 3x3, including ones straddling cell boundaries and at the map edges
+	std::vector<test_unit> units;
+	for (int y = 0; y < map_size; y += 3) {
+		for (int x = 0; x < map_size; x += 4) {
+			const int size = 1 + (x + y) % 3;
+
+			test_unit unit;
+			unit.rect = QRect(QPoint(std::min(x + y % 2, map_size - size), std::min(y, map_size - size)), QSize(size, size));
+			units.push_back(unit);
+		}
+	}
+
+	wyrmgus::cell_grid<test_unit> grid(QSize(map_size, map_size));
+	for (test_unit &unit : units) {
+		grid.insert(&unit, unit.rect);
+	}
+
+	const std::vector<QRect> rects = {
+		QRect(0, 0, map_size, map_size),
+		QRect(7, 7, 2, 2),
+		QRect(5, 3, 12, 9),
+		QRect(-4, -4, 10, 10),
+		QRect(map_size - 3, map_size - 3, 8, 8),
+		QRect(15, 0, 2, map_size)
+	};
+
+	for (const QRect &rect : rects) {
+		std::vector<const test_unit *> grid_units;
+		grid.for_each_in_rect(rect, [&grid_units, &rect](test_unit *unit, const QRect &intersection) {
+			BOOST_CHECK(intersection == unit->rect.intersected(rect));
+			grid_units.push_back(unit);
+		});
+
+		//each unit intersecting with the rectangle must be visited exactly once
+		std::vector<const test_unit *> expected_units;
+		for (const test_unit &unit : units) {
+			if (unit.rect.intersects(rect)) {
+				expected_units.push_back(&unit);
+			}
+		}
+
+		std::sort(grid_units.begin(), grid_units.end());
+		BOOST_CHECK(grid_units == expected_units);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
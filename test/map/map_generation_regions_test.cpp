@@ -0,0 +1,134 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "map/map_generation_regions.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(map_generation_regions_tests)
+
+namespace {
+
+constexpr int map_width = 200;
+constexpr int map_height = 150;
+
+//expand zones from the given seeds cardinally until the whole map is filled, in the way map templates generate zones
+std::vector<int> expand_zones(const std::vector<QPoint> &seeds, const uint64_t seed)
+{
+	const QRect map_rect(QPoint(0, 0), QSize(map_width, map_height));
+	const wyrmgus::map_generation_regions regions(map_rect, seed);
+
+	std::vector<int> tile_zones(map_width * map_height, 0);
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		tile_zones[seeds[i].y() * map_width + seeds[i].x()] = static_cast<int>(i) + 1;
+	}
+
+	regions.expand(seeds, [&](const size_t region_index, std::vector<QPoint> &region_seeds, wyrmgus::random_stream &region_random, std::vector<QPoint> &outside_seeds) {
+		const QRect region_rect = regions.get_region_rect(region_index);
+
+		while (!region_seeds.empty()) {
+			const QPoint seed_pos = region_random.take_random(region_seeds);
+			const int zone = tile_zones[seed_pos.y() * map_width + seed_pos.x()];
+
+			std::vector<QPoint> adjacent_positions;
+			for (const QPoint &offset : { QPoint(0, -1), QPoint(1, 0), QPoint(0, 1), QPoint(-1, 0) }) {
+				const QPoint adjacent_pos = seed_pos + offset;
+
+				if (!map_rect.contains(adjacent_pos) || tile_zones[adjacent_pos.y() * map_width + adjacent_pos.x()] != 0) {
+					continue;
+				}
+
+				adjacent_positions.push_back(adjacent_pos);
+			}
+
+			if (adjacent_positions.empty()) {
+				continue;
+			}
+
+			if (adjacent_positions.size() > 1) {
+				region_seeds.push_back(seed_pos);
+			}
+
+			const QPoint adjacent_pos = region_random.take_random(adjacent_positions);
+			tile_zones[adjacent_pos.y() * map_width + adjacent_pos.x()] = zone;
+
+			if (region_rect.contains(adjacent_pos)) {
+				region_seeds.push_back(adjacent_pos);
+			} else {
+				outside_seeds.push_back(adjacent_pos);
+			}
+		}
+	});
+
+	return tile_zones;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(map_generation_regions_rect_test)
+{
+	const QRect rect(QPoint(5, 7), QSize(70, 40));
+	const wyrmgus::map_generation_regions regions(rect, 0);
+
+	BOOST_CHECK(regions.get_region_count() == 6);
+
+	for (int x = rect.left(); x <= rect.right(); ++x) {
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			const QPoint pos(x, y);
+			BOOST_CHECK(regions.get_region_rect(regions.get_region_index(pos)).contains(pos));
+		}
+	}
+
+	//regions on the edge of the rect are cut to fit within it
+	BOOST_CHECK(regions.get_region_rect(5) == QRect(QPoint(69, 39), QPoint(74, 46)));
+
+	//positions outside the rect are not distributed to any region
+	const std::vector<std::vector<QPoint>> region_positions = regions.distribute({ QPoint(5, 7), QPoint(4, 7), QPoint(74, 46), QPoint(40, 7) });
+	BOOST_CHECK(region_positions[0].size() == 1);
+	BOOST_CHECK(region_positions[1].size() == 1);
+	BOOST_CHECK(region_positions[5].size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(map_generation_regions_deterministic_expansion_test)
+{
+	const std::vector<QPoint> seeds = { QPoint(3, 4), QPoint(100, 20), QPoint(150, 140), QPoint(40, 100), QPoint(190, 70) };
+
+	const std::vector<int> tile_zones = expand_zones(seeds, 12345);
+
+	//every tile is reached, even in regions with no seeds of their own
+	BOOST_CHECK(std::find(tile_zones.begin(), tile_zones.end(), 0) == tile_zones.end());
+
+	//the same seed must yield the same result, regardless of how the regions were scheduled on the threads
+	for (int i = 0; i < 10; ++i) {
+		BOOST_CHECK(expand_zones(seeds, 12345) == tile_zones);
+	}
+
+	BOOST_CHECK(expand_zones(seeds, 54321) != tile_zones);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,165 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/minimap_overlay_tracker.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(minimap_overlay_tracker_tests)
+
+using wyrmgus::minimap_overlay_tracker;
+using wyrmgus::minimap_unit_draw_state;
+
+namespace {
+
+constexpr int texture_size = 64;
+
+class test_overlay final
+{
+public:
+	test_overlay() : background(texture_size * texture_size, 0), pixels(texture_size * texture_size, 0)
+	{
+		for (int i = 0; i < texture_size * texture_size; ++i) {
+			this->background[i] = static_cast<uint32_t>(i % 7);
+		}
+
+		this->pixels = this->background;
+	}
+
+	void restore(const QRect &rect)
+	{
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			std::copy_n(this->background.begin() + y * texture_size + rect.left(), rect.width(), this->pixels.begin() + y * texture_size + rect.left());
+		}
+	}
+
+	void draw(const minimap_unit_draw_state &state)
+	{
+		const QRect rect = state.rect.intersected(QRect(0, 0, texture_size, texture_size));
+
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			std::fill_n(this->pixels.begin() + y * texture_size + rect.left(), rect.width(), state.color);
+		}
+	}
+
+	//get the pixels the overlay should have: the background, with the units drawn over it in order
+	std::vector<uint32_t> get_expected_pixels(const std::vector<minimap_overlay_tracker::unit_state> &unit_states) const
+	{
+		test_overlay expected_overlay;
+		expected_overlay.background = this->background;
+		expected_overlay.restore(QRect(0, 0, texture_size, texture_size));
+
+		for (const auto &[key, state] : unit_states) {
+			expected_overlay.draw(state);
+		}
+
+		return expected_overlay.pixels;
+	}
+
+	std::vector<uint32_t> background;
+	std::vector<uint32_t> pixels;
+};
+
+minimap_overlay_tracker::unit_state create_unit_state(const size_t key, const QRect &rect, const uint32_t color)
+{
+	minimap_unit_draw_state state;
+	state.rect = rect;
+	state.color = color;
+	return minimap_overlay_tracker::unit_state(key, state);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(minimap_overlay_tracker_test)
+{
+	test_overlay overlay;
+	minimap_overlay_tracker tracker;
+	tracker.clear(QSize(texture_size, texture_size));
+
+	int draw_count = 0;
+
+	const auto update = [&tracker, &overlay, &draw_count](const std::vector<minimap_overlay_tracker::unit_state> &unit_states) {
+		draw_count = 0;
+
+		tracker.update(unit_states, [&overlay](const QRect &rect) {
+			overlay.restore(rect);
+		}, [&overlay, &draw_count](const size_t, const minimap_unit_draw_state &state) {
+			overlay.draw(state);
+			++draw_count;
+		});
+
+		BOOST_CHECK(overlay.pixels == overlay.get_expected_pixels(unit_states));
+	};
+
+	std::vector<minimap_overlay_tracker::unit_state> unit_states = {
+		create_unit_state(0, QRect(4, 4, 3, 3), 100),
+		create_unit_state(1, QRect(5, 5, 4, 4), 101), //overlaps the first unit, and is drawn over it
+		create_unit_state(2, QRect(30, 30, 2, 2), 102),
+		create_unit_state(3, QRect(62, 62, 4, 4), 103) //partially outside the texture
+	};
+
+	update(unit_states);
+	BOOST_CHECK(draw_count == 4);
+
+	//nothing changed, so nothing is redrawn
+	update(unit_states);
+	BOOST_CHECK(draw_count == 0);
+
+	//the first unit changing color must be redrawn together with the unit over it, to keep their drawing order
+	unit_states[0].second.color = 200;
+	update(unit_states);
+	BOOST_CHECK(draw_count == 2);
+
+	//a moved unit must have its previous texels restored
+	unit_states[2].second.rect = QRect(40, 20, 2, 2);
+	update(unit_states);
+	BOOST_CHECK(draw_count == 1);
+
+	//a removed unit must have its texels restored, and the units under it redrawn
+	unit_states.erase(unit_states.begin() + 1);
+	update(unit_states);
+	BOOST_CHECK(draw_count == 1);
+
+	//a change in the background redraws it, and the units over it
+	for (int y = 3; y < 8; ++y) {
+		for (int x = 3; x < 8; ++x) {
+			overlay.background[y * texture_size + x] = 300;
+		}
+	}
+	tracker.mark_dirty(QRect(3, 3, 5, 5));
+	update(unit_states);
+	BOOST_CHECK(draw_count == 1);
+
+	//a new unit reusing the key of a removed one
+	unit_states.push_back(create_unit_state(1, QRect(60, 0, 2, 2), 104));
+	update(unit_states);
+	BOOST_CHECK(draw_count == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
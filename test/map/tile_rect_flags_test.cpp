@@ -0,0 +1,89 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "map/tile_rect_flags.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(tile_rect_flags_tests)
+
+BOOST_AUTO_TEST_CASE(tile_rect_flags_neighborhood_test)
+{
+	wyrmgus::tile_rect_flags flags(QRect(QPoint(2, 3), QPoint(9, 9)));
+
+	flags.set(QPoint(5, 5));
+
+	BOOST_CHECK(flags.get(QPoint(5, 5)));
+	BOOST_CHECK(flags.get(QPoint(5, 6)) == false);
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(6, 6)));
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(4, 4)));
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(7, 5)) == false);
+
+	//tiles on the edge of the rect only check adjacent tiles within it
+	flags.set(QPoint(2, 3));
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(2, 4)));
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(9, 9)) == false);
+}
+
+BOOST_AUTO_TEST_CASE(tile_rect_flags_set_if_test)
+{
+	//large enough for the bands of columns to be checked in parallel, and not a multiple of the band width
+	const QRect rect(QPoint(5, 7), QSize(150, 90));
+	BOOST_CHECK(rect.width() * rect.height() >= wyrmgus::tile_rect_flags::min_parallel_tile_count);
+
+	const auto predicate = [](const QPoint &tile_pos) {
+		return (tile_pos.x() * 7 + tile_pos.y() * 3) % 11 == 0;
+	};
+
+	wyrmgus::tile_rect_flags flags(rect);
+	flags.set_if(predicate);
+
+	for (int x = rect.left(); x <= rect.right(); ++x) {
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			const QPoint tile_pos(x, y);
+			BOOST_CHECK(flags.get(tile_pos) == predicate(tile_pos));
+		}
+	}
+
+	flags.clear();
+	BOOST_CHECK(flags.get(QPoint(5, 7)) == false);
+	BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(5, 7)) == false);
+
+	//a predicate which is never true leaves no flags set
+	flags.set_if([](const QPoint &) {
+		return false;
+	});
+	for (int x = rect.left(); x <= rect.right(); ++x) {
+		for (int y = rect.top(); y <= rect.bottom(); ++y) {
+			BOOST_CHECK(flags.is_set_in_neighborhood(QPoint(x, y)) == false);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "network/net_message.h"
+#include "network/network.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(group_command_tests)
+
+namespace {
+
+CNetworkCommandQueue create_unit_command(const unsigned char type, const uint16_t unit, const uint16_t x, const uint16_t y, const uint16_t dest)
+{
+	CNetworkCommand nc;
+	nc.Unit = unit;
+	nc.X = x;
+	nc.Y = y;
+	nc.Dest = dest;
+
+	CNetworkCommandQueue ncq;
+	ncq.Type = type;
+	ncq.Data.resize(nc.Size());
+	nc.Serialize(&ncq.Data[0]);
+	return ncq;
+}
+
+CNetworkGroupCommand get_group_command(const CNetworkCommandQueue &ncq)
+{
+	CNetworkGroupCommand ngc;
+	ngc.Deserialize(&ncq.Data[0]);
+	return ngc;
+}
+
+uint16_t get_command_unit(const CNetworkCommandQueue &ncq)
+{
+	CNetworkCommand nc;
+	nc.Deserialize(&ncq.Data[0]);
+	return nc.Unit;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(group_command_serialization_test)
+{
+	CNetworkGroupCommand ngc;
+	ngc.Type = MessageCommandMove;
+	ngc.X = 0x1234;
+	ngc.Y = 0x5678;
+	ngc.Dest = 0x9ABC;
+	for (uint16_t i = 0; i < MaxNetworkGroupCommandUnits; ++i) {
+		ngc.Units.push_back(static_cast<uint16_t>(0x0123 * i));
+	}
+
+	std::vector<unsigned char> buffer(ngc.Size());
+	BOOST_CHECK(ngc.Serialize(buffer.data()) == ngc.Size());
+
+	CNetworkGroupCommand loaded_ngc;
+	BOOST_CHECK(loaded_ngc.Deserialize(buffer.data()) == ngc.Size());
+
+	BOOST_CHECK(loaded_ngc.Type == ngc.Type);
+	BOOST_CHECK(loaded_ngc.X == ngc.X);
+	BOOST_CHECK(loaded_ngc.Y == ngc.Y);
+	BOOST_CHECK(loaded_ngc.Dest == ngc.Dest);
+	BOOST_CHECK(loaded_ngc.Units == ngc.Units);
+}
+
+BOOST_AUTO_TEST_CASE(group_command_merge_test)
+{
+	static constexpr unsigned char flush_flag = 0x80;
+
+	std::deque<CNetworkCommandQueue> commands;
+	for (uint16_t unit = 1; unit <= 3; ++unit) {
+		commands.push_back(create_unit_command(MessageCommandMove | flush_flag, unit, 10, 20, 0));
+	}
+	//a different target, flush flag or command type ends the group
+	commands.push_back(create_unit_command(MessageCommandMove | flush_flag, 4, 11, 20, 0));
+	commands.push_back(create_unit_command(MessageCommandMove, 5, 11, 20, 0));
+	commands.push_back(create_unit_command(MessageCommandAttack, 6, 11, 20, 0));
+	//dismiss commands are never grouped
+	commands.push_back(create_unit_command(MessageCommandDismiss, 7, 0, 0, 0));
+	commands.push_back(create_unit_command(MessageCommandDismiss, 8, 0, 0, 0));
+
+	const CNetworkCommandQueue group_ncq = PopNetworkCommand(commands);
+	BOOST_CHECK(group_ncq.Type == (MessageGroupCommand | flush_flag));
+
+	const CNetworkGroupCommand ngc = get_group_command(group_ncq);
+	BOOST_CHECK(ngc.Type == MessageCommandMove);
+	BOOST_CHECK(ngc.X == 10);
+	BOOST_CHECK(ngc.Y == 20);
+	BOOST_CHECK(ngc.Units == std::vector<uint16_t>({ 1, 2, 3 }));
+
+	//commands which could not be merged are sent unchanged, in their original order
+	const std::array<std::pair<unsigned char, uint16_t>, 5> expected_commands = {{
+		{ MessageCommandMove | flush_flag, 4 },
+		{ MessageCommandMove, 5 },
+		{ MessageCommandAttack, 6 },
+		{ MessageCommandDismiss, 7 },
+		{ MessageCommandDismiss, 8 }
+	}};
+
+	for (const auto &[type, unit] : expected_commands) {
+		BOOST_REQUIRE(!commands.empty());
+		const CNetworkCommandQueue ncq = PopNetworkCommand(commands);
+		BOOST_CHECK(ncq.Type == type);
+		BOOST_CHECK(get_command_unit(ncq) == unit);
+	}
+
+	BOOST_CHECK(commands.empty());
+}
+
+BOOST_AUTO_TEST_CASE(group_command_unit_cap_test)
+{
+	static constexpr uint16_t unit_count = 100;
+
+	std::deque<CNetworkCommandQueue> commands;
+	for (uint16_t unit = 0; unit < unit_count; ++unit) {
+		commands.push_back(create_unit_command(MessageCommandMove, unit, 10, 20, 0));
+	}
+
+	//the units are split into groups of at most the maximum size, keeping their order
+	std::vector<uint16_t> units;
+	while (!commands.empty()) {
+		const CNetworkCommandQueue ncq = PopNetworkCommand(commands);
+		BOOST_REQUIRE(ncq.Type == MessageGroupCommand);
+
+		const CNetworkGroupCommand ngc = get_group_command(ncq);
+		BOOST_CHECK(ngc.Units.size() <= static_cast<size_t>(MaxNetworkGroupCommandUnits));
+		units.insert(units.end(), ngc.Units.begin(), ngc.Units.end());
+	}
+
+	BOOST_REQUIRE(units.size() == unit_count);
+	for (uint16_t unit = 0; unit < unit_count; ++unit) {
+		BOOST_CHECK(units[unit] == unit);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -50,6 +50,17 @@ void FillCustomValue(CNetworkExtendedCommand *obj)
 	obj->Arg4 = 0x9ABC;
 }
 
+void FillCustomValue(CNetworkGroupCommand *obj)
+{
+	obj->Type = MessageCommandMove;
+	obj->X = 0x1234;
+	obj->Y = 0x5678;
+	obj->Dest = 0x9ABC;
+	for (int i = 0; i != 10; ++i) {
+		obj->Units.push_back(0x0123 * i);
+	}
+}
+
 void FillCustomValue(CNetworkChat *obj)
 {
 	obj->Text = "abcdefghijklmnopqrstuvwxyz";
@@ -94,6 +105,11 @@ bool Comp(const CNetworkSelection &lhs, const CNetworkSelection &rhs)
 	return lhs.Units == rhs.Units;
 }
 
+bool Comp(const CNetworkGroupCommand &lhs, const CNetworkGroupCommand &rhs)
+{
+	return lhs.Type == rhs.Type && lhs.X == rhs.X && lhs.Y == rhs.Y && lhs.Dest == rhs.Dest && lhs.Units == rhs.Units;
+}
+
 
 template <typename T>
 bool CheckSerialization()
@@ -119,6 +135,10 @@ TEST(CNetworkExtendedCommand)
 {
 	CHECK(CheckSerialization<CNetworkExtendedCommand>());
 }
+TEST(CNetworkGroupCommand)
+{
+	CHECK(CheckSerialization<CNetworkGroupCommand>());
+}
 TEST(CNetworkChat)
 {
 	CHECK(CheckSerialization<CNetworkChat>());
@@ -0,0 +1,150 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/astar_open_list.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(astar_open_list_tests)
+
+BOOST_AUTO_TEST_CASE(astar_open_list_pop_order_test)
+{
+	wyrmgus::astar_open_list open_list;
+	open_list.set_node_count(16);
+
+	open_list.push(Vec2i(0, 0), 0, 10, 5, 5);
+	open_list.push(Vec2i(1, 0), 1, 8, 6, 6);
+	open_list.push(Vec2i(2, 0), 2, 8, 4, 4);
+	open_list.push(Vec2i(3, 0), 3, 12, 1, 1);
+
+	//lower the cost of a node which is already in the list
+	open_list.push(Vec2i(3, 0), 3, 7, 1, 1);
+
+	BOOST_CHECK(open_list.size() == 4);
+	BOOST_CHECK(open_list.pop().offset == 3);
+	BOOST_CHECK(open_list.pop().offset == 2);
+	BOOST_CHECK(open_list.pop().offset == 1);
+	BOOST_CHECK(open_list.pop().offset == 0);
+	BOOST_CHECK(open_list.empty());
+
+	//a node with a cost of 0 must be counted and popped like any other, also when it lowers the base cost of the list
+	open_list.push(Vec2i(4, 0), 4, 3, 1, 1);
+	open_list.push(Vec2i(5, 0), 5, 0, 0, 0);
+	open_list.push(Vec2i(5, 0), 5, 0, 0, 0);
+
+	BOOST_CHECK(open_list.size() == 2);
+	BOOST_CHECK(open_list.pop().offset == 5);
+	BOOST_CHECK(open_list.pop().offset == 4);
+	BOOST_CHECK(open_list.empty());
+}
+
+BOOST_AUTO_TEST_CASE(astar_open_list_rebase_bucket_count_test)
+{
+	wyrmgus::astar_open_list open_list;
+	open_list.set_node_count(16);
+
+	//repeated searches which each lower the base cost, as happens with an inconsistent heuristic, must reuse the existing buckets
+	for (int search = 0; search < 1000; ++search) {
+		open_list.clear();
+		open_list.push(Vec2i(0, 0), 0, 100, 0, 0);
+		open_list.push(Vec2i(1, 0), 1, 90, 0, 0);
+		open_list.push(Vec2i(2, 0), 2, 50, 0, 0);
+
+		BOOST_CHECK(open_list.pop().offset == 2);
+		BOOST_CHECK(open_list.pop().offset == 1);
+		BOOST_CHECK(open_list.pop().offset == 0);
+	}
+
+	BOOST_CHECK(open_list.get_bucket_count() <= 51);
+
+	//a search with a very wide cost range does not keep all of its buckets allocated afterwards
+	open_list.clear();
+	open_list.push(Vec2i(0, 0), 0, 0, 0, 0);
+	open_list.push(Vec2i(1, 0), 1, 100000, 0, 0);
+	BOOST_CHECK(open_list.pop().offset == 0);
+	BOOST_CHECK(open_list.pop().offset == 1);
+	open_list.clear();
+
+	BOOST_CHECK(open_list.get_bucket_count() <= wyrmgus::astar_open_list::max_kept_bucket_count);
+}
+
+BOOST_AUTO_TEST_CASE(astar_open_list_random_operations_test)
+{
+	static constexpr unsigned int node_count = 512;
+
+	struct node_key final
+	{
+		auto operator <=>(const node_key &other) const = default;
+
+		int costs = 0;
+		int cost_to_goal = 0;
+		int distance = 0;
+		unsigned int offset = 0;
+	};
+
+	wyrmgus::astar_open_list open_list;
+	open_list.set_node_count(node_count);
+
+	//the nodes which should be in the open list
+	std::map<unsigned int, node_key> expected_nodes;
+
+	std::mt19937 random_engine(42);
+
+	for (int operation = 0; operation < 20000; ++operation) {
+		if (expected_nodes.empty() || random_engine() % 3 != 0) {
+			const unsigned int offset = random_engine() % node_count;
+			int costs = static_cast<int>(random_engine() % 200);
+
+			const auto find_iterator = expected_nodes.find(offset);
+			if (find_iterator != expected_nodes.end()) {
+				//nodes already in the list can only have their cost lowered
+				costs = std::min(costs, find_iterator->second.costs);
+			}
+
+			const int cost_to_goal = static_cast<int>(offset % 17);
+			const int distance = static_cast<int>(offset % 5);
+			open_list.push(Vec2i(static_cast<short>(offset % 32), static_cast<short>(offset / 32)), offset, costs, cost_to_goal, distance);
+			expected_nodes[offset] = node_key{ costs, cost_to_goal, distance, offset };
+		} else {
+			//the node popped must be the lowest one by cost, then by cost to the goal, distance and offset
+			const auto min_iterator = std::min_element(expected_nodes.begin(), expected_nodes.end(), [](const auto &lhs, const auto &rhs) {
+				return lhs.second < rhs.second;
+			});
+
+			const wyrmgus::astar_open_list::entry entry = open_list.pop();
+			BOOST_CHECK(entry.offset == min_iterator->first);
+			BOOST_CHECK(entry.costs == min_iterator->second.costs);
+			expected_nodes.erase(min_iterator);
+		}
+
+		BOOST_CHECK(open_list.size() == expected_nodes.size());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
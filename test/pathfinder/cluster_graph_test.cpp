@@ -0,0 +1,258 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+
+#include "stratagus.h"
+
+#include "pathfinder/cluster_graph.h"
+
+#include "pathfinder/flow_field.h"
+#include "pathfinder/pathfinder_test_data.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(cluster_graph_tests)
+
+using namespace pathfinder_test_data;
+
+namespace {
+
+//get the cost of the cheapest path between two positions, or -1 if there is none
+int find_path_cost(const cost_grid &grid, const QPoint &start_pos, const QPoint &goal_pos)
+{
+	wyrmgus::flow_field field(grid.get_size(), goal_pos, 0, grid.get_cost_function());
+	return field.get_path_cost(start_pos);
+}
+
+//get the cost of the path found by moving from waypoint to waypoint of the cluster graph, as units do when pathfinding hierarchically; returns -1 if there is no path
+int find_waypoint_path_cost(wyrmgus::cluster_graph &graph, const cost_grid &grid, const QPoint &start_pos, const QPoint &goal_pos)
+{
+	QPoint pos = start_pos;
+	int total_cost = 0;
+
+	//the number of steps is bounded, so that a faulty graph can't make the search loop forever
+	for (int i = 0; i < grid.get_size().width() * grid.get_size().height(); ++i) {
+		QPoint waypoint;
+		if (!graph.find_waypoint(pos, goal_pos, max_waypoint_distance, waypoint)) {
+			const int cost = find_path_cost(grid, pos, goal_pos);
+			return cost != -1 ? total_cost + cost : -1;
+		}
+
+		//each waypoint must be within the maximum waypoint distance of the previous position
+		BOOST_CHECK(std::max(std::abs(waypoint.x() - pos.x()), std::abs(waypoint.y() - pos.y())) <= max_waypoint_distance);
+
+		const int cost = find_path_cost(grid, pos, waypoint);
+		if (cost == -1) {
+			return -1;
+		}
+
+		total_cost += cost;
+		pos = waypoint;
+	}
+
+	return -1;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_waypoint_test)
+{
+	cost_grid grid;
+	wyrmgus::cluster_graph graph(QSize(map_width, map_height), grid.get_cost_function());
+
+	QPoint waypoint;
+
+	//on open terrain, the waypoint must be a passable tile within the maximum distance of the start
+	BOOST_CHECK(graph.find_waypoint(QPoint(2, 2), QPoint(200, 180), max_waypoint_distance, waypoint));
+	BOOST_CHECK(std::max(std::abs(waypoint.x() - 2), std::abs(waypoint.y() - 2)) <= max_waypoint_distance);
+	BOOST_CHECK(grid.get_cost(waypoint) != -1);
+
+	//positions connected within the same cluster don't need a waypoint
+	BOOST_CHECK(!graph.find_waypoint(QPoint(1, 1), QPoint(10, 10), max_waypoint_distance, waypoint));
+
+	//wall off the goal
+	const QPoint goal_pos(200, 180);
+	for (int x = goal_pos.x() - 1; x <= goal_pos.x() + 1; ++x) {
+		for (int y = goal_pos.y() - 1; y <= goal_pos.y() + 1; ++y) {
+			if (QPoint(x, y) != goal_pos) {
+				grid.set_cost(QPoint(x, y), -1);
+				graph.on_tile_changed(QPoint(x, y));
+			}
+		}
+	}
+
+	BOOST_CHECK(!graph.find_waypoint(QPoint(2, 2), goal_pos, max_waypoint_distance, waypoint));
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_passability_change_test)
+{
+	cost_grid grid;
+
+	//a wall across the map, with a single gap
+	static constexpr int wall_x = 100;
+	for (int y = 0; y < map_height; ++y) {
+		if (y != 20) {
+			grid.set_cost(QPoint(wall_x, y), -1);
+		}
+	}
+
+	wyrmgus::cluster_graph graph(QSize(map_width, map_height), grid.get_cost_function());
+
+	const QPoint start_pos(90, 200);
+	const QPoint goal_pos(110, 200);
+
+	BOOST_CHECK(find_waypoint_path_cost(graph, grid, start_pos, goal_pos) >= 180);
+
+	//moving the gap closer must shorten the path, as the graph has to pick up the change
+	grid.set_cost(QPoint(wall_x, 20), -1);
+	graph.on_tile_changed(QPoint(wall_x, 20));
+	grid.set_cost(QPoint(wall_x, 180), 1);
+	graph.on_tile_changed(QPoint(wall_x, 180));
+
+	const int waypoint_cost = find_waypoint_path_cost(graph, grid, start_pos, goal_pos);
+	BOOST_CHECK(waypoint_cost != -1);
+	BOOST_CHECK(waypoint_cost < 60);
+
+	//closing the gap must make the goal unreachable
+	grid.set_cost(QPoint(wall_x, 180), -1);
+	graph.on_tile_changed(QPoint(wall_x, 180));
+
+	BOOST_CHECK(find_waypoint_path_cost(graph, grid, start_pos, goal_pos) == -1);
+
+	//reopening a gap must work also after invalidating the whole graph
+	grid.set_cost(QPoint(wall_x, 20), 1);
+	graph.invalidate();
+
+	BOOST_CHECK(find_waypoint_path_cost(graph, grid, start_pos, goal_pos) != -1);
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_cost_change_test)
+{
+	cost_grid grid;
+
+	//a wall across the map, with a gap near each end
+	static constexpr int wall_x = 100;
+	for (int y = 0; y < map_height; ++y) {
+		if (y != 40 && y != map_height - 40) {
+			grid.set_cost(QPoint(wall_x, y), -1);
+		}
+	}
+
+	const auto set_half_cost = [&grid](const bool upper_half, const int cost, wyrmgus::cluster_graph *graph) {
+		for (int y = upper_half ? 0 : map_height / 2; y < (upper_half ? map_height / 2 : map_height); ++y) {
+			for (int x = 0; x < map_width; ++x) {
+				if (grid.get_cost(QPoint(x, y)) != -1) {
+					grid.set_cost(QPoint(x, y), cost);
+
+					if (graph != nullptr) {
+						graph->on_tile_changed(QPoint(x, y));
+					}
+				}
+			}
+		}
+	};
+
+	//make the upper half of the map rough terrain, so that the path goes through the lower gap
+	set_half_cost(true, 5, nullptr);
+
+	wyrmgus::cluster_graph graph(QSize(map_width, map_height), grid.get_cost_function());
+
+	const QPoint start_pos(90, map_height / 2);
+	const QPoint goal_pos(110, map_height / 2);
+
+	QPoint waypoint;
+	BOOST_CHECK(graph.find_waypoint(start_pos, goal_pos, max_waypoint_distance, waypoint));
+	BOOST_CHECK(waypoint.y() > map_height / 2);
+
+	//swapping the rough terrain to the lower half must make the path go through the upper gap
+	set_half_cost(true, 1, &graph);
+	set_half_cost(false, 5, &graph);
+
+	BOOST_CHECK(graph.find_waypoint(start_pos, goal_pos, max_waypoint_distance, waypoint));
+	BOOST_CHECK(waypoint.y() < map_height / 2);
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_path_cost_test)
+{
+	const cost_grid grid = create_cost_grid();
+	wyrmgus::cluster_graph graph(QSize(map_width, map_height), grid.get_cost_function());
+
+	for (const auto &[start_pos, goal_pos] : create_start_goal_pairs(grid)) {
+		const int optimal_cost = find_path_cost(grid, start_pos, goal_pos);
+		const int waypoint_cost = find_waypoint_path_cost(graph, grid, start_pos, goal_pos);
+
+		//the path through the waypoints must be found whenever a path exists, and be close to the optimal one
+		BOOST_CHECK((waypoint_cost == -1) == (optimal_cost == -1));
+		BOOST_CHECK(waypoint_cost >= optimal_cost);
+		BOOST_CHECK(waypoint_cost <= optimal_cost * 3 / 2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cluster_graph_concurrent_search_test)
+{
+	const cost_grid grid = create_cost_grid();
+	const std::vector<std::pair<QPoint, QPoint>> start_goal_pairs = create_start_goal_pairs(grid);
+
+	const auto find_waypoints = [&start_goal_pairs](wyrmgus::cluster_graph &graph) {
+		std::vector<std::optional<QPoint>> waypoints;
+
+		for (const auto &[start_pos, goal_pos] : start_goal_pairs) {
+			QPoint waypoint;
+			if (graph.find_waypoint(start_pos, goal_pos, max_waypoint_distance, waypoint)) {
+				waypoints.push_back(waypoint);
+			} else {
+				waypoints.push_back(std::nullopt);
+			}
+		}
+
+		return waypoints;
+	};
+
+	wyrmgus::cluster_graph serial_graph(QSize(map_width, map_height), grid.get_cost_function());
+	const std::vector<std::optional<QPoint>> serial_waypoints = find_waypoints(serial_graph);
+
+	//searches running concurrently on a graph which is still being built must give the same results as serial ones
+	wyrmgus::cluster_graph concurrent_graph(QSize(map_width, map_height), grid.get_cost_function());
+
+	std::vector<std::vector<std::optional<QPoint>>> concurrent_waypoints(4);
+	std::vector<std::thread> threads;
+	for (std::vector<std::optional<QPoint>> &thread_waypoints : concurrent_waypoints) {
+		threads.emplace_back([&find_waypoints, &concurrent_graph, &thread_waypoints]() {
+			thread_waypoints = find_waypoints(concurrent_graph);
+		});
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	for (const std::vector<std::optional<QPoint>> &thread_waypoints : concurrent_waypoints) {
+		BOOST_CHECK(thread_waypoints == serial_waypoints);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
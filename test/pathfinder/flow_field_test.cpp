@@ -0,0 +1,201 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+#include "stratagus.h"
+
+#include "pathfinder/flow_field.h"
+
+#include "pathfinder/pathfinder_test_data.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(flow_field_tests)
+
+using namespace pathfinder_test_data;
+
+//check that the path cost of each tile is that of the cheapest path to the goal: 0 for the goal, and otherwise the lowest cost of entering an adjacent tile and moving on from there, or -1 if there is no path
+static void check_path_costs(wyrmgus::flow_field &field, const cost_grid &grid, const QPoint &goal_pos)
+{
+	int mismatch_count = 0;
+
+	for (int x = 0; x < map_width; ++x) {
+		for (int y = 0; y < map_height; ++y) {
+			const QPoint tile_pos(x, y);
+
+			int expected_cost = -1;
+
+			if (grid.get_cost(tile_pos) != -1) {
+				if (tile_pos == goal_pos) {
+					expected_cost = 0;
+				} else {
+					for (int i = 0; i < 8; ++i) {
+						const QPoint adjacent_pos(x + Heading2X[i], y + Heading2Y[i]);
+
+						if (adjacent_pos.x() < 0 || adjacent_pos.y() < 0 || adjacent_pos.x() >= map_width || adjacent_pos.y() >= map_height) {
+							continue;
+						}
+
+						const int adjacent_path_cost = field.get_path_cost(adjacent_pos);
+
+						if (adjacent_path_cost == -1) {
+							continue;
+						}
+
+						const int cost = adjacent_path_cost + grid.get_cost(adjacent_pos);
+
+						if (expected_cost == -1 || cost < expected_cost) {
+							expected_cost = cost;
+						}
+					}
+				}
+			}
+
+			if (field.get_path_cost(tile_pos) != expected_cost) {
+				++mismatch_count;
+			}
+		}
+	}
+
+	BOOST_CHECK_EQUAL(mismatch_count, 0);
+}
+
+//check that the costs of a flow field are the same as those of one built anew, and that following the field leads to the goal
+static void check_flow_field(wyrmgus::flow_field &field, const cost_grid &grid, const QPoint &goal_pos)
+{
+	wyrmgus::flow_field rebuilt_field(QSize(map_width, map_height), goal_pos, 0, grid.get_cost_function());
+
+	int mismatch_count = 0;
+	for (int x = 0; x < map_width; ++x) {
+		for (int y = 0; y < map_height; ++y) {
+			if (field.get_path_cost(QPoint(x, y)) != rebuilt_field.get_path_cost(QPoint(x, y))) {
+				++mismatch_count;
+			}
+		}
+	}
+
+	BOOST_CHECK_EQUAL(mismatch_count, 0);
+
+	check_path_costs(field, grid, goal_pos);
+
+	for (const auto &[start_pos, pair_goal_pos] : create_start_goal_pairs(grid)) {
+		std::array<char, PathFinderOutput::MAX_PATH_LENGTH> path{};
+		const int path_length = field.find_path(start_pos, path);
+
+		if (path_length <= 0 || path_length > static_cast<int>(path.size())) {
+			continue;
+		}
+
+		QPoint pos = start_pos;
+		int path_cost = 0;
+		for (int i = path_length - 1; i >= 0; --i) {
+			pos = pos + QPoint(Heading2X[path[i]], Heading2Y[path[i]]);
+			path_cost += grid.get_cost(pos);
+		}
+
+		BOOST_CHECK(pos == goal_pos);
+		BOOST_CHECK_EQUAL(path_cost, field.get_path_cost(start_pos));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(flow_field_path_cost_test)
+{
+	const cost_grid grid = create_cost_grid();
+
+	const std::vector<std::pair<QPoint, QPoint>> start_goal_pairs = create_start_goal_pairs(grid);
+
+	for (size_t i = 0; i < start_goal_pairs.size(); i += 4) {
+		const QPoint &goal_pos = start_goal_pairs[i].second;
+		wyrmgus::flow_field field(QSize(map_width, map_height), goal_pos, 0, grid.get_cost_function());
+
+		check_path_costs(field, grid, goal_pos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(flow_field_repair_test)
+{
+	cost_grid grid = create_cost_grid();
+	const QPoint goal_pos(200, 180);
+	grid.set_cost(goal_pos, 1);
+
+	wyrmgus::flow_field field(QSize(map_width, map_height), goal_pos, 0, grid.get_cost_function());
+	check_flow_field(field, grid, goal_pos);
+
+	uint32_t seed = 0x68E31DA4;
+	const auto get_random_value = [&seed](const int max) {
+		seed = seed * 1103515245 + 12345;
+		return static_cast<int>((seed >> 16) % max);
+	};
+
+	//change small areas of the map at a time, with the field having to be repaired around them
+	for (int i = 0; i < 24; ++i) {
+		const QPoint area_pos(get_random_value(map_width - 8), get_random_value(map_height - 8));
+		const int cost = i % 3 == 0 ? -1 : get_random_value(6) + 1;
+
+		for (int x = area_pos.x(); x < area_pos.x() + 8; ++x) {
+			for (int y = area_pos.y(); y < area_pos.y() + 8; y += (i % 2 == 0) ? 1 : 7) {
+				grid.set_cost(QPoint(x, y), QPoint(x, y) == goal_pos ? 1 : cost);
+				field.on_tile_changed(QPoint(x, y));
+			}
+		}
+
+		check_flow_field(field, grid, goal_pos);
+	}
+
+	QPoint reachable_pos;
+	for (const auto &[start_pos, pair_goal_pos] : create_start_goal_pairs(grid)) {
+		if (field.get_path_cost(start_pos) > 0) {
+			reachable_pos = start_pos;
+			break;
+		}
+	}
+
+	BOOST_REQUIRE(field.get_path_cost(reachable_pos) > 0);
+
+	//walling off the goal must make it unreachable, and removing the wall must make it reachable again
+	std::vector<std::pair<QPoint, int>> wall_tile_costs;
+	for (int x = goal_pos.x() - 1; x <= goal_pos.x() + 1; ++x) {
+		for (int y = goal_pos.y() - 1; y <= goal_pos.y() + 1; ++y) {
+			if (QPoint(x, y) != goal_pos) {
+				wall_tile_costs.emplace_back(QPoint(x, y), grid.get_cost(QPoint(x, y)));
+				grid.set_cost(QPoint(x, y), -1);
+				field.on_tile_changed(QPoint(x, y));
+			}
+		}
+	}
+
+	BOOST_CHECK_EQUAL(field.get_path_cost(reachable_pos), -1);
+	check_flow_field(field, grid, goal_pos);
+
+	for (const auto &[tile_pos, cost] : wall_tile_costs) {
+		grid.set_cost(tile_pos, cost);
+		field.on_tile_changed(tile_pos);
+	}
+
+	BOOST_CHECK(field.get_path_cost(reachable_pos) > 0);
+	check_flow_field(field, grid, goal_pos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
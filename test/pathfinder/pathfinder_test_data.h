@@ -0,0 +1,139 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#pragma once
+
+#include "pathfinder/cluster_graph.h"
+
+//the test data shared by the pathfinder unit tests and the benchmark
+namespace pathfinder_test_data {
+
+inline constexpr int map_width = 256;
+inline constexpr int map_height = 256;
+inline constexpr int max_waypoint_distance = wyrmgus::cluster_graph::cluster_size * 2; //the waypoint distance used by the game
+
+//a tile cost grid, with -1 for impassable tiles
+class cost_grid final
+{
+public:
+	explicit cost_grid(const QSize &size = QSize(map_width, map_height))
+		: size(size), costs(static_cast<size_t>(size.width() * size.height()), 1)
+	{
+	}
+
+	const QSize &get_size() const
+	{
+		return this->size;
+	}
+
+	int get_cost(const QPoint &pos) const
+	{
+		return this->costs[pos.y() * this->size.width() + pos.x()];
+	}
+
+	void set_cost(const QPoint &pos, const int cost)
+	{
+		this->costs[pos.y() * this->size.width() + pos.x()] = cost;
+	}
+
+	wyrmgus::cluster_graph::tile_cost_function get_cost_function() const
+	{
+		return [this](const QPoint &pos) {
+			return this->get_cost(pos);
+		};
+	}
+
+private:
+	QSize size;
+	std::vector<int> costs;
+};
+
+//a grid with scattered obstacles, rough terrain and long walls with a few gaps, so that paths need to go around them
+inline cost_grid create_cost_grid(const QSize &size = QSize(map_width, map_height))
+{
+	cost_grid grid(size);
+
+	uint32_t seed = 0x2545F491;
+	for (int y = 0; y < size.height(); ++y) {
+		for (int x = 0; x < size.width(); ++x) {
+			seed = seed * 1103515245 + 12345;
+			const uint32_t value = (seed >> 16) % 100;
+
+			if (value < 10) {
+				grid.set_cost(QPoint(x, y), -1);
+			} else if (value < 25) {
+				grid.set_cost(QPoint(x, y), 4);
+			}
+		}
+	}
+
+	for (int x = 40; x < size.width(); x += 64) {
+		for (int y = 0; y < size.height(); ++y) {
+			if (y % 96 >= 8) {
+				grid.set_cost(QPoint(x, y), -1);
+			}
+		}
+	}
+
+	return grid;
+}
+
+inline std::vector<std::pair<QPoint, QPoint>> create_start_goal_pairs(const cost_grid &grid)
+{
+	std::vector<std::pair<QPoint, QPoint>> pairs;
+
+	uint32_t seed = 0x1B873593;
+	const int width = grid.get_size().width();
+	const int height = grid.get_size().height();
+
+	const auto get_random_passable_pos = [&grid, &seed, width, height]() {
+		while (true) {
+			seed = seed * 1103515245 + 12345;
+			const int x = static_cast<int>((seed >> 16) % width);
+			seed = seed * 1103515245 + 12345;
+			const int y = static_cast<int>((seed >> 16) % height);
+
+			if (grid.get_cost(QPoint(x, y)) != -1) {
+				return QPoint(x, y);
+			}
+		}
+	};
+
+	while (pairs.size() < 24) {
+		const QPoint start_pos = get_random_passable_pos();
+		const QPoint goal_pos = get_random_passable_pos();
+
+		//only long paths are searched hierarchically
+		if (std::abs(start_pos.x() - goal_pos.x()) + std::abs(start_pos.y() - goal_pos.y()) >= width / 2) {
+			pairs.emplace_back(start_pos, goal_pos);
+		}
+	}
+
+	return pairs;
+}
+
+}
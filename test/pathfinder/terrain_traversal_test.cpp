@@ -0,0 +1,129 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "pathfinder/pathfinder.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(terrain_traversal_tests)
+
+BOOST_AUTO_TEST_CASE(terrain_traversal_reuse_test)
+{
+	TerrainTraversal terrain_traversal;
+	terrain_traversal.SetSize(8, 8);
+
+	terrain_traversal.Init();
+	terrain_traversal.PushPos(Vec2i(2, 2));
+	BOOST_CHECK(terrain_traversal.Get(Vec2i(2, 2)) == 1);
+
+	//the border around the map is always invalid
+	BOOST_CHECK(terrain_traversal.Get(Vec2i(-1, 0)) == -1);
+	BOOST_CHECK(terrain_traversal.Get(Vec2i(8, 7)) == -1);
+
+	//initializing a new search discards the visit marks of the previous one
+	terrain_traversal.Init();
+	BOOST_CHECK(terrain_traversal.IsVisited(Vec2i(2, 2)) == false);
+	BOOST_CHECK(terrain_traversal.Get(Vec2i(-1, 0)) == -1);
+
+	//marks of earlier searches stay discarded when the generation counter wraps around
+	terrain_traversal.PushPos(Vec2i(5, 5));
+
+	bool stale_mark_visited = false;
+	for (int i = 0; i < 70000; ++i) {
+		terrain_traversal.Init();
+
+		if (terrain_traversal.IsVisited(Vec2i(5, 5))) {
+			stale_mark_visited = true;
+		}
+	}
+
+	BOOST_CHECK(stale_mark_visited == false);
+	BOOST_CHECK(terrain_traversal.Get(Vec2i(8, 7)) == -1);
+}
+
+BOOST_AUTO_TEST_CASE(terrain_traversal_distance_test)
+{
+	static constexpr int map_size = 16;
+
+	//records the tiles visited by a traversal, and the distance values they were visited with
+	class distance_recorder final
+	{
+	public:
+		VisitResult Visit(TerrainTraversal &terrain_traversal, const Vec2i &pos, const Vec2i &from)
+		{
+			Q_UNUSED(from);
+
+			if (pos.x < 0 || pos.y < 0 || pos.x >= map_size || pos.y >= map_size) {
+				return VisitResult::DeadEnd;
+			}
+
+			//a wall in the middle of the map, with a gap at its bottom
+			if (pos.x == 8 && pos.y < map_size - 1) {
+				return VisitResult::DeadEnd;
+			}
+
+			this->distances[pos.y * map_size + pos.x] = terrain_traversal.Get(pos);
+			return VisitResult::Ok;
+		}
+
+		std::array<int, map_size * map_size> distances{};
+	};
+
+	//successive searches, each reusing the storage of the previous ones, must each only visit the tiles reachable from their start, with the distance of each tile being one more than the amount of steps to reach it
+	for (const Vec2i &start_pos : { Vec2i(0, 0), Vec2i(3, 5), Vec2i(12, 2), Vec2i(0, 0) }) {
+		TerrainTraversal terrain_traversal;
+		terrain_traversal.SetSize(map_size, map_size);
+		terrain_traversal.Init();
+		terrain_traversal.PushPos(start_pos);
+
+		distance_recorder recorder;
+		BOOST_CHECK(terrain_traversal.Run(recorder) == false);
+
+		for (int y = 0; y < map_size; ++y) {
+			for (int x = 0; x < map_size; ++x) {
+				const int distance = recorder.distances[y * map_size + x];
+
+				if (x == 8 && y < map_size - 1) {
+					BOOST_CHECK(distance == 0);
+					continue;
+				}
+
+				//tiles on the same side of the wall are reached in as many steps as their diagonal distance
+				const bool same_side = (x < 8) == (start_pos.x < 8) && x != 8;
+				if (same_side) {
+					BOOST_CHECK(distance == std::max(std::abs(x - start_pos.x), std::abs(y - start_pos.y)) + 1);
+				} else {
+					BOOST_CHECK(distance > 1);
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,53 @@
+#run a replay without display with one and with several pathfinding threads, and check that the game ends up in the same state, as given by the final SyncHash
+#the replay is also converted to the binary replay format, which must end up in the same state as the replay log
+
+function(run_headless_replay replay_file thread_count result_variable)
+	execute_process(
+		COMMAND ${GAME} -d ${DATA_PATH} --headless-replay ${replay_file} --pathfinding-threads ${thread_count}
+		OUTPUT_VARIABLE output
+		ERROR_VARIABLE error_output
+		RESULT_VARIABLE result
+	)
+
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "The headless replay of \"${replay_file}\" with ${thread_count} pathfinding threads failed with exit code ${result}:\n${output}\n${error_output}")
+	endif()
+
+	string(REGEX MATCH "Final SyncHash: ([0-9]+)" sync_hash_match "${output}")
+	if(NOT sync_hash_match)
+		message(FATAL_ERROR "The headless replay of \"${replay_file}\" with ${thread_count} pathfinding threads did not print its final SyncHash:\n${output}")
+	endif()
+
+	set(${result_variable} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+foreach(thread_count 1 4)
+	run_headless_replay(${REPLAY} ${thread_count} sync_hash_${thread_count})
+endforeach()
+
+if(NOT sync_hash_1 STREQUAL sync_hash_4)
+	message(FATAL_ERROR "The final SyncHash differs between 1 (${sync_hash_1}) and 4 (${sync_hash_4}) pathfinding threads.")
+endif()
+
+get_filename_component(replay_name ${REPLAY} NAME_WE)
+set(binary_replay ${CMAKE_CURRENT_BINARY_DIR}/${replay_name}_determinism_test.wrpl)
+
+execute_process(
+	COMMAND ${GAME} -d ${DATA_PATH} --convert-replay ${REPLAY} --convert-replay-output ${binary_replay}
+	OUTPUT_VARIABLE output
+	ERROR_VARIABLE error_output
+	RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0 OR NOT EXISTS ${binary_replay})
+	message(FATAL_ERROR "Converting the replay to the binary replay format failed with exit code ${result}:\n${output}\n${error_output}")
+endif()
+
+run_headless_replay(${binary_replay} 1 binary_sync_hash)
+file(REMOVE ${binary_replay})
+
+if(NOT binary_sync_hash STREQUAL sync_hash_1)
+	message(FATAL_ERROR "The final SyncHash differs between the replay log (${sync_hash_1}) and the binary replay converted from it (${binary_sync_hash}).")
+endif()
+
+message(STATUS "Final SyncHash with 1 and 4 pathfinding threads, and of the binary replay: ${sync_hash_1}")
@@ -0,0 +1,94 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/fenwick_tree.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(fenwick_tree_tests)
+
+BOOST_AUTO_TEST_CASE(fenwick_tree_find_test)
+{
+	wyrmgus::fenwick_tree tree;
+	tree.assign({ 3, 0, 1, 5, 2 });
+
+	BOOST_CHECK(tree.get_total_weight() == 11);
+
+	const std::vector<size_t> expected_indexes = { 0, 0, 0, 2, 3, 3, 3, 3, 3, 4, 4 };
+	for (int i = 0; i < tree.get_total_weight(); ++i) {
+		BOOST_CHECK(tree.find(i) == expected_indexes[i]);
+	}
+
+	tree.remove(3);
+
+	BOOST_CHECK(tree.get_total_weight() == 6);
+	BOOST_CHECK(tree.find(3) == 2);
+	BOOST_CHECK(tree.find(4) == 4);
+	BOOST_CHECK(tree.find(5) == 4);
+}
+
+BOOST_AUTO_TEST_CASE(fenwick_tree_random_removal_test)
+{
+	std::mt19937 rng(42);
+
+	std::vector<int> weights;
+	for (int i = 0; i < 300; ++i) {
+		weights.push_back(i % 11 == 0 ? 0 : static_cast<int>(rng() % 50));
+	}
+
+	wyrmgus::fenwick_tree tree;
+	tree.assign(weights);
+
+	while (true) {
+		const int total_weight = std::accumulate(weights.begin(), weights.end(), 0);
+		BOOST_REQUIRE(tree.get_total_weight() == total_weight);
+
+		if (total_weight == 0) {
+			break;
+		}
+
+		//each value must select the element whose range of cumulative weight contains it
+		size_t index = 0;
+		int range_end = weights[0];
+		for (int value = 0; value < total_weight; ++value) {
+			while (value >= range_end) {
+				++index;
+				range_end += weights[index];
+			}
+
+			BOOST_CHECK(tree.find(value) == index);
+		}
+
+		const size_t removed_index = tree.find(std::uniform_int_distribution<int>(0, total_weight - 1)(rng));
+		tree.remove(removed_index);
+		weights[removed_index] = 0;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
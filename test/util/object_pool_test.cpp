@@ -0,0 +1,185 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/object_pool.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(object_pool_tests)
+
+namespace {
+
+//a stand-in for a missile, with derived classes which differ only in their action
+class test_missile
+{
+public:
+	virtual ~test_missile()
+	{
+	}
+
+	virtual void action(std::vector<int> &hits) = 0;
+
+	int id = 0;
+	std::array<char, 128> padding{};
+};
+
+class test_missile_hit final : public test_missile
+{
+public:
+	virtual void action(std::vector<int> &hits) override
+	{
+		hits.push_back(this->id);
+	}
+};
+
+class test_missile_fly final : public test_missile
+{
+public:
+	virtual void action(std::vector<int> &hits) override
+	{
+		Q_UNUSED(hits);
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_slot_reuse_test)
+{
+	wyrmgus::object_pool<test_missile, 4> pool;
+	std::vector<test_missile *> missiles;
+
+	for (int i = 0; i < 6; ++i) {
+		test_missile *missile = pool.create<test_missile_fly>();
+		missile->id = i;
+		missiles.push_back(missile);
+	}
+
+	BOOST_CHECK(pool.size() == 6);
+
+	//objects keep their address when more slabs are added
+	for (int i = 0; i < 6; ++i) {
+		BOOST_CHECK(missiles[i]->id == i);
+	}
+
+	test_missile *destroyed_missile = missiles[2];
+	pool.destroy(destroyed_missile);
+	BOOST_CHECK(pool.size() == 5);
+
+	//the slot of a destroyed object is reused for the next one, even if it is of another derived type
+	test_missile *missile = pool.create<test_missile_hit>();
+	BOOST_CHECK(missile == destroyed_missile);
+	missiles[2] = missile;
+
+	for (test_missile *missile_to_destroy : missiles) {
+		pool.destroy(missile_to_destroy);
+	}
+
+	BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_destruction_test)
+{
+	static int destroyed_count = 0;
+
+	class counted_missile : public test_missile
+	{
+	public:
+		virtual ~counted_missile() override
+		{
+			++destroyed_count;
+		}
+
+		virtual void action(std::vector<int> &hits) override
+		{
+			hits.push_back(this->id);
+		}
+	};
+
+	{
+		wyrmgus::object_pool<test_missile, 4> pool;
+
+		std::vector<test_missile *> missiles;
+		for (int i = 0; i < 6; ++i) {
+			missiles.push_back(pool.create<counted_missile>());
+		}
+
+		pool.destroy(missiles[1]);
+		pool.destroy(missiles[4]);
+		BOOST_CHECK(destroyed_count == 2);
+	}
+
+	//the objects still alive when the pool is destroyed are destroyed with it, each exactly once
+	BOOST_CHECK(destroyed_count == 6);
+}
+
+BOOST_AUTO_TEST_CASE(object_pool_random_operations_test)
+{
+	wyrmgus::object_pool<test_missile, 8> pool;
+	std::vector<test_missile *> missiles;
+
+	std::mt19937 rng(42);
+	int next_id = 0;
+
+	for (int operation = 0; operation < 5000; ++operation) {
+		if (missiles.empty() || rng() % 5 < 3) {
+			test_missile *missile = nullptr;
+			if (rng() % 2 == 0) {
+				missile = pool.create<test_missile_fly>();
+			} else {
+				missile = pool.create<test_missile_hit>();
+			}
+
+			//a new object must never share its slot with a live one
+			BOOST_CHECK(std::find(missiles.begin(), missiles.end(), missile) == missiles.end());
+
+			missile->id = next_id++;
+			missile->padding.fill(static_cast<char>(missile->id));
+			missiles.push_back(missile);
+		} else {
+			const size_t index = rng() % missiles.size();
+			pool.destroy(missiles[index]);
+			missiles[index] = missiles.back();
+			missiles.pop_back();
+		}
+
+		BOOST_CHECK(pool.size() == missiles.size());
+	}
+
+	//creating and destroying other objects must not have changed the live ones
+	for (const test_missile *missile : missiles) {
+		BOOST_CHECK(std::all_of(missile->padding.begin(), missile->padding.end(), [missile](const char c) {
+			return c == static_cast<char>(missile->id);
+		}));
+	}
+
+	pool.clear();
+	BOOST_CHECK(pool.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
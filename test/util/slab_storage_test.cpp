@@ -0,0 +1,127 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "util/slab_storage.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(slab_storage_tests)
+
+namespace {
+
+struct test_unit final
+{
+	explicit test_unit(int &destruction_count) : destruction_count(&destruction_count)
+	{
+	}
+
+	~test_unit()
+	{
+		++(*this->destruction_count);
+	}
+
+	int *destruction_count = nullptr;
+	int slot = -1;
+	std::array<char, 512> padding{};
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(slab_storage_stable_address_test)
+{
+	int destruction_count = 0;
+
+	{
+		wyrmgus::slab_storage<test_unit, 4> storage;
+		std::vector<test_unit *> pointers;
+
+		for (int i = 0; i < 10; ++i) {
+			test_unit *unit = storage.emplace_back(destruction_count);
+			unit->slot = i;
+			pointers.push_back(unit);
+		}
+
+		BOOST_CHECK(storage.size() == 10);
+
+		//objects must not move when new slabs are added
+		for (int i = 0; i < 10; ++i) {
+			BOOST_CHECK(&storage[i] == pointers[i]);
+			BOOST_CHECK(storage[i].slot == i);
+		}
+
+		//objects within a slab are contiguous
+		BOOST_CHECK(&storage[1] == &storage[0] + 1);
+
+		BOOST_CHECK_THROW(storage.at(10), std::out_of_range);
+
+		storage.clear();
+		BOOST_CHECK(storage.empty());
+		BOOST_CHECK(destruction_count == 10);
+
+		storage.emplace_back(destruction_count);
+	}
+
+	BOOST_CHECK(destruction_count == 11);
+}
+
+BOOST_AUTO_TEST_CASE(slab_storage_destruction_order_test)
+{
+	struct alignas(32) ordered_object final
+	{
+		explicit ordered_object(std::vector<int> &destroyed_values, const int value) : destroyed_values(&destroyed_values), value(value)
+		{
+		}
+
+		~ordered_object()
+		{
+			this->destroyed_values->push_back(this->value);
+		}
+
+		std::vector<int> *destroyed_values = nullptr;
+		int value = 0;
+	};
+
+	std::vector<int> destroyed_values;
+
+	{
+		wyrmgus::slab_storage<ordered_object, 3> storage;
+
+		for (int i = 0; i < 7; ++i) {
+			const ordered_object *object = storage.emplace_back(destroyed_values, i);
+
+			//objects must be aligned as their type requires
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(object) % alignof(ordered_object) == 0);
+		}
+	}
+
+	//the objects are destroyed in the reverse of the order in which they were added
+	BOOST_CHECK(destroyed_values == std::vector<int>({ 6, 5, 4, 3, 2, 1, 0 }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
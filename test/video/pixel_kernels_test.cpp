@@ -0,0 +1,181 @@
+//       _________ __                 __
+//      /   _____//  |_____________ _/  |______     ____  __ __  ______
+//      \_____  \\   __\_  __ \__  \\   __\__  \   / ___\|  |  \/  ___/
+//      /        \|  |  |  | \// __ \|  |  / __ \_/ /_/  >  |  /\___ |
+//     /_______  /|__|  |__|  (____  /__| (____  /\___  /|____//____  >
+//             \/                  \/          \//_____/            \/
+//  ______________________                           ______________________
+//                        T H E   W A R   B E G I N S
+//         Stratagus - A free fantasy real time strategy game engine
+//
+//      (c) Copyright 2022 by Andrettin
+//
+//      This program is free software; you can redistribute it and/or modify
+//      it under the terms of the GNU General Public License as published by
+//      the Free Software Foundation; only version 2 of the License.
+//
+//      This program is distributed in the hope that it will be useful,
+//      but WITHOUT ANY WARRANTY; without even the implied warranty of
+//      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//      GNU General Public License for more details.
+//
+//      You should have received a copy of the GNU General Public License
+//      along with this program; if not, write to the Free Software
+//      Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA
+//      02111-1307, USA.
+
+
+#include "stratagus.h"
+
+#include "video/pixel_kernels.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(pixel_kernels_tests)
+
+using wyrmgus::pixel_kernels::color_swap;
+using wyrmgus::pixel_kernels::simd_level;
+
+namespace {
+
+std::vector<simd_level> get_simd_levels()
+{
+	std::vector<simd_level> levels = { simd_level::scalar };
+
+	if (wyrmgus::pixel_kernels::get_supported_simd_level() >= simd_level::sse2) {
+		levels.push_back(simd_level::sse2);
+	}
+
+	if (wyrmgus::pixel_kernels::get_supported_simd_level() >= simd_level::avx2) {
+		levels.push_back(simd_level::avx2);
+	}
+
+	return levels;
+}
+
+//every RGB value, with varying alpha values, and an odd count so that the scalar tail of the vectorized kernels is exercised
+std::vector<uint32_t> create_all_rgb_pixels()
+{
+	std::vector<uint32_t> pixels((1 << 24) + 3);
+
+	for (size_t i = 0; i < pixels.size(); ++i) {
+		const uint32_t rgb = static_cast<uint32_t>(i) & 0xFFFFFF;
+		pixels[i] = rgb | (static_cast<uint32_t>((i * 37) & 0xFF) << 24);
+	}
+
+	return pixels;
+}
+
+constexpr uint32_t to_rgba(const uint32_t red, const uint32_t green, const uint32_t blue, const uint32_t alpha)
+{
+	return red | (green << 8) | (blue << 16) | (alpha << 24);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_values_test)
+{
+	for (const simd_level level : get_simd_levels()) {
+		//more pixels than fit in a vector register, so that both the vectorized part and the scalar tail are checked
+		std::vector<uint32_t> pixels(19, to_rgba(100, 150, 200, 77));
+		pixels[17] = to_rgba(255, 255, 255, 3);
+		pixels[18] = to_rgba(0, 0, 0, 255);
+
+		std::vector<uint32_t> grayscale_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_grayscale(grayscale_pixels.data(), grayscale_pixels.size(), level);
+		BOOST_CHECK(grayscale_pixels[0] == to_rgba(143, 143, 143, 77));
+		BOOST_CHECK(grayscale_pixels[16] == to_rgba(143, 143, 143, 77));
+		BOOST_CHECK(grayscale_pixels[18] == to_rgba(0, 0, 0, 255));
+
+		std::vector<uint32_t> sepia_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_sepia(sepia_pixels.data(), sepia_pixels.size(), level);
+		BOOST_CHECK(sepia_pixels[0] == to_rgba(192, 171, 133, 77));
+		BOOST_CHECK(sepia_pixels[16] == to_rgba(192, 171, 133, 77));
+		BOOST_CHECK(sepia_pixels[17] == to_rgba(255, 255, 238, 3));
+
+		//the results are clamped to the 0-255 range
+		std::vector<uint32_t> changed_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_rgb_change(changed_pixels.data(), changed_pixels.size(), 20, 120, -250, level);
+		BOOST_CHECK(changed_pixels[0] == to_rgba(120, 255, 0, 77));
+		BOOST_CHECK(changed_pixels[16] == to_rgba(120, 255, 0, 77));
+		BOOST_CHECK(changed_pixels[17] == to_rgba(255, 255, 5, 3));
+		BOOST_CHECK(changed_pixels[18] == to_rgba(20, 120, 0, 255));
+
+		//only pixels with an RGB value in the table are replaced, keeping their alpha value
+		const std::vector<color_swap> color_swaps = {
+			color_swap{ to_rgba(100, 150, 200, 0), to_rgba(1, 2, 3, 0) },
+			color_swap{ to_rgba(0, 0, 0, 0), to_rgba(0, 0, 252, 0) }
+		};
+		std::vector<uint32_t> swapped_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_color_swaps(swapped_pixels.data(), swapped_pixels.size(), color_swaps, level);
+		BOOST_CHECK(swapped_pixels[0] == to_rgba(1, 2, 3, 77));
+		BOOST_CHECK(swapped_pixels[16] == to_rgba(1, 2, 3, 77));
+		BOOST_CHECK(swapped_pixels[17] == to_rgba(255, 255, 255, 3));
+		BOOST_CHECK(swapped_pixels[18] == to_rgba(0, 0, 252, 255));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(pixel_kernels_simd_level_bit_exact_test)
+{
+	const std::vector<uint32_t> pixels = create_all_rgb_pixels();
+
+	static constexpr std::array<std::array<short, 3>, 5> rgb_changes = {{
+		{ 10, -10, 0 },
+		{ 255, -255, 1 },
+		{ 300, -300, -1 },
+		{ -32768, 32767, 0 },
+		{ 0, 0, 100 }
+	}};
+
+	const std::vector<color_swap> color_swaps = {
+		color_swap{ to_rgba(164, 0, 0, 0), to_rgba(0, 0, 252, 0) },
+		color_swap{ to_rgba(124, 0, 0, 0), to_rgba(0, 4, 196, 0) },
+		color_swap{ to_rgba(92, 4, 0, 0), to_rgba(0, 4, 140, 0) },
+		color_swap{ to_rgba(0, 0, 252, 0), to_rgba(164, 0, 0, 0) }
+	};
+
+	//the vectorized kernels must produce exactly the same output as the scalar ones
+	std::vector<uint32_t> scalar_grayscale_pixels = pixels;
+	wyrmgus::pixel_kernels::apply_grayscale(scalar_grayscale_pixels.data(), scalar_grayscale_pixels.size(), simd_level::scalar);
+
+	std::vector<uint32_t> scalar_sepia_pixels = pixels;
+	wyrmgus::pixel_kernels::apply_sepia(scalar_sepia_pixels.data(), scalar_sepia_pixels.size(), simd_level::scalar);
+
+	std::vector<uint32_t> scalar_swapped_pixels = pixels;
+	wyrmgus::pixel_kernels::apply_color_swaps(scalar_swapped_pixels.data(), scalar_swapped_pixels.size(), color_swaps, simd_level::scalar);
+
+	for (const simd_level level : get_simd_levels()) {
+		if (level == simd_level::scalar) {
+			continue;
+		}
+
+		std::vector<uint32_t> grayscale_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_grayscale(grayscale_pixels.data(), grayscale_pixels.size(), level);
+		BOOST_CHECK_MESSAGE(grayscale_pixels == scalar_grayscale_pixels, "Grayscale output differs for " << wyrmgus::pixel_kernels::get_simd_level_name(level));
+
+		std::vector<uint32_t> sepia_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_sepia(sepia_pixels.data(), sepia_pixels.size(), level);
+		BOOST_CHECK_MESSAGE(sepia_pixels == scalar_sepia_pixels, "Sepia output differs for " << wyrmgus::pixel_kernels::get_simd_level_name(level));
+
+		std::vector<uint32_t> swapped_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_color_swaps(swapped_pixels.data(), swapped_pixels.size(), color_swaps, level);
+		BOOST_CHECK_MESSAGE(swapped_pixels == scalar_swapped_pixels, "Color swap output differs for " << wyrmgus::pixel_kernels::get_simd_level_name(level));
+	}
+
+	for (const std::array<short, 3> &rgb_change : rgb_changes) {
+		std::vector<uint32_t> scalar_changed_pixels = pixels;
+		wyrmgus::pixel_kernels::apply_rgb_change(scalar_changed_pixels.data(), scalar_changed_pixels.size(), rgb_change[0], rgb_change[1], rgb_change[2], simd_level::scalar);
+
+		for (const simd_level level : get_simd_levels()) {
+			if (level == simd_level::scalar) {
+				continue;
+			}
+
+			std::vector<uint32_t> changed_pixels = pixels;
+			wyrmgus::pixel_kernels::apply_rgb_change(changed_pixels.data(), changed_pixels.size(), rgb_change[0], rgb_change[1], rgb_change[2], level);
+			BOOST_CHECK_MESSAGE(changed_pixels == scalar_changed_pixels, "RGB change output differs for " << wyrmgus::pixel_kernels::get_simd_level_name(level));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()